@@ -0,0 +1,200 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_RCU_PTR_H
+#define SRSRAN_RCU_PTR_H
+
+#include "srsran/adt/scope_exit.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace srsran {
+
+/**
+ * @brief Read-Copy-Update pointer for read-mostly data shared between threads
+ *
+ * Readers take a snapshot of the current object with read() and never block: entering and leaving the read-side
+ * section only increments and decrements a counter of the current epoch. Writers copy the current object, modify the
+ * copy and publish it. The old object is destroyed after a grace period, once every reader that may still hold it has
+ * left its read-side section. Writers are serialized between them and may block waiting for the grace period, except
+ * with modify_deferred(), which leaves the old object to a later writer call.
+ *
+ * The object seen by a reader does not change during the read-side section, so it shall be treated as immutable. A
+ * thread must not call modify() from a read-side section of the same rcu_ptr, the grace period would never end.
+ * @tparam T type of the protected object, it must be copy constructible
+ */
+template <typename T>
+class rcu_ptr
+{
+public:
+  /// Read-side section, the object it points to stays valid until it is destroyed
+  class read_guard
+  {
+  public:
+    read_guard(read_guard&& other) noexcept : parent(other.parent), idx(other.idx), ptr(other.ptr)
+    {
+      other.parent = nullptr;
+    }
+    read_guard(const read_guard&) = delete;
+    read_guard& operator=(const read_guard&) = delete;
+    read_guard& operator=(read_guard&&) = delete;
+    ~read_guard()
+    {
+      if (parent != nullptr) {
+        parent->readers[idx].fetch_sub(1, std::memory_order_release);
+      }
+    }
+
+    const T& operator*() const { return *ptr; }
+    const T* operator->() const { return ptr; }
+    const T* get() const { return ptr; }
+
+  private:
+    friend class rcu_ptr<T>;
+
+    explicit read_guard(const rcu_ptr<T>& parent_) : parent(&parent_), idx(parent_.epoch.load() & 1U)
+    {
+      // The counter must be visible before the pointer is loaded, so the writer cannot miss this reader
+      parent->readers[idx].fetch_add(1);
+      ptr = parent->ptr.load();
+    }
+
+    const rcu_ptr<T>* parent;
+    uint32_t          idx;
+    const T*          ptr = nullptr;
+  };
+
+  rcu_ptr() : rcu_ptr(std::unique_ptr<T>(new T{})) {}
+  explicit rcu_ptr(std::unique_ptr<T> obj) : ptr(obj.release()) {}
+  rcu_ptr(const rcu_ptr&) = delete;
+  rcu_ptr& operator=(const rcu_ptr&) = delete;
+  ~rcu_ptr() { delete ptr.load(); }
+
+  /// Enters a read-side section
+  read_guard read() const { return read_guard(*this); }
+
+  /**
+   * Copies the current object, calls the given function with the copy and publishes it when the function returns.
+   * @return whatever the function returns
+   */
+  template <typename Func>
+  auto modify(Func&& f) -> decltype(f(std::declval<T&>()))
+  {
+    std::lock_guard<std::mutex> lock(write_mutex);
+    std::unique_ptr<T>          next(new T(*ptr.load()));
+    auto                        publish = make_scope_exit([this, &next]() { replace(std::move(next)); });
+    return f(*next);
+  }
+
+  /**
+   * Same as modify(), but it does not wait for the grace period. The old object is retired and destroyed by a later
+   * writer call, once no reader can hold it. Intended for writers that must not block on readers
+   * @return whatever the function returns
+   */
+  template <typename Func>
+  auto modify_deferred(Func&& f) -> decltype(f(std::declval<T&>()))
+  {
+    std::lock_guard<std::mutex> lock(write_mutex);
+    std::unique_ptr<T>          next(new T(*ptr.load()));
+    auto                        publish = make_scope_exit([this, &next]() { retire(std::move(next)); });
+    return f(*next);
+  }
+
+  /// Publishes a new object, the current one is destroyed after the grace period
+  void reset(std::unique_ptr<T> obj)
+  {
+    std::lock_guard<std::mutex> lock(write_mutex);
+    replace(std::move(obj));
+  }
+
+  /// Destroys the retired objects that no reader holds anymore, it never waits for readers
+  void reclaim()
+  {
+    std::lock_guard<std::mutex> lock(write_mutex);
+    collect();
+  }
+
+private:
+  /// Object replaced without waiting for the grace period
+  struct retired_obj {
+    std::unique_ptr<T> obj;
+    uint32_t           pending_readers = 0b11; ///< Reader counters not seen drained since the object was replaced
+  };
+
+  void retire(std::unique_ptr<T> next)
+  {
+    retired_objs.push_back({std::unique_ptr<T>(ptr.exchange(next.release())), 0b11});
+
+    // New readers count in the other counter, so the one of the old epoch eventually drains
+    epoch.fetch_add(1);
+    collect();
+  }
+
+  void collect()
+  {
+    // Every reader holding a retired object incremented one of the two counters before it was replaced. Once a counter
+    // is seen at zero after the replacement, none of those readers remains in it
+    for (uint32_t i = 0; i < 2; i++) {
+      if (readers[i].load() == 0) {
+        for (retired_obj& r : retired_objs) {
+          r.pending_readers &= ~(1U << i);
+        }
+      }
+    }
+    retired_objs.erase(std::remove_if(retired_objs.begin(),
+                                      retired_objs.end(),
+                                      [](const retired_obj& r) { return r.pending_readers == 0; }),
+                       retired_objs.end());
+  }
+
+  void replace(std::unique_ptr<T> next)
+  {
+    std::unique_ptr<T> old(ptr.exchange(next.release()));
+
+    // Every reader holding the old object incremented one of the two counters before the exchange. After each epoch
+    // flip, new readers count in the other counter, so waiting for the old one to drain terminates. A reader may have
+    // read the epoch before an earlier flip, hence both counters are drained
+    for (uint32_t i = 0; i < 2; i++) {
+      uint32_t old_idx = epoch.fetch_add(1) & 1U;
+      while (readers[old_idx].load(std::memory_order_acquire) != 0) {
+        std::this_thread::yield();
+      }
+    }
+
+    // The grace period also covers the objects retired before
+    retired_objs.clear();
+  }
+
+  std::atomic<T*>                              ptr;
+  std::atomic<uint32_t>                        epoch   = {0};
+  mutable std::array<std::atomic<uint32_t>, 2> readers = {};
+  std::mutex                                   write_mutex;
+  std::vector<retired_obj>                     retired_objs;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_RCU_PTR_H
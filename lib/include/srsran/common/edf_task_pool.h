@@ -0,0 +1,154 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_EDF_TASK_POOL_H
+#define SRSRAN_EDF_TASK_POOL_H
+
+#include "srsran/adt/move_callback.h"
+#include "srsran/common/threads.h"
+#include "srsran/srslog/srslog.h"
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace srsran {
+
+/**
+ * @brief Pool of threads running tasks in earliest-deadline-first order
+ *
+ * Every task carries an absolute deadline and a type index. Pending tasks are kept in a heap sorted by deadline, so
+ * a free worker always picks the task that is due first, whichever producer pushed it. Tasks are pushed as part of a
+ * task group, the producer waits for the completion of its group with wait() and runs pending tasks of the pool
+ * meanwhile, so a producer never sits idle while there is work left. Tasks shall not wait for other tasks.
+ *
+ * The slack of a task is the time left until its deadline when it finishes, a task finishing after its deadline is a
+ * deadline miss. Both are accumulated per task type until they are read with get_metrics().
+ */
+class edf_task_pool
+{
+public:
+  using time_point = std::chrono::steady_clock::time_point;
+  using task_t     = srsran::move_callback<void(), default_move_callback_buffer_size, true>;
+
+  /// Set of tasks a producer waits for
+  class task_group
+  {
+  public:
+    uint32_t nof_pending() const { return pending; }
+
+  private:
+    friend class edf_task_pool;
+    uint32_t pending = 0; ///< Protected by the pool mutex
+  };
+
+  struct type_metrics_t {
+    uint32_t nof_tasks      = 0;
+    uint32_t nof_misses     = 0;
+    float    avg_slack_us   = 0.0f; ///< Negative when tasks finish after their deadline on average
+    float    min_slack_us   = 0.0f;
+    float    avg_runtime_us = 0.0f;
+  };
+
+  /**
+   * @param nof_types_ Number of task types for which metrics are kept
+   * @param nof_workers Number of threads of the pool, it may be zero if the producers run every task themselves
+   */
+  edf_task_pool(uint32_t nof_types_, uint32_t nof_workers, int32_t prio_ = -1, uint32_t mask_ = 255);
+  edf_task_pool(const edf_task_pool&) = delete;
+  edf_task_pool& operator=(const edf_task_pool&) = delete;
+  ~edf_task_pool();
+
+  void stop();
+
+  /**
+   * Pushes a task to the pool
+   * @param group task group the task belongs to, it shall not be destroyed before wait() returns
+   * @param type task type index, lower than the number of types given at construction
+   * @param deadline time at which the task shall be finished
+   */
+  void push_task(task_group& group, uint32_t type, time_point deadline, task_t&& task);
+
+  /// Waits for every task of the group to finish, running the earliest pending tasks of the pool meanwhile
+  void wait(task_group& group);
+
+  /// Returns the metrics of each task type accumulated since the last call and resets them
+  std::vector<type_metrics_t> get_metrics();
+
+  uint32_t nof_pending_tasks() const;
+
+private:
+  struct pending_task_t {
+    time_point  deadline;
+    uint64_t    seq; ///< Keeps push order among tasks with the same deadline
+    uint32_t    type;
+    task_group* group;
+    task_t      task;
+  };
+
+  struct type_stats_t {
+    uint32_t nof_tasks      = 0;
+    uint32_t nof_misses     = 0;
+    double   sum_slack_us   = 0;
+    double   min_slack_us   = 0;
+    double   sum_runtime_us = 0;
+  };
+
+  class worker_t : public thread
+  {
+  public:
+    worker_t(edf_task_pool* parent_, uint32_t id);
+    void stop() { wait_thread_finish(); }
+
+  private:
+    void run_thread() override;
+
+    edf_task_pool* parent = nullptr;
+  };
+
+  static bool later(const pending_task_t& a, const pending_task_t& b)
+  {
+    return a.deadline > b.deadline or (a.deadline == b.deadline and a.seq > b.seq);
+  }
+
+  // Pops the earliest pending task, the lock must be held and the heap must not be empty
+  pending_task_t pop_task();
+  // Runs a popped task without holding the lock and records its completion
+  void run_task(std::unique_lock<std::mutex>& lock, pending_task_t& t);
+
+  int32_t               prio = -1;
+  uint32_t              mask = 255;
+  srslog::basic_logger& logger;
+
+  mutable std::mutex                      mutex;
+  std::condition_variable                 cv_task;
+  std::condition_variable                 cv_done;
+  std::vector<pending_task_t>             heap;
+  uint64_t                                seq     = 0;
+  bool                                    running = true;
+  std::vector<type_stats_t>               stats;
+  std::vector<std::unique_ptr<worker_t> > workers;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_EDF_TASK_POOL_H
@@ -329,6 +329,32 @@ liblte_security_milenage_f1_star(uint8* k, uint8* op, uint8* rand, uint8* sqn, u
 LIBLTE_ERROR_ENUM
 liblte_security_milenage_f2345(uint8* k, uint8* op, uint8* rand, uint8* res, uint8* ck, uint8* ik, uint8* ak);
 
+/*********************************************************************
+    Name: liblte_security_milenage_f12345
+
+    Description: Milenage security functions F1, F2, F3, F4, and F5
+                 for the authentication of the network.  Computes
+                 RES, CK, IK and AK from random challenge RAND, and
+                 MAC-A from the SQN and AMF carried in AUTN.  The
+                 round keys and the intermediate value TEMP are
+                 shared by all functions.
+
+    Document Reference: 35.206 v10.0.0 Annex 3
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM liblte_security_milenage_f12345(uint8* k,
+                                                  uint8* op,
+                                                  uint8* rand,
+                                                  uint8* autn,
+                                                  uint8* mac_a,
+                                                  uint8* res,
+                                                  uint8* ck,
+                                                  uint8* ik,
+                                                  uint8* ak);
+
 /*********************************************************************
     Name: liblte_security_milenage_f5_star
 
@@ -22,18 +22,15 @@
 #ifndef SRSRAN_MAC_PCAP_BASE_H
 #define SRSRAN_MAC_PCAP_BASE_H
 
-#include "srsran/adt/circular_buffer.h"
-#include "srsran/common/buffer_pool.h"
 #include "srsran/common/common.h"
 #include "srsran/common/pcap.h"
-#include "srsran/common/threads.h"
 #include "srsran/srslog/srslog.h"
+#include <atomic>
 #include <mutex>
 #include <stdint.h>
-#include <thread>
 
 namespace srsran {
-class mac_pcap_base : protected srsran::thread
+class mac_pcap_base
 {
 public:
   mac_pcap_base();
@@ -43,7 +40,7 @@ public:
   mac_pcap_base(mac_pcap_base&& other)                 = delete;
   mac_pcap_base& operator=(mac_pcap_base&& other) = delete;
 
-  ~mac_pcap_base();
+  virtual ~mac_pcap_base();
   void             enable(bool enable);
   virtual uint32_t close() = 0;
 
@@ -102,17 +99,18 @@ protected:
     srsran::srsran_rat_t  rat;
     MAC_Context_Info_t    context;
     mac_nr_context_info_t context_nr;
-    unique_byte_buffer_t  pdu;
+    const uint8_t*        payload;
+    uint32_t              payload_len;
   } pcap_pdu_t;
 
+  /// Called from the context of the caller of the write functions, which may be any PHY or stack thread. The payload
+  /// is only valid during the call
   virtual void write_pdu(pcap_pdu_t& pdu) = 0;
-  void         run_thread() final;
 
-  std::mutex                              mutex;
-  srslog::basic_logger&                   logger;
-  std::atomic<bool>                       running = {false};
-  static_blocking_queue<pcap_pdu_t, 1024> queue;
-  uint16_t                                ue_id = 0;
+  std::mutex            mutex;
+  srslog::basic_logger& logger;
+  std::atomic<bool>     running = {false};
+  uint16_t              ue_id   = 0;
 
 private:
   void pack_and_queue(uint8_t* payload,
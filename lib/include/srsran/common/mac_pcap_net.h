@@ -25,10 +25,12 @@
 #include "srsran/common/common.h"
 #include "srsran/common/mac_pcap_base.h"
 #include "srsran/common/network_utils.h"
+#include "srsran/common/pcap_writer.h"
+#include "srsran/common/threads.h"
 #include "srsran/srsran.h"
 
 namespace srsran {
-class mac_pcap_net : public mac_pcap_base
+class mac_pcap_net : public mac_pcap_base, protected srsran::thread
 {
 public:
   mac_pcap_net();
@@ -41,9 +43,15 @@ public:
   uint32_t close();
 
 private:
-  void write_pdu(srsran::mac_pcap_base::pcap_pdu_t& pdu);
-  void write_mac_lte_pdu_to_net(srsran::mac_pcap_base::pcap_pdu_t& pdu);
-  void write_mac_nr_pdu_to_net(srsran::mac_pcap_base::pcap_pdu_t& pdu);
+  static const size_t ring_size = 2 * 1024 * 1024;
+
+  void write_pdu(srsran::mac_pcap_base::pcap_pdu_t& pdu) override;
+  void run_thread() override;
+  void send_to_net(const uint8_t* datagram, uint32_t len);
+
+  // UDP datagrams (start string + MAC context + PDU) waiting to be sent by the writer thread
+  pcap_ring             ring;
+  std::atomic<uint64_t> nof_dropped = {0};
 
   srsran::unique_socket socket;
   struct sockaddr_in    client_addr;
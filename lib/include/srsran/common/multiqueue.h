@@ -31,8 +31,12 @@
 #include "srsran/adt/circular_buffer.h"
 #include "srsran/adt/move_callback.h"
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <functional>
+#include <limits>
 #include <mutex>
 #include <queue>
 #include <vector>
@@ -40,12 +44,20 @@
 namespace srsran {
 
 #define MULTIQUEUE_DEFAULT_CAPACITY (8192) // Default per-queue capacity
+#define MULTIQUEUE_MAX_CLASSES (32)        // Maximum number of queue classes
+
+/// Information about a popped message
+struct multiqueue_pop_info {
+  uint32_t                              queue_class = 0; ///< Class of the queue the message was popped from
+  std::chrono::steady_clock::time_point push_time;       ///< Time at which the message was pushed
+};
 
 /**
  * N-to-1 Message-Passing Broker that manages the creation, destruction of input ports, and popping of messages that
  * are pushed to these ports.
  * Each port provides a thread-safe push(...) / try_push(...) interface to enqueue messages
- * The class will pop from the several created ports in a round-robin fashion.
+ * Each port belongs to a class. The class will pop from the ports of the lowest class that has messages, and from the
+ * ports of the same class in a round-robin fashion. A blocked consumer is woken up by the producers.
  * The popping() interface is not safe-thread. That means, that it is expected that only one thread will
  * be popping tasks.
  * @tparam myobj message type
@@ -56,7 +68,9 @@ class multiqueue_handler
   class input_port_impl
   {
   public:
-    input_port_impl(uint32_t cap, multiqueue_handler<myobj>* parent_) : buffer(cap), parent(parent_) {}
+    input_port_impl(uint32_t cap, uint32_t class_, multiqueue_handler<myobj>* parent_) :
+      buffer(cap), queue_class(class_), parent(parent_)
+    {}
     input_port_impl(const input_port_impl&) = delete;
     input_port_impl(input_port_impl&&)      = delete;
     input_port_impl& operator=(const input_port_impl&) = delete;
@@ -118,19 +132,22 @@ class multiqueue_handler
       return {std::move(o)};
     }
 
-    bool try_pop(myobj& obj)
+    bool try_pop(myobj& obj, multiqueue_pop_info* info = nullptr)
     {
       std::unique_lock<std::mutex> lock(q_mutex);
-      return pop_(lock, obj);
+      return pop_(lock, obj, info);
     }
 
-    bool try_pop(myobj& obj, bool& try_lock_success)
+    bool try_pop(myobj& obj, bool& try_lock_success, multiqueue_pop_info* info = nullptr)
     {
       std::unique_lock<std::mutex> lock(q_mutex, std::try_to_lock);
       try_lock_success = lock.owns_lock();
-      return try_lock_success ? pop_(lock, obj) : false;
+      return try_lock_success ? pop_(lock, obj, info) : false;
     }
 
+    uint32_t get_class() const { return queue_class.load(std::memory_order_relaxed); }
+    void     set_class(uint32_t class_) { queue_class.store(class_, std::memory_order_relaxed); }
+
   private:
     template <typename T>
     bool push_(T* o, bool blocking) noexcept
@@ -154,16 +171,22 @@ class multiqueue_handler
           return false;
         }
       }
-      buffer.push(std::forward<T>(*o));
+      buffer.push(entry{std::forward<T>(*o), std::chrono::steady_clock::now()});
+      lock.unlock();
+      parent->notify_push(get_class());
       return true;
     }
 
-    bool pop_(std::unique_lock<std::mutex>& lock, myobj& obj)
+    bool pop_(std::unique_lock<std::mutex>& lock, myobj& obj, multiqueue_pop_info* info)
     {
       if (buffer.empty()) {
         return false;
       }
-      obj = std::move(buffer.top());
+      obj = std::move(buffer.top().obj);
+      if (info != nullptr) {
+        info->queue_class = get_class();
+        info->push_time   = buffer.top().push_time;
+      }
       buffer.pop();
       if (nof_waiting > 0) {
         lock.unlock();
@@ -172,10 +195,16 @@ class multiqueue_handler
       return true;
     }
 
+    struct entry {
+      myobj                                 obj;
+      std::chrono::steady_clock::time_point push_time;
+    };
+
     multiqueue_handler<myobj>* parent = nullptr;
 
     mutable std::mutex                 q_mutex;
-    srsran::dyn_circular_buffer<myobj> buffer;
+    srsran::dyn_circular_buffer<entry> buffer;
+    std::atomic<uint32_t>              queue_class{0};
     std::condition_variable            cv_full, cv_exit;
     bool                               active_     = true;
     int                                nof_waiting = 0;
@@ -234,6 +263,8 @@ public:
       // signal deactivation to pushing threads in a non-blocking way
       q.set_active(false);
     }
+    // wake up a blocked consumer
+    cv_pop.notify_one();
     while (consumer_state) {
       cv_exit.wait(lock);
     }
@@ -246,10 +277,12 @@ public:
   /**
    * Adds a new queue with fixed capacity
    * @param capacity_ The capacity of the queue.
+   * @param queue_class Class of the queue. Queues of lower classes are popped first
    * @return The index of the newly created (or reused) queue within the vector of queues.
    */
-  queue_handle add_queue(uint32_t capacity_)
+  queue_handle add_queue(uint32_t capacity_, uint32_t queue_class = 0)
   {
+    srsran_assert(queue_class < MULTIQUEUE_MAX_CLASSES, "Invalid queue class %d", queue_class);
     uint32_t                    qidx = 0;
     std::lock_guard<std::mutex> lock(mutex);
     if (not running) {
@@ -262,9 +295,10 @@ public:
     // check if there is a free queue of the required size
     if (qidx == queues.size()) {
       // create new queue
-      queues.emplace_back(capacity_, this);
+      queues.emplace_back(capacity_, queue_class, this);
       qidx = queues.size() - 1; // update qidx to the last element
     } else {
+      queues[qidx].set_class(queue_class);
       queues[qidx].set_active(true);
     }
     return queue_handle(&queues[qidx]);
@@ -286,43 +320,85 @@ public:
     return count;
   }
 
-  bool wait_pop(myobj* value)
+  /**
+   * Pops a message, blocking until one of the queues of the given classes has a message or the multiqueue is stopped
+   * @param value popped message
+   * @param class_mask bitmap of the classes to pop from, bit i set for class i
+   * @param info if not null, filled with the class of the queue and the time at which the message was pushed
+   * @return false if the multiqueue was stopped
+   */
+  bool wait_pop(myobj* value, uint32_t class_mask = all_classes, multiqueue_pop_info* info = nullptr)
   {
     std::unique_lock<std::mutex> lock(mutex);
     consumer_state = true;
     while (running) {
-      if (round_robin_pop_(value)) {
+      // Publish the classes that wake us up before the last check of the queues, so that a message pushed after it
+      // always sees them set
+      waiting_classes.store(class_mask, std::memory_order_seq_cst);
+      if (class_priority_pop_(value, class_mask, info)) {
+        waiting_classes.store(0, std::memory_order_relaxed);
         consumer_state = false;
         return true;
       }
-      lock.unlock();
-      std::this_thread::sleep_for(std::chrono::microseconds(100));
-      lock.lock();
+      cv_pop.wait(lock);
     }
+    waiting_classes.store(0, std::memory_order_relaxed);
     consumer_state = false;
     lock.unlock();
     cv_exit.notify_one();
     return false;
   }
 
-  bool try_pop(myobj* value)
+  bool try_pop(myobj* value, uint32_t class_mask = all_classes, multiqueue_pop_info* info = nullptr)
   {
     std::unique_lock<std::mutex> lock(mutex);
-    return running and round_robin_pop_(value);
+    return running and class_priority_pop_(value, class_mask, info);
   }
 
+  static const uint32_t all_classes = std::numeric_limits<uint32_t>::max();
+
 private:
-  bool round_robin_pop_(myobj* value)
+  void notify_push(uint32_t queue_class)
+  {
+    if ((waiting_classes.load(std::memory_order_seq_cst) & (1U << queue_class)) != 0) {
+      // Taking the mutex ensures that the consumer is either waiting or has not checked the queues yet
+      std::lock_guard<std::mutex> lock(mutex);
+      cv_pop.notify_one();
+    }
+  }
+
+  bool class_priority_pop_(myobj* value, uint32_t class_mask, multiqueue_pop_info* info)
+  {
+    // Find the classes with queues, so that a multiqueue with a single class costs a single round-robin search
+    uint32_t used_classes = 0;
+    for (const input_port_impl& q : queues) {
+      used_classes |= 1U << q.get_class();
+    }
+    used_classes &= class_mask;
+    for (uint32_t c = 0; used_classes != 0; ++c, used_classes >>= 1U) {
+      if ((used_classes & 1U) != 0 and round_robin_pop_(value, c, info)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool round_robin_pop_(myobj* value, uint32_t queue_class, multiqueue_pop_info* info)
   {
-    // Round-robin for all queues
-    auto     q_it  = queues.begin() + spin_idx;
-    uint32_t count = 0;
+    // Round-robin for all queues of the class
+    uint32_t& spin_idx = spin_idxs[queue_class];
+    spin_idx           = spin_idx < queues.size() ? spin_idx : 0;
+    auto     q_it      = queues.begin() + spin_idx;
+    uint32_t count     = 0;
     for (; count < queues.size(); ++count, ++q_it) {
       if (q_it == queues.end()) {
         q_it = queues.begin(); // wrap-around
       }
+      if (q_it->get_class() != queue_class) {
+        continue;
+      }
       bool try_lock_success = true;
-      if (q_it->try_pop(*value, try_lock_success)) {
+      if (q_it->try_pop(*value, try_lock_success, info)) {
         spin_idx = (spin_idx + count + 1) % queues.size();
         return true;
       }
@@ -334,12 +410,13 @@ private:
     return false;
   }
 
-  mutable std::mutex          mutex;
-  std::condition_variable     cv_exit;
-  uint32_t                    spin_idx = 0;
-  bool                        running = true, consumer_state = false;
-  std::deque<input_port_impl> queues;
-  uint32_t                    default_capacity = 0;
+  mutable std::mutex                           mutex;
+  std::condition_variable                      cv_exit, cv_pop;
+  std::array<uint32_t, MULTIQUEUE_MAX_CLASSES> spin_idxs = {};
+  std::atomic<uint32_t>                        waiting_classes{0};
+  bool                                         running = true, consumer_state = false;
+  std::deque<input_port_impl>                  queues;
+  uint32_t                                     default_capacity = 0;
 };
 
 template <typename T>
@@ -23,7 +23,7 @@
 #define SRSRAN_NAS_PCAP_H
 
 #include "srsran/common/common.h"
-#include "srsran/common/pcap.h"
+#include "srsran/common/pcap_writer.h"
 #include <string>
 
 namespace srsran {
@@ -31,23 +31,16 @@ namespace srsran {
 class nas_pcap
 {
 public:
-  nas_pcap()
-  {
-    enable_write = false;
-    ue_id        = 0;
-    pcap_file    = NULL;
-  }
-  void enable();
+  nas_pcap();
+  void     enable();
   uint32_t open(std::string filename_, uint32_t ue_id = 0, srsran_rat_t rat_type = srsran_rat_t::lte);
-  void close();
-  void write_nas(uint8_t* pdu, uint32_t pdu_len_bytes);
+  void     close();
+  void     write_nas(uint8_t* pdu, uint32_t pdu_len_bytes);
 
 private:
-  bool        enable_write;
-  std::string filename;
-  FILE*       pcap_file;
-  uint32_t    ue_id;
-  void        pack_and_write(uint8_t* pdu, uint32_t pdu_len_bytes);
+  bool        enable_write = false;
+  pcap_writer writer;
+  uint32_t    ue_id = 0;
 };
 
 } // namespace srsran
@@ -204,6 +204,12 @@ int LTE_PCAP_MAC_WritePDU(FILE* fd, MAC_Context_Info_t* context, const unsigned
 int LTE_PCAP_MAC_UDP_WritePDU(FILE* fd, MAC_Context_Info_t* context, const unsigned char* PDU, unsigned int length);
 int LTE_PCAP_PACK_MAC_CONTEXT_TO_BUFFER(MAC_Context_Info_t* context, uint8_t* PDU, unsigned int length);
 
+/* Pack the dummy UDP header and context that precede a PDU of the given length, the buffer must hold
+ * PCAP_CONTEXT_HEADER_MAX bytes. Return the number of bytes packed */
+int LTE_PCAP_PACK_MAC_UDP_HEADER(MAC_Context_Info_t* context, unsigned int length, uint8_t* buffer);
+int LTE_PCAP_PACK_RLC_UDP_HEADER(RLC_Context_Info_t* context, unsigned int length, uint8_t* buffer);
+int NR_PCAP_PACK_MAC_UDP_HEADER(mac_nr_context_info_t* context, unsigned int length, uint8_t* buffer);
+
 /* Write an individual NAS PDU (PCAP packet header + nas-context + nas-pdu) */
 int LTE_PCAP_NAS_WritePDU(FILE* fd, NAS_Context_Info_t* context, const unsigned char* PDU, unsigned int length);
 
@@ -0,0 +1,269 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_PCAP_WRITER_H
+#define SRSRAN_PCAP_WRITER_H
+
+#include "srsran/common/pcap.h"
+#include "srsran/common/threads.h"
+#include "srsran/srslog/srslog.h"
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <sys/time.h>
+#include <vector>
+
+namespace srsran {
+
+/**
+ * @brief Lock-free ring of variable size records with multiple producers and a single consumer
+ *
+ * Producers reserve space for a record with a CAS on the head position, write the record in place and commit it by
+ * publishing its size in the record header. The consumer reads the committed records in order and zeroes their memory,
+ * so that the header of a record that is reserved but not yet committed always reads as zero. A record never wraps
+ * around the end of the buffer, the remaining bytes are reserved as a padding record instead.
+ *
+ * The buffer is only allocated while the ring is in use, between init() and release(). stop() rejects new records
+ * and waits for the producers that are still writing one, so that the consumer can read the last records afterwards.
+ */
+class pcap_ring
+{
+public:
+  pcap_ring() = default;
+  /// Creates a ring with at least the given capacity in bytes, rounded up to a power of two
+  explicit pcap_ring(size_t capacity_bytes) { init(capacity_bytes); }
+
+  /// Allocates a ring with at least the given capacity in bytes, rounded up to a power of two, and accepts records
+  void init(size_t capacity_bytes);
+  /// Rejects the records pushed from now on and returns once no producer is writing into the ring
+  void stop();
+  /// Frees the buffer of a stopped ring, the records not consumed yet are lost
+  void release();
+
+  pcap_ring(const pcap_ring&) = delete;
+  pcap_ring& operator=(const pcap_ring&) = delete;
+
+  /**
+   * Writes a record of at most max_len bytes in place.
+   * @param fill callable uint32_t(uint8_t* data) that writes the record and returns its length
+   * @return false if the ring has not enough free space, the record is dropped
+   */
+  template <typename Fill>
+  bool push(uint32_t max_len, Fill&& fill)
+  {
+    producer_guard guard(*this);
+    if (not accepting.load()) {
+      return false;
+    }
+
+    const uint64_t size = align(sizeof(header_t) + max_len);
+    if (size > capacity) {
+      return false;
+    }
+
+    uint64_t pos  = head.load(std::memory_order_relaxed);
+    uint64_t skip = 0;
+    do {
+      uint64_t offset = pos & mask;
+      skip            = (offset + size > capacity) ? capacity - offset : 0;
+      if (pos + skip + size - tail.load(std::memory_order_acquire) > capacity) {
+        return false;
+      }
+    } while (not head.compare_exchange_weak(pos, pos + skip + size, std::memory_order_relaxed));
+
+    if (skip > 0) {
+      header_at(pos)->state.store(skip | padding_flag, std::memory_order_release);
+    }
+    header_t* hdr = header_at(pos + skip);
+    hdr->len      = fill(reinterpret_cast<uint8_t*>(hdr + 1));
+    hdr->state.store(size, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Consumes the committed records in order, stops at the first one that is not committed yet. Only one thread may
+   * call this function.
+   * @param consume callable void(const uint8_t* data, uint32_t len)
+   * @return number of records consumed
+   */
+  template <typename Consume>
+  size_t pop_all(Consume&& consume)
+  {
+    size_t   count = 0;
+    uint64_t pos   = tail.load(std::memory_order_relaxed);
+    while (pos != head.load(std::memory_order_acquire)) {
+      header_t* hdr   = header_at(pos);
+      uint64_t  state = hdr->state.load(std::memory_order_acquire);
+      if (state == 0) {
+        break;
+      }
+      uint64_t size = state & ~padding_flag;
+      if ((state & padding_flag) == 0) {
+        consume(reinterpret_cast<const uint8_t*>(hdr + 1), hdr->len);
+        count++;
+      }
+      memset(reinterpret_cast<uint8_t*>(hdr), 0, size);
+      pos += size;
+      tail.store(pos, std::memory_order_release);
+    }
+    return count;
+  }
+
+  bool empty() const { return tail.load(std::memory_order_acquire) == head.load(std::memory_order_acquire); }
+
+private:
+  struct header_t {
+    std::atomic<uint64_t> state; ///< Size of the committed record including the header, 0 if not committed
+    uint32_t              len;   ///< Length of the record data
+    uint32_t              reserved;
+  };
+  static const uint64_t padding_flag = 1ULL << 63U;
+
+  /// Counts the producer as writing into the ring while it is in scope
+  struct producer_guard {
+    explicit producer_guard(pcap_ring& ring_) : ring(ring_) { ring.nof_producers.fetch_add(1); }
+    ~producer_guard() { ring.nof_producers.fetch_sub(1, std::memory_order_release); }
+    pcap_ring& ring;
+  };
+
+  static uint64_t align(uint64_t n) { return (n + sizeof(header_t) - 1) & ~(uint64_t)(sizeof(header_t) - 1); }
+  header_t*       header_at(uint64_t pos) { return reinterpret_cast<header_t*>(buffer + (pos & mask)); }
+
+  uint64_t                    capacity = 0;
+  uint64_t                    mask     = 0;
+  std::unique_ptr<uint64_t[]> storage;
+  uint8_t*                    buffer = nullptr;
+
+  // Both are accessed with sequential consistency, a producer either sees the ring stopped or stop() waits for it
+  std::atomic<bool>     accepting     = {false};
+  std::atomic<uint32_t> nof_producers = {0};
+
+  // Producers and the consumer update different positions, keep them in different cache lines. Padding rather than
+  // alignas, as the owners of the ring are allocated with new, which does not support over-aligned types in C++14
+  std::atomic<uint64_t> head = {0};
+  uint8_t               head_padding[64 - sizeof(std::atomic<uint64_t>)];
+  std::atomic<uint64_t> tail = {0};
+};
+
+/// Rotation of the PCAP files. A new file is started when one of the enabled limits is reached
+struct pcap_rotation_t {
+  uint32_t max_size_mb    = 0; ///< Maximum size of each file in MB, 0 disables the limit
+  uint32_t max_duration_s = 0; ///< Maximum time span of each file in seconds, 0 disables the limit
+};
+
+/**
+ * @brief Asynchronous PCAP file writer shared by the PCAP classes
+ *
+ * Any thread formats complete PCAP records in place into a lock-free ring, without allocations or locks. The writer
+ * thread copies them into a large buffer that is written to the file with a single write() call when it fills up or
+ * when the ring becomes idle. Records are dropped, and counted, when the ring is full. The ring and the batch buffer
+ * are only allocated while the file is open.
+ *
+ * With rotation enabled the first file uses the configured name and the following ones add an index before the
+ * extension, e.g. enb_mac.pcap, enb_mac_1.pcap, enb_mac_2.pcap.
+ */
+class pcap_writer : private srsran::thread
+{
+public:
+  static const size_t default_ring_size = 8 * 1024 * 1024;
+  static const size_t small_ring_size   = 256 * 1024; ///< For the low rate signalling PCAPs
+  static const size_t batch_size        = 256 * 1024;
+
+  pcap_writer(const std::string& thread_name, srslog::basic_logger& logger, size_t ring_size = default_ring_size);
+  ~pcap_writer();
+
+  pcap_writer(const pcap_writer&) = delete;
+  pcap_writer& operator=(const pcap_writer&) = delete;
+
+  /// Creates the file, writes the PCAP file header and starts the writer thread
+  int open(const std::string& filename, uint32_t dlt, const pcap_rotation_t& rotation = {});
+
+  /// Writes the pending records, stops the writer thread and closes the file
+  void close();
+
+  bool               is_open() const { return opened.load(std::memory_order_relaxed); }
+  const std::string& get_filename() const { return filename; }
+  uint32_t           get_dlt() const { return dlt; }
+  uint64_t           get_nof_dropped() const { return nof_dropped.load(std::memory_order_relaxed); }
+
+  /**
+   * Queues a PCAP packet of at most max_len bytes. The PCAP record header is added with the current time.
+   * @param pack callable uint32_t(uint8_t* data) that writes the packet and returns its length
+   * @return false if the writer is closed or the packet was dropped
+   */
+  template <typename Pack>
+  bool write(uint32_t max_len, Pack&& pack)
+  {
+    if (not is_open()) {
+      return false;
+    }
+    bool ret = ring.push(sizeof(pcaprec_hdr_t) + max_len, [&pack](uint8_t* data) {
+      uint32_t       len = pack(data + sizeof(pcaprec_hdr_t));
+      struct timeval t;
+      gettimeofday(&t, nullptr);
+      pcaprec_hdr_t hdr;
+      hdr.ts_sec   = t.tv_sec;
+      hdr.ts_usec  = t.tv_usec;
+      hdr.incl_len = len;
+      hdr.orig_len = len;
+      memcpy(data, &hdr, sizeof(hdr));
+      return (uint32_t)(sizeof(pcaprec_hdr_t) + len);
+    });
+    if (not ret and is_open()) {
+      nof_dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+    return ret;
+  }
+
+private:
+  void run_thread() override;
+  void append(const uint8_t* data, uint32_t len);
+  bool flush();
+  bool open_file();
+  void close_file();
+  void rotate();
+
+  srslog::basic_logger& logger;
+  const size_t          ring_size;
+  pcap_ring             ring;
+
+  // Owned by the writer thread while the file is open
+  std::vector<uint8_t>                  batch;
+  size_t                                batch_len    = 0;
+  int                                   fd           = -1;
+  uint64_t                              file_size    = 0;
+  uint32_t                              file_idx     = 0;
+  uint64_t                              last_dropped = 0;
+  std::chrono::steady_clock::time_point file_start;
+
+  std::string           filename;
+  uint32_t              dlt = 0;
+  pcap_rotation_t       rotation;
+  std::atomic<bool>     opened      = {false};
+  std::atomic<bool>     running     = {false};
+  std::atomic<uint64_t> nof_dropped = {0};
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_PCAP_WRITER_H
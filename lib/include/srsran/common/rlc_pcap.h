@@ -22,7 +22,7 @@
 #ifndef RLCPCAP_H
 #define RLCPCAP_H
 
-#include "srsran/common/pcap.h"
+#include "srsran/common/pcap_writer.h"
 #include "srsran/interfaces/rlc_interface_types.h"
 #include <stdint.h>
 
@@ -31,7 +31,7 @@ namespace srsran {
 class rlc_pcap
 {
 public:
-  rlc_pcap() {}
+  rlc_pcap();
   void enable(bool en);
   void open(const char* filename, const rlc_config_t& config);
   void close();
@@ -42,9 +42,9 @@ public:
   void write_ul_ccch(uint8_t* pdu, uint32_t pdu_len_bytes);
 
 private:
-  bool     enable_write = false;
-  FILE*    pcap_file    = nullptr;
-  uint32_t ue_id        = 0;
+  bool        enable_write = false;
+  pcap_writer writer;
+  uint32_t    ue_id = 0;
   uint8_t  mode         = 0;
   uint8_t  sn_length    = 0;
   void     pack_and_write(uint8_t* pdu,
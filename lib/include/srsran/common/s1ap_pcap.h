@@ -22,7 +22,7 @@
 #ifndef SRSRAN_S1AP_PCAP_H
 #define SRSRAN_S1AP_PCAP_H
 
-#include "srsran/common/pcap.h"
+#include "srsran/common/pcap_writer.h"
 #include <string>
 
 namespace srsran {
@@ -37,14 +37,13 @@ public:
   s1ap_pcap& operator=(s1ap_pcap&& other) = delete;
 
   void enable();
-  void open(const char* filename_);
+  void open(const char* filename_, const pcap_rotation_t& rotation = {});
   void close();
   void write_s1ap(uint8_t* pdu, uint32_t pdu_len_bytes);
 
 private:
   bool        enable_write = false;
-  std::string filename;
-  FILE*       pcap_file = nullptr;
+  pcap_writer writer;
 };
 
 } // namespace srsran
@@ -0,0 +1,149 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_STAGE_PROFILER_H
+#define SRSRAN_STAGE_PROFILER_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace srsran {
+
+/// Reads a free running counter: the CPU time stamp counter on x86, a monotonic nanosecond clock otherwise
+inline uint64_t read_cycle_counter()
+{
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+#endif
+}
+
+/**
+ * @brief Accumulates the time spent in a fixed set of processing stages
+ *
+ * Durations are measured in cycles of read_cycle_counter() and kept per stage as a number of samples, a sum, a
+ * maximum and a log-linear microsecond histogram. Every power of two range is split in nof_sub_buckets buckets of equal
+ * width, so a percentile read from the histogram is off by at most 1 us or 1/nof_sub_buckets of its value. Samples can
+ * be added from any thread, the counters are relaxed atomics and the processing path takes no lock. The counter rate is
+ * calibrated against the steady clock at construction and refined every time the metrics are read.
+ *
+ * A processing thread usually times its stages into a period_t and commits it once per TTI, so every sample is the
+ * time spent in a stage during one TTI.
+ */
+class stage_profiler
+{
+public:
+  static const uint32_t max_stages = 16;
+
+  /// Durations below 2 * nof_sub_buckets us have 1 us buckets, each power of two range above has nof_sub_buckets
+  static const uint32_t nof_sub_buckets_log2 = 3;
+  static const uint32_t nof_sub_buckets      = 1U << nof_sub_buckets_log2;
+  /// Durations of 2^max_us_log2 us or more fall in the last bucket, which has no upper bound
+  static const uint32_t max_us_log2 = 12;
+  static const uint32_t nof_buckets = nof_sub_buckets * (max_us_log2 - nof_sub_buckets_log2 + 1) + 1;
+
+  struct stage_metrics_t {
+    uint32_t                          count     = 0;
+    float                             avg_us    = 0.0f;
+    float                             p99_us    = 0.0f; ///< Upper edge of the bucket holding the 99th percentile
+    float                             max_us    = 0.0f;
+    std::array<uint32_t, nof_buckets> histogram = {};
+  };
+
+  /// Cycles spent in each stage during one processing period, owned by a single thread
+  class period_t
+  {
+  public:
+    void add(uint32_t stage, uint64_t nof_cycles) { cycles[stage] += nof_cycles; }
+
+  private:
+    friend class stage_profiler;
+    std::array<uint64_t, max_stages> cycles = {};
+  };
+
+  /// Adds the lifetime of the object to a stage of a period
+  class scoped_timer
+  {
+  public:
+    scoped_timer(period_t& period_, uint32_t stage_) : period(period_), stage(stage_), start(read_cycle_counter()) {}
+    scoped_timer(const scoped_timer&) = delete;
+    scoped_timer& operator=(const scoped_timer&) = delete;
+    ~scoped_timer() { period.add(stage, read_cycle_counter() - start); }
+
+  private:
+    period_t& period;
+    uint32_t  stage;
+    uint64_t  start;
+  };
+
+  explicit stage_profiler(uint32_t nof_stages);
+  stage_profiler(const stage_profiler&) = delete;
+  stage_profiler& operator=(const stage_profiler&) = delete;
+
+  uint32_t nof_stages() const { return nof_stages_; }
+
+  /// Adds one sample to a stage
+  void add(uint32_t stage, uint64_t nof_cycles);
+
+  /// Adds one sample to every stage that ran during the period and clears it
+  void commit(period_t& period);
+
+  /// Returns the metrics of each stage accumulated since the last call and resets them
+  std::vector<stage_metrics_t> get_metrics();
+
+  /// Histogram bucket of a duration in whole microseconds
+  static uint32_t bucket_index(uint64_t us);
+
+  /// Lower edge of a histogram bucket in microseconds
+  static float bucket_lower_us(uint32_t bucket);
+
+  /// Upper edge of a histogram bucket in microseconds, infinity for the last bucket
+  static float bucket_upper_us(uint32_t bucket);
+
+private:
+  struct stage_stats_t {
+    std::atomic<uint32_t>                          count      = {0};
+    std::atomic<uint64_t>                          sum_cycles = {0};
+    std::atomic<uint64_t>                          max_cycles = {0};
+    std::array<std::atomic<uint32_t>, nof_buckets> histogram  = {};
+  };
+
+  void calibrate();
+
+  uint32_t                              nof_stages_;
+  std::array<stage_stats_t, max_stages> stats;
+  std::atomic<double>                   us_per_cycle = {0.0};
+  std::chrono::steady_clock::time_point calib_time;
+  uint64_t                              calib_cycles = 0;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_STAGE_PROFILER_H
@@ -30,13 +30,77 @@
 
 namespace srsran {
 
+/**
+ * Priority classes of the tasks run by the task scheduler. The queues of a class are only serviced when the queues of
+ * the classes before it are empty, or when those classes have used up their time budget of the current tick.
+ */
+enum class task_priority : uint32_t {
+  tti_critical = 0, ///< TTI processing, always serviced first
+  control,          ///< Control plane and the handling of the outcomes of background tasks
+  bulk,             ///< User plane and metrics
+  nof_priorities
+};
+inline const char* to_string(task_priority prio)
+{
+  switch (prio) {
+    case task_priority::tti_critical:
+      return "tti_critical";
+    case task_priority::control:
+      return "control";
+    case task_priority::bulk:
+      return "bulk";
+    default:
+      return "invalid";
+  }
+}
+
+/// Statistics of the tasks of a priority class
+struct task_class_metrics_t {
+  static const uint32_t nof_bins = 16;
+
+  uint64_t nof_tasks            = 0;
+  uint64_t nof_budget_exhausted = 0; ///< Number of ticks in which the class used up its time budget
+  uint64_t max_latency_us       = 0; ///< Maximum time a task waited in its queue
+  /// Bin i counts the tasks that waited in their queue less than 2^i us, the last bin counts the rest
+  std::array<uint64_t, nof_bins> latency_hist = {};
+
+  void add_latency(std::chrono::steady_clock::duration latency)
+  {
+    uint64_t us    = std::chrono::duration_cast<std::chrono::microseconds>(latency).count();
+    uint32_t bin   = 0;
+    max_latency_us = std::max(max_latency_us, us);
+    while (bin < nof_bins - 1 and us >= (1ULL << bin)) {
+      bin++;
+    }
+    latency_hist[bin]++;
+    nof_tasks++;
+  }
+
+  /// Upper bound of the given percentile (0-100) of the queueing latency, in us
+  uint64_t latency_percentile_us(float percentile) const
+  {
+    uint64_t target = static_cast<uint64_t>(nof_tasks * percentile / 100);
+    uint64_t count  = 0;
+    for (uint32_t bin = 0; bin < nof_bins - 1; ++bin) {
+      count += latency_hist[bin];
+      if (count > target) {
+        return 1ULL << bin;
+      }
+    }
+    return max_latency_us;
+  }
+};
+
 class task_scheduler
 {
 public:
   explicit task_scheduler(uint32_t default_extern_tasks_size = 512, uint32_t nof_timers_prealloc = 100) :
-    external_tasks{default_extern_tasks_size}, timers{nof_timers_prealloc}, internal_tasks(512)
+    default_queue_size(default_extern_tasks_size),
+    external_tasks{default_extern_tasks_size},
+    timers{nof_timers_prealloc},
+    internal_tasks(512)
   {
-    background_queue = external_tasks.add_queue();
+    background_queue = make_task_queue(task_priority::control);
   }
   task_scheduler(const task_scheduler&) = delete;
   task_scheduler(task_scheduler&&)      = delete;
@@ -48,8 +112,26 @@ public:
   srsran::unique_timer get_unique_timer() { return timers.get_unique_timer(); }
 
   //! Creates new queue for tasks coming from external thread
-  srsran::task_queue_handle make_task_queue() { return external_tasks.add_queue(); }
-  srsran::task_queue_handle make_task_queue(uint32_t qsize) { return external_tasks.add_queue(qsize); }
+  srsran::task_queue_handle make_task_queue(task_priority prio = task_priority::control)
+  {
+    return make_task_queue(default_queue_size, prio);
+  }
+  srsran::task_queue_handle make_task_queue(uint32_t qsize, task_priority prio = task_priority::control)
+  {
+    return external_tasks.add_queue(qsize, static_cast<uint32_t>(prio));
+  }
+
+  //! Limits the time spent in the tasks of a priority class per tic. A zero budget disables the limit
+  void set_task_budget(task_priority prio, std::chrono::microseconds budget)
+  {
+    classes[static_cast<uint32_t>(prio)].budget = budget;
+  }
+
+  //! Statistics of the tasks of a priority class. CAUTION: Should be called in main thread
+  const task_class_metrics_t& get_task_metrics(task_priority prio) const
+  {
+    return classes[static_cast<uint32_t>(prio)].metrics;
+  }
 
   //! Delays a task processing by duration_ms
   template <typename F>
@@ -73,18 +155,25 @@ public:
     background_queue.push(std::move(task));
   }
 
-  //! Updates timers, and run any pending internal tasks.
+  //! Updates timers, and starts a new time budget period for all task classes.
   //  CAUTION: Should be called in main thread
-  void tic() { timers.step_all(); }
+  void tic()
+  {
+    timers.step_all();
+    for (auto& c : classes) {
+      c.used = {};
+    }
+    budget_mask = srsran::task_multiqueue::all_classes;
+  }
 
-  //! Processes the next task in the multiqueue.
+  //! Processes the next task in the multiqueue, in order of priority class.
   //  CAUTION: This is a blocking call
   bool run_next_task()
   {
-    srsran::move_task_t task{};
-    if (external_tasks.wait_pop(&task)) {
-      task();
-      run_all_internal_tasks();
+    srsran::move_task_t         task{};
+    srsran::multiqueue_pop_info info;
+    if (external_tasks.wait_pop(&task, budget_mask, &info)) {
+      run_task(task, info);
       return true;
     }
     run_all_internal_tasks();
@@ -95,16 +184,41 @@ public:
   void run_pending_tasks()
   {
     run_all_internal_tasks();
-    srsran::move_task_t task{};
-    while (external_tasks.try_pop(&task)) {
-      task();
-      run_all_internal_tasks();
+    srsran::move_task_t         task{};
+    srsran::multiqueue_pop_info info;
+    while (external_tasks.try_pop(&task, srsran::task_multiqueue::all_classes, &info)) {
+      run_task(task, info);
     }
   }
 
   srsran::timer_handler* get_timer_handler() { return &timers; }
 
 private:
+  struct task_class_t {
+    std::chrono::microseconds           budget{0};
+    std::chrono::steady_clock::duration used{0};
+    task_class_metrics_t                metrics;
+  };
+
+  void run_task(srsran::move_task_t& task, const srsran::multiqueue_pop_info& info)
+  {
+    task_class_t& c     = classes[info.queue_class];
+    auto          start = std::chrono::steady_clock::now();
+    c.metrics.add_latency(start - info.push_time);
+
+    task();
+    run_all_internal_tasks();
+
+    if (c.budget.count() > 0 and (budget_mask & (1U << info.queue_class)) != 0) {
+      c.used += std::chrono::steady_clock::now() - start;
+      if (c.used >= c.budget) {
+        // the class is not serviced again until the next tic
+        budget_mask &= ~(1U << info.queue_class);
+        c.metrics.nof_budget_exhausted++;
+      }
+    }
+  }
+
   // Perform pending stack deferred tasks
   void run_all_internal_tasks()
   {
@@ -114,11 +228,15 @@ private:
     }
   }
 
+  uint32_t                  default_queue_size;
   srsran::task_multiqueue   external_tasks;
   srsran::task_queue_handle background_queue; ///< Queue for handling the outcomes of tasks run in the background
   srsran::timer_handler     timers;
   srsran::dyn_blocking_queue<srsran::move_task_t>
       internal_tasks; ///< enqueues stack tasks from within main thread. Avoids locking
+
+  std::array<task_class_t, static_cast<uint32_t>(task_priority::nof_priorities)> classes;
+  uint32_t budget_mask = srsran::task_multiqueue::all_classes; ///< Classes that have budget left in this tic
 };
 
 //! Task scheduler handle given to classes/functions running within the main control thread
@@ -138,7 +256,10 @@ public:
     sched->defer_callback(duration_ms, std::forward<F>(func));
   }
   void                      defer_task(srsran::move_task_t func) { sched->defer_task(std::move(func)); }
-  srsran::task_queue_handle make_task_queue() { return sched->make_task_queue(); }
+  srsran::task_queue_handle make_task_queue(task_priority prio = task_priority::control)
+  {
+    return sched->make_task_queue(prio);
+  }
 
 private:
   task_scheduler* sched;
@@ -155,7 +276,10 @@ public:
   {
     sched->notify_background_task_result(std::move(task));
   }
-  srsran::task_queue_handle make_task_queue() { return sched->make_task_queue(); }
+  srsran::task_queue_handle make_task_queue(task_priority prio = task_priority::control)
+  {
+    return sched->make_task_queue(prio);
+  }
   template <typename F>
   void defer_callback(uint32_t duration_ms, F&& func)
   {
@@ -34,6 +34,7 @@
 #include "srsran/srslog/srslog.h"
 #include <atomic>
 #include <condition_variable>
+#include <deque>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -119,7 +120,9 @@ public:
   void start(int32_t prio_ = -1, uint32_t mask_ = 255);
   void set_nof_workers(uint32_t nof_workers);
 
-  void     push_task(task_t&& task);
+  bool     push_task(task_t&& task);
+  /// Same as push_task(), but a full queue is not logged, the caller is expected to handle it
+  bool     try_push_task(task_t&& task);
   uint32_t nof_pending_tasks() const;
   size_t   nof_workers() const { return workers.size(); }
 
@@ -187,6 +190,50 @@ private:
   srsran::dyn_blocking_queue<task_t> pending_tasks;
 };
 
+/**
+ * Queue of tasks that run in the workers of a task_thread_pool one at a time and in the order they were pushed. Tasks
+ * of different queues run in parallel, so a queue per context (e.g. per UE) gives the ordering guarantees of a
+ * dedicated thread without one thread per context.
+ * The tasks that have not started when the queue is destroyed are discarded, the running one is not waited for.
+ * If the pool queue is full, the tasks run in the thread that pushes them instead.
+ */
+class serial_task_queue
+{
+  using task_t = srsran::move_task_t;
+
+public:
+  explicit serial_task_queue(task_thread_pool& pool_);
+  serial_task_queue(const serial_task_queue&) = delete;
+  serial_task_queue& operator=(const serial_task_queue&) = delete;
+  ~serial_task_queue();
+
+  void   push_task(task_t&& task);
+  size_t nof_pending_tasks() const;
+
+  /// Handle that expires when the queue is destroyed, so that results of its tasks can detect a destroyed owner
+  std::weak_ptr<void> alive_token() const { return alive; }
+
+private:
+  /// Maximum number of tasks run in a row before the worker is handed to other queues
+  static const uint32_t max_tasks_per_run = 16;
+
+  struct state_t {
+    explicit state_t(task_thread_pool& pool_) : pool(pool_) {}
+    task_thread_pool&  pool;
+    mutable std::mutex mutex;
+    std::deque<task_t> tasks;
+    bool               scheduled = false;
+    bool               stopped   = false;
+  };
+
+  static void schedule(const std::shared_ptr<state_t>& state);
+  static void run_tasks(const std::shared_ptr<state_t>& state);
+
+  // The state outlives the queue while a worker runs its tasks, the token does not
+  std::shared_ptr<state_t> state;
+  std::shared_ptr<bool>    alive;
+};
+
 srsran::task_thread_pool& get_background_workers();
 
 } // namespace srsran
@@ -25,6 +25,9 @@
 #include <cstdint>
 
 namespace srsenb {
+
+struct stack_mem_footprint_t;
+
 class enb_command_interface
 {
 public:
@@ -36,6 +39,13 @@ public:
   virtual void cmd_cell_gain(uint32_t cell_id, float gain) = 0;
 
   virtual void toggle_padding() = 0;
+
+  /**
+   * Gets the memory held by the UE contexts of each layer of the stack.
+   * @param footprint Bytes per layer and number of connected UEs
+   * @return false if the stack could not be queried
+   */
+  virtual bool cmd_mem_footprint(stack_mem_footprint_t* footprint) = 0;
 };
 } // namespace srsenb
 
@@ -32,6 +32,7 @@ struct mac_args_t {
   sched_interface::sched_args_t sched;
   int                           lcid_padding;
   uint32_t                      nof_prealloc_ues; ///< Number of UE resources to pre-allocate at eNB startup
+  bool                          compact_ue_ctx;   ///< Allocate per-UE buffers on demand and release the idle ones
   uint32_t                      max_nof_kos;
   int                           rlf_min_ul_snr_estim;
 };
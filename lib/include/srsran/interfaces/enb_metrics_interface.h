@@ -52,15 +52,32 @@ struct stack_metrics_t {
   rlc_metrics_t  rlc;
   pdcp_metrics_t pdcp;
   s1ap_metrics_t s1ap;
+
+  /// Positions in the full MAC UE list of the UEs reported, empty if every UE is reported
+  std::vector<uint32_t> ue_idxs;
+};
+
+/// Bytes held by the UE contexts of each layer of the stack
+struct stack_mem_footprint_t {
+  uint32_t nof_ues = 0;
+  size_t   mac     = 0;
+  size_t   sched   = 0;
+  size_t   rlc     = 0;
+  size_t   pdcp    = 0;
+  size_t   rrc     = 0;
+  size_t   s1ap    = 0;
+
+  size_t total() const { return mac + sched + rlc + pdcp + rrc + s1ap; }
 };
 
 struct enb_metrics_t {
-  srsran::rf_metrics_t       rf;
-  std::vector<phy_metrics_t> phy;
-  stack_metrics_t            stack;
-  stack_metrics_t            nr_stack;
-  srsran::sys_metrics_t      sys;
-  bool                       running;
+  srsran::rf_metrics_t             rf;
+  std::vector<phy_metrics_t>       phy;
+  std::vector<phy_stage_metrics_t> phy_stages; ///< Indexed by phy_stage_t
+  stack_metrics_t                  stack;
+  stack_metrics_t                  nr_stack;
+  srsran::sys_metrics_t            sys;
+  bool                             running;
 };
 
 // ENB interface
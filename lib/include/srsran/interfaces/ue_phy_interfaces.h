@@ -49,11 +49,12 @@ struct phy_args_t {
   float dl_freq = -1.0f;
   float ul_freq = -1.0f;
 
-  bool     ul_pwr_ctrl_en  = false;
-  float    prach_gain      = -1;
-  uint32_t pdsch_max_its   = 8;
-  bool     meas_evm        = false;
-  uint32_t nof_phy_threads = 3;
+  bool     ul_pwr_ctrl_en    = false;
+  float    prach_gain        = -1;
+  uint32_t pdsch_max_its     = 8;
+  bool     meas_evm          = false;
+  uint32_t nof_phy_threads   = 3;
+  uint32_t nof_dl_fe_threads = 0;
 
   int worker_cpu_mask   = -1;
   int sync_cpu_affinity = -1;
@@ -72,6 +73,7 @@ struct phy_args_t {
   bool        cfo_is_doppler               = false;
   bool        cfo_integer_enabled          = false;
   float       cfo_correct_tol_hz           = 1.0f;
+  bool        cfo_correct_in_demod         = false;
   float       cfo_pss_ema                  = DEFAULT_CFO_EMA_TRACK;
   float       cfo_loop_bw_pss              = DEFAULT_CFO_BW_PSS;
   float       cfo_loop_bw_ref              = DEFAULT_CFO_BW_REF;
@@ -76,6 +76,10 @@ typedef struct {
   cf_t* pilot_known_signal;
   cf_t* tmp_noise;
 
+  // Maximum ratio combining, averaged estimates turned into combining weights and the resulting channel gain
+  cf_t* mrc_weights[SRSRAN_MAX_PORTS];
+  cf_t* mrc_gain;
+
 #ifdef FREQ_SEL_SNR
   float snr_vector[12000];
   float pilot_power[12000];
@@ -103,12 +107,45 @@ SRSRAN_API void srsran_chest_ul_pregen(srsran_chest_ul_t*                 q,
                                        srsran_refsignal_dmrs_pusch_cfg_t* cfg,
                                        srsran_refsignal_srs_cfg_t*        srs_cfg);
 
+/**
+ * @brief Loads the PUSCH DMRS pre-generated for the cell instead of generating them, the table is packed with
+ * srsran_refsignal_dmrs_pusch_pregen_pack() for the same cell and DMRS configuration
+ */
+SRSRAN_API int srsran_chest_ul_pregen_load(srsran_chest_ul_t* q, const uint8_t* dmrs_table);
+
 SRSRAN_API int srsran_chest_ul_estimate_pusch(srsran_chest_ul_t*     q,
                                               srsran_ul_sf_cfg_t*    sf,
                                               srsran_pusch_cfg_t*    cfg,
                                               cf_t*                  input,
                                               srsran_chest_ul_res_t* res);
 
+/**
+ * Estimates the PUSCH channel of several receive antennas and combines them with Maximum Ratio Combining (MRC). Every
+ * resource element of the PUSCH allocation in output is the combination of the received grids weighted by the
+ * conjugated channel of each antenna, normalised by the combined channel gain, which is written in res->ce. The output
+ * grid and res can be passed to srsran_pusch_decode(), whose single antenna MMSE/ZF equalization then results in the
+ * multi-antenna MMSE/ZF estimate of the transmitted symbols.
+ *
+ * Only the resource elements of the PUSCH allocation (excluding the DMRS) are written in output and res->ce. The
+ * output grid may be the grid of one of the antennas.
+ *
+ * @param q Uplink Channel estimation instance
+ * @param sf Uplink subframe configuration
+ * @param cfg PUSCH configuration
+ * @param input Received resource grid of each antenna
+ * @param nof_rx_ant Number of receive antennas
+ * @param output Combined resource grid
+ * @param res UL channel estimation result, the SNR is the one after combining
+ * @return SRSRAN_SUCCESS if no error occurs, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_chest_ul_estimate_pusch_mrc(srsran_chest_ul_t*     q,
+                                                  srsran_ul_sf_cfg_t*    sf,
+                                                  srsran_pusch_cfg_t*    cfg,
+                                                  cf_t*                  input[SRSRAN_MAX_PORTS],
+                                                  uint32_t               nof_rx_ant,
+                                                  cf_t*                  output,
+                                                  srsran_chest_ul_res_t* res);
+
 SRSRAN_API int srsran_chest_ul_estimate_pucch(srsran_chest_ul_t*     q,
                                               srsran_ul_sf_cfg_t*    sf,
                                               srsran_pucch_cfg_t*    cfg,
@@ -96,6 +96,8 @@ SRSRAN_API uint32_t srsran_refsignal_dmrs_N_rs(srsran_pucch_format_t format, srs
 
 SRSRAN_API uint32_t srsran_refsignal_dmrs_pucch_symbol(uint32_t m, srsran_pucch_format_t format, srsran_cp_t cp);
 
+SRSRAN_API float srsran_refsignal_dmrs_pucch_format1_w_arg(uint32_t m, uint32_t n_oc, srsran_cp_t cp);
+
 SRSRAN_API int srsran_refsignal_dmrs_pusch_pregen_init(srsran_refsignal_ul_dmrs_pregen_t* pregen, uint32_t max_prb);
 
 SRSRAN_API int srsran_refsignal_dmrs_pusch_pregen(srsran_refsignal_ul_t*             q,
@@ -105,6 +107,35 @@ SRSRAN_API int srsran_refsignal_dmrs_pusch_pregen(srsran_refsignal_ul_t*
 SRSRAN_API void srsran_refsignal_dmrs_pusch_pregen_free(srsran_refsignal_ul_t*             q,
                                                         srsran_refsignal_ul_dmrs_pregen_t* pregen);
 
+/**
+ * @brief Layout version of the packed pre-generated PUSCH DMRS, it changes whenever the packing does so that tables
+ * stored by other builds are not unpacked
+ */
+#define SRSRAN_REFSIGNAL_DMRS_PUSCH_PREGEN_FORMAT 1
+
+/**
+ * @brief Number of bytes of the pre-generated PUSCH DMRS of a cell with nof_prb PRB once packed in a single buffer
+ */
+SRSRAN_API uint32_t srsran_refsignal_dmrs_pusch_pregen_nof_bytes(uint32_t nof_prb);
+
+/**
+ * @brief Packs the pre-generated PUSCH DMRS of a cell with nof_prb PRB in a contiguous buffer, so that it can be copied
+ * to other objects or stored without generating it again
+ * @return SRSRAN_SUCCESS if the table was packed, SRSRAN_ERROR otherwise
+ */
+SRSRAN_API int srsran_refsignal_dmrs_pusch_pregen_pack(const srsran_refsignal_ul_dmrs_pregen_t* pregen,
+                                                       uint32_t                                 nof_prb,
+                                                       uint8_t*                                 buffer);
+
+/**
+ * @brief Unpacks the pre-generated PUSCH DMRS of a cell with nof_prb PRB packed with
+ * srsran_refsignal_dmrs_pusch_pregen_pack()
+ * @return SRSRAN_SUCCESS if the table was unpacked, SRSRAN_ERROR otherwise
+ */
+SRSRAN_API int srsran_refsignal_dmrs_pusch_pregen_unpack(srsran_refsignal_ul_dmrs_pregen_t* pregen,
+                                                         uint32_t                           nof_prb,
+                                                         const uint8_t*                     buffer);
+
 SRSRAN_API int srsran_refsignal_dmrs_pusch_pregen_put(srsran_refsignal_ul_t*             q,
                                                       srsran_ul_sf_cfg_t*                sf_cfg,
                                                       srsran_refsignal_ul_dmrs_pregen_t* pregen,
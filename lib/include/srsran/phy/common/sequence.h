@@ -83,6 +83,94 @@ SRSRAN_API void srsran_sequence_apply_packed(const uint8_t* in, uint8_t* out, ui
 
 SRSRAN_API void srsran_sequence_apply_bit(const uint8_t* in, uint8_t* out, uint32_t length, uint32_t seed);
 
+/*
+ * Cache of the pseudo-random sequences of the users, one sequence per user and index (e.g. the subframe). The cache is
+ * fully associative with least recently used replacement, so any set of RNTIs shares it without colliding. It is
+ * created for at most nof_users users and holds nof_idx sequences for each of the users set with
+ * srsran_sequence_cache_set_nof_users(), which bounds the memory to the connected users. Sequences are only generated
+ * up to the requested length, a longer request extends the cached sequence and a different seed (e.g. another cell)
+ * regenerates it. The memory of a user is returned when it is released or evicted by a smaller user count.
+ */
+#define SRSRAN_SEQUENCE_CACHE_NOF_USERS (64)
+
+typedef struct SRSRAN_API {
+  uint16_t                rnti;
+  uint32_t                idx;
+  uint32_t                seed;
+  uint32_t                len;      // Number of generated sequence bits, 0 if the entry is empty
+  uint32_t                cap;      // Number of bits the words can hold
+  uint64_t                last_use; // Access count of the cache at the last use of the entry
+  srsran_sequence_state_t state;    // Generator state after the last generated bit
+  uint64_t*               words;    // Packed sequence, 64 bits per word starting from the LSB
+} srsran_sequence_cache_entry_t;
+
+typedef struct SRSRAN_API {
+  srsran_sequence_cache_entry_t* entries;
+  uint32_t                       max_entries; // Number of allocated entries, nof_users * nof_idx
+  uint32_t                       nof_entries; // Number of entries in use for the current number of users
+  uint32_t                       nof_idx;
+  uint32_t                       max_len;
+  uint64_t                       nof_uses;
+} srsran_sequence_cache_t;
+
+SRSRAN_API int
+srsran_sequence_cache_init(srsran_sequence_cache_t* q, uint32_t nof_users, uint32_t nof_idx, uint32_t max_len);
+
+SRSRAN_API void srsran_sequence_cache_free(srsran_sequence_cache_t* q);
+
+SRSRAN_API void srsran_sequence_cache_reset(srsran_sequence_cache_t* q);
+
+/* Limits the cache to the sequences of the given number of users, at most the number given at initialisation. The least
+ * recently used sequences beyond the limit are freed. */
+SRSRAN_API void srsran_sequence_cache_set_nof_users(srsran_sequence_cache_t* q, uint32_t nof_users);
+
+/* Frees the sequences of the given RNTI, e.g. when the user is removed */
+SRSRAN_API void srsran_sequence_cache_release(srsran_sequence_cache_t* q, uint16_t rnti);
+
+/*
+ * The following functions apply the sequence of the given seed, cached in the entry of the given RNTI and index.
+ * Lengths greater than the cache maximum length and non-initialised caches fall back to generating the sequence.
+ */
+SRSRAN_API void srsran_sequence_cache_apply_f(srsran_sequence_cache_t* q,
+                                              const float*             in,
+                                              float*                   out,
+                                              uint32_t                 length,
+                                              uint16_t                 rnti,
+                                              uint32_t                 idx,
+                                              uint32_t                 seed);
+
+SRSRAN_API void srsran_sequence_cache_apply_s(srsran_sequence_cache_t* q,
+                                              const int16_t*           in,
+                                              int16_t*                 out,
+                                              uint32_t                 length,
+                                              uint16_t                 rnti,
+                                              uint32_t                 idx,
+                                              uint32_t                 seed);
+
+SRSRAN_API void srsran_sequence_cache_apply_c(srsran_sequence_cache_t* q,
+                                              const int8_t*            in,
+                                              int8_t*                  out,
+                                              uint32_t                 length,
+                                              uint16_t                 rnti,
+                                              uint32_t                 idx,
+                                              uint32_t                 seed);
+
+SRSRAN_API void srsran_sequence_cache_apply_packed(srsran_sequence_cache_t* q,
+                                                   const uint8_t*           in,
+                                                   uint8_t*                 out,
+                                                   uint32_t                 length,
+                                                   uint16_t                 rnti,
+                                                   uint32_t                 idx,
+                                                   uint32_t                 seed);
+
+SRSRAN_API void srsran_sequence_cache_apply_bit(srsran_sequence_cache_t* q,
+                                                const uint8_t*           in,
+                                                uint8_t*                 out,
+                                                uint32_t                 length,
+                                                uint16_t                 rnti,
+                                                uint32_t                 idx,
+                                                uint32_t                 seed);
+
 SRSRAN_API int srsran_sequence_pbch(srsran_sequence_t* seq, srsran_cp_t cp, uint32_t cell_id);
 
 SRSRAN_API int srsran_sequence_pcfich(srsran_sequence_t* seq, uint32_t nslot, uint32_t cell_id);
@@ -126,6 +214,33 @@ SRSRAN_API void srsran_sequence_pdsch_apply_c(const int8_t* in,
                                               uint32_t      cell_id,
                                               uint32_t      len);
 
+SRSRAN_API void srsran_sequence_pdsch_cache_apply_pack(srsran_sequence_cache_t* cache,
+                                                       const uint8_t*           in,
+                                                       uint8_t*                 out,
+                                                       uint16_t                 rnti,
+                                                       int                      q,
+                                                       uint32_t                 nslot,
+                                                       uint32_t                 cell_id,
+                                                       uint32_t                 len);
+
+SRSRAN_API void srsran_sequence_pdsch_cache_apply_s(srsran_sequence_cache_t* cache,
+                                                    const int16_t*           in,
+                                                    int16_t*                 out,
+                                                    uint16_t                 rnti,
+                                                    int                      q,
+                                                    uint32_t                 nslot,
+                                                    uint32_t                 cell_id,
+                                                    uint32_t                 len);
+
+SRSRAN_API void srsran_sequence_pdsch_cache_apply_c(srsran_sequence_cache_t* cache,
+                                                    const int8_t*            in,
+                                                    int8_t*                  out,
+                                                    uint16_t                 rnti,
+                                                    int                      q,
+                                                    uint32_t                 nslot,
+                                                    uint32_t                 cell_id,
+                                                    uint32_t                 len);
+
 SRSRAN_API int
 srsran_sequence_pusch(srsran_sequence_t* seq, uint16_t rnti, uint32_t nslot, uint32_t cell_id, uint32_t len);
 
@@ -153,6 +268,37 @@ SRSRAN_API void srsran_sequence_pusch_apply_s(const int16_t* in,
 SRSRAN_API void
 srsran_sequence_pusch_gen_unpack(uint8_t* out, uint16_t rnti, uint32_t nslot, uint32_t cell_id, uint32_t len);
 
+SRSRAN_API void srsran_sequence_pusch_cache_apply_pack(srsran_sequence_cache_t* cache,
+                                                       const uint8_t*           in,
+                                                       uint8_t*                 out,
+                                                       uint16_t                 rnti,
+                                                       uint32_t                 nslot,
+                                                       uint32_t                 cell_id,
+                                                       uint32_t                 len);
+
+SRSRAN_API void srsran_sequence_pusch_cache_apply_c(srsran_sequence_cache_t* cache,
+                                                    const int8_t*            in,
+                                                    int8_t*                  out,
+                                                    uint16_t                 rnti,
+                                                    uint32_t                 nslot,
+                                                    uint32_t                 cell_id,
+                                                    uint32_t                 len);
+
+SRSRAN_API void srsran_sequence_pusch_cache_apply_s(srsran_sequence_cache_t* cache,
+                                                    const int16_t*           in,
+                                                    int16_t*                 out,
+                                                    uint16_t                 rnti,
+                                                    uint32_t                 nslot,
+                                                    uint32_t                 cell_id,
+                                                    uint32_t                 len);
+
+SRSRAN_API void srsran_sequence_pusch_cache_gen_unpack(srsran_sequence_cache_t* cache,
+                                                       uint8_t*                 out,
+                                                       uint16_t                 rnti,
+                                                       uint32_t                 nslot,
+                                                       uint32_t                 cell_id,
+                                                       uint32_t                 len);
+
 SRSRAN_API int srsran_sequence_pucch(srsran_sequence_t* seq, uint16_t rnti, uint32_t nslot, uint32_t cell_id);
 
 SRSRAN_API int srsran_sequence_pmch(srsran_sequence_t* seq, uint32_t nslot, uint32_t mbsfn_id, uint32_t len);
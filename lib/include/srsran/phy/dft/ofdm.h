@@ -87,6 +87,71 @@ typedef struct SRSRAN_API {
   cf_t              phase_compensation[SRSRAN_MAX_NSYMB * SRSRAN_NOF_SLOTS_PER_SF];
 } srsran_ofdm_t;
 
+/**
+ * @struct srsran_ofdm_tx_batch_t
+ * Multi-port OFDM modulator for normal subframes. The output scaling is applied while the resource grid is mapped into
+ * the inverse-DFT input, each slot of each port is transformed with a batched plan that writes every symbol straight
+ * into its place in the output buffer, and the cyclic prefix is inserted afterwards. The DC subcarrier is skipped,
+ * frequency shift and phase compensation are not supported.
+ */
+typedef struct SRSRAN_API {
+  uint32_t          max_prb;
+  uint32_t          max_ports;
+  uint32_t          nof_prb;
+  uint32_t          nof_ports;
+  srsran_cp_t       cp;
+  uint32_t          symbol_sz;
+  uint32_t          nof_symbols; ///< Number of symbols in a slot
+  uint32_t          nof_re;
+  uint32_t          slot_sz;
+  uint32_t          sf_sz;
+  float             scale;
+  cf_t*             in_buffer[SRSRAN_MAX_PORTS];
+  cf_t*             out_buffer[SRSRAN_MAX_PORTS];
+  cf_t*             tmp; ///< Inverse-DFT input of one slot, shared by all plans
+  srsran_dft_plan_t plan[SRSRAN_MAX_PORTS][SRSRAN_NOF_SLOTS_PER_SF];
+} srsran_ofdm_tx_batch_t;
+
+/**
+ * @brief Initialises the multi-port OFDM modulator
+ *
+ * @param q OFDM modulator object
+ * @param in_buffer Resource grid of every port, each of them holds one subframe of max_prb
+ * @param out_buffer Baseband output of every port, each of them holds one subframe of max_prb
+ * @param max_ports Maximum number of ports
+ * @param max_prb Maximum number of PRB
+ * @return SRSRAN_SUCCESS if the initialization is successful, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_ofdm_tx_batch_init(srsran_ofdm_tx_batch_t* q,
+                                         cf_t*                   in_buffer[SRSRAN_MAX_PORTS],
+                                         cf_t*                   out_buffer[SRSRAN_MAX_PORTS],
+                                         uint32_t                max_ports,
+                                         uint32_t                max_prb);
+
+/**
+ * @brief Reconfigures the multi-port OFDM modulator, the plans are only recreated if a parameter changes
+ *
+ * @param q OFDM modulator object
+ * @param cp Cyclic prefix type
+ * @param nof_prb Number of PRB, not greater than the maximum given at initialization
+ * @param nof_ports Number of ports modulated in each subframe, not greater than the maximum given at initialization
+ * @return SRSRAN_SUCCESS if the reconfiguration is successful, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int
+srsran_ofdm_tx_batch_set_cell(srsran_ofdm_tx_batch_t* q, srsran_cp_t cp, uint32_t nof_prb, uint32_t nof_ports);
+
+/**
+ * @brief Sets the factor applied to the output samples, it replaces a separate scaling pass over the output
+ */
+SRSRAN_API void srsran_ofdm_tx_batch_set_scale(srsran_ofdm_tx_batch_t* q, float scale);
+
+/**
+ * @brief Modulates one subframe of every port into the output buffers given at initialization
+ */
+SRSRAN_API void srsran_ofdm_tx_batch_sf(srsran_ofdm_tx_batch_t* q);
+
+SRSRAN_API void srsran_ofdm_tx_batch_free(srsran_ofdm_tx_batch_t* q);
+
 /**
  * @brief Initialises or reconfigures OFDM receiver
  *
@@ -127,6 +192,18 @@ SRSRAN_API void srsran_ofdm_rx_sf(srsran_ofdm_t* q);
 
 SRSRAN_API void srsran_ofdm_rx_sf_ng(srsran_ofdm_t* q, cf_t* input, cf_t* output);
 
+/**
+ * @brief Demodulates a subframe while correcting a carrier frequency offset
+ *
+ * It is equivalent to correcting the CFO of the whole input buffer with srsran_vec_apply_cfo() and then calling
+ * srsran_ofdm_rx_sf(). However, the CFO is corrected only on the samples that are actually demodulated, the cyclic
+ * prefix is discarded on the way, and the input buffer is not modified.
+ *
+ * @param q OFDM receiver object
+ * @param cfo Frequency offset to apply, normalised by the sampling rate (same sign as srsran_vec_apply_cfo())
+ */
+SRSRAN_API void srsran_ofdm_rx_sf_cfo(srsran_ofdm_t* q, float cfo);
+
 SRSRAN_API int
 srsran_ofdm_tx_init(srsran_ofdm_t* q, srsran_cp_t cp_type, cf_t* in_buffer, cf_t* out_buffer, uint32_t nof_prb);
 
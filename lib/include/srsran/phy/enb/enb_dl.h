@@ -66,8 +66,8 @@ typedef struct SRSRAN_API {
 
   cf_t* sf_symbols[SRSRAN_MAX_PORTS];
   cf_t*         out_buffer[SRSRAN_MAX_PORTS];
-  srsran_ofdm_t ifft[SRSRAN_MAX_PORTS];
-  srsran_ofdm_t ifft_mbsfn;
+  srsran_ofdm_tx_batch_t ifft;
+  srsran_ofdm_t          ifft_mbsfn;
 
   srsran_pbch_t   pbch;
   srsran_pcfich_t pcfich;
@@ -52,19 +52,30 @@
 typedef struct SRSRAN_API {
   srsran_cell_t cell;
 
-  cf_t*                 sf_symbols;
-  cf_t*                 in_buffer;
+  uint32_t              nof_rx_ant;
+  cf_t*                 sf_symbols[SRSRAN_MAX_PORTS];
+  cf_t*                 in_buffer[SRSRAN_MAX_PORTS];
+  cf_t*                 pusch_symbols; // Combination of the PUSCH resource elements of all antennas
   srsran_chest_ul_res_t chest_res;
 
-  srsran_ofdm_t     fft;
+  srsran_ofdm_t     fft[SRSRAN_MAX_PORTS];
   srsran_chest_ul_t chest;
   srsran_pusch_t    pusch;
   srsran_pucch_t    pucch;
 
 } srsran_enb_ul_t;
 
-/* This function shall be called just after the initial synchronization */
-SRSRAN_API int srsran_enb_ul_init(srsran_enb_ul_t* q, cf_t* in_buffer, uint32_t max_prb);
+/* PUCCH reception of a user, decoded together with the rest of users of the subframe */
+typedef struct SRSRAN_API {
+  srsran_pucch_cfg_t cfg;
+  srsran_pucch_res_t res;
+  int                ret;
+} srsran_enb_ul_pucch_t;
+
+/* This function shall be called just after the initial synchronization. PUSCH is received from all the antennas,
+ * PUCCH from the first one */
+SRSRAN_API int
+srsran_enb_ul_init(srsran_enb_ul_t* q, cf_t* in_buffer[SRSRAN_MAX_PORTS], uint32_t max_prb, uint32_t nof_rx_ant);
 
 SRSRAN_API void srsran_enb_ul_free(srsran_enb_ul_t* q);
 
@@ -80,9 +91,25 @@ SRSRAN_API int srsran_enb_ul_get_pucch(srsran_enb_ul_t*    q,
                                        srsran_pucch_cfg_t* cfg,
                                        srsran_pucch_res_t* res);
 
+/* Decodes the PUCCH of all the users of the subframe. The users transmitting format 1, 1a or 1b in the same PRB are
+ * detected from a single channel estimation and despreading of the PRB. The result of every user is stored in ret */
+SRSRAN_API int srsran_enb_ul_get_pucch_multi(srsran_enb_ul_t*       q,
+                                             srsran_ul_sf_cfg_t*    ul_sf,
+                                             srsran_enb_ul_pucch_t* pucch,
+                                             uint32_t               nof_pucch);
+
 SRSRAN_API int srsran_enb_ul_get_pusch(srsran_enb_ul_t*    q,
                                        srsran_ul_sf_cfg_t* ul_sf,
                                        srsran_pusch_cfg_t* cfg,
                                        srsran_pusch_res_t* res);
 
+/* PUSCH reception split in its two steps, equivalent to srsran_enb_ul_get_pusch() */
+SRSRAN_API int
+srsran_enb_ul_estimate_pusch(srsran_enb_ul_t* q, srsran_ul_sf_cfg_t* ul_sf, srsran_pusch_cfg_t* cfg);
+
+SRSRAN_API int srsran_enb_ul_decode_pusch(srsran_enb_ul_t*    q,
+                                          srsran_ul_sf_cfg_t* ul_sf,
+                                          srsran_pusch_cfg_t* cfg,
+                                          srsran_pusch_res_t* res);
+
 #endif // SRSRAN_ENB_UL_H
@@ -83,6 +83,13 @@ SRSRAN_API void srsran_softbuffer_rx_free(srsran_softbuffer_rx_t* p);
  */
 SRSRAN_API void srsran_softbuffer_rx_reset_cb_crc(srsran_softbuffer_rx_t* q, uint32_t nof_cb);
 
+/**
+ * @brief Computes the memory allocated by an Rx soft-buffer, including the object itself
+ * @param q Rx soft-buffer object
+ * @return The number of bytes allocated for the soft-buffer
+ */
+SRSRAN_API size_t srsran_softbuffer_rx_mem_size(const srsran_softbuffer_rx_t* q);
+
 SRSRAN_API int srsran_softbuffer_tx_init(srsran_softbuffer_tx_t* q, uint32_t nof_prb);
 
 /**
@@ -102,6 +109,13 @@ SRSRAN_API void srsran_softbuffer_tx_reset_cb(srsran_softbuffer_tx_t* q, uint32_
 
 SRSRAN_API void srsran_softbuffer_tx_free(srsran_softbuffer_tx_t* p);
 
+/**
+ * @brief Computes the memory allocated by a Tx soft-buffer, including the object itself
+ * @param q Tx soft-buffer object
+ * @return The number of bytes allocated for the soft-buffer
+ */
+SRSRAN_API size_t srsran_softbuffer_tx_mem_size(const srsran_softbuffer_tx_t* q);
+
 #ifdef __cplusplus
 }
 #endif
@@ -63,6 +63,17 @@ SRSRAN_API int srsran_gnb_ul_get_pusch(srsran_gnb_ul_t*             q,
                                        const srsran_sch_grant_nr_t* grant,
                                        srsran_pusch_res_nr_t*       data);
 
+/* PUSCH reception split in its two steps, equivalent to srsran_gnb_ul_get_pusch() */
+SRSRAN_API int srsran_gnb_ul_estimate_pusch(srsran_gnb_ul_t*             q,
+                                            const srsran_slot_cfg_t*     slot_cfg,
+                                            const srsran_sch_cfg_nr_t*   cfg,
+                                            const srsran_sch_grant_nr_t* grant);
+
+SRSRAN_API int srsran_gnb_ul_decode_pusch(srsran_gnb_ul_t*             q,
+                                          const srsran_sch_cfg_nr_t*   cfg,
+                                          const srsran_sch_grant_nr_t* grant,
+                                          srsran_pusch_res_nr_t*       data);
+
 SRSRAN_API int srsran_gnb_ul_get_pucch(srsran_gnb_ul_t*                    q,
                                        const srsran_slot_cfg_t*            slot_cfg,
                                        const srsran_pucch_nr_common_cfg_t* cfg,
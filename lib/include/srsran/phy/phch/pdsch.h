@@ -44,6 +44,9 @@
 #include "srsran/phy/phch/sch.h"
 #include "srsran/phy/scrambling/scrambling.h"
 
+/* Subframe types with a different set of PDSCH resource elements: SF 0, SF 5, SF 1/6 (TDD PSS) and the rest */
+#define SRSRAN_PDSCH_NOF_RE_MASKS 4
+
 /* PDSCH object */
 typedef struct SRSRAN_API {
   srsran_cell_t cell;
@@ -72,8 +75,15 @@ typedef struct SRSRAN_API {
   srsran_evm_buffer_t* evm_buffer[SRSRAN_MAX_CODEWORDS];
   float                avg_evm;
 
+  // Scrambling sequences, one per subframe of each user, one cache for each codeword (as the EVM buffers)
+  srsran_sequence_cache_t seq_cache[SRSRAN_MAX_CODEWORDS];
+
   srsran_sch_t dl_sch;
 
+  // PDSCH RE masks for each subframe type, 12 bits for every symbol and PRB of the grid (Tx only)
+  uint16_t* re_mask[SRSRAN_PDSCH_NOF_RE_MASKS];
+  uint32_t* re_idx; /* Grid index of every PDSCH RE in the subframe being encoded (Tx only) */
+
   void* coworker_ptr;
 
 } srsran_pdsch_t;
@@ -96,6 +106,11 @@ SRSRAN_API int srsran_pdsch_enable_coworker(srsran_pdsch_t* q);
 
 SRSRAN_API int srsran_pdsch_set_cell(srsran_pdsch_t* q, srsran_cell_t cell);
 
+SRSRAN_API void srsran_pdsch_release_rnti(srsran_pdsch_t* q, uint16_t rnti);
+
+/* Limits the cached scrambling sequences to the given number of users */
+SRSRAN_API void srsran_pdsch_set_nof_users(srsran_pdsch_t* q, uint32_t nof_users);
+
 /* These functions do not modify the state and run in real-time */
 SRSRAN_API int srsran_pdsch_encode(srsran_pdsch_t*     q,
                                    srsran_dl_sf_cfg_t* sf,
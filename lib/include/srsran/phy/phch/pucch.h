@@ -58,6 +58,15 @@
 #define SRSRAN_PUCCH_DEFAULT_THRESHOLD_FORMAT3 (0.5f)
 #define SRSRAN_PUCCH_DEFAULT_THRESHOLD_DMRS (0.4f)
 
+/* Received signal of a PUCCH format 1 PRB pair after removing the base sequence. Every cyclic shift of every symbol is
+ * despread at once, so all the users multiplexed in the PRB pair are detected from the same data */
+typedef struct SRSRAN_API {
+  cf_t  bins[SRSRAN_NOF_SLOTS_PER_SF][SRSRAN_CP_NORM_NSYMB][SRSRAN_NRE]; // Despread signal for each cyclic shift
+  float noise;                                                          // Noise and interference per resource element
+  bool  group_hopping_en;
+  bool  valid;
+} srsran_pucch_prb_t;
+
 /* PUCCH object */
 typedef struct SRSRAN_API {
   srsran_cell_t        cell;
@@ -78,6 +87,10 @@ typedef struct SRSRAN_API {
   cf_t* z_tmp;
   cf_t* ce;
 
+  /* Joint detection of format 1, 1a and 1b (eNb only) */
+  srsran_pucch_prb_t* prb;
+  cf_t                dft[SRSRAN_NRE][SRSRAN_NRE];
+
 } srsran_pucch_t;
 
 typedef struct SRSRAN_API {
@@ -117,6 +130,17 @@ SRSRAN_API int srsran_pucch_decode(srsran_pucch_t*        q,
                                    cf_t*                  sf_symbols,
                                    srsran_pucch_res_t*    data);
 
+/* Joint detection of PUCCH format 1, 1a and 1b. The channel is estimated from the despread PRB pair, which is computed
+ * the first time one of its resources is decoded and reused by the rest of resources until the next reset. Call the
+ * reset every subframe before decoding the first resource */
+SRSRAN_API void srsran_pucch_joint_reset(srsran_pucch_t* q);
+
+SRSRAN_API int srsran_pucch_decode_joint(srsran_pucch_t*     q,
+                                         srsran_ul_sf_cfg_t* sf,
+                                         srsran_pucch_cfg_t* cfg,
+                                         cf_t*               sf_symbols,
+                                         srsran_pucch_res_t* data);
+
 /* Other utilities. These functions do not modify the state and run in real-time */
 SRSRAN_API float srsran_pucch_alpha_format1(const uint32_t n_cs_cell[SRSRAN_NSLOTS_X_FRAME][SRSRAN_CP_NORM_NSYMB],
                                             const srsran_pucch_cfg_t* cfg,
@@ -50,7 +50,6 @@ typedef struct SRSRAN_API {
   srsran_cell_t cell;
 
   bool     is_ue;
-  uint16_t ue_rnti;
   uint32_t max_re;
 
   bool llr_is_8bit;
@@ -73,6 +72,11 @@ typedef struct SRSRAN_API {
   // EVM buffer
   srsran_evm_buffer_t* evm_buffer;
 
+  /* Scrambling sequences, one per subframe of each user. The UE keeps the ones of its C-RNTI and uses them for
+   * scrambling if seq_cache_en is set (by srsran_pusch_init_ue()), the eNb keeps the ones of every user */
+  bool                    seq_cache_en;
+  srsran_sequence_cache_t seq_cache;
+
 } srsran_pusch_t;
 
 typedef struct SRSRAN_API {
@@ -98,6 +102,11 @@ SRSRAN_API void srsran_pusch_free(srsran_pusch_t* q);
 /* These functions modify the state of the object and may take some time */
 SRSRAN_API int srsran_pusch_set_cell(srsran_pusch_t* q, srsran_cell_t cell);
 
+SRSRAN_API void srsran_pusch_release_rnti(srsran_pusch_t* q, uint16_t rnti);
+
+/* Limits the cached scrambling sequences to the given number of users */
+SRSRAN_API void srsran_pusch_set_nof_users(srsran_pusch_t* q, uint32_t nof_users);
+
 /**
  * Asserts PUSCH grant attributes are in range
  * @param grant Pointer to PUSCH grant
@@ -80,6 +80,19 @@ typedef struct SRSRAN_API {
   float                       scaling;        ///< IFFT scaling (used for modulation), set to 0 for default
 } srsran_ssb_cfg_t;
 
+/**
+ * @brief Describes the SSB tracking correlation window state and the time/frequency drift statistics
+ */
+typedef struct SRSRAN_API {
+  uint32_t window;          ///< Current correlation window half length in samples, zero if not initialised
+  uint32_t nof_tracks;      ///< Number of tracking correlations since the last find
+  uint32_t nof_extensions;  ///< Number of times the correlation window was extended since the last find
+  int32_t  t_drift_samples; ///< Last time drift in samples between the expected and the correlation peak
+  float    t_drift_us;      ///< Average measured SSB delay in microseconds, the drift above plus the residual delay
+  float    cfo_drift_hz;    ///< Average residual frequency offset in Hz
+  float    corr;            ///< Average normalised PSS correlation peak
+} srsran_ssb_track_stats_t;
+
 /**
  * @brief Describes SSB object
  */
@@ -113,11 +126,15 @@ typedef struct SRSRAN_API {
   srsran_pbch_nr_t  pbch;      ///< PBCH encoder and decoder
 
   /// Frequency/Time domain temporal data
-  cf_t* tmp_freq;                     ///< Temporal frequency domain buffer
-  cf_t* tmp_time;                     ///< Temporal time domain buffer
-  cf_t* tmp_corr;                     ///< Temporal correlation frequency domain buffer
-  cf_t* sf_buffer;                    ///< subframe buffer
-  cf_t* pss_seq[SRSRAN_NOF_NID_2_NR]; ///< Possible frequency domain PSS for find
+  cf_t* tmp_freq;                          ///< Temporal frequency domain buffer
+  cf_t* tmp_time;                          ///< Temporal time domain buffer
+  cf_t* tmp_corr;                          ///< Temporal correlation frequency domain buffer
+  cf_t* sf_buffer;                         ///< subframe buffer
+  cf_t* pss_seq[SRSRAN_NOF_NID_2_NR];      ///< Possible frequency domain PSS for find
+  cf_t* pss_seq_time[SRSRAN_NOF_NID_2_NR]; ///< Possible time domain PSS for track
+
+  /// Tracking
+  srsran_ssb_track_stats_t track; ///< Tracking correlation window and drift statistics
 } srsran_ssb_t;
 
 /**
@@ -243,6 +260,12 @@ SRSRAN_API int srsran_ssb_find(srsran_ssb_t*                  q,
 
 /**
  * @brief Track SSB by performing measurements and decoding PBCH
+ *
+ * The PSS is correlated only within a small window around the expected SSB position. The window is extended when the
+ * correlation peak falls in its border or its power degrades, and it is shrunk back while the peak stays centred. The
+ * found time drift is added to the measured delay and, together with the residual frequency offset, it is averaged in
+ * the tracking statistics.
+ *
  * @param q SSB object
  * @param sf_buffer subframe buffer with 1ms worth of samples
  * @param N_id Physical cell identifier to find
@@ -260,6 +283,13 @@ SRSRAN_API int srsran_ssb_track(srsran_ssb_t*                  q,
                                 srsran_csi_trs_measurements_t* meas,
                                 srsran_pbch_msg_nr_t*          pbch_msg);
 
+/**
+ * @brief Get the SSB tracking time/frequency drift statistics
+ * @param q SSB object
+ * @return A pointer to the tracking statistics, NULL if the object is invalid
+ */
+SRSRAN_API const srsran_ssb_track_stats_t* srsran_ssb_get_track_stats(const srsran_ssb_t* q);
+
 /**
  * @brief Calculates the subframe index within the radio frame of a given SSB candidate for the SSB object
  * @param q SSB object
@@ -74,6 +74,13 @@ typedef struct SRSRAN_API {
   uint32_t              nof_formats;
 } dci_blind_search_t;
 
+/// OFDM demodulation and channel estimation outputs of a UE DL object, read by the objects that share them
+typedef struct SRSRAN_API {
+  const srsran_cell_t*         cell;
+  cf_t* const*                 sf_symbols;
+  const srsran_chest_dl_res_t* chest_res;
+} srsran_ue_dl_front_end_t;
+
 typedef struct SRSRAN_API {
   // Cell configuration
   srsran_cell_t cell;
@@ -97,6 +104,7 @@ typedef struct SRSRAN_API {
   srsran_chest_dl_res_t chest_res;
   srsran_ofdm_t         fft[SRSRAN_MAX_PORTS];
   srsran_ofdm_t         fft_mbsfn;
+  float                 cfo; ///< Carrier frequency offset corrected by the OFDM demodulation, normalised by the srate
 
   // Buffers to store channel symbols after demodulation
   cf_t*              sf_symbols[SRSRAN_MAX_PORTS];
@@ -107,6 +115,12 @@ typedef struct SRSRAN_API {
 
   srsran_dci_location_t allocated_locations[SRSRAN_MAX_DCI_MSG];
   uint32_t              nof_allocated_locations;
+
+  // Shared front-end (OFDM demodulation and channel estimation), NULL if this object owns its own
+  const srsran_ue_dl_front_end_t* front_end;
+
+  // Outputs of the own front-end, for the objects sharing it
+  srsran_ue_dl_front_end_t front_end_out;
 } srsran_ue_dl_t;
 
 // Downlink config (includes common and dedicated variables)
@@ -160,6 +174,17 @@ typedef struct {
 SRSRAN_API int
 srsran_ue_dl_init(srsran_ue_dl_t* q, cf_t* input[SRSRAN_MAX_PORTS], uint32_t max_prb, uint32_t nof_rx_antennas);
 
+/**
+ * Initialises a UE DL object that does not run its own OFDM demodulation nor channel estimation. Instead, it uses the
+ * subframe symbols and channel estimates of the given front-end object. This allows emulating several UE contexts
+ * camping on the same cell while the common downlink processing is performed only once per subframe.
+ *
+ * The front-end must outlive this object and it must be configured with the same cell. Every subframe, the front-end
+ * shall be processed with srsran_ue_dl_decode_fft_estimate() before any of the objects attached to it, using the same
+ * subframe configuration (it carries the decoded CFI).
+ */
+SRSRAN_API int srsran_ue_dl_init_shared(srsran_ue_dl_t* q, const srsran_ue_dl_t* front_end, uint32_t max_prb);
+
 SRSRAN_API void srsran_ue_dl_free(srsran_ue_dl_t* q);
 
 SRSRAN_API int srsran_ue_dl_set_cell(srsran_ue_dl_t* q, srsran_cell_t cell);
@@ -172,9 +197,22 @@ SRSRAN_API void srsran_ue_dl_set_mi_manual(srsran_ue_dl_t* q, uint32_t mi_idx);
 
 SRSRAN_API void srsran_ue_dl_set_mi_auto(srsran_ue_dl_t* q);
 
-/* Perform signal demodulation and channel estimation and store signals in the object */
+/* Sets the carrier frequency offset, normalised by the sampling rate, that the OFDM demodulation corrects in the
+ * following subframes. It is used when the receive buffer was not corrected by the synchronization */
+SRSRAN_API void srsran_ue_dl_set_cfo(srsran_ue_dl_t* q, float cfo);
+
+/* Perform signal demodulation and channel estimation and store signals in the object. Objects initialised with
+ * srsran_ue_dl_init_shared() reuse the front-end results and only extract their own PDCCH soft bits */
 SRSRAN_API int srsran_ue_dl_decode_fft_estimate(srsran_ue_dl_t* q, srsran_dl_sf_cfg_t* sf, srsran_ue_dl_cfg_t* cfg);
 
+/* Runs the OFDM demodulation of a single receive antenna. Together with srsran_ue_dl_estimate() it splits
+ * srsran_ue_dl_decode_fft_estimate() in stages, so the antennas of a carrier can be demodulated concurrently */
+SRSRAN_API int srsran_ue_dl_run_fft(srsran_ue_dl_t* q, srsran_dl_sf_cfg_t* sf, uint32_t rx_ant);
+
+/* Estimates the channel, decodes the CFI and extracts the PDCCH soft bits of the symbols demodulated by
+ * srsran_ue_dl_run_fft() for all the receive antennas */
+SRSRAN_API int srsran_ue_dl_estimate(srsran_ue_dl_t* q, srsran_dl_sf_cfg_t* sf, srsran_ue_dl_cfg_t* cfg);
+
 SRSRAN_API int srsran_ue_dl_decode_fft_estimate_noguru(srsran_ue_dl_t*     q,
                                                        srsran_dl_sf_cfg_t* sf,
                                                        srsran_ue_dl_cfg_t* cfg,
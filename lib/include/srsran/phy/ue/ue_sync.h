@@ -125,6 +125,9 @@ typedef struct SRSRAN_API {
   bool  cfo_is_copied;
   bool  cfo_correct_enable_track;
   bool  cfo_correct_enable_find;
+  bool  cfo_correct_in_demod; ///< In tracking, the CFO is corrected by the OFDM demodulation instead of in place
+  float cfo_demod_value;      ///< CFO to correct in the last subframe, normalised by the sampling rate
+  cf_t* track_buffer;         ///< CFO corrected copy of the subframes carrying the PSS, for the tracking
   float cfo_current_value;
   float cfo_loop_bw_pss;
   float cfo_loop_bw_ref;
@@ -247,6 +250,17 @@ SRSRAN_API uint32_t srsran_ue_sync_get_sfidx(srsran_ue_sync_t* q);
 
 SRSRAN_API float srsran_ue_sync_get_cfo(srsran_ue_sync_t* q);
 
+/* Leaves the CFO correction of the tracked subframes to the OFDM demodulation. The receive buffer is not corrected in
+ * place, srsran_ue_sync_get_cfo_demod() returns the CFO the demodulation shall correct in the last subframe */
+SRSRAN_API int srsran_ue_sync_set_cfo_correct_in_demod(srsran_ue_sync_t* q, bool enable);
+
+SRSRAN_API float srsran_ue_sync_get_cfo_demod(srsran_ue_sync_t* q);
+
+/* Corrects into output the CFO the tracking leaves to the OFDM demodulation, for other consumers of the receive buffer.
+ * It returns false, without writing output, if the receive buffer is corrected in place or not corrected at all */
+SRSRAN_API bool
+srsran_ue_sync_cfo_correct_copy(srsran_ue_sync_t* q, const cf_t* input, cf_t* output, uint32_t nof_samples);
+
 SRSRAN_API void srsran_ue_sync_cp_en(srsran_ue_sync_t* q, bool enabled);
 
 SRSRAN_API float srsran_ue_sync_get_sfo(srsran_ue_sync_t* q);
@@ -91,6 +91,15 @@ typedef struct SRSRAN_API {
 
 } srsran_ue_ul_cfg_t;
 
+/* PUSCH DMRS generated for the last configuration used in a subframe */
+typedef struct {
+  bool                              valid;
+  srsran_refsignal_dmrs_pusch_cfg_t cfg;
+  uint32_t                          nof_prb;
+  uint32_t                          n_dmrs;
+  cf_t*                             r;
+} srsran_ue_ul_dmrs_cache_t;
+
 typedef struct SRSRAN_API {
   srsran_cell_t cell;
 
@@ -102,6 +111,7 @@ typedef struct SRSRAN_API {
   srsran_refsignal_ul_t             signals;
   srsran_refsignal_ul_dmrs_pregen_t pregen_dmrs;
   srsran_refsignal_srs_pregen_t     pregen_srs;
+  srsran_ue_ul_dmrs_cache_t         dmrs_cache[SRSRAN_NOF_SF_X_FRAME];
 
   srsran_pusch_t pusch;
   srsran_pucch_t pucch;
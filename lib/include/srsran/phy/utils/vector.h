@@ -102,6 +102,52 @@ static inline float srsran_convert_dB_to_power(float v)
   return powf(10.0f, v / 10.0f);
 }
 
+/*!
+ * Instruction sets the vector kernels can be bound to. SRSRAN_VEC_ISA_NATIVE are the kernels built with the library
+ * compilation flags, the others are only available if the library is built with ENABLE_ISA_DISPATCH.
+ */
+typedef enum {
+  SRSRAN_VEC_ISA_NATIVE = 0,
+  SRSRAN_VEC_ISA_SSE,
+  SRSRAN_VEC_ISA_AVX2,
+  SRSRAN_VEC_ISA_AVX512,
+  SRSRAN_VEC_ISA_COUNT
+} srsran_vec_isa_t;
+
+SRSRAN_API const char* srsran_vec_isa_string(srsran_vec_isa_t isa);
+
+/*!
+ * Checks whether the kernels of an instruction set are built in the library and supported by the running CPU.
+ * \param[in] isa Instruction set.
+ * \return true if the kernels can be selected with srsran_vec_isa_set().
+ */
+SRSRAN_API bool srsran_vec_isa_available(srsran_vec_isa_t isa);
+
+/*!
+ * Returns the instruction set of the kernels in use. The best available one is selected at startup, unless the
+ * environment variable SRSRAN_VEC_ISA names another available instruction set.
+ */
+SRSRAN_API srsran_vec_isa_t srsran_vec_isa_get(void);
+
+/*!
+ * Binds the vector kernels to an instruction set, it is intended for testing and benchmarking. It is not thread-safe,
+ * it shall not be called while other threads use the vector functions.
+ * \param[in] isa Instruction set.
+ * \return SRSRAN_SUCCESS if the instruction set is available, SRSRAN_ERROR otherwise.
+ */
+SRSRAN_API int srsran_vec_isa_set(srsran_vec_isa_t isa);
+
+/*!
+ * Carry-less multiplication widths the CRC folding kernels can use, besides the vector kernels.
+ */
+typedef enum { SRSRAN_VEC_CLMUL_NONE = 0, SRSRAN_VEC_CLMUL_128, SRSRAN_VEC_CLMUL_512 } srsran_vec_clmul_t;
+
+/*!
+ * Returns the carry-less multiplication width bound with the instruction set in use. With SRSRAN_VEC_ISA_NATIVE it is
+ * given by the library compilation flags, otherwise by the instructions the running CPU reports.
+ */
+SRSRAN_API srsran_vec_clmul_t srsran_vec_isa_clmul(void);
+
 /*!
  * Computes \f$ z = x \oplus y \f$ elementwise.
  * \param[in] x A pointer to a vector of uint8_t with 0's and 1's.
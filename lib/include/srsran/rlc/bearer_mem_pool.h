@@ -23,13 +23,26 @@
 #define SRSRAN_BEARER_MEM_POOL_H
 
 #include <cstddef>
+#include <cstdint>
 
 namespace srsran {
 
 // Allocation of objects in rnti-dedicated memory pool
-void  reserve_rlc_memblocks(size_t nof_blocks);
-void* allocate_rlc_bearer(std::size_t size);
-void  deallocate_rlc_bearer(void* p);
+void        reserve_rlc_memblocks(size_t nof_blocks);
+void*       allocate_rlc_bearer(std::size_t size);
+void        deallocate_rlc_bearer(void* p);
+std::size_t rlc_bearer_block_size();
+
+// Allocation of the RLC AM windows in memory pools shared by all bearers. In compact mode, the windows of a bearer are
+// only allocated while they hold PDUs, instead of for the whole lifetime of the bearer
+void  set_rlc_compact_windows(bool enable);
+bool  rlc_compact_windows();
+void* allocate_rlc_window(std::size_t size);
+void  deallocate_rlc_window(void* p, std::size_t size);
+
+// Time in ms a bearer has to stay without PDUs in flight before its windows are given back in compact mode. A bearer
+// that goes idle and active again in short bursts keeps them instead of allocating and freeing them every time
+const uint32_t rlc_compact_idle_ms = 100;
 
 } // namespace srsran
 
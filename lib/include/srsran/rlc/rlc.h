@@ -57,6 +57,10 @@ public:
   void stop();
 
   void get_metrics(rlc_metrics_t& m, const uint32_t nof_tti);
+  void reset_metrics();
+
+  /// Bytes held by the RLC entity and all its bearers
+  size_t get_mem_footprint();
 
   // PDCP interface
   void write_sdu(uint32_t lcid, unique_byte_buffer_t sdu);
@@ -95,8 +99,6 @@ public:
   bool has_bearer(uint32_t lcid);
 
 private:
-  void reset_metrics();
-
   void get_buffer_state(uint32_t lcid, uint32_t& tx_queue, uint32_t& prio_tx_queue);
 
   srslog::basic_logger&      logger;
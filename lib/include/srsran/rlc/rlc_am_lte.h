@@ -46,7 +46,8 @@ namespace srsran {
 class rlc_amd_tx_pdu;
 class pdcp_pdu_info;
 
-/// Pool that manages the allocation of RLC AM PDU Segments to RLC PDUs and tracking of segments ACK state
+/// Pool that manages the allocation of RLC AM PDU Segments to RLC PDUs and tracking of segments ACK state. The segments
+/// are stored in a block of the shared RLC window pool and constructed on first use
 struct rlc_am_pdu_segment_pool {
   const static size_t MAX_POOL_SIZE = 16384;
   using rlc_list_tag                = default_intrusive_tag;
@@ -73,17 +74,28 @@ struct rlc_am_pdu_segment_pool {
     rlc_am_pdu_segment_pool* parent_pool = nullptr;
   };
 
+  const static size_t storage_size = MAX_POOL_SIZE * sizeof(segment_resource);
+
   rlc_am_pdu_segment_pool();
+  ~rlc_am_pdu_segment_pool();
   rlc_am_pdu_segment_pool(const rlc_am_pdu_segment_pool&) = delete;
   rlc_am_pdu_segment_pool(rlc_am_pdu_segment_pool&&)      = delete;
   rlc_am_pdu_segment_pool& operator=(const rlc_am_pdu_segment_pool&) = delete;
   rlc_am_pdu_segment_pool& operator=(rlc_am_pdu_segment_pool&&) = delete;
-  bool                     has_segments() const { return not free_list.empty(); }
-  bool                     make_segment(rlc_amd_tx_pdu& rlc_list, pdcp_pdu_info& pdcp_info);
+  bool   has_segments() const { return not free_list.empty() or nof_constructed < MAX_POOL_SIZE; }
+  bool   make_segment(rlc_amd_tx_pdu& rlc_list, pdcp_pdu_info& pdcp_info);
+  size_t get_mem_footprint() const { return segments != nullptr ? storage_size : 0; }
+
+  /// In compact mode, returns the segment storage to the shared pool if no segment is in use
+  void shrink();
 
 private:
+  void release_segment(segment_resource* segment);
+
   intrusive_forward_list<segment_resource, free_list_tag> free_list;
-  std::array<segment_resource, MAX_POOL_SIZE>             segments;
+  segment_resource*                                       segments        = nullptr;
+  uint32_t                                                nof_constructed = 0;
+  uint32_t                                                nof_used        = 0;
 };
 
 /// RLC AM PDU Segment, containing the PDCP SN and RLC SN it has been assigned to, and its current ACK state
@@ -189,31 +201,67 @@ public:
   const_iterator end() const { return list.end(); }
 };
 
+/// RLC AM window, stored in a block of the shared RLC window pool. In compact mode the block is only held while the
+/// window holds PDUs, or until the owner shrinks it
 template <class T>
 struct rlc_ringbuffer_t {
+  using window_t = srsran::static_circular_map<uint32_t, T, RLC_AM_WINDOW_SIZE>;
+
+  rlc_ringbuffer_t()
+  {
+    if (not rlc_compact_windows()) {
+      allocate();
+    }
+  }
+  rlc_ringbuffer_t(const rlc_ringbuffer_t&) = delete;
+  rlc_ringbuffer_t& operator=(const rlc_ringbuffer_t&) = delete;
+  ~rlc_ringbuffer_t() { release(); }
+
   T& add_pdu(size_t sn)
   {
     srsran_expect(not has_sn(sn), "The same SN=%zd should not be added twice", sn);
-    window.overwrite(sn, T(sn));
-    return window[sn];
+    if (window == nullptr) {
+      allocate();
+    }
+    window->overwrite(sn, T(sn));
+    return (*window)[sn];
   }
   void remove_pdu(size_t sn)
   {
     srsran_expect(has_sn(sn), "The removed SN=%zd is not in the window", sn);
-    window.erase(sn);
+    window->erase(sn);
+  }
+  T&     operator[](size_t sn) { return (*window)[sn]; }
+  size_t size() const { return window != nullptr ? window->size() : 0; }
+  bool   empty() const { return size() == 0; }
+  void   clear()
+  {
+    if (window != nullptr) {
+      window->clear();
+      if (rlc_compact_windows()) {
+        release();
+      }
+    }
   }
-  T&     operator[](size_t sn) { return window[sn]; }
-  size_t size() const { return window.size(); }
-  bool   empty() const { return window.empty(); }
-  void   clear() { window.clear(); }
 
-  bool has_sn(uint32_t sn) const { return window.contains(sn); }
+  bool has_sn(uint32_t sn) const { return window != nullptr and window->contains(sn); }
+
+  /// In compact mode, returns the window block to the shared pool if the window holds no PDU
+  void shrink()
+  {
+    if (window != nullptr and window->empty() and rlc_compact_windows()) {
+      release();
+    }
+  }
 
   // Return the sum data bytes of all active PDUs (check PDU is non-null)
   uint32_t get_buffered_bytes()
   {
     uint32_t buff_size = 0;
-    for (const auto& pdu : window) {
+    if (window == nullptr) {
+      return buff_size;
+    }
+    for (const auto& pdu : *window) {
       if (pdu.second.buf != nullptr) {
         buff_size += pdu.second.buf->N_bytes;
       }
@@ -221,8 +269,33 @@ struct rlc_ringbuffer_t {
     return buff_size;
   }
 
+  // Return the memory held by the window and the buffers of its PDUs
+  size_t get_mem_footprint()
+  {
+    if (window == nullptr) {
+      return 0;
+    }
+    size_t bytes = sizeof(window_t);
+    for (const auto& pdu : *window) {
+      if (pdu.second.buf != nullptr) {
+        bytes += sizeof(byte_buffer_t);
+      }
+    }
+    return bytes;
+  }
+
 private:
-  srsran::static_circular_map<uint32_t, T, RLC_AM_WINDOW_SIZE> window;
+  void allocate() { window = new (allocate_rlc_window(sizeof(window_t))) window_t(); }
+  void release()
+  {
+    if (window != nullptr) {
+      window->~window_t();
+      deallocate_rlc_window(window, sizeof(window_t));
+      window = nullptr;
+    }
+  }
+
+  window_t* window = nullptr;
 };
 
 struct buffered_pdcp_pdu_list {
@@ -234,6 +307,9 @@ public:
   {
     srsran_expect(sn <= max_pdcp_sn or sn == status_report_sn, "Invalid PDCP SN=%d", sn);
     srsran_assert(not has_pdcp_sn(sn), "Cannot re-add same PDCP SN twice");
+    if (buffered_pdus.empty()) {
+      buffered_pdus.resize(buffer_size);
+    }
     pdcp_pdu_info& pdu = get_pdu_(sn);
     if (pdu.valid()) {
       pdu.clear();
@@ -244,6 +320,9 @@ public:
   }
   void clear_pdcp_sdu(uint32_t sn)
   {
+    if (buffered_pdus.empty() and sn != status_report_sn) {
+      return;
+    }
     pdcp_pdu_info& pdu = get_pdu_(sn);
     if (not pdu.valid()) {
       return;
@@ -260,10 +339,17 @@ public:
   bool has_pdcp_sn(uint32_t pdcp_sn) const
   {
     srsran_expect(pdcp_sn <= max_pdcp_sn or pdcp_sn == status_report_sn, "Invalid PDCP SN=%d", pdcp_sn);
+    if (buffered_pdus.empty() and pdcp_sn != status_report_sn) {
+      return false;
+    }
     return get_pdu_(pdcp_sn).sn == pdcp_sn;
   }
   uint32_t nof_sdus() const { return count; }
 
+  /// In compact mode, frees the SDU info buffer if there are no SDUs
+  void   shrink();
+  size_t get_mem_footprint() const { return buffered_pdus.capacity() * sizeof(pdcp_pdu_info); }
+
 private:
   const static size_t   max_pdcp_sn      = 262143u;
   const static size_t   buffer_size      = 4096u;
@@ -278,7 +364,7 @@ private:
     return (sn == status_report_sn) ? status_report_pdu : buffered_pdus[static_cast<size_t>(sn % buffer_size)];
   }
 
-  // size equal to buffer_size
+  // size equal to buffer_size, or empty in compact mode while there are no SDUs
   std::vector<pdcp_pdu_info> buffered_pdus;
   pdcp_pdu_info              status_report_pdu;
   uint32_t                   count = 0;
@@ -364,6 +450,8 @@ public:
 
   void set_bsr_callback(bsr_callback_t callback);
 
+  size_t get_mem_footprint() override;
+
 private:
   // Transmitter sub-class
   class rlc_am_lte_tx : public timer_callback
@@ -395,8 +483,12 @@ private:
 
     void set_bsr_callback(bsr_callback_t callback);
 
+    size_t get_mem_footprint();
+
   private:
     void stop_nolock();
+    void compact_nolock();
+    void schedule_compact_nolock();
 
     int  build_status_pdu(uint8_t* payload, uint32_t nof_bytes);
     int  build_retx_pdu(uint8_t* payload, uint32_t nof_bytes);
@@ -459,6 +551,7 @@ private:
 
     srsran::timer_handler::unique_timer poll_retx_timer;
     srsran::timer_handler::unique_timer status_prohibit_timer;
+    srsran::timer_handler::unique_timer compact_timer; // Delays giving back the idle storage in compact mode
 
     // SDU info for PDCP notifications
     buffered_pdcp_pdu_list undelivered_sdu_info_queue;
@@ -493,6 +586,7 @@ private:
 
     uint32_t get_rx_buffered_bytes(); // returns sum of PDUs in rx_window
     uint32_t get_sdu_rx_latency_ms();
+    size_t   get_mem_footprint();
 
     // Timeout callback interface
     void timer_expired(uint32_t timeout_id);
@@ -553,6 +647,7 @@ private:
      ***************************************************************************/
 
     srsran::timer_handler::unique_timer reordering_timer;
+    srsran::timer_handler::unique_timer compact_timer; // Delays giving back the idle window in compact mode
 
     srsran::rolling_average<double> sdu_rx_latency_ms;
   };
@@ -288,6 +288,9 @@ public:
 
   virtual void set_bsr_callback(bsr_callback_t callback) = 0;
 
+  // Memory held by the bearer, i.e. its block of the bearer pool and the windows and buffers it allocated
+  virtual size_t get_mem_footprint() { return rlc_bearer_block_size(); }
+
   void* operator new(size_t sz) { return allocate_rlc_bearer(sz); }
   void  operator delete(void* p) { return deallocate_rlc_bearer(p); }
 
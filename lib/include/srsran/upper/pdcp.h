@@ -75,8 +75,9 @@ public:
   std::map<uint32_t, srsran::unique_byte_buffer_t> get_buffered_pdus(uint32_t lcid);
 
   // Metrics
-  void get_metrics(pdcp_metrics_t& m, const uint32_t nof_tti);
-  void reset_metrics();
+  void   get_metrics(pdcp_metrics_t& m, const uint32_t nof_tti);
+  void   reset_metrics();
+  size_t get_mem_footprint();
 
 private:
   srsue::rlc_interface_pdcp* rlc    = nullptr;
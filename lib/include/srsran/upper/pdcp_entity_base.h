@@ -139,8 +139,9 @@ public:
   uint32_t COUNT(uint32_t hfn, uint32_t sn);
 
   // Metrics helpers
-  virtual pdcp_bearer_metrics_t get_metrics()   = 0;
-  virtual void                  reset_metrics() = 0;
+  virtual pdcp_bearer_metrics_t get_metrics()       = 0;
+  virtual void                  reset_metrics()     = 0;
+  virtual size_t                get_mem_footprint() = 0;
 
   const char* get_rb_name() const { return rb_name.c_str(); }
 
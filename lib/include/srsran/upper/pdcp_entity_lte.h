@@ -55,6 +55,8 @@ public:
   }
   // Getter for the number of discard timers. Used for debugging.
   size_t nof_discard_timers() const;
+  // Bytes held by the queue, including the buffered SDUs
+  size_t get_mem_footprint() const;
 
   bool add_sdu(uint32_t                              sn,
                const srsran::unique_byte_buffer_t&   sdu,
@@ -90,6 +92,7 @@ private:
     srsran::unique_timer         discard_timer;
   };
 
+  srsran::task_sched_handle                  task_sched;
   uint32_t                                   count = 0;
   uint32_t                                   bytes = 0;
   uint32_t                                   fms   = 0; // SN of the first missing PDCP SDU
@@ -151,6 +154,7 @@ public:
   // Metrics helpers
   pdcp_bearer_metrics_t get_metrics() override;
   void                  reset_metrics() override;
+  size_t                get_mem_footprint() override;
 
   size_t nof_discard_timers() const { return undelivered_sdus != nullptr ? undelivered_sdus->nof_discard_timers() : 0; }
 
@@ -74,6 +74,7 @@ public:
   void                  send_status_report() override {}
   pdcp_bearer_metrics_t get_metrics() override;
   void                  reset_metrics() override;
+  size_t                get_mem_footprint() override;
 
   std::map<uint32_t, srsran::unique_byte_buffer_t> get_buffered_pdus() override { return {}; }
 
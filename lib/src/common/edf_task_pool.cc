@@ -0,0 +1,169 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/edf_task_pool.h"
+#include <algorithm>
+
+namespace srsran {
+
+edf_task_pool::edf_task_pool(uint32_t nof_types_, uint32_t nof_workers, int32_t prio_, uint32_t mask_) :
+  prio(prio_), mask(mask_), logger(srslog::fetch_basic_logger("POOL")), stats(nof_types_)
+{
+  for (uint32_t i = 0; i < nof_workers; ++i) {
+    workers.emplace_back(new worker_t(this, i));
+  }
+}
+
+edf_task_pool::~edf_task_pool()
+{
+  stop();
+}
+
+void edf_task_pool::stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (not running) {
+      return;
+    }
+    running = false;
+  }
+  cv_task.notify_all();
+  for (std::unique_ptr<worker_t>& w : workers) {
+    w->stop();
+  }
+  workers.clear();
+
+  // Tasks left behind still complete their groups, so producers do not wait forever
+  std::unique_lock<std::mutex> lock(mutex);
+  while (not heap.empty()) {
+    pending_task_t t = pop_task();
+    run_task(lock, t);
+  }
+}
+
+void edf_task_pool::push_task(task_group& group, uint32_t type, time_point deadline, task_t&& task)
+{
+  if (type >= stats.size()) {
+    logger.error("Invalid task type %d", type);
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    group.pending++;
+    heap.push_back(pending_task_t{deadline, seq++, type, &group, std::move(task)});
+    std::push_heap(heap.begin(), heap.end(), later);
+  }
+  cv_task.notify_one();
+}
+
+void edf_task_pool::wait(task_group& group)
+{
+  std::unique_lock<std::mutex> lock(mutex);
+  while (group.pending > 0) {
+    if (not heap.empty()) {
+      pending_task_t t = pop_task();
+      run_task(lock, t);
+    } else {
+      cv_done.wait(lock);
+    }
+  }
+}
+
+std::vector<edf_task_pool::type_metrics_t> edf_task_pool::get_metrics()
+{
+  std::lock_guard<std::mutex> lock(mutex);
+
+  std::vector<type_metrics_t> ret(stats.size());
+  for (uint32_t i = 0; i < stats.size(); ++i) {
+    type_stats_t& s = stats[i];
+    if (s.nof_tasks > 0) {
+      ret[i].nof_tasks      = s.nof_tasks;
+      ret[i].nof_misses     = s.nof_misses;
+      ret[i].avg_slack_us   = (float)(s.sum_slack_us / s.nof_tasks);
+      ret[i].min_slack_us   = (float)s.min_slack_us;
+      ret[i].avg_runtime_us = (float)(s.sum_runtime_us / s.nof_tasks);
+    }
+    s = {};
+  }
+  return ret;
+}
+
+uint32_t edf_task_pool::nof_pending_tasks() const
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  return heap.size();
+}
+
+edf_task_pool::pending_task_t edf_task_pool::pop_task()
+{
+  std::pop_heap(heap.begin(), heap.end(), later);
+  pending_task_t t = std::move(heap.back());
+  heap.pop_back();
+  return t;
+}
+
+void edf_task_pool::run_task(std::unique_lock<std::mutex>& lock, pending_task_t& t)
+{
+  lock.unlock();
+  time_point start = std::chrono::steady_clock::now();
+  t.task();
+  time_point end = std::chrono::steady_clock::now();
+  lock.lock();
+
+  double        slack_us = std::chrono::duration<double, std::micro>(t.deadline - end).count();
+  type_stats_t& s        = stats[t.type];
+  s.min_slack_us         = (s.nof_tasks == 0) ? slack_us : std::min(s.min_slack_us, slack_us);
+  s.nof_tasks++;
+  s.nof_misses += (slack_us < 0) ? 1 : 0;
+  s.sum_slack_us += slack_us;
+  s.sum_runtime_us += std::chrono::duration<double, std::micro>(end - start).count();
+
+  t.group->pending--;
+  if (t.group->pending == 0) {
+    cv_done.notify_all();
+  }
+}
+
+edf_task_pool::worker_t::worker_t(edf_task_pool* parent_, uint32_t id) :
+  thread("EDFWORKER" + std::to_string(id)), parent(parent_)
+{
+  if (parent->mask == 255) {
+    start(parent->prio);
+  } else {
+    start_cpu_mask(parent->prio, parent->mask);
+  }
+}
+
+void edf_task_pool::worker_t::run_thread()
+{
+  std::unique_lock<std::mutex> lock(parent->mutex);
+  while (parent->running) {
+    if (parent->heap.empty()) {
+      parent->cv_task.wait(lock);
+      continue;
+    }
+    pending_task_t t = parent->pop_task();
+    parent->run_task(lock, t);
+  }
+}
+
+} // namespace srsran
@@ -1272,6 +1272,111 @@ liblte_security_milenage_f2345(uint8* k, uint8* op_c, uint8* rand, uint8* res, u
   return (err);
 }
 
+/*********************************************************************
+    Name: liblte_security_milenage_f12345
+
+    Description: Milenage security functions F1, F2, F3, F4, and F5
+                 for the authentication of the network.  Computes
+                 RES, CK, IK and AK from random challenge RAND, and
+                 MAC-A from the SQN and AMF carried in AUTN.  The
+                 round keys and the intermediate value TEMP are
+                 shared by all functions.
+
+    Document Reference: 35.206 v10.0.0 Annex 3
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_security_milenage_f12345(uint8* k,
+                                                  uint8* op_c,
+                                                  uint8* rand,
+                                                  uint8* autn,
+                                                  uint8* mac_a,
+                                                  uint8* res,
+                                                  uint8* ck,
+                                                  uint8* ik,
+                                                  uint8* ak)
+{
+  LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+  uint32            i;
+  uint8             temp[16];
+  uint8             in1[16];
+  uint8             out[16];
+  uint8             input[16];
+  aes_context       ctx;
+
+  if (k != NULL && op_c != NULL && rand != NULL && autn != NULL && mac_a != NULL && res != NULL && ck != NULL &&
+      ik != NULL && ak != NULL) {
+    // Initialize the round keys
+    aes_setkey_enc(&ctx, k, 128);
+
+    // Compute temp
+    for (i = 0; i < 16; i++) {
+      input[i] = rand[i] ^ op_c[i];
+    }
+    aes_crypt_ecb(&ctx, AES_ENCRYPT, input, temp);
+
+    // Compute out for RES and AK
+    for (i = 0; i < 16; i++) {
+      input[i] = temp[i] ^ op_c[i];
+    }
+    input[15] ^= 1;
+    aes_crypt_ecb(&ctx, AES_ENCRYPT, input, out);
+    for (i = 0; i < 16; i++) {
+      out[i] ^= op_c[i];
+    }
+    for (i = 0; i < 8; i++) {
+      res[i] = out[i + 8];
+    }
+    for (i = 0; i < 6; i++) {
+      ak[i] = out[i];
+    }
+
+    // Compute out for CK
+    for (i = 0; i < 16; i++) {
+      input[(i + 12) % 16] = temp[i] ^ op_c[i];
+    }
+    input[15] ^= 2;
+    aes_crypt_ecb(&ctx, AES_ENCRYPT, input, out);
+    for (i = 0; i < 16; i++) {
+      ck[i] = out[i] ^ op_c[i];
+    }
+
+    // Compute out for IK
+    for (i = 0; i < 16; i++) {
+      input[(i + 8) % 16] = temp[i] ^ op_c[i];
+    }
+    input[15] ^= 4;
+    aes_crypt_ecb(&ctx, AES_ENCRYPT, input, out);
+    for (i = 0; i < 16; i++) {
+      ik[i] = out[i] ^ op_c[i];
+    }
+
+    // Construct in1 from the SQN, concealed by AK, and the AMF of AUTN
+    for (i = 0; i < 6; i++) {
+      in1[i]     = autn[i] ^ ak[i];
+      in1[i + 8] = in1[i];
+    }
+    for (i = 0; i < 2; i++) {
+      in1[i + 6]  = autn[i + 6];
+      in1[i + 14] = autn[i + 6];
+    }
+
+    // Compute out1 for MAC-A
+    for (i = 0; i < 16; i++) {
+      input[(i + 8) % 16] = in1[i] ^ op_c[i];
+    }
+    for (i = 0; i < 16; i++) {
+      input[i] ^= temp[i];
+    }
+    aes_crypt_ecb(&ctx, AES_ENCRYPT, input, out);
+    for (i = 0; i < 8; i++) {
+      mac_a[i] = out[i] ^ op_c[i];
+    }
+
+    err = LIBLTE_SUCCESS;
+  }
+
+  return (err);
+}
+
 /*********************************************************************
     Name: liblte_security_milenage_f5_star
 
@@ -33,7 +33,7 @@ static void emergency_cleanup_handler(void* data)
   reinterpret_cast<mac_pcap_base*>(data)->close();
 }
 
-mac_pcap_base::mac_pcap_base() : logger(srslog::fetch_basic_logger("MAC")), thread("PCAP_WRITER_MAC")
+mac_pcap_base::mac_pcap_base() : logger(srslog::fetch_basic_logger("MAC"))
 {
   add_emergency_cleanup_handler(emergency_cleanup_handler, this);
 }
@@ -52,26 +52,7 @@ void mac_pcap_base::set_ue_id(uint16_t ue_id_)
   ue_id = ue_id_;
 }
 
-void mac_pcap_base::run_thread()
-{
-  // blocking write until stopped
-  while (running) {
-    pcap_pdu_t pdu = queue.pop_blocking();
-    {
-      std::lock_guard<std::mutex> lock(mutex);
-      write_pdu(pdu);
-    }
-  }
-
-  // write remainder of queue
-  pcap_pdu_t pdu = {};
-  while (queue.try_pop(pdu)) {
-    std::lock_guard<std::mutex> lock(mutex);
-    write_pdu(pdu);
-  }
-}
-
-// Function called from PHY worker context, locking not needed as PDU queue is thread-safe
+// Function called from PHY worker context, locking not needed as the writers are thread-safe
 void mac_pcap_base::pack_and_queue(uint8_t* payload,
                                    uint32_t payload_len,
                                    uint16_t ue_id,
@@ -96,23 +77,13 @@ void mac_pcap_base::pack_and_queue(uint8_t* payload,
     pdu.context.cc_idx         = cc_idx;
     pdu.context.sysFrameNumber = (uint16_t)(tti / 10);
     pdu.context.subFrameNumber = (uint16_t)(tti % 10);
-
-    // try to allocate PDU buffer
-    pdu.pdu = srsran::make_byte_buffer();
-    if (pdu.pdu != nullptr && pdu.pdu->get_tailroom() >= payload_len) {
-      // copy payload into PDU buffer
-      memcpy(pdu.pdu->msg, payload, payload_len);
-      pdu.pdu->N_bytes = payload_len;
-      if (not queue.try_push(std::move(pdu))) {
-        logger.warning("Dropping PDU (%d B) in PCAP. Write queue full.", payload_len);
-      }
-    } else {
-      logger.warning("Dropping PDU in PCAP. No buffer available or not enough space (pdu_len=%d).", payload_len);
-    }
+    pdu.payload                = payload;
+    pdu.payload_len            = payload_len;
+    write_pdu(pdu);
   }
 }
 
-// Function called from PHY worker context, locking not needed as PDU queue is thread-safe
+// Function called from PHY worker context, locking not needed as the writers are thread-safe
 void mac_pcap_base::pack_and_queue_nr(uint8_t* payload,
                                       uint32_t payload_len,
                                       uint32_t tti,
@@ -133,19 +104,9 @@ void mac_pcap_base::pack_and_queue_nr(uint8_t* payload,
     pdu.context_nr.harqid              = harqid;
     pdu.context_nr.system_frame_number = tti / 10;
     pdu.context_nr.sub_frame_number    = tti % 10;
-
-    // try to allocate PDU buffer
-    pdu.pdu = srsran::make_byte_buffer();
-    if (pdu.pdu != nullptr && pdu.pdu->get_tailroom() >= payload_len) {
-      // copy payload into PDU buffer
-      memcpy(pdu.pdu->msg, payload, payload_len);
-      pdu.pdu->N_bytes = payload_len;
-      if (not queue.try_push(std::move(pdu))) {
-        logger.warning("Dropping PDU (%d B) in NR PCAP. Write queue full.", payload_len);
-      }
-    } else {
-      logger.warning("Dropping PDU in NR PCAP. No buffer available or not enough space (pdu_len=%d).", payload_len);
-    }
+    pdu.payload                        = payload;
+    pdu.payload_len                    = payload_len;
+    write_pdu(pdu);
   }
 }
 
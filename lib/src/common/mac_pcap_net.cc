@@ -20,10 +20,12 @@
  */
 
 #include "srsran/common/mac_pcap_net.h"
+#include <inttypes.h>
+#include <thread>
 
 namespace srsran {
 
-mac_pcap_net::mac_pcap_net() : mac_pcap_base() {}
+mac_pcap_net::mac_pcap_net() : mac_pcap_base(), thread("PCAP_WRITER_MAC") {}
 
 mac_pcap_net::~mac_pcap_net()
 {
@@ -65,6 +67,7 @@ uint32_t mac_pcap_net::open(std::string client_ip_addr_,
   }
   running                     = true;
   ue_id                       = ue_id_;
+  ring.init(ring_size);
   // start writer thread
   start();
 
@@ -79,13 +82,13 @@ uint32_t mac_pcap_net::close()
       return SRSRAN_ERROR;
     }
 
-    // tell writer thread to stop
-    running        = false;
-    pcap_pdu_t pdu = {};
-    queue.push_blocking(std::move(pdu));
+    // tell writer thread to stop once the PDUs being queued are in the ring
+    ring.stop();
+    running = false;
   }
 
   wait_thread_finish();
+  ring.release();
   // close socket handle
   if (socket.is_open()) {
     std::lock_guard<std::mutex> lock(mutex);
@@ -97,85 +100,63 @@ uint32_t mac_pcap_net::close()
 
 void mac_pcap_net::write_pdu(pcap_pdu_t& pdu)
 {
-  if (pdu.pdu != nullptr && socket.is_open()) {
-    switch (pdu.rat) {
-      case srsran_rat_t::lte:
-        write_mac_lte_pdu_to_net(pdu);
-        break;
-      case srsran_rat_t::nr:
-        write_mac_nr_pdu_to_net(pdu);
-        break;
-      default:
-        logger.error("Error writing PDU to PCAP socket. Unsupported RAT selected.");
+  if (pdu.payload == nullptr) {
+    return;
+  }
+  if (pdu.rat != srsran_rat_t::lte and pdu.rat != srsran_rat_t::nr) {
+    logger.error("Error writing PDU to PCAP socket. Unsupported RAT selected.");
+    return;
+  }
+
+  // Format the datagram in place, the writer thread only sends it
+  bool ret = ring.push(PCAP_CONTEXT_HEADER_MAX + pdu.payload_len, [&pdu](uint8_t* data) {
+    // MAC_LTE_START_STRING for UDP heuristics
+    uint32_t offset = strlen(MAC_LTE_START_STRING);
+    memcpy(data, MAC_LTE_START_STRING, offset);
+    if (pdu.rat == srsran_rat_t::lte) {
+      offset += LTE_PCAP_PACK_MAC_CONTEXT_TO_BUFFER(&pdu.context, data + offset, PCAP_CONTEXT_HEADER_MAX);
+    } else {
+      offset += NR_PCAP_PACK_MAC_CONTEXT_TO_BUFFER(&pdu.context_nr, data + offset, PCAP_CONTEXT_HEADER_MAX);
     }
+    memcpy(data + offset, pdu.payload, pdu.payload_len);
+    return offset + pdu.payload_len;
+  });
+  if (not ret and running) {
+    nof_dropped.fetch_add(1, std::memory_order_relaxed);
   }
 }
 
-void mac_pcap_net::write_mac_lte_pdu_to_net(pcap_pdu_t& pdu)
+void mac_pcap_net::run_thread()
 {
-  int      bytes_sent;
-  uint32_t offset = 0;
-  uint8_t  buffer[PCAP_CONTEXT_HEADER_MAX];
-
-  // MAC_LTE_START_STRING for UDP heuristics
-  memcpy(buffer + offset, MAC_LTE_START_STRING, strlen(MAC_LTE_START_STRING));
-  offset += strlen(MAC_LTE_START_STRING);
-
-  offset += LTE_PCAP_PACK_MAC_CONTEXT_TO_BUFFER(&pdu.context, buffer + offset, PCAP_CONTEXT_HEADER_MAX);
+  auto send = [this](const uint8_t* data, uint32_t len) { send_to_net(data, len); };
 
-  if (pdu.pdu.get()->get_headroom() < offset) {
-    logger.error("PDU headroom is to small for adding context buffer");
-    return;
+  // send until stopped, sleeping while there is nothing to send
+  while (running) {
+    if (ring.pop_all(send) == 0) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
   }
 
-  pdu.pdu.get()->msg -= offset;
-  memcpy(pdu.pdu.get()->msg, buffer, offset);
-  pdu.pdu.get()->N_bytes += offset;
+  // send remainder of the ring
+  ring.pop_all(send);
 
-  bytes_sent = sendto(socket.get_socket(),
-                      pdu.pdu.get()->msg,
-                      pdu.pdu.get()->N_bytes,
-                      0,
-                      (const struct sockaddr*)&client_addr,
-                      sizeof(client_addr));
-
-  if ((int)pdu.pdu.get()->N_bytes != bytes_sent || bytes_sent < 0) {
-    logger.error(
-        "Sending UDP packet mismatches %d != %d (err %s)", pdu.pdu.get()->N_bytes, bytes_sent, strerror(errno));
+  uint64_t dropped = nof_dropped.exchange(0);
+  if (dropped > 0) {
+    logger.warning("Dropped %" PRIu64 " PDUs in MAC PCAP socket. Write queue full.", dropped);
   }
 }
 
-void mac_pcap_net::write_mac_nr_pdu_to_net(pcap_pdu_t& pdu)
+void mac_pcap_net::send_to_net(const uint8_t* datagram, uint32_t len)
 {
-  int      bytes_sent;
-  uint32_t offset = 0;
-  uint8_t  buffer[PCAP_CONTEXT_HEADER_MAX];
-
-  // MAC_LTE_START_STRING for UDP heuristics
-  memcpy(buffer + offset, MAC_LTE_START_STRING, strlen(MAC_LTE_START_STRING));
-  offset += strlen(MAC_LTE_START_STRING);
-
-  offset += NR_PCAP_PACK_MAC_CONTEXT_TO_BUFFER(&pdu.context_nr, buffer + offset, PCAP_CONTEXT_HEADER_MAX);
-
-  if (pdu.pdu.get()->get_headroom() < offset) {
-    logger.error("PDU headroom is to small for adding context buffer");
+  if (not socket.is_open()) {
     return;
   }
 
-  pdu.pdu.get()->msg -= offset;
-  memcpy(pdu.pdu.get()->msg, buffer, offset);
-  pdu.pdu.get()->N_bytes += offset;
-
-  bytes_sent = sendto(socket.get_socket(),
-                      pdu.pdu.get()->msg,
-                      pdu.pdu.get()->N_bytes,
-                      0,
-                      (const struct sockaddr*)&client_addr,
-                      sizeof(client_addr));
+  int bytes_sent =
+      sendto(socket.get_socket(), datagram, len, 0, (const struct sockaddr*)&client_addr, sizeof(client_addr));
 
-  if ((int)pdu.pdu.get()->N_bytes != bytes_sent || bytes_sent < 0) {
-    logger.error(
-        "Sending UDP packet mismatches %d != %d (err %s)", pdu.pdu.get()->N_bytes, bytes_sent, strerror(errno));
+  if ((int)len != bytes_sent || bytes_sent < 0) {
+    logger.error("Sending UDP packet mismatches %d != %d (err %s)", len, bytes_sent, strerror(errno));
   }
 }
-} // namespace srsran
\ No newline at end of file
+} // namespace srsran
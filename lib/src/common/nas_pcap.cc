@@ -26,6 +26,8 @@
 
 namespace srsran {
 
+nas_pcap::nas_pcap() : writer("PCAP_WRITER_NAS", srslog::fetch_basic_logger("NAS"), pcap_writer::small_ring_size) {}
+
 void nas_pcap::enable()
 {
   enable_write = true;
@@ -33,13 +35,8 @@ void nas_pcap::enable()
 
 uint32_t nas_pcap::open(std::string filename_, uint32_t ue_id_, srsran_rat_t rat_type)
 {
-  filename = filename_;
-  if (rat_type == srsran_rat_t::nr) {
-    pcap_file = DLT_PCAP_Open(NAS_5G_DLT, filename.c_str());
-  } else {
-    pcap_file = DLT_PCAP_Open(NAS_LTE_DLT, filename.c_str());
-  }
-  if (pcap_file == nullptr) {
+  uint32_t dlt = (rat_type == srsran_rat_t::nr) ? NAS_5G_DLT : NAS_LTE_DLT;
+  if (writer.open(filename_, dlt) != SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
   ue_id        = ue_id_;
@@ -49,17 +46,19 @@ uint32_t nas_pcap::open(std::string filename_, uint32_t ue_id_, srsran_rat_t rat
 
 void nas_pcap::close()
 {
-  fprintf(stdout, "Saving NAS PCAP file (DLT=%d) to %s \n", NAS_LTE_DLT, filename.c_str());
-  DLT_PCAP_Close(pcap_file);
+  fprintf(stdout, "Saving NAS PCAP file (DLT=%d) to %s \n", writer.get_dlt(), writer.get_filename().c_str());
+  enable_write = false;
+  writer.close();
 }
 
 void nas_pcap::write_nas(uint8_t* pdu, uint32_t pdu_len_bytes)
 {
-  if (enable_write) {
-    NAS_Context_Info_t context;
-    if (pdu) {
-      LTE_PCAP_NAS_WritePDU(pcap_file, &context, pdu, pdu_len_bytes);
-    }
+  if (enable_write && pdu) {
+    // No NAS context, the record is the PDU
+    writer.write(pdu_len_bytes, [pdu, pdu_len_bytes](uint8_t* data) {
+      memcpy(data, pdu, pdu_len_bytes);
+      return pdu_len_bytes;
+    });
   }
 }
 
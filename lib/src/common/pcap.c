@@ -146,23 +146,14 @@ inline int LTE_PCAP_MAC_WritePDU(FILE* fd, MAC_Context_Info_t* context, const un
   return 1;
 }
 
-/* Write an individual PDU (PCAP packet header + mac-context + mac-pdu) */
-inline int
-LTE_PCAP_MAC_UDP_WritePDU(FILE* fd, MAC_Context_Info_t* context, const unsigned char* PDU, unsigned int length)
+/* Packs the dummy UDP header and the MAC context that precede a MAC PDU of the given length */
+int LTE_PCAP_PACK_MAC_UDP_HEADER(MAC_Context_Info_t* context, unsigned int length, uint8_t* buffer)
 {
-  pcaprec_hdr_t  packet_header;
-  uint8_t        context_header[PCAP_CONTEXT_HEADER_MAX] = {};
-  int            offset                                  = 0;
+  int            offset = 0;
   struct udphdr* udp_header;
-  // uint16_t       tmp16;
 
-  /* Can't write if file wasn't successfully opened */
-  if (fd == NULL) {
-    printf("Error: Can't write to empty file handle\n");
-    return 0;
-  }
   // Add dummy UDP header, start with src and dest port
-  udp_header       = (struct udphdr*)context_header;
+  udp_header       = (struct udphdr*)buffer;
   udp_header->dest = htons(0xdead);
   offset += 2;
   udp_header->source = htons(0xbeef);
@@ -175,12 +166,30 @@ LTE_PCAP_MAC_UDP_WritePDU(FILE* fd, MAC_Context_Info_t* context, const unsigned
   offset += 2;
 
   // Start magic string
-  memcpy(&context_header[offset], MAC_LTE_START_STRING, strlen(MAC_LTE_START_STRING));
+  memcpy(&buffer[offset], MAC_LTE_START_STRING, strlen(MAC_LTE_START_STRING));
   offset += strlen(MAC_LTE_START_STRING);
 
-  offset += LTE_PCAP_PACK_MAC_CONTEXT_TO_BUFFER(context, &context_header[offset], PCAP_CONTEXT_HEADER_MAX);
+  offset += LTE_PCAP_PACK_MAC_CONTEXT_TO_BUFFER(context, &buffer[offset], PCAP_CONTEXT_HEADER_MAX);
   udp_header->len = htons(length + offset);
 
+  return offset;
+}
+
+/* Write an individual PDU (PCAP packet header + mac-context + mac-pdu) */
+inline int
+LTE_PCAP_MAC_UDP_WritePDU(FILE* fd, MAC_Context_Info_t* context, const unsigned char* PDU, unsigned int length)
+{
+  pcaprec_hdr_t packet_header;
+  uint8_t       context_header[PCAP_CONTEXT_HEADER_MAX] = {};
+  int           offset                                  = 0;
+
+  /* Can't write if file wasn't successfully opened */
+  if (fd == NULL) {
+    printf("Error: Can't write to empty file handle\n");
+    return 0;
+  }
+  offset += LTE_PCAP_PACK_MAC_UDP_HEADER(context, length, context_header);
+
   /****************************************************************/
   /* PCAP Header                                                  */
   struct timeval t;
@@ -231,75 +240,83 @@ int LTE_PCAP_NAS_WritePDU(FILE* fd, NAS_Context_Info_t* context, const unsigned
  * API functions for writing RLC-LTE PCAP files                           *
  **************************************************************************/
 
-/* Write an individual RLC PDU (PCAP packet header + UDP header + rlc-context + rlc-pdu) */
-int LTE_PCAP_RLC_WritePDU(FILE* fd, RLC_Context_Info_t* context, const unsigned char* PDU, unsigned int length)
+/* Packs the dummy UDP header and the RLC context that precede a RLC PDU of the given length */
+int LTE_PCAP_PACK_RLC_UDP_HEADER(RLC_Context_Info_t* context, unsigned int length, uint8_t* buffer)
 {
-  pcaprec_hdr_t packet_header;
-  char          context_header[PCAP_CONTEXT_HEADER_MAX] = {};
-  int           offset                                  = 0;
-  uint16_t      tmp16;
-
-  /* Can't write if file wasn't successfully opened */
-  if (fd == NULL) {
-    printf("Error: Can't write to empty file handle\n");
-    return 0;
-  }
-
-  /*****************************************************************/
+  int      offset = 0;
+  uint16_t tmp16;
 
   // Add dummy UDP header, start with src and dest port
-  context_header[offset++] = 0xde;
-  context_header[offset++] = 0xad;
-  context_header[offset++] = 0xbe;
-  context_header[offset++] = 0xef;
+  buffer[offset++] = 0xde;
+  buffer[offset++] = 0xad;
+  buffer[offset++] = 0xbe;
+  buffer[offset++] = 0xef;
   // length
   tmp16 = length + 30;
   if (context->rlcMode == RLC_UM_MODE) {
     tmp16 += 2; // RLC UM requires two bytes more for SN length (see below
   }
-  context_header[offset++] = (tmp16 & 0xff00) >> 8;
-  context_header[offset++] = (tmp16 & 0xff);
+  buffer[offset++] = (tmp16 & 0xff00) >> 8;
+  buffer[offset++] = (tmp16 & 0xff);
   // dummy CRC
-  context_header[offset++] = 0xde;
-  context_header[offset++] = 0xad;
+  buffer[offset++] = 0xde;
+  buffer[offset++] = 0xad;
 
   // Start magic string
-  memcpy(&context_header[offset], RLC_LTE_START_STRING, strlen(RLC_LTE_START_STRING));
+  memcpy(&buffer[offset], RLC_LTE_START_STRING, strlen(RLC_LTE_START_STRING));
   offset += strlen(RLC_LTE_START_STRING);
 
   // Fixed field RLC mode
-  context_header[offset++] = context->rlcMode;
+  buffer[offset++] = context->rlcMode;
 
   // Conditional fields
   if (context->rlcMode == RLC_UM_MODE) {
-    context_header[offset++] = RLC_LTE_SN_LENGTH_TAG;
-    context_header[offset++] = context->sequenceNumberLength;
+    buffer[offset++] = RLC_LTE_SN_LENGTH_TAG;
+    buffer[offset++] = context->sequenceNumberLength;
   }
 
   // Optional fields
-  context_header[offset++] = RLC_LTE_DIRECTION_TAG;
-  context_header[offset++] = context->direction;
+  buffer[offset++] = RLC_LTE_DIRECTION_TAG;
+  buffer[offset++] = context->direction;
 
-  context_header[offset++] = RLC_LTE_PRIORITY_TAG;
-  context_header[offset++] = context->priority;
+  buffer[offset++] = RLC_LTE_PRIORITY_TAG;
+  buffer[offset++] = context->priority;
 
-  context_header[offset++] = RLC_LTE_UEID_TAG;
-  tmp16                    = htons(context->ueid);
-  memcpy(context_header + offset, &tmp16, 2);
+  buffer[offset++] = RLC_LTE_UEID_TAG;
+  tmp16            = htons(context->ueid);
+  memcpy(buffer + offset, &tmp16, 2);
   offset += 2;
 
-  context_header[offset++] = RLC_LTE_CHANNEL_TYPE_TAG;
-  tmp16                    = htons(context->channelType);
-  memcpy(context_header + offset, &tmp16, 2);
+  buffer[offset++] = RLC_LTE_CHANNEL_TYPE_TAG;
+  tmp16            = htons(context->channelType);
+  memcpy(buffer + offset, &tmp16, 2);
   offset += 2;
 
-  context_header[offset++] = RLC_LTE_CHANNEL_ID_TAG;
-  tmp16                    = htons(context->channelId);
-  memcpy(context_header + offset, &tmp16, 2);
+  buffer[offset++] = RLC_LTE_CHANNEL_ID_TAG;
+  tmp16            = htons(context->channelId);
+  memcpy(buffer + offset, &tmp16, 2);
   offset += 2;
 
   // Now the actual PDU
-  context_header[offset++] = RLC_LTE_PAYLOAD_TAG;
+  buffer[offset++] = RLC_LTE_PAYLOAD_TAG;
+
+  return offset;
+}
+
+/* Write an individual RLC PDU (PCAP packet header + UDP header + rlc-context + rlc-pdu) */
+int LTE_PCAP_RLC_WritePDU(FILE* fd, RLC_Context_Info_t* context, const unsigned char* PDU, unsigned int length)
+{
+  pcaprec_hdr_t packet_header;
+  uint8_t       context_header[PCAP_CONTEXT_HEADER_MAX] = {};
+  int           offset                                  = 0;
+
+  /* Can't write if file wasn't successfully opened */
+  if (fd == NULL) {
+    printf("Error: Can't write to empty file handle\n");
+    return 0;
+  }
+
+  offset += LTE_PCAP_PACK_RLC_UDP_HEADER(context, length, context_header);
 
   // PCAP header
   struct timeval t;
@@ -397,21 +414,14 @@ inline int NR_PCAP_PACK_MAC_CONTEXT_TO_BUFFER(mac_nr_context_info_t* context, ui
   return offset;
 }
 
-/* Write an individual NR MAC PDU (PCAP packet header + UDP header + nr-mac-context + mac-pdu) */
-int NR_PCAP_MAC_UDP_WritePDU(FILE* fd, mac_nr_context_info_t* context, const unsigned char* PDU, unsigned int length)
+/* Packs the dummy UDP header and the NR MAC context that precede a MAC PDU of the given length */
+int NR_PCAP_PACK_MAC_UDP_HEADER(mac_nr_context_info_t* context, unsigned int length, uint8_t* buffer)
 {
-  uint8_t        context_header[PCAP_CONTEXT_HEADER_MAX] = {};
   struct udphdr* udp_header;
   int            offset = 0;
 
-  /* Can't write if file wasn't successfully opened */
-  if (fd == NULL) {
-    printf("Error: Can't write to empty file handle\n");
-    return -1;
-  }
-
   // Add dummy UDP header, start with src and dest port
-  udp_header       = (struct udphdr*)context_header;
+  udp_header       = (struct udphdr*)buffer;
   udp_header->dest = htons(0xdead);
   offset += 2;
   udp_header->source = htons(0xbeef);
@@ -424,16 +434,32 @@ int NR_PCAP_MAC_UDP_WritePDU(FILE* fd, mac_nr_context_info_t* context, const uns
   offset += 2;
 
   // Start magic string
-  memcpy(&context_header[offset], MAC_NR_START_STRING, strlen(MAC_NR_START_STRING));
+  memcpy(&buffer[offset], MAC_NR_START_STRING, strlen(MAC_NR_START_STRING));
   offset += strlen(MAC_NR_START_STRING);
 
-  offset += NR_PCAP_PACK_MAC_CONTEXT_TO_BUFFER(context, &context_header[offset], PCAP_CONTEXT_HEADER_MAX);
+  offset += NR_PCAP_PACK_MAC_CONTEXT_TO_BUFFER(context, &buffer[offset], PCAP_CONTEXT_HEADER_MAX);
 
   udp_header->len = htons(offset + length);
 
   if (offset != 31) {
     printf("ERROR Does not match offset %d != 31\n", offset);
   }
+  return offset;
+}
+
+/* Write an individual NR MAC PDU (PCAP packet header + UDP header + nr-mac-context + mac-pdu) */
+int NR_PCAP_MAC_UDP_WritePDU(FILE* fd, mac_nr_context_info_t* context, const unsigned char* PDU, unsigned int length)
+{
+  uint8_t context_header[PCAP_CONTEXT_HEADER_MAX] = {};
+  int     offset                                  = 0;
+
+  /* Can't write if file wasn't successfully opened */
+  if (fd == NULL) {
+    printf("Error: Can't write to empty file handle\n");
+    return -1;
+  }
+
+  offset += NR_PCAP_PACK_MAC_UDP_HEADER(context, length, context_header);
 
   /****************************************************************/
   /* PCAP Header                                                  */
@@ -0,0 +1,257 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/pcap_writer.h"
+#include "srsran/config.h"
+#include <algorithm>
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <thread>
+#include <unistd.h>
+
+namespace srsran {
+
+/// Time the writer thread sleeps when there are no records to write
+static const std::chrono::milliseconds idle_sleep{2};
+
+/// Minimum time between two warnings about dropped records
+static const std::chrono::seconds drop_report_period{1};
+
+void pcap_ring::init(size_t capacity_bytes)
+{
+  capacity = sizeof(header_t);
+  while (capacity < capacity_bytes) {
+    capacity <<= 1U;
+  }
+  mask = capacity - 1;
+  storage.reset(new uint64_t[capacity / sizeof(uint64_t)]());
+  buffer = reinterpret_cast<uint8_t*>(storage.get());
+  head.store(0, std::memory_order_relaxed);
+  tail.store(0, std::memory_order_relaxed);
+  accepting.store(true);
+}
+
+void pcap_ring::stop()
+{
+  accepting.store(false);
+  while (nof_producers.load() > 0) {
+    std::this_thread::yield();
+  }
+}
+
+void pcap_ring::release()
+{
+  storage.reset();
+  buffer   = nullptr;
+  capacity = 0;
+  mask     = 0;
+}
+
+/// Returns the name of the file with the given rotation index, the first file keeps the configured name
+static std::string rotated_filename(const std::string& filename, uint32_t idx)
+{
+  if (idx == 0) {
+    return filename;
+  }
+  size_t dot   = filename.rfind('.');
+  size_t slash = filename.rfind('/');
+  if (dot == std::string::npos or (slash != std::string::npos and dot < slash)) {
+    dot = filename.size();
+  }
+  return filename.substr(0, dot) + "_" + std::to_string(idx) + filename.substr(dot);
+}
+
+pcap_writer::pcap_writer(const std::string& thread_name, srslog::basic_logger& logger_, size_t ring_size) :
+  thread(thread_name), logger(logger_), ring_size(ring_size)
+{}
+
+pcap_writer::~pcap_writer()
+{
+  close();
+}
+
+int pcap_writer::open(const std::string& filename_, uint32_t dlt_, const pcap_rotation_t& rotation_)
+{
+  if (is_open()) {
+    logger.error("PCAP writer for %s already running. Close first.", filename.c_str());
+    return SRSRAN_ERROR;
+  }
+
+  filename = filename_;
+  dlt      = dlt_;
+  rotation = rotation_;
+  file_idx = 0;
+  batch.resize(std::min(batch_size, ring_size));
+  if (not open_file()) {
+    std::vector<uint8_t>().swap(batch);
+    return SRSRAN_ERROR;
+  }
+  ring.init(ring_size);
+
+  last_dropped = nof_dropped.load(std::memory_order_relaxed);
+  running      = true;
+  opened       = true;
+  start();
+
+  return SRSRAN_SUCCESS;
+}
+
+void pcap_writer::close()
+{
+  if (not opened.exchange(false)) {
+    return;
+  }
+
+  // Records queued from now on are dropped, the writer thread writes the remaining ones before it finishes
+  ring.stop();
+  running = false;
+  wait_thread_finish();
+  close_file();
+
+  ring.release();
+  std::vector<uint8_t>().swap(batch);
+}
+
+void pcap_writer::run_thread()
+{
+  auto consume     = [this](const uint8_t* data, uint32_t len) { append(data, len); };
+  auto last_report = std::chrono::steady_clock::now();
+
+  while (running.load(std::memory_order_relaxed)) {
+    if (ring.pop_all(consume) == 0) {
+      // The ring is idle, write what is pending and give the producers some time
+      flush();
+      std::this_thread::sleep_for(idle_sleep);
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    if (rotation.max_duration_s > 0 and now - file_start >= std::chrono::seconds(rotation.max_duration_s)) {
+      rotate();
+    }
+    if (now - last_report >= drop_report_period) {
+      uint64_t dropped = nof_dropped.load(std::memory_order_relaxed);
+      if (dropped != last_dropped) {
+        logger.warning(
+            "Dropped %" PRIu64 " packets in PCAP %s. Write queue full.", dropped - last_dropped, filename.c_str());
+        last_dropped = dropped;
+      }
+      last_report = now;
+    }
+  }
+
+  // write remainder of the ring
+  ring.pop_all(consume);
+  flush();
+}
+
+void pcap_writer::append(const uint8_t* data, uint32_t len)
+{
+  if (rotation.max_size_mb > 0 and file_size + len > rotation.max_size_mb * 1024ULL * 1024ULL and
+      file_size > sizeof(pcap_hdr_t)) {
+    rotate();
+  }
+
+  if (fd < 0) {
+    // The last rotation could not open a file, the record is dropped until the next one
+    nof_dropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  if (batch_len + len > batch.size()) {
+    flush();
+  }
+  if (len > batch.size()) {
+    // Larger than the batch buffer, write it directly
+    if (::write(fd, data, len) != (ssize_t)len) {
+      logger.error("Error writing to PCAP %s: %s", filename.c_str(), strerror(errno));
+    }
+  } else {
+    memcpy(batch.data() + batch_len, data, len);
+    batch_len += len;
+  }
+  file_size += len;
+}
+
+bool pcap_writer::flush()
+{
+  size_t offset = 0;
+  while (fd >= 0 and offset < batch_len) {
+    ssize_t n = ::write(fd, batch.data() + offset, batch_len - offset);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      logger.error("Error writing to PCAP %s: %s", filename.c_str(), strerror(errno));
+      break;
+    }
+    offset += n;
+  }
+  bool ret  = offset == batch_len;
+  batch_len = 0;
+  return ret;
+}
+
+bool pcap_writer::open_file()
+{
+  std::string name = rotated_filename(filename, file_idx);
+  file_size        = 0;
+  file_start       = std::chrono::steady_clock::now();
+  fd               = ::open(name.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  if (fd < 0) {
+    logger.error("Couldn't open %s to write PCAP: %s", name.c_str(), strerror(errno));
+    return false;
+  }
+
+  pcap_hdr_t file_header = {
+      0xa1b2c3d4, /* magic number */
+      2,
+      4,     /* version number is 2.4 */
+      0,     /* timezone */
+      0,     /* sigfigs - apparently all tools do this */
+      65535, /* snaplen - this should be long enough */
+      dlt    /* Data Link Type (DLT) */
+  };
+  append(reinterpret_cast<const uint8_t*>(&file_header), sizeof(file_header));
+  return true;
+}
+
+void pcap_writer::close_file()
+{
+  if (fd < 0) {
+    return;
+  }
+  flush();
+  ::close(fd);
+  fd = -1;
+}
+
+void pcap_writer::rotate()
+{
+  close_file();
+  file_idx++;
+  if (open_file()) {
+    logger.info("Rotating PCAP %s to %s", filename.c_str(), rotated_filename(filename, file_idx).c_str());
+  } else {
+    logger.error("Couldn't rotate PCAP %s, dropping packets until the next rotation", filename.c_str());
+  }
+}
+
+} // namespace srsran
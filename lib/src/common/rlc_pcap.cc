@@ -26,6 +26,8 @@
 
 namespace srsran {
 
+rlc_pcap::rlc_pcap() : writer("PCAP_WRITER_RLC", srslog::fetch_basic_logger("RLC")) {}
+
 void rlc_pcap::enable(bool en)
 {
   enable_write = true;
@@ -34,7 +36,7 @@ void rlc_pcap::enable(bool en)
 void rlc_pcap::open(const char* filename, const rlc_config_t& config)
 {
   fprintf(stdout, "Opening RLC PCAP with DLT=%d\n", UDP_DLT);
-  pcap_file    = DLT_PCAP_Open(UDP_DLT, filename);
+  writer.open(filename, UDP_DLT);
   enable_write = true;
 
   if (config.rlc_mode == rlc_mode_t::am) {
@@ -54,7 +56,8 @@ void rlc_pcap::open(const char* filename, const rlc_config_t& config)
 void rlc_pcap::close()
 {
   fprintf(stdout, "Saving RLC PCAP file\n");
-  DLT_PCAP_Close(pcap_file);
+  enable_write = false;
+  writer.close();
 }
 
 void rlc_pcap::set_ue_id(uint16_t ue_id_)
@@ -83,7 +86,11 @@ void rlc_pcap::pack_and_write(uint8_t* pdu,
     context.channelId            = channel_id;
     context.pduLength            = pdu_len_bytes;
     if (pdu) {
-      LTE_PCAP_RLC_WritePDU(pcap_file, &context, pdu, pdu_len_bytes);
+      writer.write(PCAP_CONTEXT_HEADER_MAX + pdu_len_bytes, [&context, pdu, pdu_len_bytes](uint8_t* data) {
+        uint32_t offset = LTE_PCAP_PACK_RLC_UDP_HEADER(&context, pdu_len_bytes, data);
+        memcpy(data + offset, pdu, pdu_len_bytes);
+        return offset + pdu_len_bytes;
+      });
     }
   }
 }
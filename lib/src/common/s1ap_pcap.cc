@@ -33,7 +33,7 @@ static void emergency_cleanup_handler(void* data)
   reinterpret_cast<s1ap_pcap*>(data)->close();
 }
 
-s1ap_pcap::s1ap_pcap()
+s1ap_pcap::s1ap_pcap() : writer("PCAP_WRITER_S1AP", srslog::fetch_basic_logger("S1AP"), pcap_writer::small_ring_size)
 {
   add_emergency_cleanup_handler(emergency_cleanup_handler, this);
 }
@@ -42,10 +42,9 @@ void s1ap_pcap::enable()
 {
   enable_write = true;
 }
-void s1ap_pcap::open(const char* filename_)
+void s1ap_pcap::open(const char* filename_, const pcap_rotation_t& rotation)
 {
-  filename     = filename_;
-  pcap_file    = DLT_PCAP_Open(S1AP_LTE_DLT, filename.c_str());
+  writer.open(filename_, S1AP_LTE_DLT, rotation);
   enable_write = true;
 }
 void s1ap_pcap::close()
@@ -53,17 +52,19 @@ void s1ap_pcap::close()
   if (!enable_write) {
     return;
   }
-  fprintf(stdout, "Saving S1AP PCAP file (DLT=%d) to %s\n", S1AP_LTE_DLT, filename.c_str());
-  DLT_PCAP_Close(pcap_file);
+  enable_write = false;
+  fprintf(stdout, "Saving S1AP PCAP file (DLT=%d) to %s\n", S1AP_LTE_DLT, writer.get_filename().c_str());
+  writer.close();
 }
 
 void s1ap_pcap::write_s1ap(uint8_t* pdu, uint32_t pdu_len_bytes)
 {
-  if (enable_write) {
-    S1AP_Context_Info_t context;
-    if (pdu) {
-      LTE_PCAP_S1AP_WritePDU(pcap_file, &context, pdu, pdu_len_bytes);
-    }
+  if (enable_write && pdu) {
+    // No S1AP context, the record is the PDU
+    writer.write(pdu_len_bytes, [pdu, pdu_len_bytes](uint8_t* data) {
+      memcpy(data, pdu, pdu_len_bytes);
+      return pdu_len_bytes;
+    });
   }
 }
 
@@ -0,0 +1,158 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/stage_profiler.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace srsran {
+
+stage_profiler::stage_profiler(uint32_t nof_stages) : nof_stages_(std::min(nof_stages, max_stages))
+{
+  calib_time   = std::chrono::steady_clock::now();
+  calib_cycles = read_cycle_counter();
+
+#if defined(__x86_64__) || defined(__i386__)
+  // Spin for a short time to get a first estimate of the counter rate, it is refined at every metrics read
+  std::chrono::steady_clock::time_point t;
+  do {
+    t = std::chrono::steady_clock::now();
+  } while (t - calib_time < std::chrono::milliseconds(1));
+#endif
+  calibrate();
+}
+
+void stage_profiler::calibrate()
+{
+#if defined(__x86_64__) || defined(__i386__)
+  std::chrono::steady_clock::time_point now    = std::chrono::steady_clock::now();
+  uint64_t                              cycles = read_cycle_counter();
+  double elapsed_us = std::chrono::duration_cast<std::chrono::duration<double, std::micro> >(now - calib_time).count();
+  if (cycles > calib_cycles and elapsed_us > 0) {
+    us_per_cycle.store(elapsed_us / (double)(cycles - calib_cycles), std::memory_order_relaxed);
+  }
+  calib_time   = now;
+  calib_cycles = cycles;
+#else
+  // The counter is the steady clock in nanoseconds
+  us_per_cycle.store(1e-3, std::memory_order_relaxed);
+#endif
+}
+
+void stage_profiler::add(uint32_t stage, uint64_t nof_cycles)
+{
+  if (stage >= nof_stages_) {
+    return;
+  }
+  stage_stats_t& s = stats[stage];
+
+  uint32_t bucket = bucket_index((uint64_t)((double)nof_cycles * us_per_cycle.load(std::memory_order_relaxed)));
+
+  s.count.fetch_add(1, std::memory_order_relaxed);
+  s.sum_cycles.fetch_add(nof_cycles, std::memory_order_relaxed);
+  s.histogram[bucket].fetch_add(1, std::memory_order_relaxed);
+  uint64_t max = s.max_cycles.load(std::memory_order_relaxed);
+  while (nof_cycles > max and not s.max_cycles.compare_exchange_weak(max, nof_cycles, std::memory_order_relaxed)) {
+  }
+}
+
+void stage_profiler::commit(period_t& period)
+{
+  for (uint32_t i = 0; i < nof_stages_; i++) {
+    if (period.cycles[i] > 0) {
+      add(i, period.cycles[i]);
+      period.cycles[i] = 0;
+    }
+  }
+}
+
+std::vector<stage_profiler::stage_metrics_t> stage_profiler::get_metrics()
+{
+  calibrate();
+  double rate = us_per_cycle.load(std::memory_order_relaxed);
+
+  std::vector<stage_metrics_t> metrics(nof_stages_);
+  for (uint32_t i = 0; i < nof_stages_; i++) {
+    stage_stats_t&   s = stats[i];
+    stage_metrics_t& m = metrics[i];
+
+    // Samples added while reading are accounted either in this report or in the next one
+    m.count             = s.count.exchange(0, std::memory_order_relaxed);
+    uint64_t sum_cycles = s.sum_cycles.exchange(0, std::memory_order_relaxed);
+    uint64_t max_cycles = s.max_cycles.exchange(0, std::memory_order_relaxed);
+    for (uint32_t b = 0; b < nof_buckets; b++) {
+      m.histogram[b] = s.histogram[b].exchange(0, std::memory_order_relaxed);
+    }
+    if (m.count == 0) {
+      continue;
+    }
+    m.avg_us = (float)((double)sum_cycles * rate / m.count);
+    m.max_us = (float)((double)max_cycles * rate);
+
+    // The 99th percentile falls in the first bucket reaching 99% of the samples
+    uint32_t target = m.count - m.count / 100;
+    uint32_t acc    = 0;
+    for (uint32_t b = 0; b < nof_buckets; b++) {
+      acc += m.histogram[b];
+      if (acc >= target) {
+        m.p99_us = std::min(bucket_upper_us(b), m.max_us);
+        break;
+      }
+    }
+  }
+  return metrics;
+}
+
+uint32_t stage_profiler::bucket_index(uint64_t us)
+{
+  if (us >= (1ULL << max_us_log2)) {
+    return nof_buckets - 1;
+  }
+  if (us < 2 * nof_sub_buckets) {
+    return (uint32_t)us;
+  }
+
+  // The power of two range selects a group of buckets, the bits below the leading one select a bucket of the group
+  uint32_t msb   = 63 - __builtin_clzll(us);
+  uint32_t shift = msb - nof_sub_buckets_log2;
+  return nof_sub_buckets * (shift + 1) + (uint32_t)((us >> shift) & (nof_sub_buckets - 1));
+}
+
+float stage_profiler::bucket_lower_us(uint32_t bucket)
+{
+  bucket = std::min(bucket, nof_buckets - 1);
+  if (bucket < 2 * nof_sub_buckets) {
+    return (float)bucket;
+  }
+  uint32_t shift = bucket / nof_sub_buckets - 1;
+  return (float)((uint64_t)(nof_sub_buckets + bucket % nof_sub_buckets) << shift);
+}
+
+float stage_profiler::bucket_upper_us(uint32_t bucket)
+{
+  if (bucket >= nof_buckets - 1) {
+    return std::numeric_limits<float>::infinity();
+  }
+  return bucket_lower_us(bucket + 1);
+}
+
+} // namespace srsran
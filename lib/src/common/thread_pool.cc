@@ -338,17 +338,26 @@ void task_thread_pool::stop()
   }
 }
 
-void task_thread_pool::push_task(task_t&& task)
+bool task_thread_pool::push_task(task_t&& task)
+{
+  if (try_push_task(std::move(task))) {
+    return true;
+  }
+  logger.error("Cannot push anymore tasks into the queue, maximum size is %u", uint32_t(max_task_num));
+  return false;
+}
+
+bool task_thread_pool::try_push_task(task_t&& task)
 {
   {
     std::lock_guard<std::mutex> lock(queue_mutex);
     if (pending_tasks.full()) {
-      logger.error("Cannot push anymore tasks into the queue, maximum size is %u", uint32_t(max_task_num));
-      return;
+      return false;
     }
     pending_tasks.push(std::move(task));
   }
   cv_empty.notify_one();
+  return true;
 }
 
 uint32_t task_thread_pool::nof_pending_tasks() const
@@ -470,6 +479,93 @@ void task_worker::run_thread()
   logger.info("Task worker %s finished.", thread::get_name().c_str());
 }
 
+serial_task_queue::serial_task_queue(task_thread_pool& pool_) :
+  state(std::make_shared<state_t>(pool_)), alive(std::make_shared<bool>(true))
+{}
+
+serial_task_queue::~serial_task_queue()
+{
+  std::lock_guard<std::mutex> lock(state->mutex);
+  state->stopped = true;
+  state->tasks.clear();
+}
+
+void serial_task_queue::push_task(task_t&& task)
+{
+  {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    state->tasks.push_back(std::move(task));
+    if (state->scheduled) {
+      // The worker running this queue will pick it up
+      return;
+    }
+    state->scheduled = true;
+  }
+  schedule(state);
+}
+
+size_t serial_task_queue::nof_pending_tasks() const
+{
+  std::lock_guard<std::mutex> lock(state->mutex);
+  return state->tasks.size();
+}
+
+void serial_task_queue::schedule(const std::shared_ptr<state_t>& state)
+{
+  // The pool task keeps the state alive, in case the queue is destroyed in the meantime
+  std::shared_ptr<state_t> state_sptr = state;
+  if (state->pool.try_push_task([state_sptr]() { run_tasks(state_sptr); })) {
+    return;
+  }
+
+  // The pool queue is full. Rather than dropping the tasks, they run in order in the calling thread. It happens on
+  // every push while the pool stays full, so it is logged once per run and not as an error
+  uint32_t nof_tasks = 0;
+  while (true) {
+    task_t task;
+    {
+      std::lock_guard<std::mutex> lock(state->mutex);
+      if (state->stopped or state->tasks.empty()) {
+        state->scheduled = false;
+        break;
+      }
+      task = std::move(state->tasks.front());
+      state->tasks.pop_front();
+    }
+    task();
+    nof_tasks++;
+  }
+  srslog::fetch_basic_logger("POOL").info(
+      "Ran %d tasks of a serial task queue in the calling thread, the thread pool is full", nof_tasks);
+}
+
+void serial_task_queue::run_tasks(const std::shared_ptr<state_t>& state)
+{
+  for (uint32_t n = 0; n < max_tasks_per_run; ++n) {
+    task_t task;
+    {
+      std::lock_guard<std::mutex> lock(state->mutex);
+      if (state->stopped or state->tasks.empty()) {
+        state->scheduled = false;
+        return;
+      }
+      task = std::move(state->tasks.front());
+      state->tasks.pop_front();
+    }
+    task();
+  }
+
+  // Yield the worker, the remaining tasks go to the back of the pool queue
+  {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    if (state->stopped or state->tasks.empty()) {
+      state->scheduled = false;
+      return;
+    }
+  }
+  schedule(state);
+}
+
 // Global thread pool for long, low-priority tasks
 task_thread_pool& get_background_workers()
 {
@@ -392,4 +392,16 @@ void pdcp::reset_metrics()
   metrics_tp = std::chrono::high_resolution_clock::now();
 }
 
+size_t pdcp::get_mem_footprint()
+{
+  size_t bytes = sizeof(pdcp);
+  for (auto& entity : pdcp_array) {
+    bytes += entity.second->get_mem_footprint();
+  }
+  for (auto& entity : pdcp_array_mrb) {
+    bytes += entity.second->get_mem_footprint();
+  }
+  return bytes;
+}
+
 } // namespace srsran
@@ -862,6 +862,15 @@ pdcp_bearer_metrics_t pdcp_entity_lte::get_metrics()
   return metrics;
 }
 
+size_t pdcp_entity_lte::get_mem_footprint()
+{
+  size_t bytes = sizeof(pdcp_entity_lte) + rx_counts_info.capacity() * sizeof(uint32_t);
+  if (undelivered_sdus != nullptr) {
+    bytes += undelivered_sdus->get_mem_footprint();
+  }
+  return bytes;
+}
+
 void pdcp_entity_lte::reset_metrics()
 {
   // Only reset metrics that have are snapshots, leave the incremental ones untouched.
@@ -871,12 +880,7 @@ void pdcp_entity_lte::reset_metrics()
 /****************************************************************************
  * Undelivered SDUs queue helpers
  ***************************************************************************/
-undelivered_sdus_queue::undelivered_sdus_queue(srsran::task_sched_handle task_sched)
-{
-  for (auto& e : sdus) {
-    e.discard_timer = task_sched.get_unique_timer();
-  }
-}
+undelivered_sdus_queue::undelivered_sdus_queue(srsran::task_sched_handle task_sched_) : task_sched(task_sched_) {}
 
 bool undelivered_sdus_queue::add_sdu(uint32_t                              sn,
                                      const srsran::unique_byte_buffer_t&   sdu,
@@ -920,6 +924,10 @@ bool undelivered_sdus_queue::add_sdu(uint32_t                              sn,
   sdus[sn].sdu->N_bytes    = sdu->N_bytes;
   memcpy(sdus[sn].sdu->msg, sdu->msg, sdu->N_bytes);
   if (discard_timeout > 0) {
+    // Discard timers are created on first use of the SN, so bearers that carry little traffic keep only a few
+    if (not sdus[sn].discard_timer.is_valid()) {
+      sdus[sn].discard_timer = task_sched.get_unique_timer();
+    }
     sdus[sn].discard_timer.set(discard_timeout, std::move(callback));
     sdus[sn].discard_timer.run();
   }
@@ -962,6 +970,11 @@ size_t undelivered_sdus_queue::nof_discard_timers() const
   });
 }
 
+size_t undelivered_sdus_queue::get_mem_footprint() const
+{
+  return sizeof(undelivered_sdus_queue) + count * sizeof(srsran::byte_buffer_t);
+}
+
 void undelivered_sdus_queue::update_fms()
 {
   if (empty()) {
@@ -324,4 +324,10 @@ void pdcp_entity_nr::reset_metrics()
   metrics = {};
 }
 
+size_t pdcp_entity_nr::get_mem_footprint()
+{
+  return sizeof(pdcp_entity_nr) + reorder_queue.size() * sizeof(srsran::byte_buffer_t) +
+         discard_timers_map.size() * sizeof(timer_handler::unique_timer);
+}
+
 } // namespace srsran
@@ -31,6 +31,7 @@
 #include "srsran/phy/ch_estimation/chest_ul.h"
 #include "srsran/phy/dft/dft_precoding.h"
 #include "srsran/phy/utils/convolution.h"
+#include "srsran/phy/utils/simd.h"
 #include "srsran/phy/utils/vector.h"
 #include "srsran/srsran.h"
 
@@ -84,6 +85,19 @@ int srsran_chest_ul_init(srsran_chest_ul_t* q, uint32_t max_prb)
       goto clean_exit;
     }
 
+    for (int i = 0; i < SRSRAN_MAX_PORTS; i++) {
+      q->mrc_weights[i] = srsran_vec_cf_malloc(MAX_REFS_SF);
+      if (!q->mrc_weights[i]) {
+        perror("malloc");
+        goto clean_exit;
+      }
+    }
+    q->mrc_gain = srsran_vec_cf_malloc(MAX_REFS_SF);
+    if (!q->mrc_gain) {
+      perror("malloc");
+      goto clean_exit;
+    }
+
     if (srsran_interp_linear_vector_init(&q->srsran_interp_linvec, MAX_REFS_SYM)) {
       ERROR("Error initializing vector interpolator");
       goto clean_exit;
@@ -132,6 +146,14 @@ void srsran_chest_ul_free(srsran_chest_ul_t* q)
   if (q->pilot_known_signal) {
     free(q->pilot_known_signal);
   }
+  for (int i = 0; i < SRSRAN_MAX_PORTS; i++) {
+    if (q->mrc_weights[i]) {
+      free(q->mrc_weights[i]);
+    }
+  }
+  if (q->mrc_gain) {
+    free(q->mrc_gain);
+  }
   bzero(q, sizeof(srsran_chest_ul_t));
 }
 
@@ -196,6 +218,40 @@ void srsran_chest_ul_pregen(srsran_chest_ul_t*                 q,
   }
 }
 
+int srsran_chest_ul_pregen_load(srsran_chest_ul_t* q, const uint8_t* dmrs_table)
+{
+  if (srsran_refsignal_dmrs_pusch_pregen_unpack(&q->dmrs_pregen, q->cell.nof_prb, dmrs_table)) {
+    return SRSRAN_ERROR;
+  }
+  q->dmrs_signal_configured = true;
+  return SRSRAN_SUCCESS;
+}
+
+/* Compensates the noise power measured after the smoothing filter */
+static float calibrate_noise_pilots(srsran_chest_ul_t* q, float power)
+{
+  if (q->smooth_filter_len == 3) {
+    // Calibrated for filter length 3
+    float w = q->smooth_filter[0];
+    float a = 7.419 * w * w + 0.1117 * w - 0.005387;
+    return (power / (a * 0.8));
+  } else {
+    return power;
+  }
+}
+
+/* Converts the normalized frequency of the pilot estimates into a time alignment error in micro-seconds */
+static float convert_ta_err_us(float ta_err, uint32_t stride)
+{
+  if (isnormal(ta_err) && stride > 0) {
+    ta_err /= (float)stride;               // Divide by the pilot spacing
+    ta_err /= 15e3f;                       // Convert from normalized frequency to seconds
+    ta_err *= 1e6f;                        // Convert to micro-seconds
+    return roundf(ta_err * 10.0f) / 10.0f; // Round to one tenth of micro-second
+  }
+  return 0.0f;
+}
+
 /* Uses the difference between the averaged and non-averaged pilot estimates */
 static float estimate_noise_pilots(srsran_chest_ul_t* q, cf_t* ce, uint32_t nslots, uint32_t nrefs, uint32_t n_prb[2])
 {
@@ -210,14 +266,7 @@ static float estimate_noise_pilots(srsran_chest_ul_t* q, cf_t* ce, uint32_t nslo
 
   power /= nslots;
 
-  if (q->smooth_filter_len == 3) {
-    // Calibrated for filter length 3
-    float w = q->smooth_filter[0];
-    float a = 7.419 * w * w + 0.1117 * w - 0.005387;
-    return (power / (a * 0.8));
-  } else {
-    return power;
-  }
+  return calibrate_noise_pilots(q, power);
 }
 
 // The interpolator currently only supports same frequency allocation for each subframe
@@ -315,15 +364,7 @@ static void chest_ul_estimate(srsran_chest_ul_t*     q,
   }
 
   // Calculate actual time alignment error in micro-seconds
-  if (isnormal(ta_err) && stride > 0) {
-    ta_err /= (float)stride;                     // Divide by the pilot spacing
-    ta_err /= 15e3f;                             // Convert from normalized frequency to seconds
-    ta_err *= 1e6f;                              // Convert to micro-seconds
-    ta_err     = roundf(ta_err * 10.0f) / 10.0f; // Round to one tenth of micro-second
-    res->ta_us = ta_err;
-  } else {
-    res->ta_us = 0.0f;
-  }
+  res->ta_us = convert_ta_err_us(ta_err, stride);
 
   // Check if intra-subframe frequency hopping is enabled
   if (n_prb[0] != n_prb[1]) {
@@ -403,6 +444,181 @@ int srsran_chest_ul_estimate_pusch(srsran_chest_ul_t*     q,
   return 0;
 }
 
+/* Replaces the averaged estimates h of every antenna by the MRC weights conj(h)/g and writes the combined channel gain
+ * g = sqrt(sum(|h|^2)) of every subcarrier. A power floor keeps the weights of null subcarriers at zero */
+static void mrc_compute_weights(srsran_chest_ul_t* q, uint32_t nof_rx_ant, uint32_t nof_re)
+{
+  uint32_t i = 0;
+
+#if SRSRAN_SIMD_CF_SIZE
+  simd_f_t  _floor = srsran_simd_f_set1(FLT_MIN);
+  simd_cf_t _one   = srsran_simd_cf_set1(1.0f);
+  for (; i + SRSRAN_SIMD_CF_SIZE < nof_re + 1; i += SRSRAN_SIMD_CF_SIZE) {
+    simd_cf_t h[SRSRAN_MAX_PORTS];
+    simd_f_t  power = _floor;
+    for (uint32_t a = 0; a < nof_rx_ant; a++) {
+      h[a]  = srsran_simd_cfi_load(&q->mrc_weights[a][i]);
+      power = srsran_simd_f_add(power, srsran_simd_cf_re(srsran_simd_cf_conjprod(h[a], h[a])));
+    }
+
+    simd_f_t gain = srsran_simd_f_sqrt(power);
+    simd_f_t norm = srsran_simd_f_rcp(gain);
+    for (uint32_t a = 0; a < nof_rx_ant; a++) {
+      srsran_simd_cfi_store(&q->mrc_weights[a][i], srsran_simd_cf_mul(srsran_simd_cf_conj(h[a]), norm));
+    }
+    srsran_simd_cfi_store(&q->mrc_gain[i], srsran_simd_cf_mul(_one, gain));
+  }
+#endif /* SRSRAN_SIMD_CF_SIZE */
+
+  for (; i < nof_re; i++) {
+    float power = FLT_MIN;
+    for (uint32_t a = 0; a < nof_rx_ant; a++) {
+      cf_t h = q->mrc_weights[a][i];
+      power += __real__ h * __real__ h + __imag__ h * __imag__ h;
+    }
+
+    float gain = sqrtf(power);
+    float norm = 1.0f / gain;
+    for (uint32_t a = 0; a < nof_rx_ant; a++) {
+      q->mrc_weights[a][i] = conjf(q->mrc_weights[a][i]) * norm;
+    }
+    q->mrc_gain[i] = gain;
+  }
+}
+
+/* Combines the resource elements of all antennas of one OFDM symbol in a single pass */
+static void mrc_combine_symbol(cf_t*    y[SRSRAN_MAX_PORTS],
+                               cf_t*    w[SRSRAN_MAX_PORTS],
+                               uint32_t nof_rx_ant,
+                               cf_t*    out,
+                               uint32_t nof_re)
+{
+  uint32_t i = 0;
+
+#if SRSRAN_SIMD_CF_SIZE
+  for (; i + SRSRAN_SIMD_CF_SIZE < nof_re + 1; i += SRSRAN_SIMD_CF_SIZE) {
+    simd_cf_t acc = srsran_simd_cf_prod(srsran_simd_cfi_loadu(&y[0][i]), srsran_simd_cfi_loadu(&w[0][i]));
+    for (uint32_t a = 1; a < nof_rx_ant; a++) {
+      simd_cf_t prod = srsran_simd_cf_prod(srsran_simd_cfi_loadu(&y[a][i]), srsran_simd_cfi_loadu(&w[a][i]));
+      acc            = srsran_simd_cf_add(acc, prod);
+    }
+    srsran_simd_cfi_storeu(&out[i], acc);
+  }
+#endif /* SRSRAN_SIMD_CF_SIZE */
+
+  for (; i < nof_re; i++) {
+    cf_t acc = y[0][i] * w[0][i];
+    for (uint32_t a = 1; a < nof_rx_ant; a++) {
+      acc += y[a][i] * w[a][i];
+    }
+    out[i] = acc;
+  }
+}
+
+int srsran_chest_ul_estimate_pusch_mrc(srsran_chest_ul_t*     q,
+                                       srsran_ul_sf_cfg_t*    sf,
+                                       srsran_pusch_cfg_t*    cfg,
+                                       cf_t*                  input[SRSRAN_MAX_PORTS],
+                                       uint32_t               nof_rx_ant,
+                                       cf_t*                  output,
+                                       srsran_chest_ul_res_t* res)
+{
+  if (q == NULL || sf == NULL || cfg == NULL || input == NULL || output == NULL || res == NULL || res->ce == NULL ||
+      nof_rx_ant == 0 || nof_rx_ant > SRSRAN_MAX_PORTS) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  if (!q->dmrs_signal_configured) {
+    ERROR("Error must call srsran_chest_ul_set_cfg() before using the UL estimator");
+    return SRSRAN_ERROR;
+  }
+
+  uint32_t nof_prb = cfg->grant.L_prb;
+
+  if (!srsran_dft_precoding_valid_prb(nof_prb)) {
+    ERROR("Error invalid nof_prb=%d", nof_prb);
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  uint32_t nrefs_sym = nof_prb * SRSRAN_NRE;
+  uint32_t nrefs_sf  = nrefs_sym * SRSRAN_NOF_SLOTS_PER_SF;
+  uint32_t nof_est   = SRSRAN_NOF_SLOTS_PER_SF * nof_rx_ant;
+  cf_t*    dmrs      = q->dmrs_pregen.r[cfg->grant.n_dmrs][sf->tti % SRSRAN_NOF_SF_X_FRAME][nof_prb];
+
+  cf_t  cfo_corr    = 0.0f;
+  float ta_err      = 0.0f;
+  float noise       = 0.0f;
+  float pilot_power = 0.0f;
+  for (uint32_t a = 0; a < nof_rx_ant; a++) {
+    // Least-squares estimates of the antenna
+    srsran_refsignal_dmrs_pusch_get(&q->dmrs_signal, cfg, input[a], q->pilot_recv_signal);
+    srsran_vec_prod_conj_ccc(q->pilot_recv_signal, dmrs, q->pilot_estimates, nrefs_sf);
+    pilot_power += srsran_vec_avg_power_cf(q->pilot_recv_signal, nrefs_sf);
+
+    // CFO and time alignment are measured from the pilots of all antennas
+    cfo_corr += srsran_vec_dot_prod_conj_ccc(&q->pilot_estimates[0], &q->pilot_estimates[nrefs_sym], nrefs_sym);
+    if (cfg->meas_ta_en) {
+      for (uint32_t i = 0; i < SRSRAN_NOF_SLOTS_PER_SF; i++) {
+        ta_err += srsran_vec_estimate_frequency(&q->pilot_estimates[i * nrefs_sym], nrefs_sym);
+      }
+    }
+
+    // Average the estimates of each slot, the noise is measured from the difference with the non-averaged ones
+    if (q->smooth_filter_len > 0) {
+      for (uint32_t i = 0; i < SRSRAN_NOF_SLOTS_PER_SF; i++) {
+        srsran_chest_average_pilots(&q->pilot_estimates[i * nrefs_sym],
+                                    &q->mrc_weights[a][i * nrefs_sym],
+                                    q->smooth_filter,
+                                    nrefs_sym,
+                                    1,
+                                    q->smooth_filter_len);
+        noise += srsran_chest_estimate_noise_pilots(
+            &q->pilot_estimates[i * nrefs_sym], &q->mrc_weights[a][i * nrefs_sym], q->tmp_noise, nrefs_sym);
+      }
+    } else {
+      srsran_vec_cf_copy(q->mrc_weights[a], q->pilot_estimates, nrefs_sf);
+    }
+  }
+
+  res->cfo_hz         = cargf(cfo_corr) / (2.0f * (float)M_PI * 0.0005f);
+  res->ta_us          = convert_ta_err_us(ta_err / (float)nof_est, 1);
+  res->noise_estimate = (q->smooth_filter_len > 0) ? calibrate_noise_pilots(q, noise / (float)nof_est) : 0.0f;
+
+  // The SNR after combining is the sum of the SNR of each antenna
+  if (isnormal(res->noise_estimate)) {
+    res->snr = pilot_power / res->noise_estimate;
+  } else {
+    res->snr = NAN;
+  }
+  res->snr_db             = srsran_convert_power_to_dB(res->snr);
+  res->noise_estimate_dbm = srsran_convert_power_to_dBm(res->noise_estimate);
+
+  // The estimates are constant within each slot, so the weights are computed once for all the symbols of the slot
+  mrc_compute_weights(q, nof_rx_ant, nrefs_sf);
+
+  uint32_t nsymb = SRSRAN_CP_NSYMB(q->cell.cp);
+  for (uint32_t s = 0; s < SRSRAN_NOF_SLOTS_PER_SF; s++) {
+    cf_t* y[SRSRAN_MAX_PORTS] = {NULL};
+    cf_t* w[SRSRAN_MAX_PORTS] = {NULL};
+    for (uint32_t l = s * nsymb; l < (s + 1) * nsymb; l++) {
+      // Skip the DMRS symbol
+      if (l == SRSRAN_REFSIGNAL_UL_L(s, q->cell.cp)) {
+        continue;
+      }
+
+      uint32_t offset = (l * q->cell.nof_prb + cfg->grant.n_prb[s]) * SRSRAN_NRE;
+      for (uint32_t a = 0; a < nof_rx_ant; a++) {
+        y[a] = &input[a][offset];
+        w[a] = &q->mrc_weights[a][s * nrefs_sym];
+      }
+      mrc_combine_symbol(y, w, nof_rx_ant, &output[offset], nrefs_sym);
+      srsran_vec_cf_copy(&res->ce[offset], &q->mrc_gain[s * nrefs_sym], nrefs_sym);
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 static float
 estimate_noise_pilots_pucch(srsran_chest_ul_t* q, cf_t* ce, uint32_t n_rs, uint32_t n_prb[SRSRAN_NOF_SLOTS_PER_SF])
 {
@@ -317,6 +317,73 @@ void srsran_refsignal_dmrs_pusch_pregen_free(srsran_refsignal_ul_t* q, srsran_re
   }
 }
 
+uint32_t srsran_refsignal_dmrs_pusch_pregen_nof_bytes(uint32_t nof_prb)
+{
+  uint32_t nof_re = 0;
+  for (uint32_t n = 1; n <= nof_prb; n++) {
+    if (srsran_dft_precoding_valid_prb(n)) {
+      nof_re += n * 2 * SRSRAN_NRE;
+    }
+  }
+  return SRSRAN_NOF_CSHIFT * SRSRAN_NOF_SF_X_FRAME * nof_re * (uint32_t)sizeof(cf_t);
+}
+
+int srsran_refsignal_dmrs_pusch_pregen_pack(const srsran_refsignal_ul_dmrs_pregen_t* pregen,
+                                            uint32_t                                 nof_prb,
+                                            uint8_t*                                 buffer)
+{
+  if (pregen == NULL || buffer == NULL || nof_prb > pregen->max_prb) {
+    return SRSRAN_ERROR;
+  }
+
+  for (uint32_t sf_idx = 0; sf_idx < SRSRAN_NOF_SF_X_FRAME; sf_idx++) {
+    for (uint32_t cs = 0; cs < SRSRAN_NOF_CSHIFT; cs++) {
+      if (!pregen->r[cs][sf_idx]) {
+        return SRSRAN_ERROR;
+      }
+      for (uint32_t n = 1; n <= nof_prb; n++) {
+        if (srsran_dft_precoding_valid_prb(n)) {
+          if (!pregen->r[cs][sf_idx][n]) {
+            return SRSRAN_ERROR;
+          }
+          uint32_t len = n * 2 * SRSRAN_NRE * (uint32_t)sizeof(cf_t);
+          memcpy(buffer, pregen->r[cs][sf_idx][n], len);
+          buffer += len;
+        }
+      }
+    }
+  }
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_refsignal_dmrs_pusch_pregen_unpack(srsran_refsignal_ul_dmrs_pregen_t* pregen,
+                                              uint32_t                           nof_prb,
+                                              const uint8_t*                     buffer)
+{
+  if (pregen == NULL || buffer == NULL || nof_prb > pregen->max_prb) {
+    return SRSRAN_ERROR;
+  }
+
+  for (uint32_t sf_idx = 0; sf_idx < SRSRAN_NOF_SF_X_FRAME; sf_idx++) {
+    for (uint32_t cs = 0; cs < SRSRAN_NOF_CSHIFT; cs++) {
+      if (!pregen->r[cs][sf_idx]) {
+        return SRSRAN_ERROR;
+      }
+      for (uint32_t n = 1; n <= nof_prb; n++) {
+        if (srsran_dft_precoding_valid_prb(n)) {
+          if (!pregen->r[cs][sf_idx][n]) {
+            return SRSRAN_ERROR;
+          }
+          uint32_t len = n * 2 * SRSRAN_NRE * (uint32_t)sizeof(cf_t);
+          memcpy(pregen->r[cs][sf_idx][n], buffer, len);
+          buffer += len;
+        }
+      }
+    }
+  }
+  return SRSRAN_SUCCESS;
+}
+
 int srsran_refsignal_dmrs_pusch_pregen_put(srsran_refsignal_ul_t*             q,
                                            srsran_ul_sf_cfg_t*                sf_cfg,
                                            srsran_refsignal_ul_dmrs_pregen_t* pregen,
@@ -428,6 +495,21 @@ uint32_t srsran_refsignal_dmrs_pucch_symbol(uint32_t m, srsran_pucch_format_t fo
   return 0;
 }
 
+/* Table 5.5.2.2.1-2: Argument of the orthogonal sequence of the DMRS m for PUCCH formats 1, 1a and 1b. 36.211 */
+float srsran_refsignal_dmrs_pucch_format1_w_arg(uint32_t m, uint32_t n_oc, srsran_cp_t cp)
+{
+  if (SRSRAN_CP_ISNORM(cp)) {
+    if (m < 3 && n_oc < 3) {
+      return w_arg_pucch_format1_cpnorm[n_oc][m];
+    }
+  } else {
+    if (m < 2 && n_oc < 3) {
+      return w_arg_pucch_format1_cpext[n_oc][m];
+    }
+  }
+  return 0.0f;
+}
+
 /* Generates DMRS for PUCCH according to 5.5.2.2 in 36.211 */
 int srsran_refsignal_dmrs_pucch_gen(srsran_refsignal_ul_t* q,
                                     srsran_ul_sf_cfg_t*    sf,
@@ -22,6 +22,7 @@
 #include <complex.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <strings.h>
 #include <unistd.h>
 
@@ -232,6 +233,33 @@ int main(int argc, char** argv)
     printf("cid=%d\n", cid);
   }
 
+  // The DMRS loaded from a packed table match the generated ones
+  uint32_t table_len = srsran_refsignal_dmrs_pusch_pregen_nof_bytes(cell.nof_prb);
+  uint8_t* table     = srsran_vec_u8_malloc(table_len);
+  uint8_t* table2    = srsran_vec_u8_malloc(table_len);
+  if (!table || !table2) {
+    perror("srsran_vec_malloc");
+    goto do_exit;
+  }
+  srsran_chest_ul_t est2;
+  if (srsran_chest_ul_init(&est2, cell.nof_prb) || srsran_chest_ul_set_cell(&est2, cell)) {
+    ERROR("Error initializing equalizer");
+    goto do_exit;
+  }
+  if (srsran_refsignal_dmrs_pusch_pregen_pack(&est.dmrs_pregen, cell.nof_prb, table) ||
+      srsran_chest_ul_pregen_load(&est2, table) ||
+      srsran_refsignal_dmrs_pusch_pregen_pack(&est2.dmrs_pregen, cell.nof_prb, table2)) {
+    ERROR("Error packing DMRS");
+    goto do_exit;
+  }
+  if (memcmp(table, table2, table_len) != 0 || !est2.dmrs_signal_configured) {
+    ERROR("Loaded DMRS do not match");
+    goto do_exit;
+  }
+  srsran_chest_ul_free(&est2);
+  free(table);
+  free(table2);
+
   srsran_chest_ul_free(&est);
 
   if (fmatlab) {
@@ -0,0 +1,296 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/test_common.h"
+#include "srsran/phy/channel/ch_awgn.h"
+#include "srsran/phy/utils/random.h"
+#include "srsran/srsran.h"
+#include <complex.h>
+#include <getopt.h>
+#include <sys/time.h>
+
+// Test parameters, a PRB or antenna number of zero sweeps all the values
+static uint32_t nof_prb         = 0;
+static uint32_t nof_rx_ant      = 0;
+static uint32_t nof_repetitions = 100;
+static float    snr_db          = 30.0f;
+
+static const uint32_t prb_sweep[] = {6, 15, 25, 50, 75, 100};
+
+#define MAX_PRB 100
+#define MAX_RE SRSRAN_SF_LEN_RE(MAX_PRB, SRSRAN_CP_NORM)
+
+static srsran_random_t       random_gen = NULL;
+static srsran_channel_awgn_t awgn       = {};
+
+// Resource grids
+static cf_t*  tx                     = NULL;
+static cf_t*  rx[SRSRAN_MAX_PORTS]    = {};
+static cf_t*  ce[SRSRAN_MAX_PORTS]    = {};
+static cf_t*  mrc                    = NULL;
+static cf_t*  mrc_ce                 = NULL;
+static cf_t*  y_ext[SRSRAN_MAX_PORTS] = {};
+static cf_t*  h_ext[SRSRAN_MAX_PORTS] = {};
+static cf_t*  x_tx                   = NULL;
+static cf_t*  x_ref                  = NULL;
+static cf_t*  x_mrc                  = NULL;
+static float* csi                    = NULL;
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [parsv]\n", prog);
+  printf("\t-p number of PRB, 0 for %d to %d [Default %d]\n", prb_sweep[0], MAX_PRB, nof_prb);
+  printf("\t-a number of receive antennas, 0 for 1 to %d [Default %d]\n", SRSRAN_MAX_PORTS, nof_rx_ant);
+  printf("\t-r number of repetitions [Default %d]\n", nof_repetitions);
+  printf("\t-s Signal to Noise Ratio in dB [Default %.2f]\n", snr_db);
+  printf("\t-v [set srsran_verbose to debug, default none]\n");
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "parsv")) != -1) {
+    switch (opt) {
+      case 'p':
+        nof_prb = SRSRAN_MIN((uint32_t)strtol(argv[optind], NULL, 10), MAX_PRB);
+        break;
+      case 'a':
+        nof_rx_ant = SRSRAN_MIN((uint32_t)strtol(argv[optind], NULL, 10), SRSRAN_MAX_PORTS);
+        break;
+      case 'r':
+        nof_repetitions = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 's':
+        snr_db = strtof(argv[optind], NULL);
+        break;
+      case 'v':
+        increase_srsran_verbose_level();
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+static uint64_t elapsed_us(struct timeval t[3])
+{
+  get_time_interval(t);
+  return t[0].tv_usec + t[0].tv_sec * 1000000UL;
+}
+
+// Copies the PUSCH resource elements of a grid as the PUSCH decoder does
+static uint32_t extract(srsran_cell_t* cell, const cf_t* grid, cf_t* out)
+{
+  uint32_t nof_re = cell->nof_prb * SRSRAN_NRE;
+  uint32_t k      = 0;
+  for (uint32_t l = 0; l < SRSRAN_CP_NSYMB(cell->cp) * SRSRAN_NOF_SLOTS_PER_SF; l++) {
+    if (l != SRSRAN_REFSIGNAL_UL_L(0, cell->cp) && l != SRSRAN_REFSIGNAL_UL_L(1, cell->cp)) {
+      srsran_vec_cf_copy(&out[k], &grid[l * nof_re], nof_re);
+      k += nof_re;
+    }
+  }
+  return k;
+}
+
+static int run_test(uint32_t prb, uint32_t nof_ant)
+{
+  srsran_cell_t cell = {.nof_prb         = prb,
+                        .nof_ports       = 1,
+                        .id              = 1,
+                        .cp              = SRSRAN_CP_NORM,
+                        .phich_resources = SRSRAN_PHICH_R_1,
+                        .phich_length    = SRSRAN_PHICH_NORM};
+
+  srsran_chest_ul_t chest = {};
+  TESTASSERT(srsran_chest_ul_init(&chest, prb) == SRSRAN_SUCCESS);
+  TESTASSERT(srsran_chest_ul_set_cell(&chest, cell) == SRSRAN_SUCCESS);
+
+  srsran_refsignal_dmrs_pusch_cfg_t dmrs_cfg = {};
+  srsran_chest_ul_pregen(&chest, &dmrs_cfg, NULL);
+
+  // Full bandwidth allocation
+  srsran_pusch_cfg_t cfg = {};
+  cfg.grant.L_prb        = prb;
+  cfg.meas_ta_en         = true;
+  srsran_ul_sf_cfg_t ul_sf = {};
+
+  uint32_t nof_re_grid = SRSRAN_NOF_RE(cell);
+  uint64_t t_ref       = 0;
+  uint64_t t_mrc       = 0;
+  float    evm         = 0.0f;
+  float    max_diff    = 0.0f;
+
+  for (uint32_t r = 0; r < nof_repetitions; r++) {
+    ul_sf.tti = r % SRSRAN_NOF_SF_X_FRAME;
+
+    // QPSK data and DMRS
+    for (uint32_t i = 0; i < nof_re_grid; i++) {
+      tx[i] = (srsran_random_bool(random_gen, 0.5f) ? M_SQRT1_2 : -M_SQRT1_2) +
+              (srsran_random_bool(random_gen, 0.5f) ? M_SQRT1_2 : -M_SQRT1_2) * _Complex_I;
+    }
+    srsran_refsignal_dmrs_pusch_put(
+        &chest.dmrs_signal, &cfg, chest.dmrs_pregen.r[cfg.grant.n_dmrs][ul_sf.tti][prb], tx);
+
+    // Frequency selective channel, different for every antenna
+    for (uint32_t a = 0; a < nof_ant; a++) {
+      float gain  = srsran_random_uniform_real_dist(random_gen, 0.5f, 1.5f);
+      float phase = srsran_random_uniform_real_dist(random_gen, -M_PI, M_PI);
+      float delay = srsran_random_uniform_real_dist(random_gen, -0.01f, 0.01f);
+      for (uint32_t l = 0; l < SRSRAN_CP_NSYMB(cell.cp) * SRSRAN_NOF_SLOTS_PER_SF; l++) {
+        for (uint32_t k = 0; k < prb * SRSRAN_NRE; k++) {
+          uint32_t idx = l * prb * SRSRAN_NRE + k;
+          rx[a][idx]   = tx[idx] * gain * cexpf(_Complex_I * (phase + 2.0f * M_PI * delay * k));
+        }
+      }
+      srsran_channel_awgn_run_c(&awgn, rx[a], rx[a], nof_re_grid);
+    }
+    uint32_t nof_re = extract(&cell, tx, x_tx);
+
+    // Estimation of every antenna and combination during the equalization
+    struct timeval        t[3] = {};
+    srsran_chest_ul_res_t res[SRSRAN_MAX_PORTS];
+    float                 noise = 0.0f;
+    gettimeofday(&t[1], NULL);
+    for (uint32_t a = 0; a < nof_ant; a++) {
+      res[a].ce = ce[a];
+      TESTASSERT(srsran_chest_ul_estimate_pusch(&chest, &ul_sf, &cfg, rx[a], &res[a]) == SRSRAN_SUCCESS);
+      noise += res[a].noise_estimate / nof_ant;
+      extract(&cell, rx[a], y_ext[a]);
+      extract(&cell, ce[a], h_ext[a]);
+    }
+    float* csi_cw[SRSRAN_MAX_CODEWORDS] = {csi};
+    srsran_predecoding_single_multi(y_ext, h_ext, x_ref, csi_cw, nof_ant, nof_re, 1.0f, noise);
+    gettimeofday(&t[2], NULL);
+    t_ref += elapsed_us(t);
+
+    // Estimation and combination of all the antennas
+    srsran_chest_ul_res_t mrc_res = {};
+    mrc_res.ce                    = mrc_ce;
+    gettimeofday(&t[1], NULL);
+    TESTASSERT(srsran_chest_ul_estimate_pusch_mrc(&chest, &ul_sf, &cfg, rx, nof_ant, mrc, &mrc_res) ==
+               SRSRAN_SUCCESS);
+    extract(&cell, mrc, y_ext[0]);
+    extract(&cell, mrc_ce, h_ext[0]);
+    srsran_predecoding_single(y_ext[0], h_ext[0], x_mrc, NULL, nof_re, 1.0f, mrc_res.noise_estimate);
+    gettimeofday(&t[2], NULL);
+    t_mrc += elapsed_us(t);
+
+    // Both receivers see the same noise and, with a single antenna, measure the same
+    TESTASSERT(fabsf(mrc_res.noise_estimate - noise) <= 1e-3f * noise);
+    if (nof_ant == 1) {
+      TESTASSERT(fabsf(mrc_res.snr_db - res[0].snr_db) < 0.01f);
+      TESTASSERT(fabsf(mrc_res.cfo_hz - res[0].cfo_hz) < 1.0f);
+      TESTASSERT(fabsf(mrc_res.ta_us - res[0].ta_us) < 0.1f);
+    }
+
+    for (uint32_t i = 0; i < nof_re; i++) {
+      max_diff = SRSRAN_MAX(max_diff, cabsf(x_ref[i] - x_mrc[i]));
+      evm += cabsf(x_mrc[i] - x_tx[i]) / (float)nof_re;
+    }
+  }
+  evm /= (float)nof_repetitions;
+
+  printf("nof_prb=%3d; nof_rx_ant=%d; per antenna %7.1f us; combined %7.1f us; evm=%.3f; max_diff=%.1e\n",
+         prb,
+         nof_ant,
+         (double)t_ref / nof_repetitions,
+         (double)t_mrc / nof_repetitions,
+         evm,
+         max_diff);
+
+  srsran_chest_ul_free(&chest);
+
+  // The combined receiver gives the same symbols as the per antenna one
+  TESTASSERT(max_diff < 1e-2f);
+  TESTASSERT(evm < 0.2f);
+
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  int ret = SRSRAN_ERROR;
+
+  parse_args(argc, argv);
+
+  random_gen = srsran_random_init(0x1234);
+  if (srsran_channel_awgn_init(&awgn, 0x1234)) {
+    ERROR("Error initiating AWGN");
+    goto clean_exit;
+  }
+  srsran_channel_awgn_set_n0(&awgn, -snr_db);
+
+  tx     = srsran_vec_cf_malloc(MAX_RE);
+  mrc    = srsran_vec_cf_malloc(MAX_RE);
+  mrc_ce = srsran_vec_cf_malloc(MAX_RE);
+  x_tx   = srsran_vec_cf_malloc(MAX_RE);
+  x_ref  = srsran_vec_cf_malloc(MAX_RE);
+  x_mrc  = srsran_vec_cf_malloc(MAX_RE);
+  csi    = srsran_vec_f_malloc(MAX_RE);
+  if (!tx || !mrc || !mrc_ce || !x_tx || !x_ref || !x_mrc || !csi) {
+    ERROR("Error allocating buffers");
+    goto clean_exit;
+  }
+  for (uint32_t a = 0; a < SRSRAN_MAX_PORTS; a++) {
+    rx[a]    = srsran_vec_cf_malloc(MAX_RE);
+    ce[a]    = srsran_vec_cf_malloc(MAX_RE);
+    y_ext[a] = srsran_vec_cf_malloc(MAX_RE);
+    h_ext[a] = srsran_vec_cf_malloc(MAX_RE);
+    if (!rx[a] || !ce[a] || !y_ext[a] || !h_ext[a]) {
+      ERROR("Error allocating buffers");
+      goto clean_exit;
+    }
+  }
+
+  uint32_t nof_prb_cases = nof_prb ? 1 : sizeof(prb_sweep) / sizeof(prb_sweep[0]);
+  uint32_t min_rx_ant    = nof_rx_ant ? nof_rx_ant : 1;
+  uint32_t max_rx_ant    = nof_rx_ant ? nof_rx_ant : SRSRAN_MAX_PORTS;
+  for (uint32_t p = 0; p < nof_prb_cases; p++) {
+    for (uint32_t a = min_rx_ant; a <= max_rx_ant; a++) {
+      if (run_test(nof_prb ? nof_prb : prb_sweep[p], a) != SRSRAN_SUCCESS) {
+        goto clean_exit;
+      }
+    }
+  }
+
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  srsran_random_free(random_gen);
+  srsran_channel_awgn_free(&awgn);
+  free(tx);
+  free(mrc);
+  free(mrc_ce);
+  free(x_tx);
+  free(x_ref);
+  free(x_mrc);
+  free(csi);
+  for (uint32_t a = 0; a < SRSRAN_MAX_PORTS; a++) {
+    free(rx[a]);
+    free(ce[a]);
+    free(y_ext[a]);
+    free(h_ext[a]);
+  }
+
+  printf("%s\n", ret == SRSRAN_SUCCESS ? "OK" : "Failed");
+  return ret;
+}
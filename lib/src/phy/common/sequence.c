@@ -23,6 +23,7 @@
 #include "srsran/phy/utils/bit.h"
 #include "srsran/phy/utils/debug.h"
 #include "srsran/phy/utils/vector.h"
+#include "sequence_simd.h"
 
 #ifdef LV_HAVE_SSE
 #include <immintrin.h>
@@ -220,18 +221,119 @@ void srsran_sequence_state_init(srsran_sequence_state_t* s, uint32_t seed)
   s->x2 = sequence_get_x2_init(seed);
 }
 
-#define FLOAT_U32_XOR(DST, SRC, U32_MASK)                                                                              \
-  do {                                                                                                                 \
-    uint32_t temp_u32;                                                                                                 \
-    memcpy(&temp_u32, &(SRC), 4);                                                                                      \
-    temp_u32 ^= (U32_MASK);                                                                                            \
-    memcpy(&(DST), &temp_u32, 4);                                                                                      \
-  } while (false)
+/**
+ * Number of sequence bits generated in a block. It is the least common multiple of SEQUENCE_PAR_BITS and 64, so a block
+ * fills an integer number of 64-bit words which are expanded into int8, int16 or float signs with wide SIMD.
+ */
+#define SEQUENCE_BLOCK_BITS (192U)
+#define SEQUENCE_BLOCK_WORDS (SEQUENCE_BLOCK_BITS / 64U)
+
+/**
+ * Gets the word kernels of the instruction set selected by the vector kernel dispatcher. Blocks replace the 24 bit SSE
+ * loops only when the kernels are AVX2 or AVX512, otherwise they are slower.
+ */
+static inline const srsran_sequence_simd_table_t* sequence_simd(void)
+{
+#ifdef SRSRAN_VEC_ISA_DISPATCH
+  switch (srsran_vec_isa_get()) {
+    case SRSRAN_VEC_ISA_AVX2:
+      return &srsran_sequence_simd_table_avx2;
+    case SRSRAN_VEC_ISA_AVX512:
+      return &srsran_sequence_simd_table_avx512;
+    default:
+      break;
+  }
+#endif /* SRSRAN_VEC_ISA_DISPATCH */
+  return &srsran_sequence_simd_table_native;
+}
+
+/**
+ * Generates SEQUENCE_BLOCK_BITS sequence bits packed in 64-bit words, starting from the LSB of the first word
+ * @param s Sequence state, it is advanced by SEQUENCE_BLOCK_BITS
+ * @param words Destination of SEQUENCE_BLOCK_WORDS words
+ */
+static inline void sequence_gen_block(srsran_sequence_state_t* s, uint64_t* words)
+{
+  for (uint32_t k = 0; k < SEQUENCE_BLOCK_WORDS; k++) {
+    words[k] = 0;
+  }
+
+  for (uint32_t n = 0; n < SEQUENCE_BLOCK_BITS; n += SEQUENCE_PAR_BITS) {
+    uint64_t c   = (uint64_t)((s->x1 ^ s->x2) & SEQUENCE_MASK);
+    uint32_t w   = n / 64U;
+    uint32_t off = n % 64U;
+
+    // Insert the parallel bits, they may straddle two words
+    words[w] |= c << off;
+    if (off + SEQUENCE_PAR_BITS > 64U) {
+      words[w + 1] |= c >> (64U - off);
+    }
+
+    // Step sequences
+    s->x1 = sequence_gen_LTE_pr_memless_step_par_x1(s->x1);
+    s->x2 = sequence_gen_LTE_pr_memless_step_par_x2(s->x2);
+  }
+}
+
+/**
+ * Reverses the bit order within each byte, so the sequence bits are MSB first as in packed bits
+ */
+static inline uint64_t sequence_word_reverse_bytes(uint64_t w)
+{
+  w = ((w >> 1U) & 0x5555555555555555UL) | ((w & 0x5555555555555555UL) << 1U);
+  w = ((w >> 2U) & 0x3333333333333333UL) | ((w & 0x3333333333333333UL) << 2U);
+  w = ((w >> 4U) & 0x0f0f0f0f0f0f0f0fUL) | ((w & 0x0f0f0f0f0f0f0f0fUL) << 4U);
+  return w;
+}
+
+/**
+ * XORs 64 sequence bits with 8 bytes of packed bits
+ */
+static inline void sequence_word_apply_packed(uint64_t w, const uint8_t* in, uint8_t* out)
+{
+  uint64_t v;
+  memcpy(&v, in, sizeof(uint64_t));
+  v ^= sequence_word_reverse_bytes(w);
+  memcpy(out, &v, sizeof(uint64_t));
+}
+
+static void sequence_words_apply_packed(const uint64_t* words, const uint8_t* in, uint8_t* out, uint32_t length)
+{
+  uint32_t i = 0;
+  for (; i + 64 <= length; i += 64) {
+    sequence_word_apply_packed(words[i / 64], in + i / 8, out + i / 8);
+  }
+  if (i == length) {
+    return;
+  }
+
+  // Process spare bytes
+  uint64_t w = sequence_word_reverse_bytes(words[i / 64]);
+  for (; i + 8 <= length; i += 8) {
+    out[i / 8] = in[i / 8] ^ (uint8_t)(w & 0xffU);
+    w          = w >> 8U;
+  }
+
+  // Process spare bits
+  uint32_t rem8 = length % 8;
+  if (rem8 != 0) {
+    out[i / 8] = in[i / 8] ^ (uint8_t)(w & (0xffU << (8U - rem8)));
+  }
+}
 
 void srsran_sequence_state_gen_f(srsran_sequence_state_t* s, float value, float* out, uint32_t length)
 {
   uint32_t i = 0;
 
+  const srsran_sequence_simd_table_t* simd = sequence_simd();
+  if (simd->wide) {
+    for (; i + SEQUENCE_BLOCK_BITS <= length; i += SEQUENCE_BLOCK_BITS) {
+      uint64_t words[SEQUENCE_BLOCK_WORDS];
+      sequence_gen_block(s, words);
+      simd->gen_f(words, value, out + i, SEQUENCE_BLOCK_BITS);
+    }
+  }
+
   if (length >= SEQUENCE_PAR_BITS) {
     for (; i < length - (SEQUENCE_PAR_BITS - 1); i += SEQUENCE_PAR_BITS) {
       uint32_t c = (uint32_t)(s->x1 ^ s->x2);
@@ -284,6 +386,15 @@ void srsran_sequence_state_apply_f(srsran_sequence_state_t* s, const float* in,
 {
   uint32_t i = 0;
 
+  const srsran_sequence_simd_table_t* simd = sequence_simd();
+  if (simd->wide) {
+    for (; i + SEQUENCE_BLOCK_BITS <= length; i += SEQUENCE_BLOCK_BITS) {
+      uint64_t words[SEQUENCE_BLOCK_WORDS];
+      sequence_gen_block(s, words);
+      simd->apply_f(words, in + i, out + i, SEQUENCE_BLOCK_BITS);
+    }
+  }
+
   if (length >= SEQUENCE_PAR_BITS) {
     for (; i < length - (SEQUENCE_PAR_BITS - 1); i += SEQUENCE_PAR_BITS) {
       uint32_t c = (uint32_t)(s->x1 ^ s->x2);
@@ -506,12 +617,24 @@ void srsran_sequence_apply_f(const float* in, float* out, uint32_t length, uint3
 
 void srsran_sequence_apply_s(const int16_t* in, int16_t* out, uint32_t length, uint32_t seed)
 {
-  const int16_t s[2] = {+1, -1};
-  uint32_t      x1   = sequence_x1_init;           // X1 initial state is fix
-  uint32_t      x2   = sequence_get_x2_init(seed); // loads x2 initial state
+  const int16_t           s[2]  = {+1, -1};
+  srsran_sequence_state_t state = {};
+  srsran_sequence_state_init(&state, seed);
 
   uint32_t i = 0;
 
+  const srsran_sequence_simd_table_t* simd = sequence_simd();
+  if (simd->wide) {
+    for (; i + SEQUENCE_BLOCK_BITS <= length; i += SEQUENCE_BLOCK_BITS) {
+      uint64_t words[SEQUENCE_BLOCK_WORDS];
+      sequence_gen_block(&state, words);
+      simd->apply_s(words, in + i, out + i, SEQUENCE_BLOCK_BITS);
+    }
+  }
+
+  uint32_t x1 = state.x1;
+  uint32_t x2 = state.x2;
+
   if (length >= SEQUENCE_PAR_BITS) {
     for (; i < length - (SEQUENCE_PAR_BITS - 1); i += SEQUENCE_PAR_BITS) {
       uint32_t c = (uint32_t)(x1 ^ x2);
@@ -564,6 +687,15 @@ void srsran_sequence_state_apply_c(srsran_sequence_state_t* s, const int8_t* in,
 {
   uint32_t i = 0;
 
+  const srsran_sequence_simd_table_t* simd = sequence_simd();
+  if (simd->wide) {
+    for (; i + SEQUENCE_BLOCK_BITS <= length; i += SEQUENCE_BLOCK_BITS) {
+      uint64_t words[SEQUENCE_BLOCK_WORDS];
+      sequence_gen_block(s, words);
+      simd->apply_c(words, in + i, out + i, SEQUENCE_BLOCK_BITS);
+    }
+  }
+
   if (length >= SEQUENCE_PAR_BITS) {
     for (; i < length - (SEQUENCE_PAR_BITS - 1); i += SEQUENCE_PAR_BITS) {
       uint32_t c = (uint32_t)(s->x1 ^ s->x2);
@@ -628,6 +760,15 @@ void srsran_sequence_state_apply_bit(srsran_sequence_state_t* s, const uint8_t*
 {
   uint32_t i = 0;
 
+  const srsran_sequence_simd_table_t* simd = sequence_simd();
+  if (simd->wide) {
+    for (; i + SEQUENCE_BLOCK_BITS <= length; i += SEQUENCE_BLOCK_BITS) {
+      uint64_t words[SEQUENCE_BLOCK_WORDS];
+      sequence_gen_block(s, words);
+      simd->apply_bit(words, in + i, out + i, SEQUENCE_BLOCK_BITS);
+    }
+  }
+
   if (length >= SEQUENCE_PAR_BITS) {
     for (; i < length - (SEQUENCE_PAR_BITS - 1); i += SEQUENCE_PAR_BITS) {
       uint32_t c = (uint32_t)(s->x1 ^ s->x2);
@@ -725,6 +866,17 @@ void srsran_sequence_apply_packed(const uint8_t* in, uint8_t* out, uint32_t leng
   };
 
   uint32_t i = 0;
+
+  // Whole blocks are XORed a word at a time
+  srsran_sequence_state_t state = {x1, x2};
+  for (; i + SEQUENCE_BLOCK_BITS / 8 <= length / 8; i += SEQUENCE_BLOCK_BITS / 8) {
+    uint64_t words[SEQUENCE_BLOCK_WORDS];
+    sequence_gen_block(&state, words);
+    sequence_words_apply_packed(words, in + i, out + i, SEQUENCE_BLOCK_BITS);
+  }
+  x1 = state.x1;
+  x2 = state.x2;
+
 #if SEQUENCE_PAR_BITS % 8 != 0
   uint64_t buffer = 0;
   uint32_t count  = 0;
@@ -797,3 +949,274 @@ void srsran_sequence_apply_packed(const uint8_t* in, uint8_t* out, uint32_t leng
   }
 #endif // SEQUENCE_PAR_BITS % 8 == 0
 }
+
+int srsran_sequence_cache_init(srsran_sequence_cache_t* q, uint32_t nof_users, uint32_t nof_idx, uint32_t max_len)
+{
+  if (q == NULL || nof_users == 0 || nof_idx == 0) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  bzero(q, sizeof(srsran_sequence_cache_t));
+
+  // Sequences are stored in words, only allocated when the entry is first used
+  q->entries = calloc(nof_users * nof_idx, sizeof(srsran_sequence_cache_entry_t));
+  if (q->entries == NULL) {
+    ERROR("Error allocating sequence cache");
+    return SRSRAN_ERROR;
+  }
+  q->max_entries = nof_users * nof_idx;
+  q->nof_entries = q->max_entries;
+  q->nof_idx     = nof_idx;
+  q->max_len     = max_len;
+
+  return SRSRAN_SUCCESS;
+}
+
+static void sequence_cache_entry_free(srsran_sequence_cache_entry_t* entry)
+{
+  if (entry->words) {
+    free(entry->words);
+  }
+  bzero(entry, sizeof(srsran_sequence_cache_entry_t));
+}
+
+void srsran_sequence_cache_free(srsran_sequence_cache_t* q)
+{
+  if (q == NULL) {
+    return;
+  }
+
+  if (q->entries) {
+    for (uint32_t i = 0; i < q->max_entries; i++) {
+      sequence_cache_entry_free(&q->entries[i]);
+    }
+    free(q->entries);
+  }
+  bzero(q, sizeof(srsran_sequence_cache_t));
+}
+
+void srsran_sequence_cache_reset(srsran_sequence_cache_t* q)
+{
+  if (q == NULL || q->entries == NULL) {
+    return;
+  }
+
+  for (uint32_t i = 0; i < q->max_entries; i++) {
+    q->entries[i].len = 0;
+  }
+}
+
+void srsran_sequence_cache_set_nof_users(srsran_sequence_cache_t* q, uint32_t nof_users)
+{
+  if (q == NULL || q->entries == NULL) {
+    return;
+  }
+
+  uint32_t nof_entries = SRSRAN_MIN(SRSRAN_MAX(nof_users, 1) * q->nof_idx, q->max_entries);
+  if (nof_entries >= q->nof_entries) {
+    q->nof_entries = nof_entries;
+    return;
+  }
+
+  // Free the least recently used sequences until the others fit in the new number of entries
+  uint32_t nof_used = 0;
+  for (uint32_t i = 0; i < q->nof_entries; i++) {
+    nof_used += (q->entries[i].len > 0) ? 1 : 0;
+  }
+  for (; nof_used > nof_entries; nof_used--) {
+    srsran_sequence_cache_entry_t* oldest = NULL;
+    for (uint32_t i = 0; i < q->nof_entries; i++) {
+      if (q->entries[i].len > 0 && (oldest == NULL || q->entries[i].last_use < oldest->last_use)) {
+        oldest = &q->entries[i];
+      }
+    }
+    sequence_cache_entry_free(oldest);
+  }
+
+  // Move the sequences beyond the new number of entries to the empty ones
+  uint32_t i = 0;
+  for (uint32_t j = nof_entries; j < q->nof_entries; j++) {
+    if (q->entries[j].len > 0) {
+      while (q->entries[i].len > 0) {
+        i++;
+      }
+      sequence_cache_entry_free(&q->entries[i]);
+      q->entries[i] = q->entries[j];
+      bzero(&q->entries[j], sizeof(srsran_sequence_cache_entry_t));
+    } else {
+      sequence_cache_entry_free(&q->entries[j]);
+    }
+  }
+  q->nof_entries = nof_entries;
+}
+
+void srsran_sequence_cache_release(srsran_sequence_cache_t* q, uint16_t rnti)
+{
+  if (q == NULL || q->entries == NULL) {
+    return;
+  }
+
+  for (uint32_t i = 0; i < q->nof_entries; i++) {
+    if (q->entries[i].len > 0 && q->entries[i].rnti == rnti) {
+      sequence_cache_entry_free(&q->entries[i]);
+    }
+  }
+}
+
+/**
+ * Finds the entry of the RNTI and index. If there is none, the first empty entry or else the least recently used one is
+ * taken over.
+ */
+static srsran_sequence_cache_entry_t* sequence_cache_find(srsran_sequence_cache_t* q, uint16_t rnti, uint32_t idx)
+{
+  srsran_sequence_cache_entry_t* victim = NULL;
+  for (uint32_t i = 0; i < q->nof_entries; i++) {
+    srsran_sequence_cache_entry_t* entry = &q->entries[i];
+    if (entry->len == 0) {
+      if (victim == NULL || victim->len > 0) {
+        victim = entry;
+      }
+    } else if (entry->rnti == rnti && entry->idx == idx) {
+      return entry;
+    } else if (victim == NULL || (victim->len > 0 && entry->last_use < victim->last_use)) {
+      victim = entry;
+    }
+  }
+
+  victim->rnti = rnti;
+  victim->idx  = idx;
+  victim->len  = 0;
+  return victim;
+}
+
+/**
+ * Gets the packed sequence of the given seed with at least the given length from the entry of the RNTI and index,
+ * generating or extending it if necessary
+ * @return The sequence words, NULL if the sequence cannot be cached
+ */
+static const uint64_t*
+sequence_cache_get(srsran_sequence_cache_t* q, uint32_t length, uint16_t rnti, uint32_t idx, uint32_t seed)
+{
+  if (q == NULL || q->entries == NULL || length > q->max_len) {
+    return NULL;
+  }
+
+  srsran_sequence_cache_entry_t* entry = sequence_cache_find(q, rnti, idx);
+  entry->last_use                      = ++q->nof_uses;
+
+  // Another seed takes over the entry
+  if (entry->len == 0 || entry->seed != seed) {
+    entry->seed = seed;
+    entry->len  = 0;
+    srsran_sequence_state_init(&entry->state, seed);
+  }
+
+  // Grow the words up to the requested length, keeping the generated blocks
+  if (length > entry->cap) {
+    uint32_t  nof_blocks = SRSRAN_CEIL(length, SEQUENCE_BLOCK_BITS);
+    uint64_t* words      = SRSRAN_MEM_ALLOC(uint64_t, nof_blocks * SEQUENCE_BLOCK_WORDS);
+    if (words == NULL) {
+      entry->len = 0;
+      return NULL;
+    }
+    if (entry->words != NULL) {
+      memcpy(words, entry->words, sizeof(uint64_t) * (entry->len / 64));
+      free(entry->words);
+    }
+    entry->words = words;
+    entry->cap   = nof_blocks * SEQUENCE_BLOCK_BITS;
+  }
+
+  // Generate the missing blocks
+  while (entry->len < length) {
+    sequence_gen_block(&entry->state, entry->words + entry->len / 64);
+    entry->len += SEQUENCE_BLOCK_BITS;
+  }
+
+  return entry->words;
+}
+
+void srsran_sequence_cache_apply_f(srsran_sequence_cache_t* q,
+                                   const float*             in,
+                                   float*                   out,
+                                   uint32_t                 length,
+                                   uint16_t                 rnti,
+                                   uint32_t                 idx,
+                                   uint32_t                 seed)
+{
+  const uint64_t* words = sequence_cache_get(q, length, rnti, idx, seed);
+  if (words == NULL) {
+    srsran_sequence_apply_f(in, out, length, seed);
+    return;
+  }
+
+  sequence_simd()->apply_f(words, in, out, length);
+}
+
+void srsran_sequence_cache_apply_s(srsran_sequence_cache_t* q,
+                                   const int16_t*           in,
+                                   int16_t*                 out,
+                                   uint32_t                 length,
+                                   uint16_t                 rnti,
+                                   uint32_t                 idx,
+                                   uint32_t                 seed)
+{
+  const uint64_t* words = sequence_cache_get(q, length, rnti, idx, seed);
+  if (words == NULL) {
+    srsran_sequence_apply_s(in, out, length, seed);
+    return;
+  }
+
+  sequence_simd()->apply_s(words, in, out, length);
+}
+
+void srsran_sequence_cache_apply_c(srsran_sequence_cache_t* q,
+                                   const int8_t*            in,
+                                   int8_t*                  out,
+                                   uint32_t                 length,
+                                   uint16_t                 rnti,
+                                   uint32_t                 idx,
+                                   uint32_t                 seed)
+{
+  const uint64_t* words = sequence_cache_get(q, length, rnti, idx, seed);
+  if (words == NULL) {
+    srsran_sequence_apply_c(in, out, length, seed);
+    return;
+  }
+
+  sequence_simd()->apply_c(words, in, out, length);
+}
+
+void srsran_sequence_cache_apply_packed(srsran_sequence_cache_t* q,
+                                        const uint8_t*           in,
+                                        uint8_t*                 out,
+                                        uint32_t                 length,
+                                        uint16_t                 rnti,
+                                        uint32_t                 idx,
+                                        uint32_t                 seed)
+{
+  const uint64_t* words = sequence_cache_get(q, length, rnti, idx, seed);
+  if (words == NULL) {
+    srsran_sequence_apply_packed(in, out, length, seed);
+    return;
+  }
+
+  sequence_words_apply_packed(words, in, out, length);
+}
+
+void srsran_sequence_cache_apply_bit(srsran_sequence_cache_t* q,
+                                     const uint8_t*           in,
+                                     uint8_t*                 out,
+                                     uint32_t                 length,
+                                     uint16_t                 rnti,
+                                     uint32_t                 idx,
+                                     uint32_t                 seed)
+{
+  const uint64_t* words = sequence_cache_get(q, length, rnti, idx, seed);
+  if (words == NULL) {
+    srsran_sequence_apply_bit(in, out, length, seed);
+    return;
+  }
+
+  sequence_simd()->apply_bit(words, in, out, length);
+}
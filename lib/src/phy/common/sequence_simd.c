@@ -0,0 +1,318 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ *  File:         sequence_simd.c
+ *  Description:  Kernels applying packed sequence words. Built with the library
+ *                flags they form the native table. With SRSRAN_SEQUENCE_BUILD_AVX2
+ *                or SRSRAN_SEQUENCE_BUILD_AVX512 they are built for that ISA
+ *                instead, the build system compiles this file once per ISA with
+ *                the matching compiler flags.
+ *****************************************************************************/
+
+#if defined(SRSRAN_SEQUENCE_BUILD_AVX2) || defined(SRSRAN_SEQUENCE_BUILD_AVX512)
+/* The SIMD selection of the library flags is replaced by the one of this build */
+#undef LV_HAVE_SSE
+#undef LV_HAVE_AVX
+#undef LV_HAVE_AVX2
+#undef LV_HAVE_FMA
+#undef LV_HAVE_AVX512
+#define LV_HAVE_SSE
+#define LV_HAVE_AVX
+#define LV_HAVE_AVX2
+#define LV_HAVE_FMA
+#ifdef SRSRAN_SEQUENCE_BUILD_AVX512
+#define LV_HAVE_AVX512
+#define SEQUENCE_SIMD_TABLE srsran_sequence_simd_table_avx512
+#else
+#define SEQUENCE_SIMD_TABLE srsran_sequence_simd_table_avx2
+#endif
+#define SEQUENCE_SIMD_WIDE true
+#else
+#define SEQUENCE_SIMD_TABLE srsran_sequence_simd_table_native
+#if defined(LV_HAVE_AVX2) || defined(LV_HAVE_AVX512)
+#define SEQUENCE_SIMD_WIDE true
+#else
+#define SEQUENCE_SIMD_WIDE false
+#endif
+#endif
+
+#include "sequence_simd.h"
+
+#ifdef LV_HAVE_SSE
+#include <immintrin.h>
+#endif /* LV_HAVE_SSE */
+
+#ifdef LV_HAVE_SSE
+/**
+ * Expands 16 sequence bits into a byte mask, 0xff where the bit is set
+ */
+static inline __m128i sequence_mask_epi8_sse(uint32_t c)
+{
+  const __m128i bits  = _mm_set1_epi64x(0x8040201008040201);
+  const __m128i index = _mm_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1);
+  __m128i       mask  = _mm_shuffle_epi8(_mm_set1_epi32((int)c), index);
+  return _mm_cmpeq_epi8(_mm_and_si128(mask, bits), bits);
+}
+#endif // LV_HAVE_SSE
+
+#ifdef LV_HAVE_AVX2
+/**
+ * Expands 32 sequence bits into a byte mask, 0xff where the bit is set
+ */
+static inline __m256i sequence_mask_epi8_avx2(uint32_t c)
+{
+  const __m256i bits  = _mm256_set1_epi64x(0x8040201008040201);
+  const __m256i index = _mm256_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, //
+                                         2, 2, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3);
+  __m256i       mask  = _mm256_shuffle_epi8(_mm256_set1_epi32((int)c), index);
+  return _mm256_cmpeq_epi8(_mm256_and_si256(mask, bits), bits);
+}
+
+/**
+ * Expands 16 sequence bits into a 16-bit mask, 0xffff where the bit is set
+ */
+static inline __m256i sequence_mask_epi16_avx2(uint32_t c)
+{
+  const __m256i bits = _mm256_setr_epi16(0x0001,
+                                         0x0002,
+                                         0x0004,
+                                         0x0008,
+                                         0x0010,
+                                         0x0020,
+                                         0x0040,
+                                         0x0080,
+                                         0x0100,
+                                         0x0200,
+                                         0x0400,
+                                         0x0800,
+                                         0x1000,
+                                         0x2000,
+                                         0x4000,
+                                         (int16_t)0x8000);
+  __m256i       mask = _mm256_set1_epi16((int16_t)(c & 0xffffU));
+  return _mm256_cmpeq_epi16(_mm256_and_si256(mask, bits), bits);
+}
+
+/**
+ * Expands 8 sequence bits into a float sign mask, -0.0 where the bit is set
+ */
+static inline __m256i sequence_mask_sign_avx2(uint32_t c)
+{
+  const __m256i bits = _mm256_setr_epi32(0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80);
+  __m256i       mask = _mm256_set1_epi32((int)(c & 0xffU));
+  return _mm256_slli_epi32(_mm256_cmpeq_epi32(_mm256_and_si256(mask, bits), bits), 31);
+}
+#endif // LV_HAVE_AVX2
+
+/**
+ * Applies 64 sequence bits to int8 values, negating the values where the sequence bit is set
+ */
+static inline void sequence_word_apply_c(uint64_t w, const int8_t* in, int8_t* out)
+{
+#if defined(LV_HAVE_AVX512)
+  __m512i v = _mm512_loadu_si512(in);
+  _mm512_storeu_si512(out, _mm512_mask_sub_epi8(v, (__mmask64)w, _mm512_setzero_si512(), v));
+#elif defined(LV_HAVE_AVX2)
+  for (uint32_t j = 0; j < 64; j += 32) {
+    __m256i m = sequence_mask_epi8_avx2((uint32_t)(w >> j));
+    __m256i v = _mm256_loadu_si256((__m256i*)(in + j));
+    _mm256_storeu_si256((__m256i*)(out + j), _mm256_sub_epi8(_mm256_xor_si256(v, m), m));
+  }
+#elif defined(LV_HAVE_SSE)
+  for (uint32_t j = 0; j < 64; j += 16) {
+    __m128i m = sequence_mask_epi8_sse((uint32_t)(w >> j));
+    __m128i v = _mm_loadu_si128((__m128i*)(in + j));
+    _mm_storeu_si128((__m128i*)(out + j), _mm_sub_epi8(_mm_xor_si128(v, m), m));
+  }
+#else
+  for (uint32_t j = 0; j < 64; j++) {
+    out[j] = in[j] * (((w >> j) & 1U) ? -1 : +1);
+  }
+#endif
+}
+
+/**
+ * Applies 64 sequence bits to int16 values, negating the values where the sequence bit is set
+ */
+static inline void sequence_word_apply_s(uint64_t w, const int16_t* in, int16_t* out)
+{
+#if defined(LV_HAVE_AVX512)
+  for (uint32_t j = 0; j < 64; j += 32) {
+    __m512i v = _mm512_loadu_si512(in + j);
+    _mm512_storeu_si512(out + j, _mm512_mask_sub_epi16(v, (__mmask32)(w >> j), _mm512_setzero_si512(), v));
+  }
+#elif defined(LV_HAVE_AVX2)
+  for (uint32_t j = 0; j < 64; j += 16) {
+    __m256i m = sequence_mask_epi16_avx2((uint32_t)(w >> j));
+    __m256i v = _mm256_loadu_si256((__m256i*)(in + j));
+    _mm256_storeu_si256((__m256i*)(out + j), _mm256_sub_epi16(_mm256_xor_si256(v, m), m));
+  }
+#elif defined(LV_HAVE_SSE)
+  const __m128i bits = _mm_setr_epi16(0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80);
+  for (uint32_t j = 0; j < 64; j += 8) {
+    __m128i m = _mm_set1_epi16((int16_t)((w >> j) & 0xffU));
+    m         = _mm_cmpeq_epi16(_mm_and_si128(m, bits), bits);
+    __m128i v = _mm_loadu_si128((__m128i*)(in + j));
+    _mm_storeu_si128((__m128i*)(out + j), _mm_sub_epi16(_mm_xor_si128(v, m), m));
+  }
+#else
+  for (uint32_t j = 0; j < 64; j++) {
+    out[j] = in[j] * (((w >> j) & 1U) ? -1 : +1);
+  }
+#endif
+}
+
+/**
+ * Applies 64 sequence bits to float values, flipping the sign where the sequence bit is set
+ */
+static inline void sequence_word_apply_f(uint64_t w, const float* in, float* out)
+{
+#if defined(LV_HAVE_AVX512)
+  const __m512i sign = _mm512_set1_epi32((int)0x80000000);
+  for (uint32_t j = 0; j < 64; j += 16) {
+    __m512i v = _mm512_castps_si512(_mm512_loadu_ps(in + j));
+    _mm512_storeu_ps(out + j, _mm512_castsi512_ps(_mm512_mask_xor_epi32(v, (__mmask16)(w >> j), v, sign)));
+  }
+#elif defined(LV_HAVE_AVX2)
+  for (uint32_t j = 0; j < 64; j += 8) {
+    __m256 m = _mm256_castsi256_ps(sequence_mask_sign_avx2((uint32_t)(w >> j)));
+    _mm256_storeu_ps(out + j, _mm256_xor_ps(_mm256_loadu_ps(in + j), m));
+  }
+#else
+  for (uint32_t j = 0; j < 64; j++) {
+    FLOAT_U32_XOR(out[j], in[j], (uint32_t)((w >> j) & 1U) << 31U);
+  }
+#endif
+}
+
+/**
+ * Writes the given value with the sign flipped where the sequence bit is set, for 64 sequence bits
+ */
+static inline void sequence_word_gen_f(uint64_t w, float value, float* out)
+{
+#if defined(LV_HAVE_AVX512)
+  const __m512i sign = _mm512_set1_epi32((int)0x80000000);
+  const __m512i v    = _mm512_castps_si512(_mm512_set1_ps(value));
+  for (uint32_t j = 0; j < 64; j += 16) {
+    _mm512_storeu_ps(out + j, _mm512_castsi512_ps(_mm512_mask_xor_epi32(v, (__mmask16)(w >> j), v, sign)));
+  }
+#elif defined(LV_HAVE_AVX2)
+  const __m256 v = _mm256_set1_ps(value);
+  for (uint32_t j = 0; j < 64; j += 8) {
+    __m256 m = _mm256_castsi256_ps(sequence_mask_sign_avx2((uint32_t)(w >> j)));
+    _mm256_storeu_ps(out + j, _mm256_xor_ps(v, m));
+  }
+#else
+  for (uint32_t j = 0; j < 64; j++) {
+    FLOAT_U32_XOR(out[j], value, (uint32_t)((w >> j) & 1U) << 31U);
+  }
+#endif
+}
+
+/**
+ * XORs 64 sequence bits with unpacked bits
+ */
+static inline void sequence_word_apply_bit(uint64_t w, const uint8_t* in, uint8_t* out)
+{
+#if defined(LV_HAVE_AVX512)
+  __m512i v = _mm512_loadu_si512(in);
+  _mm512_storeu_si512(out, _mm512_xor_si512(v, _mm512_maskz_set1_epi8((__mmask64)w, 1)));
+#elif defined(LV_HAVE_AVX2)
+  for (uint32_t j = 0; j < 64; j += 32) {
+    __m256i m = _mm256_and_si256(sequence_mask_epi8_avx2((uint32_t)(w >> j)), _mm256_set1_epi8(1));
+    __m256i v = _mm256_loadu_si256((__m256i*)(in + j));
+    _mm256_storeu_si256((__m256i*)(out + j), _mm256_xor_si256(v, m));
+  }
+#elif defined(LV_HAVE_SSE)
+  for (uint32_t j = 0; j < 64; j += 16) {
+    __m128i m = _mm_and_si128(sequence_mask_epi8_sse((uint32_t)(w >> j)), _mm_set1_epi8(1));
+    __m128i v = _mm_loadu_si128((__m128i*)(in + j));
+    _mm_storeu_si128((__m128i*)(out + j), _mm_xor_si128(v, m));
+  }
+#else
+  for (uint32_t j = 0; j < 64; j++) {
+    out[j] = in[j] ^ (uint8_t)((w >> j) & 1U);
+  }
+#endif
+}
+
+static void sequence_words_apply_c(const uint64_t* words, const int8_t* in, int8_t* out, uint32_t length)
+{
+  uint32_t i = 0;
+  for (; i + 64 <= length; i += 64) {
+    sequence_word_apply_c(words[i / 64], in + i, out + i);
+  }
+  for (; i < length; i++) {
+    out[i] = in[i] * (((words[i / 64] >> (i % 64)) & 1U) ? -1 : +1);
+  }
+}
+
+static void sequence_words_apply_s(const uint64_t* words, const int16_t* in, int16_t* out, uint32_t length)
+{
+  uint32_t i = 0;
+  for (; i + 64 <= length; i += 64) {
+    sequence_word_apply_s(words[i / 64], in + i, out + i);
+  }
+  for (; i < length; i++) {
+    out[i] = in[i] * (((words[i / 64] >> (i % 64)) & 1U) ? -1 : +1);
+  }
+}
+
+static void sequence_words_apply_f(const uint64_t* words, const float* in, float* out, uint32_t length)
+{
+  uint32_t i = 0;
+  for (; i + 64 <= length; i += 64) {
+    sequence_word_apply_f(words[i / 64], in + i, out + i);
+  }
+  for (; i < length; i++) {
+    FLOAT_U32_XOR(out[i], in[i], (uint32_t)((words[i / 64] >> (i % 64)) & 1U) << 31U);
+  }
+}
+
+static void sequence_words_apply_bit(const uint64_t* words, const uint8_t* in, uint8_t* out, uint32_t length)
+{
+  uint32_t i = 0;
+  for (; i + 64 <= length; i += 64) {
+    sequence_word_apply_bit(words[i / 64], in + i, out + i);
+  }
+  for (; i < length; i++) {
+    out[i] = in[i] ^ (uint8_t)((words[i / 64] >> (i % 64)) & 1U);
+  }
+}
+
+static void sequence_words_gen_f(const uint64_t* words, float value, float* out, uint32_t length)
+{
+  uint32_t i = 0;
+  for (; i + 64 <= length; i += 64) {
+    sequence_word_gen_f(words[i / 64], value, out + i);
+  }
+  for (; i < length; i++) {
+    FLOAT_U32_XOR(out[i], value, (uint32_t)((words[i / 64] >> (i % 64)) & 1U) << 31U);
+  }
+}
+
+const srsran_sequence_simd_table_t SEQUENCE_SIMD_TABLE = {.wide      = SEQUENCE_SIMD_WIDE,
+                                                          .apply_c   = sequence_words_apply_c,
+                                                          .apply_s   = sequence_words_apply_s,
+                                                          .apply_f   = sequence_words_apply_f,
+                                                          .apply_bit = sequence_words_apply_bit,
+                                                          .gen_f     = sequence_words_gen_f};
@@ -0,0 +1,65 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ *  File:         sequence_simd.h
+ *  Description:  Table of the kernels that apply pseudo-random sequence bits,
+ *                packed in 64-bit words, to int8, int16, float and unpacked
+ *                bit buffers. The kernels are built once with the library
+ *                flags and, if the ISA dispatch is enabled, once more for AVX2
+ *                and AVX-512. sequence.c uses the table of the instruction set
+ *                selected by the vector kernel dispatcher.
+ *****************************************************************************/
+
+#ifndef SRSRAN_SEQUENCE_SIMD_H
+#define SRSRAN_SEQUENCE_SIMD_H
+
+#include "srsran/config.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#define FLOAT_U32_XOR(DST, SRC, U32_MASK)                                                                              \
+  do {                                                                                                                 \
+    uint32_t temp_u32;                                                                                                 \
+    memcpy(&temp_u32, &(SRC), 4);                                                                                      \
+    temp_u32 ^= (U32_MASK);                                                                                            \
+    memcpy(&(DST), &temp_u32, 4);                                                                                      \
+  } while (false)
+
+typedef struct {
+  // Whole blocks of words replace the 24 bit loops of sequence.c, it is only faster with AVX2 or wider
+  bool wide;
+  void (*apply_c)(const uint64_t* words, const int8_t* in, int8_t* out, uint32_t length);
+  void (*apply_s)(const uint64_t* words, const int16_t* in, int16_t* out, uint32_t length);
+  void (*apply_f)(const uint64_t* words, const float* in, float* out, uint32_t length);
+  void (*apply_bit)(const uint64_t* words, const uint8_t* in, uint8_t* out, uint32_t length);
+  void (*gen_f)(const uint64_t* words, float value, float* out, uint32_t length);
+} srsran_sequence_simd_table_t;
+
+extern const srsran_sequence_simd_table_t srsran_sequence_simd_table_native;
+
+#ifdef SRSRAN_VEC_ISA_DISPATCH
+extern const srsran_sequence_simd_table_t srsran_sequence_simd_table_avx2;
+extern const srsran_sequence_simd_table_t srsran_sequence_simd_table_avx512;
+#endif /* SRSRAN_VEC_ISA_DISPATCH */
+
+#endif // SRSRAN_SEQUENCE_SIMD_H
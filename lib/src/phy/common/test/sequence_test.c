@@ -43,6 +43,46 @@ static int8_t  ones_char[Nc + MAX_SEQ_LEN + 31];
 static uint8_t ones_packed[(MAX_SEQ_LEN * 7) / 8];
 static uint8_t ones_unpacked[MAX_SEQ_LEN];
 
+static float   in_float[MAX_SEQ_LEN];
+static int16_t in_short[MAX_SEQ_LEN];
+static int8_t  in_char[MAX_SEQ_LEN];
+static uint8_t in_unpacked[MAX_SEQ_LEN];
+static uint8_t in_packed[MAX_SEQ_LEN / 8];
+static float   out_float[MAX_SEQ_LEN];
+static int16_t out_short[MAX_SEQ_LEN];
+static int8_t  out_char[MAX_SEQ_LEN];
+static uint8_t out_unpacked[MAX_SEQ_LEN];
+static uint8_t out_packed[MAX_SEQ_LEN / 8];
+
+// Sequence cache test parameters, the maximum length is the one of a 100 PRB PUSCH with 64QAM
+#define CACHE_NOF_USERS 4
+#define CACHE_NOF_IDX 3
+#define CACHE_NOF_RNTIS 6
+#define CACHE_NOF_SEEDS 6
+#define CACHE_MAX_LEN 86400
+
+static void gold_sequence(uint32_t seed, uint32_t length)
+{
+  for (uint32_t n = 0; n < 31; n++) {
+    x2[n] = (seed >> n) & 0x1;
+  }
+  x1[0] = 1;
+
+  for (uint32_t n = 0; n < Nc + length; n++) {
+    x1[n + 31] = (x1[n + 3] + x1[n]) & 0x1;
+    x2[n + 31] = (x2[n + 3] + x2[n + 2] + x2[n + 1] + x2[n]) & 0x1;
+  }
+
+  for (uint32_t n = 0; n < length; n++) {
+    c[n]       = (x1[n + Nc] + x2[n + Nc]) & 0x1;
+    c_float[n] = c[n] ? -1.0f : +1.0f;
+    c_short[n] = c[n] ? -1 : +1;
+    c_char[n]  = c[n] ? -1 : +1;
+  }
+
+  srsran_bit_pack_vector(c, c_packed_gold, length);
+}
+
 static int test_sequence(srsran_sequence_t* sequence, uint32_t seed, uint32_t length, uint32_t repetitions)
 {
   int            ret                      = SRSRAN_SUCCESS;
@@ -66,24 +106,7 @@ static int test_sequence(srsran_sequence_t* sequence, uint32_t seed, uint32_t le
   interval_gen_us = t->tv_sec * 1000000UL + t->tv_usec;
 
   // Generate gold sequence
-  for (uint32_t n = 0; n < 31; n++) {
-    x2[n] = (seed >> n) & 0x1;
-  }
-  x1[0] = 1;
-
-  for (uint32_t n = 0; n < Nc + length; n++) {
-    x1[n + 31] = (x1[n + 3] + x1[n]) & 0x1;
-    x2[n + 31] = (x2[n + 3] + x2[n + 2] + x2[n + 1] + x2[n]) & 0x1;
-  }
-
-  for (uint32_t n = 0; n < length; n++) {
-    c[n]       = (x1[n + Nc] + x2[n + Nc]) & 0x1;
-    c_float[n] = c[n] ? -1.0f : +1.0f;
-    c_short[n] = c[n] ? -1 : +1;
-    c_char[n]  = c[n] ? -1 : +1;
-  }
-
-  srsran_bit_pack_vector(c, c_packed_gold, length);
+  gold_sequence(seed, length);
 
   if (memcmp(c, sequence->c, length) != 0) {
     ERROR("Unmatched c");
@@ -192,6 +215,197 @@ static int test_sequence(srsran_sequence_t* sequence, uint32_t seed, uint32_t le
   return SRSRAN_SUCCESS;
 }
 
+// Checks the sequence applied to the random inputs against the gold sequence, starting at the given offset
+static int check_apply(uint32_t offset, uint32_t length, bool check_packed)
+{
+  for (uint32_t n = 0; n < length; n++) {
+    uint8_t bit = c[offset + n];
+    if (out_char[n] != (int8_t)(bit ? -in_char[n] : in_char[n])) {
+      ERROR("Unmatched c_char at %d", n);
+      return SRSRAN_ERROR;
+    }
+    if (out_float[n] != (bit ? -in_float[n] : in_float[n])) {
+      ERROR("Unmatched c_float at %d", n);
+      return SRSRAN_ERROR;
+    }
+    if (out_unpacked[n] != (in_unpacked[n] ^ bit)) {
+      ERROR("Unmatched c_unpacked at %d", n);
+      return SRSRAN_ERROR;
+    }
+  }
+
+  if (!check_packed) {
+    return SRSRAN_SUCCESS;
+  }
+
+  for (uint32_t n = 0; n < length; n++) {
+    if (out_short[n] != (int16_t)(c[n] ? -in_short[n] : in_short[n])) {
+      ERROR("Unmatched c_short at %d", n);
+      return SRSRAN_ERROR;
+    }
+  }
+
+  for (uint32_t n = 0; n < (length + 7) / 8; n++) {
+    if (out_packed[n] != (in_packed[n] ^ c_packed_gold[n])) {
+      ERROR("Unmatched c_packed at byte %d", n);
+      return SRSRAN_ERROR;
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+static int test_state(uint32_t seed, uint32_t offset, uint32_t length)
+{
+  srsran_sequence_state_t state = {};
+
+  gold_sequence(seed, offset + length);
+
+  srsran_sequence_state_init(&state, seed);
+  srsran_sequence_state_advance(&state, offset);
+  srsran_sequence_state_apply_c(&state, in_char, out_char, length);
+
+  srsran_sequence_state_init(&state, seed);
+  srsran_sequence_state_advance(&state, offset);
+  srsran_sequence_state_apply_f(&state, in_float, out_float, length);
+
+  srsran_sequence_state_init(&state, seed);
+  srsran_sequence_state_advance(&state, offset);
+  srsran_sequence_state_apply_bit(&state, in_unpacked, out_unpacked, length);
+
+  if (check_apply(offset, length, false) != SRSRAN_SUCCESS) {
+    ERROR("Failed seed=0x%08x; offset=%d; length=%d", seed, offset, length);
+    return SRSRAN_ERROR;
+  }
+
+  // The generated values must carry the sign of the sequence
+  srsran_sequence_state_init(&state, seed);
+  srsran_sequence_state_advance(&state, offset);
+  srsran_sequence_state_gen_f(&state, 0.5f, out_float, length);
+  for (uint32_t n = 0; n < length; n++) {
+    if (out_float[n] != (c[offset + n] ? -0.5f : +0.5f)) {
+      ERROR("Unmatched generated float at %d (seed=0x%08x; offset=%d; length=%d)", n, seed, offset, length);
+      return SRSRAN_ERROR;
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+static int
+test_cache(srsran_sequence_cache_t* cache, uint16_t rnti, uint32_t idx, uint32_t seed, uint32_t length)
+{
+  gold_sequence(seed, length);
+
+  srsran_sequence_cache_apply_c(cache, in_char, out_char, length, rnti, idx, seed);
+  srsran_sequence_cache_apply_s(cache, in_short, out_short, length, rnti, idx, seed);
+  srsran_sequence_cache_apply_f(cache, in_float, out_float, length, rnti, idx, seed);
+  srsran_sequence_cache_apply_bit(cache, in_unpacked, out_unpacked, length, rnti, idx, seed);
+  srsran_sequence_cache_apply_packed(cache, in_packed, out_packed, length, rnti, idx, seed);
+
+  if (check_apply(0, length, true) != SRSRAN_SUCCESS) {
+    ERROR("Failed cached rnti=0x%x; idx=%d; seed=0x%08x; length=%d", rnti, idx, seed, length);
+    return SRSRAN_ERROR;
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+static uint32_t cache_nof_sequences(const srsran_sequence_cache_t* cache, uint16_t rnti)
+{
+  uint32_t count = 0;
+  for (uint32_t i = 0; i < cache->nof_entries; i++) {
+    if (cache->entries[i].len > 0 && cache->entries[i].rnti == rnti) {
+      count++;
+    }
+  }
+  return count;
+}
+
+// RNTIs equal modulo the number of users share the cache, the least recently used sequences are replaced first
+static int test_cache_replacement(void)
+{
+  srsran_sequence_cache_t cache = {};
+  if (srsran_sequence_cache_init(&cache, CACHE_NOF_USERS, CACHE_NOF_IDX, CACHE_MAX_LEN) != SRSRAN_SUCCESS) {
+    fprintf(stderr, "Error initializing sequence cache\n");
+    return SRSRAN_ERROR;
+  }
+
+  int ret = SRSRAN_SUCCESS;
+  for (uint32_t u = 0; u < CACHE_NOF_USERS && ret == SRSRAN_SUCCESS; u++) {
+    uint16_t rnti = (uint16_t)(0x46 + u * CACHE_NOF_USERS);
+    for (uint32_t idx = 0; idx < CACHE_NOF_IDX && ret == SRSRAN_SUCCESS; idx++) {
+      ret = test_cache(&cache, rnti, idx, ((uint32_t)rnti << 14U) + (idx << 9U) + 1, 1000);
+    }
+    if (cache_nof_sequences(&cache, rnti) != CACHE_NOF_IDX) {
+      ERROR("Sequences of rnti=0x%x were replaced with free entries", rnti);
+      ret = SRSRAN_ERROR;
+    }
+  }
+
+  // One more sequence replaces the first used one
+  uint16_t last = (uint16_t)(0x46 + CACHE_NOF_USERS * CACHE_NOF_USERS);
+  if (ret == SRSRAN_SUCCESS) {
+    ret = test_cache(&cache, last, 0, ((uint32_t)last << 14U) + 1, 1000);
+  }
+  if (ret == SRSRAN_SUCCESS && cache_nof_sequences(&cache, 0x46) != CACHE_NOF_IDX - 1) {
+    ERROR("The least recently used sequence was not replaced");
+    ret = SRSRAN_ERROR;
+  }
+
+  // Two users keep the most recently used sequences
+  srsran_sequence_cache_set_nof_users(&cache, 2);
+  uint16_t newest = (uint16_t)(0x46 + (CACHE_NOF_USERS - 1) * CACHE_NOF_USERS);
+  if (ret == SRSRAN_SUCCESS &&
+      (cache.nof_entries != 2 * CACHE_NOF_IDX || cache_nof_sequences(&cache, last) != 1 ||
+       cache_nof_sequences(&cache, newest) != CACHE_NOF_IDX ||
+       cache_nof_sequences(&cache, newest - CACHE_NOF_USERS) != CACHE_NOF_IDX - 1)) {
+    ERROR("Reducing the number of users did not keep the most recently used sequences");
+    ret = SRSRAN_ERROR;
+  }
+  for (uint32_t idx = 0; idx < CACHE_NOF_IDX && ret == SRSRAN_SUCCESS; idx++) {
+    ret = test_cache(&cache, newest, idx, ((uint32_t)newest << 14U) + (idx << 9U) + 1, 2000);
+  }
+
+  srsran_sequence_cache_free(&cache);
+  return ret;
+}
+
+// Descrambles the LLR of a number of users transmitting in every subframe, with and without the cache
+static void benchmark_cache(srsran_sequence_cache_t* cache, uint32_t nof_users, uint32_t repetitions)
+{
+  struct timeval t[3]      = {};
+  uint64_t       gen_us    = 0;
+  uint64_t       cached_us = 0;
+
+  for (uint32_t r = 0; r < repetitions; r++) {
+    for (uint32_t sf = 0; sf < SRSRAN_NOF_SF_X_FRAME; sf++) {
+      for (uint16_t rnti = 0x46; rnti < 0x46 + nof_users; rnti++) {
+        uint32_t seed = ((uint32_t)rnti << 14U) + (sf << 9U) + 1;
+
+        gettimeofday(&t[1], NULL);
+        srsran_sequence_apply_c(in_char, out_char, CACHE_MAX_LEN, seed);
+        gettimeofday(&t[2], NULL);
+        get_time_interval(t);
+        gen_us += t->tv_sec * 1000000UL + t->tv_usec;
+
+        gettimeofday(&t[1], NULL);
+        srsran_sequence_cache_apply_c(cache, in_char, out_char, CACHE_MAX_LEN, rnti, sf, seed);
+        gettimeofday(&t[2], NULL);
+        get_time_interval(t);
+        cached_us += t->tv_sec * 1000000UL + t->tv_usec;
+      }
+    }
+  }
+
+  double nof_bits = (double)CACHE_MAX_LEN * SRSRAN_NOF_SF_X_FRAME * nof_users * repetitions;
+  printf("XOR 8 descrambling %d bits of %d users: %.1f Mbps generated; %.1f Mbps cached\n",
+         CACHE_MAX_LEN,
+         nof_users,
+         gen_us ? nof_bits / (double)gen_us : 0.0,
+         cached_us ? nof_bits / (double)cached_us : 0.0);
+}
+
 int main(int argc, char** argv)
 {
   uint32_t repetitions = 1;
@@ -233,9 +447,71 @@ int main(int argc, char** argv)
     test_sequence(&sequence, (uint32_t)srsran_random_uniform_int_dist(random_gen, 1, INT32_MAX), length, repetitions);
   }
 
+  // Random inputs for checking the sequence application
+  for (uint32_t i = 0; i < MAX_SEQ_LEN; i++) {
+    in_float[i]    = srsran_random_uniform_real_dist(random_gen, -1.0f, 1.0f);
+    in_short[i]    = (int16_t)srsran_random_uniform_int_dist(random_gen, INT16_MIN, INT16_MAX);
+    in_char[i]     = (int8_t)srsran_random_uniform_int_dist(random_gen, INT8_MIN, INT8_MAX);
+    in_unpacked[i] = (uint8_t)srsran_random_uniform_int_dist(random_gen, 0, 1);
+    if (i < MAX_SEQ_LEN / 8) {
+      in_packed[i] = (uint8_t)srsran_random_uniform_int_dist(random_gen, 0, UINT8_MAX);
+    }
+  }
+
+  // Sequence states starting at arbitrary offsets
+  int ret = SRSRAN_SUCCESS;
+  for (uint32_t i = 0; i < 200 && ret == SRSRAN_SUCCESS; i++) {
+    ret = test_state((uint32_t)srsran_random_uniform_int_dist(random_gen, 1, INT32_MAX),
+                     (uint32_t)srsran_random_uniform_int_dist(random_gen, 0, 1000),
+                     (uint32_t)srsran_random_uniform_int_dist(random_gen, 0, 5000));
+  }
+
+  // Sequence cache, with more RNTIs than users, more indexes than the cache holds, seeds changing for the same entry,
+  // released users and random lengths for exercising the replacement, the extension of the cached sequences and the
+  // lengths beyond the cache maximum
+  srsran_sequence_cache_t cache = {};
+  if (srsran_sequence_cache_init(&cache, CACHE_NOF_USERS, CACHE_NOF_IDX, CACHE_MAX_LEN) != SRSRAN_SUCCESS) {
+    fprintf(stderr, "Error initializing sequence cache\n");
+    return SRSRAN_ERROR;
+  }
+
+  uint32_t seeds[CACHE_NOF_SEEDS];
+  for (uint32_t i = 0; i < CACHE_NOF_SEEDS; i++) {
+    seeds[i] = (uint32_t)srsran_random_uniform_int_dist(random_gen, 1, INT32_MAX);
+  }
+
+  for (uint32_t i = 0; i < 300 && ret == SRSRAN_SUCCESS; i++) {
+    uint16_t rnti = (uint16_t)(0x46 + srsran_random_uniform_int_dist(random_gen, 0, CACHE_NOF_RNTIS - 1));
+    uint32_t idx  = (uint32_t)srsran_random_uniform_int_dist(random_gen, 0, 2 * CACHE_NOF_IDX);
+    uint32_t seed = seeds[srsran_random_uniform_int_dist(random_gen, 0, CACHE_NOF_SEEDS - 1)];
+    ret           = test_cache(
+        &cache, rnti, idx, seed, (uint32_t)srsran_random_uniform_int_dist(random_gen, 1, CACHE_MAX_LEN + 1000));
+
+    // Released users regenerate their sequences on the next use
+    if (i % 16 == 15) {
+      srsran_sequence_cache_release(&cache, rnti);
+    }
+  }
+
+  srsran_sequence_cache_free(&cache);
+
+  if (ret == SRSRAN_SUCCESS) {
+    ret = test_cache_replacement();
+  }
+
+  if (ret == SRSRAN_SUCCESS) {
+    if (srsran_sequence_cache_init(&cache, SRSRAN_SEQUENCE_CACHE_NOF_USERS, SRSRAN_NOF_SF_X_FRAME, CACHE_MAX_LEN) !=
+        SRSRAN_SUCCESS) {
+      fprintf(stderr, "Error initializing sequence cache\n");
+      return SRSRAN_ERROR;
+    }
+    benchmark_cache(&cache, 16, 10);
+    srsran_sequence_cache_free(&cache);
+  }
+
   // Free sequence object
   srsran_sequence_free(&sequence);
   srsran_random_free(random_gen);
 
-  return SRSRAN_SUCCESS;
+  return ret;
 }
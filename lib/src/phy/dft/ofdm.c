@@ -101,7 +101,8 @@ static int ofdm_init_mbsfn_(srsran_ofdm_t* q, srsran_ofdm_cfg_t* cfg, srsran_dft
     }
 
 #ifdef AVOID_GURU
-    q->tmp = srsran_vec_cf_malloc(symbol_sz);
+    // The receiver with CFO correction keeps the DFT input and output in two consecutive symbols
+    q->tmp = srsran_vec_cf_malloc(2 * symbol_sz);
 #else
     q->tmp = srsran_vec_cf_malloc(q->sf_sz);
 #endif /* AVOID_GURU */
@@ -126,7 +127,7 @@ static int ofdm_init_mbsfn_(srsran_ofdm_t* q, srsran_ofdm_cfg_t* cfg, srsran_dft
   }
 
 #ifdef AVOID_GURU
-  srsran_vec_cf_zero(q->tmp, symbol_sz);
+  srsran_vec_cf_zero(q->tmp, 2 * symbol_sz);
 #else
   uint32_t nof_prb = q->cfg.nof_prb;
   cf_t* in_buffer = q->cfg.in_buffer;
@@ -561,6 +562,106 @@ void srsran_ofdm_rx_sf_ng(srsran_ofdm_t* q, cf_t* input, cf_t* output)
   }
 }
 
+/* Demodulates one OFDM symbol starting at sample n of the subframe, applying the CFO correction and the optional
+ * frequency shift while the symbol is copied into the DFT input buffer. The phase accumulated by the CFO until the
+ * beginning of the symbol is applied after the DFT, together with the normalization and phase compensation, so
+ * the phase is continuous across all the symbols in the subframe.
+ */
+static void ofdm_rx_symbol_cfo(srsran_ofdm_t* q, uint32_t n, float cfo, uint32_t symbol_idx, cf_t* output)
+{
+  uint32_t symbol_sz = q->cfg.symbol_sz;
+  uint32_t nof_re    = q->nof_re;
+  uint32_t dc        = (q->fft_plan.dc) ? 1 : 0;
+  cf_t*    fft_in    = q->tmp;
+  cf_t*    fft_out   = q->tmp + symbol_sz;
+
+  srsran_vec_apply_cfo(&q->cfg.in_buffer[n], cfo, fft_in, (int)symbol_sz);
+  if (isnormal(q->cfg.freq_shift_f)) {
+    srsran_vec_prod_ccc(fft_in, &q->shift_buffer[n], fft_in, symbol_sz);
+  }
+
+  srsran_dft_run_c_zerocopy(&q->fft_plan, fft_in, fft_out);
+
+  // Apply frequency domain window offset
+  if (q->window_offset_n) {
+    srsran_vec_prod_ccc(fft_out, q->window_offset_buffer, fft_out, symbol_sz);
+  }
+
+  // Perform FFT shift
+  srsran_vec_cf_copy(output, fft_out + symbol_sz - nof_re / 2, nof_re / 2);
+  srsran_vec_cf_copy(output + nof_re / 2, &fft_out[dc], nof_re / 2);
+
+  // CFO phase at the beginning of the symbol, calculated in double precision
+  cf_t phase = (cf_t)cexp(I * 2.0 * M_PI * (double)cfo * (double)n);
+
+  if (isnormal(q->cfg.phase_compensation_hz)) {
+    phase *= conjf(q->phase_compensation[symbol_idx]);
+  }
+
+  if (q->fft_plan.norm) {
+    phase *= 1.0f / sqrtf(q->fft_plan.size);
+  }
+
+  srsran_vec_sc_prod_ccc(output, phase, output, nof_re);
+}
+
+/* Same as ofdm_rx_slot_mbsfn() for the first slot of an MBSFN subframe, correcting the CFO of each symbol into the
+ * scratch buffer so the input buffer is not modified.
+ */
+static void ofdm_rx_slot_mbsfn_cfo(srsran_ofdm_t* q, float cfo, cf_t* output)
+{
+  uint32_t symbol_sz = q->cfg.symbol_sz;
+  cf_t*    fft_in    = q->tmp;
+  cf_t*    fft_out   = q->tmp + symbol_sz;
+  uint32_t n         = 0;
+
+  for (uint32_t i = 0; i < q->nof_symbols_mbsfn; i++) {
+    if (i == q->non_mbsfn_region) {
+      n += SRSRAN_NON_MBSFN_REGION_GUARD_LENGTH(q->non_mbsfn_region, symbol_sz);
+    }
+    n += (i >= q->non_mbsfn_region) ? SRSRAN_CP_LEN_EXT(symbol_sz) : SRSRAN_CP_LEN_NORM(i, symbol_sz);
+
+    srsran_vec_apply_cfo(&q->cfg.in_buffer[n], cfo, fft_in, (int)symbol_sz);
+    if (isnormal(q->cfg.freq_shift_f)) {
+      srsran_vec_prod_ccc(fft_in, &q->shift_buffer[n], fft_in, symbol_sz);
+    }
+    srsran_dft_run_c(&q->fft_plan, fft_in, fft_out);
+
+    // CFO phase at the beginning of the symbol
+    cf_t phase = (cf_t)cexp(I * 2.0 * M_PI * (double)cfo * (double)n);
+    srsran_vec_sc_prod_ccc(&fft_out[q->nof_guards], phase, output, q->nof_re);
+
+    n += symbol_sz;
+    output += q->nof_re;
+  }
+}
+
+void srsran_ofdm_rx_sf_cfo(srsran_ofdm_t* q, float cfo)
+{
+  uint32_t    symbol_sz = q->cfg.symbol_sz;
+  srsran_cp_t cp        = q->cfg.cp;
+  cf_t*       output    = q->cfg.out_buffer;
+  uint32_t    n         = 0;
+  uint32_t    slot      = 0;
+
+  // The first slot of MBSFN subframes has its own numerology, the second one is demodulated as usual
+  if (q->mbsfn_subframe) {
+    ofdm_rx_slot_mbsfn_cfo(q, cfo, output);
+    n = q->slot_sz;
+    output += q->nof_re * q->nof_symbols;
+    slot = 1;
+  }
+
+  for (; slot < SRSRAN_NOF_SLOTS_PER_SF; slot++) {
+    for (uint32_t i = 0; i < q->nof_symbols; i++) {
+      n += SRSRAN_CP_ISNORM(cp) ? SRSRAN_CP_LEN_NORM(i, symbol_sz) : SRSRAN_CP_LEN_EXT(symbol_sz);
+      ofdm_rx_symbol_cfo(q, n - q->window_offset_n, cfo, slot * q->nof_symbols + i, output);
+      n += symbol_sz;
+      output += q->nof_re;
+    }
+  }
+}
+
 /* Transforms input OFDM symbols into output samples.
  * Performs FFT on a each symbol and adds CP.
  */
@@ -665,3 +766,155 @@ void srsran_ofdm_tx_sf(srsran_ofdm_t* q)
     srsran_vec_prod_ccc(q->cfg.out_buffer, q->shift_buffer, q->cfg.out_buffer, q->sf_sz);
   }
 }
+
+int srsran_ofdm_tx_batch_init(srsran_ofdm_tx_batch_t* q,
+                              cf_t*                   in_buffer[SRSRAN_MAX_PORTS],
+                              cf_t*                   out_buffer[SRSRAN_MAX_PORTS],
+                              uint32_t                max_ports,
+                              uint32_t                max_prb)
+{
+  if (q == NULL || in_buffer == NULL || out_buffer == NULL || max_ports == 0 || max_ports > SRSRAN_MAX_PORTS) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  SRSRAN_MEM_ZERO(q, srsran_ofdm_tx_batch_t, 1);
+
+  int symbol_sz = srsran_symbol_sz(max_prb);
+  if (symbol_sz <= SRSRAN_SUCCESS) {
+    ERROR("Invalid number of PRB %d", max_prb);
+    return SRSRAN_ERROR;
+  }
+
+  q->max_prb   = max_prb;
+  q->max_ports = max_ports;
+  q->scale     = 1.0f;
+  for (uint32_t i = 0; i < max_ports; i++) {
+    q->in_buffer[i]  = in_buffer[i];
+    q->out_buffer[i] = out_buffer[i];
+  }
+
+  // Normal CP gives the largest number of symbols
+  q->tmp = srsran_vec_cf_malloc(SRSRAN_CP_NORM_NSYMB * (uint32_t)symbol_sz);
+  if (!q->tmp) {
+    perror("malloc");
+    return SRSRAN_ERROR;
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+static void ofdm_tx_batch_free_plans(srsran_ofdm_tx_batch_t* q)
+{
+  for (uint32_t p = 0; p < SRSRAN_MAX_PORTS; p++) {
+    for (uint32_t slot = 0; slot < SRSRAN_NOF_SLOTS_PER_SF; slot++) {
+      if (q->plan[p][slot].size) {
+        srsran_dft_plan_free(&q->plan[p][slot]);
+      }
+    }
+  }
+}
+
+int srsran_ofdm_tx_batch_set_cell(srsran_ofdm_tx_batch_t* q, srsran_cp_t cp, uint32_t nof_prb, uint32_t nof_ports)
+{
+  if (q == NULL || nof_prb > q->max_prb || nof_ports == 0 || nof_ports > q->max_ports) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  int symbol_sz = srsran_symbol_sz(nof_prb);
+  if (symbol_sz <= SRSRAN_SUCCESS) {
+    ERROR("Invalid number of PRB %d", nof_prb);
+    return SRSRAN_ERROR;
+  }
+
+  // Check if there is nothing to configure
+  if (q->plan[0][0].size && q->cp == cp && q->nof_prb == nof_prb && q->nof_ports == nof_ports) {
+    return SRSRAN_SUCCESS;
+  }
+
+  q->cp          = cp;
+  q->nof_prb     = nof_prb;
+  q->nof_ports   = nof_ports;
+  q->symbol_sz   = (uint32_t)symbol_sz;
+  q->nof_symbols = SRSRAN_CP_NSYMB(cp);
+  q->nof_re      = nof_prb * SRSRAN_NRE;
+  q->slot_sz     = (uint32_t)SRSRAN_SLOT_LEN(q->symbol_sz);
+  q->sf_sz       = (uint32_t)SRSRAN_SF_LEN(q->symbol_sz);
+
+  ofdm_tx_batch_free_plans(q);
+
+  // Every symbol after the first one of a slot has the same CP length, the first symbol starts at the longest CP
+  uint32_t cp1 = SRSRAN_CP_ISNORM(cp) ? SRSRAN_CP_LEN_NORM(0, q->symbol_sz) : SRSRAN_CP_LEN_EXT(q->symbol_sz);
+  uint32_t cp2 = SRSRAN_CP_ISNORM(cp) ? SRSRAN_CP_LEN_NORM(1, q->symbol_sz) : SRSRAN_CP_LEN_EXT(q->symbol_sz);
+
+  for (uint32_t p = 0; p < nof_ports; p++) {
+    for (uint32_t slot = 0; slot < SRSRAN_NOF_SLOTS_PER_SF; slot++) {
+      if (srsran_dft_plan_guru_c(&q->plan[p][slot],
+                                 symbol_sz,
+                                 SRSRAN_DFT_BACKWARD,
+                                 q->tmp,
+                                 q->out_buffer[p] + cp1 + q->slot_sz * slot,
+                                 1,
+                                 1,
+                                 q->nof_symbols,
+                                 symbol_sz,
+                                 symbol_sz + cp2)) {
+        ERROR("Creating Guru inverse-DFT plan (port %d, slot %d)", p, slot);
+        return SRSRAN_ERROR;
+      }
+    }
+  }
+
+  // Planning may overwrite the buffer, guard subcarriers and DC are zeroed once and never written afterwards
+  srsran_vec_cf_zero(q->tmp, q->nof_symbols * q->symbol_sz);
+
+  return SRSRAN_SUCCESS;
+}
+
+void srsran_ofdm_tx_batch_set_scale(srsran_ofdm_tx_batch_t* q, float scale)
+{
+  q->scale = scale;
+}
+
+void srsran_ofdm_tx_batch_sf(srsran_ofdm_tx_batch_t* q)
+{
+  uint32_t symbol_sz = q->symbol_sz;
+  uint32_t nof_re    = q->nof_re;
+
+  for (uint32_t p = 0; p < q->nof_ports; p++) {
+    cf_t* input  = q->in_buffer[p];
+    cf_t* output = q->out_buffer[p];
+
+    for (uint32_t slot = 0; slot < SRSRAN_NOF_SLOTS_PER_SF; slot++) {
+      // The inverse-DFT is linear, scaling the subcarriers saves a pass over the larger time domain output
+      cf_t* tmp = q->tmp;
+      for (uint32_t i = 0; i < q->nof_symbols; i++) {
+        srsran_vec_sc_prod_cfc(&input[nof_re / 2], q->scale, &tmp[1], nof_re / 2);
+        srsran_vec_sc_prod_cfc(&input[0], q->scale, &tmp[symbol_sz - nof_re / 2], nof_re / 2);
+
+        input += nof_re;
+        tmp += symbol_sz;
+      }
+
+      srsran_dft_run_guru_c(&q->plan[p][slot]);
+
+      for (uint32_t i = 0; i < q->nof_symbols; i++) {
+        uint32_t cp_len = SRSRAN_CP_ISNORM(q->cp) ? SRSRAN_CP_LEN_NORM(i, symbol_sz) : SRSRAN_CP_LEN_EXT(symbol_sz);
+        srsran_vec_cf_copy(output, &output[symbol_sz], cp_len);
+        output += symbol_sz + cp_len;
+      }
+    }
+  }
+}
+
+void srsran_ofdm_tx_batch_free(srsran_ofdm_tx_batch_t* q)
+{
+  if (q == NULL) {
+    return;
+  }
+
+  ofdm_tx_batch_free_plans(q);
+  if (q->tmp) {
+    free(q->tmp);
+  }
+  SRSRAN_MEM_ZERO(q, srsran_ofdm_tx_batch_t, 1);
+}
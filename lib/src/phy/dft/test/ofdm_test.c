@@ -36,6 +36,7 @@ static float       rx_window_offset      = 0.5f;
 static float       freq_shift_f          = 0.0f;
 static double      phase_compensation_hz = 0.0;
 static uint32_t    force_symbol_sz       = 0;
+static float       cfo                   = 0.0f;
 static double      elapsed_us(struct timeval* ts_start, struct timeval* ts_end)
 {
   if (ts_end->tv_usec > ts_start->tv_usec) {
@@ -57,12 +58,14 @@ static void usage(char* prog)
   printf("\t-o rx window offset (portion of CP length) [Default %.1f]\n", rx_window_offset);
   printf("\t-s frequency shift (normalised with sampling rate) [Default %.1f]\n", freq_shift_f);
   printf("\t-p Phase compensation carrier frequency in Hz [Default %.1f]\n", phase_compensation_hz);
+  printf("\t-c carrier frequency offset corrected by the receiver (normalised with sampling rate) [Default %.1f]\n",
+         cfo);
 }
 
 static void parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "Nnerosp")) != -1) {
+  while ((opt = getopt(argc, argv, "Nnerospc")) != -1) {
     switch (opt) {
       case 'n':
         nof_prb = (int)strtol(argv[optind], NULL, 10);
@@ -85,6 +88,9 @@ static void parse_args(int argc, char** argv)
       case 'p':
         phase_compensation_hz = strtod(argv[optind], NULL);
         break;
+      case 'c':
+        cfo = strtof(argv[optind], NULL);
+        break;
       default:
         usage(argv[0]);
         exit(-1);
@@ -150,7 +156,7 @@ int main(int argc, char** argv)
       exit(-1);
     }
 
-    if (isnormal(freq_shift_f)) {
+    if (isnormal(freq_shift_f) || isnormal(cfo)) {
       nof_repetitions = 1;
     }
 
@@ -165,10 +171,21 @@ int main(int argc, char** argv)
     gettimeofday(&end, NULL);
     printf(" Tx@%.1fMsps", (float)(sf_len * nof_repetitions) / elapsed_us(&start, &end));
 
+    // Emulate carrier frequency offset, the phase is calculated for every sample in double precision
+    if (isnormal(cfo)) {
+      for (uint32_t i = 0; i < sf_len; i++) {
+        outifft[i] *= (cf_t)cexp(I * 2.0 * M_PI * (double)cfo * (double)i);
+      }
+    }
+
     // Execute Rx
     gettimeofday(&start, NULL);
     for (uint32_t i = 0; i < nof_repetitions; i++) {
-      srsran_ofdm_rx_sf(&fft);
+      if (isnormal(cfo)) {
+        srsran_ofdm_rx_sf_cfo(&fft, -cfo);
+      } else {
+        srsran_ofdm_rx_sf(&fft);
+      }
     }
     gettimeofday(&end, NULL);
     printf(" Rx@%.1fMsps", (double)(sf_len * nof_repetitions) / elapsed_us(&start, &end));
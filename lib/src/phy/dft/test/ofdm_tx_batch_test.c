@@ -0,0 +1,185 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "srsran/phy/utils/random.h"
+#include "srsran/srsran.h"
+#include "srsran/support/srsran_test.h"
+
+static int         nof_prb         = -1;
+static uint32_t    nof_ports       = 4;
+static srsran_cp_t cp              = SRSRAN_CP_NORM;
+static int         nof_repetitions = 1;
+static float       scale           = 0.05f;
+
+static void usage(char* prog)
+{
+  printf("Usage: %s\n", prog);
+  printf("\t-n Force number of Resource blocks [Default All]\n");
+  printf("\t-p Number of ports [Default %d]\n", nof_ports);
+  printf("\t-e extended cyclic prefix [Default Normal]\n");
+  printf("\t-r nof_repetitions [Default %d]\n", nof_repetitions);
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "nper")) != -1) {
+    switch (opt) {
+      case 'n':
+        nof_prb = (int)strtol(argv[optind], NULL, 10);
+        break;
+      case 'p':
+        nof_ports = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'e':
+        cp = SRSRAN_CP_EXT;
+        break;
+      case 'r':
+        nof_repetitions = (int)strtol(argv[optind], NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+static double elapsed_us(struct timeval* ts_start, struct timeval* ts_end)
+{
+  return ((double)ts_end->tv_sec - (double)ts_start->tv_sec) * 1e6 + (double)ts_end->tv_usec -
+         (double)ts_start->tv_usec;
+}
+
+// Modulates every port with the single port modulator followed by a scaling pass, as the eNB did before batching
+static int test_prb(srsran_random_t random_gen, uint32_t n_prb, uint32_t max_prb)
+{
+  struct timeval start, end;
+  uint32_t       sf_len = SRSRAN_SF_LEN_PRB(n_prb);
+  uint32_t       n_re   = SRSRAN_SF_LEN_RE(n_prb, cp);
+  cf_t*          input[SRSRAN_MAX_PORTS]     = {NULL};
+  cf_t*          output[SRSRAN_MAX_PORTS]    = {NULL};
+  cf_t*          reference[SRSRAN_MAX_PORTS] = {NULL};
+  srsran_ofdm_t  ifft[SRSRAN_MAX_PORTS];
+
+  srsran_ofdm_tx_batch_t batch;
+  bzero(ifft, sizeof(ifft));
+  bzero(&batch, sizeof(batch));
+
+  printf("Running test for %d PRB, %d ports... ", n_prb, nof_ports);
+  fflush(stdout);
+
+  for (uint32_t p = 0; p < nof_ports; p++) {
+    input[p]     = srsran_vec_cf_malloc(SRSRAN_SF_LEN_RE(max_prb, SRSRAN_CP_NORM));
+    output[p]    = srsran_vec_cf_malloc(SRSRAN_SF_LEN_PRB(max_prb));
+    reference[p] = srsran_vec_cf_malloc(sf_len);
+    TESTASSERT(input[p] && output[p] && reference[p]);
+
+    srsran_ofdm_cfg_t ofdm_cfg;
+    bzero(&ofdm_cfg, sizeof(ofdm_cfg));
+    ofdm_cfg.cp         = cp;
+    ofdm_cfg.in_buffer  = input[p];
+    ofdm_cfg.out_buffer = reference[p];
+    ofdm_cfg.nof_prb    = n_prb;
+    TESTASSERT(srsran_ofdm_tx_init_cfg(&ifft[p], &ofdm_cfg) == SRSRAN_SUCCESS);
+  }
+
+  // The batch is initialised for the maximum size and then reconfigured, as the eNB does
+  TESTASSERT(srsran_ofdm_tx_batch_init(&batch, input, output, nof_ports, max_prb) == SRSRAN_SUCCESS);
+  TESTASSERT(srsran_ofdm_tx_batch_set_cell(&batch, cp, n_prb, nof_ports) == SRSRAN_SUCCESS);
+  srsran_ofdm_tx_batch_set_scale(&batch, scale);
+
+  for (uint32_t p = 0; p < nof_ports; p++) {
+    srsran_random_uniform_complex_dist_vector(random_gen, input[p], n_re, -1.0f, +1.0f);
+  }
+
+  gettimeofday(&start, NULL);
+  for (int i = 0; i < nof_repetitions; i++) {
+    for (uint32_t p = 0; p < nof_ports; p++) {
+      srsran_ofdm_tx_sf(&ifft[p]);
+      srsran_vec_sc_prod_cfc(reference[p], scale, reference[p], sf_len);
+    }
+  }
+  gettimeofday(&end, NULL);
+  printf(" Tx@%.1fus/sf", elapsed_us(&start, &end) / nof_repetitions);
+
+  gettimeofday(&start, NULL);
+  for (int i = 0; i < nof_repetitions; i++) {
+    srsran_ofdm_tx_batch_sf(&batch);
+  }
+  gettimeofday(&end, NULL);
+  printf(" Batch@%.1fus/sf", elapsed_us(&start, &end) / nof_repetitions);
+
+  // Regenerate the reference, it was scaled again on every repetition
+  for (uint32_t p = 0; p < nof_ports; p++) {
+    srsran_ofdm_tx_sf(&ifft[p]);
+    srsran_vec_sc_prod_cfc(reference[p], scale, reference[p], sf_len);
+  }
+
+  float max_err = 0.0f;
+  for (uint32_t p = 0; p < nof_ports; p++) {
+    srsran_vec_sub_ccc(reference[p], output[p], output[p], sf_len);
+    max_err = SRSRAN_MAX(max_err, sqrtf(srsran_vec_avg_power_cf(output[p], sf_len)) / scale);
+  }
+  printf(" MSE=%.6f\n", max_err);
+  TESTASSERT(max_err < 0.0001f);
+
+  srsran_ofdm_tx_batch_free(&batch);
+  for (uint32_t p = 0; p < nof_ports; p++) {
+    srsran_ofdm_tx_free(&ifft[p]);
+    free(input[p]);
+    free(output[p]);
+    free(reference[p]);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  srsran_random_t random_gen = srsran_random_init(0);
+
+  parse_args(argc, argv);
+
+  if (nof_ports == 0 || nof_ports > SRSRAN_MAX_PORTS) {
+    usage(argv[0]);
+    return SRSRAN_ERROR;
+  }
+
+  uint32_t first_prb = (nof_prb == -1) ? 6 : (uint32_t)nof_prb;
+  uint32_t last_prb  = (nof_prb == -1) ? SRSRAN_MAX_PRB : (uint32_t)nof_prb;
+  for (uint32_t n_prb = first_prb; n_prb <= last_prb; n_prb++) {
+    if (test_prb(random_gen, n_prb, last_prb) != SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+  }
+
+  srsran_random_free(random_gen);
+
+  return SRSRAN_SUCCESS;
+}
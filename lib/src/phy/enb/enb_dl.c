@@ -54,6 +54,11 @@ int srsran_enb_dl_init(srsran_enb_dl_t* q, cf_t* out_buffer[SRSRAN_MAX_PORTS], u
       q->out_buffer[i] = out_buffer[i];
     }
 
+    if (srsran_ofdm_tx_batch_init(&q->ifft, q->sf_symbols, out_buffer, SRSRAN_MAX_PORTS, max_prb)) {
+      ERROR("Error initiating FFT");
+      goto clean_exit;
+    }
+
     srsran_ofdm_cfg_t ofdm_cfg = {};
     ofdm_cfg.nof_prb           = max_prb;
     ofdm_cfg.cp                = SRSRAN_CP_EXT;
@@ -120,9 +125,7 @@ clean_exit:
 void srsran_enb_dl_free(srsran_enb_dl_t* q)
 {
   if (q) {
-    for (int i = 0; i < SRSRAN_MAX_PORTS; i++) {
-      srsran_ofdm_tx_free(&q->ifft[i]);
-    }
+    srsran_ofdm_tx_batch_free(&q->ifft);
     srsran_ofdm_tx_free(&q->ifft_mbsfn);
     srsran_regs_free(&q->regs);
     srsran_pbch_free(&q->pbch);
@@ -152,29 +155,17 @@ int srsran_enb_dl_set_cell(srsran_enb_dl_t* q, srsran_cell_t cell)
         srsran_regs_free(&q->regs);
       }
       q->cell = cell;
-      srsran_ofdm_cfg_t ofdm_cfg = {};
-      ofdm_cfg.nof_prb           = q->cell.nof_prb;
-      ofdm_cfg.cp                = cell.cp;
-      ofdm_cfg.normalize         = false;
-      for (int i = 0; i < SRSRAN_MAX_PORTS; i++) {
-        ofdm_cfg.in_buffer  = q->sf_symbols[i];
-        ofdm_cfg.out_buffer = q->out_buffer[i];
-        ofdm_cfg.sf_type    = SRSRAN_SF_NORM;
-        if (srsran_ofdm_tx_init_cfg(&q->ifft[i], &ofdm_cfg)) {
-          ERROR("Error initiating FFT (%d)", i);
-          return SRSRAN_ERROR;
-        }
-      }
       if (srsran_regs_init(&q->regs, q->cell)) {
         ERROR("Error resizing REGs");
         return SRSRAN_ERROR;
       }
-      for (int i = 0; i < q->cell.nof_ports; i++) {
-        if (srsran_ofdm_tx_set_prb(&q->ifft[i], q->cell.cp, q->cell.nof_prb)) {
-          ERROR("Error re-planning iFFT (%d)", i);
-          return SRSRAN_ERROR;
-        }
+
+      // The output normalization is applied by the modulator while mapping the resource grid
+      if (srsran_ofdm_tx_batch_set_cell(&q->ifft, q->cell.cp, q->cell.nof_prb, q->cell.nof_ports)) {
+        ERROR("Error re-planning iFFT");
+        return SRSRAN_ERROR;
       }
+      srsran_ofdm_tx_batch_set_scale(&q->ifft, enb_dl_get_norm_factor(q->cell.nof_prb));
 
       if (srsran_ofdm_tx_set_prb(&q->ifft_mbsfn, SRSRAN_CP_EXT, q->cell.nof_prb)) {
         ERROR("Error re-planning ifft_mbsfn");
@@ -429,13 +420,7 @@ void srsran_enb_dl_gen_signal(srsran_enb_dl_t* q)
                            q->ifft_mbsfn.cfg.out_buffer,
                            (uint32_t)SRSRAN_SF_LEN_PRB(q->cell.nof_prb));
   } else {
-    for (int i = 0; i < q->cell.nof_ports; i++) {
-      srsran_ofdm_tx_sf(&q->ifft[i]);
-      srsran_vec_sc_prod_cfc(q->ifft[i].cfg.out_buffer,
-                             norm_factor,
-                             q->ifft[i].cfg.out_buffer,
-                             (uint32_t)SRSRAN_SF_LEN_PRB(q->cell.nof_prb));
-    }
+    srsran_ofdm_tx_batch_sf(&q->ifft);
   }
 }
 
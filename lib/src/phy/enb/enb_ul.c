@@ -26,17 +26,27 @@
 #include <math.h>
 #include <string.h>
 
-int srsran_enb_ul_init(srsran_enb_ul_t* q, cf_t* in_buffer, uint32_t max_prb)
+int srsran_enb_ul_init(srsran_enb_ul_t* q, cf_t* in_buffer[SRSRAN_MAX_PORTS], uint32_t max_prb, uint32_t nof_rx_ant)
 {
   int ret = SRSRAN_ERROR_INVALID_INPUTS;
 
-  if (q != NULL) {
+  if (q != NULL && in_buffer != NULL && nof_rx_ant > 0 && nof_rx_ant <= SRSRAN_MAX_PORTS) {
     ret = SRSRAN_ERROR;
 
     bzero(q, sizeof(srsran_enb_ul_t));
 
-    q->sf_symbols = srsran_vec_cf_malloc(SRSRAN_SF_LEN_RE(max_prb, SRSRAN_CP_NORM));
-    if (!q->sf_symbols) {
+    q->nof_rx_ant = nof_rx_ant;
+    for (uint32_t i = 0; i < q->nof_rx_ant; i++) {
+      q->sf_symbols[i] = srsran_vec_cf_malloc(SRSRAN_SF_LEN_RE(max_prb, SRSRAN_CP_NORM));
+      if (!q->sf_symbols[i]) {
+        perror("malloc");
+        goto clean_exit;
+      }
+      q->in_buffer[i] = in_buffer[i];
+    }
+
+    q->pusch_symbols = srsran_vec_cf_malloc(SRSRAN_SF_LEN_RE(max_prb, SRSRAN_CP_NORM));
+    if (!q->pusch_symbols) {
       perror("malloc");
       goto clean_exit;
     }
@@ -46,7 +56,6 @@ int srsran_enb_ul_init(srsran_enb_ul_t* q, cf_t* in_buffer, uint32_t max_prb)
       perror("malloc");
       goto clean_exit;
     }
-    q->in_buffer = in_buffer;
 
     if (srsran_pucch_init_enb(&q->pucch)) {
       ERROR("Error creating PUCCH object");
@@ -79,13 +88,18 @@ clean_exit:
 void srsran_enb_ul_free(srsran_enb_ul_t* q)
 {
   if (q) {
-    srsran_ofdm_rx_free(&q->fft);
+    for (uint32_t i = 0; i < SRSRAN_MAX_PORTS; i++) {
+      srsran_ofdm_rx_free(&q->fft[i]);
+      if (q->sf_symbols[i]) {
+        free(q->sf_symbols[i]);
+      }
+    }
     srsran_pucch_free(&q->pucch);
     srsran_pusch_free(&q->pusch);
     srsran_chest_ul_free(&q->chest);
 
-    if (q->sf_symbols) {
-      free(q->sf_symbols);
+    if (q->pusch_symbols) {
+      free(q->pusch_symbols);
     }
     if (q->chest_res.ce) {
       free(q->chest_res.ce);
@@ -105,21 +119,23 @@ int srsran_enb_ul_set_cell(srsran_enb_ul_t*                   q,
     if (cell.id != q->cell.id || q->cell.nof_prb == 0) {
       q->cell = cell;
 
-      srsran_ofdm_cfg_t ofdm_cfg = {};
-      ofdm_cfg.nof_prb           = q->cell.nof_prb;
-      ofdm_cfg.in_buffer         = q->in_buffer;
-      ofdm_cfg.out_buffer        = q->sf_symbols;
-      ofdm_cfg.cp                = q->cell.cp;
-      ofdm_cfg.freq_shift_f      = -0.5f;
-      ofdm_cfg.normalize         = false;
-      ofdm_cfg.rx_window_offset  = 0.5f;
-      if (srsran_ofdm_rx_init_cfg(&q->fft, &ofdm_cfg)) {
-        ERROR("Error initiating FFT");
-        return SRSRAN_ERROR;
-      }
-      if (srsran_ofdm_rx_set_prb(&q->fft, q->cell.cp, q->cell.nof_prb)) {
-        ERROR("Error initiating FFT");
-        return SRSRAN_ERROR;
+      for (uint32_t i = 0; i < q->nof_rx_ant; i++) {
+        srsran_ofdm_cfg_t ofdm_cfg = {};
+        ofdm_cfg.nof_prb           = q->cell.nof_prb;
+        ofdm_cfg.in_buffer         = q->in_buffer[i];
+        ofdm_cfg.out_buffer        = q->sf_symbols[i];
+        ofdm_cfg.cp                = q->cell.cp;
+        ofdm_cfg.freq_shift_f      = -0.5f;
+        ofdm_cfg.normalize         = false;
+        ofdm_cfg.rx_window_offset  = 0.5f;
+        if (srsran_ofdm_rx_init_cfg(&q->fft[i], &ofdm_cfg)) {
+          ERROR("Error initiating FFT");
+          return SRSRAN_ERROR;
+        }
+        if (srsran_ofdm_rx_set_prb(&q->fft[i], q->cell.cp, q->cell.nof_prb)) {
+          ERROR("Error initiating FFT");
+          return SRSRAN_ERROR;
+        }
       }
 
       if (srsran_pucch_set_cell(&q->pucch, q->cell)) {
@@ -137,8 +153,10 @@ int srsran_enb_ul_set_cell(srsran_enb_ul_t*                   q,
         return SRSRAN_ERROR;
       }
 
-      // SRS is a dedicated configuration
-      srsran_chest_ul_pregen(&q->chest, pusch_cfg, srs_cfg);
+      // SRS is a dedicated configuration. Without PUSCH DMRS configuration the signals are loaded afterwards
+      if (pusch_cfg != NULL) {
+        srsran_chest_ul_pregen(&q->chest, pusch_cfg, srs_cfg);
+      }
 
       ret = SRSRAN_SUCCESS;
     }
@@ -150,10 +168,13 @@ int srsran_enb_ul_set_cell(srsran_enb_ul_t*                   q,
 
 void srsran_enb_ul_fft(srsran_enb_ul_t* q)
 {
-  srsran_ofdm_rx_sf(&q->fft);
+  for (uint32_t i = 0; i < q->nof_rx_ant; i++) {
+    srsran_ofdm_rx_sf(&q->fft[i]);
+  }
 }
 
-static int get_pucch(srsran_enb_ul_t* q, srsran_ul_sf_cfg_t* ul_sf, srsran_pucch_cfg_t* cfg, srsran_pucch_res_t* res)
+static int
+get_pucch(srsran_enb_ul_t* q, srsran_ul_sf_cfg_t* ul_sf, srsran_pucch_cfg_t* cfg, srsran_pucch_res_t* res, bool joint)
 {
   int      ret                               = SRSRAN_SUCCESS;
   uint32_t n_pucch_i[SRSRAN_PUCCH_MAX_ALLOC] = {};
@@ -171,6 +192,9 @@ static int get_pucch(srsran_enb_ul_t* q, srsran_ul_sf_cfg_t* ul_sf, srsran_pucch
     return SRSRAN_ERROR;
   }
 
+  // The joint receiver detects formats 1, 1a and 1b only
+  joint = joint && cfg->format < SRSRAN_PUCCH_FORMAT_2;
+
   // Get possible resources
   int nof_resources = srsran_pucch_proc_get_resources(&q->cell, cfg, &cfg->uci_cfg, NULL, n_pucch_i);
   if (nof_resources < 1 || nof_resources > SRSRAN_PUCCH_CS_MAX_ACK) {
@@ -188,14 +212,19 @@ static int get_pucch(srsran_enb_ul_t* q, srsran_ul_sf_cfg_t* ul_sf, srsran_pucch
     // Configure resource
     cfg->n_pucch = n_pucch_i[i];
 
-    // Prepare configuration
-    if (srsran_chest_ul_estimate_pucch(&q->chest, ul_sf, cfg, q->sf_symbols, &q->chest_res)) {
-      ERROR("Error estimating PUCCH DMRS");
-      return SRSRAN_ERROR;
-    }
-    pucch_res.snr_db = q->chest_res.snr_db;
+    if (joint) {
+      // Channel estimation and measurements are done by the joint receiver
+      ret = srsran_pucch_decode_joint(&q->pucch, ul_sf, cfg, q->sf_symbols[0], &pucch_res);
+    } else {
+      // Prepare configuration
+      if (srsran_chest_ul_estimate_pucch(&q->chest, ul_sf, cfg, q->sf_symbols[0], &q->chest_res)) {
+        ERROR("Error estimating PUCCH DMRS");
+        return SRSRAN_ERROR;
+      }
+      pucch_res.snr_db = q->chest_res.snr_db;
 
-    ret = srsran_pucch_decode(&q->pucch, ul_sf, cfg, &q->chest_res, q->sf_symbols, &pucch_res);
+      ret = srsran_pucch_decode(&q->pucch, ul_sf, cfg, &q->chest_res, q->sf_symbols[0], &pucch_res);
+    }
     if (ret < SRSRAN_SUCCESS) {
       ERROR("Error decoding PUCCH");
     } else {
@@ -215,7 +244,18 @@ static int get_pucch(srsran_enb_ul_t* q, srsran_ul_sf_cfg_t* ul_sf, srsran_pucch
       // Compares correlation value, it stores the PUCCH result with the greatest correlation
       if (i == 0 || pucch_res.correlation > res->correlation) {
         // Copy measurements only if PUCCH was decoded succesfully
-        if (cfg->meas_ta_en) {
+        if (cfg->meas_ta_en && !joint) {
+          pucch_res.ta_valid = !(isnan(q->chest_res.ta_us) || isinf(q->chest_res.ta_us));
+          pucch_res.ta_us    = q->chest_res.ta_us;
+        }
+
+        // The joint receiver leaves the time alignment invalid if the resource cyclic shift may be next to another
+        // user, it is estimated from the channel of the resource as the receiver per user does
+        if (cfg->meas_ta_en && joint && !pucch_res.ta_valid) {
+          if (srsran_chest_ul_estimate_pucch(&q->chest, ul_sf, cfg, q->sf_symbols[0], &q->chest_res)) {
+            ERROR("Error estimating PUCCH DMRS");
+            return SRSRAN_ERROR;
+          }
           pucch_res.ta_valid = !(isnan(q->chest_res.ta_us) || isinf(q->chest_res.ta_us));
           pucch_res.ta_us    = q->chest_res.ta_us;
         }
@@ -228,17 +268,18 @@ static int get_pucch(srsran_enb_ul_t* q, srsran_ul_sf_cfg_t* ul_sf, srsran_pucch
   return ret;
 }
 
-int srsran_enb_ul_get_pucch(srsran_enb_ul_t*    q,
+static int enb_ul_get_pucch(srsran_enb_ul_t*    q,
                             srsran_ul_sf_cfg_t* ul_sf,
                             srsran_pucch_cfg_t* cfg,
-                            srsran_pucch_res_t* res)
+                            srsran_pucch_res_t* res,
+                            bool                joint)
 {
   if (!srsran_pucch_cfg_isvalid(cfg, q->cell.nof_prb)) {
     ERROR("Invalid PUCCH configuration");
     return SRSRAN_ERROR_INVALID_INPUTS;
   }
 
-  if (get_pucch(q, ul_sf, cfg, res)) {
+  if (get_pucch(q, ul_sf, cfg, res, joint)) {
     return SRSRAN_ERROR;
   }
 
@@ -252,7 +293,7 @@ int srsran_enb_ul_get_pucch(srsran_enb_ul_t*    q,
     srsran_pucch_res_t res_no_sr = {};
 
     // Actual decode without SR
-    if (get_pucch(q, ul_sf, cfg, &res_no_sr)) {
+    if (get_pucch(q, ul_sf, cfg, &res_no_sr, joint)) {
       return SRSRAN_ERROR;
     }
 
@@ -270,12 +311,62 @@ int srsran_enb_ul_get_pucch(srsran_enb_ul_t*    q,
   return SRSRAN_SUCCESS;
 }
 
+int srsran_enb_ul_get_pucch(srsran_enb_ul_t*    q,
+                            srsran_ul_sf_cfg_t* ul_sf,
+                            srsran_pucch_cfg_t* cfg,
+                            srsran_pucch_res_t* res)
+{
+  return enb_ul_get_pucch(q, ul_sf, cfg, res, false);
+}
+
+int srsran_enb_ul_get_pucch_multi(srsran_enb_ul_t*       q,
+                                  srsran_ul_sf_cfg_t*    ul_sf,
+                                  srsran_enb_ul_pucch_t* pucch,
+                                  uint32_t               nof_pucch)
+{
+  if (q == NULL || ul_sf == NULL || (pucch == NULL && nof_pucch > 0)) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // Drop the PRB pairs despread in the previous subframe
+  srsran_pucch_joint_reset(&q->pucch);
+
+  for (uint32_t i = 0; i < nof_pucch; i++) {
+    srsran_pucch_res_t res = {};
+    pucch[i].ret           = enb_ul_get_pucch(q, ul_sf, &pucch[i].cfg, &res, true);
+    pucch[i].res           = res;
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_enb_ul_estimate_pusch(srsran_enb_ul_t* q, srsran_ul_sf_cfg_t* ul_sf, srsran_pusch_cfg_t* cfg)
+{
+  // The antennas are combined during the estimation, the decoder equalizes the combined resource elements
+  if (srsran_chest_ul_estimate_pusch_mrc(
+          &q->chest, ul_sf, cfg, q->sf_symbols, q->nof_rx_ant, q->pusch_symbols, &q->chest_res)) {
+    ERROR("Error estimating PUSCH DMRS");
+    return SRSRAN_ERROR;
+  }
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_enb_ul_decode_pusch(srsran_enb_ul_t*    q,
+                               srsran_ul_sf_cfg_t* ul_sf,
+                               srsran_pusch_cfg_t* cfg,
+                               srsran_pusch_res_t* res)
+{
+  return srsran_pusch_decode(&q->pusch, ul_sf, cfg, &q->chest_res, q->pusch_symbols, res);
+}
+
 int srsran_enb_ul_get_pusch(srsran_enb_ul_t*    q,
                             srsran_ul_sf_cfg_t* ul_sf,
                             srsran_pusch_cfg_t* cfg,
                             srsran_pusch_res_t* res)
 {
-  srsran_chest_ul_estimate_pusch(&q->chest, ul_sf, cfg, q->sf_symbols, &q->chest_res);
+  if (srsran_enb_ul_estimate_pusch(q, ul_sf, cfg)) {
+    return SRSRAN_ERROR;
+  }
 
-  return srsran_pusch_decode(&q->pusch, ul_sf, cfg, &q->chest_res, q->sf_symbols, res);
+  return srsran_enb_ul_decode_pusch(q, ul_sf, cfg, res);
 }
@@ -22,11 +22,34 @@
 #include "srsran/phy/fec/crc.h"
 #include "srsran/phy/utils/bit.h"
 #include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/vector.h"
+#include "crc_fold.h"
 
 #ifdef LV_HAVE_SSE
 #include <immintrin.h>
 #endif // LV_HAVE_SSE
 
+/* Gets the folding kernels matching the carry-less multiplication reported by the vector kernel dispatcher, NULL if the
+ * CPU or the build has none and the lookup table is used.
+ */
+static inline const srsran_crc_fold_table_t* crc_fold(void)
+{
+  switch (srsran_vec_isa_clmul()) {
+#ifdef SRSRAN_VEC_ISA_DISPATCH
+    case SRSRAN_VEC_CLMUL_512:
+      return &srsran_crc_fold_table_vpclmul;
+    case SRSRAN_VEC_CLMUL_128:
+      return &srsran_crc_fold_table_clmul;
+#elif defined(CRC_FOLD_NATIVE)
+    case SRSRAN_VEC_CLMUL_512:
+    case SRSRAN_VEC_CLMUL_128:
+      return &srsran_crc_fold_table_native;
+#endif /* SRSRAN_VEC_ISA_DISPATCH */
+    default:
+      return NULL;
+  }
+}
+
 static void gen_crc_table(srsran_crc_t* h)
 {
   uint32_t pad        = (h->order < 8) ? (8 - h->order) : 0;
@@ -47,6 +70,25 @@ static void gen_crc_table(srsran_crc_t* h)
   }
 }
 
+/* Computes x^(128 + 64 * i) modulo the generator polynomial. Multiplying the two 64-bit halves of a 128-bit block by
+ * these constants moves the block 128 * (i / 2 + 1) bits forward while keeping the remainder of the division.
+ */
+static void gen_fold_constants(srsran_crc_t* h)
+{
+  uint64_t r = 1;
+  uint32_t d = 0;
+  for (uint32_t i = 0; i < 8; i++) {
+    for (; d < 128 + 64 * i; d++) {
+      r <<= 1U;
+      if (r & (h->crchighbit << 1U)) {
+        r ^= (uint64_t)h->polynom;
+      }
+    }
+    h->fold_k[i] = r & h->crcmask;
+  }
+}
+
+
 uint64_t reversecrcbit(uint32_t crc, int nbits, srsran_crc_t* h)
 {
   uint64_t m, rmask = 0x1;
@@ -89,6 +131,9 @@ int srsran_crc_init(srsran_crc_t* h, uint32_t crc_poly, int crc_order)
   // generate lookup table
   gen_crc_table(h);
 
+  // generate folding constants
+  gen_fold_constants(h);
+
   return 0;
 }
 
@@ -107,6 +152,17 @@ uint32_t srsran_crc_checksum(srsran_crc_t* h, uint8_t* data, int len)
     a = 1;
   }
 
+  const srsran_crc_fold_table_t* fold = crc_fold();
+  if (fold != NULL && len8 >= CRC_FOLD_MIN_BYTES) {
+    crc = (uint32_t)fold->checksum_bits(h, data, len);
+
+    // Reverse CRC res8 positions
+    if (a == 1) {
+      crc = reversecrcbit(crc, 8 - res8, h);
+    }
+    return crc;
+  }
+
   // Calculate CRC
   for (i = 0; i < len8 + a; i++) {
     pter = (uint8_t*)(data + 8 * i);
@@ -149,6 +205,11 @@ uint32_t srsran_crc_checksum_byte(srsran_crc_t* h, const uint8_t* data, int len)
   int      i;
   uint32_t crc = 0;
 
+  const srsran_crc_fold_table_t* fold = crc_fold();
+  if (fold != NULL && len / 8 >= CRC_FOLD_MIN_BYTES) {
+    return (uint32_t)fold->checksum_bytes(h, data, len / 8);
+  }
+
   srsran_crc_set_init(h, 0);
 
   // Calculate CRC
@@ -0,0 +1,191 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ *  File:         crc_fold.c
+ *  Description:  CRC folding kernels. Built with the library flags they form
+ *                the native table, which only exists if the flags include
+ *                PCLMUL. With SRSRAN_CRC_FOLD_BUILD_CLMUL or
+ *                SRSRAN_CRC_FOLD_BUILD_VPCLMUL they are built for that
+ *                instruction set instead, the build system compiles this file
+ *                once per instruction set with the matching compiler flags.
+ *****************************************************************************/
+
+#include "crc_fold.h"
+#include "srsran/phy/utils/bit.h"
+#include "srsran/phy/utils/vector.h"
+
+#if defined(SRSRAN_CRC_FOLD_BUILD_VPCLMUL)
+#define CRC_FOLD_CLMUL
+#define CRC_FOLD_VPCLMUL
+#define CRC_FOLD_TABLE srsran_crc_fold_table_vpclmul
+#elif defined(SRSRAN_CRC_FOLD_BUILD_CLMUL)
+#define CRC_FOLD_CLMUL
+#define CRC_FOLD_TABLE srsran_crc_fold_table_clmul
+#elif defined(CRC_FOLD_NATIVE)
+#define CRC_FOLD_CLMUL
+#if defined(LV_HAVE_AVX512) && defined(__VPCLMULQDQ__) && defined(__AVX512BW__)
+#define CRC_FOLD_VPCLMUL
+#endif
+#define CRC_FOLD_TABLE srsran_crc_fold_table_native
+#endif
+
+#ifdef CRC_FOLD_CLMUL
+#include <immintrin.h>
+
+// Number of packed bytes processed at once when the input is one bit per byte
+#define CRC_FOLD_CHUNK_BYTES 256
+
+// Loads a 16-byte block with the first byte in the most significant position, which is the highest polynomial degree
+static inline __m128i crc_fold_load(const uint8_t* ptr)
+{
+  return _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)ptr),
+                          _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+}
+
+// Multiplies the block by the folding constants k, the result is at most 64 + order bits long
+static inline __m128i crc_fold_mul(__m128i a, __m128i k)
+{
+  return _mm_xor_si128(_mm_clmulepi64_si128(a, k, 0x00), _mm_clmulepi64_si128(a, k, 0x11));
+}
+
+static inline __m128i crc_fold_k(const srsran_crc_t* h, uint32_t nof_blocks)
+{
+  return _mm_set_epi64x((long long)h->fold_k[2 * nof_blocks - 1], (long long)h->fold_k[2 * nof_blocks - 2]);
+}
+
+/* Appends nof_blocks 16-byte blocks to the accumulator. The accumulator is congruent, modulo the generator polynomial,
+ * with all the data appended so far.
+ */
+static __m128i crc_fold_blocks(const srsran_crc_t* h, __m128i acc, const uint8_t* data, uint32_t nof_blocks)
+{
+  __m128i  k1 = crc_fold_k(h, 1);
+  uint32_t i  = 0;
+
+#ifdef CRC_FOLD_VPCLMUL
+  if (nof_blocks >= 8) {
+    const __m512i reverse = _mm512_broadcast_i32x4(_mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+    const __m512i k4      = _mm512_broadcast_i32x4(crc_fold_k(h, 4));
+
+    // Four independent lanes, the previous accumulator goes in front of the first one
+    __m512i a = _mm512_shuffle_epi8(_mm512_loadu_si512((const void*)data), reverse);
+    a         = _mm512_xor_si512(a, _mm512_zextsi128_si512(crc_fold_mul(acc, k1)));
+    for (i = 4; i + 4 <= nof_blocks; i += 4) {
+      __m512i b = _mm512_shuffle_epi8(_mm512_loadu_si512((const void*)&data[16 * i]), reverse);
+      a         = _mm512_ternarylogic_epi64(
+          _mm512_clmulepi64_epi128(a, k4, 0x00), _mm512_clmulepi64_epi128(a, k4, 0x11), b, 0x96);
+    }
+
+    // Combine lanes
+    acc = _mm_xor_si128(crc_fold_mul(_mm512_extracti32x4_epi32(a, 0), crc_fold_k(h, 3)),
+                        crc_fold_mul(_mm512_extracti32x4_epi32(a, 1), crc_fold_k(h, 2)));
+    acc = _mm_xor_si128(acc, crc_fold_mul(_mm512_extracti32x4_epi32(a, 2), k1));
+    acc = _mm_xor_si128(acc, _mm512_extracti32x4_epi32(a, 3));
+  }
+#else  // CRC_FOLD_VPCLMUL
+  if (nof_blocks >= 8) {
+    __m128i k4 = crc_fold_k(h, 4);
+
+    // Four independent lanes, the previous accumulator goes in front of the first one
+    __m128i a0 = _mm_xor_si128(crc_fold_load(&data[0]), crc_fold_mul(acc, k1));
+    __m128i a1 = crc_fold_load(&data[16]);
+    __m128i a2 = crc_fold_load(&data[32]);
+    __m128i a3 = crc_fold_load(&data[48]);
+    for (i = 4; i + 4 <= nof_blocks; i += 4) {
+      a0 = _mm_xor_si128(crc_fold_mul(a0, k4), crc_fold_load(&data[16 * i]));
+      a1 = _mm_xor_si128(crc_fold_mul(a1, k4), crc_fold_load(&data[16 * i + 16]));
+      a2 = _mm_xor_si128(crc_fold_mul(a2, k4), crc_fold_load(&data[16 * i + 32]));
+      a3 = _mm_xor_si128(crc_fold_mul(a3, k4), crc_fold_load(&data[16 * i + 48]));
+    }
+
+    // Combine lanes
+    acc = _mm_xor_si128(crc_fold_mul(a0, crc_fold_k(h, 3)), crc_fold_mul(a1, crc_fold_k(h, 2)));
+    acc = _mm_xor_si128(acc, crc_fold_mul(a2, k1));
+    acc = _mm_xor_si128(acc, a3);
+  }
+#endif // CRC_FOLD_VPCLMUL
+
+  for (; i < nof_blocks; i++) {
+    acc = _mm_xor_si128(crc_fold_mul(acc, k1), crc_fold_load(&data[16 * i]));
+  }
+
+  return acc;
+}
+
+// Reduces the accumulator and the remaining bytes with the lookup table
+static uint64_t crc_fold_finish(srsran_crc_t* h, __m128i acc, const uint8_t* tail, uint32_t tail_len)
+{
+  uint8_t buffer[16];
+  _mm_storeu_si128((__m128i*)buffer,
+                   _mm_shuffle_epi8(acc, _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15)));
+
+  srsran_crc_set_init(h, 0);
+  for (uint32_t i = 0; i < 16; i++) {
+    srsran_crc_checksum_put_byte(h, buffer[i]);
+  }
+  for (uint32_t i = 0; i < tail_len; i++) {
+    srsran_crc_checksum_put_byte(h, tail[i]);
+  }
+  return srsran_crc_checksum_get(h);
+}
+
+// Packs bits, one per byte, into bytes with the first bit in the most significant position. nof_bytes must be even
+static void crc_fold_pack(const uint8_t* bits, uint8_t* bytes, uint32_t nof_bytes)
+{
+  const __m128i reverse = _mm_set_epi8(8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7);
+  for (uint32_t i = 0; i < nof_bytes; i += 2) {
+    __m128i  v    = _mm_cmpgt_epi8(_mm_loadu_si128((const __m128i*)&bits[8 * i]), _mm_setzero_si128());
+    uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_shuffle_epi8(v, reverse));
+    bytes[i]      = (uint8_t)(mask & 0xffU);
+    bytes[i + 1]  = (uint8_t)(mask >> 8U);
+  }
+}
+
+static uint64_t crc_fold_checksum_bytes(srsran_crc_t* h, const uint8_t* data, uint32_t nof_bytes)
+{
+  uint32_t nof_blocks = nof_bytes / 16;
+  __m128i  acc        = crc_fold_blocks(h, _mm_setzero_si128(), data, nof_blocks);
+  return crc_fold_finish(h, acc, &data[16 * nof_blocks], nof_bytes % 16);
+}
+
+static uint64_t crc_fold_checksum_bits(srsran_crc_t* h, uint8_t* data, uint32_t nof_bits)
+{
+  uint8_t  chunk[CRC_FOLD_CHUNK_BYTES];
+  uint32_t nof_blocks = nof_bits / 128;
+  __m128i  acc        = _mm_setzero_si128();
+
+  for (uint32_t i = 0; i < nof_blocks;) {
+    uint32_t n = SRSRAN_MIN(nof_blocks - i, CRC_FOLD_CHUNK_BYTES / 16);
+    crc_fold_pack(&data[128 * i], chunk, 16 * n);
+    acc = crc_fold_blocks(h, acc, chunk, n);
+    i += n;
+  }
+
+  // Pack the remaining bits, the spare bits of the last byte are zero
+  uint32_t nof_tail_bits = nof_bits % 128;
+  srsran_bit_pack_vector(&data[128 * nof_blocks], chunk, (int)nof_tail_bits);
+
+  return crc_fold_finish(h, acc, chunk, SRSRAN_CEIL(nof_tail_bits, 8));
+}
+
+const srsran_crc_fold_table_t CRC_FOLD_TABLE = {.checksum_bytes = crc_fold_checksum_bytes,
+                                                .checksum_bits  = crc_fold_checksum_bits};
+#endif // CRC_FOLD_CLMUL
@@ -0,0 +1,59 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ *  File:         crc_fold.h
+ *  Description:  CRC computation folding 128-bit blocks with carry-less
+ *                multiplications. The kernels are built with the library flags
+ *                if they include PCLMUL and, if the ISA dispatch is enabled,
+ *                once more for PCLMUL and for VPCLMULQDQ. crc.c uses the table
+ *                matching the carry-less multiplication reported by the vector
+ *                kernel dispatcher, or the lookup table if there is none.
+ *****************************************************************************/
+
+#ifndef SRSRAN_CRC_FOLD_H
+#define SRSRAN_CRC_FOLD_H
+
+#include "srsran/config.h"
+#include "srsran/phy/fec/crc.h"
+
+// Minimum number of bytes for folding, shorter messages are faster with the lookup table
+#define CRC_FOLD_MIN_BYTES 32
+
+#if defined(LV_HAVE_SSE) && defined(__PCLMUL__) && defined(__SSSE3__)
+#define CRC_FOLD_NATIVE
+#endif
+
+typedef struct {
+  uint64_t (*checksum_bytes)(srsran_crc_t* h, const uint8_t* data, uint32_t nof_bytes);
+  uint64_t (*checksum_bits)(srsran_crc_t* h, uint8_t* data, uint32_t nof_bits);
+} srsran_crc_fold_table_t;
+
+#ifdef CRC_FOLD_NATIVE
+extern const srsran_crc_fold_table_t srsran_crc_fold_table_native;
+#endif /* CRC_FOLD_NATIVE */
+
+#ifdef SRSRAN_VEC_ISA_DISPATCH
+extern const srsran_crc_fold_table_t srsran_crc_fold_table_clmul;
+extern const srsran_crc_fold_table_t srsran_crc_fold_table_vpclmul;
+#endif /* SRSRAN_VEC_ISA_DISPATCH */
+
+#endif // SRSRAN_CRC_FOLD_H
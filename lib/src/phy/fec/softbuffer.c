@@ -177,6 +177,18 @@ void srsran_softbuffer_rx_reset_cb_crc(srsran_softbuffer_rx_t* q, uint32_t nof_c
   SRSRAN_MEM_ZERO(q->cb_crc, bool, SRSRAN_MIN(q->max_cb, nof_cb));
 }
 
+size_t srsran_softbuffer_rx_mem_size(const srsran_softbuffer_rx_t* q)
+{
+  if (q == NULL) {
+    return 0;
+  }
+
+  // Pointer and CRC arrays followed by the soft bits and the decoded data of each code block
+  size_t cb_size = sizeof(int16_t*) + sizeof(uint8_t*) + sizeof(bool) + q->max_cb_size * sizeof(int16_t) +
+                   q->max_cb_size / 8 * sizeof(uint8_t);
+  return sizeof(srsran_softbuffer_rx_t) + q->max_cb * cb_size;
+}
+
 int srsran_softbuffer_tx_init(srsran_softbuffer_tx_t* q, uint32_t nof_prb)
 {
   int ret = srsran_ra_tbs_from_idx(SRSRAN_RA_NOF_TBS_IDX - 1, nof_prb);
@@ -239,6 +251,16 @@ void srsran_softbuffer_tx_free(srsran_softbuffer_tx_t* q)
   }
 }
 
+size_t srsran_softbuffer_tx_mem_size(const srsran_softbuffer_tx_t* q)
+{
+  if (q == NULL) {
+    return 0;
+  }
+
+  // Pointer array followed by the encoded bits of each code block
+  return sizeof(srsran_softbuffer_tx_t) + q->max_cb * (sizeof(uint8_t*) + q->max_cb_size * sizeof(uint8_t));
+}
+
 void srsran_softbuffer_tx_reset_tbs(srsran_softbuffer_tx_t* q, uint32_t tbs)
 {
   uint32_t nof_cb = (tbs + 24) / (SRSRAN_TCOD_MAX_LEN_CB - 24) + 1;
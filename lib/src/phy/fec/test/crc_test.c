@@ -24,6 +24,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <strings.h>
+#include <sys/time.h>
 #include <time.h>
 #include <unistd.h>
 
@@ -71,6 +72,77 @@ void parse_args(int argc, char** argv)
   }
 }
 
+// Bit-serial CRC used as reference, data is one bit per byte
+static uint32_t crc_reference(const uint8_t* bits, int len)
+{
+  uint64_t crc  = 0;
+  uint64_t mask = ((uint64_t)1 << crc_length) - 1;
+  for (int i = 0; i < len; i++) {
+    bool feedback = (((crc >> (crc_length - 1)) & 1U) ^ bits[i]) != 0;
+    crc           = (crc << 1U) & mask;
+    if (feedback) {
+      crc ^= crc_poly & mask;
+    }
+  }
+  return (uint32_t)crc;
+}
+
+// Compares the packed and unpacked checksums against the reference for all lengths up to num_bits
+static int test_lengths(srsran_crc_t* crc_p, uint8_t* data, uint8_t* data_packed)
+{
+  for (int len = 0; len <= num_bits; len++) {
+    uint32_t expected = crc_reference(data, len);
+
+    uint32_t crc_word = srsran_crc_checksum(crc_p, data, len);
+    if (crc_word != expected) {
+      ERROR("Unpacked checksum mismatch for %d bits (%x != %x)", len, crc_word, expected);
+      return SRSRAN_ERROR;
+    }
+
+    if (len % 8 == 0) {
+      srsran_bit_pack_vector(data, data_packed, len);
+      crc_word = srsran_crc_checksum_byte(crc_p, data_packed, len);
+      if (crc_word != expected) {
+        ERROR("Packed checksum mismatch for %d bits (%x != %x)", len, crc_word, expected);
+        return SRSRAN_ERROR;
+      }
+    }
+  }
+  return SRSRAN_SUCCESS;
+}
+
+// Measures the throughput of the packed and unpacked checksums
+static void benchmark(srsran_crc_t* crc_p, uint8_t* data, uint8_t* data_packed)
+{
+  uint32_t       nof_repetitions = 10000;
+  struct timeval t[3];
+  uint32_t       nbytes = (uint32_t)num_bits / 8;
+
+  srsran_bit_pack_vector(data, data_packed, num_bits);
+
+  gettimeofday(&t[1], NULL);
+  for (uint32_t i = 0; i < nof_repetitions; i++) {
+    srsran_crc_checksum_byte(crc_p, data_packed, nbytes * 8);
+  }
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+  double packed_us = t[0].tv_sec * 1e6 + t[0].tv_usec;
+
+  gettimeofday(&t[1], NULL);
+  for (uint32_t i = 0; i < nof_repetitions; i++) {
+    srsran_crc_checksum(crc_p, data, num_bits);
+  }
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+  double unpacked_us = t[0].tv_sec * 1e6 + t[0].tv_usec;
+
+  printf("CRC%d %d bits: packed %.2f GB/s; unpacked %.2f Gbit/s\n",
+         crc_length,
+         num_bits,
+         (double)nbytes * nof_repetitions / packed_us / 1e3,
+         (double)num_bits * nof_repetitions / unpacked_us / 1e3);
+}
+
 int main(int argc, char** argv)
 {
   int          i;
@@ -111,7 +183,20 @@ int main(int argc, char** argv)
 
   INFO("checksum=%x", crc_word);
 
+  uint8_t* data_packed = srsran_vec_u8_malloc(num_bits / 8 + 1);
+  if (!data_packed) {
+    perror("malloc");
+    exit(-1);
+  }
+
+  if (test_lengths(&crc_p, data, data_packed)) {
+    exit(-1);
+  }
+
+  benchmark(&crc_p, data, data_packed);
+
   free(data);
+  free(data_packed);
 
   // check if generated word is as expected
   if (get_expected_word(num_bits, crc_length, crc_poly, seed, &expected_word)) {
@@ -20,6 +20,7 @@
  */
 
 #include <math.h>
+#include <pthread.h>
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -79,6 +80,7 @@ static srsran_bit_interleaver_t bit_interleavers_parity_bits[192];
 static uint16_t                 deinterleaver[192][4][18448];
 static int                      k0_vec[SRSRAN_NOF_TC_CB_SIZES][4][2];
 static bool                     rm_turbo_tables_generated = false;
+static pthread_mutex_t          rm_turbo_tables_mutex     = PTHREAD_MUTEX_INITIALIZER;
 
 // Store deinterleaver version for sub-block turbo decoder
 #if SRSRAN_TDEC_EXPECT_INPUT_SB == 1
@@ -275,8 +277,9 @@ static void interleave_table_sb(uint16_t* in, uint16_t* out, uint32_t cb_idx, ui
 
 void srsran_rm_turbo_gentables()
 {
+  // The tables are shared by all the objects, which may be initialised from different threads
+  pthread_mutex_lock(&rm_turbo_tables_mutex);
   if (!rm_turbo_tables_generated) {
-    rm_turbo_tables_generated = true;
     for (int cb_idx = 0; cb_idx < SRSRAN_NOF_TC_CB_SIZES; cb_idx++) {
       int cb_len = srsran_cbsegm_cbsize(cb_idx);
       int in_len = 3 * cb_len + 12;
@@ -313,11 +316,14 @@ void srsran_rm_turbo_gentables()
 #endif
       }
     }
+    rm_turbo_tables_generated = true;
   }
+  pthread_mutex_unlock(&rm_turbo_tables_mutex);
 }
 
 void srsran_rm_turbo_free_tables()
 {
+  pthread_mutex_lock(&rm_turbo_tables_mutex);
   if (rm_turbo_tables_generated) {
     for (int i = 0; i < SRSRAN_NOF_TC_CB_SIZES; i++) {
       srsran_bit_interleaver_free(&bit_interleavers_systematic_bits[i]);
@@ -326,6 +332,7 @@ void srsran_rm_turbo_free_tables()
     rm_turbo_tables_generated = false;
   }
   rm_turbo_tables_generated = false;
+  pthread_mutex_unlock(&rm_turbo_tables_mutex);
 }
 
 /**
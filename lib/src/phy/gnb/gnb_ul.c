@@ -175,13 +175,12 @@ int srsran_gnb_ul_fft(srsran_gnb_ul_t* q)
   return SRSRAN_SUCCESS;
 }
 
-int srsran_gnb_ul_get_pusch(srsran_gnb_ul_t*             q,
-                            const srsran_slot_cfg_t*     slot_cfg,
-                            const srsran_sch_cfg_nr_t*   cfg,
-                            const srsran_sch_grant_nr_t* grant,
-                            srsran_pusch_res_nr_t*       data)
+int srsran_gnb_ul_estimate_pusch(srsran_gnb_ul_t*             q,
+                                 const srsran_slot_cfg_t*     slot_cfg,
+                                 const srsran_sch_cfg_nr_t*   cfg,
+                                 const srsran_sch_grant_nr_t* grant)
 {
-  if (q == NULL || cfg == NULL || grant == NULL || data == NULL) {
+  if (q == NULL || cfg == NULL || grant == NULL) {
     return SRSRAN_ERROR_INVALID_INPUTS;
   }
 
@@ -189,6 +188,18 @@ int srsran_gnb_ul_get_pusch(srsran_gnb_ul_t*             q,
     return SRSRAN_ERROR;
   }
 
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_gnb_ul_decode_pusch(srsran_gnb_ul_t*             q,
+                               const srsran_sch_cfg_nr_t*   cfg,
+                               const srsran_sch_grant_nr_t* grant,
+                               srsran_pusch_res_nr_t*       data)
+{
+  if (q == NULL || cfg == NULL || grant == NULL || data == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
   // Check PUSCH DMRS minimum SNR and abort PUSCH decoding if it is below the threshold
   if (q->dmrs.csi.snr_dB < q->pusch_min_snr_dB) {
     // Set PUSCH data as not decoded
@@ -205,6 +216,23 @@ int srsran_gnb_ul_get_pusch(srsran_gnb_ul_t*             q,
   return SRSRAN_SUCCESS;
 }
 
+int srsran_gnb_ul_get_pusch(srsran_gnb_ul_t*             q,
+                            const srsran_slot_cfg_t*     slot_cfg,
+                            const srsran_sch_cfg_nr_t*   cfg,
+                            const srsran_sch_grant_nr_t* grant,
+                            srsran_pusch_res_nr_t*       data)
+{
+  if (q == NULL || cfg == NULL || grant == NULL || data == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  if (srsran_gnb_ul_estimate_pusch(q, slot_cfg, cfg, grant) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
+  return srsran_gnb_ul_decode_pusch(q, cfg, grant, data);
+}
+
 static int gnb_ul_decode_pucch_format1(srsran_gnb_ul_t*                    q,
                                        const srsran_slot_cfg_t*            slot_cfg,
                                        const srsran_pucch_nr_common_cfg_t* cfg,
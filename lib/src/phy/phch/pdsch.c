@@ -253,6 +253,103 @@ int srsran_pdsch_get(srsran_pdsch_t*       q,
   return srsran_pdsch_cp(q, sf_symbols, symbols, grant, lstart, subframe, false);
 }
 
+/* Selects the PDSCH RE mask of a subframe: SF 0 (PBCH and SS), SF 5 (SS), SF 1/6 in TDD (PSS) and the rest */
+static inline uint32_t pdsch_re_mask_idx(const srsran_cell_t* cell, uint32_t sf_idx)
+{
+  if (sf_idx == 0) {
+    return 0;
+  }
+  if (sf_idx == 5) {
+    return 1;
+  }
+  if (cell->frame_type == SRSRAN_TDD && (sf_idx == 1 || sf_idx == 6)) {
+    return 2;
+  }
+  return 3;
+}
+
+/**
+ * Computes the PDSCH RE masks of every subframe type. Bit k of a mask is set if RE k of the PRB carries PDSCH when the
+ * PRB is allocated. The masks are obtained by mapping a full allocation with complete slots using the generic copy, so
+ * the RE order matches srsran_pdsch_put()
+ */
+static void pdsch_re_mask_init(srsran_pdsch_t* q)
+{
+  const uint32_t sf_idx[SRSRAN_PDSCH_NOF_RE_MASKS] = {0, 5, 1, 2};
+  uint32_t       nof_symb                          = SRSRAN_CP_NSYMB(q->cell.cp);
+  uint32_t       nof_prb_sf                        = SRSRAN_NOF_SLOTS_PER_SF * nof_symb * q->cell.nof_prb;
+
+  srsran_pdsch_grant_t grant;
+  bzero(&grant, sizeof(srsran_pdsch_grant_t));
+  for (uint32_t s = 0; s < SRSRAN_NOF_SLOTS_PER_SF; s++) {
+    grant.nof_symb_slot[s] = nof_symb;
+    for (uint32_t n = 0; n < q->cell.nof_prb; n++) {
+      grant.prb_idx[s][n] = true;
+    }
+  }
+
+  // The symbol buffers are only used as scratch, they hold one subframe of the cell
+  cf_t* ones = q->symbols[0];
+  cf_t* grid = q->symbols[1];
+  for (uint32_t i = 0; i < nof_prb_sf * SRSRAN_NRE; i++) {
+    ones[i] = 1.0f;
+  }
+
+  for (uint32_t t = 0; t < SRSRAN_PDSCH_NOF_RE_MASKS; t++) {
+    srsran_vec_cf_zero(grid, nof_prb_sf * SRSRAN_NRE);
+    srsran_pdsch_cp(q, ones, grid, &grant, 0, sf_idx[t], true);
+
+    for (uint32_t i = 0; i < nof_prb_sf; i++) {
+      uint16_t mask = 0;
+      for (uint32_t k = 0; k < SRSRAN_NRE; k++) {
+        if (grid[i * SRSRAN_NRE + k] != 0.0f) {
+          mask |= (uint16_t)(1U << k);
+        }
+      }
+      q->re_mask[t][i] = mask;
+    }
+  }
+}
+
+/* Writes the grid index of every PDSCH RE of the grant in q->re_idx, in mapping order. Returns the number of RE */
+static uint32_t
+pdsch_re_idx_build(srsran_pdsch_t* q, const srsran_pdsch_grant_t* grant, uint32_t lstart_grant, uint32_t sf_idx)
+{
+  const uint16_t* re_mask   = q->re_mask[pdsch_re_mask_idx(&q->cell, sf_idx)];
+  const uint16_t  full_mask = (1U << SRSRAN_NRE) - 1;
+  uint32_t        count     = 0;
+
+  for (uint32_t s = 0; s < SRSRAN_NOF_SLOTS_PER_SF; s++) {
+    uint32_t lstart = (s == 0) ? lstart_grant : 0;
+
+    for (uint32_t l = lstart; l < grant->nof_symb_slot[s]; l++) {
+      uint32_t lp = l + s * grant->nof_symb_slot[0];
+
+      for (uint32_t n = 0; n < q->cell.nof_prb; n++) {
+        if (!grant->prb_idx[s][n]) {
+          continue;
+        }
+
+        uint32_t prb_idx = lp * q->cell.nof_prb + n;
+        uint16_t mask    = re_mask[prb_idx];
+        if (mask == full_mask) {
+          for (uint32_t k = 0; k < SRSRAN_NRE; k++) {
+            q->re_idx[count++] = prb_idx * SRSRAN_NRE + k;
+          }
+        } else {
+          for (uint32_t k = 0; k < SRSRAN_NRE; k++) {
+            if (mask & (1U << k)) {
+              q->re_idx[count++] = prb_idx * SRSRAN_NRE + k;
+            }
+          }
+        }
+      }
+    }
+  }
+
+  return count;
+}
+
 /** Initializes the PDSCH transmitter and receiver */
 static int pdsch_init(srsran_pdsch_t* q, uint32_t max_prb, bool is_ue, uint32_t nof_antennas)
 {
@@ -292,6 +389,14 @@ static int pdsch_init(srsran_pdsch_t* q, uint32_t max_prb, bool is_ue, uint32_t
         goto clean;
       }
 
+      // The UE only receives with its C-RNTI
+      if (srsran_sequence_cache_init(&q->seq_cache[i],
+                                     is_ue ? 1 : SRSRAN_SEQUENCE_CACHE_NOF_USERS,
+                                     SRSRAN_NOF_SF_X_FRAME,
+                                     q->max_re * srsran_mod_bits_x_symbol(SRSRAN_MOD_256QAM))) {
+        goto clean;
+      }
+
       // If it is the UE, allocate EVM buffer, for only minimum PRB
       if (is_ue) {
         q->evm_buffer[i] = srsran_evm_buffer_alloc(srsran_ra_tbs_from_idx(SRSRAN_RA_NOF_TBS_IDX - 1, 6));
@@ -330,6 +435,20 @@ static int pdsch_init(srsran_pdsch_t* q, uint32_t max_prb, bool is_ue, uint32_t
       }
     }
 
+    // The transmitter maps the PDSCH straight into the grid, one mask per subframe type
+    if (!is_ue) {
+      for (int i = 0; i < SRSRAN_PDSCH_NOF_RE_MASKS; i++) {
+        q->re_mask[i] = srsran_vec_u16_malloc(q->max_re / SRSRAN_NRE);
+        if (!q->re_mask[i]) {
+          goto clean;
+        }
+      }
+      q->re_idx = srsran_vec_u32_malloc(q->max_re);
+      if (!q->re_idx) {
+        goto clean;
+      }
+    }
+
     ret = SRSRAN_SUCCESS;
   }
 
@@ -429,6 +548,8 @@ void srsran_pdsch_free(srsran_pdsch_t* q)
     if (q->evm_buffer[i]) {
       srsran_evm_free(q->evm_buffer[i]);
     }
+
+    srsran_sequence_cache_free(&q->seq_cache[i]);
   }
 
   /* Free sch objects */
@@ -450,6 +571,15 @@ void srsran_pdsch_free(srsran_pdsch_t* q)
     }
   }
 
+  for (int i = 0; i < SRSRAN_PDSCH_NOF_RE_MASKS; i++) {
+    if (q->re_mask[i]) {
+      free(q->re_mask[i]);
+    }
+  }
+  if (q->re_idx) {
+    free(q->re_idx);
+  }
+
   for (int i = 0; i < SRSRAN_MOD_NITEMS; i++) {
     srsran_modem_table_free(&q->mod[i]);
   }
@@ -470,6 +600,8 @@ int srsran_pdsch_set_cell(srsran_pdsch_t* q, srsran_cell_t cell)
       for (int i = 0; i < SRSRAN_MAX_CODEWORDS; i++) {
         srsran_evm_buffer_resize(q->evm_buffer[i], srsran_ra_tbs_from_idx(SRSRAN_RA_NOF_TBS_IDX - 1, cell.nof_prb));
       }
+    } else {
+      pdsch_re_mask_init(q);
     }
 
     INFO("PDSCH: Cell config PCI=%d, %d ports, %d PRBs, max_symbols: %d",
@@ -483,6 +615,28 @@ int srsran_pdsch_set_cell(srsran_pdsch_t* q, srsran_cell_t cell)
   return ret;
 }
 
+void srsran_pdsch_release_rnti(srsran_pdsch_t* q, uint16_t rnti)
+{
+  if (q == NULL) {
+    return;
+  }
+
+  for (int i = 0; i < SRSRAN_MAX_CODEWORDS; i++) {
+    srsran_sequence_cache_release(&q->seq_cache[i], rnti);
+  }
+}
+
+void srsran_pdsch_set_nof_users(srsran_pdsch_t* q, uint32_t nof_users)
+{
+  if (q == NULL) {
+    return;
+  }
+
+  for (int i = 0; i < SRSRAN_MAX_CODEWORDS; i++) {
+    srsran_sequence_cache_set_nof_users(&q->seq_cache[i], nof_users);
+  }
+}
+
 static float apply_power_allocation(srsran_pdsch_t* q, srsran_pdsch_cfg_t* cfg, cf_t* sf_symbols_m[SRSRAN_MAX_PORTS])
 {
   uint32_t nof_symbols_slot = cfg->grant.nof_symb_slot[0];
@@ -715,21 +869,23 @@ static int srsran_pdsch_codeword_decode(srsran_pdsch_t*     q,
 
     /* Bit scrambling */
     if (q->llr_is_8bit) {
-      srsran_sequence_pdsch_apply_c(q->e[codeword_idx],
-                                    q->e[codeword_idx],
-                                    cfg->rnti,
-                                    codeword_idx,
-                                    2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME),
-                                    q->cell.id,
-                                    cfg->grant.tb[tb_idx].nof_bits);
+      srsran_sequence_pdsch_cache_apply_c(&q->seq_cache[codeword_idx],
+                                          q->e[codeword_idx],
+                                          q->e[codeword_idx],
+                                          cfg->rnti,
+                                          codeword_idx,
+                                          2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME),
+                                          q->cell.id,
+                                          cfg->grant.tb[tb_idx].nof_bits);
     } else {
-      srsran_sequence_pdsch_apply_s(q->e[codeword_idx],
-                                    q->e[codeword_idx],
-                                    cfg->rnti,
-                                    codeword_idx,
-                                    2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME),
-                                    q->cell.id,
-                                    cfg->grant.tb[tb_idx].nof_bits);
+      srsran_sequence_pdsch_cache_apply_s(&q->seq_cache[codeword_idx],
+                                          q->e[codeword_idx],
+                                          q->e[codeword_idx],
+                                          cfg->rnti,
+                                          codeword_idx,
+                                          2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME),
+                                          q->cell.id,
+                                          cfg->grant.tb[tb_idx].nof_bits);
     }
 
     if (cfg->csi_enable) {
@@ -995,13 +1151,14 @@ static int srsran_pdsch_codeword_encode(srsran_pdsch_t*         q,
     }
 
     /* Bit scrambling */
-    srsran_sequence_pdsch_apply_pack((uint8_t*)q->e[codeword_idx],
-                                     (uint8_t*)q->e[codeword_idx],
-                                     cfg->rnti,
-                                     codeword_idx,
-                                     2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME),
-                                     q->cell.id,
-                                     cfg->grant.tb[tb_idx].nof_bits);
+    srsran_sequence_pdsch_cache_apply_pack(&q->seq_cache[codeword_idx],
+                                           (uint8_t*)q->e[codeword_idx],
+                                           (uint8_t*)q->e[codeword_idx],
+                                           cfg->rnti,
+                                           codeword_idx,
+                                           2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME),
+                                           q->cell.id,
+                                           cfg->grant.tb[tb_idx].nof_bits);
 
     /* Bit mapping */
     srsran_mod_modulate_bytes(
@@ -1014,6 +1171,329 @@ static int srsran_pdsch_codeword_encode(srsran_pdsch_t*         q,
   return SRSRAN_SUCCESS;
 }
 
+/* Transmission on a single antenna port */
+static void pdsch_fused_port0(const cf_t* d, const uint32_t* re_idx, uint32_t nof_re, float scaling, cf_t* y)
+{
+  for (uint32_t k = 0; k < nof_re; k++) {
+    y[re_idx[k]] = d[k] * scaling;
+  }
+}
+
+/* Transmit diversity on 2 ports, each pair of symbols is sent in two consecutive PDSCH RE (36.211 6.3.4.3) */
+static void pdsch_fused_diversity2(const cf_t*     d,
+                                   const uint32_t* re_idx,
+                                   uint32_t        nof_re,
+                                   float           scaling,
+                                   cf_t*           y[SRSRAN_MAX_PORTS])
+{
+  scaling *= M_SQRT1_2;
+
+  cf_t* y0 = y[0];
+  cf_t* y1 = y[1];
+
+  uint32_t k = 0;
+  for (; k + 1 < nof_re; k += 2) {
+    cf_t x0 = d[k] * scaling;
+    cf_t x1 = d[k + 1] * scaling;
+
+    y0[re_idx[k]]     = x0;
+    y1[re_idx[k]]     = -conjf(x1);
+    y0[re_idx[k + 1]] = x1;
+    y1[re_idx[k + 1]] = conjf(x0);
+  }
+
+  // A trailing RE without pair is not transmitted
+  for (; k < nof_re; k++) {
+    y0[re_idx[k]] = 0.0f;
+    y1[re_idx[k]] = 0.0f;
+  }
+}
+
+/* Transmit diversity on 4 ports, each group of 4 symbols is sent in four consecutive PDSCH RE (36.211 6.3.4.3) */
+static void pdsch_fused_diversity4(const cf_t*     d,
+                                   const uint32_t* re_idx,
+                                   uint32_t        nof_re,
+                                   float           scaling,
+                                   cf_t*           y[SRSRAN_MAX_PORTS])
+{
+  scaling /= M_SQRT2;
+
+  cf_t* y0 = y[0];
+  cf_t* y1 = y[1];
+  cf_t* y2 = y[2];
+  cf_t* y3 = y[3];
+
+  uint32_t k = 0;
+  for (; k + 3 < nof_re; k += 4) {
+    cf_t x0 = d[k] * scaling;
+    cf_t x1 = d[k + 1] * scaling;
+    cf_t x2 = d[k + 2] * scaling;
+    cf_t x3 = d[k + 3] * scaling;
+
+    uint32_t i0 = re_idx[k];
+    uint32_t i1 = re_idx[k + 1];
+    uint32_t i2 = re_idx[k + 2];
+    uint32_t i3 = re_idx[k + 3];
+
+    y0[i0] = x0;
+    y1[i0] = 0.0f;
+    y2[i0] = -conjf(x1);
+    y3[i0] = 0.0f;
+
+    y0[i1] = x1;
+    y1[i1] = 0.0f;
+    y2[i1] = conjf(x0);
+    y3[i1] = 0.0f;
+
+    y0[i2] = 0.0f;
+    y1[i2] = x2;
+    y2[i2] = 0.0f;
+    y3[i2] = -conjf(x3);
+
+    y0[i3] = 0.0f;
+    y1[i3] = x3;
+    y2[i3] = 0.0f;
+    y3[i3] = conjf(x2);
+  }
+
+  // Trailing RE without a complete group are not transmitted
+  for (; k < nof_re; k++) {
+    y0[re_idx[k]] = 0.0f;
+    y1[re_idx[k]] = 0.0f;
+    y2[re_idx[k]] = 0.0f;
+    y3[re_idx[k]] = 0.0f;
+  }
+}
+
+/* Precoding of 1 or 2 layers on 2 ports: y_p(k) = c_p (a_p(k) x_0(k) + b_p(k) x_1(k)), where c_p is either 1 or j and
+ * the real weights a_p, b_p depend on the parity of k (large delay CDD) */
+typedef struct {
+  float a[2][2]; /* [parity][port] */
+  float b[2][2]; /* [parity][port] */
+  bool  mul_j[2];
+} pdsch_fused_2x2_w_t;
+
+/* Returns false if the combination is not supported by srsran_precoding_type() */
+static bool pdsch_fused_2x2_weights(srsran_tx_scheme_t   type,
+                                    uint32_t             nof_layers,
+                                    uint32_t             codebook_idx,
+                                    float                scaling,
+                                    pdsch_fused_2x2_w_t* w)
+{
+  float s2 = scaling * M_SQRT1_2;
+  float s4 = scaling / 2.0f;
+
+  bzero(w, sizeof(pdsch_fused_2x2_w_t));
+
+  if (type == SRSRAN_TXSCHEME_CDD && nof_layers == 2) {
+    for (uint32_t p = 0; p < 2; p++) {
+      w->a[p][0] = s4;
+      w->b[p][0] = s4;
+      w->a[p][1] = (p == 0) ? s4 : -s4;
+      w->b[p][1] = (p == 0) ? -s4 : s4;
+    }
+    return true;
+  }
+
+  if (type != SRSRAN_TXSCHEME_SPATIALMUX) {
+    return false;
+  }
+
+  float a[2] = {0.0f, 0.0f};
+  float b[2] = {0.0f, 0.0f};
+  if (nof_layers == 1) {
+    if (codebook_idx > 3) {
+      return false;
+    }
+    a[0]        = s2;
+    a[1]        = (codebook_idx % 2 == 0) ? s2 : -s2;
+    w->mul_j[1] = codebook_idx >= 2;
+  } else if (nof_layers == 2) {
+    switch (codebook_idx) {
+      case 0:
+        a[0] = s2;
+        b[1] = s2;
+        break;
+      case 1:
+      case 2:
+        a[0]        = s4;
+        b[0]        = s4;
+        a[1]        = s4;
+        b[1]        = -s4;
+        w->mul_j[1] = codebook_idx == 2;
+        break;
+      default:
+        return false;
+    }
+  } else {
+    return false;
+  }
+
+  for (uint32_t p = 0; p < 2; p++) {
+    for (uint32_t port = 0; port < 2; port++) {
+      w->a[p][port] = a[port];
+      w->b[p][port] = b[port];
+    }
+  }
+  return true;
+}
+
+static inline cf_t pdsch_fused_2x2_sym(float a, float b, bool mul_j, cf_t x0, cf_t x1)
+{
+  float re = a * __real__ x0 + b * __real__ x1;
+  float im = a * __imag__ x0 + b * __imag__ x1;
+  cf_t  v;
+  __real__ v = mul_j ? -im : re;
+  __imag__ v = mul_j ? re : im;
+  return v;
+}
+
+static void pdsch_fused_2x2(const cf_t*                x0,
+                            const cf_t*                x1,
+                            const uint32_t*            re_idx,
+                            uint32_t                   nof_re,
+                            const pdsch_fused_2x2_w_t* w,
+                            cf_t*                      y[SRSRAN_MAX_PORTS])
+{
+  // Local copies, the weights cannot be aliased by the grid
+  pdsch_fused_2x2_w_t c  = *w;
+  cf_t*               y0 = y[0];
+  cf_t*               y1 = y[1];
+
+  uint32_t k = 0;
+  for (; k + 1 < nof_re; k += 2) {
+    uint32_t i0 = re_idx[k];
+    uint32_t i1 = re_idx[k + 1];
+    y0[i0]      = pdsch_fused_2x2_sym(c.a[0][0], c.b[0][0], c.mul_j[0], x0[k], x1[k]);
+    y1[i0]      = pdsch_fused_2x2_sym(c.a[0][1], c.b[0][1], c.mul_j[1], x0[k], x1[k]);
+    y0[i1]      = pdsch_fused_2x2_sym(c.a[1][0], c.b[1][0], c.mul_j[0], x0[k + 1], x1[k + 1]);
+    y1[i1]      = pdsch_fused_2x2_sym(c.a[1][1], c.b[1][1], c.mul_j[1], x0[k + 1], x1[k + 1]);
+  }
+  if (k < nof_re) {
+    y0[re_idx[k]] = pdsch_fused_2x2_sym(c.a[0][0], c.b[0][0], c.mul_j[0], x0[k], x1[k]);
+    y1[re_idx[k]] = pdsch_fused_2x2_sym(c.a[0][1], c.b[0][1], c.mul_j[1], x0[k], x1[k]);
+  }
+}
+
+/**
+ * Layer mapping, precoding and mapping to resource elements in a single pass, the modulated symbols are written
+ * straight into the grid of every port using the PDSCH RE masks.
+ *
+ * Returns SRSRAN_ERROR without modifying the grid if the configuration is not supported, the caller shall use the
+ * generic chain instead
+ */
+static int pdsch_encode_fused(srsran_pdsch_t*     q,
+                              srsran_pdsch_cfg_t* cfg,
+                              uint32_t            nof_tb,
+                              float               scaling,
+                              uint32_t            lstart,
+                              uint32_t            sf_idx,
+                              cf_t*               sf_symbols[SRSRAN_MAX_PORTS])
+{
+  srsran_pdsch_grant_t* grant      = &cfg->grant;
+  uint32_t              nof_ports  = q->cell.nof_ports;
+  uint32_t              nof_layers = grant->nof_layers;
+  pdsch_fused_2x2_w_t   w;
+
+  // The masks assume complete slots (not DwPTS)
+  if (q->re_idx == NULL || grant->nof_symb_slot[0] != SRSRAN_CP_NSYMB(q->cell.cp) ||
+      grant->nof_symb_slot[1] != SRSRAN_CP_NSYMB(q->cell.cp)) {
+    return SRSRAN_ERROR;
+  }
+
+  bool diversity = nof_ports > 1 && grant->tx_scheme == SRSRAN_TXSCHEME_DIVERSITY;
+  if (diversity) {
+    if (nof_tb != 1 || nof_layers != nof_ports) {
+      return SRSRAN_ERROR;
+    }
+  } else if (nof_ports == 2) {
+    uint32_t codebook_idx = nof_tb == 1 ? grant->pmi : (grant->pmi + 1);
+    if (nof_layers != nof_tb || !pdsch_fused_2x2_weights(grant->tx_scheme, nof_layers, codebook_idx, scaling, &w)) {
+      return SRSRAN_ERROR;
+    }
+  } else if (nof_ports != 1) {
+    return SRSRAN_ERROR;
+  }
+
+  uint32_t nof_re = pdsch_re_idx_build(q, grant, lstart, sf_idx);
+  if (nof_re != grant->nof_re) {
+    return SRSRAN_ERROR;
+  }
+
+  if (nof_ports == 1) {
+    pdsch_fused_port0(q->d[0], q->re_idx, nof_re, scaling, sf_symbols[0]);
+  } else if (diversity && nof_ports == 2) {
+    pdsch_fused_diversity2(q->d[0], q->re_idx, nof_re, scaling, sf_symbols);
+  } else if (diversity) {
+    pdsch_fused_diversity4(q->d[0], q->re_idx, nof_re, scaling, sf_symbols);
+  } else {
+    pdsch_fused_2x2(q->d[0], nof_layers == 2 ? q->d[1] : q->d[0], q->re_idx, nof_re, &w, sf_symbols);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+/* Layer mapping, precoding and mapping to resource elements through intermediate buffers */
+static void pdsch_encode_generic(srsran_pdsch_t*     q,
+                                 srsran_pdsch_cfg_t* cfg,
+                                 uint32_t            nof_tb,
+                                 float               scaling,
+                                 uint32_t            lstart,
+                                 uint32_t            sf_idx,
+                                 cf_t*               sf_symbols[SRSRAN_MAX_PORTS])
+{
+  int i;
+  /* Set pointers for layermapping & precoding */
+  cf_t* x[SRSRAN_MAX_LAYERS];
+
+  // Layer mapping & precode if necessary
+  if (q->cell.nof_ports > 1) {
+    int nof_symbols;
+    /* If number of layers is equal to transport blocks (codewords) skip layer mapping */
+    if (cfg->grant.nof_layers == nof_tb) {
+      for (i = 0; i < cfg->grant.nof_layers; i++) {
+        x[i] = q->d[i];
+      }
+      nof_symbols = cfg->grant.nof_re;
+    } else {
+      /* Initialise layer map pointers */
+      for (i = 0; i < cfg->grant.nof_layers; i++) {
+        x[i] = q->x[i];
+      }
+      memset(&x[cfg->grant.nof_layers], 0, sizeof(cf_t*) * (SRSRAN_MAX_LAYERS - cfg->grant.nof_layers));
+
+      nof_symbols = srsran_layermap_type(q->d,
+                                         x,
+                                         nof_tb,
+                                         cfg->grant.nof_layers,
+                                         (int[SRSRAN_MAX_CODEWORDS]){cfg->grant.nof_re, cfg->grant.nof_re},
+                                         cfg->grant.tx_scheme);
+    }
+
+    /* Precode */
+    uint32_t codebook_idx = nof_tb == 1 ? cfg->grant.pmi : (cfg->grant.pmi + 1);
+    srsran_precoding_type(x,
+                          q->symbols,
+                          cfg->grant.nof_layers,
+                          q->cell.nof_ports,
+                          codebook_idx,
+                          nof_symbols,
+                          scaling,
+                          cfg->grant.tx_scheme);
+  } else {
+    if (scaling == 1.0f) {
+      memcpy(q->symbols[0], q->d[0], cfg->grant.nof_re * sizeof(cf_t));
+    } else {
+      srsran_vec_sc_prod_cfc(q->d[0], scaling, q->symbols[0], cfg->grant.nof_re);
+    }
+  }
+
+  /* mapping to resource elements */
+  for (i = 0; i < q->cell.nof_ports; i++) {
+    srsran_pdsch_put(q, q->symbols[i], sf_symbols[i], &cfg->grant, lstart, sf_idx);
+  }
+}
+
 int srsran_pdsch_encode(srsran_pdsch_t*     q,
                         srsran_dl_sf_cfg_t* sf,
                         srsran_pdsch_cfg_t* cfg,
@@ -1021,9 +1501,7 @@ int srsran_pdsch_encode(srsran_pdsch_t*     q,
                         cf_t*               sf_symbols[SRSRAN_MAX_PORTS])
 {
   int i;
-  /* Set pointers for layermapping & precoding */
-  cf_t* x[SRSRAN_MAX_LAYERS];
-  int   ret = SRSRAN_ERROR_INVALID_INPUTS;
+  int ret = SRSRAN_ERROR_INVALID_INPUTS;
 
   if (q != NULL && cfg != NULL) {
     struct timeval t[3];
@@ -1081,52 +1559,10 @@ int srsran_pdsch_encode(srsran_pdsch_t*     q,
            srsran_mimotype2str(cfg->grant.tx_scheme));
     }
 
-    // Layer mapping & precode if necessary
-    if (q->cell.nof_ports > 1) {
-      int nof_symbols;
-      /* If number of layers is equal to transport blocks (codewords) skip layer mapping */
-      if (cfg->grant.nof_layers == nof_tb) {
-        for (i = 0; i < cfg->grant.nof_layers; i++) {
-          x[i] = q->d[i];
-        }
-        nof_symbols = cfg->grant.nof_re;
-      } else {
-        /* Initialise layer map pointers */
-        for (i = 0; i < cfg->grant.nof_layers; i++) {
-          x[i] = q->x[i];
-        }
-        memset(&x[cfg->grant.nof_layers], 0, sizeof(cf_t*) * (SRSRAN_MAX_LAYERS - cfg->grant.nof_layers));
-
-        nof_symbols = srsran_layermap_type(q->d,
-                                           x,
-                                           nof_tb,
-                                           cfg->grant.nof_layers,
-                                           (int[SRSRAN_MAX_CODEWORDS]){cfg->grant.nof_re, cfg->grant.nof_re},
-                                           cfg->grant.tx_scheme);
-      }
-
-      /* Precode */
-      uint32_t codebook_idx = nof_tb == 1 ? cfg->grant.pmi : (cfg->grant.pmi + 1);
-      srsran_precoding_type(x,
-                            q->symbols,
-                            cfg->grant.nof_layers,
-                            q->cell.nof_ports,
-                            codebook_idx,
-                            nof_symbols,
-                            scaling,
-                            cfg->grant.tx_scheme);
-    } else {
-      if (scaling == 1.0f) {
-        memcpy(q->symbols[0], q->d[0], cfg->grant.nof_re * sizeof(cf_t));
-      } else {
-        srsran_vec_sc_prod_cfc(q->d[0], scaling, q->symbols[0], cfg->grant.nof_re);
-      }
-    }
-
-    /* mapping to resource elements */
+    /* Layer mapping, precoding and mapping to resource elements */
     uint32_t lstart = SRSRAN_NOF_CTRL_SYMBOLS(q->cell, sf->cfi);
-    for (i = 0; i < q->cell.nof_ports; i++) {
-      srsran_pdsch_put(q, q->symbols[i], sf_symbols[i], &cfg->grant, lstart, sf->tti % 10);
+    if (pdsch_encode_fused(q, cfg, nof_tb, scaling, lstart, sf->tti % 10, sf_symbols) != SRSRAN_SUCCESS) {
+      pdsch_encode_generic(q, cfg, nof_tb, scaling, lstart, sf->tti % 10, sf_symbols);
     }
 
     if (cfg->meas_time_en) {
@@ -71,6 +71,13 @@ int pdsch_nr_init_common(srsran_pdsch_nr_t* q, const srsran_pdsch_nr_args_t* arg
     return SRSRAN_ERROR;
   }
 
+  for (uint32_t cw = 0; cw < SRSRAN_MAX_CODEWORDS; cw++) {
+    if (srsran_sequence_cache_init(
+            &q->seq_cache[cw], SRSRAN_SEQUENCE_CACHE_NOF_USERS, 1, SRSRAN_SLOT_MAX_NOF_BITS_NR) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+  }
+
   return SRSRAN_SUCCESS;
 }
 
@@ -179,6 +186,8 @@ void srsran_pdsch_nr_free(srsran_pdsch_nr_t* q)
     if (q->d[cw]) {
       free(q->d[cw]);
     }
+
+    srsran_sequence_cache_free(&q->seq_cache[cw]);
   }
 
   srsran_sch_nr_free(&q->sch);
@@ -337,7 +346,8 @@ static inline int pdsch_nr_encode_codeword(srsran_pdsch_nr_t*         q,
 
   // 7.3.1.1 Scrambling
   uint32_t cinit = pdsch_nr_cinit(&q->carrier, cfg, rnti, tb->cw_idx);
-  srsran_sequence_apply_bit(q->b[tb->cw_idx], q->b[tb->cw_idx], tb->nof_bits, cinit);
+  srsran_sequence_cache_apply_bit(
+      &q->seq_cache[tb->cw_idx], q->b[tb->cw_idx], q->b[tb->cw_idx], tb->nof_bits, rnti, 0, cinit);
 
   // 7.3.1.2 Modulation
   srsran_mod_modulate(&q->modem_tables[tb->mod], q->b[tb->cw_idx], q->d[tb->cw_idx], tb->nof_bits);
@@ -467,7 +477,8 @@ static inline int pdsch_nr_decode_codeword(srsran_pdsch_nr_t*         q,
   srsran_vec_neg_bb(llr, llr, tb->nof_bits);
 
   // Descrambling
-  srsran_sequence_apply_c(llr, llr, tb->nof_bits, pdsch_nr_cinit(&q->carrier, cfg, rnti, tb->cw_idx));
+  uint32_t cinit = pdsch_nr_cinit(&q->carrier, cfg, rnti, tb->cw_idx);
+  srsran_sequence_cache_apply_c(&q->seq_cache[tb->cw_idx], llr, llr, tb->nof_bits, rnti, 0, cinit);
 
   if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_DEBUG && !is_handler_registered()) {
     DEBUG("b=");
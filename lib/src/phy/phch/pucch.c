@@ -23,6 +23,7 @@
 #include "srsran/srsran.h"
 #include <assert.h>
 #include <complex.h>
+#include <float.h>
 #include <math.h>
 #include <stdbool.h>
 #include <stdint.h>
@@ -69,6 +70,19 @@ int srsran_pucch_init_(srsran_pucch_t* q, bool is_ue)
 
     if (!q->is_ue) {
       q->ce = srsran_vec_cf_malloc(SRSRAN_PUCCH_MAX_SYMBOLS);
+
+      q->prb = SRSRAN_MEM_ALLOC(srsran_pucch_prb_t, SRSRAN_MAX_PRB);
+      if (!q->prb) {
+        goto clean_exit;
+      }
+      srsran_pucch_joint_reset(q);
+
+      // DFT matrix for despreading all the cyclic shifts at once
+      for (uint32_t n = 0; n < SRSRAN_NRE; n++) {
+        for (uint32_t k = 0; k < SRSRAN_NRE; k++) {
+          q->dft[n][k] = cexpf(-I * 2.0f * (float)M_PI * (float)((n * k) % SRSRAN_NRE) / (float)SRSRAN_NRE);
+        }
+      }
     }
 
     ret = SRSRAN_SUCCESS;
@@ -104,6 +118,9 @@ void srsran_pucch_free(srsran_pucch_t* q)
   if (q->ce) {
     free(q->ce);
   }
+  if (q->prb) {
+    free(q->prb);
+  }
 
   srsran_modem_table_free(&q->mod);
   bzero(q, sizeof(srsran_pucch_t));
@@ -871,6 +888,301 @@ int srsran_pucch_decode(srsran_pucch_t*        q,
   return ret;
 }
 
+void srsran_pucch_joint_reset(srsran_pucch_t* q)
+{
+  if (q != NULL && q->prb != NULL) {
+    for (uint32_t m = 0; m < SRSRAN_MAX_PRB; m++) {
+      q->prb[m].valid = false;
+    }
+  }
+}
+
+/* Removes the base sequence from the PRB pair of the resource and despreads all its cyclic shifts */
+static int pucch_joint_prb(srsran_pucch_t*     q,
+                           srsran_ul_sf_cfg_t* sf,
+                           srsran_pucch_cfg_t* cfg,
+                           cf_t*               sf_symbols,
+                           srsran_pucch_prb_t* prb)
+{
+  uint32_t nsymbols  = SRSRAN_CP_NSYMB(q->cell.cp);
+  uint32_t sf_idx    = sf->tti % SRSRAN_NOF_SF_X_FRAME;
+  float    noise     = 0.0f;
+  uint32_t nof_noise = 0;
+
+  for (uint32_t s = 0; s < SRSRAN_NOF_SLOTS_PER_SF; s++) {
+    uint32_t ns = SRSRAN_NOF_SLOTS_PER_SF * sf_idx + s;
+
+    // Determine n_prb
+    uint32_t n_prb = srsran_pucch_n_prb(&q->cell, cfg, s);
+    if (n_prb >= q->cell.nof_prb) {
+      ERROR("Invalid PUCCH n_prb=%d", n_prb);
+      return SRSRAN_ERROR;
+    }
+
+    // Get group hopping number u and its base sequence
+    uint32_t f_gh = 0;
+    if (cfg->group_hopping_en) {
+      f_gh = q->f_gh[ns];
+    }
+    uint32_t u = (f_gh + (q->cell.id % 30)) % 30;
+
+    cf_t r_uv[SRSRAN_NRE];
+    if (srsran_zc_sequence_generate_lte(u, 0, 0.0f, 1, r_uv) < SRSRAN_SUCCESS) {
+      ERROR("Error generating PUCCH base sequence");
+      return SRSRAN_ERROR;
+    }
+
+    for (uint32_t l = 0; l < nsymbols; l++) {
+      cf_t z[SRSRAN_NRE];
+      srsran_vec_prod_conj_ccc(
+          &sf_symbols[SRSRAN_RE_IDX(q->cell.nof_prb, l + s * nsymbols, n_prb * SRSRAN_NRE)], r_uv, z, SRSRAN_NRE);
+
+      for (uint32_t n = 0; n < SRSRAN_NRE; n++) {
+        prb->bins[s][l][n] = srsran_vec_dot_prod_ccc(z, q->dft[n], SRSRAN_NRE);
+      }
+    }
+
+    // The data of a slot without SRS is spread by one of the first three orthogonal sequences of length 4. The fourth
+    // sequence is not used by any resource, so whatever it despreads is noise and interference
+    if (get_N_sf(SRSRAN_PUCCH_FORMAT_1, s, sf->shortened) == 4) {
+      for (uint32_t k = 0; k < SRSRAN_NRE; k++) {
+        cf_t e = 0.0f;
+        for (uint32_t i = 0; i < 4; i++) {
+          uint32_t l = get_pucch_symbol(i, SRSRAN_PUCCH_FORMAT_1, q->cell.cp);
+          e += pucch3_w_n_oc_4[2][i] * prb->bins[s][l][(q->n_cs_cell[ns][l] + k) % SRSRAN_NRE];
+        }
+        noise += __real__ e * __real__ e + __imag__ e * __imag__ e;
+      }
+      nof_noise += SRSRAN_NRE;
+    }
+  }
+
+  // Every despread value accumulates the noise of SRSRAN_NRE subcarriers and 4 symbols
+  prb->noise = noise / (float)(nof_noise * SRSRAN_NRE * 4);
+
+  return SRSRAN_SUCCESS;
+}
+
+static uint32_t pucch_joint_n_cs(float alpha)
+{
+  return (uint32_t)roundf(alpha * SRSRAN_NRE / (2.0f * (float)M_PI)) % SRSRAN_NRE;
+}
+
+// Cyclic shifts around the one of the resource that hold its time alignment: the shift itself and the adjacent ones
+#define PUCCH_JOINT_TA_NOF_BINS 3
+
+/* The resources of an orthogonal sequence are spaced delta_pucch_shift cyclic shifts, so the shifts adjacent to a
+ * resource only carry users of other orthogonal sequences, which are removed by the despreading, if the spacing is two
+ * or more. The PRB pair shared with format 2 is excluded, format 2 users are not orthogonally spread */
+static bool pucch_joint_ta_isolated(const srsran_pucch_cfg_t* cfg, srsran_cp_t cp)
+{
+  uint32_t c = SRSRAN_CP_ISNORM(cp) ? 3 : 2;
+  return cfg->delta_pucch_shift > 1 && cfg->n_pucch >= c * cfg->N_cs / cfg->delta_pucch_shift;
+}
+
+/* Estimates the time alignment error of a resource, in normalised frequency, from the DMRS despread in its own cyclic
+ * shift and the adjacent ones. A delay of a fraction of cyclic shift moves part of the resource energy to the adjacent
+ * shifts, the fraction is interpolated from the three of them (Candan's estimator for rectangular windows). It is only
+ * valid if the adjacent shifts are not used by other resources, see pucch_joint_ta_isolated(), and the resource shift
+ * holds the peak, otherwise it returns false */
+static bool pucch_joint_ta(const cf_t taps[SRSRAN_NOF_SLOTS_PER_SF][PUCCH_JOINT_TA_NOF_BINS], float* ta)
+{
+  float num                             = 0.0f;
+  float den                             = 0.0f;
+  float energy[PUCCH_JOINT_TA_NOF_BINS] = {};
+  for (uint32_t s = 0; s < SRSRAN_NOF_SLOTS_PER_SF; s++) {
+    cf_t diff = taps[s][0] - taps[s][2];
+    cf_t curv = 2.0f * taps[s][1] - taps[s][0] - taps[s][2];
+    num += crealf(diff * conjf(curv));
+    den += crealf(curv * conjf(curv));
+    for (uint32_t d = 0; d < PUCCH_JOINT_TA_NOF_BINS; d++) {
+      energy[d] += crealf(taps[s][d] * conjf(taps[s][d]));
+    }
+  }
+
+  // A delay of more than half cyclic shift moves the peak out of the resource shift and the interpolation aliases
+  if (!isnormal(den) || energy[1] < energy[0] || energy[1] < energy[2]) {
+    return false;
+  }
+
+  // The delay moves the peak towards the negative shifts, one shift is a delay of 1 / SRSRAN_NRE
+  float bias_corr = tanf((float)M_PI / SRSRAN_NRE) / ((float)M_PI / SRSRAN_NRE);
+  *ta             = -bias_corr * (num / den) / (float)SRSRAN_NRE;
+  return true;
+}
+
+int srsran_pucch_decode_joint(srsran_pucch_t*     q,
+                              srsran_ul_sf_cfg_t* sf,
+                              srsran_pucch_cfg_t* cfg,
+                              cf_t*               sf_symbols,
+                              srsran_pucch_res_t* data)
+{
+  if (q == NULL || sf == NULL || cfg == NULL || sf_symbols == NULL || data == NULL || q->prb == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  if (cfg->format != SRSRAN_PUCCH_FORMAT_1 && cfg->format != SRSRAN_PUCCH_FORMAT_1A &&
+      cfg->format != SRSRAN_PUCCH_FORMAT_1B) {
+    ERROR("PUCCH %s not supported by the joint detection", srsran_pucch_format_text(cfg->format));
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // Despread the PRB pair if no other resource did it before
+  uint32_t m = srsran_pucch_m(cfg, q->cell.cp);
+  if (m >= SRSRAN_MAX_PRB) {
+    ERROR("Invalid PUCCH m=%d", m);
+    return SRSRAN_ERROR;
+  }
+  srsran_pucch_prb_t* prb = &q->prb[m];
+  if (!prb->valid || prb->group_hopping_en != cfg->group_hopping_en) {
+    if (pucch_joint_prb(q, sf, cfg, sf_symbols, prb) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+    prb->group_hopping_en = cfg->group_hopping_en;
+    prb->valid            = true;
+  }
+
+  uint32_t n_rs   = srsran_refsignal_dmrs_N_rs(cfg->format, q->cell.cp);
+  uint32_t sf_idx = sf->tti % SRSRAN_NOF_SF_X_FRAME;
+  uint32_t nof_re = 0;
+
+  cf_t     h[SRSRAN_NOF_SLOTS_PER_SF]      = {}; // Channel estimate of each slot
+  cf_t     c[SRSRAN_NOF_SLOTS_PER_SF]      = {}; // Despread data of each slot
+  float    energy[SRSRAN_NOF_SLOTS_PER_SF] = {}; // Despread data energy of each slot
+  uint32_t n_data[SRSRAN_NOF_SLOTS_PER_SF] = {}; // Number of data symbols of each slot
+  cf_t     taps[SRSRAN_NOF_SLOTS_PER_SF][PUCCH_JOINT_TA_NOF_BINS] = {}; // Despread pilots around the resource shift
+
+  for (uint32_t s = 0; s < SRSRAN_NOF_SLOTS_PER_SF; s++) {
+    uint32_t ns = SRSRAN_NOF_SLOTS_PER_SF * sf_idx + s;
+
+    // Pick the cyclic shift of the resource in every DMRS symbol and remove the orthogonal sequence
+    for (uint32_t i = 0; i < n_rs; i++) {
+      uint32_t l    = srsran_refsignal_dmrs_pucch_symbol(i, cfg->format, q->cell.cp);
+      uint32_t n_oc = 0;
+      uint32_t n_cs =
+          pucch_joint_n_cs(srsran_pucch_alpha_format1(q->n_cs_cell, cfg, q->cell.cp, true, ns, l, &n_oc, NULL));
+      cf_t w = cexpf(I * srsran_refsignal_dmrs_pucch_format1_w_arg(i, n_oc, q->cell.cp));
+
+      h[s] += conjf(w) * prb->bins[s][l][n_cs];
+
+      for (uint32_t d = 0; d < PUCCH_JOINT_TA_NOF_BINS; d++) {
+        taps[s][d] += conjf(w) * prb->bins[s][l][(n_cs + SRSRAN_NRE + d - PUCCH_JOINT_TA_NOF_BINS / 2) % SRSRAN_NRE];
+      }
+    }
+    h[s] /= (float)(n_rs * SRSRAN_NRE);
+
+    // Same for the data symbols
+    uint32_t N_sf      = get_N_sf(cfg->format, s, sf->shortened);
+    uint32_t N_sf_widx = N_sf == 3 ? 1 : 0;
+    for (uint32_t i = 0; i < N_sf; i++) {
+      uint32_t l          = get_pucch_symbol(i, cfg->format, q->cell.cp);
+      uint32_t n_oc       = 0;
+      uint32_t n_prime_ns = 0;
+      uint32_t n_cs       = pucch_joint_n_cs(
+          srsran_pucch_alpha_format1(q->n_cs_cell, cfg, q->cell.cp, true, ns, l, &n_oc, &n_prime_ns));
+      float S_ns = 0;
+      if (n_prime_ns % 2) {
+        S_ns = M_PI / 2;
+      }
+      cf_t w = cexpf(I * (w_n_oc[N_sf_widx][n_oc % 3][i] + S_ns));
+
+      cf_t b = prb->bins[s][l][n_cs];
+      c[s] += conjf(w) * b;
+      energy[s] += (__real__ b * __real__ b + __imag__ b * __imag__ b) / SRSRAN_NRE;
+    }
+    n_data[s] = N_sf;
+    nof_re += N_sf * SRSRAN_NRE;
+  }
+
+  // Measure power, the noise is common to all the resources of the PRB pair
+  float rsrp = 0.0f;
+  for (uint32_t s = 0; s < SRSRAN_NOF_SLOTS_PER_SF; s++) {
+    rsrp += (__real__ h[s] * __real__ h[s] + __imag__ h[s] * __imag__ h[s]) / SRSRAN_NOF_SLOTS_PER_SF;
+  }
+  float noise_estimate = prb->noise;
+  if (fpclassify(noise_estimate) == FP_ZERO) {
+    noise_estimate = FLT_MIN;
+  }
+  data->snr_db = srsran_convert_power_to_dB(rsrp / noise_estimate);
+
+  // The time alignment is left invalid when the adjacent cyclic shifts may hold other users, the caller estimates it
+  // from the channel of the resource instead
+  data->ta_valid = false;
+  float ta_err   = 0.0f;
+  if (cfg->meas_ta_en && pucch_joint_ta_isolated(cfg, q->cell.cp) && pucch_joint_ta(taps, &ta_err)) {
+    ta_err /= 15e3f;                         // Convert from normalized frequency to seconds
+    ta_err *= 1e6f;                          // Convert to micro-seconds
+    ta_err = roundf(ta_err * 10.0f) / 10.0f; // Round to one tenth of micro-second
+
+    data->ta_valid = true;
+    data->ta_us    = ta_err;
+  }
+
+  // Perform DMRS Detection, if enabled. The power of the resource pilots is compared with the noise of a channel
+  // estimate averaged in time only, as the estimate of the detection per resource
+  if (isnormal(cfg->threshold_dmrs_detection)) {
+    data->dmrs_correlation = rsrp / (rsrp + noise_estimate / (float)n_rs);
+
+    // Return not detected if the ratio is 0, NAN, +/- Infinity or below threshold
+    if (!isnormal(data->dmrs_correlation) || data->dmrs_correlation < cfg->threshold_dmrs_detection) {
+      data->correlation = 0.0f;
+      data->detected    = false;
+      return SRSRAN_SUCCESS;
+    }
+  }
+
+  // Equalize the despread data. The correlation with every hypothesis is normalised by the power of the resource
+  // cyclic shift plus the noise of the rest, so the users multiplexed in the same PRB do not reduce the correlation
+  cf_t  y       = 0.0f;
+  float y_power = 0.0f;
+  for (uint32_t s = 0; s < SRSRAN_NOF_SLOTS_PER_SF; s++) {
+    float h_pow = __real__ h[s] * __real__ h[s] + __imag__ h[s] * __imag__ h[s];
+    cf_t  g     = conjf(h[s]) / (h_pow + noise_estimate);
+    y += g * c[s];
+    y_power += (__real__ g * __real__ g + __imag__ g * __imag__ g) *
+               (energy[s] + (float)(n_data[s] * (SRSRAN_NRE - 1)) * noise_estimate);
+  }
+  float norm = sqrtf(y_power * (float)nof_re);
+
+  // Perform ML-decoding
+  uint8_t  pucch_bits[SRSRAN_CQI_MAX_BITS] = {};
+  uint32_t nof_bits                        = srsran_pucch_nof_ack_format(cfg->format);
+  uint32_t i_max                           = 0;
+  float    corr_max                        = -1e9;
+  for (uint32_t i = 0; i < (1U << nof_bits); i++) {
+    for (uint32_t j = 0; j < nof_bits; j++) {
+      pucch_bits[j] = (uint8_t)((i >> (nof_bits - 1 - j)) & 1U);
+    }
+    if (uci_mod_bits(q, sf, cfg, pucch_bits)) {
+      return SRSRAN_ERROR;
+    }
+    float corr = isnormal(norm) ? crealf(conjf(q->d[0]) * y) / norm : 0.0f;
+    if (corr > corr_max) {
+      corr_max = corr;
+      i_max    = i;
+    }
+  }
+  for (uint32_t j = 0; j < nof_bits; j++) {
+    pucch_bits[j] = (uint8_t)((i_max >> (nof_bits - 1 - j)) & 1U);
+  }
+
+  bool pucch_found = (cfg->format == SRSRAN_PUCCH_FORMAT_1) ? (corr_max >= cfg->threshold_format1)
+                                                            : (corr_max > cfg->threshold_format1);
+
+  // Convert bits to UCI data
+  decode_bits(cfg, pucch_found, pucch_bits, cfg->pucch2_drs_bits, &data->uci_data);
+
+  data->detected    = pucch_found;
+  data->correlation = corr_max;
+
+  // Accept ACK only if correlation above threshold
+  if (cfg->format != SRSRAN_PUCCH_FORMAT_1) {
+    data->uci_data.ack.valid = data->correlation > cfg->threshold_data_valid_format1a;
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 char* srsran_pucch_format_text(srsran_pucch_format_t format)
 {
   char* ret = NULL;
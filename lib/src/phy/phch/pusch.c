@@ -94,9 +94,39 @@ static int pusch_cp(srsran_pusch_t*       q,
   }
 }
 
-static int pusch_put(srsran_pusch_t* q, srsran_pusch_grant_t* grant, cf_t* input, cf_t* output, bool is_shortened)
+/* Transform precodes the modulated symbols and writes them directly into the PUSCH RB of the resource grid, it is
+ * equivalent to srsran_dft_precoding followed by the allocation of the precoded symbols in the grid.
+ */
+static int pusch_dft_put(srsran_pusch_t* q, srsran_pusch_grant_t* grant, cf_t* input, cf_t* output, bool is_shortened)
 {
-  return pusch_cp(q, grant, input, output, is_shortened, true);
+  if (grant->L_prb > q->dft_precoding.max_prb || !srsran_dft_precoding_valid_prb(grant->L_prb)) {
+    ERROR("Error invalid number of PRB (%d)", grant->L_prb);
+    return SRSRAN_ERROR;
+  }
+
+  srsran_dft_plan_t* plan  = &q->dft_precoding.dft_plan[grant->L_prb];
+  uint32_t           M_sc  = grant->L_prb * SRSRAN_NRE;
+  uint32_t           count = 0;
+
+  uint32_t L_ref = 3;
+  if (SRSRAN_CP_ISEXT(q->cell.cp)) {
+    L_ref = 2;
+  }
+  for (uint32_t slot = 0; slot < 2; slot++) {
+    uint32_t N_srs = 0;
+    if (is_shortened && slot == 1) {
+      N_srs = 1;
+    }
+    for (uint32_t l = 0; l < SRSRAN_CP_NSYMB(q->cell.cp) - N_srs && count < grant->nof_re; l++) {
+      if (l != L_ref) {
+        uint32_t idx = SRSRAN_RE_IDX(
+            q->cell.nof_prb, l + slot * SRSRAN_CP_NSYMB(q->cell.cp), grant->n_prb_tilde[slot] * SRSRAN_NRE);
+        srsran_dft_run_c(plan, &input[count], &output[idx]);
+        count += M_sc;
+      }
+    }
+  }
+  return count;
 }
 
 static int pusch_get(srsran_pusch_t* q, srsran_pusch_grant_t* grant, cf_t* input, cf_t* output, bool is_shortened)
@@ -160,12 +190,22 @@ static int pusch_init(srsran_pusch_t* q, uint32_t max_prb, bool is_ue)
         ERROR("Allocating EVM buffer");
         goto clean;
       }
+
     }
     q->z = srsran_vec_cf_malloc(q->max_re);
     if (!q->z) {
       goto clean;
     }
 
+    // The UE only transmits with its C-RNTI
+    if (srsran_sequence_cache_init(&q->seq_cache,
+                                   is_ue ? 1 : SRSRAN_SEQUENCE_CACHE_NOF_USERS,
+                                   SRSRAN_NOF_SF_X_FRAME,
+                                   q->max_re * srsran_mod_bits_x_symbol(SRSRAN_MOD_64QAM))) {
+      goto clean;
+    }
+    q->seq_cache_en = is_ue;
+
     ret = SRSRAN_SUCCESS;
   }
 clean:
@@ -207,6 +247,7 @@ void srsran_pusch_free(srsran_pusch_t* q)
   if (q->evm_buffer) {
     srsran_evm_free(q->evm_buffer);
   }
+  srsran_sequence_cache_free(&q->seq_cache);
   srsran_dft_precoding_free(&q->dft_precoding);
 
   for (i = 0; i < SRSRAN_MOD_NITEMS; i++) {
@@ -229,11 +270,29 @@ int srsran_pusch_set_cell(srsran_pusch_t* q, srsran_cell_t cell)
 
     q->cell   = cell;
     q->max_re = cell.nof_prb * MAX_PUSCH_RE(cell.cp);
-    ret       = SRSRAN_SUCCESS;
+    ret = SRSRAN_SUCCESS;
   }
   return ret;
 }
 
+void srsran_pusch_release_rnti(srsran_pusch_t* q, uint16_t rnti)
+{
+  if (q == NULL) {
+    return;
+  }
+
+  srsran_sequence_cache_release(&q->seq_cache, rnti);
+}
+
+void srsran_pusch_set_nof_users(srsran_pusch_t* q, uint32_t nof_users)
+{
+  if (q == NULL) {
+    return;
+  }
+
+  srsran_sequence_cache_set_nof_users(&q->seq_cache, nof_users);
+}
+
 int srsran_pusch_assert_grant(const srsran_pusch_grant_t* grant)
 {
   // Check for valid number of PRB
@@ -304,13 +363,15 @@ int srsran_pusch_encode(srsran_pusch_t*      q,
 
     uint32_t nof_ri_ack_bits = (uint32_t)ret;
 
-    // Run scrambling
-    srsran_sequence_pusch_apply_pack((uint8_t*)q->q,
-                                     (uint8_t*)q->q,
-                                     cfg->rnti,
-                                     2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME),
-                                     q->cell.id,
-                                     cfg->grant.tb.nof_bits);
+    // Run scrambling, the UE generates the sequence of each subframe once
+    uint32_t nslot = 2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME);
+    if (q->seq_cache_en) {
+      srsran_sequence_pusch_cache_apply_pack(
+          &q->seq_cache, (uint8_t*)q->q, (uint8_t*)q->q, cfg->rnti, nslot, q->cell.id, cfg->grant.tb.nof_bits);
+    } else {
+      srsran_sequence_pusch_apply_pack(
+          (uint8_t*)q->q, (uint8_t*)q->q, cfg->rnti, nslot, q->cell.id, cfg->grant.tb.nof_bits);
+    }
 
     // Correct UCI placeholder/repetition bits
     uint8_t* d = q->q;
@@ -333,11 +394,8 @@ int srsran_pusch_encode(srsran_pusch_t*      q,
     // Bit mapping
     srsran_mod_modulate_bytes(&q->mod[cfg->grant.tb.mod], (uint8_t*)q->q, q->d, cfg->grant.tb.nof_bits);
 
-    // DFT precoding
-    srsran_dft_precoding(&q->dft_precoding, q->d, q->z, cfg->grant.L_prb, cfg->grant.nof_symb);
-
-    // Mapping to resource elements
-    uint32_t n = pusch_put(q, &cfg->grant, q->z, sf_symbols, sf->shortened);
+    // DFT precoding and mapping to resource elements
+    int n = pusch_dft_put(q, &cfg->grant, q->d, sf_symbols, sf->shortened);
     if (n != cfg->grant.nof_re) {
       ERROR("Error trying to allocate %d symbols but %d were allocated (tti=%d, short=%d, L=%d)",
             cfg->grant.nof_re,
@@ -433,18 +491,18 @@ int srsran_pusch_decode(srsran_pusch_t*        q,
     }
 
     // Descrambling
+    uint32_t nslot = 2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME);
     if (q->llr_is_8bit) {
-      srsran_sequence_pusch_apply_c(
-          q->q, q->q, cfg->rnti, 2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME), q->cell.id, cfg->grant.tb.nof_bits);
+      srsran_sequence_pusch_cache_apply_c(
+          &q->seq_cache, q->q, q->q, cfg->rnti, nslot, q->cell.id, cfg->grant.tb.nof_bits);
     } else {
-      srsran_sequence_pusch_apply_s(
-          q->q, q->q, cfg->rnti, 2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME), q->cell.id, cfg->grant.tb.nof_bits);
+      srsran_sequence_pusch_cache_apply_s(
+          &q->seq_cache, q->q, q->q, cfg->rnti, nslot, q->cell.id, cfg->grant.tb.nof_bits);
     }
 
     // Generate packed sequence for UCI decoder
     uint8_t* c = (uint8_t*)q->z; // Reuse Z
-    srsran_sequence_pusch_gen_unpack(
-        c, cfg->rnti, 2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME), q->cell.id, cfg->grant.tb.nof_bits);
+    srsran_sequence_pusch_cache_gen_unpack(&q->seq_cache, c, cfg->rnti, nslot, q->cell.id, cfg->grant.tb.nof_bits);
 
     // Set max number of iterations
     srsran_sch_set_max_noi(&q->ul_sch, cfg->max_nof_iterations);
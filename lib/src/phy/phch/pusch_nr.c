@@ -108,6 +108,14 @@ int srsran_pusch_nr_init_ue(srsran_pusch_nr_t* q, const srsran_pusch_nr_args_t*
     return SRSRAN_ERROR;
   }
 
+  // The scrambling sequence does not depend on the slot, so it is kept between transmissions. The UE only transmits
+  // with its C-RNTI
+  for (uint32_t cw = 0; cw < SRSRAN_MAX_CODEWORDS; cw++) {
+    if (srsran_sequence_cache_init(&q->seq_users[cw], 1, 1, SRSRAN_SLOT_MAX_NOF_BITS_NR) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+  }
+
   if (srsran_sch_nr_init_tx(&q->sch, &args->sch)) {
     ERROR("Initialising SCH");
     return SRSRAN_ERROR;
@@ -126,6 +134,14 @@ int srsran_pusch_nr_init_gnb(srsran_pusch_nr_t* q, const srsran_pusch_nr_args_t*
     return SRSRAN_ERROR;
   }
 
+  // The users scrambling sequences do not depend on the slot, keep one per user
+  for (uint32_t cw = 0; cw < SRSRAN_MAX_CODEWORDS; cw++) {
+    if (srsran_sequence_cache_init(
+            &q->seq_users[cw], SRSRAN_SEQUENCE_CACHE_NOF_USERS, 1, SRSRAN_SLOT_MAX_NOF_BITS_NR) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+  }
+
   if (srsran_sch_nr_init_rx(&q->sch, &args->sch) < SRSRAN_SUCCESS) {
     ERROR("Initialising SCH");
     return SRSRAN_ERROR;
@@ -227,6 +243,8 @@ void srsran_pusch_nr_free(srsran_pusch_nr_t* q)
     if (q->d[cw]) {
       free(q->d[cw]);
     }
+
+    srsran_sequence_cache_free(&q->seq_users[cw]);
   }
 
   srsran_sch_nr_free(&q->sch);
@@ -678,7 +696,7 @@ static inline int pusch_nr_encode_codeword(srsran_pusch_nr_t*           q,
 
   // 7.3.1.1 Scrambling
   uint32_t cinit = pusch_nr_cinit(&q->carrier, cfg, rnti, tb->cw_idx);
-  srsran_sequence_apply_bit(b, q->b[tb->cw_idx], nof_bits, cinit);
+  srsran_sequence_cache_apply_bit(&q->seq_users[tb->cw_idx], b, q->b[tb->cw_idx], nof_bits, rnti, 0, cinit);
 
   // Special Scrambling condition
   if (cfg->uci.ack.count <= 2) {
@@ -849,7 +867,8 @@ static inline int pusch_nr_decode_codeword(srsran_pusch_nr_t*         q,
   }
 
   // Descrambling
-  srsran_sequence_apply_c(llr, llr, nof_bits, pusch_nr_cinit(&q->carrier, cfg, rnti, tb->cw_idx));
+  uint32_t cinit = pusch_nr_cinit(&q->carrier, cfg, rnti, tb->cw_idx);
+  srsran_sequence_cache_apply_c(&q->seq_users[tb->cw_idx], llr, llr, nof_bits, rnti, 0, cinit);
 
   if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_DEBUG && !is_handler_registered()) {
     DEBUG("b=");
@@ -113,6 +113,43 @@ void srsran_sequence_pdsch_apply_c(const int8_t* in,
   srsran_sequence_apply_c(in, out, len, sequence_pdsch_seed(rnti, q, nslot, cell_id));
 }
 
+void srsran_sequence_pdsch_cache_apply_pack(srsran_sequence_cache_t* cache,
+                                            const uint8_t*           in,
+                                            uint8_t*                 out,
+                                            uint16_t                 rnti,
+                                            int                      q,
+                                            uint32_t                 nslot,
+                                            uint32_t                 cell_id,
+                                            uint32_t                 len)
+{
+  srsran_sequence_cache_apply_packed(
+      cache, in, out, len, rnti, nslot / 2, sequence_pdsch_seed(rnti, q, nslot, cell_id));
+}
+
+void srsran_sequence_pdsch_cache_apply_s(srsran_sequence_cache_t* cache,
+                                         const int16_t*           in,
+                                         int16_t*                 out,
+                                         uint16_t                 rnti,
+                                         int                      q,
+                                         uint32_t                 nslot,
+                                         uint32_t                 cell_id,
+                                         uint32_t                 len)
+{
+  srsran_sequence_cache_apply_s(cache, in, out, len, rnti, nslot / 2, sequence_pdsch_seed(rnti, q, nslot, cell_id));
+}
+
+void srsran_sequence_pdsch_cache_apply_c(srsran_sequence_cache_t* cache,
+                                         const int8_t*            in,
+                                         int8_t*                  out,
+                                         uint16_t                 rnti,
+                                         int                      q,
+                                         uint32_t                 nslot,
+                                         uint32_t                 cell_id,
+                                         uint32_t                 len)
+{
+  srsran_sequence_cache_apply_c(cache, in, out, len, rnti, nslot / 2, sequence_pdsch_seed(rnti, q, nslot, cell_id));
+}
+
 /**
  * 36.211 5.3.1
  */
@@ -163,6 +200,51 @@ void srsran_sequence_pusch_apply_c(const int8_t* in,
   srsran_sequence_apply_c(in, out, len, sequence_pusch_seed(rnti, nslot, cell_id));
 }
 
+void srsran_sequence_pusch_cache_apply_pack(srsran_sequence_cache_t* cache,
+                                            const uint8_t*           in,
+                                            uint8_t*                 out,
+                                            uint16_t                 rnti,
+                                            uint32_t                 nslot,
+                                            uint32_t                 cell_id,
+                                            uint32_t                 len)
+{
+  srsran_sequence_cache_apply_packed(cache, in, out, len, rnti, nslot / 2, sequence_pusch_seed(rnti, nslot, cell_id));
+}
+
+void srsran_sequence_pusch_cache_apply_c(srsran_sequence_cache_t* cache,
+                                         const int8_t*            in,
+                                         int8_t*                  out,
+                                         uint16_t                 rnti,
+                                         uint32_t                 nslot,
+                                         uint32_t                 cell_id,
+                                         uint32_t                 len)
+{
+  srsran_sequence_cache_apply_c(cache, in, out, len, rnti, nslot / 2, sequence_pusch_seed(rnti, nslot, cell_id));
+}
+
+void srsran_sequence_pusch_cache_apply_s(srsran_sequence_cache_t* cache,
+                                         const int16_t*           in,
+                                         int16_t*                 out,
+                                         uint16_t                 rnti,
+                                         uint32_t                 nslot,
+                                         uint32_t                 cell_id,
+                                         uint32_t                 len)
+{
+  srsran_sequence_cache_apply_s(cache, in, out, len, rnti, nslot / 2, sequence_pusch_seed(rnti, nslot, cell_id));
+}
+
+void srsran_sequence_pusch_cache_gen_unpack(srsran_sequence_cache_t* cache,
+                                            uint8_t*                 out,
+                                            uint16_t                 rnti,
+                                            uint32_t                 nslot,
+                                            uint32_t                 cell_id,
+                                            uint32_t                 len)
+{
+  srsran_vec_u8_zero(out, len);
+
+  srsran_sequence_cache_apply_bit(cache, out, out, len, rnti, nslot / 2, sequence_pusch_seed(rnti, nslot, cell_id));
+}
+
 /**
  * 36.211 5.4.2
  */
@@ -55,10 +55,11 @@ static char*       input_file                   = NULL;
 static int         M                            = 1;
 static bool        enable_256qam                = false;
 static bool        use_8_bit                    = false;
+static uint32_t    nof_tx_ports                 = 2;
 
 void usage(char* prog)
 {
-  printf("Usage: %s [fmMbcsrtRFpnwav] \n", prog);
+  printf("Usage: %s [fmMbcsrtRFpPnwav] \n", prog);
   printf("\t-f read signal from file [Default generate it with pdsch_encode()]\n");
   printf("\t-m MCS [Default %d]\n", mcs[0]);
   printf("\t-M MCS2 [Default %d]\n", mcs[1]);
@@ -73,6 +74,7 @@ void usage(char* prog)
   printf("\t-x Transmission mode [1 to 4] [Default %d]\n", tm + 1);
   printf("\t-n cell.nof_prb [Default %d]\n", cell.nof_prb);
   printf("\t-a nof_rx_antennas [Default %d]\n", nof_rx_antennas);
+  printf("\t-P nof_ports for transmission modes 2 to 4 [Default %d]\n", nof_tx_ports);
   printf("\t-p pmi (multiplex only)  [Default %d]\n", pmi);
   printf("\t-w Swap Transport Blocks\n");
   printf("\t-j Enable PDSCH decoder coworker\n");
@@ -83,7 +85,7 @@ void usage(char* prog)
 void parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "fmMcsbrtRFpnqawvXxj")) != -1) {
+  while ((opt = getopt(argc, argv, "fmMcsbrtRFpPnqawvXxj")) != -1) {
     switch (opt) {
       case 'f':
         input_file = argv[optind];
@@ -130,6 +132,9 @@ void parse_args(int argc, char** argv)
       case 'a':
         nof_rx_antennas = (uint32_t)strtol(argv[optind], NULL, 10);
         break;
+      case 'P':
+        nof_tx_ports = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
       case 'w':
         tb_cw_swap = true;
         break;
@@ -189,14 +194,14 @@ static int check_softbits(srsran_pdsch_t*     pdsch_enb,
 
 int main(int argc, char** argv)
 {
-  int                     ret  = -1;
-  struct timeval          t[3] = {};
-  srsran_softbuffer_tx_t* softbuffers_tx[SRSRAN_MAX_CODEWORDS];
-  bool                    acks[SRSRAN_MAX_CODEWORDS] = {false};
-
-  uint8_t*                data_tx[SRSRAN_MAX_CODEWORDS] = {NULL};
-  uint8_t*                data_rx[SRSRAN_MAX_CODEWORDS] = {NULL};
-  srsran_softbuffer_rx_t* softbuffers_rx[SRSRAN_MAX_CODEWORDS];
+  int                     ret                                  = -1;
+  struct timeval          t[3]                                 = {};
+  srsran_softbuffer_tx_t* softbuffers_tx[SRSRAN_MAX_CODEWORDS] = {NULL};
+  bool                    acks[SRSRAN_MAX_CODEWORDS]           = {false};
+
+  uint8_t*                data_tx[SRSRAN_MAX_CODEWORDS]        = {NULL};
+  uint8_t*                data_rx[SRSRAN_MAX_CODEWORDS]        = {NULL};
+  srsran_softbuffer_rx_t* softbuffers_rx[SRSRAN_MAX_CODEWORDS] = {NULL};
   srsran_pdsch_cfg_t      pdsch_cfg;
   srsran_dl_sf_cfg_t      dl_sf;
   cf_t*                   tx_slot_symbols[SRSRAN_MAX_PORTS];
@@ -235,7 +240,7 @@ int main(int argc, char** argv)
     mcs[1]         = 0;
     rv_idx[1]      = 1;
   } else {
-    cell.nof_ports = 2;
+    cell.nof_ports = nof_tx_ports;
   }
 
   srsran_dci_dl_t dci;
@@ -301,11 +306,12 @@ int main(int argc, char** argv)
   }
 
   for (uint32_t i = 0; i < cell.nof_ports; i++) {
-    tx_slot_symbols[i] = calloc(SRSRAN_NOF_RE(cell), sizeof(cf_t));
+    tx_slot_symbols[i] = srsran_vec_cf_malloc(SRSRAN_NOF_RE(cell));
     if (!tx_slot_symbols[i]) {
       perror("srsran_vec_malloc");
       goto quit;
     }
+    srsran_vec_cf_zero(tx_slot_symbols[i], SRSRAN_NOF_RE(cell));
   }
 
   for (uint32_t i = 0; i < SRSRAN_MAX_TB; i++) {
@@ -343,11 +349,12 @@ int main(int argc, char** argv)
   pdsch_rx.dl_sch.llr_is_8bit = use_8_bit;
 
   for (uint32_t i = 0; i < SRSRAN_MAX_CODEWORDS; i++) {
-    softbuffers_rx[i] = calloc(sizeof(srsran_softbuffer_rx_t), 1);
+    softbuffers_rx[i] = srsran_vec_malloc(sizeof(srsran_softbuffer_rx_t));
     if (!softbuffers_rx[i]) {
       ERROR("Error allocating RX soft buffer");
       goto quit;
     }
+    SRSRAN_MEM_ZERO(softbuffers_rx[i], srsran_softbuffer_rx_t, 1);
 
     if (srsran_softbuffer_rx_init(softbuffers_rx[i], cell.nof_prb)) {
       ERROR("Error initiating RX soft buffer");
@@ -388,10 +395,12 @@ int main(int argc, char** argv)
     }
 
     for (uint32_t i = 0; i < SRSRAN_MAX_CODEWORDS; i++) {
-      softbuffers_tx[i] = calloc(sizeof(srsran_softbuffer_tx_t), 1);
+      softbuffers_tx[i] = srsran_vec_malloc(sizeof(srsran_softbuffer_tx_t));
       if (!softbuffers_tx[i]) {
         ERROR("Error allocating TX soft buffer");
+        goto quit;
       }
+      SRSRAN_MEM_ZERO(softbuffers_tx[i], srsran_softbuffer_tx_t, 1);
 
       if (srsran_softbuffer_tx_init(softbuffers_tx[i], cell.nof_prb)) {
         ERROR("Error initiating TX soft buffer");
@@ -48,6 +48,27 @@
  */
 #define SSB_PBCH_DMRS_DEFAULT_CORR_THR 0.6f
 
+/*
+ * SSB tracking minimum correlation window half length in number of CP lengths
+ */
+#define SSB_TRACK_MIN_WINDOW_NCP 1
+
+/*
+ * SSB tracking correlation window is extended if the correlation peak falls below this fraction of its average
+ */
+#define SSB_TRACK_CORR_DEGRADE 0.5f
+
+/*
+ * SSB tracking statistics Exponential Moving Average (EMA) coefficient
+ */
+#define SSB_TRACK_EMA_ALPHA 0.1f
+
+/*
+ * SSB tracking correlates in time domain while the number of lags times the symbol size stays below this factor times
+ * the cost of a correlation DFT (N log2(N) for the correlation size N). Wider windows use the DFT correlation
+ */
+#define SSB_TRACK_TIME_CORR_MAX_COST 2.0
+
 static int ssb_init_corr(srsran_ssb_t* q)
 {
   // Initialise correlation only if it is enabled
@@ -63,6 +84,12 @@ static int ssb_init_corr(srsran_ssb_t* q)
       ERROR("Malloc");
       return SRSRAN_ERROR;
     }
+
+    q->pss_seq_time[N_id_2] = srsran_vec_cf_malloc(q->max_symbol_sz);
+    if (q->pss_seq_time[N_id_2] == NULL) {
+      ERROR("Malloc");
+      return SRSRAN_ERROR;
+    }
   }
 
   q->sf_buffer = srsran_vec_cf_malloc(q->max_ssb_sz + q->max_sf_sz);
@@ -159,6 +186,9 @@ void srsran_ssb_free(srsran_ssb_t* q)
     if (q->pss_seq[N_id_2] != NULL) {
       free(q->pss_seq[N_id_2]);
     }
+    if (q->pss_seq_time[N_id_2] != NULL) {
+      free(q->pss_seq_time[N_id_2]);
+    }
   }
 
   if (q->sf_buffer != NULL) {
@@ -394,6 +424,9 @@ static int ssb_setup_corr(srsran_ssb_t* q)
     // Modulate symbol with PSS
     ssb_modulate_symbol(q, ssb_grid, SRSRAN_PSS_NR_SYMBOL_IDX);
 
+    // Keep time domain sequence for tracking
+    srsran_vec_cf_copy(q->pss_seq_time[N_id_2], q->tmp_time, q->symbol_sz);
+
     // Convert to frequency domain
     srsran_dft_run_guru_c(&q->fft_corr);
 
@@ -517,6 +550,9 @@ int srsran_ssb_set_cfg(srsran_ssb_t* q, const srsran_ssb_cfg_t* cfg)
     q->cfg.beta_pbch_dmrs = SRSRAN_SSB_DEFAULT_BETA;
   }
 
+  // Reset tracking, the window and statistics depend on the sampling rate
+  SRSRAN_MEM_ZERO(&q->track, srsran_ssb_track_stats_t, 1);
+
   return SRSRAN_SUCCESS;
 }
 
@@ -1138,6 +1174,52 @@ int srsran_ssb_search(srsran_ssb_t* q, const cf_t* in, uint32_t nof_samples, srs
   return SRSRAN_SUCCESS;
 }
 
+static float ssb_pss_corr(srsran_ssb_t* q,
+                          const cf_t*   in,
+                          uint32_t      nof_samples,
+                          uint32_t      t_offset,
+                          uint32_t      N_id_2,
+                          uint32_t      nof_lags,
+                          uint32_t*     peak_idx)
+{
+  // Number of samples taken in this iteration
+  uint32_t n = q->corr_sz;
+
+  // Detect if the correlation input exceeds the input length, take the maximum amount of samples
+  if (t_offset + q->corr_sz > nof_samples) {
+    n = nof_samples - t_offset;
+  }
+
+  // Copy the amount of samples
+  srsran_vec_cf_copy(q->tmp_time, &in[t_offset], n);
+
+  // Append zeros if there is space left
+  if (n < q->corr_sz) {
+    srsran_vec_cf_zero(&q->tmp_time[n], q->corr_sz - n);
+  }
+
+  // Convert to frequency domain
+  srsran_dft_run_guru_c(&q->fft_corr);
+
+  // Actual correlation in frequency domain
+  srsran_vec_prod_conj_ccc(q->tmp_freq, q->pss_seq[N_id_2], q->tmp_corr, q->corr_sz);
+
+  // Convert to time domain
+  srsran_dft_run_guru_c(&q->ifft_corr);
+
+  // Find maximum
+  *peak_idx = srsran_vec_max_abs_ci(q->tmp_time, nof_lags);
+
+  // Average power, return zero correlation if value is invalid (0.0, nan or inf)
+  float avg_pwr_corr = srsran_vec_avg_power_cf(&q->tmp_time[*peak_idx], q->symbol_sz);
+  if (!isnormal(avg_pwr_corr)) {
+    return 0.0f;
+  }
+
+  // Normalise correlation
+  return SRSRAN_CSQABS(q->tmp_time[*peak_idx]) / avg_pwr_corr / sqrtf(SRSRAN_PSS_NR_LEN);
+}
+
 static int ssb_pss_find(srsran_ssb_t* q, const cf_t* in, uint32_t nof_samples, uint32_t N_id_2, uint32_t* found_delay)
 {
   // verify it is initialised
@@ -1152,55 +1234,140 @@ static int ssb_pss_find(srsran_ssb_t* q, const cf_t* in, uint32_t nof_samples, u
   // Delay in correlation window
   uint32_t t_offset = 0;
   while ((t_offset + q->symbol_sz) < nof_samples) {
-    // Number of samples taken in this iteration
-    uint32_t n = q->corr_sz;
+    // Correlate and find the peak in the window, invalid windows result in zero correlation
+    uint32_t peak_idx = 0;
+    float    corr     = ssb_pss_corr(q, in, nof_samples, t_offset, N_id_2, q->corr_window, &peak_idx);
 
-    // Detect if the correlation input exceeds the input length, take the maximum amount of samples
-    if (t_offset + q->corr_sz > nof_samples) {
-      n = nof_samples - t_offset;
+    // Update if the correlation is better than the current best
+    if (best_corr < corr) {
+      best_corr  = corr;
+      best_delay = peak_idx + t_offset;
     }
 
-    // Copy the amount of samples
-    srsran_vec_cf_copy(q->tmp_time, &in[t_offset], n);
+    // Advance time
+    t_offset += q->corr_window;
+  }
 
-    // Append zeros if there is space left
-    if (n < q->corr_sz) {
-      srsran_vec_cf_zero(&q->tmp_time[n], q->corr_sz - n);
+  // Save findings
+  *found_delay = best_delay;
+
+  return SRSRAN_SUCCESS;
+}
+
+// Correlates the time domain PSS with the input at the lags [t_start, t_start + nof_lags) and returns the normalised
+// correlation peak. It takes nof_lags times symbol_sz operations, which is cheaper than a full correlation DFT for the
+// small windows used while tracking.
+static float ssb_pss_corr_time(srsran_ssb_t* q,
+                               const cf_t*   in,
+                               uint32_t      nof_samples,
+                               uint32_t      t_start,
+                               uint32_t      N_id_2,
+                               uint32_t      nof_lags,
+                               uint32_t*     peak_idx)
+{
+  // Limit the lags to the ones with a whole symbol in the input
+  if (t_start + q->symbol_sz > nof_samples) {
+    *peak_idx = 0;
+    return 0.0f;
+  }
+  nof_lags = SRSRAN_MIN(nof_lags, nof_samples - q->symbol_sz - t_start + 1);
+
+  // Find the lag with the largest correlation magnitude
+  const cf_t* pss       = q->pss_seq_time[N_id_2];
+  float       best_pwr  = 0.0f;
+  cf_t        best_corr = 0.0f;
+  *peak_idx             = 0;
+  for (uint32_t lag = 0; lag < nof_lags; lag++) {
+    cf_t  corr = srsran_vec_dot_prod_conj_ccc(&in[t_start + lag], pss, q->symbol_sz);
+    float pwr  = SRSRAN_CSQABS(corr);
+    if (pwr > best_pwr) {
+      best_pwr  = pwr;
+      best_corr = corr;
+      *peak_idx = lag;
     }
+  }
 
-    // Convert to frequency domain
-    srsran_dft_run_guru_c(&q->fft_corr);
+  // Normalise with the energy of the input and the sequence, return zero correlation if the value is invalid
+  float in_pwr  = srsran_vec_avg_power_cf(&in[t_start + *peak_idx], q->symbol_sz);
+  float pss_pwr = srsran_vec_avg_power_cf(pss, q->symbol_sz);
+  float norm    = in_pwr * pss_pwr * (float)q->symbol_sz * (float)q->symbol_sz;
+  if (!isnormal(norm)) {
+    return 0.0f;
+  }
 
-    // Actual correlation in frequency domain
-    srsran_vec_prod_conj_ccc(q->tmp_freq, q->pss_seq[N_id_2], q->tmp_corr, q->corr_sz);
+  return SRSRAN_CSQABS(best_corr) / norm;
+}
 
-    // Convert to time domain
-    srsran_dft_run_guru_c(&q->ifft_corr);
+// Correlates the PSS at the lags [t_start, t_start + nof_lags), in time domain for narrow windows and with the DFT
+// correlation for wide ones. The peak is normalised as in ssb_pss_corr_time() in both cases, so the tracked average
+// correlation does not depend on the method.
+static float ssb_pss_corr_window(srsran_ssb_t* q,
+                                 const cf_t*   in,
+                                 uint32_t      nof_samples,
+                                 uint32_t      t_start,
+                                 uint32_t      N_id_2,
+                                 uint32_t      nof_lags,
+                                 uint32_t*     peak_idx)
+{
+  double time_cost = (double)nof_lags * (double)q->symbol_sz;
+  double dft_cost  = SSB_TRACK_TIME_CORR_MAX_COST * (double)q->corr_sz * log2((double)q->corr_sz);
+  if (time_cost <= dft_cost || t_start >= nof_samples) {
+    return ssb_pss_corr_time(q, in, nof_samples, t_start, N_id_2, nof_lags, peak_idx);
+  }
 
-    // Find maximum
-    uint32_t peak_idx = srsran_vec_max_abs_ci(q->tmp_time, q->corr_window);
+  // The window fits in the valid lags of the DFT correlation, as it is bounded to the correlation window
+  ssb_pss_corr(q, in, nof_samples, t_start, N_id_2, SRSRAN_MIN(nof_lags, q->corr_window), peak_idx);
 
-    // Average power, skip window if value is invalid (0.0, nan or inf)
-    float avg_pwr_corr = srsran_vec_avg_power_cf(&q->tmp_time[peak_idx], q->symbol_sz);
-    if (!isnormal(avg_pwr_corr)) {
-      continue;
-    }
+  uint32_t unused = 0;
+  return ssb_pss_corr_time(q, in, nof_samples, t_start + *peak_idx, N_id_2, 1, &unused);
+}
 
-    // Normalise correlation
-    float corr = SRSRAN_CSQABS(q->tmp_time[peak_idx]) / avg_pwr_corr / sqrtf(SRSRAN_PSS_NR_LEN);
+static int
+ssb_pss_track(srsran_ssb_t* q, const cf_t* in, uint32_t nof_samples, uint32_t N_id_2, uint32_t t_expected, int* t_drift)
+{
+  // verify it is initialised and the expected position is in the buffer
+  if (q->corr_sz == 0 || t_expected >= nof_samples) {
+    return SRSRAN_ERROR;
+  }
 
-    // Update if the correlation is better than the current best
-    if (best_corr < corr) {
-      best_corr  = corr;
-      best_delay = peak_idx + t_offset;
+  // Select window, bounded to the same delays the full correlation provides
+  uint32_t min_window = SRSRAN_MAX(SSB_TRACK_MIN_WINDOW_NCP * q->cp_sz, 1);
+  uint32_t max_window = SRSRAN_MAX((q->corr_window - 1) / 2, min_window);
+  uint32_t window     = SRSRAN_MIN(SRSRAN_MAX(q->track.window, min_window), max_window);
+
+  float corr  = 0.0f;
+  int   drift = 0;
+  while (true) {
+    // Correlate only around the expected position
+    uint32_t t_start  = (t_expected > window) ? (t_expected - window) : 0;
+    uint32_t nof_lags = t_expected + window + 1 - t_start;
+    uint32_t peak_idx = 0;
+    corr              = ssb_pss_corr_window(q, in, nof_samples, t_start, N_id_2, nof_lags, &peak_idx);
+    drift             = (int)(t_start + peak_idx) - (int)t_expected;
+
+    // Extend the window if the peak is in the border or it degraded, unless it is already the maximum
+    bool border   = (uint32_t)abs(drift) >= window;
+    bool degraded = (q->track.nof_tracks > 0) && (corr < SSB_TRACK_CORR_DEGRADE * q->track.corr);
+    if ((!border && !degraded) || window >= max_window) {
+      break;
     }
+    window = SRSRAN_MIN(2 * window, max_window);
+    q->track.nof_extensions++;
+  }
 
-    // Advance time
-    t_offset += q->corr_window;
+  // Shrink the window back while the peak stays centred
+  if ((uint32_t)abs(drift) < window / 4) {
+    window = SRSRAN_MAX(window / 2, min_window);
   }
 
-  // Save findings
-  *found_delay = best_delay;
+  // Update tracking state
+  float corr_avg           = SRSRAN_VEC_EMA(corr, q->track.corr, SSB_TRACK_EMA_ALPHA);
+  q->track.window          = window;
+  q->track.t_drift_samples = drift;
+  q->track.corr            = (q->track.nof_tracks == 0) ? corr : corr_avg;
+  q->track.nof_tracks++;
+
+  *t_drift = drift;
 
   return SRSRAN_SUCCESS;
 }
@@ -1221,6 +1388,9 @@ int srsran_ssb_find(srsran_ssb_t*                  q,
     return SRSRAN_ERROR;
   }
 
+  // A new search invalidates the tracking window and statistics
+  SRSRAN_MEM_ZERO(&q->track, srsran_ssb_track_stats_t, 1);
+
   // Copy tail from previous execution into the start of this
   srsran_vec_cf_copy(q->sf_buffer, &q->sf_buffer[q->sf_sz], q->ssb_sz);
 
@@ -1301,6 +1471,20 @@ int srsran_ssb_track(srsran_ssb_t*                  q,
   // Calculate SSB offset
   uint32_t t_offset = srsran_ssb_candidate_sf_offset(q, ssb_idx);
 
+  // Correlate PSS around the expected position, the PSS is in the first SSB symbol
+  int t_drift = 0;
+  if (ssb_pss_track(q, sf_buffer, q->sf_sz, SRSRAN_NID_2_NR(N_id), t_offset + q->cp_sz, &t_drift) < SRSRAN_SUCCESS) {
+    ERROR("Error tracking N_id_2");
+    return SRSRAN_ERROR;
+  }
+
+  // Apply drift only if the SSB is still within the subframe
+  if ((int)t_offset + t_drift >= 0 && (int)t_offset + t_drift + (int)q->ssb_sz <= (int)q->sf_sz) {
+    t_offset = (uint32_t)((int)t_offset + t_drift);
+  } else {
+    t_drift = 0;
+  }
+
   // Demodulate
   cf_t ssb_grid[SRSRAN_SSB_NOF_RE] = {};
   if (ssb_demodulate(q, sf_buffer, t_offset, ssb_grid) < SRSRAN_SUCCESS) {
@@ -1320,9 +1504,30 @@ int srsran_ssb_track(srsran_ssb_t*                  q,
     return SRSRAN_ERROR;
   }
 
+  // Add the drift found by the correlation to the measured delay
+  meas->delay_us += (float)(1e6 * (double)t_drift / q->cfg.srate_hz);
+
+  // Average time and frequency drift
+  if (q->track.nof_tracks == 1) {
+    q->track.t_drift_us   = meas->delay_us;
+    q->track.cfo_drift_hz = meas->cfo_hz;
+  } else {
+    q->track.t_drift_us   = SRSRAN_VEC_EMA(meas->delay_us, q->track.t_drift_us, SSB_TRACK_EMA_ALPHA);
+    q->track.cfo_drift_hz = SRSRAN_VEC_EMA(meas->cfo_hz, q->track.cfo_drift_hz, SSB_TRACK_EMA_ALPHA);
+  }
+
   return SRSRAN_SUCCESS;
 }
 
+const srsran_ssb_track_stats_t* srsran_ssb_get_track_stats(const srsran_ssb_t* q)
+{
+  if (q == NULL) {
+    return NULL;
+  }
+
+  return &q->track;
+}
+
 uint32_t srsran_ssb_candidate_sf_idx(const srsran_ssb_t* q, uint32_t ssb_idx, bool half_frame)
 {
   if (q == NULL) {
@@ -43,6 +43,9 @@ static int32_t delay_n       = 1;
 static float   cfo_hz        = 1000.0f;
 static float   n0_dB         = -10.0f;
 
+// Maximum tracking delay measurement error
+#define TRACK_DELAY_MAX_ERROR_US 0.5f
+
 // Test context
 static srsran_random_t       random_gen = NULL;
 static srsran_channel_awgn_t awgn       = {};
@@ -221,6 +224,109 @@ static int test_case_1(srsran_ssb_t* ssb)
   return SRSRAN_SUCCESS;
 }
 
+static int test_case_2(srsran_ssb_t* ssb)
+{
+  // For benchmarking purposes
+  uint64_t t_track_usec = 0;
+
+  // SSB configuration
+  srsran_ssb_cfg_t ssb_cfg = {};
+  ssb_cfg.srate_hz         = srate_hz;
+  ssb_cfg.center_freq_hz   = carrier_freq_hz;
+  ssb_cfg.ssb_freq_hz      = ssb_freq_hz;
+  ssb_cfg.scs              = ssb_scs;
+  ssb_cfg.pattern          = ssb_pattern;
+
+  TESTASSERT(srsran_ssb_set_cfg(ssb, &ssb_cfg) == SRSRAN_SUCCESS);
+
+  // Time drifts in number of CP lengths, the larger ones require extending the tracking window and the largest one
+  // correlating the wide window with the DFT
+  const float drifts[] = {0.0f, 0.1f, 0.3f, -0.2f, 1.5f, 2.5f, -1.5f, 6.0f, 0.0f};
+
+  uint32_t sf_len    = (uint32_t)round(srate_hz / 1000.0);
+  cf_t*    sf_buffer = srsran_vec_cf_malloc(sf_len);
+  TESTASSERT(sf_buffer != NULL);
+
+  // For each PCI...
+  uint64_t count = 0;
+  for (uint32_t pci = 0; pci < SRSRAN_NOF_NID_NR; pci += 101) {
+    for (uint32_t ssb_idx = 0; ssb_idx < ssb->Lmax; ssb_idx++) {
+      // Build PBCH message
+      srsran_pbch_msg_nr_t pbch_msg_tx = {};
+      gen_pbch_msg(&pbch_msg_tx, ssb_idx);
+
+      // Initialise baseband and add the SSB
+      srsran_vec_cf_zero(buffer, hf_len);
+      TESTASSERT(srsran_ssb_add(ssb, pci, &pbch_msg_tx, buffer, buffer) == SRSRAN_SUCCESS);
+
+      // Subframe, expected position of the SSB candidate and actual position of the SSB in the subframe
+      uint32_t sf_idx    = srsran_ssb_candidate_sf_idx(ssb, ssb_idx, false);
+      int      sf_offset = (int)srsran_ssb_candidate_sf_offset(ssb, ssb_idx);
+      int      t_ssb     = (int)round(srsran_symbol_offset_s(ssb->l_first[ssb_idx], ssb_scs) * srate_hz);
+      int      t_bias    = t_ssb - (int)(sf_idx * sf_len) - sf_offset;
+
+      for (uint32_t i = 0; i < sizeof(drifts) / sizeof(drifts[0]); i++) {
+        int drift = (int)roundf(drifts[i] * (float)ssb->cp_sz);
+
+        // Skip drifts that move the SSB out of the subframe
+        if (sf_offset + t_bias + drift < 0 || sf_offset + t_bias + drift + (int)ssb->ssb_sz > (int)sf_len) {
+          continue;
+        }
+
+        // Delay the subframe by the drift
+        for (int n = 0; n < (int)sf_len; n++) {
+          int idx      = (int)(sf_idx * sf_len) + n - drift;
+          sf_buffer[n] = (idx >= 0 && idx < (int)hf_len) ? buffer[idx] : 0.0f;
+        }
+        srsran_channel_awgn_run_c(&awgn, sf_buffer, sf_buffer, sf_len);
+        srsran_vec_sc_prod_ccc(sf_buffer, wideband_gain, sf_buffer, sf_len);
+
+        // Track
+        struct timeval                t[3]        = {};
+        srsran_csi_trs_measurements_t meas        = {};
+        srsran_pbch_msg_nr_t          pbch_msg_rx = {};
+        gettimeofday(&t[1], NULL);
+        TESTASSERT(srsran_ssb_track(ssb, sf_buffer, pci, ssb_idx, 0, &meas, &pbch_msg_rx) == SRSRAN_SUCCESS);
+        gettimeofday(&t[2], NULL);
+        get_time_interval(t);
+        t_track_usec += t[0].tv_usec + t[0].tv_sec * 1000000UL;
+        count++;
+
+        const srsran_ssb_track_stats_t* stats = srsran_ssb_get_track_stats(ssb);
+        INFO("test_case_2 - pci=%d ssb_idx=%d drift=%d bias=%d found=%d window=%d delay_us=%.3f crc=%s",
+             pci,
+             ssb_idx,
+             drift,
+             t_bias,
+             stats->t_drift_samples,
+             stats->window,
+             meas.delay_us,
+             pbch_msg_rx.crc ? "OK" : "KO");
+
+        // Assert PBCH message, the correlation peak (within one sample) and the measured delay
+        TESTASSERT(pbch_msg_rx.crc);
+        TESTASSERT(memcmp(&pbch_msg_rx, &pbch_msg_tx, sizeof(srsran_pbch_msg_nr_t)) == 0);
+        TESTASSERT(abs(stats->t_drift_samples - (drift + t_bias)) <= 1);
+        TESTASSERT(fabsf(meas.delay_us - (float)(1e6 * (drift + t_bias) / srate_hz)) < TRACK_DELAY_MAX_ERROR_US);
+      }
+    }
+  }
+
+  // The largest drifts must have extended the window
+  TESTASSERT(srsran_ssb_get_track_stats(ssb)->nof_extensions > 0);
+
+  free(sf_buffer);
+
+  if (!count) {
+    ERROR("Error in test case 2: undefined division");
+    return SRSRAN_ERROR;
+  }
+
+  INFO("test_case_2 - %.1f usec/track;", (double)t_track_usec / (double)(count));
+
+  return SRSRAN_SUCCESS;
+}
+
 int main(int argc, char** argv)
 {
   int ret = SRSRAN_ERROR;
@@ -262,6 +368,11 @@ int main(int argc, char** argv)
     goto clean_exit;
   }
 
+  if (test_case_2(&ssb) != SRSRAN_SUCCESS) {
+    ERROR("test case failed");
+    goto clean_exit;
+  }
+
   ret = SRSRAN_SUCCESS;
 
 clean_exit:
@@ -0,0 +1,242 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/test_common.h"
+#include "srsran/phy/utils/random.h"
+#include "srsran/srsran.h"
+#include <getopt.h>
+#include <sys/time.h>
+
+// Test parameters
+static srsran_cell_t cell = {.nof_prb         = 25,
+                             .nof_ports       = 1,
+                             .id              = 1,
+                             .cp              = SRSRAN_CP_NORM,
+                             .phich_resources = SRSRAN_PHICH_R_1,
+                             .phich_length    = SRSRAN_PHICH_NORM};
+
+static uint32_t nof_check_sf = 60;   // Number of subframes compared against an object without cached state
+static uint32_t nof_bench_sf = 1000; // Number of subframes for measuring the generation time
+static uint32_t mcs_idx      = 10;
+
+// Maximum tolerated difference between the objects with and without cached state
+#define UE_UL_TEST_MAX_ERROR 1e-4f
+
+// Transport block buffer size in bytes
+#define UE_UL_TEST_DATA_SIZE 150000
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [nNCmv]\n", prog);
+  printf("\t-n number of PRB [Default %d]\n", cell.nof_prb);
+  printf("\t-N number of subframes in the benchmark [Default %d]\n", nof_bench_sf);
+  printf("\t-C number of subframes checked against an object without cached state [Default %d]\n", nof_check_sf);
+  printf("\t-m MCS index [Default %d]\n", mcs_idx);
+  printf("\t-v [set srsran_verbose to debug, default none]\n");
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "nNCmv")) != -1) {
+    switch (opt) {
+      case 'n':
+        cell.nof_prb = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'N':
+        nof_bench_sf = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'C':
+        nof_check_sf = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'm':
+        mcs_idx = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'v':
+        increase_srsran_verbose_level();
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+// Fills the configuration for a given subframe; the RNTI, the allocation and the DMRS cyclic shift change along the
+// subframes for exercising the cached scrambling sequences and DMRS
+static int set_cfg(uint32_t n, srsran_ul_sf_cfg_t* sf, srsran_ue_ul_cfg_t* cfg, srsran_softbuffer_tx_t* softbuffer)
+{
+  sf->tti = n;
+
+  srsran_dci_ul_t dci = {};
+  uint32_t        L   = srsran_dft_precoding_get_valid_prb(cell.nof_prb - (n / 20) % 4);
+  dci.rnti            = (uint16_t)(0x46 + (n / 30) % 2);
+  dci.freq_hop_fl     = SRSRAN_RA_PUSCH_HOP_DISABLED;
+  dci.type2_alloc.riv = srsran_ra_type2_to_riv(L, cell.nof_prb - L, cell.nof_prb);
+  dci.tb.mcs_idx      = mcs_idx;
+  dci.n_dmrs          = (n / 10) % SRSRAN_NOF_CSHIFT;
+
+  if (srsran_ra_ul_dci_to_grant(&cell, sf, &cfg->ul_cfg.hopping, &dci, &cfg->ul_cfg.pusch.grant)) {
+    ERROR("Error computing resource allocation");
+    return SRSRAN_ERROR;
+  }
+  cfg->ul_cfg.pusch.grant.n_prb_tilde[0] = cfg->ul_cfg.pusch.grant.n_prb[0];
+  cfg->ul_cfg.pusch.grant.n_prb_tilde[1] = cfg->ul_cfg.pusch.grant.n_prb[1];
+  cfg->ul_cfg.pusch.grant.n_dmrs         = dci.n_dmrs;
+  cfg->ul_cfg.pusch.rnti                 = dci.rnti;
+  cfg->ul_cfg.pusch.softbuffers.tx       = softbuffer;
+  cfg->grant_available                   = true;
+
+  srsran_softbuffer_tx_reset(softbuffer);
+
+  return SRSRAN_SUCCESS;
+}
+
+static float max_error(const cf_t* a, const cf_t* b, cf_t* tmp, uint32_t len)
+{
+  srsran_vec_sub_ccc(a, b, tmp, len);
+  return cabsf(tmp[srsran_vec_max_abs_ci(tmp, len)]);
+}
+
+int main(int argc, char** argv)
+{
+  int                    ret         = SRSRAN_ERROR;
+  srsran_random_t        random_gen  = srsran_random_init(0x1234);
+  srsran_ue_ul_t         ue_ul       = {};
+  srsran_ue_ul_t         ue_ul_ref   = {};
+  srsran_ue_ul_cfg_t     cfg         = {};
+  srsran_softbuffer_tx_t softbuffer  = {};
+  uint8_t*               data        = srsran_vec_u8_malloc(UE_UL_TEST_DATA_SIZE);
+  uint32_t               sf_len      = 0;
+  cf_t*                  buffer      = NULL;
+  cf_t*                  buffer_ref  = NULL;
+  cf_t*                  buffer_diff = NULL;
+
+  parse_args(argc, argv);
+
+  sf_len      = SRSRAN_SF_LEN_PRB(cell.nof_prb);
+  buffer      = srsran_vec_cf_malloc(sf_len);
+  buffer_ref  = srsran_vec_cf_malloc(sf_len);
+  buffer_diff = srsran_vec_cf_malloc(sf_len);
+  if (data == NULL || buffer == NULL || buffer_ref == NULL || buffer_diff == NULL) {
+    ERROR("Error allocating buffers");
+    goto clean_exit;
+  }
+
+  if (srsran_softbuffer_tx_init(&softbuffer, cell.nof_prb)) {
+    ERROR("Error initiating softbuffer");
+    goto clean_exit;
+  }
+
+  if (srsran_ue_ul_init(&ue_ul, buffer, cell.nof_prb) || srsran_ue_ul_set_cell(&ue_ul, cell)) {
+    ERROR("Error initiating UE UL");
+    goto clean_exit;
+  }
+  if (srsran_ue_ul_init(&ue_ul_ref, buffer_ref, cell.nof_prb) || srsran_ue_ul_set_cell(&ue_ul_ref, cell)) {
+    ERROR("Error initiating UE UL");
+    goto clean_exit;
+  }
+
+  for (uint32_t i = 0; i < UE_UL_TEST_DATA_SIZE; i++) {
+    data[i] = (uint8_t)srsran_random_uniform_int_dist(random_gen, 0, 255);
+  }
+  srsran_pusch_data_t pusch_data = {};
+  pusch_data.ptr                 = data;
+
+  cfg.ul_cfg.dmrs.cyclic_shift        = 2;
+  cfg.ul_cfg.dmrs.delta_ss            = 3;
+  cfg.ul_cfg.dmrs.group_hopping_en    = true;
+  cfg.ul_cfg.dmrs.sequence_hopping_en = false;
+  cfg.normalize_mode                  = SRSRAN_UE_UL_NORMALIZE_MODE_FORCE_AMPLITUDE;
+
+  // The reference generates the scrambling sequence of every subframe without the cache
+  ue_ul_ref.pusch.seq_cache_en = false;
+
+  // The object with cached state must generate the same signal as one without it
+  for (uint32_t n = 0; n < nof_check_sf; n++) {
+    srsran_ul_sf_cfg_t sf = {};
+    if (set_cfg(n, &sf, &cfg, &softbuffer)) {
+      goto clean_exit;
+    }
+    TESTASSERT(srsran_ue_ul_encode(&ue_ul, &sf, &cfg, &pusch_data) > 0);
+
+    // Changing the cell drops the cached DMRS of the reference object
+    srsran_cell_t other_cell = cell;
+    other_cell.id            = (cell.id + 1) % SRSRAN_NUM_PCI;
+    TESTASSERT(srsran_ue_ul_set_cell(&ue_ul_ref, other_cell) == SRSRAN_SUCCESS);
+    TESTASSERT(srsran_ue_ul_set_cell(&ue_ul_ref, cell) == SRSRAN_SUCCESS);
+
+    srsran_softbuffer_tx_reset(&softbuffer);
+    TESTASSERT(srsran_ue_ul_encode(&ue_ul_ref, &sf, &cfg, &pusch_data) > 0);
+
+    float err = max_error(buffer, buffer_ref, buffer_diff, sf_len);
+    INFO("sf=%d; rnti=0x%x; L_prb=%d; n_dmrs=%d; error=%e",
+         n,
+         cfg.ul_cfg.pusch.rnti,
+         cfg.ul_cfg.pusch.grant.L_prb,
+         cfg.ul_cfg.pusch.grant.n_dmrs,
+         err);
+    TESTASSERT(err < UE_UL_TEST_MAX_ERROR);
+  }
+
+  // Measure the generation time of a UE transmitting PUSCH in every subframe
+  uint64_t t_usec = 0;
+  for (uint32_t n = 0; n < nof_bench_sf; n++) {
+    srsran_ul_sf_cfg_t sf = {};
+    if (set_cfg(n, &sf, &cfg, &softbuffer)) {
+      goto clean_exit;
+    }
+
+    struct timeval t[3] = {};
+    gettimeofday(&t[1], NULL);
+    TESTASSERT(srsran_ue_ul_encode(&ue_ul, &sf, &cfg, &pusch_data) > 0);
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+    t_usec += t[0].tv_usec + t[0].tv_sec * 1000000UL;
+  }
+
+  printf("PUSCH generation: %d PRB, MCS %d: %.1f usec/sf\n",
+         cell.nof_prb,
+         mcs_idx,
+         nof_bench_sf ? (double)t_usec / (double)nof_bench_sf : 0.0);
+
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  srsran_random_free(random_gen);
+  srsran_ue_ul_free(&ue_ul);
+  srsran_ue_ul_free(&ue_ul_ref);
+  srsran_softbuffer_tx_free(&softbuffer);
+  if (data) {
+    free(data);
+  }
+  if (buffer) {
+    free(buffer);
+  }
+  if (buffer_ref) {
+    free(buffer_ref);
+  }
+  if (buffer_diff) {
+    free(buffer_diff);
+  }
+
+  return ret;
+}
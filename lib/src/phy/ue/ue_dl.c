@@ -72,10 +72,13 @@ int srsran_ue_dl_init(srsran_ue_dl_t* q, cf_t* in_buffer[SRSRAN_MAX_PORTS], uint
 
     bzero(q, sizeof(srsran_ue_dl_t));
 
-    q->pending_ul_dci_count = 0;
-    q->nof_rx_antennas      = nof_rx_antennas;
-    q->mi_auto              = true;
-    q->mi_manual_index      = 0;
+    q->pending_ul_dci_count     = 0;
+    q->nof_rx_antennas          = nof_rx_antennas;
+    q->mi_auto                  = true;
+    q->mi_manual_index          = 0;
+    q->front_end_out.cell       = &q->cell;
+    q->front_end_out.sf_symbols = q->sf_symbols;
+    q->front_end_out.chest_res  = &q->chest_res;
 
     for (int j = 0; j < SRSRAN_MAX_PORTS; j++) {
       q->sf_symbols[j] = srsran_vec_cf_malloc(MAX_SFLEN_RE);
@@ -154,15 +157,75 @@ clean_exit:
   return ret;
 }
 
+int srsran_ue_dl_init_shared(srsran_ue_dl_t* q, const srsran_ue_dl_t* front_end, uint32_t max_prb)
+{
+  int ret = SRSRAN_ERROR_INVALID_INPUTS;
+
+  if (q != NULL && front_end != NULL && front_end->front_end == NULL) {
+    ret = SRSRAN_ERROR;
+
+    bzero(q, sizeof(srsran_ue_dl_t));
+
+    q->front_end            = &front_end->front_end_out;
+    q->pending_ul_dci_count = 0;
+    q->nof_rx_antennas      = front_end->nof_rx_antennas;
+    q->mi_auto              = true;
+    q->mi_manual_index      = 0;
+
+    // Subframe symbols and channel estimates are taken from the front-end, only the UE specific channels are created
+    if (srsran_pcfich_init(&q->pcfich, q->nof_rx_antennas)) {
+      ERROR("Error creating PCFICH object");
+      goto clean_exit;
+    }
+    if (srsran_phich_init(&q->phich, q->nof_rx_antennas)) {
+      ERROR("Error creating PHICH object");
+      goto clean_exit;
+    }
+
+    if (srsran_pdcch_init_ue(&q->pdcch, max_prb, q->nof_rx_antennas)) {
+      ERROR("Error creating PDCCH object");
+      goto clean_exit;
+    }
+
+    if (srsran_pdsch_init_ue(&q->pdsch, max_prb, q->nof_rx_antennas)) {
+      ERROR("Error creating PDSCH object");
+      goto clean_exit;
+    }
+
+    if (srsran_pmch_init(&q->pmch, max_prb, q->nof_rx_antennas)) {
+      ERROR("Error creating PMCH object");
+      goto clean_exit;
+    }
+
+    ret = SRSRAN_SUCCESS;
+  } else {
+    ERROR("Invalid parameters");
+  }
+
+clean_exit:
+  if (ret == SRSRAN_ERROR) {
+    srsran_ue_dl_free(q);
+  }
+  return ret;
+}
+
 void srsran_ue_dl_free(srsran_ue_dl_t* q)
 {
   if (q) {
-    for (int port = 0; port < SRSRAN_MAX_PORTS; port++) {
-      srsran_ofdm_rx_free(&q->fft[port]);
+    // Objects attached to a front-end do not own the FFT, estimator nor the symbol buffers
+    if (q->front_end == NULL) {
+      for (int port = 0; port < SRSRAN_MAX_PORTS; port++) {
+        srsran_ofdm_rx_free(&q->fft[port]);
+      }
+      srsran_ofdm_rx_free(&q->fft_mbsfn);
+      srsran_chest_dl_free(&q->chest);
+      srsran_chest_dl_res_free(&q->chest_res);
+      for (int j = 0; j < SRSRAN_MAX_PORTS; j++) {
+        if (q->sf_symbols[j]) {
+          free(q->sf_symbols[j]);
+        }
+      }
     }
-    srsran_ofdm_rx_free(&q->fft_mbsfn);
-    srsran_chest_dl_free(&q->chest);
-    srsran_chest_dl_res_free(&q->chest_res);
     for (int i = 0; i < SRSRAN_MI_NOF_REGS; i++) {
       srsran_regs_free(&q->regs[i]);
     }
@@ -171,11 +234,6 @@ void srsran_ue_dl_free(srsran_ue_dl_t* q)
     srsran_pdcch_free(&q->pdcch);
     srsran_pdsch_free(&q->pdsch);
     srsran_pmch_free(&q->pmch);
-    for (int j = 0; j < SRSRAN_MAX_PORTS; j++) {
-      if (q->sf_symbols[j]) {
-        free(q->sf_symbols[j]);
-      }
-    }
     bzero(q, sizeof(srsran_ue_dl_t));
   }
 }
@@ -200,7 +258,11 @@ int srsran_ue_dl_set_cell(srsran_ue_dl_t* q, srsran_cell_t cell)
           return SRSRAN_ERROR;
         }
       }
-      for (int port = 0; port < q->nof_rx_antennas; port++) {
+      if (q->front_end != NULL && q->front_end->cell->id != cell.id) {
+        ERROR("Shared UE DL cell (%d) does not match the front-end cell (%d)", cell.id, q->front_end->cell->id);
+        return SRSRAN_ERROR;
+      }
+      for (int port = 0; port < q->nof_rx_antennas && q->front_end == NULL; port++) {
         if (srsran_ofdm_rx_set_prb(&q->fft[port], q->cell.cp, q->cell.nof_prb)) {
           ERROR("Error resizing FFT");
           return SRSRAN_ERROR;
@@ -215,14 +277,16 @@ int srsran_ue_dl_set_cell(srsran_ue_dl_t* q, srsran_cell_t cell)
         phich_init_reg = 2; // mi=2
       }
 
-      if (srsran_ofdm_rx_set_prb(&q->fft_mbsfn, SRSRAN_CP_EXT, q->cell.nof_prb)) {
-        ERROR("Error resizing MBSFN FFT");
-        return SRSRAN_ERROR;
-      }
+      if (q->front_end == NULL) {
+        if (srsran_ofdm_rx_set_prb(&q->fft_mbsfn, SRSRAN_CP_EXT, q->cell.nof_prb)) {
+          ERROR("Error resizing MBSFN FFT");
+          return SRSRAN_ERROR;
+        }
 
-      if (srsran_chest_dl_set_cell(&q->chest, q->cell)) {
-        ERROR("Error resizing channel estimator");
-        return SRSRAN_ERROR;
+        if (srsran_chest_dl_set_cell(&q->chest, q->cell)) {
+          ERROR("Error resizing channel estimator");
+          return SRSRAN_ERROR;
+        }
       }
       if (srsran_pcfich_set_cell(&q->pcfich, &q->regs[0], q->cell)) {
         ERROR("Error resizing PCFICH object");
@@ -257,7 +321,9 @@ int srsran_ue_dl_set_cell(srsran_ue_dl_t* q, srsran_cell_t cell)
 
 void srsran_ue_dl_set_non_mbsfn_region(srsran_ue_dl_t* q, uint8_t non_mbsfn_region_length)
 {
-  srsran_ofdm_set_non_mbsfn_region(&q->fft_mbsfn, non_mbsfn_region_length);
+  if (q->front_end == NULL) {
+    srsran_ofdm_set_non_mbsfn_region(&q->fft_mbsfn, non_mbsfn_region_length);
+  }
 }
 
 void srsran_ue_dl_set_mi_auto(srsran_ue_dl_t* q)
@@ -265,6 +331,11 @@ void srsran_ue_dl_set_mi_auto(srsran_ue_dl_t* q)
   q->mi_auto = true;
 }
 
+void srsran_ue_dl_set_cfo(srsran_ue_dl_t* q, float cfo)
+{
+  q->cfo = cfo;
+}
+
 void srsran_ue_dl_set_mi_manual(srsran_ue_dl_t* q, uint32_t mi_idx)
 {
   q->mi_auto         = false;
@@ -279,7 +350,7 @@ int srsran_ue_dl_set_mbsfn_area_id(srsran_ue_dl_t* q, uint16_t mbsfn_area_id)
   int ret = SRSRAN_ERROR_INVALID_INPUTS;
   if (q != NULL) {
     ret = SRSRAN_ERROR;
-    if (srsran_chest_dl_set_mbsfn_area_id(&q->chest, mbsfn_area_id)) {
+    if (q->front_end == NULL && srsran_chest_dl_set_mbsfn_area_id(&q->chest, mbsfn_area_id)) {
       ERROR("Error setting MBSFN area ID ");
       return ret;
     }
@@ -346,29 +417,86 @@ static int estimate_pdcch_pcfich(srsran_ue_dl_t* q, srsran_dl_sf_cfg_t* sf, srsr
   }
 }
 
-int srsran_ue_dl_decode_fft_estimate(srsran_ue_dl_t* q, srsran_dl_sf_cfg_t* sf, srsran_ue_dl_cfg_t* cfg)
+static int estimate_pdcch_shared(srsran_ue_dl_t* q, srsran_dl_sf_cfg_t* sf, srsran_ue_dl_cfg_t* cfg)
 {
-  if (q) {
-    /* Run FFT for all subframe data */
-    for (int j = 0; j < q->nof_rx_antennas; j++) {
-      if (sf->sf_type == SRSRAN_SF_MBSFN) {
-        srsran_ofdm_rx_sf(&q->fft_mbsfn);
+  set_mi_value(q, sf, cfg);
+
+  // Point to the front-end symbols and estimates, the CFI was already decoded by the front-end into sf
+  for (int j = 0; j < SRSRAN_MAX_PORTS; j++) {
+    q->sf_symbols[j] = q->front_end->sf_symbols[j];
+  }
+  q->chest_res = *q->front_end->chest_res;
+
+  if (srsran_pdcch_extract_llr(&q->pdcch, sf, &q->chest_res, q->sf_symbols)) {
+    ERROR("Extracting PDCCH LLR");
+    return SRSRAN_ERROR;
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_ue_dl_run_fft(srsran_ue_dl_t* q, srsran_dl_sf_cfg_t* sf, uint32_t rx_ant)
+{
+  if (q == NULL || sf == NULL || rx_ant >= q->nof_rx_antennas) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // Objects sharing a front-end do not demodulate
+  if (q->front_end) {
+    return SRSRAN_SUCCESS;
+  }
+
+  if (sf->sf_type == SRSRAN_SF_MBSFN) {
+    // The MBSFN demodulator only processes the first antenna
+    if (rx_ant == 0) {
+      if (isnormal(q->cfo)) {
+        srsran_ofdm_rx_sf_cfo(&q->fft_mbsfn, q->cfo);
       } else {
-        srsran_ofdm_rx_sf(&q->fft[j]);
+        srsran_ofdm_rx_sf(&q->fft_mbsfn);
       }
     }
+  } else if (isnormal(q->cfo)) {
+    // Correct the CFO while the symbols are copied into the DFT input, the receive buffer is not modified
+    srsran_ofdm_rx_sf_cfo(&q->fft[rx_ant], q->cfo);
+  } else {
+    srsran_ofdm_rx_sf(&q->fft[rx_ant]);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_ue_dl_estimate(srsran_ue_dl_t* q, srsran_dl_sf_cfg_t* sf, srsran_ue_dl_cfg_t* cfg)
+{
+  if (q && q->front_end) {
+    return estimate_pdcch_shared(q, sf, cfg);
+  } else if (q) {
     return estimate_pdcch_pcfich(q, sf, cfg);
   } else {
     return SRSRAN_ERROR_INVALID_INPUTS;
   }
 }
 
+int srsran_ue_dl_decode_fft_estimate(srsran_ue_dl_t* q, srsran_dl_sf_cfg_t* sf, srsran_ue_dl_cfg_t* cfg)
+{
+  if (q && !q->front_end) {
+    /* Run FFT for all subframe data */
+    for (uint32_t j = 0; j < q->nof_rx_antennas; j++) {
+      if (srsran_ue_dl_run_fft(q, sf, j) < SRSRAN_SUCCESS) {
+        return SRSRAN_ERROR;
+      }
+    }
+  }
+  return srsran_ue_dl_estimate(q, sf, cfg);
+}
+
 int srsran_ue_dl_decode_fft_estimate_noguru(srsran_ue_dl_t*     q,
                                             srsran_dl_sf_cfg_t* sf,
                                             srsran_ue_dl_cfg_t* cfg,
                                             cf_t*               input[SRSRAN_MAX_PORTS])
 {
-  if (q && input) {
+  if (q && q->front_end) {
+    return estimate_pdcch_shared(q, sf, cfg);
+  } else if (q && input) {
     /* Run FFT for all subframe data */
     for (int j = 0; j < q->nof_rx_antennas; j++) {
       if (sf->sf_type == SRSRAN_SF_MBSFN) {
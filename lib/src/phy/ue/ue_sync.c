@@ -323,6 +323,9 @@ void srsran_ue_sync_free(srsran_ue_sync_t* q)
   } else {
     srsran_filesource_free(&q->file_source);
   }
+  if (q->track_buffer) {
+    free(q->track_buffer);
+  }
   bzero(q, sizeof(srsran_ue_sync_t));
 }
 
@@ -509,6 +512,35 @@ float srsran_ue_sync_get_cfo(srsran_ue_sync_t* q)
   return 15000 * q->cfo_current_value;
 }
 
+int srsran_ue_sync_set_cfo_correct_in_demod(srsran_ue_sync_t* q, bool enable)
+{
+  // Only the subframes carrying the PSS are corrected, in a separate buffer, for the tracking
+  if (enable && q->track_buffer == NULL) {
+    q->track_buffer = srsran_vec_cf_malloc(q->nof_recv_sf * SRSRAN_SF_LEN_PRB(q->max_prb));
+    if (q->track_buffer == NULL) {
+      perror("malloc");
+      return SRSRAN_ERROR;
+    }
+  }
+  q->cfo_correct_in_demod = enable;
+  return SRSRAN_SUCCESS;
+}
+
+float srsran_ue_sync_get_cfo_demod(srsran_ue_sync_t* q)
+{
+  return q->cfo_demod_value;
+}
+
+bool srsran_ue_sync_cfo_correct_copy(srsran_ue_sync_t* q, const cf_t* input, cf_t* output, uint32_t nof_samples)
+{
+  // Same correction as the one applied in place by srsran_ue_sync_zerocopy() in tracking
+  if (!q->cfo_correct_in_demod || !q->cfo_correct_enable_track || q->state != SF_TRACK) {
+    return false;
+  }
+  srsran_vec_apply_cfo(input, -q->cfo_current_value / q->fft_size, output, (int)nof_samples);
+  return true;
+}
+
 void srsran_ue_sync_cp_en(srsran_ue_sync_t* q, bool enabled)
 {
   srsran_sync_cp_en(&q->strack, enabled);
@@ -737,6 +769,7 @@ int srsran_ue_sync_zerocopy(srsran_ue_sync_t* q,
   int ret = SRSRAN_ERROR_INVALID_INPUTS;
 
   if (q != NULL && input_buffer != NULL) {
+    q->cfo_demod_value = 0.0f;
     if (q->file_mode) {
       int n = srsran_filesource_read_multi(&q->file_source, (void**)input_buffer, q->sf_len, q->nof_rx_antennas);
       if (n < 0) {
@@ -807,8 +840,11 @@ int srsran_ue_sync_zerocopy(srsran_ue_sync_t* q,
             q->frame_number = (q->frame_number + 1) % 1024;
           }
 
-          // Correct CFO before PSS/SSS tracking using the sync object corrector (initialized for 1 ms)
-          if (q->cfo_correct_enable_track) {
+          // Correct CFO before PSS/SSS tracking using the sync object corrector (initialized for 1 ms), unless the
+          // OFDM demodulation corrects it
+          if (q->cfo_correct_enable_track && q->cfo_correct_in_demod) {
+            q->cfo_demod_value = -q->cfo_current_value / q->fft_size;
+          } else if (q->cfo_correct_enable_track) {
             for (int i = 0; i < q->nof_rx_antennas; i++) {
               if (input_buffer[i]) {
                 srsran_cfo_correct(
@@ -887,7 +923,14 @@ int srsran_ue_sync_run_track_pss_mode(srsran_ue_sync_t* q, cf_t* input_buffer[SR
     // Expected PSS position is different for FDD and TDD
     uint32_t pss_idx = q->frame_len - PSS_OFFSET - q->fft_size - q->strack.max_offset / 2;
 
-    int n = srsran_sync_find(&q->strack, input_buffer[0], pss_idx, &track_idx);
+    // The tracking estimates the residual CFO, so it needs corrected samples also when the buffer is not corrected
+    cf_t* track_input = input_buffer[0];
+    if (q->cfo_correct_enable_track && q->cfo_correct_in_demod) {
+      srsran_cfo_correct(&q->strack.cfo_corr_frame, input_buffer[0], q->track_buffer, q->cfo_demod_value);
+      track_input = q->track_buffer;
+    }
+
+    int n = srsran_sync_find(&q->strack, track_input, pss_idx, &track_idx);
     switch (n) {
       case SRSRAN_SYNC_ERROR:
         ERROR("Error tracking correlation peak");
@@ -89,6 +89,14 @@ int srsran_ue_ul_init(srsran_ue_ul_t* q, cf_t* out_buffer, uint32_t max_prb)
       perror("malloc");
       goto clean_exit;
     }
+
+    for (uint32_t i = 0; i < SRSRAN_NOF_SF_X_FRAME; i++) {
+      q->dmrs_cache[i].r = srsran_vec_cf_malloc(2 * SRSRAN_NRE * max_prb);
+      if (!q->dmrs_cache[i].r) {
+        perror("malloc");
+        goto clean_exit;
+      }
+    }
     q->out_buffer           = out_buffer;
     q->signals_pregenerated = false;
     ret                     = SRSRAN_SUCCESS;
@@ -121,6 +129,11 @@ void srsran_ue_ul_free(srsran_ue_ul_t* q)
     if (q->srs_signal) {
       free(q->srs_signal);
     }
+    for (uint32_t i = 0; i < SRSRAN_NOF_SF_X_FRAME; i++) {
+      if (q->dmrs_cache[i].r) {
+        free(q->dmrs_cache[i].r);
+      }
+    }
     if (q->signals_pregenerated) {
       srsran_refsignal_dmrs_pusch_pregen_free(&q->signals, &q->pregen_dmrs);
       srsran_refsignal_srs_pregen_free(&q->signals, &q->pregen_srs);
@@ -166,6 +179,9 @@ int srsran_ue_ul_set_cell(srsran_ue_ul_t* q, srsran_cell_t cell)
         return SRSRAN_ERROR;
       }
       q->signals_pregenerated = false;
+      for (uint32_t i = 0; i < SRSRAN_NOF_SF_X_FRAME; i++) {
+        q->dmrs_cache[i].valid = false;
+      }
     }
     ret = SRSRAN_SUCCESS;
   } else {
@@ -291,6 +307,35 @@ static void add_srs(srsran_ue_ul_t* q, srsran_ue_ul_cfg_t* cfg, uint32_t tti)
   }
 }
 
+/* Returns the PUSCH DMRS for the subframe, it is only generated if the configuration differs from the last one used in
+ * the same subframe index
+ */
+static cf_t* dmrs_pusch_cached(srsran_ue_ul_t* q, srsran_ul_sf_cfg_t* sf, srsran_ue_ul_cfg_t* cfg)
+{
+  srsran_ue_ul_dmrs_cache_t*         cache    = &q->dmrs_cache[sf->tti % SRSRAN_NOF_SF_X_FRAME];
+  srsran_refsignal_dmrs_pusch_cfg_t* dmrs_cfg = &cfg->ul_cfg.dmrs;
+  srsran_pusch_grant_t*              grant    = &cfg->ul_cfg.pusch.grant;
+
+  if (cache->valid && cache->nof_prb == grant->L_prb && cache->n_dmrs == grant->n_dmrs &&
+      cache->cfg.cyclic_shift == dmrs_cfg->cyclic_shift && cache->cfg.delta_ss == dmrs_cfg->delta_ss &&
+      cache->cfg.group_hopping_en == dmrs_cfg->group_hopping_en &&
+      cache->cfg.sequence_hopping_en == dmrs_cfg->sequence_hopping_en) {
+    return cache->r;
+  }
+
+  cache->valid = false;
+  if (srsran_refsignal_dmrs_pusch_gen(
+          &q->signals, dmrs_cfg, grant->L_prb, sf->tti % SRSRAN_NOF_SF_X_FRAME, grant->n_dmrs, cache->r)) {
+    return NULL;
+  }
+  cache->cfg     = *dmrs_cfg;
+  cache->nof_prb = grant->L_prb;
+  cache->n_dmrs  = grant->n_dmrs;
+  cache->valid   = true;
+
+  return cache->r;
+}
+
 static int pusch_encode(srsran_ue_ul_t* q, srsran_ul_sf_cfg_t* sf, srsran_ue_ul_cfg_t* cfg, srsran_pusch_data_t* data)
 {
   int ret = SRSRAN_ERROR_INVALID_INPUTS;
@@ -306,16 +351,12 @@ static int pusch_encode(srsran_ue_ul_t* q, srsran_ul_sf_cfg_t* sf, srsran_ue_ul_
     if (q->signals_pregenerated) {
       srsran_refsignal_dmrs_pusch_pregen_put(&q->signals, sf, &q->pregen_dmrs, &cfg->ul_cfg.pusch, q->sf_symbols);
     } else {
-      if (srsran_refsignal_dmrs_pusch_gen(&q->signals,
-                                          &cfg->ul_cfg.dmrs,
-                                          cfg->ul_cfg.pusch.grant.L_prb,
-                                          sf->tti % 10,
-                                          cfg->ul_cfg.pusch.grant.n_dmrs,
-                                          q->refsignal)) {
+      cf_t* refsignal = dmrs_pusch_cached(q, sf, cfg);
+      if (refsignal == NULL) {
         ERROR("Error generating PUSCH DMRS signals");
         return ret;
       }
-      srsran_refsignal_dmrs_pusch_put(&q->signals, &cfg->ul_cfg.pusch, q->refsignal, q->sf_symbols);
+      srsran_refsignal_dmrs_pusch_put(&q->signals, &cfg->ul_cfg.pusch, refsignal, q->sf_symbols);
     }
 
     add_srs(q, cfg, sf->tti);
@@ -860,6 +860,8 @@ int main(int argc, char** argv)
     nof_repetitions = (uint32_t)strtol(argv[1], NULL, 10);
   }
 
+  printf("Vector kernels: %s\n", srsran_vec_isa_string(srsran_vec_isa_get()));
+
   for (uint32_t block_size = 1; block_size <= 1024 * 32; block_size *= 2) {
     func_count = 0;
 
@@ -30,36 +30,161 @@
 #include "srsran/phy/utils/simd.h"
 #include "srsran/phy/utils/vector.h"
 #include "srsran/phy/utils/vector_simd.h"
+#include "vector_simd_isa.h"
+
+static const srsran_vec_simd_table_t  vec_simd_native = SRSRAN_VEC_SIMD_TABLE_INIT(SRSRAN_VEC_ISA_NATIVE);
+static const srsran_vec_simd_table_t* vec_simd        = &vec_simd_native;
+static srsran_vec_clmul_t             vec_clmul       = SRSRAN_VEC_CLMUL_NONE;
+
+static const srsran_vec_simd_table_t* vec_isa_table(srsran_vec_isa_t isa)
+{
+  switch (isa) {
+    case SRSRAN_VEC_ISA_NATIVE:
+      return &vec_simd_native;
+#ifdef SRSRAN_VEC_ISA_DISPATCH
+    case SRSRAN_VEC_ISA_SSE:
+      return __builtin_cpu_supports("sse4.1") ? &srsran_vec_simd_table_sse : NULL;
+    case SRSRAN_VEC_ISA_AVX2:
+      return (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) ? &srsran_vec_simd_table_avx2 : NULL;
+    case SRSRAN_VEC_ISA_AVX512:
+      return (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512cd") &&
+              __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512dq"))
+                 ? &srsran_vec_simd_table_avx512
+                 : NULL;
+#endif /* SRSRAN_VEC_ISA_DISPATCH */
+    default:
+      return NULL;
+  }
+}
+
+// The folding kernels do not depend on the vector width but on PCLMUL and VPCLMULQDQ, which are checked separately
+static srsran_vec_clmul_t vec_isa_clmul(srsran_vec_isa_t isa)
+{
+  switch (isa) {
+    case SRSRAN_VEC_ISA_NATIVE:
+#if defined(LV_HAVE_AVX512) && defined(__VPCLMULQDQ__) && defined(__AVX512BW__) && defined(__PCLMUL__)
+      return SRSRAN_VEC_CLMUL_512;
+#elif defined(LV_HAVE_SSE) && defined(__PCLMUL__) && defined(__SSSE3__)
+      return SRSRAN_VEC_CLMUL_128;
+#else
+      return SRSRAN_VEC_CLMUL_NONE;
+#endif
+#ifdef SRSRAN_VEC_ISA_DISPATCH
+    case SRSRAN_VEC_ISA_AVX512:
+      if (__builtin_cpu_supports("vpclmulqdq") && __builtin_cpu_supports("pclmul")) {
+        return SRSRAN_VEC_CLMUL_512;
+      }
+      // Fall through
+    case SRSRAN_VEC_ISA_SSE:
+    case SRSRAN_VEC_ISA_AVX2:
+      return __builtin_cpu_supports("pclmul") ? SRSRAN_VEC_CLMUL_128 : SRSRAN_VEC_CLMUL_NONE;
+#endif /* SRSRAN_VEC_ISA_DISPATCH */
+    default:
+      return SRSRAN_VEC_CLMUL_NONE;
+  }
+}
+
+const char* srsran_vec_isa_string(srsran_vec_isa_t isa)
+{
+  switch (isa) {
+    case SRSRAN_VEC_ISA_NATIVE:
+      return "native";
+    case SRSRAN_VEC_ISA_SSE:
+      return "sse";
+    case SRSRAN_VEC_ISA_AVX2:
+      return "avx2";
+    case SRSRAN_VEC_ISA_AVX512:
+      return "avx512";
+    default:
+      return "invalid";
+  }
+}
+
+bool srsran_vec_isa_available(srsran_vec_isa_t isa)
+{
+  return vec_isa_table(isa) != NULL;
+}
+
+srsran_vec_isa_t srsran_vec_isa_get(void)
+{
+  return vec_simd->isa;
+}
+
+int srsran_vec_isa_set(srsran_vec_isa_t isa)
+{
+  const srsran_vec_simd_table_t* table = vec_isa_table(isa);
+  if (table == NULL) {
+    return SRSRAN_ERROR;
+  }
+  vec_simd  = table;
+  vec_clmul = vec_isa_clmul(isa);
+  return SRSRAN_SUCCESS;
+}
+
+srsran_vec_clmul_t srsran_vec_isa_clmul(void)
+{
+  return vec_clmul;
+}
+
+// Binds the kernels before main() runs, so no vector function runs with a table that changes afterwards
+__attribute__((constructor)) static void vec_isa_init(void)
+{
+  // The best instruction set available is selected, the native kernels are kept if no other is available
+  vec_clmul = vec_isa_clmul(SRSRAN_VEC_ISA_NATIVE);
+  for (int isa = SRSRAN_VEC_ISA_COUNT - 1; isa > SRSRAN_VEC_ISA_NATIVE; isa--) {
+    if (srsran_vec_isa_set((srsran_vec_isa_t)isa) == SRSRAN_SUCCESS) {
+      break;
+    }
+  }
+
+  // Override for testing
+  const char* env = getenv("SRSRAN_VEC_ISA");
+  if (env == NULL || env[0] == '\0') {
+    return;
+  }
+  for (int isa = SRSRAN_VEC_ISA_NATIVE; isa < SRSRAN_VEC_ISA_COUNT; isa++) {
+    if (strcmp(env, srsran_vec_isa_string((srsran_vec_isa_t)isa)) == 0) {
+      if (srsran_vec_isa_set((srsran_vec_isa_t)isa) != SRSRAN_SUCCESS) {
+        fprintf(stderr,
+                "Vector kernels for %s are not available, using %s\n",
+                env,
+                srsran_vec_isa_string(vec_simd->isa));
+      }
+      return;
+    }
+  }
+  fprintf(stderr, "Invalid SRSRAN_VEC_ISA=%s, using %s\n", env, srsran_vec_isa_string(vec_simd->isa));
+}
 
 void srsran_vec_xor_bbb(const uint8_t* x, const uint8_t* y, uint8_t* z, const uint32_t len)
 {
-  srsran_vec_xor_bbb_simd(x, y, z, len);
+  vec_simd->xor_bbb(x, y, z, len);
 }
 
 // Used in PRACH detector, AGC and chest_dl for noise averaging
 float srsran_vec_acc_ff(const float* x, const uint32_t len)
 {
-  return srsran_vec_acc_ff_simd(x, len);
+  return vec_simd->acc_ff(x, len);
 }
 
 cf_t srsran_vec_acc_cc(const cf_t* x, const uint32_t len)
 {
-  return srsran_vec_acc_cc_simd(x, len);
+  return vec_simd->acc_cc(x, len);
 }
 
 void srsran_vec_sub_fff(const float* x, const float* y, float* z, const uint32_t len)
 {
-  srsran_vec_sub_fff_simd(x, y, z, len);
+  vec_simd->sub_fff(x, y, z, len);
 }
 
 void srsran_vec_sub_sss(const int16_t* x, const int16_t* y, int16_t* z, const uint32_t len)
 {
-  srsran_vec_sub_sss_simd(x, y, z, len);
+  vec_simd->sub_sss(x, y, z, len);
 }
 
 void srsran_vec_sub_bbb(const int8_t* x, const int8_t* y, int8_t* z, const uint32_t len)
 {
-  srsran_vec_sub_bbb_simd(x, y, z, len);
+  vec_simd->sub_bbb(x, y, z, len);
 }
 
 // Noise estimation in chest_dl, interpolation
@@ -71,12 +196,12 @@ void srsran_vec_sub_ccc(const cf_t* x, const cf_t* y, cf_t* z, const uint32_t le
 // Used in PSS/SSS and sum_ccc
 void srsran_vec_sum_fff(const float* x, const float* y, float* z, const uint32_t len)
 {
-  srsran_vec_add_fff_simd(x, y, z, len);
+  vec_simd->add_fff(x, y, z, len);
 }
 
 void srsran_vec_sum_sss(const int16_t* x, const int16_t* y, int16_t* z, const uint32_t len)
 {
-  srsran_vec_sum_sss_simd(x, y, z, len);
+  vec_simd->sum_sss(x, y, z, len);
 }
 
 void srsran_vec_sum_ccc(const cf_t* x, const cf_t* y, cf_t* z, const uint32_t len)
@@ -87,55 +212,55 @@ void srsran_vec_sum_ccc(const cf_t* x, const cf_t* y, cf_t* z, const uint32_t le
 // PSS, PBCH, DEMOD, FFTW, etc.
 void srsran_vec_sc_prod_fff(const float* x, const float h, float* z, const uint32_t len)
 {
-  srsran_vec_sc_prod_fff_simd(x, h, z, len);
+  vec_simd->sc_prod_fff(x, h, z, len);
 }
 
 // Used throughout
 void srsran_vec_sc_prod_cfc(const cf_t* x, const float h, cf_t* z, const uint32_t len)
 {
-  srsran_vec_sc_prod_cfc_simd(x, h, z, len);
+  vec_simd->sc_prod_cfc(x, h, z, len);
 }
 
 void srsran_vec_sc_prod_fcc(const float* x, const cf_t h, cf_t* z, const uint32_t len)
 {
-  srsran_vec_sc_prod_fcc_simd(x, h, z, len);
+  vec_simd->sc_prod_fcc(x, h, z, len);
 }
 
 // Chest UL
 void srsran_vec_sc_prod_ccc(const cf_t* x, const cf_t h, cf_t* z, const uint32_t len)
 {
-  srsran_vec_sc_prod_ccc_simd(x, h, z, len);
+  vec_simd->sc_prod_ccc(x, h, z, len);
 }
 
 // Used in turbo decoder
 void srsran_vec_convert_if(const int16_t* x, const float scale, float* z, const uint32_t len)
 {
-  srsran_vec_convert_if_simd(x, z, scale, len);
+  vec_simd->convert_if(x, z, scale, len);
 }
 
 void srsran_vec_convert_fi(const float* x, const float scale, int16_t* z, const uint32_t len)
 {
-  srsran_vec_convert_fi_simd(x, z, scale, len);
+  vec_simd->convert_fi(x, z, scale, len);
 }
 
 void srsran_vec_convert_conj_cs(const cf_t* x, const float scale, int16_t* z, const uint32_t len)
 {
-  srsran_vec_convert_conj_cs_simd(x, z, scale, len);
+  vec_simd->convert_conj_cs(x, z, scale, len);
 }
 
 void srsran_vec_convert_fb(const float* x, const float scale, int8_t* z, const uint32_t len)
 {
-  srsran_vec_convert_fb_simd(x, z, scale, len);
+  vec_simd->convert_fb(x, z, scale, len);
 }
 
 void srsran_vec_lut_sss(const short* x, const unsigned short* lut, short* y, const uint32_t len)
 {
-  srsran_vec_lut_sss_simd(x, lut, y, len);
+  vec_simd->lut_sss(x, lut, y, len);
 }
 
 void srsran_vec_lut_bbb(const int8_t* x, const unsigned short* lut, int8_t* y, const uint32_t len)
 {
-  srsran_vec_lut_bbb_simd(x, lut, y, len);
+  vec_simd->lut_bbb(x, lut, y, len);
 }
 
 void srsran_vec_lut_sis(const short* x, const unsigned int* lut, short* y, const uint32_t len)
@@ -468,29 +593,29 @@ void srsran_vec_conj_cc(const cf_t* x, cf_t* y, const uint32_t len)
 // Used in scrambling complex
 void srsran_vec_prod_cfc(const cf_t* x, const float* y, cf_t* z, const uint32_t len)
 {
-  srsran_vec_prod_cfc_simd(x, y, z, len);
+  vec_simd->prod_cfc(x, y, z, len);
 }
 
 // Used in scrambling float
 void srsran_vec_prod_fff(const float* x, const float* y, float* z, const uint32_t len)
 {
-  srsran_vec_prod_fff_simd(x, y, z, len);
+  vec_simd->prod_fff(x, y, z, len);
 }
 
 void srsran_vec_prod_sss(const int16_t* x, const int16_t* y, int16_t* z, const uint32_t len)
 {
-  srsran_vec_prod_sss_simd(x, y, z, len);
+  vec_simd->prod_sss(x, y, z, len);
 }
 
 // Scrambling
 void srsran_vec_neg_sss(const int16_t* x, const int16_t* y, int16_t* z, const uint32_t len)
 {
-  srsran_vec_neg_sss_simd(x, y, z, len);
+  vec_simd->neg_sss(x, y, z, len);
 }
 
 void srsran_vec_neg_bbb(const int8_t* x, const int8_t* y, int8_t* z, const uint32_t len)
 {
-  srsran_vec_neg_bbb_simd(x, y, z, len);
+  vec_simd->neg_bbb(x, y, z, len);
 }
 
 void srsran_vec_neg_bb(const int8_t* x, int8_t* z, const uint32_t len)
@@ -503,7 +628,7 @@ void srsran_vec_neg_bb(const int8_t* x, int8_t* z, const uint32_t len)
 // CFO and OFDM processing
 void srsran_vec_prod_ccc(const cf_t* x, const cf_t* y, cf_t* z, const uint32_t len)
 {
-  srsran_vec_prod_ccc_simd(x, y, z, len);
+  vec_simd->prod_ccc(x, y, z, len);
 }
 
 void srsran_vec_prod_ccc_split(const float*   x_re,
@@ -514,13 +639,13 @@ void srsran_vec_prod_ccc_split(const float*   x_re,
                                float*         z_im,
                                const uint32_t len)
 {
-  srsran_vec_prod_ccc_split_simd(x_re, x_im, y_re, y_im, z_re, z_im, len);
+  vec_simd->prod_ccc_split(x_re, x_im, y_re, y_im, z_re, z_im, len);
 }
 
 // PRACH, CHEST UL, etc.
 void srsran_vec_prod_conj_ccc(const cf_t* x, const cf_t* y, cf_t* z, const uint32_t len)
 {
-  srsran_vec_prod_conj_ccc_simd(x, y, z, len);
+  vec_simd->prod_conj_ccc(x, y, z, len);
 }
 
 //#define DIV_USE_VEC
@@ -528,24 +653,24 @@ void srsran_vec_prod_conj_ccc(const cf_t* x, const cf_t* y, cf_t* z, const uint3
 // Used in SSS
 void srsran_vec_div_ccc(const cf_t* x, const cf_t* y, cf_t* z, const uint32_t len)
 {
-  srsran_vec_div_ccc_simd(x, y, z, len);
+  vec_simd->div_ccc(x, y, z, len);
 }
 
 /* Complex division by float z=x/y */
 void srsran_vec_div_cfc(const cf_t* x, const float* y, cf_t* z, const uint32_t len)
 {
-  srsran_vec_div_cfc_simd(x, y, z, len);
+  vec_simd->div_cfc(x, y, z, len);
 }
 
 void srsran_vec_div_fff(const float* x, const float* y, float* z, const uint32_t len)
 {
-  srsran_vec_div_fff_simd(x, y, z, len);
+  vec_simd->div_fff(x, y, z, len);
 }
 
 // PSS. convolution
 cf_t srsran_vec_dot_prod_ccc(const cf_t* x, const cf_t* y, const uint32_t len)
 {
-  return srsran_vec_dot_prod_ccc_simd(x, y, len);
+  return vec_simd->dot_prod_ccc(x, y, len);
 }
 
 // Convolution filter and in SSS search
@@ -562,7 +687,7 @@ cf_t srsran_vec_dot_prod_cfc(const cf_t* x, const float* y, const uint32_t len)
 // SYNC
 cf_t srsran_vec_dot_prod_conj_ccc(const cf_t* x, const cf_t* y, const uint32_t len)
 {
-  return srsran_vec_dot_prod_conj_ccc_simd(x, y, len);
+  return vec_simd->dot_prod_conj_ccc(x, y, len);
 }
 
 // PHICH
@@ -578,7 +703,7 @@ float srsran_vec_dot_prod_fff(const float* x, const float* y, const uint32_t len
 
 int32_t srsran_vec_dot_prod_sss(const int16_t* x, const int16_t* y, const uint32_t len)
 {
-  return srsran_vec_dot_prod_sss_simd(x, y, len);
+  return vec_simd->dot_prod_sss(x, y, len);
 }
 
 float srsran_vec_avg_power_cf(const cf_t* x, const uint32_t len)
@@ -643,7 +768,7 @@ float srsran_vec_corr_ccc(const cf_t* x, cf_t* y, const uint32_t len)
 // PSS (disabled and using abs_square )
 void srsran_vec_abs_cf(const cf_t* x, float* abs, const uint32_t len)
 {
-  srsran_vec_abs_cf_simd(x, abs, len);
+  vec_simd->abs_cf(x, abs, len);
 }
 
 void srsran_vec_abs_dB_cf(const cf_t* x, float default_value, float* abs, const uint32_t len)
@@ -681,23 +806,23 @@ void srsran_vec_arg_deg_cf(const cf_t* x, float default_value, float* arg, const
 // PRACH
 void srsran_vec_abs_square_cf(const cf_t* x, float* abs_square, const uint32_t len)
 {
-  srsran_vec_abs_square_cf_simd(x, abs_square, len);
+  vec_simd->abs_square_cf(x, abs_square, len);
 }
 
 uint32_t srsran_vec_max_fi(const float* x, const uint32_t len)
 {
-  return srsran_vec_max_fi_simd(x, len);
+  return vec_simd->max_fi(x, len);
 }
 
 uint32_t srsran_vec_max_abs_fi(const float* x, const uint32_t len)
 {
-  return srsran_vec_max_abs_fi_simd(x, len);
+  return vec_simd->max_abs_fi(x, len);
 }
 
 // CP autocorr
 uint32_t srsran_vec_max_abs_ci(const cf_t* x, const uint32_t len)
 {
-  return srsran_vec_max_ci_simd(x, len);
+  return vec_simd->max_ci(x, len);
 }
 
 void srsran_vec_quant_fs(const float*   in,
@@ -818,25 +943,25 @@ void srsran_vec_quant_sus(const int16_t* in,
 
 void srsran_vec_interleave(const cf_t* x, const cf_t* y, cf_t* z, const int len)
 {
-  srsran_vec_interleave_simd(x, y, z, len);
+  vec_simd->interleave(x, y, z, len);
 }
 
 void srsran_vec_interleave_add(const cf_t* x, const cf_t* y, cf_t* z, const int len)
 {
-  srsran_vec_interleave_add_simd(x, y, z, len);
+  vec_simd->interleave_add(x, y, z, len);
 }
 
 cf_t srsran_vec_gen_sine(cf_t amplitude, float freq, cf_t* z, int len)
 {
-  return srsran_vec_gen_sine_simd(amplitude, freq, z, len);
+  return vec_simd->gen_sine(amplitude, freq, z, len);
 }
 
 void srsran_vec_apply_cfo(const cf_t* x, float cfo, cf_t* z, int len)
 {
-  srsran_vec_apply_cfo_simd(x, cfo, z, len);
+  vec_simd->apply_cfo(x, cfo, z, len);
 }
 
 float srsran_vec_estimate_frequency(const cf_t* x, int len)
 {
-  return srsran_vec_estimate_frequency_simd(x, len);
+  return vec_simd->estimate_frequency(x, len);
 }
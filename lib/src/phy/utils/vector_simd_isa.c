@@ -0,0 +1,114 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ *  File:         vector_simd_isa.c
+ *  Description:  Builds the SIMD vector kernels of vector_simd.c for the ISA
+ *                selected with SRSRAN_VEC_BUILD_SSE, SRSRAN_VEC_BUILD_AVX2 or
+ *                SRSRAN_VEC_BUILD_AVX512. Every kernel is renamed with the ISA
+ *                as suffix and a table of them is exported for vector.c. The
+ *                build system compiles this file once per ISA with the
+ *                matching compiler flags.
+ *****************************************************************************/
+
+/* The SIMD selection of the library flags is replaced by the one of this build */
+#undef LV_HAVE_SSE
+#undef LV_HAVE_AVX
+#undef LV_HAVE_AVX2
+#undef LV_HAVE_FMA
+#undef LV_HAVE_AVX512
+
+#if defined(SRSRAN_VEC_BUILD_SSE)
+#define LV_HAVE_SSE
+#define SRSRAN_VEC_ISA_SYMBOL(NAME) NAME##_sse
+#define SRSRAN_VEC_ISA_TABLE srsran_vec_simd_table_sse
+#define SRSRAN_VEC_ISA_ID SRSRAN_VEC_ISA_SSE
+#elif defined(SRSRAN_VEC_BUILD_AVX2)
+#define LV_HAVE_SSE
+#define LV_HAVE_AVX
+#define LV_HAVE_AVX2
+#define LV_HAVE_FMA
+#define SRSRAN_VEC_ISA_SYMBOL(NAME) NAME##_avx2
+#define SRSRAN_VEC_ISA_TABLE srsran_vec_simd_table_avx2
+#define SRSRAN_VEC_ISA_ID SRSRAN_VEC_ISA_AVX2
+#elif defined(SRSRAN_VEC_BUILD_AVX512)
+#define LV_HAVE_SSE
+#define LV_HAVE_AVX
+#define LV_HAVE_AVX2
+#define LV_HAVE_FMA
+#define LV_HAVE_AVX512
+#define SRSRAN_VEC_ISA_SYMBOL(NAME) NAME##_avx512
+#define SRSRAN_VEC_ISA_TABLE srsran_vec_simd_table_avx512
+#define SRSRAN_VEC_ISA_ID SRSRAN_VEC_ISA_AVX512
+#else
+#error "No ISA selected"
+#endif
+
+#define srsran_vec_xor_bbb_simd SRSRAN_VEC_ISA_SYMBOL(srsran_vec_xor_bbb_simd)
+#define srsran_vec_sum_sss_simd SRSRAN_VEC_ISA_SYMBOL(srsran_vec_sum_sss_simd)
+#define srsran_vec_sub_sss_simd SRSRAN_VEC_ISA_SYMBOL(srsran_vec_sub_sss_simd)
+#define srsran_vec_sub_bbb_simd SRSRAN_VEC_ISA_SYMBOL(srsran_vec_sub_bbb_simd)
+#define srsran_vec_acc_ff_simd SRSRAN_VEC_ISA_SYMBOL(srsran_vec_acc_ff_simd)
+#define srsran_vec_acc_cc_simd SRSRAN_VEC_ISA_SYMBOL(srsran_vec_acc_cc_simd)
+#define srsran_vec_add_fff_simd SRSRAN_VEC_ISA_SYMBOL(srsran_vec_add_fff_simd)
+#define srsran_vec_sub_fff_simd SRSRAN_VEC_ISA_SYMBOL(srsran_vec_sub_fff_simd)
+#define srsran_vec_sc_prod_cfc_simd SRSRAN_VEC_ISA_SYMBOL(srsran_vec_sc_prod_cfc_simd)
+#define srsran_vec_sc_prod_fcc_simd SRSRAN_VEC_ISA_SYMBOL(srsran_vec_sc_prod_fcc_simd)
+#define srsran_vec_sc_prod_fff_simd SRSRAN_VEC_ISA_SYMBOL(srsran_vec_sc_prod_fff_simd)
+#define srsran_vec_sc_prod_ccc_simd SRSRAN_VEC_ISA_SYMBOL(srsran_vec_sc_prod_ccc_simd)
+#define srsran_vec_sc_prod_ccc_simd2 SRSRAN_VEC_ISA_SYMBOL(srsran_vec_sc_prod_ccc_simd2)
+#define srsran_vec_prod_ccc_split_simd SRSRAN_VEC_ISA_SYMBOL(srsran_vec_prod_ccc_split_simd)
+#define srsran_vec_prod_ccc_c16_simd SRSRAN_VEC_ISA_SYMBOL(srsran_vec_prod_ccc_c16_simd)
+#define srsran_vec_prod_sss_simd SRSRAN_VEC_ISA_SYMBOL(srsran_vec_prod_sss_simd)
+#define srsran_vec_neg_sss_simd SRSRAN_VEC_ISA_SYMBOL(srsran_vec_neg_sss_simd)
+#define srsran_vec_neg_bbb_simd SRSRAN_VEC_ISA_SYMBOL(srsran_vec_neg_bbb_simd)
+#define srsran_vec_prod_cfc_simd SRSRAN_VEC_ISA_SYMBOL(srsran_vec_prod_cfc_simd)
+#define srsran_vec_prod_fff_simd SRSRAN_VEC_ISA_SYMBOL(srsran_vec_prod_fff_simd)
+#define srsran_vec_prod_ccc_simd SRSRAN_VEC_ISA_SYMBOL(srsran_vec_prod_ccc_simd)
+#define srsran_vec_prod_conj_ccc_simd SRSRAN_VEC_ISA_SYMBOL(srsran_vec_prod_conj_ccc_simd)
+#define srsran_vec_div_ccc_simd SRSRAN_VEC_ISA_SYMBOL(srsran_vec_div_ccc_simd)
+#define srsran_vec_div_cfc_simd SRSRAN_VEC_ISA_SYMBOL(srsran_vec_div_cfc_simd)
+#define srsran_vec_div_fff_simd SRSRAN_VEC_ISA_SYMBOL(srsran_vec_div_fff_simd)
+#define srsran_vec_dot_prod_conj_ccc_simd SRSRAN_VEC_ISA_SYMBOL(srsran_vec_dot_prod_conj_ccc_simd)
+#define srsran_vec_dot_prod_ccc_simd SRSRAN_VEC_ISA_SYMBOL(srsran_vec_dot_prod_ccc_simd)
+#define srsran_vec_dot_prod_ccc_c16i_simd SRSRAN_VEC_ISA_SYMBOL(srsran_vec_dot_prod_ccc_c16i_simd)
+#define srsran_vec_dot_prod_sss_simd SRSRAN_VEC_ISA_SYMBOL(srsran_vec_dot_prod_sss_simd)
+#define srsran_vec_abs_cf_simd SRSRAN_VEC_ISA_SYMBOL(srsran_vec_abs_cf_simd)
+#define srsran_vec_abs_square_cf_simd SRSRAN_VEC_ISA_SYMBOL(srsran_vec_abs_square_cf_simd)
+#define srsran_vec_lut_sss_simd SRSRAN_VEC_ISA_SYMBOL(srsran_vec_lut_sss_simd)
+#define srsran_vec_lut_bbb_simd SRSRAN_VEC_ISA_SYMBOL(srsran_vec_lut_bbb_simd)
+#define srsran_vec_convert_if_simd SRSRAN_VEC_ISA_SYMBOL(srsran_vec_convert_if_simd)
+#define srsran_vec_convert_fi_simd SRSRAN_VEC_ISA_SYMBOL(srsran_vec_convert_fi_simd)
+#define srsran_vec_convert_conj_cs_simd SRSRAN_VEC_ISA_SYMBOL(srsran_vec_convert_conj_cs_simd)
+#define srsran_vec_convert_fb_simd SRSRAN_VEC_ISA_SYMBOL(srsran_vec_convert_fb_simd)
+#define srsran_vec_interleave_simd SRSRAN_VEC_ISA_SYMBOL(srsran_vec_interleave_simd)
+#define srsran_vec_interleave_add_simd SRSRAN_VEC_ISA_SYMBOL(srsran_vec_interleave_add_simd)
+#define srsran_vec_gen_sine_simd SRSRAN_VEC_ISA_SYMBOL(srsran_vec_gen_sine_simd)
+#define srsran_vec_apply_cfo_simd SRSRAN_VEC_ISA_SYMBOL(srsran_vec_apply_cfo_simd)
+#define srsran_vec_estimate_frequency_simd SRSRAN_VEC_ISA_SYMBOL(srsran_vec_estimate_frequency_simd)
+#define srsran_vec_max_fi_simd SRSRAN_VEC_ISA_SYMBOL(srsran_vec_max_fi_simd)
+#define srsran_vec_max_abs_fi_simd SRSRAN_VEC_ISA_SYMBOL(srsran_vec_max_abs_fi_simd)
+#define srsran_vec_max_ci_simd SRSRAN_VEC_ISA_SYMBOL(srsran_vec_max_ci_simd)
+
+#include "vector_simd.c"
+#include "vector_simd_isa.h"
+
+const srsran_vec_simd_table_t SRSRAN_VEC_ISA_TABLE = SRSRAN_VEC_SIMD_TABLE_INIT(SRSRAN_VEC_ISA_ID);
@@ -0,0 +1,143 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ *  File:         vector_simd_isa.h
+ *  Description:  Table of the SIMD vector kernels used by vector.c. The kernels
+ *                are built once with the library flags and, if the ISA dispatch
+ *                is enabled, once more for each supported ISA. The table of the
+ *                best ISA the CPU supports is selected at startup.
+ *****************************************************************************/
+
+#ifndef SRSRAN_VECTOR_SIMD_ISA_H
+#define SRSRAN_VECTOR_SIMD_ISA_H
+
+#include "srsran/config.h"
+#include "srsran/phy/utils/vector.h"
+#include "srsran/phy/utils/vector_simd.h"
+
+typedef struct {
+  srsran_vec_isa_t isa;
+  void (*xor_bbb)(const uint8_t* x, const uint8_t* y, uint8_t* z, int len);
+  void (*sum_sss)(const int16_t* x, const int16_t* y, int16_t* z, int len);
+  void (*sub_sss)(const int16_t* x, const int16_t* y, int16_t* z, int len);
+  void (*sub_bbb)(const int8_t* x, const int8_t* y, int8_t* z, int len);
+  float (*acc_ff)(const float* x, int len);
+  cf_t (*acc_cc)(const cf_t* x, int len);
+  void (*add_fff)(const float* x, const float* y, float* z, int len);
+  void (*sub_fff)(const float* x, const float* y, float* z, int len);
+  void (*sc_prod_cfc)(const cf_t* x, const float h, cf_t* y, const int len);
+  void (*sc_prod_fcc)(const float* x, const cf_t h, cf_t* y, const int len);
+  void (*sc_prod_fff)(const float* x, const float h, float* z, const int len);
+  void (*sc_prod_ccc)(const cf_t* x, const cf_t h, cf_t* z, const int len);
+  void (*prod_ccc_split)(const float* a_re,
+                         const float* a_im,
+                         const float* b_re,
+                         const float* b_im,
+                         float*       r_re,
+                         float*       r_im,
+                         const int    len);
+  void (*prod_sss)(const int16_t* x, const int16_t* y, int16_t* z, const int len);
+  void (*neg_sss)(const int16_t* x, const int16_t* y, int16_t* z, const int len);
+  void (*neg_bbb)(const int8_t* x, const int8_t* y, int8_t* z, const int len);
+  void (*prod_cfc)(const cf_t* x, const float* y, cf_t* z, const int len);
+  void (*prod_fff)(const float* x, const float* y, float* z, const int len);
+  void (*prod_ccc)(const cf_t* x, const cf_t* y, cf_t* z, const int len);
+  void (*prod_conj_ccc)(const cf_t* x, const cf_t* y, cf_t* z, const int len);
+  void (*div_ccc)(const cf_t* x, const cf_t* y, cf_t* z, const int len);
+  void (*div_cfc)(const cf_t* x, const float* y, cf_t* z, const int len);
+  void (*div_fff)(const float* x, const float* y, float* z, const int len);
+  cf_t (*dot_prod_conj_ccc)(const cf_t* x, const cf_t* y, const int len);
+  cf_t (*dot_prod_ccc)(const cf_t* x, const cf_t* y, const int len);
+  int (*dot_prod_sss)(const int16_t* x, const int16_t* y, const int len);
+  void (*abs_cf)(const cf_t* x, float* z, const int len);
+  void (*abs_square_cf)(const cf_t* x, float* z, const int len);
+  void (*lut_sss)(const short* x, const unsigned short* lut, short* y, const int len);
+  void (*lut_bbb)(const int8_t* x, const unsigned short* lut, int8_t* y, const int len);
+  void (*convert_if)(const int16_t* x, float* z, const float scale, const int len);
+  void (*convert_fi)(const float* x, int16_t* z, const float scale, const int len);
+  void (*convert_conj_cs)(const cf_t* x, int16_t* z, const float scale, const int len);
+  void (*convert_fb)(const float* x, int8_t* z, const float scale, const int len);
+  void (*interleave)(const cf_t* x, const cf_t* y, cf_t* z, const int len);
+  void (*interleave_add)(const cf_t* x, const cf_t* y, cf_t* z, const int len);
+  cf_t (*gen_sine)(cf_t amplitude, float freq, cf_t* z, int len);
+  void (*apply_cfo)(const cf_t* x, float cfo, cf_t* z, int len);
+  float (*estimate_frequency)(const cf_t* x, int len);
+  uint32_t (*max_fi)(const float* x, const int len);
+  uint32_t (*max_abs_fi)(const float* x, const int len);
+  uint32_t (*max_ci)(const cf_t* x, const int len);
+} srsran_vec_simd_table_t;
+
+/* Initializer of a table with the kernels visible under their plain names, the ISA builds rename them */
+#define SRSRAN_VEC_SIMD_TABLE_INIT(ISA)                                                                                \
+  {                                                                                                                    \
+    .isa = ISA,                                                                                                        \
+    .xor_bbb = srsran_vec_xor_bbb_simd,                                                                                \
+    .sum_sss = srsran_vec_sum_sss_simd,                                                                                \
+    .sub_sss = srsran_vec_sub_sss_simd,                                                                                \
+    .sub_bbb = srsran_vec_sub_bbb_simd,                                                                                \
+    .acc_ff = srsran_vec_acc_ff_simd,                                                                                  \
+    .acc_cc = srsran_vec_acc_cc_simd,                                                                                  \
+    .add_fff = srsran_vec_add_fff_simd,                                                                                \
+    .sub_fff = srsran_vec_sub_fff_simd,                                                                                \
+    .sc_prod_cfc = srsran_vec_sc_prod_cfc_simd,                                                                        \
+    .sc_prod_fcc = srsran_vec_sc_prod_fcc_simd,                                                                        \
+    .sc_prod_fff = srsran_vec_sc_prod_fff_simd,                                                                        \
+    .sc_prod_ccc = srsran_vec_sc_prod_ccc_simd,                                                                        \
+    .prod_ccc_split = srsran_vec_prod_ccc_split_simd,                                                                  \
+    .prod_sss = srsran_vec_prod_sss_simd,                                                                              \
+    .neg_sss = srsran_vec_neg_sss_simd,                                                                                \
+    .neg_bbb = srsran_vec_neg_bbb_simd,                                                                                \
+    .prod_cfc = srsran_vec_prod_cfc_simd,                                                                              \
+    .prod_fff = srsran_vec_prod_fff_simd,                                                                              \
+    .prod_ccc = srsran_vec_prod_ccc_simd,                                                                              \
+    .prod_conj_ccc = srsran_vec_prod_conj_ccc_simd,                                                                    \
+    .div_ccc = srsran_vec_div_ccc_simd,                                                                                \
+    .div_cfc = srsran_vec_div_cfc_simd,                                                                                \
+    .div_fff = srsran_vec_div_fff_simd,                                                                                \
+    .dot_prod_conj_ccc = srsran_vec_dot_prod_conj_ccc_simd,                                                            \
+    .dot_prod_ccc = srsran_vec_dot_prod_ccc_simd,                                                                      \
+    .dot_prod_sss = srsran_vec_dot_prod_sss_simd,                                                                      \
+    .abs_cf = srsran_vec_abs_cf_simd,                                                                                  \
+    .abs_square_cf = srsran_vec_abs_square_cf_simd,                                                                    \
+    .lut_sss = srsran_vec_lut_sss_simd,                                                                                \
+    .lut_bbb = srsran_vec_lut_bbb_simd,                                                                                \
+    .convert_if = srsran_vec_convert_if_simd,                                                                          \
+    .convert_fi = srsran_vec_convert_fi_simd,                                                                          \
+    .convert_conj_cs = srsran_vec_convert_conj_cs_simd,                                                                \
+    .convert_fb = srsran_vec_convert_fb_simd,                                                                          \
+    .interleave = srsran_vec_interleave_simd,                                                                          \
+    .interleave_add = srsran_vec_interleave_add_simd,                                                                  \
+    .gen_sine = srsran_vec_gen_sine_simd,                                                                              \
+    .apply_cfo = srsran_vec_apply_cfo_simd,                                                                            \
+    .estimate_frequency = srsran_vec_estimate_frequency_simd,                                                          \
+    .max_fi = srsran_vec_max_fi_simd,                                                                                  \
+    .max_abs_fi = srsran_vec_max_abs_fi_simd,                                                                          \
+    .max_ci = srsran_vec_max_ci_simd                                                                                   \
+  }
+
+#ifdef SRSRAN_VEC_ISA_DISPATCH
+extern const srsran_vec_simd_table_t srsran_vec_simd_table_sse;
+extern const srsran_vec_simd_table_t srsran_vec_simd_table_avx2;
+extern const srsran_vec_simd_table_t srsran_vec_simd_table_avx512;
+#endif /* SRSRAN_VEC_ISA_DISPATCH */
+
+#endif // SRSRAN_VECTOR_SIMD_ISA_H
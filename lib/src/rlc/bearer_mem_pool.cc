@@ -24,6 +24,7 @@
 #include "srsran/rlc/rlc_am_lte.h"
 #include "srsran/rlc/rlc_um_lte.h"
 #include "srsran/rlc/rlc_um_nr.h"
+#include <atomic>
 
 namespace srsran {
 
@@ -49,5 +50,44 @@ void deallocate_rlc_bearer(void* p)
 {
   get_bearer_pool()->deallocate_node(p);
 }
+std::size_t rlc_bearer_block_size()
+{
+  return get_bearer_pool()->get_node_max_size();
+}
+
+namespace {
+
+std::atomic<bool> compact_windows{false};
+
+/// The Tx and Rx windows have similar sizes and share a pool, the PDU segments of the Tx side use a second one
+srsran::background_mem_pool* get_window_pool(std::size_t sz)
+{
+  static background_mem_pool window_pool(4,
+                                         std::max(sizeof(rlc_ringbuffer_t<rlc_amd_tx_pdu>::window_t),
+                                                  sizeof(rlc_ringbuffer_t<rlc_amd_rx_pdu>::window_t)),
+                                         8,
+                                         0);
+  static background_mem_pool segment_pool(4, rlc_am_pdu_segment_pool::storage_size, 8, 0);
+  return sz <= window_pool.get_node_max_size() ? &window_pool : &segment_pool;
+}
+
+} // namespace
+
+void set_rlc_compact_windows(bool enable)
+{
+  compact_windows.store(enable, std::memory_order_relaxed);
+}
+bool rlc_compact_windows()
+{
+  return compact_windows.load(std::memory_order_relaxed);
+}
+void* allocate_rlc_window(std::size_t sz)
+{
+  return get_window_pool(sz)->allocate_node(sz);
+}
+void deallocate_rlc_window(void* p, std::size_t sz)
+{
+  get_window_pool(sz)->deallocate_node(p);
+}
 
 } // namespace srsran
@@ -129,6 +129,19 @@ void rlc::get_metrics(rlc_metrics_t& m, const uint32_t nof_tti)
   reset_metrics();
 }
 
+size_t rlc::get_mem_footprint()
+{
+  rwlock_read_guard lock(rwlock);
+  size_t            bytes = sizeof(rlc);
+  for (auto& bearer : rlc_array) {
+    bytes += bearer.second->get_mem_footprint();
+  }
+  for (auto& bearer : rlc_array_mrb) {
+    bytes += bearer.second->get_mem_footprint();
+  }
+  return bytes;
+}
+
 // Reestablish all RLC bearer
 void rlc::reestablish()
 {
@@ -73,14 +73,14 @@ void log_rlc_am_status_pdu_to_string(srslog::log_channel& log_ch,
 
 int rlc_am_pdu_segment_pool::segment_resource::id() const
 {
-  return std::distance(parent_pool->segments.cbegin(), this);
+  return std::distance<const segment_resource*>(parent_pool->segments, this);
 }
 
 void rlc_am_pdu_segment_pool::segment_resource::release_pdcp_sn()
 {
   pdcp_sn_ = invalid_pdcp_sn;
   if (empty()) {
-    parent_pool->free_list.push_front(this);
+    parent_pool->release_segment(this);
   }
 }
 
@@ -88,26 +88,60 @@ void rlc_am_pdu_segment_pool::segment_resource::release_rlc_sn()
 {
   rlc_sn_ = invalid_rlc_sn;
   if (empty()) {
-    parent_pool->free_list.push_front(this);
+    parent_pool->release_segment(this);
   }
 }
 
 rlc_am_pdu_segment_pool::rlc_am_pdu_segment_pool()
 {
-  for (segment_resource& s : segments) {
-    s.parent_pool = this;
-    free_list.push_front(&s);
+  if (not rlc_compact_windows()) {
+    segments = static_cast<segment_resource*>(allocate_rlc_window(storage_size));
   }
 }
 
+rlc_am_pdu_segment_pool::~rlc_am_pdu_segment_pool()
+{
+  if (segments != nullptr) {
+    deallocate_rlc_window(segments, storage_size);
+  }
+}
+
+void rlc_am_pdu_segment_pool::release_segment(segment_resource* segment)
+{
+  free_list.push_front(segment);
+  nof_used--;
+}
+
+void rlc_am_pdu_segment_pool::shrink()
+{
+  if (segments == nullptr or nof_used > 0 or not rlc_compact_windows()) {
+    return;
+  }
+  // the segments are trivially destructible, the free list only has to forget them
+  free_list = {};
+  deallocate_rlc_window(segments, storage_size);
+  segments        = nullptr;
+  nof_constructed = 0;
+}
+
 bool rlc_am_pdu_segment_pool::make_segment(rlc_amd_tx_pdu& rlc_list, pdcp_pdu_info& pdcp_list)
 {
   if (not has_segments()) {
     return false;
   }
-  segment_resource* segment = free_list.pop_front();
-  segment->rlc_sn_          = rlc_list.rlc_sn;
-  segment->pdcp_sn_         = pdcp_list.sn;
+  segment_resource* segment = nullptr;
+  if (not free_list.empty()) {
+    segment = free_list.pop_front();
+  } else {
+    if (segments == nullptr) {
+      segments = static_cast<segment_resource*>(allocate_rlc_window(storage_size));
+    }
+    segment              = new (&segments[nof_constructed++]) segment_resource();
+    segment->parent_pool = this;
+  }
+  nof_used++;
+  segment->rlc_sn_  = rlc_list.rlc_sn;
+  segment->pdcp_sn_ = pdcp_list.sn;
   rlc_list.add_segment(*segment);
   pdcp_list.add_segment(*segment);
   return true;
@@ -228,6 +262,11 @@ void rlc_am_lte::reset_metrics()
   metrics = {};
 }
 
+size_t rlc_am_lte::get_mem_footprint()
+{
+  return rlc_common::get_mem_footprint() + tx.get_mem_footprint() + rx.get_mem_footprint();
+}
+
 /****************************************************************************
  * PDCP interface
  ***************************************************************************/
@@ -301,7 +340,8 @@ rlc_am_lte::rlc_am_lte_tx::rlc_am_lte_tx(rlc_am_lte* parent_) :
   logger(parent_->logger),
   pool(byte_buffer_pool::get_instance()),
   poll_retx_timer(parent_->timers->get_unique_timer()),
-  status_prohibit_timer(parent_->timers->get_unique_timer())
+  status_prohibit_timer(parent_->timers->get_unique_timer()),
+  compact_timer(parent_->timers->get_unique_timer())
 {}
 
 rlc_am_lte::rlc_am_lte_tx::~rlc_am_lte_tx() {}
@@ -311,6 +351,17 @@ void rlc_am_lte::rlc_am_lte_tx::set_bsr_callback(bsr_callback_t callback)
   bsr_callback = callback;
 }
 
+size_t rlc_am_lte::rlc_am_lte_tx::get_mem_footprint()
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  size_t bytes = segment_pool.get_mem_footprint() + undelivered_sdu_info_queue.get_mem_footprint() +
+                 tx_window.get_mem_footprint() + tx_sdu_queue.size() * sizeof(byte_buffer_t);
+  if (tx_sdu != nullptr) {
+    bytes += sizeof(byte_buffer_t);
+  }
+  return bytes;
+}
+
 bool rlc_am_lte::rlc_am_lte_tx::configure(const rlc_config_t& cfg_)
 {
   std::lock_guard<std::mutex> lock(mutex);
@@ -340,6 +391,10 @@ bool rlc_am_lte::rlc_am_lte_tx::configure(const rlc_config_t& cfg_)
     poll_retx_timer.set(static_cast<uint32_t>(cfg.t_poll_retx), [this](uint32_t timerid) { timer_expired(timerid); });
   }
 
+  if (rlc_compact_windows() and compact_timer.is_valid()) {
+    compact_timer.set(rlc_compact_idle_ms, [this](uint32_t timerid) { timer_expired(timerid); });
+  }
+
   // make sure Tx queue is empty before attempting to resize
   empty_queue_nolock();
   tx_sdu_queue.resize(cfg_.tx_queue_length);
@@ -369,6 +424,10 @@ void rlc_am_lte::rlc_am_lte_tx::stop_nolock()
     status_prohibit_timer.stop();
   }
 
+  if (parent->timers != nullptr && compact_timer.is_valid()) {
+    compact_timer.stop();
+  }
+
   vt_a    = 0;
   vt_ms   = RLC_AM_WINDOW_SIZE;
   vt_s    = 0;
@@ -385,6 +444,25 @@ void rlc_am_lte::rlc_am_lte_tx::stop_nolock()
 
   // Drop all SDU info in queue
   undelivered_sdu_info_queue.clear();
+
+  compact_nolock();
+}
+
+void rlc_am_lte::rlc_am_lte_tx::compact_nolock()
+{
+  // Give back the SDU info, the segments and the window once nothing is pending
+  undelivered_sdu_info_queue.shrink();
+  segment_pool.shrink();
+  tx_window.shrink();
+}
+
+void rlc_am_lte::rlc_am_lte_tx::schedule_compact_nolock()
+{
+  // The storage is only given back if the bearer is still idle when the timer expires, otherwise the next ACK that
+  // empties the window restarts it
+  if (tx_window.empty() and compact_timer.is_valid() and compact_timer.duration() > 0) {
+    compact_timer.run();
+  }
 }
 
 void rlc_am_lte::rlc_am_lte_tx::empty_queue()
@@ -642,6 +720,9 @@ void rlc_am_lte::rlc_am_lte_tx::timer_expired(uint32_t timeout_id)
     }
   } else if (status_prohibit_timer.is_valid() && status_prohibit_timer.id() == timeout_id) {
     logger.debug("%s Status prohibit timer expired after %dms", RB_NAME, status_prohibit_timer.duration());
+  } else if (compact_timer.is_valid() && compact_timer.id() == timeout_id) {
+    compact_nolock();
+    return;
   }
 
   if (bsr_callback) {
@@ -1350,6 +1431,7 @@ void rlc_am_lte::rlc_am_lte_tx::handle_control_pdu(uint8_t* payload, uint32_t no
       logger.error("%s vt_a=%d points to invalid position in Tx window.", RB_NAME, vt_a);
       parent->rrc->protocol_failure();
     }
+    schedule_compact_nolock();
   }
 
   debug_state();
@@ -1489,7 +1571,8 @@ rlc_am_lte::rlc_am_lte_rx::rlc_am_lte_rx(rlc_am_lte* parent_) :
   parent(parent_),
   pool(byte_buffer_pool::get_instance()),
   logger(parent_->logger),
-  reordering_timer(parent_->timers->get_unique_timer())
+  reordering_timer(parent_->timers->get_unique_timer()),
+  compact_timer(parent_->timers->get_unique_timer())
 {}
 
 rlc_am_lte::rlc_am_lte_rx::~rlc_am_lte_rx() {}
@@ -1510,6 +1593,10 @@ bool rlc_am_lte::rlc_am_lte_rx::configure(rlc_am_config_t cfg_)
     reordering_timer.set(static_cast<uint32_t>(cfg.t_reordering), [this](uint32_t tid) { timer_expired(tid); });
   }
 
+  if (rlc_compact_windows() and compact_timer.is_valid()) {
+    compact_timer.set(rlc_compact_idle_ms, [this](uint32_t tid) { timer_expired(tid); });
+  }
+
   return true;
 }
 
@@ -1526,6 +1613,10 @@ void rlc_am_lte::rlc_am_lte_rx::stop()
     reordering_timer.stop();
   }
 
+  if (parent->timers != nullptr && compact_timer.is_valid()) {
+    compact_timer.stop();
+  }
+
   rx_sdu.reset();
 
   vr_r  = 0;
@@ -1941,6 +2032,11 @@ void rlc_am_lte::rlc_am_lte_rx::write_pdu(uint8_t* payload, const uint32_t nof_b
     } else {
       handle_data_pdu(payload, payload_len, header);
     }
+
+    // The window is only given back if no PDU arrives while the timer runs
+    if (rx_window.empty() and compact_timer.is_valid() and compact_timer.duration() > 0) {
+      compact_timer.run();
+    }
   }
 }
 
@@ -1956,6 +2052,19 @@ uint32_t rlc_am_lte::rlc_am_lte_rx::get_sdu_rx_latency_ms()
   return sdu_rx_latency_ms.value();
 }
 
+size_t rlc_am_lte::rlc_am_lte_rx::get_mem_footprint()
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  size_t bytes = rx_window.get_mem_footprint();
+  for (const auto& pdu_segments : rx_segments) {
+    bytes += pdu_segments.second.segments.size() * sizeof(byte_buffer_t);
+  }
+  if (rx_sdu != nullptr) {
+    bytes += sizeof(byte_buffer_t);
+  }
+  return bytes;
+}
+
 /**
  * Function called from stack thread when timer has expired
  *
@@ -1983,6 +2092,8 @@ void rlc_am_lte::rlc_am_lte_rx::timer_expired(uint32_t timeout_id)
     }
 
     debug_state();
+  } else if (compact_timer.is_valid() and compact_timer.id() == timeout_id) {
+    rx_window.shrink();
   }
 }
 
@@ -2269,11 +2380,21 @@ void rlc_am_lte::rlc_am_lte_rx::debug_state()
   logger.debug("%s vr_r = %d, vr_mr = %d, vr_x = %d, vr_ms = %d, vr_h = %d", RB_NAME, vr_r, vr_mr, vr_x, vr_ms, vr_h);
 }
 
-buffered_pdcp_pdu_list::buffered_pdcp_pdu_list() : buffered_pdus(buffered_pdcp_pdu_list::buffer_size)
+buffered_pdcp_pdu_list::buffered_pdcp_pdu_list()
 {
+  if (not rlc_compact_windows()) {
+    buffered_pdus.resize(buffer_size);
+  }
   clear();
 }
 
+void buffered_pdcp_pdu_list::shrink()
+{
+  if (count == 0 and not buffered_pdus.empty() and rlc_compact_windows()) {
+    std::vector<pdcp_pdu_info>().swap(buffered_pdus);
+  }
+}
+
 void buffered_pdcp_pdu_list::clear()
 {
   count = 0;
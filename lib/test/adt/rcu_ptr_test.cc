@@ -0,0 +1,184 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/adt/rcu_ptr.h"
+#include "srsran/common/test_common.h"
+#include <map>
+#include <vector>
+
+namespace srsran {
+
+struct counted_obj {
+  static std::atomic<int> nof_alive;
+
+  counted_obj() { nof_alive++; }
+  counted_obj(const counted_obj& other) : a(other.a), b(other.b) { nof_alive++; }
+  ~counted_obj() { nof_alive--; }
+
+  uint32_t a = 0;
+  uint32_t b = 0;
+};
+
+std::atomic<int> counted_obj::nof_alive = {0};
+
+int test_rcu_ptr_single_thread()
+{
+  {
+    rcu_ptr<counted_obj> obj;
+    TESTASSERT(counted_obj::nof_alive == 1);
+    TESTASSERT(obj.read()->a == 0);
+
+    // TEST: modification is visible after publishing, the old object is destroyed
+    obj.modify([](counted_obj& o) { o.a = 5; });
+    TESTASSERT(obj.read()->a == 5);
+    TESTASSERT(counted_obj::nof_alive == 1);
+
+    // TEST: the return value of the modification function is forwarded
+    bool ret = obj.modify([](counted_obj& o) {
+      o.b = 3;
+      return o.a == 5;
+    });
+    TESTASSERT(ret);
+    TESTASSERT(obj.read()->b == 3);
+
+    // TEST: a read-side section keeps its snapshot after another thread publishes a new object
+    std::thread writer;
+    {
+      auto guard = obj.read();
+      writer     = std::thread([&obj]() { obj.modify([](counted_obj& o) { o.a = 10; }); });
+
+      // Wait for the new object to be published, the writer then waits for this reader to destroy the old one
+      while (obj.read()->a != 10) {
+        std::this_thread::yield();
+      }
+      TESTASSERT(guard->a == 5);
+      TESTASSERT(counted_obj::nof_alive == 2);
+
+      // A moved guard keeps the section open
+      auto guard2 = std::move(guard);
+      TESTASSERT(guard2->a == 5);
+      TESTASSERT(counted_obj::nof_alive == 2);
+    }
+    writer.join();
+    TESTASSERT(counted_obj::nof_alive == 1);
+
+    // TEST: a deferred modification does not wait for the readers, the next writer call destroys the old object
+    {
+      auto guard = obj.read();
+      obj.modify_deferred([](counted_obj& o) { o.a = 15; });
+      TESTASSERT(obj.read()->a == 15);
+      TESTASSERT(guard->a == 10);
+      TESTASSERT(counted_obj::nof_alive == 2);
+
+      // The old object is still held by the reader
+      obj.reclaim();
+      TESTASSERT(counted_obj::nof_alive == 2);
+    }
+    obj.reclaim();
+    TESTASSERT(counted_obj::nof_alive == 1);
+
+    // TEST: a deferred modification without readers destroys the old object right away
+    obj.modify_deferred([](counted_obj& o) { o.b = 4; });
+    TESTASSERT(obj.read()->b == 4);
+    TESTASSERT(counted_obj::nof_alive == 1);
+
+    // TEST: the grace period of a modification also covers the retired objects
+    {
+      auto guard = obj.read();
+      obj.modify_deferred([](counted_obj& o) { o.b = 5; });
+      TESTASSERT(counted_obj::nof_alive == 2);
+    }
+    obj.modify([](counted_obj& o) { o.b = 6; });
+    TESTASSERT(counted_obj::nof_alive == 1);
+
+    // TEST: reset replaces the whole object
+    std::unique_ptr<counted_obj> other(new counted_obj{});
+    other->a = 20;
+    obj.reset(std::move(other));
+    TESTASSERT(obj.read()->a == 20);
+    TESTASSERT(counted_obj::nof_alive == 1);
+  }
+  TESTASSERT(counted_obj::nof_alive == 0);
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_rcu_ptr_concurrent()
+{
+  const uint32_t nof_readers = 4;
+  const uint32_t nof_writes  = 2000;
+
+  // The writer keeps both values of every entry equal, readers must never see a torn or destroyed map
+  rcu_ptr<std::map<uint32_t, counted_obj> > db;
+  std::atomic<bool>                         running = {true};
+  std::atomic<uint32_t>                     nof_errors = {0};
+  std::vector<std::thread>                  readers;
+
+  for (uint32_t i = 0; i < nof_readers; i++) {
+    readers.emplace_back([&db, &running, &nof_errors]() {
+      while (running) {
+        auto snapshot = db.read();
+        for (const auto& e : *snapshot) {
+          if (e.second.a != e.second.b or e.second.a < e.first) {
+            nof_errors++;
+          }
+        }
+      }
+    });
+  }
+
+  for (uint32_t n = 0; n < nof_writes; n++) {
+    auto write = [n](std::map<uint32_t, counted_obj>& m) {
+      uint32_t key = n % 16;
+      if (n % 5 == 0) {
+        m.erase(key);
+      } else {
+        m[key].a = key + n;
+        m[key].b = key + n;
+      }
+    };
+    // Half of the writes do not wait for the readers
+    if (n % 2 == 0) {
+      db.modify(write);
+    } else {
+      db.modify_deferred(write);
+    }
+  }
+
+  running = false;
+  for (auto& t : readers) {
+    t.join();
+  }
+  TESTASSERT(nof_errors == 0);
+
+  return SRSRAN_SUCCESS;
+}
+
+} // namespace srsran
+
+int main()
+{
+  TESTASSERT(srsran::test_rcu_ptr_single_thread() == SRSRAN_SUCCESS);
+  TESTASSERT(srsran::test_rcu_ptr_concurrent() == SRSRAN_SUCCESS);
+  TESTASSERT(srsran::counted_obj::nof_alive == 0);
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
@@ -0,0 +1,170 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/edf_task_pool.h"
+#include "srsran/common/test_common.h"
+#include <atomic>
+#include <thread>
+
+using namespace std::chrono;
+using edf_time_point = srsran::edf_task_pool::time_point;
+
+int test_edf_order_no_workers()
+{
+  srsran::edf_task_pool             pool{2, 0};
+  srsran::edf_task_pool::task_group group;
+  std::vector<int>                  order;
+  edf_time_point                    now = steady_clock::now();
+
+  // TEST: tasks are run by the waiting producer in deadline order, ties are run in push order
+  pool.push_task(group, 0, now + milliseconds(3), [&order]() { order.push_back(3); });
+  pool.push_task(group, 1, now + milliseconds(1), [&order]() { order.push_back(1); });
+  pool.push_task(group, 0, now + milliseconds(2), [&order]() { order.push_back(2); });
+  pool.push_task(group, 1, now + milliseconds(3), [&order]() { order.push_back(4); });
+  TESTASSERT(group.nof_pending() == 4);
+  TESTASSERT(order.empty());
+
+  pool.wait(group);
+  TESTASSERT(group.nof_pending() == 0);
+  TESTASSERT(pool.nof_pending_tasks() == 0);
+  TESTASSERT(order == std::vector<int>({1, 2, 3, 4}));
+
+  // TEST: metrics are counted per type and reset on read
+  std::vector<srsran::edf_task_pool::type_metrics_t> m = pool.get_metrics();
+  TESTASSERT(m.size() == 2);
+  TESTASSERT(m[0].nof_tasks == 2 and m[1].nof_tasks == 2);
+  m = pool.get_metrics();
+  TESTASSERT(m[0].nof_tasks == 0 and m[1].nof_tasks == 0);
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_edf_deadline_miss()
+{
+  srsran::edf_task_pool             pool{2, 1};
+  srsran::edf_task_pool::task_group group;
+  edf_time_point                    now = steady_clock::now();
+
+  // TEST: a task finishing after its deadline is a miss and its slack is negative
+  pool.push_task(group, 0, now - milliseconds(1), []() {});
+  pool.push_task(group, 1, now + seconds(10), []() {});
+  pool.wait(group);
+
+  std::vector<srsran::edf_task_pool::type_metrics_t> m = pool.get_metrics();
+  TESTASSERT(m[0].nof_tasks == 1 and m[0].nof_misses == 1);
+  TESTASSERT(m[0].avg_slack_us < -1000 and m[0].min_slack_us < -1000);
+  TESTASSERT(m[1].nof_tasks == 1 and m[1].nof_misses == 0);
+  TESTASSERT(m[1].min_slack_us > 1e6);
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_edf_order_worker()
+{
+  srsran::edf_task_pool             pool{1, 1};
+  srsran::edf_task_pool::task_group blocker, group;
+  std::atomic<bool>                 release = {false}, blocked = {false};
+  std::vector<int>                  order;
+  edf_time_point                    now = steady_clock::now();
+
+  // Keep the only worker busy while the tasks are pushed
+  pool.push_task(blocker, 0, now, [&release, &blocked]() {
+    blocked = true;
+    while (not release) {
+      std::this_thread::yield();
+    }
+  });
+  while (not blocked) {
+    std::this_thread::yield();
+  }
+
+  // TEST: the worker picks the tasks pushed meanwhile in deadline order
+  for (int i = 9; i >= 0; --i) {
+    pool.push_task(group, 0, now + milliseconds(i), [&order, i]() { order.push_back(i); });
+  }
+  release = true;
+  pool.wait(blocker);
+  pool.wait(group);
+
+  TESTASSERT(order.size() == 10);
+  for (int i = 0; i < 10; ++i) {
+    TESTASSERT(order[i] == i);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_edf_concurrent_producers()
+{
+  const uint32_t nof_producers = 4;
+  const uint32_t nof_rounds    = 200;
+  const uint32_t nof_tasks     = 8;
+
+  srsran::edf_task_pool    pool{2, 2};
+  std::atomic<uint32_t>    count = {0};
+  std::vector<std::thread> producers;
+
+  // TEST: groups of several producers complete independently and every task runs once
+  for (uint32_t p = 0; p < nof_producers; ++p) {
+    producers.emplace_back([&pool, &count, p]() {
+      for (uint32_t r = 0; r < nof_rounds; ++r) {
+        srsran::edf_task_pool::task_group group;
+        std::atomic<uint32_t>             local    = {0};
+        edf_time_point                    deadline = steady_clock::now() + milliseconds(1);
+        for (uint32_t t = 0; t < nof_tasks; ++t) {
+          pool.push_task(group, p % 2, deadline, [&count, &local]() {
+            count++;
+            local++;
+          });
+        }
+        pool.wait(group);
+        if (local != nof_tasks) {
+          count = 0;
+        }
+      }
+    });
+  }
+  for (std::thread& t : producers) {
+    t.join();
+  }
+  TESTASSERT(count == nof_producers * nof_rounds * nof_tasks);
+
+  std::vector<srsran::edf_task_pool::type_metrics_t> m = pool.get_metrics();
+  TESTASSERT(m[0].nof_tasks + m[1].nof_tasks == nof_producers * nof_rounds * nof_tasks);
+
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  auto& logger = srslog::fetch_basic_logger("POOL", false);
+  logger.set_level(srslog::basic_levels::info);
+  srslog::init();
+
+  TESTASSERT(test_edf_order_no_workers() == SRSRAN_SUCCESS);
+  TESTASSERT(test_edf_deadline_miss() == SRSRAN_SUCCESS);
+  TESTASSERT(test_edf_order_worker() == SRSRAN_SUCCESS);
+  TESTASSERT(test_edf_concurrent_producers() == SRSRAN_SUCCESS);
+
+  srslog::flush();
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
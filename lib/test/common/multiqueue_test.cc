@@ -306,6 +306,74 @@ int test_multiqueue_threading4()
   return 0;
 }
 
+int test_multiqueue_classes()
+{
+  std::cout << "\n===== TEST multiqueue classes test: start =====\n";
+  // Description: the queues of lower classes are popped first, and a consumer blocked on a subset of the classes is
+  //              only woken up by pushes to those classes
+
+  int                     number = 0;
+  multiqueue_handler<int> multiqueue(8);
+  auto                    qbulk1 = multiqueue.add_queue(8, 2);
+  auto                    qbulk2 = multiqueue.add_queue(8, 2);
+  auto                    qcrit  = multiqueue.add_queue(8, 0);
+
+  TESTASSERT(qbulk1.try_push(10));
+  TESTASSERT(qbulk1.try_push(11));
+  TESTASSERT(qbulk2.try_push(20));
+  TESTASSERT(qcrit.try_push(0));
+
+  multiqueue_pop_info info;
+  TESTASSERT(multiqueue.wait_pop(&number, multiqueue.all_classes, &info) and number == 0);
+  TESTASSERT(info.queue_class == 0);
+  TESTASSERT(info.push_time <= std::chrono::steady_clock::now());
+
+  // round-robin within the class
+  TESTASSERT(multiqueue.wait_pop(&number, multiqueue.all_classes, &info) and number == 10);
+  TESTASSERT(info.queue_class == 2);
+  TESTASSERT(qcrit.try_push(1));
+  TESTASSERT(multiqueue.wait_pop(&number) and number == 1);
+  TESTASSERT(multiqueue.wait_pop(&number) and number == 20);
+
+  // masked classes are not popped
+  TESTASSERT(not multiqueue.try_pop(&number, 1U << 0U));
+  TESTASSERT(multiqueue.try_pop(&number, 1U << 2U) and number == 11);
+
+  // a reused queue takes the class it is added with
+  qcrit.reset();
+  qcrit = multiqueue.add_queue(8, 1);
+  TESTASSERT(qcrit.try_push(5));
+  TESTASSERT(not multiqueue.try_pop(&number, 1U << 0U));
+  TESTASSERT(multiqueue.try_pop(&number, 1U << 1U) and number == 5);
+
+  // the consumer waits only for the unmasked class
+  std::atomic<int> popped{-1};
+  std::thread      t1([&multiqueue, &popped]() {
+    int value = 0;
+    if (multiqueue.wait_pop(&value, 1U << 1U)) {
+      popped = value;
+    }
+  });
+  TESTASSERT(qbulk1.try_push(12));
+  usleep(1000);
+  TESTASSERT(popped == -1);
+  TESTASSERT(qcrit.try_push(6));
+  for (int count = 0; popped == -1; ++count) {
+    usleep(100);
+    TESTASSERT(count < 10000);
+  }
+  TESTASSERT(popped == 6);
+  t1.join();
+  TESTASSERT(qbulk1.size() == 1);
+
+  multiqueue.stop();
+
+  std::cout << "outcome: Success\n";
+  std::cout << "===================================================\n";
+
+  return 0;
+}
+
 int test_task_thread_pool()
 {
   std::cout << "\n====== TEST task thread pool test 1: start ======\n";
@@ -410,6 +478,73 @@ int test_task_thread_pool3()
   return 0;
 }
 
+int test_serial_task_queue()
+{
+  std::cout << "\n====== TEST serial task queue: start ======\n";
+  // Description: tasks of each queue run in order and never concurrently, while different queues share the workers
+
+  const uint32_t nof_workers = 4, nof_queues = 8, nof_runs = 2000;
+
+  task_thread_pool                                  thread_pool(nof_workers);
+  std::vector<std::unique_ptr<serial_task_queue> >  queues;
+  std::vector<uint32_t>                             count(nof_queues, 0);
+  std::vector<std::unique_ptr<std::atomic<bool> > > busy;
+  std::atomic<uint32_t>                             nof_errors{0}, nof_done{0};
+
+  for (uint32_t q = 0; q < nof_queues; ++q) {
+    queues.emplace_back(new serial_task_queue(thread_pool));
+    busy.emplace_back(new std::atomic<bool>(false));
+  }
+  for (uint32_t i = 0; i < nof_runs; ++i) {
+    for (uint32_t q = 0; q < nof_queues; ++q) {
+      queues[q]->push_task([&, q, i]() {
+        if (busy[q]->exchange(true) or count[q] != i) {
+          nof_errors++;
+        }
+        count[q]++;
+        busy[q]->store(false);
+        nof_done++;
+      });
+    }
+  }
+
+  while (nof_done < nof_queues * nof_runs) {
+    usleep(100);
+  }
+  TESTASSERT(nof_errors == 0);
+
+  // TEST: pending tasks are discarded when the queue is destroyed, the token expires
+  std::atomic<bool>   release{false}, run{false};
+  std::weak_ptr<void> token = queues[0]->alive_token();
+  queues[0]->push_task([&release]() {
+    while (not release) {
+      usleep(100);
+    }
+  });
+  queues[0]->push_task([&run]() { run = true; });
+  queues[0].reset();
+  TESTASSERT(token.expired());
+  release = true;
+  thread_pool.stop();
+  TESTASSERT(not run);
+
+  // TEST: the tasks run in order in the calling thread when the pool does not accept more tasks
+  task_thread_pool full_pool(1, true);
+  while (full_pool.try_push_task([]() {})) {
+  }
+  serial_task_queue inline_queue(full_pool);
+  std::vector<int>  order;
+  std::thread::id   caller = std::this_thread::get_id();
+  inline_queue.push_task([&order, caller]() { order.push_back(std::this_thread::get_id() == caller ? 1 : -1); });
+  inline_queue.push_task([&order, caller]() { order.push_back(std::this_thread::get_id() == caller ? 2 : -1); });
+  TESTASSERT(order == std::vector<int>({1, 2}));
+  TESTASSERT(inline_queue.nof_pending_tasks() == 0);
+
+  std::cout << "outcome: Success\n";
+  std::cout << "===================================================\n";
+  return 0;
+}
+
 struct C {
   std::unique_ptr<int> val{new int{5}};
 };
@@ -499,10 +634,12 @@ int main()
   TESTASSERT(test_multiqueue_threading2() == 0);
   TESTASSERT(test_multiqueue_threading3() == 0);
   TESTASSERT(test_multiqueue_threading4() == 0);
+  TESTASSERT(test_multiqueue_classes() == 0);
 
   TESTASSERT(test_task_thread_pool() == 0);
   TESTASSERT(test_task_thread_pool2() == 0);
   TESTASSERT(test_task_thread_pool3() == 0);
+  TESTASSERT(test_serial_task_queue() == 0);
 
   TESTASSERT(test_inplace_task() == 0);
 }
@@ -0,0 +1,221 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#include "srsran/common/pcap_writer.h"
+#include "srsran/common/test_common.h"
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+
+namespace srsran {
+
+int test_pcap_ring_concurrent()
+{
+  const uint32_t nof_producers = 4;
+  const uint32_t nof_records   = 20000;
+
+  // Small ring, so that records wrap around and producers find it full
+  pcap_ring                ring(4096);
+  std::atomic<bool>        done       = {false};
+  std::atomic<uint32_t>    nof_pushed = {0};
+  std::vector<uint32_t>    next_seq(nof_producers, 0);
+  uint32_t                 nof_popped = 0;
+  uint32_t                 nof_errors = 0;
+  std::vector<std::thread> producers;
+
+  for (uint32_t p = 0; p < nof_producers; p++) {
+    producers.emplace_back([&ring, &nof_pushed, p]() {
+      uint32_t seq = 0;
+      while (seq < nof_records) {
+        // Record: producer index, sequence number and a variable length payload
+        uint32_t len = 8 + (seq % 100);
+        bool     ret = ring.push(len, [p, seq, len](uint8_t* data) {
+          memcpy(data, &p, sizeof(p));
+          memcpy(data + 4, &seq, sizeof(seq));
+          memset(data + 8, seq & 0xffU, len - 8);
+          return len;
+        });
+        if (ret) {
+          seq++;
+          nof_pushed++;
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  auto consume = [&](const uint8_t* data, uint32_t len) {
+    uint32_t p, seq;
+    memcpy(&p, data, sizeof(p));
+    memcpy(&seq, data + 4, sizeof(seq));
+    // Records of each producer are received in order and intact
+    if (p >= nof_producers or seq != next_seq[p] or len != 8 + (seq % 100) or
+        (len > 8 and data[len - 1] != (seq & 0xffU))) {
+      nof_errors++;
+    }
+    if (p < nof_producers) {
+      next_seq[p] = seq + 1;
+    }
+    nof_popped++;
+  };
+  std::thread consumer([&]() {
+    while (not done) {
+      ring.pop_all(consume);
+    }
+    ring.pop_all(consume);
+  });
+
+  for (auto& t : producers) {
+    t.join();
+  }
+  done = true;
+  consumer.join();
+
+  TESTASSERT(nof_errors == 0);
+  TESTASSERT(nof_pushed == nof_producers * nof_records);
+  TESTASSERT(nof_popped == nof_producers * nof_records);
+  TESTASSERT(ring.empty());
+
+  // A record larger than the ring is rejected
+  TESTASSERT(not ring.push(8192, [](uint8_t*) { return 0U; }));
+
+  // A stopped ring rejects all records
+  ring.stop();
+  TESTASSERT(not ring.push(8, [](uint8_t*) { return 8U; }));
+  ring.release();
+
+  return SRSRAN_SUCCESS;
+}
+
+static off_t file_size(const std::string& name)
+{
+  struct stat st = {};
+  if (stat(name.c_str(), &st) != 0) {
+    return -1;
+  }
+  return st.st_size;
+}
+
+int test_pcap_writer_file()
+{
+  srslog::basic_logger& logger  = srslog::fetch_basic_logger("PCAP");
+  const std::string     name    = "/tmp/pcap_writer_test.pcap";
+  const uint32_t        pdu_len = 100;
+  uint8_t               pdu[pdu_len];
+  memset(pdu, 0xab, pdu_len);
+
+  auto pack = [&pdu](uint8_t* data) {
+    memcpy(data, pdu, pdu_len);
+    return pdu_len;
+  };
+
+  // TEST: all records are written after the PCAP file header
+  {
+    pcap_writer writer("PCAP_TEST", logger);
+    TESTASSERT(not writer.write(pdu_len, pack));
+    TESTASSERT(writer.open(name, UDP_DLT) == SRSRAN_SUCCESS);
+    TESTASSERT(writer.open(name, UDP_DLT) != SRSRAN_SUCCESS);
+    for (uint32_t i = 0; i < 1000; i++) {
+      TESTASSERT(writer.write(pdu_len, pack));
+    }
+    writer.close();
+    TESTASSERT(not writer.is_open());
+    TESTASSERT(writer.get_nof_dropped() == 0);
+    TESTASSERT(file_size(name) == (off_t)(sizeof(pcap_hdr_t) + 1000 * (sizeof(pcaprec_hdr_t) + pdu_len)));
+    unlink(name.c_str());
+  }
+
+  // TEST: a new file is started every time the size limit is reached
+  {
+    const std::string name_1   = "/tmp/pcap_writer_test_1.pcap";
+    const std::string name_2   = "/tmp/pcap_writer_test_2.pcap";
+    const uint32_t    nof_pdus = 15000; // ~1.7 MB
+
+    pcap_writer     writer("PCAP_TEST", logger);
+    pcap_rotation_t rotation;
+    rotation.max_size_mb = 1;
+    TESTASSERT(writer.open(name, UDP_DLT, rotation) == SRSRAN_SUCCESS);
+    for (uint32_t i = 0; i < nof_pdus; i++) {
+      while (not writer.write(pdu_len, pack)) {
+        std::this_thread::yield();
+      }
+    }
+    writer.close();
+
+    off_t size_0 = file_size(name), size_1 = file_size(name_1);
+    TESTASSERT(size_0 > 0 and size_0 <= 1024 * 1024);
+    TESTASSERT(size_1 > 0 and size_1 <= 1024 * 1024);
+    TESTASSERT(file_size(name_2) < 0);
+    size_t record_size = sizeof(pcaprec_hdr_t) + pdu_len;
+    TESTASSERT((size_t)(size_0 + size_1) == 2 * sizeof(pcap_hdr_t) + nof_pdus * record_size);
+    unlink(name.c_str());
+    unlink(name_1.c_str());
+  }
+
+  // TEST: every record accepted while the writer is being closed is written, also after opening it again
+  {
+    const uint32_t nof_producers = 4;
+
+    pcap_writer writer("PCAP_TEST", logger, pcap_writer::small_ring_size);
+    for (uint32_t run = 0; run < 2; run++) {
+      TESTASSERT(writer.open(name, UDP_DLT) == SRSRAN_SUCCESS);
+
+      std::atomic<uint32_t>    nof_written = {0};
+      std::vector<std::thread> producers;
+      for (uint32_t p = 0; p < nof_producers; p++) {
+        producers.emplace_back([&writer, &nof_written, &pack]() {
+          while (writer.is_open()) {
+            if (writer.write(pdu_len, pack)) {
+              nof_written++;
+            }
+          }
+        });
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+      writer.close();
+      for (auto& t : producers) {
+        t.join();
+      }
+
+      TESTASSERT(nof_written > 0);
+      TESTASSERT(file_size(name) == (off_t)(sizeof(pcap_hdr_t) + nof_written * (sizeof(pcaprec_hdr_t) + pdu_len)));
+      unlink(name.c_str());
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+} // namespace srsran
+
+int main()
+{
+  srslog::init();
+
+  TESTASSERT(srsran::test_pcap_ring_concurrent() == SRSRAN_SUCCESS);
+  TESTASSERT(srsran::test_pcap_writer_file() == SRSRAN_SUCCESS);
+
+  srslog::flush();
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
@@ -0,0 +1,166 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/stage_profiler.h"
+#include "srsran/common/test_common.h"
+#include <cmath>
+#include <thread>
+
+namespace srsran {
+
+static void busy_wait_us(uint32_t us)
+{
+  std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+  while (std::chrono::steady_clock::now() - t0 < std::chrono::microseconds(us)) {
+  }
+}
+
+int test_stage_profiler_period()
+{
+  stage_profiler prof(3);
+
+  // TEST: stages that did not run in a period do not get a sample, the others get one per period
+  for (uint32_t n = 0; n < 10; n++) {
+    stage_profiler::period_t period;
+    {
+      stage_profiler::scoped_timer t(period, 0);
+      busy_wait_us(200);
+    }
+    {
+      stage_profiler::scoped_timer t(period, 0);
+      busy_wait_us(100);
+    }
+    prof.commit(period);
+  }
+
+  std::vector<stage_profiler::stage_metrics_t> m = prof.get_metrics();
+  TESTASSERT(m.size() == 3);
+  TESTASSERT(m[0].count == 10);
+  TESTASSERT(m[1].count == 0);
+  TESTASSERT(m[2].count == 0);
+
+  // TEST: both timed sections of a period are added in the same sample
+  TESTASSERT(m[0].avg_us >= 290 and m[0].avg_us < 2000);
+  TESTASSERT(m[0].max_us >= m[0].avg_us);
+  TESTASSERT(m[0].p99_us >= 290 and m[0].p99_us <= m[0].max_us);
+
+  uint32_t total = 0;
+  for (uint32_t b = 0; b < stage_profiler::nof_buckets; b++) {
+    total += m[0].histogram[b];
+  }
+  TESTASSERT(total == 10);
+
+  // TEST: metrics are reset after being read
+  m = prof.get_metrics();
+  TESTASSERT(m[0].count == 0);
+  TESTASSERT(m[0].histogram[9] == 0);
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_stage_profiler_histogram()
+{
+  stage_profiler prof(1);
+
+  // Convert microseconds into counter cycles with the rate estimated from a known busy wait
+  uint64_t t0 = read_cycle_counter();
+  busy_wait_us(10000);
+  double cycles_per_us = (double)(read_cycle_counter() - t0) / 10000.0;
+  prof.get_metrics();
+
+  // TEST: durations below 16 us have 1 us buckets, each power of two range above is split in 8 buckets
+  TESTASSERT(stage_profiler::bucket_index(3) == 3);
+  TESTASSERT(stage_profiler::bucket_index(15) == 15);
+  TESTASSERT(stage_profiler::bucket_index(16) == 16);
+  TESTASSERT(stage_profiler::bucket_lower_us(stage_profiler::bucket_index(33)) == 32.0f);
+  TESTASSERT(stage_profiler::bucket_upper_us(stage_profiler::bucket_index(33)) == 36.0f);
+  TESTASSERT(stage_profiler::bucket_upper_us(stage_profiler::bucket_index(4095)) == 4096.0f);
+  TESTASSERT(stage_profiler::bucket_index(4096) == stage_profiler::nof_buckets - 1);
+  for (uint32_t us = 0; us < 5000; us++) {
+    uint32_t b = stage_profiler::bucket_index(us);
+    TESTASSERT(b < stage_profiler::nof_buckets);
+    TESTASSERT(stage_profiler::bucket_lower_us(b) <= us and us < stage_profiler::bucket_upper_us(b));
+  }
+
+  // TEST: samples are added to the bucket of their duration
+  prof.add(0, (uint64_t)(0.5 * cycles_per_us));
+  prof.add(0, (uint64_t)(3.5 * cycles_per_us));
+  prof.add(0, (uint64_t)(300 * cycles_per_us));
+  prof.add(0, (uint64_t)(100000 * cycles_per_us));
+  std::vector<stage_profiler::stage_metrics_t> m = prof.get_metrics();
+  TESTASSERT(m[0].count == 4);
+  TESTASSERT(m[0].histogram[0] == 1);
+  TESTASSERT(m[0].histogram[3] == 1);
+  TESTASSERT(m[0].histogram[stage_profiler::bucket_index(300)] == 1);
+  TESTASSERT(m[0].histogram[stage_profiler::nof_buckets - 1] == 1);
+  TESTASSERT(std::abs(m[0].max_us - 100000) < 10000);
+  TESTASSERT(std::isinf(stage_profiler::bucket_upper_us(stage_profiler::nof_buckets - 1)));
+
+  // TEST: the 99th percentile is the upper edge of its bucket, so it overestimates it by less than 1/8
+  for (uint32_t n = 0; n < 100; n++) {
+    prof.add(0, (uint64_t)(33.5 * cycles_per_us));
+  }
+  m = prof.get_metrics();
+  TESTASSERT(m[0].p99_us == 36.0f or m[0].p99_us == m[0].max_us);
+  TESTASSERT(m[0].p99_us >= 33.0f and m[0].p99_us <= 36.0f);
+
+  // TEST: samples out of the configured stages are ignored
+  prof.add(1, 100);
+  TESTASSERT(prof.get_metrics()[0].count == 0);
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_stage_profiler_concurrent()
+{
+  const uint32_t nof_threads = 4;
+  const uint32_t nof_samples = 10000;
+
+  stage_profiler           prof(2);
+  std::vector<std::thread> threads;
+  for (uint32_t i = 0; i < nof_threads; i++) {
+    threads.emplace_back([&prof, i]() {
+      for (uint32_t n = 0; n < nof_samples; n++) {
+        prof.add(i % 2, 1000 + n);
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  std::vector<stage_profiler::stage_metrics_t> m = prof.get_metrics();
+  TESTASSERT(m[0].count == nof_threads / 2 * nof_samples);
+  TESTASSERT(m[1].count == nof_threads / 2 * nof_samples);
+
+  return SRSRAN_SUCCESS;
+}
+
+} // namespace srsran
+
+int main()
+{
+  TESTASSERT(srsran::test_stage_profiler_period() == SRSRAN_SUCCESS);
+  TESTASSERT(srsran::test_stage_profiler_histogram() == SRSRAN_SUCCESS);
+  TESTASSERT(srsran::test_stage_profiler_concurrent() == SRSRAN_SUCCESS);
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
@@ -78,8 +78,56 @@ int test_task_scheduler_with_pool()
   return SRSRAN_SUCCESS;
 }
 
+int test_task_scheduler_priorities()
+{
+  srsran::task_scheduler task_sched{16, 0};
+  std::vector<int>       order;
+
+  auto bulk_queue    = task_sched.make_task_queue(srsran::task_priority::bulk);
+  auto control_queue = task_sched.make_task_queue(srsran::task_priority::control);
+  auto sync_queue    = task_sched.make_task_queue(srsran::task_priority::tti_critical);
+
+  // TEST: the tasks run in order of priority class
+  bulk_queue.push([&order]() { order.push_back(2); });
+  control_queue.push([&order]() { order.push_back(1); });
+  sync_queue.push([&order]() { order.push_back(0); });
+  task_sched.run_pending_tasks();
+  TESTASSERT(order == std::vector<int>({0, 1, 2}));
+  TESTASSERT(task_sched.get_task_metrics(srsran::task_priority::tti_critical).nof_tasks == 1);
+  TESTASSERT(task_sched.get_task_metrics(srsran::task_priority::bulk).nof_tasks == 1);
+
+  // TEST: once the bulk class uses up its budget, its tasks wait for the next tic
+  order.clear();
+  task_sched.set_task_budget(srsran::task_priority::bulk, std::chrono::microseconds(1));
+  for (int i = 0; i < 3; ++i) {
+    bulk_queue.push([&order, i]() {
+      order.push_back(10 + i);
+      std::this_thread::sleep_for(std::chrono::microseconds(10));
+    });
+  }
+  TESTASSERT(task_sched.run_next_task());
+  TESTASSERT(order == std::vector<int>({10}));
+  control_queue.push([&order]() { order.push_back(1); });
+  TESTASSERT(task_sched.run_next_task());
+  TESTASSERT(order == std::vector<int>({10, 1}));
+  TESTASSERT(task_sched.get_task_metrics(srsran::task_priority::bulk).nof_budget_exhausted == 1);
+
+  task_sched.tic();
+  TESTASSERT(task_sched.run_next_task());
+  TESTASSERT(order == std::vector<int>({10, 1, 11}));
+
+  // TEST: the latency histogram counts all the tasks
+  const srsran::task_class_metrics_t& m = task_sched.get_task_metrics(srsran::task_priority::bulk);
+  TESTASSERT(m.nof_tasks == 3);
+  TESTASSERT(m.latency_percentile_us(100) <= std::max<uint64_t>(m.max_latency_us, 1ULL << 15U));
+
+  task_sched.stop();
+  return SRSRAN_SUCCESS;
+}
+
 int main()
 {
   TESTASSERT(test_task_scheduler_no_pool() == SRSRAN_SUCCESS);
   TESTASSERT(test_task_scheduler_with_pool() == SRSRAN_SUCCESS);
+  TESTASSERT(test_task_scheduler_priorities() == SRSRAN_SUCCESS);
 }
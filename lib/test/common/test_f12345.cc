@@ -21,6 +21,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "srsran/common/liblte_security.h"
 #include "srsran/common/security.h"
@@ -159,6 +160,27 @@ int test_set_2()
   uint8_t ak_star[] = {0x45, 0x1e, 0x8b, 0xec, 0xa4, 0x3b};
   err_cmp           = arrcmp(ak_star_o, ak_star, sizeof(ak_star));
   TESTASSERT(err_cmp == 0);
+
+  // f12345, with SQN and AMF taken from AUTN
+  uint8_t autn[16] = {};
+  for (uint32_t i = 0; i < 6; i++) {
+    autn[i] = sqn[i] ^ ak[i];
+  }
+  autn[6] = amf[0];
+  autn[7] = amf[1];
+  memset(mac_o, 0, sizeof(mac_o));
+  memset(res_o, 0, sizeof(res_o));
+  memset(ck_o, 0, sizeof(ck_o));
+  memset(ik_o, 0, sizeof(ik_o));
+  memset(ak_o, 0, sizeof(ak_o));
+
+  err_lte = liblte_security_milenage_f12345(k, opc_o, rand, autn, mac_o, res_o, ck_o, ik_o, ak_o);
+  TESTASSERT(err_lte == LIBLTE_SUCCESS);
+  TESTASSERT(arrcmp(mac_o, mac_a, sizeof(mac_a)) == 0);
+  TESTASSERT(arrcmp(res_o, res, sizeof(res)) == 0);
+  TESTASSERT(arrcmp(ck_o, ck, sizeof(ck)) == 0);
+  TESTASSERT(arrcmp(ik_o, ik, sizeof(ik)) == 0);
+  TESTASSERT(arrcmp(ak_o, ak, sizeof(ak)) == 0);
   return SRSRAN_SUCCESS;
 }
 
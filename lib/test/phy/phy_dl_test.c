@@ -318,23 +318,36 @@ static int check_evm(srsran_enb_dl_t* enb_dl, srsran_ue_dl_t* ue_dl, srsran_ue_d
 
 int main(int argc, char** argv)
 {
-  srsran_enb_dl_t*        enb_dl      = srsran_vec_malloc(sizeof(srsran_enb_dl_t));
-  srsran_ue_dl_t*         ue_dl       = srsran_vec_malloc(sizeof(srsran_ue_dl_t));
-  srsran_random_t         random      = srsran_random_init(0);
-  struct timeval          t[3]        = {};
+  srsran_enb_dl_t*        enb_dl       = srsran_vec_malloc(sizeof(srsran_enb_dl_t));
+  srsran_ue_dl_t*         ue_dl        = srsran_vec_malloc(sizeof(srsran_ue_dl_t));
+  srsran_ue_dl_t*         ue_dl_shared = srsran_vec_malloc(sizeof(srsran_ue_dl_t));
+  srsran_random_t         random       = srsran_random_init(0);
+  struct timeval          t[3]         = {};
   size_t                  tx_nof_bits = 0, rx_nof_bits = 0;
   srsran_softbuffer_tx_t* softbuffer_tx[SRSRAN_MAX_TB] = {};
   srsran_softbuffer_rx_t* softbuffer_rx[SRSRAN_MAX_TB] = {};
   uint8_t*                data_tx[SRSRAN_MAX_TB]       = {};
   uint8_t*                data_rx[SRSRAN_MAX_TB]       = {};
   uint32_t                count_failures = 0, count_tbs = 0;
-  size_t                  pdsch_decode_us = 0;
-  size_t                  pdsch_encode_us = 0;
-  srsran_channel_awgn_t   awgn            = {};
-  float                   snr_db_avg      = 0.0;
+  size_t                  pdsch_decode_us  = 0;
+  size_t                  pdsch_encode_us  = 0;
+  size_t                  shared_decode_us = 0;
+  srsran_channel_awgn_t   awgn             = {};
+  float                   snr_db_avg       = 0.0;
 
   int ret = -1;
 
+  // The objects are freed by any error path, they must be zeroed until they are initialised
+  if (enb_dl) {
+    SRSRAN_MEM_ZERO(enb_dl, srsran_enb_dl_t, 1);
+  }
+  if (ue_dl) {
+    SRSRAN_MEM_ZERO(ue_dl, srsran_ue_dl_t, 1);
+  }
+  if (ue_dl_shared) {
+    SRSRAN_MEM_ZERO(ue_dl_shared, srsran_ue_dl_t, 1);
+  }
+
   parse_args(argc, argv);
 
   cf_t* signal_buffer[SRSRAN_MAX_PORTS] = {NULL};
@@ -356,22 +369,24 @@ int main(int argc, char** argv)
   }
 
   for (int i = 0; i < SRSRAN_MAX_TB; i++) {
-    softbuffer_tx[i] = (srsran_softbuffer_tx_t*)calloc(sizeof(srsran_softbuffer_tx_t), 1);
+    softbuffer_tx[i] = srsran_vec_malloc(sizeof(srsran_softbuffer_tx_t));
     if (!softbuffer_tx[i]) {
       ERROR("Error allocating softbuffer_tx");
       goto quit;
     }
+    SRSRAN_MEM_ZERO(softbuffer_tx[i], srsran_softbuffer_tx_t, 1);
 
     if (srsran_softbuffer_tx_init(softbuffer_tx[i], cell.nof_prb)) {
       ERROR("Error initiating softbuffer_tx");
       goto quit;
     }
 
-    softbuffer_rx[i] = (srsran_softbuffer_rx_t*)calloc(sizeof(srsran_softbuffer_rx_t), 1);
+    softbuffer_rx[i] = srsran_vec_malloc(sizeof(srsran_softbuffer_rx_t));
     if (!softbuffer_rx[i]) {
       ERROR("Error allocating softbuffer_rx");
       goto quit;
     }
+    SRSRAN_MEM_ZERO(softbuffer_rx[i], srsran_softbuffer_rx_t, 1);
 
     if (srsran_softbuffer_rx_init(softbuffer_rx[i], cell.nof_prb)) {
       ERROR("Error initiating softbuffer_rx");
@@ -428,6 +443,17 @@ int main(int argc, char** argv)
     goto quit;
   }
 
+  // Second UE context sharing the OFDM demodulation and channel estimation of the first one
+  if (srsran_ue_dl_init_shared(ue_dl_shared, ue_dl, cell.nof_prb)) {
+    ERROR("Error initiating shared UE downlink");
+    goto quit;
+  }
+
+  if (srsran_ue_dl_set_cell(ue_dl_shared, cell)) {
+    ERROR("Error setting shared UE downlink cell");
+    goto quit;
+  }
+
   /*
    * Create PDCCH Allocations
    */
@@ -625,6 +651,28 @@ int main(int argc, char** argv)
     get_time_interval(t);
     pdsch_decode_us += (size_t)(t[0].tv_sec * 1e6 + t[0].tv_usec);
 
+    // The shared context must decode the same transport blocks without running FFT nor estimation
+    gettimeofday(&t[1], NULL);
+    srsran_pdsch_res_t pdsch_res_shared[SRSRAN_MAX_CODEWORDS] = {};
+    srsran_ue_dl_cfg_t ue_dl_cfg_shared                       = ue_dl_cfg;
+    srsran_dci_dl_t    dci_dl_shared[SRSRAN_MAX_DCI_MSG]      = {};
+    for (int i = 0; i < SRSRAN_MAX_CODEWORDS; i++) {
+      pdsch_res_shared[i].payload = data_rx[i];
+    }
+    if (work_ue(ue_dl_shared, &sf_cfg_dl, &ue_dl_cfg_shared, dci_dl_shared, sf_idx, pdsch_res_shared)) {
+      goto quit;
+    }
+    for (int i = 0; i < SRSRAN_MAX_CODEWORDS; i++) {
+      if (pdsch_res_shared[i].crc != pdsch_res[i].crc) {
+        printf("Shared UE context decoding of tb %d in subframe %d does not match\n", i, sf_idx);
+        count_failures++;
+      }
+    }
+
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+    shared_decode_us += (size_t)(t[0].tv_sec * 1e6 + t[0].tv_usec);
+
     snr_db_avg += ue_dl->chest_res.snr_db;
 
     for (int i = 0; i < SRSRAN_MAX_TB; i++) {
@@ -668,6 +716,9 @@ int main(int argc, char** argv)
   printf("            UE:   %5.1f      %5.1f\n",
          (float)rx_nof_bits / (float)nof_subframes / 1000.0f,
          (float)rx_nof_bits / pdsch_decode_us);
+  printf("     UE shared:   %5.1f      %5.1f\n",
+         (float)rx_nof_bits / (float)nof_subframes / 1000.0f,
+         (float)rx_nof_bits / shared_decode_us);
 
   printf("BLER: %5.1f%%\n", (float)count_failures / (float)count_tbs * 100.0f);
 
@@ -677,6 +728,7 @@ int main(int argc, char** argv)
 
 quit:
   srsran_enb_dl_free(enb_dl);
+  srsran_ue_dl_free(ue_dl_shared);
   srsran_ue_dl_free(ue_dl);
   srsran_random_free(random);
 
@@ -711,6 +763,9 @@ quit:
   if (ue_dl) {
     free(ue_dl);
   }
+  if (ue_dl_shared) {
+    free(ue_dl_shared);
+  }
   srsran_channel_awgn_free(&awgn);
 
   if (ret) {
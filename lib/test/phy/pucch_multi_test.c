@@ -0,0 +1,365 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/test_common.h"
+#include "srsran/phy/channel/ch_awgn.h"
+#include "srsran/phy/utils/random.h"
+#include "srsran/srsran.h"
+#include <getopt.h>
+#include <sys/time.h>
+
+// Test parameters
+static srsran_cell_t cell = {.nof_prb         = 25,
+                             .nof_ports       = 1,
+                             .id              = 1,
+                             .cp              = SRSRAN_CP_NORM,
+                             .phich_resources = SRSRAN_PHICH_R_1,
+                             .phich_length    = SRSRAN_PHICH_NORM};
+
+static uint32_t nof_ue            = 24;  // Number of users, every three users transmit SR, 1 ACK and 2 ACK respectively
+static uint32_t nof_sf            = 100; // Number of subframes
+static float    snr_db            = 20.0f;
+static uint32_t delay             = 8; // Delay in samples of the user multiplexed with a second user
+static uint32_t delta_pucch_shift = 2; // Cyclic shift spacing of the resources of an orthogonal sequence
+
+#define PUCCH_MULTI_TEST_MAX_UE 36
+
+typedef struct {
+  srsran_ue_ul_cfg_t cfg;
+  srsran_uci_value_t uci;
+  bool               tx;
+} pucch_multi_test_ue_t;
+
+static pucch_multi_test_ue_t ue[PUCCH_MULTI_TEST_MAX_UE]    = {};
+static srsran_enb_ul_pucch_t pucch[PUCCH_MULTI_TEST_MAX_UE] = {};
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [nusSdDv]\n", prog);
+  printf("\t-n number of PRB [Default %d]\n", cell.nof_prb);
+  printf("\t-u number of users, up to %d [Default %d]\n", PUCCH_MULTI_TEST_MAX_UE, nof_ue);
+  printf("\t-s number of subframes [Default %d]\n", nof_sf);
+  printf("\t-S Signal to Noise Ratio in dB [Default %.2f]\n", snr_db);
+  printf("\t-d delay in samples of the multiplexed user [Default %d]\n", delay);
+  printf("\t-D delta PUCCH shift, 1, 2 or 3 [Default %d]\n", delta_pucch_shift);
+  printf("\t-v [set srsran_verbose to debug, default none]\n");
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "nusSdDv")) != -1) {
+    switch (opt) {
+      case 'n':
+        cell.nof_prb = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'u':
+        nof_ue = SRSRAN_MIN((uint32_t)strtol(argv[optind], NULL, 10), PUCCH_MULTI_TEST_MAX_UE);
+        break;
+      case 's':
+        nof_sf = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'S':
+        snr_db = strtof(argv[optind], NULL);
+        break;
+      case 'd':
+        delay = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'D':
+        delta_pucch_shift = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'v':
+        increase_srsran_verbose_level();
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+// Every user gets a different format 1 resource, the resources fill the PRB pairs one after the other
+static void set_cfg(uint32_t i, pucch_multi_test_ue_t* ue)
+{
+  srsran_pucch_cfg_t* cfg = &ue->cfg.ul_cfg.pucch;
+
+  cfg->rnti                          = (uint16_t)(0x46 + i);
+  cfg->delta_pucch_shift             = delta_pucch_shift;
+  cfg->n_rb_2                        = 0;
+  cfg->N_cs                          = 0;
+  cfg->N_pucch_1                     = 0;
+  cfg->group_hopping_en              = true;
+  cfg->ack_nack_feedback_mode        = SRSRAN_PUCCH_ACK_NACK_FEEDBACK_MODE_NORMAL;
+  cfg->threshold_format1             = SRSRAN_PUCCH_DEFAULT_THRESHOLD_FORMAT1;
+  cfg->threshold_data_valid_format1a = SRSRAN_PUCCH_DEFAULT_THRESHOLD_FORMAT1A;
+  cfg->threshold_dmrs_detection      = SRSRAN_PUCCH_DEFAULT_THRESHOLD_DMRS;
+  cfg->meas_ta_en                    = true;
+
+  if (i % 3 == 0) {
+    cfg->n_pucch_sr                        = i;
+    cfg->uci_cfg.is_scheduling_request_tti = true;
+  } else {
+    cfg->uci_cfg.ack[0].ncce[0]  = i;
+    cfg->uci_cfg.ack[0].nof_acks = i % 3;
+  }
+}
+
+// Generates random UCI, the users with SR only transmit when the SR is positive
+static void set_uci(srsran_random_t random_gen, pucch_multi_test_ue_t* ue)
+{
+  srsran_uci_value_t* uci = &ue->uci;
+  SRSRAN_MEM_ZERO(uci, srsran_uci_value_t, 1);
+
+  if (ue->cfg.ul_cfg.pucch.uci_cfg.is_scheduling_request_tti) {
+    uci->scheduling_request = srsran_random_bool(random_gen, 0.5f);
+    ue->tx                  = uci->scheduling_request;
+  } else {
+    uci->ack.valid = true;
+    for (uint32_t j = 0; j < ue->cfg.ul_cfg.pucch.uci_cfg.ack[0].nof_acks; j++) {
+      uci->ack.ack_value[j] = (uint8_t)srsran_random_uniform_int_dist(random_gen, 0, 1);
+    }
+    ue->tx = true;
+  }
+}
+
+// The time alignment of the receiver per user is only checked for users transmitting alone, its estimate is biased by
+// the rest of users of the PRB pair. The joint receiver estimates it from the cyclic shifts of each user, unless
+// delta_pucch_shift is 1 and the adjacent shifts may hold other users
+static int check_res(const pucch_multi_test_ue_t* u, const srsran_pucch_res_t* res, bool check_ta)
+{
+  const srsran_pucch_cfg_t* cfg = &u->cfg.ul_cfg.pucch;
+
+  if (cfg->uci_cfg.is_scheduling_request_tti) {
+    TESTASSERT(res->detected == u->tx);
+    TESTASSERT(res->uci_data.scheduling_request == u->tx);
+  } else {
+    TESTASSERT(res->detected);
+    TESTASSERT(res->uci_data.ack.valid);
+    for (uint32_t j = 0; j < cfg->uci_cfg.ack[0].nof_acks; j++) {
+      TESTASSERT(res->uci_data.ack.ack_value[j] == u->uci.ack.ack_value[j]);
+    }
+    TESTASSERT(!check_ta || (res->ta_valid && fabsf(res->ta_us) < 1.0f));
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  int                               ret        = SRSRAN_ERROR;
+  srsran_random_t                   random_gen = srsran_random_init(0x1234);
+  srsran_channel_awgn_t             awgn       = {};
+  srsran_ue_ul_t                    ue_ul      = {};
+  srsran_enb_ul_t                   enb_ul     = {};
+  srsran_refsignal_dmrs_pusch_cfg_t dmrs_cfg   = {};
+  srsran_pusch_data_t               data       = {};
+  srsran_ul_sf_cfg_t                ul_sf      = {};
+  uint32_t                          sf_len     = 0;
+  uint32_t                          nof_re     = 0;
+  cf_t*                             buffer_ue  = NULL;
+  cf_t*                             buffer_enb = NULL;
+  uint64_t                          t_single   = 0;
+  uint64_t                          t_joint    = 0;
+  uint32_t                          nof_decode = 0;
+
+  parse_args(argc, argv);
+
+  sf_len     = SRSRAN_SF_LEN_PRB(cell.nof_prb);
+  nof_re     = SRSRAN_NOF_RE(cell);
+  buffer_ue  = srsran_vec_cf_malloc(sf_len);
+  buffer_enb = srsran_vec_cf_malloc(sf_len);
+  if (buffer_ue == NULL || buffer_enb == NULL) {
+    ERROR("Error allocating buffers");
+    goto clean_exit;
+  }
+
+  if (srsran_ue_ul_init(&ue_ul, buffer_ue, cell.nof_prb) || srsran_ue_ul_set_cell(&ue_ul, cell)) {
+    ERROR("Error initiating UE UL");
+    goto clean_exit;
+  }
+  cf_t* enb_buffer[SRSRAN_MAX_PORTS] = {buffer_enb};
+  if (srsran_enb_ul_init(&enb_ul, enb_buffer, cell.nof_prb, 1) ||
+      srsran_enb_ul_set_cell(&enb_ul, cell, &dmrs_cfg, NULL)) {
+    ERROR("Error initiating eNb UL");
+    goto clean_exit;
+  }
+  if (srsran_channel_awgn_init(&awgn, 0x1234)) {
+    ERROR("Error initiating AWGN");
+    goto clean_exit;
+  }
+
+  for (uint32_t i = 0; i < nof_ue; i++) {
+    set_cfg(i, &ue[i]);
+  }
+
+  // Set the noise relative to the power of a single user in the resource elements of its PUCCH
+  set_uci(random_gen, &ue[1]);
+  data.uci = ue[1].uci;
+  TESTASSERT(srsran_ue_ul_encode(&ue_ul, &ul_sf, &ue[1].cfg, &data) > 0);
+  srsran_vec_cf_copy(buffer_enb, buffer_ue, sf_len);
+  srsran_enb_ul_fft(&enb_ul);
+  float re_power = srsran_vec_avg_power_cf(enb_ul.sf_symbols[0], SRSRAN_NRE);
+  srsran_channel_awgn_set_n0(&awgn, srsran_convert_power_to_dB(re_power) - snr_db);
+
+  for (uint32_t n = 0; n < nof_sf; n++) {
+    ul_sf.tti = n;
+
+    // In the first half, the users transmit alone and the joint detection must match the detection per user. In the
+    // second half, all the users transmit at the same time
+    bool     alone = n < nof_sf / 2;
+    uint32_t first = alone ? n % nof_ue : 0;
+    uint32_t count = alone ? 1 : nof_ue;
+
+    srsran_vec_cf_zero(buffer_enb, sf_len);
+    for (uint32_t i = first; i < first + count; i++) {
+      set_uci(random_gen, &ue[i]);
+      if (ue[i].tx) {
+        data.uci = ue[i].uci;
+        TESTASSERT(srsran_ue_ul_encode(&ue_ul, &ul_sf, &ue[i].cfg, &data) > 0);
+        srsran_vec_sum_ccc(buffer_enb, buffer_ue, buffer_enb, sf_len);
+      }
+    }
+
+    srsran_enb_ul_fft(&enb_ul);
+    srsran_channel_awgn_run_c(&awgn, enb_ul.sf_symbols[0], enb_ul.sf_symbols[0], nof_re);
+
+    // Joint detection
+    for (uint32_t i = first; i < first + count; i++) {
+      pucch[i - first].cfg = ue[i].cfg.ul_cfg.pucch;
+    }
+    struct timeval t[3] = {};
+    gettimeofday(&t[1], NULL);
+    TESTASSERT(srsran_enb_ul_get_pucch_multi(&enb_ul, &ul_sf, pucch, count) == SRSRAN_SUCCESS);
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+    t_joint += t[0].tv_usec + t[0].tv_sec * 1000000UL;
+
+    for (uint32_t i = first; i < first + count; i++) {
+      srsran_pucch_res_t* res = &pucch[i - first].res;
+      TESTASSERT(pucch[i - first].ret == SRSRAN_SUCCESS);
+
+      INFO("sf=%d; ue=%d; tx=%d; detected=%d; corr=%.3f; snr=%.1f; ta=%.1f",
+           n,
+           i,
+           ue[i].tx,
+           res->detected,
+           res->correlation,
+           res->snr_db,
+           res->ta_us);
+      TESTASSERT(check_res(&ue[i], res, alone || delta_pucch_shift > 1) == SRSRAN_SUCCESS);
+    }
+
+    // Detection per user
+    gettimeofday(&t[1], NULL);
+    for (uint32_t i = first; i < first + count; i++) {
+      srsran_pucch_cfg_t cfg = ue[i].cfg.ul_cfg.pucch;
+      srsran_pucch_res_t res = {};
+      TESTASSERT(srsran_enb_ul_get_pucch(&enb_ul, &ul_sf, &cfg, &res) == SRSRAN_SUCCESS);
+
+      if (alone) {
+        TESTASSERT(res.detected == pucch[i - first].res.detected);
+        TESTASSERT(check_res(&ue[i], &res, alone) == SRSRAN_SUCCESS);
+      }
+    }
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+    t_single += t[0].tv_usec + t[0].tv_sec * 1000000UL;
+
+    nof_decode += count;
+  }
+
+  // Users 1 and 2 send ACK in the same PRB pair, user 2 delayed. The time alignment of each user is measured from its
+  // own cyclic shifts, whether it transmits alone or together with the other one. With delta_pucch_shift 1 their
+  // shifts are adjacent and the time alignment must be the one of the receiver per user
+  float delay_us = 1e6f * (float)delay / (float)srsran_sampling_freq_hz(cell.nof_prb);
+  for (uint32_t n = 0; n < 20; n++) {
+    bool     shared = n % 2;
+    uint32_t first  = shared ? 1 : 2;
+    uint32_t count  = shared ? 2 : 1;
+    ul_sf.tti       = n;
+
+    srsran_vec_cf_zero(buffer_enb, sf_len);
+    for (uint32_t i = first; i < first + count; i++) {
+      set_uci(random_gen, &ue[i]);
+      data.uci = ue[i].uci;
+      TESTASSERT(srsran_ue_ul_encode(&ue_ul, &ul_sf, &ue[i].cfg, &data) > 0);
+      uint32_t d = (i == 2) ? delay : 0;
+      srsran_vec_sum_ccc(&buffer_enb[d], buffer_ue, &buffer_enb[d], sf_len - d);
+    }
+
+    srsran_enb_ul_fft(&enb_ul);
+    srsran_channel_awgn_run_c(&awgn, enb_ul.sf_symbols[0], enb_ul.sf_symbols[0], nof_re);
+
+    for (uint32_t i = first; i < first + count; i++) {
+      pucch[i - first].cfg = ue[i].cfg.ul_cfg.pucch;
+    }
+    TESTASSERT(srsran_enb_ul_get_pucch_multi(&enb_ul, &ul_sf, pucch, count) == SRSRAN_SUCCESS);
+
+    for (uint32_t i = first; i < first + count; i++) {
+      srsran_pucch_res_t* res = &pucch[i - first].res;
+      TESTASSERT(pucch[i - first].ret == SRSRAN_SUCCESS);
+
+      INFO("sf=%d; ue=%d; shared=%d; detected=%d; ta_valid=%d; ta=%.1f (delay %.1f)",
+           n,
+           i,
+           shared,
+           res->detected,
+           res->ta_valid,
+           res->ta_us,
+           delay_us);
+      TESTASSERT(check_res(&ue[i], res, false) == SRSRAN_SUCCESS);
+      TESTASSERT(res->ta_valid);
+
+      float ta_us = (i == 2) ? delay_us : 0.0f;
+      if (delta_pucch_shift > 1 || !shared) {
+        TESTASSERT(fabsf(res->ta_us - ta_us) < 0.5f);
+      }
+      if (delta_pucch_shift == 1) {
+        srsran_pucch_cfg_t cfg    = ue[i].cfg.ul_cfg.pucch;
+        srsran_pucch_res_t single = {};
+        TESTASSERT(srsran_enb_ul_get_pucch(&enb_ul, &ul_sf, &cfg, &single) == SRSRAN_SUCCESS);
+        TESTASSERT(single.ta_valid && single.ta_us == res->ta_us);
+      }
+    }
+  }
+
+  printf("PUCCH detection of %d users, %d PRB: per user %.2f usec/user; joint %.2f usec/user\n",
+         nof_ue,
+         cell.nof_prb,
+         nof_decode ? (double)t_single / (double)nof_decode : 0.0,
+         nof_decode ? (double)t_joint / (double)nof_decode : 0.0);
+
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  srsran_random_free(random_gen);
+  srsran_channel_awgn_free(&awgn);
+  srsran_ue_ul_free(&ue_ul);
+  srsran_enb_ul_free(&enb_ul);
+  if (buffer_ue) {
+    free(buffer_ue);
+  }
+  if (buffer_enb) {
+    free(buffer_enb);
+  }
+
+  return ret;
+}
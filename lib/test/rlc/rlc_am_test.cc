@@ -3678,6 +3678,55 @@ bool discard_test()
 
   return SRSRAN_SUCCESS;
 }
+// This test checks that in compact mode the windows are only held while there are PDUs in flight, or shortly after
+bool compact_windows_test()
+{
+  set_rlc_compact_windows(true);
+
+  rlc_am_tester tester;
+  timer_handler timers(8);
+
+  rlc_am_lte rlc1(srslog::fetch_basic_logger("RLC_AM_1"), 1, &tester, &tester, &timers);
+  rlc_am_lte rlc2(srslog::fetch_basic_logger("RLC_AM_2"), 1, &tester, &tester, &timers);
+  TESTASSERT(rlc1.configure(rlc_config_t::default_rlc_am_config()));
+  TESTASSERT(rlc2.configure(rlc_config_t::default_rlc_am_config()));
+
+  // an idle bearer holds nothing besides its block of the bearer pool
+  TESTASSERT(rlc1.get_mem_footprint() == rlc_bearer_block_size());
+  TESTASSERT(rlc2.get_mem_footprint() == rlc_bearer_block_size());
+
+  for (uint32_t round = 0; round < 2; ++round) {
+    byte_buffer_t pdu_bufs[NBUFS];
+    TESTASSERT(basic_test_tx(&rlc1, pdu_bufs) == SRSRAN_SUCCESS);
+    TESTASSERT(rlc1.get_mem_footprint() > rlc_bearer_block_size());
+
+    for (int i = 0; i < NBUFS; i++) {
+      rlc2.write_pdu(pdu_bufs[i].msg, pdu_bufs[i].N_bytes);
+    }
+    byte_buffer_t status_buf;
+    status_buf.N_bytes = rlc2.read_pdu(status_buf.msg, 2);
+    rlc1.write_pdu(status_buf.msg, status_buf.N_bytes);
+
+    // all PDUs were delivered and ACKed
+    for (uint32_t i = 0; i < NBUFS; i++) {
+      TESTASSERT(tester.notified_counts[i] == round + 1);
+    }
+    // the storage is kept for a while, in case the bearer becomes active again
+    TESTASSERT(rlc1.get_mem_footprint() > rlc_bearer_block_size());
+
+    // let the status prohibit timer expire and the bearers stay idle until they give back their storage
+    for (uint32_t cnt = 0; cnt < std::max(100u, rlc_compact_idle_ms); cnt++) {
+      timers.step_all();
+    }
+    TESTASSERT(rlc1.get_mem_footprint() == rlc_bearer_block_size());
+    TESTASSERT(rlc2.get_mem_footprint() <= rlc_bearer_block_size() + sizeof(byte_buffer_t));
+  }
+  TESTASSERT(tester.sdus.size() == 2 * NBUFS);
+
+  set_rlc_compact_windows(false);
+  return SRSRAN_SUCCESS;
+}
+
 int main(int argc, char** argv)
 {
   // Setup the log message spy to intercept error and warning log entries from RLC
@@ -3883,5 +3932,10 @@ int main(int argc, char** argv)
     exit(-1);
   };
 
+  if (compact_windows_test()) {
+    printf("compact_windows_test failed\n");
+    exit(-1);
+  };
+
   return SRSRAN_SUCCESS;
 }
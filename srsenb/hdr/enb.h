@@ -92,6 +92,7 @@ struct gui_args_t {
 
 struct general_args_t {
   uint32_t    rrc_inactivity_timer;
+  bool        rrc_parallel_decoding;
   float       metrics_period_secs;
   bool        metrics_csv_enable;
   std::string metrics_csv_filename;
@@ -153,6 +154,8 @@ public:
 
   void toggle_padding() override;
 
+  bool cmd_mem_footprint(stack_mem_footprint_t* footprint) override;
+
   void tti_clock() override;
 
 private:
@@ -40,9 +40,13 @@ public:
   void set_metrics(const enb_metrics_t& m, const uint32_t period_usec) override;
   void stop() override {}
 
+  /// Limits the report to the max_ues most active UEs of the period, 0 reports every UE
+  void set_max_ues(uint32_t max_ues_) { max_ues = max_ues_; }
+
 private:
   srslog::log_channel&   log_c;
   enb_metrics_interface* enb;
+  uint32_t               max_ues = 0;
 };
 
 } // namespace srsenb
@@ -43,16 +43,22 @@ public:
   void toggle_print(bool b);
   void set_metrics(const enb_metrics_t& m, const uint32_t period_usec);
   void set_handle(enb_metrics_interface* enb_);
+  /// Limits the report to the max_ues most active UEs of the period, 0 prints every UE
+  void set_max_ues(uint32_t max_ues_);
   void stop(){};
 
 private:
-  void set_metrics_helper(uint32_t num_ue, const mac_metrics_t& mac, const std::vector<phy_metrics_t>& phy, bool is_nr);
+  void        set_metrics_helper(const std::vector<uint32_t>&      ue_idxs,
+                                 const mac_metrics_t&              mac,
+                                 const std::vector<phy_metrics_t>& phy,
+                                 bool                              is_nr);
   std::string float_to_string(float f, int digits, int field_width = 6);
   std::string float_to_eng_string(float f, int digits);
 
   std::atomic<bool>      do_print  = {false};
   uint8_t                n_reports = 0;
   enb_metrics_interface* enb       = nullptr;
+  uint32_t               max_ues   = 0;
 };
 
 } // namespace srsenb
@@ -95,6 +95,13 @@ private:
 
   srsran_softbuffer_tx_t temp_mbsfn_softbuffer = {};
 
+  // Users expecting PUCCH in the current TTI, kept between TTIs for avoiding allocations
+  std::vector<srsran_enb_ul_pucch_t> pucch_rx;
+
+  // Time spent in each PHY stage during the current TTI, committed to the common profiler at the end of the TTI
+  srsran::stage_profiler::period_t ul_stages;
+  srsran::stage_profiler::period_t dl_stages;
+
   // Class to store user information
   class ue
   {
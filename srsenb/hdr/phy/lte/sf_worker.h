@@ -22,11 +22,13 @@
 #ifndef SRSENB_PHCH_WORKER_H
 #define SRSENB_PHCH_WORKER_H
 
+#include <array>
 #include <mutex>
 #include <string.h>
 
 #include "../phy_common.h"
 #include "cc_worker.h"
+#include "srsran/common/edf_task_pool.h"
 #include "srsran/srslog/srslog.h"
 #include "srsran/srsran.h"
 
@@ -36,9 +38,20 @@ namespace lte {
 class sf_worker : public srsran::thread_pool::worker
 {
 public:
+  /// Types of the tasks a TTI is split into when a task pool is given
+  enum task_type_t { TASK_UL = 0, TASK_DL, NOF_TASK_TYPES };
+  static const char* task_type_to_string(uint32_t type);
+
   sf_worker(srslog::basic_logger& logger) : logger(logger) {}
   ~sf_worker();
-  void init(phy_common* phy);
+
+  /**
+   * Initialises the worker
+   * @param phy PHY common object
+   * @param task_pool_ Pool that runs the carriers of each TTI as deadline-aware tasks. If it is null, every carrier is
+   * processed sequentially in the worker thread
+   */
+  void init(phy_common* phy, srsran::edf_task_pool* task_pool_ = nullptr);
 
   cf_t* get_buffer_rx(uint32_t cc_idx, uint32_t antenna_idx);
   void  set_context(const srsran::phy_common_interface::worker_context_t& w_ctx);
@@ -60,6 +73,10 @@ public:
 
 private:
   void work_imp() final;
+  void work_ul(const srsran_ul_sf_cfg_t& ul_sf, stack_interface_phy_lte::ul_sched_list_t& ul_grants);
+  void work_dl(const srsran_dl_sf_cfg_t&                 dl_sf,
+               stack_interface_phy_lte::dl_sched_list_t& dl_grants,
+               stack_interface_phy_lte::ul_sched_list_t& ul_grants);
 
   /* Common objects */
   srslog::basic_logger& logger;
@@ -71,8 +88,14 @@ private:
   uint32_t                                       tti_rx = 0, tti_tx_dl = 0, tti_tx_ul = 0;
   std::vector<std::unique_ptr<cc_worker> >       cc_workers;
   srsran::phy_common_interface::worker_context_t context = {};
+  srsran_mbsfn_cfg_t                             mbsfn_cfg = {};
 
   srsran_softbuffer_tx_t temp_mbsfn_softbuffer = {};
+
+  // Deadline-aware execution, the DL configuration of each carrier is kept until its task finishes
+  srsran::edf_task_pool*                              task_pool = nullptr;
+  srsran::edf_task_pool::time_point                   tti_start;
+  std::array<srsran_dl_sf_cfg_t, SRSRAN_MAX_CARRIERS> dl_sf_cc = {};
 };
 
 } // namespace lte
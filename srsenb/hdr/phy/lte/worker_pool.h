@@ -32,6 +32,7 @@ class worker_pool
 {
   srsran::thread_pool                      pool;
   std::vector<std::unique_ptr<sf_worker> > workers;
+  std::unique_ptr<srsran::edf_task_pool>   task_pool;
 
 public:
   sf_worker* operator[](std::size_t pos) { return workers.at(pos).get(); }
@@ -43,6 +44,9 @@ public:
   sf_worker* wait_worker_id(uint32_t id);
   void       start_worker(sf_worker* w);
   void       stop();
+
+  /// Returns the deadline metrics of each task type since the last call, empty if the task pool is disabled
+  std::vector<srsran::edf_task_pool::type_metrics_t> get_task_metrics();
 };
 
 } // namespace lte
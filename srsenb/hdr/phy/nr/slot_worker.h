@@ -22,6 +22,7 @@
 #ifndef SRSENB_NR_SLOT_WORKER_H
 #define SRSENB_NR_SLOT_WORKER_H
 
+#include "srsenb/hdr/phy/phy_metrics.h"
 #include "srsran/common/thread_pool.h"
 #include "srsran/interfaces/gnb_interfaces.h"
 #include "srsran/interfaces/phy_common_interface.h"
@@ -68,6 +69,7 @@ public:
     uint32_t                    pusch_max_its    = 10;
     float                       pusch_min_snr_dB = -10.0f;
     double                      srate_hz         = 0.0;
+    srsran::stage_profiler*     stage_prof       = nullptr; ///< Optional, indexed by phy_stage_t
   };
 
   slot_worker(srsran::phy_common_interface& common_,
@@ -122,6 +124,8 @@ private:
   srsran_gnb_ul_t                                gnb_ul      = {};
   std::vector<cf_t*>                             tx_buffer; ///< Baseband transmit buffers
   std::vector<cf_t*>                             rx_buffer; ///< Baseband receive buffers
+  srsran::stage_profiler*                        stage_prof = nullptr;
+  srsran::stage_profiler::period_t               stages; ///< Time spent in each PHY stage during the current slot
   std::mutex mutex; ///< Protect concurrent access from workers (and main process that inits the class)
 };
 
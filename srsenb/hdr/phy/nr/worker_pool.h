@@ -98,16 +98,18 @@ private:
   prach_stack_adaptor_t                      prach_stack_adaptor;
   uint32_t                                   nof_prach_workers = 0;
   double                                     srate_hz          = 0.0; ///< Current sampling rate in Hz
+  srsran::stage_profiler*                    stage_prof        = nullptr;
 
 public:
   struct args_t {
-    double                 srate_hz          = 0.0;
-    uint32_t               nof_phy_threads   = 3;
-    uint32_t               nof_prach_workers = 0;
-    uint32_t               prio              = 52;
-    uint32_t               pusch_max_its     = 10;
-    float                  pusch_min_snr_dB  = -10;
-    srsran::phy_log_args_t log               = {};
+    double                  srate_hz          = 0.0;
+    uint32_t                nof_phy_threads   = 3;
+    uint32_t                nof_prach_workers = 0;
+    uint32_t                prio              = 52;
+    uint32_t                pusch_max_its     = 10;
+    float                   pusch_min_snr_dB  = -10;
+    srsran::phy_log_args_t  log               = {};
+    srsran::stage_profiler* stage_prof        = nullptr; ///< Optional, indexed by phy_stage_t
   };
   slot_worker* operator[](std::size_t pos) { return workers.at(pos).get(); }
 
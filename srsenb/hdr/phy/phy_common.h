@@ -220,6 +220,28 @@ public:
   // Common Physical Uplink DMRS configuration
   srsran_refsignal_dmrs_pusch_cfg_t dmrs_pusch_cfg = {};
 
+  /**
+   * Generates the PUSCH DMRS of each LTE cell in parallel, or loads them from the PHY table cache, once for all the
+   * workers. Must be called after setting dmrs_pusch_cfg and before initialising the workers
+   */
+  bool init_dmrs_pusch_tables();
+
+  /**
+   * Frees the PUSCH DMRS tables once the workers have loaded them, the workers initialised afterwards generate their own
+   */
+  void free_dmrs_pusch_tables();
+
+  /**
+   * PUSCH DMRS of an LTE cell packed with srsran_refsignal_dmrs_pusch_pregen_pack(), nullptr if not generated
+   */
+  const uint8_t* get_dmrs_pusch_table(uint32_t cc_idx) const
+  {
+    if (cc_idx >= dmrs_pusch_tables.size() or dmrs_pusch_tables[cc_idx].empty()) {
+      return nullptr;
+    }
+    return dmrs_pusch_tables[cc_idx].data();
+  }
+
   srsran::radio_interface_phy* radio      = nullptr;
   stack_interface_phy_lte*     stack      = nullptr;
   srsran::channel_ptr          dl_channel = nullptr;
@@ -229,6 +251,11 @@ public:
    */
   phy_ue_db ue_db;
 
+  /**
+   * Time spent by the LTE, NR and PRACH workers in each PHY stage, indexed by phy_stage_t
+   */
+  srsran::stage_profiler stage_prof{(uint32_t)phy_stage_t::nof_stages};
+
   void configure_mbsfn(srsran::phy_cfg_mbsfn_t* cfg);
   void build_mch_table();
   void build_mcch_table();
@@ -249,6 +276,8 @@ private:
   phy_cell_cfg_list_nr_t cell_list_nr;
   std::mutex             cell_gain_mutex;
 
+  std::vector<std::vector<uint8_t> > dmrs_pusch_tables;
+
   bool                    have_mtch_stop   = false;
   pthread_mutex_t         mtch_mutex       = {};
   pthread_cond_t          mtch_cvar        = {};
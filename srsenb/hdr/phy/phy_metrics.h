@@ -22,6 +22,8 @@
 #ifndef SRSENB_PHY_METRICS_H
 #define SRSENB_PHY_METRICS_H
 
+#include "srsran/common/stage_profiler.h"
+
 namespace srsenb {
 
 // PHY metrics per user
@@ -47,6 +49,35 @@ struct phy_metrics_t {
   ul_metrics_t ul;
 };
 
+// PHY processing stages timed by the workers, every sample is the time spent in a stage by one carrier in one TTI
+
+enum class phy_stage_t { fft = 0, chest, pusch, pucch, prach, pdcch, pdsch, nof_stages };
+
+inline const char* phy_stage_to_string(phy_stage_t stage)
+{
+  switch (stage) {
+    case phy_stage_t::fft:
+      return "fft";
+    case phy_stage_t::chest:
+      return "chest";
+    case phy_stage_t::pusch:
+      return "pusch";
+    case phy_stage_t::pucch:
+      return "pucch";
+    case phy_stage_t::prach:
+      return "prach";
+    case phy_stage_t::pdcch:
+      return "pdcch";
+    case phy_stage_t::pdsch:
+      return "pdsch";
+    default:
+      break;
+  }
+  return "unknown";
+}
+
+using phy_stage_metrics_t = srsran::stage_profiler::stage_metrics_t;
+
 } // namespace srsenb
 
 #endif // SRSENB_PHY_METRICS_H
@@ -0,0 +1,74 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSENB_PHY_TABLE_CACHE_H
+#define SRSENB_PHY_TABLE_CACHE_H
+
+#include "srsran/srslog/srslog.h"
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace srsenb {
+
+/**
+ * @brief On-disk cache of the tables that the PHY derives from the cell configuration
+ *
+ * Each table is stored in its own file, named after the table and the hash of the configuration it was generated from,
+ * so that a restart with the same configuration loads the tables instead of generating them again. The files carry the
+ * layout version of the table and a checksum of their contents and are written to a temporary file first, a file of
+ * another build, corrupted or partial is regenerated.
+ */
+class phy_table_cache
+{
+public:
+  /// Hashes the configuration a table is derived from, chain calls through seed to hash several fields
+  static uint64_t hash(const void* data, size_t len, uint64_t seed = hash_seed);
+  template <typename T>
+  static uint64_t hash_value(const T& value, uint64_t seed = hash_seed)
+  {
+    return hash(&value, sizeof(T), seed);
+  }
+
+  /// The cache is disabled when dir is empty
+  phy_table_cache(std::string dir, srslog::basic_logger& logger);
+
+  bool enabled() const { return not dir.empty(); }
+
+  /// Loads the table name of len bytes derived from the configuration with hash key, returns false if it is not cached
+  /// or it was stored with another format, the layout version of the table
+  bool load(const std::string& name, uint32_t format, uint64_t key, size_t len, std::vector<uint8_t>& table) const;
+
+  /// Stores the table name in the given format derived from the configuration with hash key
+  bool store(const std::string& name, uint32_t format, uint64_t key, const std::vector<uint8_t>& table) const;
+
+private:
+  static const uint64_t hash_seed = 0xcbf29ce484222325ULL;
+
+  std::string filename(const std::string& name, uint64_t key) const;
+
+  std::string           dir;
+  srslog::basic_logger& logger;
+};
+
+} // namespace srsenb
+
+#endif // SRSENB_PHY_TABLE_CACHE_H
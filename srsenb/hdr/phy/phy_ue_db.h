@@ -23,9 +23,12 @@
 #define SRSENB_PHY_UE_DB_H_
 
 #include "phy_interfaces.h"
+#include "srsran/adt/rcu_ptr.h"
 #include "srsran/interfaces/enb_mac_interfaces.h"
 #include "srsran/interfaces/enb_phy_interfaces.h"
+#include <atomic>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <srsran/adt/circular_array.h>
 
@@ -84,34 +87,57 @@ private:
    * Cell information for the UE database
    */
   struct cell_info_t {
-    cell_state_t state      = cell_state_none; ///< Configuration state
-    uint32_t     enb_cc_idx = 0;               ///< Corresponding eNb cell/carrier index
-    uint8_t      last_ri    = 0;               ///< Last reported rank indicator
+    cell_state_t      state                   = cell_state_none; ///< Configuration state
+    uint32_t          enb_cc_idx              = 0;               ///< Corresponding eNb cell/carrier index
+    bool              stash_use_tbs_index_alt = false;
+    srsran::phy_cfg_t phy_cfg; ///< Configuration, it has a default constructor
+  };
+
+  /**
+   * Cell information updated by the PHY workers. The last UL TB is protected by the mutex of the UE state, the rank
+   * indicator and the grant flags are atomic
+   */
+  struct cell_tti_state_t {
+    std::atomic<uint8_t> last_ri = {0}; ///< Last reported rank indicator, it is accessed from any TTI
     srsran::circular_array<srsran_ra_tb_t, SRSRAN_MAX_HARQ_PROC> last_tb =
         {}; ///< Stores last PUSCH Resource allocation
-    bool                                    stash_use_tbs_index_alt = false;
-    srsran::phy_cfg_t                       phy_cfg;            ///< Configuration, it has a default constructor
-    srsran::circular_array<bool, TTIMOD_SZ> is_grant_available; ///< Indicates whether there is an available grant
+    srsran::circular_array<std::atomic<bool>, TTIMOD_SZ> is_grant_available =
+        {}; ///< Indicates whether there is an available grant
   };
 
   /**
-   * UE object stored in the PHY common database
+   * UE information updated by the PHY workers, it is kept across the UE configuration changes. The workers of all the
+   * carriers access the same entries: the pending ACKs are set by the DL worker of every carrier and read by the UL
+   * worker of the carrier receiving the UCI, and the last UL TB of a HARQ process is read back by the worker of the
+   * retransmission. The mutex is only held to update or copy one of these entries, never while calling the stack or
+   * the PHY library. A worker waits at most for the copy of a srsran_pdsch_ack_t by the worker of another carrier of
+   * the same UE, the stack never takes it
    */
-  struct common_ue {
-    bool                                                  stashed_multiple_csi_request_enabled = false;
+  struct ue_tti_state_t {
+    std::mutex                                            mutex;
     srsran::circular_array<srsran_pdsch_ack_t, TTIMOD_SZ> pdsch_ack = {}; ///< Pending acknowledgements for this Cell
-    std::array<cell_info_t, SRSRAN_MAX_CARRIERS>          cell_info = {}; ///< Cell information, indexed by ue_cell_idx
+    std::array<cell_tti_state_t, SRSRAN_MAX_CARRIERS>     cell      = {}; ///< Cell information, indexed by ue_cell_idx
   };
 
   /**
-   * UE database indexed by RNTI
+   * UE object stored in the PHY common database. The configuration is not modified once it is published, the stack
+   * replaces the whole object instead
    */
-  std::map<uint16_t, common_ue> ue_db;
+  struct common_ue {
+    bool                                         stashed_multiple_csi_request_enabled = false;
+    std::array<cell_info_t, SRSRAN_MAX_CARRIERS> cell_info = {}; ///< Cell information, indexed by ue_cell_idx
+    std::shared_ptr<ue_tti_state_t>              tti_state;      ///< Shared by every configuration of the UE
+  };
+
+  typedef srsran::rcu_ptr<common_ue>                    ue_entry_t;
+  typedef std::map<uint16_t, std::shared_ptr<ue_entry_t> > ue_map_t;
 
   /**
-   * Concurrency protection mutex, allowed modifications from const methods.
+   * UE database indexed by RNTI. The PHY workers read a snapshot of the database, and a snapshot of each UE they
+   * access, without locking. The stack only publishes a new database when it adds or removes a UE, the configuration of
+   * each UE is published in its own entry, so that a UE update does not copy the rest of UEs.
    */
-  mutable std::mutex mutex;
+  srsran::rcu_ptr<ue_map_t> ue_db;
 
   /**
    * Stack interface
@@ -129,20 +155,48 @@ private:
   const phy_cell_cfg_list_t* cell_cfg_list = nullptr;
 
   /**
-   * Internal RNTI addition, it is not thread safe protected
+   * Internal RNTI addition to a database copy that is not published yet
    *
+   * @param db database copy
    * @param rnti identifier of the UE
    * @return SRSRAN_SUCCESS if the RNTI is not duplicated and is added successfully, SRSRAN_ERROR code if it exists
    */
-  inline int _add_rnti(uint16_t rnti);
+  inline int _add_rnti(ue_map_t& db, uint16_t rnti);
 
   /**
-   * Internal pending ACK clear for a given RNTI and TTI, it is not thread safe protected
+   * Gets the entry of a UE, which the stack modifies, the entry stays valid after the UE is removed
+   *
+   * @param rnti identifier of the UE
+   * @return the UE entry, nullptr if the RNTI does not exist
+   */
+  std::shared_ptr<ue_entry_t> _get_ue_entry(uint16_t rnti) const;
+
+  /**
+   * Calls a function with the snapshot of a UE, without locking
+   *
+   * @param rnti identifier of the UE
+   * @param f function called with the UE object
+   * @return SRSRAN_ERROR if the RNTI does not exist, otherwise whatever the function returns
+   */
+  template <typename Func>
+  int _read_ue(uint16_t rnti, const Func& f) const
+  {
+    auto db = ue_db.read();
+    auto it = db->find(rnti);
+    if (it == db->end()) {
+      return SRSRAN_ERROR;
+    }
+    auto ue = it->second->read();
+    return f(*ue);
+  }
+
+  /**
+   * Internal pending ACK clear for a given UE and TTI, it takes the mutex of the UE state
    *
    * @param tti is the given TTI (requires assertion prior to call)
-   * @param rnti identifier of the UE (requires assertion prior to call)
+   * @param ue UE object
    */
-  inline void _clear_tti_pending_rnti(uint32_t tti, uint16_t rnti);
+  static inline void _clear_tti_pending_rnti(uint32_t tti, const common_ue& ue);
 
   /**
    * Helper method to set the constant attributes of a given RNTI after the configuration is set, it does not modify
@@ -157,11 +211,11 @@ private:
    * Gets the SCell index for a given RNTI and a eNb cell/carrier. It returns the SCell index (0 if PCell) if the cc_idx
    * is found among the configured cells/carriers. Otherwise, it returns SRSRAN_MAX_CARRIERS.
    *
-   * @param rnti identifier of the UE (requires assertion prior to call)
+   * @param ue UE object
    * @param enb_cc_idx the eNb cell/carrier index to look for in the RNTI.
    * @return the SCell index as described above.
    */
-  inline uint32_t _get_ue_cc_idx(uint16_t rnti, uint32_t enb_cc_idx) const;
+  static inline uint32_t _get_ue_cc_idx(const common_ue& ue, uint32_t enb_cc_idx);
 
   /**
    * Gets the eNb Cell/Carrier index in which the UCI shall be carried. This corresponds to the serving cell with lowest
@@ -170,49 +224,42 @@ private:
    * If no grant is available in the indicated TTI, it returns the number of the eNb Cells/Carriers.
    *
    * @param tti The UL processing TTI
-   * @param rnti Temporal UE ID
+   * @param ue UE object
    * @return the eNb Cell/Carrier with lowest serving cell index that has an UL grant
    */
-  uint32_t _get_uci_enb_cc_idx(uint32_t tti, uint16_t rnti) const;
-
-  /**
-   * Checks if a given RNTI exists in the database
-   * @param rnti provides UE identifier
-   * @return SRSRAN_SUCCESS if the indicated RNTI exists, otherwise it returns SRSRAN_ERROR
-   */
-  inline int _assert_rnti(uint16_t rnti) const;
+  uint32_t _get_uci_enb_cc_idx(uint32_t tti, const common_ue& ue) const;
 
   /**
-   * Checks if an RNTI is configured to use an specified eNb cell/carrier as PCell or SCell
-   * @param rnti provides UE identifier
+   * Checks if a UE is configured to use an specified eNb cell/carrier as PCell or SCell
+   * @param ue UE object
    * @param enb_cc_idx provides eNb cell/carrier
-   * @return SRSRAN_SUCCESS if the indicated RNTI exists, otherwise it returns SRSRAN_ERROR
+   * @return SRSRAN_SUCCESS if the indicated eNb cell/carrier is configured, otherwise it returns SRSRAN_ERROR
    */
-  inline int _assert_enb_cc(uint16_t rnti, uint32_t enb_cc_idx) const;
+  static inline int _assert_enb_cc(const common_ue& ue, uint32_t enb_cc_idx);
 
   /**
-   * Checks if an RNTI uses a given eNb cell/carrier as PCell
-   * @param rnti provides UE identifier
+   * Checks if a UE uses a given eNb cell/carrier as PCell
+   * @param ue UE object
    * @param enb_cc_idx provides eNb cell/carrier index
-   * @return SRSRAN_SUCCESS if the indicated eNb cell/carrier of the RNTI is a PCell, otherwise it returns SRSRAN_ERROR
+   * @return SRSRAN_SUCCESS if the indicated eNb cell/carrier of the UE is a PCell, otherwise it returns SRSRAN_ERROR
    */
-  inline int _assert_enb_pcell(uint16_t rnti, uint32_t enb_cc_idx) const;
+  static inline int _assert_enb_pcell(const common_ue& ue, uint32_t enb_cc_idx);
 
   /**
-   * Checks if an RNTI is configured to use an specified UE cell/carrier as PCell or SCell
-   * @param rnti provides UE identifier
+   * Checks if a UE is configured to use an specified UE cell/carrier as PCell or SCell
+   * @param ue UE object
    * @param ue_cc_idx UE cell/carrier index that is asserted
    * @return SRSRAN_SUCCESS if the indicated cell/carrier index is valid, otherwise it returns SRSRAN_ERROR
    */
-  inline int _assert_ue_cc(uint16_t rnti, uint32_t ue_cc_idx) const;
+  static inline int _assert_ue_cc(const common_ue& ue, uint32_t ue_cc_idx);
 
   /**
-   * Checks if an RNTI is configured to use an specified eNb cell/carrier as PCell or SCell and it is active
-   * @param rnti provides UE identifier
+   * Checks if a UE is configured to use an specified eNb cell/carrier as PCell or SCell and it is active
+   * @param ue UE object
    * @param enb_cc_idx UE cell/carrier index that is asserted
    * @return SRSRAN_SUCCESS if the indicated eNb cell/carrier is active, otherwise it returns SRSRAN_ERROR
    */
-  inline int _assert_active_enb_cc(uint16_t rnti, uint32_t enb_cc_idx) const;
+  static inline int _assert_active_enb_cc(const common_ue& ue, uint32_t enb_cc_idx);
 
   /**
    * Internal eNb stack assertion
@@ -227,22 +274,75 @@ private:
   inline int _assert_cell_list_cfg() const;
 
   /**
-   * Internal eNb general configuration getter, returns default configuration if the UE does not exist in the given cell
+   * Internal default configuration getter for the non-user RNTIs
+   *
+   * @param rnti provides the RNTI
+   * @return the default PHY configuration for the RNTI
+   */
+  static inline srsran::phy_cfg_t _get_default_config(uint16_t rnti);
+
+  /**
+   * Internal eNb general configuration getter
    *
-   * @param rnti provides UE identifier
+   * @param ue UE object
    * @param enb_cc_idx eNb cell index
-   * @param[out] phy_cfg The PHY configuration of the indicated UE for the indicated eNb carrier/call index.
-   * @return SRSRAN_SUCCESS if provided context is correct, SRSRAN_ERROR code otherwise
+   * @return the PHY configuration of the UE for the indicated eNb carrier/cell, nullptr if it is not configured
+   */
+  static inline const srsran::phy_cfg_t* _get_rnti_config(const common_ue& ue, uint32_t enb_cc_idx);
+
+  /**
+   * Internal UCI configuration filler for a UE which is read by the caller, see fill_uci_cfg()
+   */
+  int _fill_uci_cfg(uint32_t          tti,
+                    uint32_t          enb_cc_idx,
+                    const common_ue&  ue,
+                    bool              aperiodic_cqi_request,
+                    bool              is_pusch_available,
+                    srsran_uci_cfg_t& uci_cfg) const;
+
+  /**
+   * UE fields the stack notification of a received UCI needs. They are copied from the UE snapshot, so that the stack
+   * is called after leaving the read-side section
+   */
+  struct uci_stack_info_t {
+    bool                                      ack_valid      = false; ///< The eNb cell/carrier is active for the UE
+    bool                                      sr_detected    = false;
+    srsran_pdsch_ack_t                        pdsch_ack      = {};    ///< Decoded ACK information
+    std::array<uint32_t, SRSRAN_MAX_CARRIERS> enb_cc_idx     = {};    ///< eNb cell/carrier index of each serving cell
+    bool                                      cqi_valid      = false; ///< The serving cell reporting CQI exists
+    uint32_t                                  cqi_cc_idx     = 0;     ///< eNb cell/carrier index of the CQI report
+    srsran_cqi_report_cfg_t                   cqi_report_cfg = {};
+    srsran_cell_t                             cell           = {};    ///< PCell
+  };
+
+  /**
+   * Internal UCI decoding for a UE which is read by the caller, see send_uci_data(). It copies what the stack needs
+   *
+   * @return SRSRAN_SUCCESS if every field is valid, SRSRAN_ERROR code otherwise, some fields may still be valid
+   */
+  int _get_uci_stack_info(uint32_t                  tti,
+                          uint32_t                  enb_cc_idx,
+                          const common_ue&          ue,
+                          const srsran_uci_cfg_t&   uci_cfg,
+                          const srsran_uci_value_t& uci_value,
+                          uci_stack_info_t&         info) const;
+
+  /**
+   * Internal UCI notification to the stack from the copied UE fields, see send_uci_data()
    */
-  inline int _get_rnti_config(uint16_t rnti, uint32_t enb_cc_idx, srsran::phy_cfg_t& phy_cfg) const;
+  void _send_uci_data(uint32_t                  tti,
+                      uint16_t                  rnti,
+                      const srsran_uci_cfg_t&   uci_cfg,
+                      const srsran_uci_value_t& uci_value,
+                      const uci_stack_info_t&   info);
 
   /**
    * Count number of configured secondary serving cells
    *
-   * @param rnti provides UE identifier
+   * @param ue UE object
    * @return The number of configured secondary cells
    */
-  inline uint32_t _count_nof_configured_scell(uint16_t rnti);
+  static inline uint32_t _count_nof_configured_scell(const common_ue& ue);
 
 public:
   /**
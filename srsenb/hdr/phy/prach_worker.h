@@ -24,6 +24,7 @@
 
 #include "srsran/common/block_queue.h"
 #include "srsran/common/buffer_pool.h"
+#include "srsran/common/stage_profiler.h"
 #include "srsran/common/threads.h"
 #include "srsran/interfaces/enb_phy_interfaces.h"
 #include "srsran/srslog/srslog.h"
@@ -53,7 +54,9 @@ public:
             const srsran_prach_cfg_t& prach_cfg_,
             stack_interface_phy_lte*  mac,
             int                       priority,
-            uint32_t                  nof_workers);
+            uint32_t                  nof_workers,
+            srsran::stage_profiler*   stage_prof_ = nullptr,
+            uint32_t                  prof_stage_ = 0);
   int  new_tti(uint32_t tti, cf_t* buffer);
   void set_max_prach_offset_us(float delay_us);
   void stop();
@@ -103,6 +106,8 @@ private:
   uint32_t                 nof_sf      = 0;
   uint32_t                 sf_cnt      = 0;
   uint32_t                 nof_workers = 0;
+  srsran::stage_profiler*  stage_prof  = nullptr; ///< Optional, PRACH detection time is added to prof_stage
+  uint32_t                 prof_stage  = 0;
 
   void run_thread() final;
   int  run_tti(sf_buffer* b);
@@ -123,14 +128,16 @@ public:
             stack_interface_phy_lte*  mac,
             srslog::basic_logger&     logger,
             int                       priority,
-            uint32_t                  nof_workers_x_cc)
+            uint32_t                  nof_workers_x_cc,
+            srsran::stage_profiler*   stage_prof = nullptr,
+            uint32_t                  prof_stage = 0)
   {
     // Create PRACH worker if required
     while (cc_idx >= prach_vec.size()) {
       prach_vec.push_back(std::unique_ptr<prach_worker>(new prach_worker(prach_vec.size(), logger)));
     }
 
-    prach_vec[cc_idx]->init(cell_, prach_cfg_, mac, priority, nof_workers_x_cc);
+    prach_vec[cc_idx]->init(cell_, prach_cfg_, mac, priority, nof_workers_x_cc, stage_prof, prof_stage);
   }
 
   void set_max_prach_offset_us(float delay_us)
@@ -22,6 +22,7 @@
 #ifndef SRSRAN_ENB_STACK_BASE_H
 #define SRSRAN_ENB_STACK_BASE_H
 
+#include "srsran/common/pcap_writer.h"
 #include "srsran/interfaces/enb_interfaces.h"
 #include "srsran/interfaces/enb_mac_interfaces.h"
 #include "srsran/interfaces/enb_s1ap_interfaces.h"
@@ -71,16 +72,20 @@ typedef struct {
 typedef struct {
   uint32_t         sync_queue_size; // Max allowed difference between PHY and Stack clocks (in TTI)
   uint32_t         gtpu_indirect_tunnel_timeout_msec;
+  uint32_t         bulk_task_budget_us; // Time per TTI for user plane and metrics tasks (in us), 0 for unlimited
+  uint32_t         metrics_max_ues;     // Max UEs collected per metrics period, the most active ones, 0 for all UEs
   mac_args_t       mac;
   s1ap_args_t      s1ap;
-  pcap_args_t      mac_pcap;
-  pcap_net_args_t  mac_pcap_net;
-  pcap_args_t      s1ap_pcap;
+  pcap_args_t             mac_pcap;
+  pcap_net_args_t         mac_pcap_net;
+  pcap_args_t             s1ap_pcap;
+  srsran::pcap_rotation_t pcap_rotation;
   stack_log_args_t log;
   embms_args_t     embms;
 } stack_args_t;
 
 struct stack_metrics_t;
+struct stack_mem_footprint_t;
 
 class enb_stack_base
 {
@@ -94,6 +99,7 @@ public:
   virtual void toggle_padding() = 0;
   // eNB metrics interface
   virtual bool get_metrics(stack_metrics_t* metrics) = 0;
+  virtual bool get_mem_footprint(stack_mem_footprint_t* footprint) = 0;
 
   virtual void tti_clock() = 0;
 };
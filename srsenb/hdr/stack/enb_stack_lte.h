@@ -40,6 +40,7 @@
 #include "srsran/common/mac_pcap_net.h"
 #include "srsran/interfaces/enb_interfaces.h"
 #include "srsran/srslog/srslog.h"
+#include <future>
 
 namespace srsenb {
 
@@ -59,6 +60,7 @@ public:
   void stop() final;
   std::string get_type() final;
   bool        get_metrics(stack_metrics_t* metrics) final;
+  bool        get_mem_footprint(stack_mem_footprint_t* footprint) final;
 
   /* PHY-MAC interface */
   int  sr_detected(uint32_t tti, uint16_t rnti) final { return mac.sr_detected(tti, rnti); }
@@ -153,6 +155,8 @@ private:
   void run_thread() override;
   void stop_impl();
   void tti_clock_impl();
+  void log_task_metrics();
+  void get_selected_ue_metrics(stack_metrics_t& metrics);
 
   // args
   stack_args_t args    = {};
@@ -193,8 +197,6 @@ private:
 
   // state
   std::atomic<bool> started{false};
-
-  srsran::dyn_blocking_queue<stack_metrics_t> pending_stack_metrics;
 };
 
 } // namespace srsenb
@@ -64,6 +64,7 @@ public:
   void        stop() final;
   std::string get_type() final;
   bool        get_metrics(srsenb::stack_metrics_t* metrics) final;
+  bool        get_mem_footprint(srsenb::stack_mem_footprint_t* footprint) final { return false; }
 
   // GW srsue stack_interface_gw dummy interface
   bool is_registered() override { return true; };
@@ -22,6 +22,7 @@
 #ifndef SRSENB_MAC_METRICS_H
 #define SRSENB_MAC_METRICS_H
 
+#include <algorithm>
 #include <cstdint>
 #include <vector>
 
@@ -71,6 +72,37 @@ struct mac_metrics_t {
   std::vector<mac_ue_metrics_t> ues;
 };
 
+/**
+ * Selects the UEs to report from the first nof_ues entries of the MAC metrics.
+ *
+ * With max_ues equal to 0 every UE is selected. Otherwise only the UEs that transmitted or received in the period are
+ * selected, at most max_ues of them with the highest bit rates, so that the cost of collecting and formatting the
+ * report does not grow with the number of idle UEs.
+ * @return indexes of the selected UEs in increasing order
+ */
+inline std::vector<uint32_t> mac_select_reported_ues(const mac_metrics_t& mac, size_t nof_ues, uint32_t max_ues)
+{
+  nof_ues = std::min(nof_ues, mac.ues.size());
+
+  std::vector<uint32_t> idxs;
+  idxs.reserve(nof_ues);
+  for (uint32_t i = 0; i < nof_ues; ++i) {
+    if (max_ues == 0 or mac.ues[i].tx_pkts > 0 or mac.ues[i].rx_pkts > 0) {
+      idxs.push_back(i);
+    }
+  }
+
+  if (max_ues > 0 and idxs.size() > max_ues) {
+    auto higher_brate = [&mac](uint32_t a, uint32_t b) {
+      return (int64_t)mac.ues[a].tx_brate + mac.ues[a].rx_brate > (int64_t)mac.ues[b].tx_brate + mac.ues[b].rx_brate;
+    };
+    std::nth_element(idxs.begin(), idxs.begin() + max_ues, idxs.end(), higher_brate);
+    idxs.resize(max_ues);
+    std::sort(idxs.begin(), idxs.end());
+  }
+  return idxs;
+}
+
 } // namespace srsenb
 
 #endif // SRSENB_MAC_METRICS_H
@@ -103,6 +103,7 @@ public:
   uint16_t reserve_new_crnti(const sched_interface::ue_cfg_t& ue_cfg) override;
 
   void get_metrics(mac_metrics_t& metrics);
+  void get_mem_footprint(stack_mem_footprint_t& footprint);
 
   void toggle_padding();
 
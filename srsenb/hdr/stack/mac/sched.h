@@ -61,6 +61,7 @@ public:
 
   uint32_t get_ul_buffer(uint16_t rnti) final;
   uint32_t get_dl_buffer(uint16_t rnti) final;
+  int get_ue_metrics_state(uint16_t rnti, uint32_t& ul_buffer, uint32_t& dl_buffer, uint32_t& pcell_enb_cc_idx) final;
 
   int dl_rlc_buffer_state(uint16_t rnti, uint32_t lc_id, uint32_t tx_queue, uint32_t prio_tx_queue) final;
   int dl_mac_buffer_state(uint16_t rnti, uint32_t ce_code, uint32_t nof_cmds = 1) final;
@@ -87,6 +88,9 @@ public:
   std::array<int, SRSRAN_MAX_CARRIERS> get_enb_ue_activ_cc_map(uint16_t rnti) final;
   int                                  ul_buffer_add(uint16_t rnti, uint32_t lcid, uint32_t bytes) final;
 
+  /// Bytes held by the scheduler contexts of all the UEs
+  size_t get_mem_footprint();
+
   class carrier_sched;
 
 protected:
@@ -268,6 +268,18 @@ public:
   virtual uint32_t get_ul_buffer(uint16_t rnti) = 0;
   virtual uint32_t get_dl_buffer(uint16_t rnti) = 0;
 
+  /**
+   * Reads the state reported in the UE metrics with a single access to the UE database.
+   *
+   * @param rnti user rnti
+   * @param ul_buffer pending bytes for new UL transmissions
+   * @param dl_buffer pending bytes for new DL RLC transmissions
+   * @param pcell_enb_cc_idx eNB carrier index of the UE PCell, SRSRAN_MAX_CARRIERS if it has none
+   * @return SRSRAN_ERROR if the user does not exist
+   */
+  virtual int
+  get_ue_metrics_state(uint16_t rnti, uint32_t& ul_buffer, uint32_t& dl_buffer, uint32_t& pcell_enb_cc_idx) = 0;
+
   /******************* Scheduling Interface ***********************/
 
   /**
@@ -145,6 +145,8 @@ public:
 
   uint32_t get_max_retx();
 
+  size_t get_mem_footprint() const { return sizeof(sched_ue) + cells.capacity() * sizeof(sched_ue_cell); }
+
   bool pdsch_enabled(tti_point tti_rx, uint32_t enb_cc_idx) const;
   bool pusch_enabled(tti_point tti_rx, uint32_t enb_cc_idx, bool needs_pdcch) const;
   bool phich_enabled(tti_point tti_rx, uint32_t enb_cc_idx) const;
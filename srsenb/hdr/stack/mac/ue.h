@@ -67,6 +67,8 @@ struct ue_cc_softbuffers {
     return softbuffer_tx_list.at(pid * SRSRAN_MAX_TB + tb_idx);
   }
   srsran_softbuffer_rx_t& get_rx(uint32_t tti) { return softbuffer_rx_list.at(tti % nof_rx_harq_proc); }
+
+  size_t get_mem_footprint() const;
 };
 
 /// Class to manage the allocation, deallocation & access to pending UL HARQ buffers
@@ -111,11 +113,14 @@ public:
     return cc_softbuffers->get_tx(pid, tb_idx);
   }
   srsran_softbuffer_rx_t& get_rx_softbuffer(uint32_t tti) { return cc_softbuffers->get_rx(tti); }
-  srsran::byte_buffer_t*  get_tx_payload_buffer(size_t harq_pid, size_t tb)
-  {
-    return tx_payload_buffer[harq_pid][tb].get();
-  }
-  cc_used_buffers_map& get_rx_used_buffers() { return rx_used_buffers; }
+  srsran::byte_buffer_t*  get_tx_payload_buffer(size_t harq_pid, size_t tb);
+  cc_used_buffers_map&    get_rx_used_buffers() { return rx_used_buffers; }
+
+  /// Allocates the Tx payload buffers of all HARQ processes upfront, otherwise they are allocated on first use
+  void   allocate_tx_payload_buffers();
+  /// Returns the Tx payload buffers to the pool once none was used for max_tx_idle_ttis TTIs
+  void   release_idle_tx_payload_buffers();
+  size_t get_mem_footprint() const;
 
 private:
   // CC softbuffers
@@ -126,6 +131,10 @@ private:
 
   // One buffer per TB per DL HARQ process and per carrier is needed for each UE.
   std::array<std::array<srsran::unique_byte_buffer_t, SRSRAN_MAX_TB>, SRSRAN_FDD_NOF_HARQ> tx_payload_buffer;
+
+  // A payload is only read by the PHY in the TTI it is generated, retransmissions use the softbuffer
+  static const uint32_t max_tx_idle_ttis = SRSRAN_FDD_NOF_HARQ + 4;
+  uint32_t              nof_tx_idle_ttis = 0;
 };
 
 class ue : public srsran::read_pdu_interface, public mac_ta_ue_interface
@@ -139,7 +148,8 @@ public:
      phy_interface_stack_lte*                 phy_,
      srslog::basic_logger&                    logger,
      uint32_t                                 nof_cells_,
-     srsran::obj_pool_itf<ue_cc_softbuffers>* softbuffer_pool);
+     srsran::obj_pool_itf<ue_cc_softbuffers>* softbuffer_pool,
+     bool                                     compact_ctx_ = false);
 
   virtual ~ue();
   void reset();
@@ -177,7 +187,7 @@ public:
   void                         clear_old_buffers(uint32_t tti);
 
   std::mutex metrics_mutex = {};
-  void       metrics_read(mac_ue_metrics_t* metrics_);
+  bool       metrics_read(mac_ue_metrics_t* metrics_);
   void       metrics_rx(bool crc, uint32_t tbs);
   void       metrics_tx(bool crc, uint32_t tbs);
   void       metrics_phr(float phr);
@@ -188,6 +198,9 @@ public:
 
   uint32_t read_pdu(uint32_t lcid, uint8_t* payload, uint32_t requested_bytes) final;
 
+  /// Bytes held by the UE context, including the softbuffers and HARQ payload buffers in use
+  size_t get_mem_footprint();
+
 private:
   void allocate_sdu(srsran::sch_pdu* pdu, uint32_t lcid, uint32_t sdu_len);
   bool process_ce(srsran::sch_subh* subh, uint32_t grant_nof_prbs);
@@ -215,6 +228,7 @@ private:
   mac_ue_metrics_t ue_metrics     = {};
 
   srsran::obj_pool_itf<ue_cc_softbuffers>* softbuffer_pool = nullptr;
+  bool                                     compact_ctx     = false;
 
   srsran::block_queue<uint32_t> pending_ta_commands;
   ta                            ta_fsm;
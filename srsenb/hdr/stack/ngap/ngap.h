@@ -22,7 +22,9 @@
 #define SRSENB_NGAP_H
 
 #include "ngap_metrics.h"
+#include "ngap_ue_utils.h"
 #include "srsenb/hdr/common/common_enb.h"
+#include "srsenb/hdr/stack/s1ap/s1ap_ue_registry.h"
 #include "srsran/adt/circular_map.h"
 #include "srsran/adt/optional.h"
 #include "srsran/asn1/asn1_utils.h"
@@ -137,27 +139,27 @@ private:
   // TS 38.413 - Section 9.2.1.1 - PDU Session Resource Setup Request
   bool handle_ue_pdu_session_res_setup_request(const asn1::ngap_nr::pdu_session_res_setup_request_s& msg);
 
-  class user_list
+  /// UE IDs used by the registry to index the NGAP UE contexts
+  struct ngap_ue_ctxt_ids {
+    static const char*                       logger_name() { return "NGAP"; }
+    static const char*                       ran_id_name() { return "ran ue ngap id"; }
+    static const char*                       core_id_name() { return "amf id"; }
+    static uint32_t                          ran_id(const ngap_ue_ctxt_t& ctxt) { return ctxt.ran_ue_ngap_id; }
+    static const srsran::optional<uint32_t>& core_id(const ngap_ue_ctxt_t& ctxt) { return ctxt.amf_ue_ngap_id; }
+    static void                              set_core_id(ngap_ue_ctxt_t& ctxt, uint32_t id)
+    {
+      ctxt.amf_ue_ngap_id = id;
+    }
+  };
+
+  /// Users keyed by RAN-UE-NGAP-ID, with indexes by RNTI and AMF-UE-NGAP-ID. The AMF-UE-NGAP-ID of a registered user
+  /// shall only be set through set_amf_ue_ngap_id(), which keeps the index consistent
+  class user_list : public s1ap_ue_registry<ue, ngap_ue_ctxt_ids>
   {
   public:
-    using value_type     = std::unique_ptr<ue>;
-    using iterator       = std::unordered_map<uint32_t, value_type>::iterator;
-    using const_iterator = std::unordered_map<uint32_t, value_type>::const_iterator;
-    using pair_type      = std::unordered_map<uint32_t, value_type>::value_type;
-
-    ue*            find_ue_rnti(uint16_t rnti);
-    ue*            find_ue_gnbid(uint32_t gnbid);
-    ue*            find_ue_amfid(uint32_t amfid);
-    ue*            add_user(value_type user);
-    void           erase(ue* ue_ptr);
-    iterator       begin() { return users.begin(); }
-    iterator       end() { return users.end(); }
-    const_iterator cbegin() const { return users.begin(); }
-    const_iterator cend() const { return users.end(); }
-    size_t         size() const { return users.size(); }
-
-  private:
-    std::unordered_map<uint32_t, std::unique_ptr<ue> > users; // maps ran_ue_ngap_id to user
+    ue*  find_ue_gnbid(uint32_t gnbid);
+    ue*  find_ue_amfid(uint32_t amfid);
+    bool set_amf_ue_ngap_id(ue* ue_ptr, uint32_t amfid);
   };
   user_list users;
 
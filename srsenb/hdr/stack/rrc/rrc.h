@@ -48,6 +48,7 @@ class mac_interface_rrc;
 class phy_interface_rrc_lte;
 
 class paging_manager;
+class meas_cfg_cache;
 
 static const char rrc_state_text[RRC_STATE_N_ITEMS][100] = {"IDLE",
                                                             "WAIT FOR CON SETUP COMPLETE",
@@ -84,9 +85,12 @@ public:
                gtpu_interface_rrc*    gtpu,
                rrc_nr_interface_rrc*  rrc_nr);
 
-  void stop();
-  void get_metrics(rrc_metrics_t& m);
-  void tti_clock();
+  void   stop();
+  void   get_metrics(rrc_metrics_t& m);
+  /// Collects the metrics of the given users only, in that order
+  void   get_metrics(rrc_metrics_t& m, const std::vector<uint16_t>& rntis);
+  size_t get_mem_footprint();
+  void   tti_clock();
 
   // rrc_interface_mac
   int      add_user(uint16_t rnti, const sched_interface::ue_cfg_t& init_ue_cfg) override;
@@ -194,6 +198,7 @@ private:
   std::unique_ptr<freq_res_common_list>    cell_res_list;
   std::map<uint16_t, unique_rnti_ptr<ue> > users; // NOTE: has to have fixed addr
   std::unique_ptr<paging_manager>          pending_paging;
+  std::unique_ptr<meas_cfg_cache>          meas_cache;
 
   void     process_release_complete(uint16_t rnti);
   void     rem_user(uint16_t rnti);
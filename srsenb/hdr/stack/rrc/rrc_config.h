@@ -80,6 +80,7 @@ struct rrc_cfg_t {
   bool                                                                                    enable_mbsfn;
   uint16_t                                                                                mbms_mcs;
   uint32_t                                                                                inactivity_timeout_ms;
+  bool                                                                                    parallel_ul_dcch = false;
   std::array<srsran::CIPHERING_ALGORITHM_ID_ENUM, srsran::CIPHERING_ALGORITHM_ID_N_ITEMS> eea_preference_list;
   std::array<srsran::INTEGRITY_ALGORITHM_ID_ENUM, srsran::INTEGRITY_ALGORITHM_ID_N_ITEMS> eia_preference_list;
   bool                                                                                    meas_cfg_present = false;
@@ -99,6 +100,7 @@ constexpr uint32_t UE_PCELL_CC_IDX = 0;
 struct ue_var_cfg_t {
   asn1::rrc::rr_cfg_ded_s                rr_cfg;
   asn1::rrc::meas_cfg_s                  meas_cfg;
+  uint32_t                               meas_cfg_id = 0; ///< Id of meas_cfg in the eNB meas_cfg_cache (0 is empty)
   asn1::rrc::scell_to_add_mod_list_r10_l scells;
 };
 
@@ -24,6 +24,7 @@
 
 #include "rrc_config_common.h"
 #include "rrc_metrics.h"
+#include "srsenb/hdr/common/common_enb.h"
 #include "srsenb/hdr/stack/enb_stack_base.h"
 #include "srsenb/hdr/stack/rrc/nr/rrc_config_nr.h"
 #include "srsran/asn1/rrc_nr.h"
@@ -110,6 +111,9 @@ public:
   int  set_aggregate_max_bitrate(uint16_t rnti, const asn1::ngap_nr::ue_aggregate_maximum_bit_rate_s& rates);
   int  allocate_lcid(uint16_t rnti);
 
+  /// Fills the whole secondary cell group config of a UE. The UEs get a copy of it packed once, with their RNTI
+  int fill_secondary_cell_group_cfg(uint16_t rnti, asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg);
+
   class ue
   {
   public:
@@ -157,40 +161,6 @@ public:
     int pack_rrc_reconfiguration(asn1::dyn_octstring& packed_rrc_reconfig);
     int pack_secondary_cell_group_cfg(asn1::dyn_octstring& packed_secondary_cell_config);
 
-    int pack_secondary_cell_group_rlc_cfg(asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack);
-    int pack_secondary_cell_group_mac_cfg(asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack);
-
-    int pack_secondary_cell_group_sp_cell_cfg(asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack);
-
-    int pack_sp_cell_cfg_ded(asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack);
-
-    int pack_sp_cell_cfg_ded_init_dl_bwp(asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack);
-    int pack_sp_cell_cfg_ded_init_dl_bwp_pdsch_cfg(asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack);
-    int pack_sp_cell_cfg_ded_init_dl_bwp_radio_link_monitoring(asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack);
-
-    int pack_sp_cell_cfg_ded_ul_cfg(asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack);
-    int pack_sp_cell_cfg_ded_ul_cfg_init_ul_bwp(asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack);
-    int pack_sp_cell_cfg_ded_ul_cfg_init_ul_bwp_pucch_cfg(asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack);
-    int pack_sp_cell_cfg_ded_ul_cfg_init_ul_bwp_pusch_cfg(asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack);
-
-    int pack_sp_cell_cfg_ded_pdcch_serving_cell_cfg(asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack);
-
-    int pack_recfg_with_sync(asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack);
-    int pack_recfg_with_sync_sp_cell_cfg_common(asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack);
-    int pack_recfg_with_sync_sp_cell_cfg_common_dl_cfg_common(asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack);
-    int pack_recfg_with_sync_sp_cell_cfg_common_dl_cfg_common_phy_cell_group_cfg(
-        asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack);
-
-    int pack_recfg_with_sync_sp_cell_cfg_common_dl_cfg_init_dl_bwp(asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack);
-    int pack_recfg_with_sync_sp_cell_cfg_common_dl_cfg_init_dl_bwp_pdsch_cfg_common(
-        asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack);
-
-    int pack_recfg_with_sync_sp_cell_cfg_common_ul_cfg_common(asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack);
-    int pack_recfg_with_sync_sp_cell_cfg_common_ul_cfg_common_init_ul_bwp(
-        asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack);
-    int pack_recfg_with_sync_sp_cell_cfg_common_ul_cfg_common_init_ul_bwp_pusch_cfg_common(
-        asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack);
-
     int pack_nr_radio_bearer_config(asn1::dyn_octstring& packed_nr_bearer_config);
 
     int add_drb();
@@ -199,15 +169,12 @@ public:
     rrc_nr_state_t state          = rrc_nr_state_t::RRC_IDLE;
     uint8_t        transaction_id = 0;
 
-    // RRC configs for UEs
-    asn1::rrc_nr::cell_group_cfg_s   cell_group_cfg;
+    // RRC configs for UEs, the cell group config is common to all UEs (see rrc_nr::base_cell_group_cfg)
     asn1::rrc_nr::radio_bearer_cfg_s radio_bearer_cfg;
 
     // MAC controller
     sched_nr_interface::ue_cfg_t uecfg{};
 
-    const uint32_t drb1_lcid = 4;
-
     // NSA specific variables
     bool     endc       = false;
     uint16_t eutra_rnti = SRSRAN_INVALID_RNTI;
@@ -215,6 +182,7 @@ public:
 
 private:
   static constexpr uint32_t UE_PSCELL_CC_IDX = 0; // first NR cell is always Primary Secondary Cell for UE
+  static constexpr uint32_t drb1_lcid        = 4;
   rrc_nr_cfg_t              cfg              = {};
 
   // interfaces
@@ -234,8 +202,17 @@ private:
   srslog::basic_logger&       logger;
   asn1::rrc_nr::sp_cell_cfg_s base_sp_cell_cfg;
 
+  // Secondary cell group config shared by all UEs, which only differ in the newUE-Identity. It is packed once with
+  // newUE-Identity=0 and the RNTI of each UE is written at new_ue_id_bit_pos of a copy of the packed config
+  asn1::rrc_nr::cell_group_cfg_s base_cell_group_cfg;
+  asn1::dyn_octstring            base_cell_group_cfg_packed;
+  uint32_t                       new_ue_id_bit_pos = 0;
+
+  // PHY config applied to the UEs added through SgNB addition
+  srsran::phy_cfg_nr_t base_ue_phy_cfg;
+
   // vars
-  std::map<uint16_t, std::unique_ptr<ue> >  users;
+  rnti_map_t<std::unique_ptr<ue> >          users;
   bool                                      running = false;
   std::vector<srsran::unique_byte_buffer_t> sib_buffer;
   srsran::unique_byte_buffer_t              mib_buffer = nullptr;
@@ -247,6 +224,43 @@ private:
   /// This gets called by rrc_nr::sgnb_addition_request and WILL NOT TRIGGER the RX MSG3 activity timer
   int add_user(uint16_t rnti, const sched_nr_ue_cfg_t& uecfg, bool start_msg3_timer);
 
+  // Helpers to fill and pack base_cell_group_cfg
+  int pack_base_cell_group_cfg();
+
+  int pack_secondary_cell_group_rlc_cfg(asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack);
+  int pack_secondary_cell_group_mac_cfg(asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack);
+
+  int pack_secondary_cell_group_sp_cell_cfg(asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack);
+
+  int pack_sp_cell_cfg_ded(asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack);
+
+  int pack_sp_cell_cfg_ded_init_dl_bwp(asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack);
+  int pack_sp_cell_cfg_ded_init_dl_bwp_pdsch_cfg(asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack);
+  int pack_sp_cell_cfg_ded_init_dl_bwp_radio_link_monitoring(asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack);
+
+  int pack_sp_cell_cfg_ded_ul_cfg(asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack);
+  int pack_sp_cell_cfg_ded_ul_cfg_init_ul_bwp(asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack);
+  int pack_sp_cell_cfg_ded_ul_cfg_init_ul_bwp_pucch_cfg(asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack);
+  int pack_sp_cell_cfg_ded_ul_cfg_init_ul_bwp_pusch_cfg(asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack);
+
+  int pack_sp_cell_cfg_ded_pdcch_serving_cell_cfg(asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack);
+
+  int pack_recfg_with_sync(asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack);
+  int pack_recfg_with_sync_sp_cell_cfg_common(asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack);
+  int pack_recfg_with_sync_sp_cell_cfg_common_dl_cfg_common(asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack);
+  int pack_recfg_with_sync_sp_cell_cfg_common_dl_cfg_common_phy_cell_group_cfg(
+      asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack);
+
+  int pack_recfg_with_sync_sp_cell_cfg_common_dl_cfg_init_dl_bwp(asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack);
+  int pack_recfg_with_sync_sp_cell_cfg_common_dl_cfg_init_dl_bwp_pdsch_cfg_common(
+      asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack);
+
+  int pack_recfg_with_sync_sp_cell_cfg_common_ul_cfg_common(asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack);
+  int pack_recfg_with_sync_sp_cell_cfg_common_ul_cfg_common_init_ul_bwp(
+      asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack);
+  int pack_recfg_with_sync_sp_cell_cfg_common_ul_cfg_common_init_ul_bwp_pusch_cfg_common(
+      asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack);
+
   // logging
   typedef enum { Rx = 0, Tx } direction_t;
   template <class T>
@@ -26,6 +26,7 @@
 #include "rrc.h"
 #include "srsran/adt/pool/batch_mem_pool.h"
 #include "srsran/asn1/rrc/uecap.h"
+#include "srsran/common/thread_pool.h"
 #include "srsran/interfaces/enb_phy_interfaces.h"
 #include "srsran/interfaces/pdcp_interface_types.h"
 
@@ -93,6 +94,22 @@ public:
   void send_ue_cap_enquiry(const std::vector<asn1::rrc::rat_type_opts::options>& rats);
   void send_ue_info_req();
 
+  /// UL-DCCH message and the parts of it that are decoded before it is handled, independently of the UE state
+  struct ul_dcch_rx_t {
+    uint32_t                     lcid = 0;
+    srsran::unique_byte_buffer_t pdu;
+    bool                         msg_valid = false;
+    asn1::rrc::ul_dcch_msg_s     msg;
+    /// Result of unpacking the EUTRA capabilities of an UECapabilityInformation
+    bool                      eutra_cap_present = false;
+    bool                      eutra_cap_valid   = false;
+    asn1::rrc::ue_eutra_cap_s eutra_cap;
+  };
+
+  /**
+   * Decodes and handles an UL-DCCH PDU. If enabled in the config, the PDU is decoded in the background workers, in
+   * order with the other PDUs of the UE, and only handled in the stack thread.
+   */
   void parse_ul_dcch(uint32_t lcid, srsran::unique_byte_buffer_t pdu);
 
   /// List of generated RRC events.
@@ -117,7 +134,7 @@ public:
   void handle_rrc_reconf_complete(asn1::rrc::rrc_conn_recfg_complete_s* msg, srsran::unique_byte_buffer_t pdu);
   void handle_security_mode_complete(asn1::rrc::security_mode_complete_s* msg);
   void handle_security_mode_failure(asn1::rrc::security_mode_fail_s* msg);
-  int  handle_ue_cap_info(asn1::rrc::ue_cap_info_s* msg);
+  int  handle_ue_cap_info(ul_dcch_rx_t& rx);
   void handle_ue_init_ctxt_setup_req(const asn1::s1ap::init_context_setup_request_s& msg);
   bool handle_ue_ctxt_mod_req(const asn1::s1ap::ue_context_mod_request_s& msg);
   void handle_ue_info_resp(const asn1::rrc::ue_info_resp_r9_s& msg, srsran::unique_byte_buffer_t pdu);
@@ -175,6 +192,13 @@ public:
   bool is_csfb = false;
 
 private:
+  /// Decodes the UL-DCCH message. Does not access the UE, so it can run outside of the stack thread
+  static void decode_ul_dcch(ul_dcch_rx_t& rx);
+  void        handle_ul_dcch(ul_dcch_rx_t& rx);
+
+  /// Decoding of the UL-DCCH PDUs of this UE in the background workers
+  srsran::serial_task_queue ul_dcch_queue;
+
   srsran::unique_timer activity_timer; // for basic DL/UL activity timeout
 
   /// Radio link failure handling uses distinct timers for PHY (DL and UL) and RLC signaled RLF
@@ -23,6 +23,10 @@
 #define SRSRAN_UE_MEAS_CFG_H
 
 #include "srsran/asn1/rrc/meascfg.h"
+#include <limits>
+#include <map>
+#include <memory>
+#include <vector>
 
 namespace srsenb {
 
@@ -82,6 +86,51 @@ bool apply_meascfg_updates(asn1::rrc::meas_cfg_s&          diff_meascfg,
                            int                             prev_earfcn = -1,
                            int                             prev_pci    = -1);
 
+/**
+ * Cache of the measConfigs derived from the eNB config. The measConfig of a UE only depends on its PCell and on its
+ * SCells, so UEs with the same cells share the same measConfig, identified by an id. The difference between two cached
+ * measConfigs is computed once, and reused in every reconfiguration and handover between them.
+ * The measGap config depends on the UE and is not part of the cached measConfigs.
+ */
+class meas_cfg_cache
+{
+public:
+  /// Id of the empty measConfig of a UE that was not configured yet
+  static const uint32_t empty_cfg_id = 0;
+  /// Id of a measConfig that is not in the cache, e.g. the one received in a handover preparation
+  static const uint32_t invalid_cfg_id = std::numeric_limits<uint32_t>::max();
+
+  meas_cfg_cache();
+
+  /// Gets the id of the measConfig of a UE with the given cells, generating the measConfig the first time
+  uint32_t                     get_cfg_id(const ue_cell_ded_list& ue_cell_list);
+  const asn1::rrc::meas_cfg_s& get_cfg(uint32_t cfg_id) const { return *cfgs[cfg_id]; }
+
+  /// Gets the difference between two cached measConfigs, computing it the first time
+  const asn1::rrc::meas_cfg_s& get_diff(uint32_t src_cfg_id, uint32_t target_cfg_id);
+
+  size_t nof_cfgs() const { return cfgs.size(); }
+  size_t nof_diffs() const { return diffs.size(); }
+
+private:
+  std::map<std::vector<uint32_t>, uint32_t>                      cfg_ids; ///< key: enb_cc_idx of PCell and SCells
+  std::vector<std::unique_ptr<asn1::rrc::meas_cfg_s> >           cfgs;
+  std::map<std::pair<uint32_t, uint32_t>, asn1::rrc::meas_cfg_s> diffs;
+};
+
+/**
+ * Same as apply_meascfg_updates(), but the target measConfig and its difference from the previous one are taken from
+ * the cache when possible. Only the measGap config is computed for the UE.
+ * @param prev_cfg_id id of prev_meascfg in the cache, set to the id of the new measConfig on return
+ */
+bool apply_meascfg_updates(asn1::rrc::meas_cfg_s&  diff_meascfg,
+                           asn1::rrc::meas_cfg_s&  prev_meascfg,
+                           uint32_t&               prev_cfg_id,
+                           const ue_cell_ded_list& ue_cell_list,
+                           meas_cfg_cache&         cache,
+                           int                     prev_earfcn = -1,
+                           int                     prev_pci    = -1);
+
 } // namespace srsenb
 
 #endif // SRSRAN_UE_MEAS_CFG_H
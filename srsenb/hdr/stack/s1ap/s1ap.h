@@ -34,6 +34,7 @@
 #include "srsran/interfaces/enb_s1ap_interfaces.h"
 
 #include "s1ap_metrics.h"
+#include "s1ap_ue_registry.h"
 #include "srsran/adt/optional.h"
 #include "srsran/asn1/s1ap.h"
 #include "srsran/common/network_utils.h"
@@ -46,16 +47,6 @@ namespace srsenb {
 
 class rrc_interface_s1ap;
 
-struct ue_ctxt_t {
-  static const uint32_t invalid_enb_id = std::numeric_limits<uint32_t>::max();
-
-  uint16_t                   rnti           = SRSRAN_INVALID_RNTI;
-  uint32_t                   enb_ue_s1ap_id = invalid_enb_id;
-  srsran::optional<uint32_t> mme_ue_s1ap_id;
-  uint32_t                   enb_cc_idx     = 0;
-  struct timeval             init_timestamp = {};
-};
-
 class s1ap : public s1ap_interface_rrc
 {
   using s1ap_proc_id_t = asn1::s1ap::s1ap_elem_procs_o::init_msg_c::types_opts::options;
@@ -67,9 +58,10 @@ public:
   s1ap(srsran::task_sched_handle   task_sched_,
        srslog::basic_logger&       logger,
        srsran::socket_manager_itf* rx_socket_handler);
-  int  init(const s1ap_args_t& args_, rrc_interface_s1ap* rrc_);
-  void stop();
-  void get_metrics(s1ap_metrics_t& m);
+  int    init(const s1ap_args_t& args_, rrc_interface_s1ap* rrc_);
+  void   stop();
+  void   get_metrics(s1ap_metrics_t& m);
+  size_t get_mem_footprint() const;
 
   // RRC interface
   void initial_ue(uint16_t                              rnti,
@@ -298,28 +290,7 @@ private:
     srsran::proc_t<ho_prep_proc_t> ho_prep_proc;
   };
 
-  class user_list
-  {
-  public:
-    using value_type     = std::unique_ptr<ue>;
-    using iterator       = std::unordered_map<uint32_t, value_type>::iterator;
-    using const_iterator = std::unordered_map<uint32_t, value_type>::const_iterator;
-    using pair_type      = std::unordered_map<uint32_t, value_type>::value_type;
-
-    ue*            find_ue_rnti(uint16_t rnti);
-    ue*            find_ue_enbid(uint32_t enbid);
-    ue*            find_ue_mmeid(uint32_t mmeid);
-    ue*            add_user(value_type user);
-    void           erase(ue* ue_ptr);
-    iterator       begin() { return users.begin(); }
-    iterator       end() { return users.end(); }
-    const_iterator cbegin() const { return users.begin(); }
-    const_iterator cend() const { return users.end(); }
-    size_t         size() const { return users.size(); }
-
-  private:
-    std::unordered_map<uint32_t, std::unique_ptr<ue> > users; // maps ENB_S1AP_ID to user
-  };
+  using user_list = s1ap_ue_registry<ue>;
   user_list users;
 
   // procedures
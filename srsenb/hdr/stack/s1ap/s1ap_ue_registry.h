@@ -0,0 +1,187 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSENB_S1AP_UE_REGISTRY_H
+#define SRSENB_S1AP_UE_REGISTRY_H
+
+#include "srsran/adt/optional.h"
+#include "srsran/phy/common/phy_common.h"
+#include "srsran/srslog/srslog.h"
+#include <limits>
+#include <memory>
+#include <sys/time.h>
+#include <unordered_map>
+
+namespace srsenb {
+
+struct ue_ctxt_t {
+  static const uint32_t invalid_enb_id = std::numeric_limits<uint32_t>::max();
+
+  uint16_t                   rnti           = SRSRAN_INVALID_RNTI;
+  uint32_t                   enb_ue_s1ap_id = invalid_enb_id;
+  srsran::optional<uint32_t> mme_ue_s1ap_id;
+  uint32_t                   enb_cc_idx     = 0;
+  struct timeval             init_timestamp = {};
+};
+
+/// UE IDs used by the registry to index the S1AP UE contexts
+struct s1ap_ue_ctxt_ids {
+  static const char*                       logger_name() { return "S1AP"; }
+  static const char*                       ran_id_name() { return "enb id"; }
+  static const char*                       core_id_name() { return "mme id"; }
+  static uint32_t                          ran_id(const ue_ctxt_t& ctxt) { return ctxt.enb_ue_s1ap_id; }
+  static const srsran::optional<uint32_t>& core_id(const ue_ctxt_t& ctxt) { return ctxt.mme_ue_s1ap_id; }
+  static void                              set_core_id(ue_ctxt_t& ctxt, uint32_t id) { ctxt.mme_ue_s1ap_id = id; }
+};
+
+/**
+ * @brief Registry of the S1AP UE contexts of the eNB
+ *
+ * The contexts are owned and keyed by eNB-UE-S1AP-ID, with secondary indexes by RNTI and MME-UE-S1AP-ID, so the three
+ * lookups take constant time whatever the number of connected UEs. The RNTI and MME-UE-S1AP-ID of a registered
+ * context shall only be changed through set_rnti() and set_mme_ue_s1ap_id(), which keep the indexes consistent.
+ * The NGAP keys its UE contexts the same way, by RAN-UE-NGAP-ID and AMF-UE-NGAP-ID, through its own IdTraits.
+ * @tparam UE type of the UE context, with a ctxt member holding the RNTI and the IDs read by IdTraits
+ * @tparam IdTraits accessors of the RAN and core network UE IDs of the context, see s1ap_ue_ctxt_ids
+ */
+template <typename UE, typename IdTraits = s1ap_ue_ctxt_ids>
+class s1ap_ue_registry
+{
+public:
+  using value_type     = std::unique_ptr<UE>;
+  using iterator       = typename std::unordered_map<uint32_t, value_type>::iterator;
+  using const_iterator = typename std::unordered_map<uint32_t, value_type>::const_iterator;
+  using pair_type      = typename std::unordered_map<uint32_t, value_type>::value_type;
+
+  UE* find_ue_rnti(uint16_t rnti)
+  {
+    if (rnti == SRSRAN_INVALID_RNTI) {
+      return nullptr;
+    }
+    auto it = rnti_index.find(rnti);
+    return it != rnti_index.end() ? it->second : nullptr;
+  }
+
+  UE* find_ue_enbid(uint32_t enbid)
+  {
+    auto it = users.find(enbid);
+    return it != users.end() ? it->second.get() : nullptr;
+  }
+
+  UE* find_ue_mmeid(uint32_t mmeid)
+  {
+    auto it = mmeid_index.find(mmeid);
+    return it != mmeid_index.end() ? it->second : nullptr;
+  }
+
+  /**
+   * @brief Adds a user to the registry, avoiding any rnti, enb_s1ap_id, mme_s1ap_id duplication
+   * @param %user to be inserted
+   * @return ptr of inserted %user. If failure, returns nullptr
+   */
+  UE* add_user(value_type user)
+  {
+    const auto& ctxt = user->ctxt;
+    if (find_ue_rnti(ctxt.rnti) != nullptr) {
+      logger.error("The user to be added with rnti=0x%x already exists", ctxt.rnti);
+      return nullptr;
+    }
+    if (find_ue_enbid(IdTraits::ran_id(ctxt)) != nullptr) {
+      logger.error("The user to be added with %s=%d already exists", IdTraits::ran_id_name(), IdTraits::ran_id(ctxt));
+      return nullptr;
+    }
+    const srsran::optional<uint32_t>& core_id = IdTraits::core_id(ctxt);
+    if (core_id.has_value() and find_ue_mmeid(core_id.value()) != nullptr) {
+      logger.error("The user to be added with %s=%d already exists", IdTraits::core_id_name(), core_id.value());
+      return nullptr;
+    }
+    UE* u = user.get();
+    users.insert(std::make_pair(IdTraits::ran_id(ctxt), std::move(user)));
+    if (u->ctxt.rnti != SRSRAN_INVALID_RNTI) {
+      rnti_index[u->ctxt.rnti] = u;
+    }
+    if (IdTraits::core_id(u->ctxt).has_value()) {
+      mmeid_index[IdTraits::core_id(u->ctxt).value()] = u;
+    }
+    return u;
+  }
+
+  void erase(UE* ue_ptr)
+  {
+    auto it = users.find(IdTraits::ran_id(ue_ptr->ctxt));
+    if (it == users.end()) {
+      logger.error("User to be erased does not exist");
+      return;
+    }
+    rnti_index.erase(ue_ptr->ctxt.rnti);
+    if (IdTraits::core_id(ue_ptr->ctxt).has_value()) {
+      mmeid_index.erase(IdTraits::core_id(ue_ptr->ctxt).value());
+    }
+    users.erase(it);
+  }
+
+  /// Changes the RNTI of a registered user, e.g. on handover or RRC re-establishment. Fails if the RNTI is in use
+  bool set_rnti(UE* ue_ptr, uint16_t rnti)
+  {
+    UE* other = find_ue_rnti(rnti);
+    if (other != nullptr) {
+      return other == ue_ptr;
+    }
+    rnti_index.erase(ue_ptr->ctxt.rnti);
+    ue_ptr->ctxt.rnti = rnti;
+    if (rnti != SRSRAN_INVALID_RNTI) {
+      rnti_index[rnti] = ue_ptr;
+    }
+    return true;
+  }
+
+  /// Sets the MME-UE-S1AP-ID of a registered user. Fails if the ID is in use by another user
+  bool set_mme_ue_s1ap_id(UE* ue_ptr, uint32_t mme_id)
+  {
+    UE* other = find_ue_mmeid(mme_id);
+    if (other != nullptr) {
+      return other == ue_ptr;
+    }
+    if (IdTraits::core_id(ue_ptr->ctxt).has_value()) {
+      mmeid_index.erase(IdTraits::core_id(ue_ptr->ctxt).value());
+    }
+    IdTraits::set_core_id(ue_ptr->ctxt, mme_id);
+    mmeid_index[mme_id] = ue_ptr;
+    return true;
+  }
+
+  iterator       begin() { return users.begin(); }
+  iterator       end() { return users.end(); }
+  const_iterator cbegin() const { return users.begin(); }
+  const_iterator cend() const { return users.end(); }
+  size_t         size() const { return users.size(); }
+
+private:
+  srslog::basic_logger& logger = srslog::fetch_basic_logger(IdTraits::logger_name());
+
+  std::unordered_map<uint32_t, value_type> users;       // maps ENB_S1AP_ID (RAN_UE_NGAP_ID) to user
+  std::unordered_map<uint16_t, UE*>        rnti_index;  // maps RNTI to user
+  std::unordered_map<uint32_t, UE*>        mmeid_index; // maps MME_S1AP_ID (AMF_UE_NGAP_ID) to user
+};
+
+} // namespace srsenb
+
+#endif // SRSENB_S1AP_UE_REGISTRY_H
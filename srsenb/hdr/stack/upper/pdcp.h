@@ -73,7 +73,10 @@ public:
   std::map<uint32_t, srsran::unique_byte_buffer_t> get_buffered_pdus(uint16_t rnti, uint32_t lcid) override;
 
   // Metrics
-  void get_metrics(pdcp_metrics_t& m, const uint32_t nof_tti);
+  void   get_metrics(pdcp_metrics_t& m, const uint32_t nof_tti);
+  /// Collects the metrics of the given users only, in that order, and restarts the period of the others
+  void   get_metrics(pdcp_metrics_t& m, const uint32_t nof_tti, const std::vector<uint16_t>& rntis);
+  size_t get_mem_footprint();
 
 private:
   class user_interface_rlc : public srsue::rlc_interface_pdcp
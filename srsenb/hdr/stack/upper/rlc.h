@@ -49,8 +49,11 @@ public:
   explicit rlc(srslog::basic_logger& logger) : logger(logger) {}
   void
   init(pdcp_interface_rlc* pdcp_, rrc_interface_rlc* rrc_, mac_interface_rlc* mac_, srsran::timer_handler* timers_);
-  void stop();
-  void get_metrics(rlc_metrics_t& m, const uint32_t nof_tti);
+  void   stop();
+  void   get_metrics(rlc_metrics_t& m, const uint32_t nof_tti);
+  /// Collects the metrics of the given users only, in that order, and restarts the period of the others
+  void   get_metrics(rlc_metrics_t& m, const uint32_t nof_tti, const std::vector<uint16_t>& rntis);
+  size_t get_mem_footprint();
 
   // rlc_interface_rrc
   void clear_buffer(uint16_t rnti);
@@ -212,8 +212,20 @@ bool enb::get_metrics(enb_metrics_t* m)
   }
   radio->get_metrics(&m->rf);
   phy->get_metrics(m->phy);
+  phy->get_stage_metrics(m->phy_stages);
   if (eutra_stack) {
     eutra_stack->get_metrics(&m->stack);
+    if (args.stack.metrics_max_ues > 0) {
+      // keep the PHY entries aligned with the UEs selected by the stack
+      uint32_t nof_ues = 0;
+      for (uint32_t idx : m->stack.ue_idxs) {
+        if (idx >= m->phy.size()) {
+          break;
+        }
+        m->phy[nof_ues++] = m->phy[idx];
+      }
+      m->phy.resize(nof_ues);
+    }
   }
   if (nr_stack) {
     nr_stack->get_metrics(&m->nr_stack);
@@ -258,6 +270,14 @@ void enb::toggle_padding()
   }
 }
 
+bool enb::cmd_mem_footprint(stack_mem_footprint_t* footprint)
+{
+  if (!started or eutra_stack == nullptr) {
+    return false;
+  }
+  return eutra_stack->get_mem_footprint(footprint);
+}
+
 void enb::tti_clock()
 {
   if (!started) {
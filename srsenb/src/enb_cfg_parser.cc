@@ -1312,6 +1312,7 @@ int set_derived_args(all_args_t* args_, rrc_cfg_t* rrc_cfg_, phy_cfg_t* phy_cfg_
   }
 
   rrc_cfg_->inactivity_timeout_ms   = args_->general.rrc_inactivity_timer;
+  rrc_cfg_->parallel_ul_dcch        = args_->general.rrc_parallel_decoding;
   uint32_t t310                     = rrc_cfg_->sibs[1].sib2().ue_timers_and_consts.t310.to_number();
   uint32_t t311                     = rrc_cfg_->sibs[1].sib2().ue_timers_and_consts.t311.to_number();
   uint32_t n310                     = rrc_cfg_->sibs[1].sib2().ue_timers_and_consts.n310.to_number();
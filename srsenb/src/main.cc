@@ -146,6 +146,8 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("pcap.nr_filename",  bpo::value<string>(&args->nr_stack.mac.pcap.filename)->default_value("enb_mac_nr.pcap"), "NR MAC layer capture filename")
     ("pcap.s1ap_enable",   bpo::value<bool>(&args->stack.s1ap_pcap.enable)->default_value(false),         "Enable S1AP packet captures for wireshark")
     ("pcap.s1ap_filename", bpo::value<string>(&args->stack.s1ap_pcap.filename)->default_value("enb_s1ap.pcap"), "S1AP layer capture filename")
+    ("pcap.rotate_size_mb", bpo::value<uint32_t>(&args->stack.pcap_rotation.max_size_mb)->default_value(0),   "Start a new MAC and S1AP capture file after this size in MB (0 to disable)")
+    ("pcap.rotate_secs",    bpo::value<uint32_t>(&args->stack.pcap_rotation.max_duration_s)->default_value(0), "Start a new MAC and S1AP capture file after this time in seconds (0 to disable)")
     ("pcap.mac_net_enable", bpo::value<bool>(&args->stack.mac_pcap_net.enable)->default_value(false),         "Enable MAC network captures")
     ("pcap.bind_ip", bpo::value<string>(&args->stack.mac_pcap_net.bind_ip)->default_value("0.0.0.0"),         "Bind IP address for MAC network trace")
     ("pcap.bind_port", bpo::value<uint16_t>(&args->stack.mac_pcap_net.bind_port)->default_value(5687),        "Bind port for MAC network trace")
@@ -221,6 +223,7 @@ void parse_args(all_args_t* args, int argc, char* argv[])
 
       /* Expert section */
     ("expert.metrics_period_secs", bpo::value<float>(&args->general.metrics_period_secs)->default_value(1.0), "Periodicity for metrics in seconds.")
+    ("expert.metrics_max_ues",     bpo::value<uint32_t>(&args->stack.metrics_max_ues)->default_value(0), "Maximum number of UEs, the most active of the period, collected and reported in each metrics period (0 for all UEs).")
     ("expert.metrics_csv_enable",  bpo::value<bool>(&args->general.metrics_csv_enable)->default_value(false), "Write metrics to CSV file.")
     ("expert.metrics_csv_filename", bpo::value<string>(&args->general.metrics_csv_filename)->default_value("/tmp/enb_metrics.csv"), "Metrics CSV filename.")
     ("expert.pusch_max_its", bpo::value<uint32_t>(&args->phy.pusch_max_its)->default_value(8), "Maximum number of turbo decoder iterations for LTE.")
@@ -228,7 +231,9 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("expert.pusch_meas_evm", bpo::value<bool>(&args->phy.pusch_meas_evm)->default_value(false), "Enable/Disable PUSCH EVM measure.")
     ("expert.tx_amplitude", bpo::value<float>(&args->phy.tx_amplitude)->default_value(0.6), "Transmit amplitude factor.")
     ("expert.nof_phy_threads", bpo::value<uint32_t>(&args->phy.nof_phy_threads)->default_value(3), "Number of PHY threads.")
+    ("expert.nof_phy_task_threads", bpo::value<uint32_t>(&args->phy.nof_phy_task_threads)->default_value(0), "Number of threads running the carriers of each TTI as deadline-aware tasks (0 disables the task pool).")
     ("expert.nof_prach_threads", bpo::value<uint32_t>(&args->phy.nof_prach_threads)->default_value(1), "Number of PRACH workers per carrier. Only 1 or 0 is supported.")
+    ("expert.phy_table_cache_dir", bpo::value<string>(&args->phy.table_cache_dir)->default_value(""), "Directory where the PHY tables derived from the cell configuration are cached between restarts (empty disables the cache).")
     ("expert.max_prach_offset_us", bpo::value<float>(&args->phy.max_prach_offset_us)->default_value(30), "Maximum allowed RACH offset (in us).")
     ("expert.equalizer_mode", bpo::value<string>(&args->phy.equalizer_mode)->default_value("mmse"), "Equalizer mode.")
     ("expert.estimator_fil_w", bpo::value<float>(&args->phy.estimator_fil_w)->default_value(0.1), "Chooses the coefficients for the 3-tap channel estimator centered filter.")
@@ -243,14 +248,17 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("expert.tracing_buffcapacity", bpo::value<std::size_t>(&args->general.tracing_buffcapacity)->default_value(1000000), "Tracing buffer capcity.")
     ("expert.stdout_ts_enable", bpo::value<bool>(&stdout_ts_enable)->default_value(false), "Prints once per second the timestamp into stdout.")
     ("expert.rrc_inactivity_timer", bpo::value<uint32_t>(&args->general.rrc_inactivity_timer)->default_value(30000), "Inactivity timer in ms.")
+    ("expert.rrc_parallel_decoding", bpo::value<bool>(&args->general.rrc_parallel_decoding)->default_value(false), "Decode the UL-DCCH messages of different UEs in parallel in the background workers.")
     ("expert.print_buffer_state", bpo::value<bool>(&args->general.print_buffer_state)->default_value(false), "Prints on the console the buffer state every 10 seconds.")
     ("expert.eea_pref_list", bpo::value<string>(&args->general.eea_pref_list)->default_value("EEA0, EEA2, EEA1"), "Ordered preference list for the selection of encryption algorithm (EEA) (default: EEA0, EEA2, EEA1).")
     ("expert.eia_pref_list", bpo::value<string>(&args->general.eia_pref_list)->default_value("EIA2, EIA1, EIA0"), "Ordered preference list for the selection of integrity algorithm (EIA) (default: EIA2, EIA1, EIA0).")
     ("expert.nof_prealloc_ues", bpo::value<uint32_t>(&args->stack.mac.nof_prealloc_ues)->default_value(8), "Number of UE resources to preallocate during eNB initialization.")
+    ("expert.compact_ue_ctx", bpo::value<bool>(&args->stack.mac.compact_ue_ctx)->default_value(false), "Allocate per-UE buffers on demand and release them while the bearers are idle, to fit more UEs in memory.")
     ("expert.lcid_padding", bpo::value<int>(&args->stack.mac.lcid_padding)->default_value(3), "LCID on which to put MAC padding")
     ("expert.max_mac_dl_kos", bpo::value<uint32_t>(&args->general.max_mac_dl_kos)->default_value(100), "Maximum number of consecutive KOs in DL before triggering the UE's release (default 100).")
     ("expert.max_mac_ul_kos", bpo::value<uint32_t>(&args->general.max_mac_ul_kos)->default_value(100), "Maximum number of consecutive KOs in UL before triggering the UE's release (default 100).")
     ("expert.gtpu_tunnel_timeout", bpo::value<uint32_t>(&args->stack.gtpu_indirect_tunnel_timeout_msec)->default_value(0), "Maximum time that GTPU takes to release indirect forwarding tunnel since the last received GTPU PDU (0 for infinity).")
+    ("expert.bulk_task_budget_us", bpo::value<uint32_t>(&args->stack.bulk_task_budget_us)->default_value(0), "Maximum time per TTI the stack spends in user plane and metrics tasks, in us (0 for unlimited).")
     ("expert.rlf_release_timer_ms", bpo::value<uint32_t>(&args->general.rlf_release_timer_ms)->default_value(4000), "Time taken by eNB to release UE context after it detects an RLF.")
     ("expert.extended_cp", bpo::value<bool>(&args->phy.extended_cp)->default_value(false), "Use extended cyclic prefix")
     ("expert.ts1_reloc_prep_timeout", bpo::value<uint32_t>(&args->stack.s1ap.ts1_reloc_prep_timeout)->default_value(10000), "S1AP TS 36.413 TS1RelocPrep Expiry Timeout value in milliseconds.")
@@ -504,6 +512,24 @@ static void execute_cmd(metrics_stdout* metrics, srsenb::enb_command_interface*
 
     // Set cell gain
     control->cmd_cell_gain(cell_id, gain_db);
+  } else if (cmd[0] == "mem") {
+    srsenb::stack_mem_footprint_t footprint = {};
+    if (not control->cmd_mem_footprint(&footprint)) {
+      cout << "Memory footprint not available" << endl;
+      return;
+    }
+    uint32_t nof_ues = std::max(footprint.nof_ues, 1U);
+    cout << "UE context memory (" << footprint.nof_ues << " UEs):" << endl;
+    auto print_layer = [nof_ues](const char* name, size_t bytes) {
+      printf("  %5s: %10zu kB, %8zu B/UE\n", name, bytes / 1024, bytes / nof_ues);
+    };
+    print_layer("MAC", footprint.mac);
+    print_layer("SCHED", footprint.sched);
+    print_layer("RLC", footprint.rlc);
+    print_layer("PDCP", footprint.pdcp);
+    print_layer("RRC", footprint.rrc);
+    print_layer("S1AP", footprint.s1ap);
+    print_layer("Total", footprint.total());
   } else if (cmd[0] == "flush") {
     if (cmd.size() != 1) {
       cout << "Usage: " << cmd[0] << endl;
@@ -519,6 +545,7 @@ static void execute_cmd(metrics_stdout* metrics, srsenb::enb_command_interface*
     cout << "      sleep: pauses the commmand line operation for a given time in seconds" << endl;
     cout << "          p: starts MAC padding" << endl;
     cout << "      flush: flushes the buffers for the log file" << endl;
+    cout << "        mem: prints the memory held by the UE contexts of each layer" << endl;
     cout << endl;
   }
 }
@@ -640,6 +667,7 @@ int main(int argc, char* argv[])
   metricshub.init(enb.get(), args.general.metrics_period_secs);
   metricshub.add_listener(&metrics_screen);
   metrics_screen.set_handle(enb.get());
+  metrics_screen.set_max_ues(args.stack.metrics_max_ues);
 
   srsenb::metrics_csv metrics_file(args.general.metrics_csv_filename);
   if (args.general.metrics_csv_enable) {
@@ -648,6 +676,7 @@ int main(int argc, char* argv[])
   }
 
   srsenb::metrics_json json_metrics(json_channel, enb.get());
+  json_metrics.set_max_ues(args.stack.metrics_max_ues);
   if (args.general.report_json_enable) {
     metricshub.add_listener(&json_metrics);
   }
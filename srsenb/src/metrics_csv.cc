@@ -72,6 +72,12 @@ void metrics_csv::set_metrics(const enb_metrics_t& metrics, const uint32_t perio
         file << ";cpu_" << std::to_string(i);
       }
 
+      // Add the PHY stage processing times
+      for (uint32_t i = 0; i < (uint32_t)phy_stage_t::nof_stages; ++i) {
+        std::string name = phy_stage_to_string((phy_stage_t)i);
+        file << ";" << name << "_avg_us;" << name << "_p99_us;" << name << "_max_us";
+      }
+
       // Add the new line.
       file << "\n";
     }
@@ -110,11 +116,22 @@ void metrics_csv::set_metrics(const enb_metrics_t& metrics, const uint32_t perio
     file << std::to_string(m.process_virtualmem_kB) << ";";
     file << float_to_string(m.system_mem, 2);
     file << float_to_string(m.process_cpu_usage, 2);
-    file << std::to_string(m.thread_count) << ";";
+    file << std::to_string(m.thread_count);
 
-    // Write the cpu metrics.
-    for (uint32_t i = 0, e = m.cpu_count, last_cpu_index = e - 1; i != e; ++i) {
-      file << float_to_string(m.cpu_load[i], 2, (i != last_cpu_index));
+    // Write the cpu metrics, each column preceded by its separator as in the header.
+    for (uint32_t i = 0, e = m.cpu_count; i != e; ++i) {
+      file << ";" << float_to_string(m.cpu_load[i], 2, false);
+    }
+
+    // Write the time spent per TTI in each PHY stage, zero for the stages without samples
+    for (uint32_t i = 0, e = (uint32_t)phy_stage_t::nof_stages; i != e; ++i) {
+      phy_stage_metrics_t s = {};
+      if (i < metrics.phy_stages.size()) {
+        s = metrics.phy_stages[i];
+      }
+      file << ";" << float_to_string(s.avg_us, 4);
+      file << float_to_string(s.p99_us, 4);
+      file << float_to_string(s.max_us, 4, false);
     }
 
     file << "\n";
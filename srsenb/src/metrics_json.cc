@@ -81,13 +81,34 @@ DECLARE_METRIC("nof_rach", metric_nof_rach, uint32_t, "");
 DECLARE_METRIC_LIST("ue_list", mlist_ues, std::vector<mset_ue_container>);
 DECLARE_METRIC_SET("cell_container", mset_cell_container, metric_carrier_id, metric_pci, metric_nof_rach, mlist_ues);
 
+/// PHY stage container metrics.
+DECLARE_METRIC("lower_us", metric_bucket_lower_us, uint32_t, "");
+DECLARE_METRIC("count", metric_bucket_count, uint32_t, "");
+DECLARE_METRIC_SET("bucket_container", mset_bucket_container, metric_bucket_lower_us, metric_bucket_count);
+DECLARE_METRIC("stage", metric_stage, std::string, "");
+DECLARE_METRIC("nof_samples", metric_stage_nof_samples, uint32_t, "");
+DECLARE_METRIC("avg_us", metric_stage_avg_us, float, "");
+DECLARE_METRIC("p99_us", metric_stage_p99_us, float, "");
+DECLARE_METRIC("max_us", metric_stage_max_us, float, "");
+DECLARE_METRIC_LIST("histogram", mlist_buckets, std::vector<mset_bucket_container>);
+DECLARE_METRIC_SET("phy_stage_container",
+                   mset_phy_stage_container,
+                   metric_stage,
+                   metric_stage_nof_samples,
+                   metric_stage_avg_us,
+                   metric_stage_p99_us,
+                   metric_stage_max_us,
+                   mlist_buckets);
+
 /// Metrics root object.
 DECLARE_METRIC("type", metric_type_tag, std::string, "");
 DECLARE_METRIC("timestamp", metric_timestamp_tag, double, "");
 DECLARE_METRIC_LIST("cell_list", mlist_cell, std::vector<mset_cell_container>);
+DECLARE_METRIC_LIST("phy_stage_list", mlist_phy_stages, std::vector<mset_phy_stage_container>);
 
 /// Metrics context.
-using metric_context_t = srslog::build_context_type<metric_type_tag, metric_timestamp_tag, mlist_cell>;
+using metric_context_t =
+    srslog::build_context_type<metric_type_tag, metric_timestamp_tag, mlist_cell, mlist_phy_stages>;
 
 } // namespace
 
@@ -144,6 +165,34 @@ static void fill_ue_metrics(mset_ue_container& ue, const enb_metrics_t& m, unsig
   }
 }
 
+/// Fill the processing time metrics of the PHY stages that ran during the period, empty buckets are skipped.
+static void fill_phy_stage_metrics(std::vector<mset_phy_stage_container>& stage_list, const enb_metrics_t& m)
+{
+  for (uint32_t i = 0; i < m.phy_stages.size(); ++i) {
+    const phy_stage_metrics_t& s = m.phy_stages[i];
+    if (s.count == 0) {
+      continue;
+    }
+    stage_list.emplace_back();
+    auto& stage = stage_list.back();
+    stage.write<metric_stage>(phy_stage_to_string((phy_stage_t)i));
+    stage.write<metric_stage_nof_samples>(s.count);
+    stage.write<metric_stage_avg_us>(s.avg_us);
+    stage.write<metric_stage_p99_us>(s.p99_us);
+    stage.write<metric_stage_max_us>(s.max_us);
+
+    auto& bucket_list = stage.get<mlist_buckets>();
+    for (uint32_t b = 0; b < s.histogram.size(); ++b) {
+      if (s.histogram[b] == 0) {
+        continue;
+      }
+      bucket_list.emplace_back();
+      bucket_list.back().write<metric_bucket_lower_us>((uint32_t)srsran::stage_profiler::bucket_lower_us(b));
+      bucket_list.back().write<metric_bucket_count>(s.histogram[b]);
+    }
+  }
+}
+
 /// Returns the current time in seconds with ms precision since UNIX epoch.
 static double get_time_stamp()
 {
@@ -186,6 +235,9 @@ void metrics_json::set_metrics(const enb_metrics_t& m, const uint32_t period_use
   auto& cell_list = ctx.get<mlist_cell>();
   cell_list.resize(m.stack.mac.cc_info.size());
 
+  // Only the selected UEs are formatted.
+  std::vector<uint32_t> ue_idxs = mac_select_reported_ues(m.stack.mac, m.stack.rrc.ues.size(), max_ues);
+
   // For each cell...
   for (unsigned cc_idx = 0, e = cell_list.size(); cc_idx != e; ++cc_idx) {
     auto& cell = cell_list[cc_idx];
@@ -194,7 +246,7 @@ void metrics_json::set_metrics(const enb_metrics_t& m, const uint32_t period_use
     cell.write<metric_pci>(m.stack.mac.cc_info[cc_idx].pci);
 
     // For each UE in this cell...
-    for (unsigned i = 0; i != m.stack.rrc.ues.size(); ++i) {
+    for (uint32_t i : ue_idxs) {
       if (!has_valid_metric_ranges(m, i)) {
         continue;
       }
@@ -208,6 +260,8 @@ void metrics_json::set_metrics(const enb_metrics_t& m, const uint32_t period_use
     }
   }
 
+  fill_phy_stage_metrics(ctx.get<mlist_phy_stages>(), m);
+
   // Log the context.
   ctx.write<metric_timestamp_tag>(get_time_stamp());
   log_c(ctx);
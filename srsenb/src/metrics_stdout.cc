@@ -80,12 +80,17 @@ static bool iszero(float x)
   return fabsf(x) < 2 * DBL_EPSILON;
 }
 
-void metrics_stdout::set_metrics_helper(uint32_t                          num_ue,
+void metrics_stdout::set_max_ues(uint32_t max_ues_)
+{
+  max_ues = max_ues_;
+}
+
+void metrics_stdout::set_metrics_helper(const std::vector<uint32_t>&      ue_idxs,
                                         const mac_metrics_t&              mac,
                                         const std::vector<phy_metrics_t>& phy,
                                         bool                              is_nr)
 {
-  for (size_t i = 0; i < num_ue; i++) {
+  for (uint32_t i : ue_idxs) {
     // make sure we have stats for MAC and PHY layer too
     if (i >= mac.ues.size() || ((i >= phy.size()) && !is_nr)) {
       break;
@@ -198,8 +203,14 @@ void metrics_stdout::set_metrics(const enb_metrics_t& metrics, const uint32_t pe
     fmt::print("rat rnti  cqi  ri  mcs  brate   ok  nok  (%) | pusch  pucch  phr  mcs  brate   ok  nok  (%)    bsr\n");
   }
 
-  set_metrics_helper(metrics.stack.rrc.ues.size(), metrics.stack.mac, metrics.phy, false);
-  set_metrics_helper(metrics.nr_stack.mac.ues.size(), metrics.nr_stack.mac, metrics.phy, true);
+  set_metrics_helper(mac_select_reported_ues(metrics.stack.mac, metrics.stack.rrc.ues.size(), max_ues),
+                     metrics.stack.mac,
+                     metrics.phy,
+                     false);
+  set_metrics_helper(mac_select_reported_ues(metrics.nr_stack.mac, metrics.nr_stack.mac.ues.size(), max_ues),
+                     metrics.nr_stack.mac,
+                     metrics.phy,
+                     true);
 }
 
 std::string metrics_stdout::float_to_string(float f, int digits, int field_width)
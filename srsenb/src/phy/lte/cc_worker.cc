@@ -115,15 +115,21 @@ void cc_worker::init(phy_common* phy_, uint32_t cc_idx_)
     ERROR("Error initiating ENB DL (cc=%d)", cc_idx);
     return;
   }
-  if (srsran_enb_ul_init(&enb_ul, signal_buffer_rx[0], nof_prb)) {
+  if (srsran_enb_ul_init(&enb_ul, signal_buffer_rx, nof_prb, phy->get_nof_ports(cc_idx))) {
     ERROR("Error initiating ENB UL");
     return;
   }
 
-  if (srsran_enb_ul_set_cell(&enb_ul, cell, &phy->dmrs_pusch_cfg, nullptr)) {
+  // The PUSCH DMRS are generated once for all the workers, load them instead of generating them
+  const uint8_t* dmrs_table = phy->get_dmrs_pusch_table(cc_idx);
+  if (srsran_enb_ul_set_cell(&enb_ul, cell, dmrs_table ? nullptr : &phy->dmrs_pusch_cfg, nullptr)) {
     ERROR("Error initiating ENB UL");
     return;
   }
+  if (dmrs_table != nullptr and srsran_chest_ul_pregen_load(&enb_ul.chest, dmrs_table)) {
+    ERROR("Error loading PUSCH DMRS (cc=%d)", cc_idx);
+    return;
+  }
 
   /* Setup SI-RNTI in PHY */
   add_rnti(SRSRAN_SIRNTI);
@@ -187,6 +193,10 @@ int cc_worker::add_rnti(uint16_t rnti)
   if (ue_db.count(rnti) == 0) {
     ue_db[rnti] = new ue(rnti);
   }
+
+  // The scrambling sequences are cached for the users of the cell only
+  srsran_pdsch_set_nof_users(&enb_dl.pdsch, ue_db.size());
+  srsran_pusch_set_nof_users(&enb_ul.pusch, ue_db.size());
   return SRSRAN_SUCCESS;
 }
 
@@ -197,6 +207,12 @@ void cc_worker::rem_rnti(uint16_t rnti)
     delete ue_db[rnti];
     ue_db.erase(rnti);
   }
+
+  // Return the scrambling sequences cached for the user
+  srsran_pdsch_release_rnti(&enb_dl.pdsch, rnti);
+  srsran_pusch_release_rnti(&enb_ul.pusch, rnti);
+  srsran_pdsch_set_nof_users(&enb_dl.pdsch, ue_db.size());
+  srsran_pusch_set_nof_users(&enb_ul.pusch, ue_db.size());
 }
 
 uint32_t cc_worker::get_nof_rnti()
@@ -212,13 +228,18 @@ void cc_worker::work_ul(const srsran_ul_sf_cfg_t& ul_sf_cfg, stack_interface_phy
   logger.set_context(ul_sf.tti);
 
   // Process UL signal
-  srsran_enb_ul_fft(&enb_ul);
+  {
+    srsran::stage_profiler::scoped_timer t(ul_stages, (uint32_t)phy_stage_t::fft);
+    srsran_enb_ul_fft(&enb_ul);
+  }
 
   // Decode pending UL grants for the tti they were scheduled
   decode_pusch(ul_grants.pusch, ul_grants.nof_grants);
 
   // Decode remaining PUCCH ACKs not associated with PUSCH transmission and SR signals
   decode_pucch();
+
+  phy->stage_prof.commit(ul_stages);
 }
 
 void cc_worker::work_dl(const srsran_dl_sf_cfg_t&            dl_sf_cfg,
@@ -234,16 +255,24 @@ void cc_worker::work_dl(const srsran_dl_sf_cfg_t&            dl_sf_cfg,
 
   // Put DL grants to resource grid. PDSCH data will be encoded as well.
   if (dl_sf_cfg.sf_type == SRSRAN_SF_NORM) {
-    encode_pdcch_dl(dl_grants.pdsch, dl_grants.nof_grants);
+    {
+      srsran::stage_profiler::scoped_timer t(dl_stages, (uint32_t)phy_stage_t::pdcch);
+      encode_pdcch_dl(dl_grants.pdsch, dl_grants.nof_grants);
+    }
+    srsran::stage_profiler::scoped_timer t(dl_stages, (uint32_t)phy_stage_t::pdsch);
     encode_pdsch(dl_grants.pdsch, dl_grants.nof_grants);
   } else {
     if (mbsfn_cfg->enable) {
+      srsran::stage_profiler::scoped_timer t(dl_stages, (uint32_t)phy_stage_t::pdsch);
       encode_pmch(dl_grants.pdsch, mbsfn_cfg);
     }
   }
 
   // Put UL grants to resource grid.
-  encode_pdcch_ul(ul_grants.pusch, ul_grants.nof_grants);
+  {
+    srsran::stage_profiler::scoped_timer t(dl_stages, (uint32_t)phy_stage_t::pdcch);
+    encode_pdcch_ul(ul_grants.pusch, ul_grants.nof_grants);
+  }
 
   // Put pending PHICH HARQ ACK/NACK indications into subframe
   encode_phich(ul_grants.phich, ul_grants.nof_phich);
@@ -260,6 +289,8 @@ void cc_worker::work_dl(const srsran_dl_sf_cfg_t&            dl_sf_cfg,
       srsran_vec_sc_prod_cfc(signal_buffer_tx[i], scale, signal_buffer_tx[i], sf_len);
     }
   }
+
+  phy->stage_prof.commit(dl_stages);
 }
 
 bool cc_worker::decode_pusch_rnti(stack_interface_phy_lte::ul_sched_grant_t& ul_grant,
@@ -321,7 +352,15 @@ bool cc_worker::decode_pusch_rnti(stack_interface_phy_lte::ul_sched_grant_t& ul_
   ul_cfg.pusch.softbuffers.rx = ul_grant.softbuffer_rx;
   pusch_res.data              = ul_grant.data;
   if (pusch_res.data) {
-    if (srsran_enb_ul_get_pusch(&enb_ul, &ul_sf, &ul_cfg.pusch, &pusch_res)) {
+    {
+      srsran::stage_profiler::scoped_timer t(ul_stages, (uint32_t)phy_stage_t::chest);
+      if (srsran_enb_ul_estimate_pusch(&enb_ul, &ul_sf, &ul_cfg.pusch)) {
+        Error("Estimating PUSCH for RNTI %x", rnti);
+        return false;
+      }
+    }
+    srsran::stage_profiler::scoped_timer t(ul_stages, (uint32_t)phy_stage_t::pusch);
+    if (srsran_enb_ul_decode_pusch(&enb_ul, &ul_sf, &ul_cfg.pusch, &pusch_res)) {
       Error("Decoding PUSCH for RNTI %x", rnti);
       return false;
     }
@@ -391,8 +430,8 @@ void cc_worker::decode_pusch(stack_interface_phy_lte::ul_sched_grant_t* grants,
 
 int cc_worker::decode_pucch()
 {
-  srsran_pucch_res_t pucch_res = {};
-
+  // Gather the users expecting PUCCH in this TTI
+  pucch_rx.clear();
   for (auto& iter : ue_db) {
     uint16_t rnti = iter.first;
 
@@ -414,34 +453,58 @@ int cc_worker::decode_pucch()
 
       // If ret is more than success, UCI is present
       if (ret > SRSRAN_SUCCESS) {
-        // Decode PUCCH
-        if (srsran_enb_ul_get_pucch(&enb_ul, &ul_sf, &ul_cfg.pucch, &pucch_res)) {
-          Error("Error getting PUCCH");
-          continue;
-        }
+        srsran_enb_ul_pucch_t pucch = {};
+        pucch.cfg                   = ul_cfg.pucch;
+        pucch.cfg.rnti              = rnti;
+        pucch_rx.push_back(pucch);
+      }
+    }
+  }
 
-        // Send UCI data to MAC
-        if (phy->ue_db.send_uci_data(tti_rx, rnti, cc_idx, ul_cfg.pucch.uci_cfg, pucch_res.uci_data) < SRSRAN_SUCCESS) {
-          Error("Error sending UCI data for RNTI %x, CC %d", rnti, cc_idx);
-          continue;
-        }
+  // Decode PUCCH of all the users together
+  int ret_pucch = SRSRAN_SUCCESS;
+  {
+    srsran::stage_profiler::scoped_timer t(ul_stages, (uint32_t)phy_stage_t::pucch);
+    ret_pucch = srsran_enb_ul_get_pucch_multi(&enb_ul, &ul_sf, pucch_rx.data(), (uint32_t)pucch_rx.size());
+  }
+  if (ret_pucch < SRSRAN_SUCCESS) {
+    for (srsran_enb_ul_pucch_t& pucch : pucch_rx) {
+      pucch.ret = ret_pucch;
+    }
+  }
 
-        if (pucch_res.detected and pucch_res.ta_valid) {
-          phy->stack->ta_info(tti_rx, rnti, pucch_res.ta_us);
-          phy->stack->snr_info(tti_rx, rnti, cc_idx, pucch_res.snr_db, mac_interface_phy_lte::PUCCH);
-        }
+  for (srsran_enb_ul_pucch_t& pucch : pucch_rx) {
+    uint16_t            rnti      = pucch.cfg.rnti;
+    srsran_pucch_res_t& pucch_res = pucch.res;
 
-        // Logging
-        if (logger.info.enabled()) {
-          char str[512];
-          srsran_pucch_rx_info(&ul_cfg.pucch, &pucch_res, str, sizeof(str));
-          logger.info("PUCCH: cc=%d; %s", cc_idx, str);
-        }
+    if (pucch.ret < SRSRAN_SUCCESS) {
+      Error("Error getting PUCCH for RNTI %x, CC %d", rnti, cc_idx);
+      continue;
+    }
+
+    // Send UCI data to MAC
+    if (phy->ue_db.send_uci_data(tti_rx, rnti, cc_idx, pucch.cfg.uci_cfg, pucch_res.uci_data) < SRSRAN_SUCCESS) {
+      Error("Error sending UCI data for RNTI %x, CC %d", rnti, cc_idx);
+      continue;
+    }
 
-        // Save metrics
-        ue_db[rnti]->metrics_ul_pucch(pucch_res.snr_db);
+    // The time alignment is reported when the receiver could estimate it
+    if (pucch_res.detected) {
+      if (pucch_res.ta_valid) {
+        phy->stack->ta_info(tti_rx, rnti, pucch_res.ta_us);
       }
+      phy->stack->snr_info(tti_rx, rnti, cc_idx, pucch_res.snr_db, mac_interface_phy_lte::PUCCH);
     }
+
+    // Logging
+    if (logger.info.enabled()) {
+      char str[512];
+      srsran_pucch_rx_info(&pucch.cfg, &pucch_res, str, sizeof(str));
+      logger.info("PUCCH: cc=%d; %s", cc_idx, str);
+    }
+
+    // Save metrics
+    ue_db[rnti]->metrics_ul_pucch(pucch_res.snr_db);
   }
   return 0;
 }
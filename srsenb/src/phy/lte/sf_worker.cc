@@ -72,9 +72,27 @@ namespace lte {
 FILE* f;
 #endif
 
-void sf_worker::init(phy_common* phy_)
+// Deadlines of the tasks of a TTI, relative to the time the worker starts processing it. The UL is decoded before the
+// MAC schedules the TX TTI and the DL signal must be ready before the radio transmits it
+static const std::chrono::microseconds ul_task_deadline(1500);
+static const std::chrono::microseconds dl_task_deadline(3000);
+
+const char* sf_worker::task_type_to_string(uint32_t type)
+{
+  switch (type) {
+    case TASK_UL:
+      return "UL";
+    case TASK_DL:
+      return "DL";
+    default:
+      return "unknown";
+  }
+}
+
+void sf_worker::init(phy_common* phy_, srsran::edf_task_pool* task_pool_)
 {
-  phy = phy_;
+  phy       = phy_;
+  task_pool = task_pool_;
 
   // Initialise each component carrier workers
   for (uint32_t i = 0; i < phy->get_nof_carriers_lte(); i++) {
@@ -147,9 +165,55 @@ uint32_t sf_worker::get_nof_rnti()
   return cc_workers[0]->get_nof_rnti();
 }
 
+void sf_worker::work_ul(const srsran_ul_sf_cfg_t& ul_sf, stack_interface_phy_lte::ul_sched_list_t& ul_grants)
+{
+  if (task_pool == nullptr) {
+    for (uint32_t cc = 0; cc < cc_workers.size(); cc++) {
+      cc_workers[cc]->work_ul(ul_sf, ul_grants[cc]);
+    }
+    return;
+  }
+
+  // Carriers are independent, each of them is a task. This thread runs pending tasks while it waits
+  srsran::edf_task_pool::task_group group;
+  for (uint32_t cc = 0; cc < cc_workers.size(); cc++) {
+    task_pool->push_task(group, TASK_UL, tti_start + ul_task_deadline, [this, cc, &ul_sf, &ul_grants]() {
+      cc_workers[cc]->work_ul(ul_sf, ul_grants[cc]);
+    });
+  }
+  task_pool->wait(group);
+}
+
+void sf_worker::work_dl(const srsran_dl_sf_cfg_t&                 dl_sf,
+                        stack_interface_phy_lte::dl_sched_list_t& dl_grants,
+                        stack_interface_phy_lte::ul_sched_list_t& ul_grants)
+{
+  srsran::edf_task_pool::task_group group;
+  for (uint32_t cc = 0; cc < cc_workers.size(); cc++) {
+    // Select CFI and make sure it is in the right range
+    dl_sf_cc[cc]     = dl_sf;
+    dl_sf_cc[cc].cfi = dl_grants[cc].cfi;
+    dl_sf_cc[cc].cfi = SRSRAN_MAX(dl_sf_cc[cc].cfi, 1);
+    dl_sf_cc[cc].cfi = SRSRAN_MIN(dl_sf_cc[cc].cfi, 3);
+
+    if (task_pool == nullptr) {
+      cc_workers[cc]->work_dl(dl_sf_cc[cc], dl_grants[cc], ul_grants[cc], &mbsfn_cfg);
+    } else {
+      task_pool->push_task(group, TASK_DL, tti_start + dl_task_deadline, [this, cc, &dl_grants, &ul_grants]() {
+        cc_workers[cc]->work_dl(dl_sf_cc[cc], dl_grants[cc], ul_grants[cc], &mbsfn_cfg);
+      });
+    }
+  }
+
+  if (task_pool != nullptr) {
+    task_pool->wait(group);
+  }
+}
+
 void sf_worker::work_imp()
 {
   std::lock_guard<std::mutex> lock(work_mutex);
+  tti_start = std::chrono::steady_clock::now();
 
   srsran_ul_sf_cfg_t ul_sf = {};
   srsran_dl_sf_cfg_t dl_sf = {};
@@ -163,8 +227,7 @@ void sf_worker::work_imp()
     return;
   }
 
-  srsran_mbsfn_cfg_t mbsfn_cfg;
-  srsran_sf_t        sf_type = phy->is_mbsfn_sf(&mbsfn_cfg, tti_tx_dl) ? SRSRAN_SF_MBSFN : SRSRAN_SF_NORM;
+  srsran_sf_t sf_type = phy->is_mbsfn_sf(&mbsfn_cfg, tti_tx_dl) ? SRSRAN_SF_MBSFN : SRSRAN_SF_NORM;
 
   // Uplink grants to receive this TTI
   stack_interface_phy_lte::ul_sched_list_t ul_grants = phy->get_ul_grants(tti_rx);
@@ -189,9 +252,7 @@ void sf_worker::work_imp()
   }
 
   // Process UL
-  for (uint32_t cc = 0; cc < cc_workers.size(); cc++) {
-    cc_workers[cc]->work_ul(ul_sf, ul_grants[cc]);
-  }
+  work_ul(ul_sf, ul_grants);
 
   // Get DL scheduling for the TX TTI from MAC
   if (sf_type == SRSRAN_SF_NORM) {
@@ -225,14 +286,7 @@ void sf_worker::work_imp()
   phy->ue_db.clear_tti_pending_ack(tti_tx_ul);
 
   // Process DL
-  for (uint32_t cc = 0; cc < cc_workers.size(); cc++) {
-    // Select CFI and make sure it is in the right range
-    dl_sf.cfi = dl_grants[cc].cfi;
-    dl_sf.cfi = SRSRAN_MAX(dl_sf.cfi, 1);
-    dl_sf.cfi = SRSRAN_MIN(dl_sf.cfi, 3);
-
-    cc_workers[cc]->work_dl(dl_sf, dl_grants[cc], ul_grants_tx[cc], &mbsfn_cfg);
-  }
+  work_dl(dl_sf, dl_grants, ul_grants_tx);
 
   // Save grants
   phy->set_ul_grants(tti_tx_ul, ul_grants_tx);
@@ -19,6 +19,7 @@
  *
  */
 #include "srsenb/hdr/phy/lte/worker_pool.h"
+#include <thread>
 
 namespace srsenb {
 namespace lte {
@@ -27,17 +28,30 @@ worker_pool::worker_pool(uint32_t max_workers) : pool(max_workers) {}
 
 bool worker_pool::init(const phy_args_t& args, phy_common* common, srslog::sink& log_sink, int prio)
 {
-  // Add workers to workers pool and start threads.
-  srslog::basic_levels log_level = srslog::str_to_basic_level(args.log.phy_level);
+  // The carriers of each TTI run as tasks shared by all the workers, the task threads add to the worker threads
+  if (args.nof_phy_task_threads > 0) {
+    task_pool.reset(new srsran::edf_task_pool(sf_worker::NOF_TASK_TYPES, args.nof_phy_task_threads, prio));
+  }
+
+  // Initialise the workers in parallel, the workers of each carrier build the same objects independently
+  srslog::basic_levels     log_level = srslog::str_to_basic_level(args.log.phy_level);
+  std::vector<std::thread> init_threads;
   for (uint32_t i = 0; i < args.nof_phy_threads; i++) {
     auto& log = srslog::fetch_basic_logger(fmt::format("PHY{}", i), log_sink);
     log.set_level(log_level);
     log.set_hex_dump_max_size(args.log.phy_hex_limit);
 
-    auto w = std::unique_ptr<lte::sf_worker>(new sf_worker(log));
-    w->init(common);
-    pool.init_worker(i, w.get(), prio);
-    workers.push_back(std::move(w));
+    workers.push_back(std::unique_ptr<lte::sf_worker>(new sf_worker(log)));
+    sf_worker* w = workers.back().get();
+    init_threads.emplace_back([w, common, this]() { w->init(common, task_pool.get()); });
+  }
+  for (auto& t : init_threads) {
+    t.join();
+  }
+
+  // Add workers to workers pool and start threads.
+  for (uint32_t i = 0; i < workers.size(); i++) {
+    pool.init_worker(i, workers[i].get(), prio);
   }
 
   return true;
@@ -61,6 +75,17 @@ sf_worker* worker_pool::wait_worker_id(uint32_t id)
 void worker_pool::stop()
 {
   pool.stop();
+  if (task_pool != nullptr) {
+    task_pool->stop();
+  }
+}
+
+std::vector<srsran::edf_task_pool::type_metrics_t> worker_pool::get_task_metrics()
+{
+  if (task_pool == nullptr) {
+    return {};
+  }
+  return task_pool->get_metrics();
 }
 
 }; // namespace lte
@@ -20,6 +20,7 @@
  */
 
 #include "srsenb/hdr/phy/nr/slot_worker.h"
+#include "srsran/adt/scope_exit.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/common.h"
 
@@ -44,6 +45,7 @@ bool slot_worker::init(const args_t& args)
   // Copy common configurations
   cell_index = args.cell_index;
   rf_port    = args.rf_port;
+  stage_prof = args.stage_prof;
 
   // Allocate Tx buffers
   tx_buffer.resize(args.nof_tx_ports);
@@ -163,9 +165,12 @@ bool slot_worker::work_ul()
   }
 
   // Demodulate
-  if (srsran_gnb_ul_fft(&gnb_ul) < SRSRAN_SUCCESS) {
-    logger.error("Error in demodulation");
-    return false;
+  {
+    srsran::stage_profiler::scoped_timer t(stages, (uint32_t)phy_stage_t::fft);
+    if (srsran_gnb_ul_fft(&gnb_ul) < SRSRAN_SUCCESS) {
+      logger.error("Error in demodulation");
+      return false;
+    }
   }
 
   // For each PUCCH...
@@ -178,6 +183,7 @@ bool slot_worker::work_ul()
       pucch_info[i].uci_data.cfg = pucch.candidates[i].uci_cfg;
 
       // Decode PUCCH
+      srsran::stage_profiler::scoped_timer t(stages, (uint32_t)phy_stage_t::pucch);
       if (srsran_gnb_ul_get_pucch(&gnb_ul,
                                   &ul_slot_cfg,
                                   &pucch.pucch_cfg,
@@ -234,11 +240,20 @@ bool slot_worker::work_ul()
     pusch_info.pdu->N_bytes             = pusch.sch.grant.tb[0].tbs / 8;
     pusch_info.pusch_data.tb[0].payload = pusch_info.pdu->data();
 
-    // Decode PUSCH
-    if (srsran_gnb_ul_get_pusch(&gnb_ul, &ul_slot_cfg, &pusch.sch, &pusch.sch.grant, &pusch_info.pusch_data) <
-        SRSRAN_SUCCESS) {
-      logger.error("Error getting PUSCH");
-      return false;
+    // Estimate channel and decode PUSCH
+    {
+      srsran::stage_profiler::scoped_timer t(stages, (uint32_t)phy_stage_t::chest);
+      if (srsran_gnb_ul_estimate_pusch(&gnb_ul, &ul_slot_cfg, &pusch.sch, &pusch.sch.grant) < SRSRAN_SUCCESS) {
+        logger.error("Error getting PUSCH");
+        return false;
+      }
+    }
+    {
+      srsran::stage_profiler::scoped_timer t(stages, (uint32_t)phy_stage_t::pusch);
+      if (srsran_gnb_ul_decode_pusch(&gnb_ul, &pusch.sch, &pusch.sch.grant, &pusch_info.pusch_data) < SRSRAN_SUCCESS) {
+        logger.error("Error getting PUSCH");
+        return false;
+      }
     }
 
     // Extract DMRS information
@@ -300,9 +315,12 @@ bool slot_worker::work_dl()
     }
 
     // Put PDCCH message
-    if (srsran_gnb_dl_pdcch_put_dl(&gnb_dl, &dl_slot_cfg, &pdcch.dci) < SRSRAN_SUCCESS) {
-      logger.error("PDCCH: Error putting DL message");
-      return false;
+    {
+      srsran::stage_profiler::scoped_timer t(stages, (uint32_t)phy_stage_t::pdcch);
+      if (srsran_gnb_dl_pdcch_put_dl(&gnb_dl, &dl_slot_cfg, &pdcch.dci) < SRSRAN_SUCCESS) {
+        logger.error("PDCCH: Error putting DL message");
+        return false;
+      }
     }
 
     // Log PDCCH information
@@ -322,9 +340,12 @@ bool slot_worker::work_dl()
     }
 
     // Put PDCCH message
-    if (srsran_gnb_dl_pdcch_put_ul(&gnb_dl, &dl_slot_cfg, &pdcch.dci) < SRSRAN_SUCCESS) {
-      logger.error("PDCCH: Error putting DL message");
-      return false;
+    {
+      srsran::stage_profiler::scoped_timer t(stages, (uint32_t)phy_stage_t::pdcch);
+      if (srsran_gnb_dl_pdcch_put_ul(&gnb_dl, &dl_slot_cfg, &pdcch.dci) < SRSRAN_SUCCESS) {
+        logger.error("PDCCH: Error putting DL message");
+        return false;
+      }
     }
 
     // Log PDCCH information
@@ -346,9 +367,12 @@ bool slot_worker::work_dl()
     }
 
     // Put PDSCH message
-    if (srsran_gnb_dl_pdsch_put(&gnb_dl, &dl_slot_cfg, &pdsch.sch, data) < SRSRAN_SUCCESS) {
-      logger.error("PDSCH: Error putting DL message");
-      return false;
+    {
+      srsran::stage_profiler::scoped_timer t(stages, (uint32_t)phy_stage_t::pdsch);
+      if (srsran_gnb_dl_pdsch_put(&gnb_dl, &dl_slot_cfg, &pdsch.sch, data) < SRSRAN_SUCCESS) {
+        logger.error("PDSCH: Error putting DL message");
+        return false;
+      }
     }
 
     // Log PDSCH information
@@ -390,6 +414,13 @@ bool slot_worker::work_dl()
 
 void slot_worker::work_imp()
 {
+  // Account the time spent in each stage of this slot whatever the outcome of the processing
+  auto commit_stages = srsran::make_scope_exit([this]() {
+    if (stage_prof != nullptr) {
+      stage_prof->commit(stages);
+    }
+  });
+
   // Inform Scheduler about new slot
   stack.slot_indication(dl_slot_cfg);
 
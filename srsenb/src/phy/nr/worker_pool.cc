@@ -41,6 +41,7 @@ worker_pool::worker_pool(srsran::phy_common_interface& common_,
 bool worker_pool::init(const args_t& args, const phy_cell_cfg_list_nr_t& cell_list)
 {
   nof_prach_workers = args.nof_prach_workers;
+  stage_prof        = args.stage_prof;
 
   // Calculate sampling rate in Hz
   if (not std::isnormal(args.srate_hz)) {
@@ -73,6 +74,7 @@ bool worker_pool::init(const args_t& args, const phy_cell_cfg_list_nr_t& cell_li
     w_args.srate_hz                = srate_hz;
     w_args.pusch_max_its           = args.pusch_max_its;
     w_args.pusch_min_snr_dB        = args.pusch_min_snr_dB;
+    w_args.stage_prof              = args.stage_prof;
 
     if (not w->init(w_args)) {
       return false;
@@ -138,7 +140,8 @@ int worker_pool::set_common_cfg(const phy_interface_rrc_nr::common_cfg_t& common
   prach_cfg.tdd_config.configured = (common_cfg.duplex_mode == SRSRAN_DUPLEX_MODE_TDD);
 
   // Set the PRACH configuration
-  prach.init(0, cell, prach_cfg, &prach_stack_adaptor, logger, 0, nof_prach_workers);
+  prach.init(
+      0, cell, prach_cfg, &prach_stack_adaptor, logger, 0, nof_prach_workers, stage_prof, (uint32_t)phy_stage_t::prach);
   prach.set_max_prach_offset_us(1000);
 
   // Setup SSB sampling rate and scaling
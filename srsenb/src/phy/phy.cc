@@ -177,10 +177,16 @@ int phy::init_lte(const phy_args_t&            args,
 
   parse_common_config(cfg);
 
+  // The PUSCH DMRS of each cell are shared by all the workers
+  if (not workers_common.init_dmrs_pusch_tables()) {
+    return SRSRAN_ERROR;
+  }
+
   // Add workers to workers pool and start threads
   if (not cfg.phy_cell_cfg.empty()) {
     lte_workers.init(args, &workers_common, log_sink, WORKERS_THREAD_PRIO);
   }
+  workers_common.free_dmrs_pusch_tables();
 
   // For each carrier, initialise PRACH worker
   for (uint32_t cc = 0; cc < cfg.phy_cell_cfg.size(); cc++) {
@@ -191,7 +197,9 @@ int phy::init_lte(const phy_args_t&            args,
                stack_lte_,
                phy_log,
                PRACH_WORKER_THREAD_PRIO,
-               args.nof_prach_threads);
+               args.nof_prach_threads,
+               &workers_common.stage_prof,
+               (uint32_t)phy_stage_t::prach);
   }
   prach.set_max_prach_offset_us(args.max_prach_offset_us);
 
@@ -273,6 +281,49 @@ void phy::get_metrics(std::vector<phy_metrics_t>& metrics)
     metrics[j].ul.pucch_sinr /= metrics[j].ul.n_samples_pucch;
     metrics[j].ul.turbo_iters /= metrics[j].ul.n_samples;
   }
+
+  // Report the deadline misses and the slack of each task type of the PHY task pool
+  std::vector<srsran::edf_task_pool::type_metrics_t> task_metrics = lte_workers.get_task_metrics();
+  for (uint32_t i = 0; i < task_metrics.size(); i++) {
+    const srsran::edf_task_pool::type_metrics_t& m = task_metrics[i];
+    if (m.nof_tasks == 0) {
+      continue;
+    }
+    if (m.nof_misses > 0) {
+      phy_log.warning("%s tasks: %d of %d missed their deadline, min_slack=%.0f us",
+                      lte::sf_worker::task_type_to_string(i),
+                      m.nof_misses,
+                      m.nof_tasks,
+                      m.min_slack_us);
+    }
+    phy_log.info("%s tasks: nof_tasks=%d, misses=%d, avg_slack=%.0f us, min_slack=%.0f us, avg_runtime=%.0f us",
+                 lte::sf_worker::task_type_to_string(i),
+                 m.nof_tasks,
+                 m.nof_misses,
+                 m.avg_slack_us,
+                 m.min_slack_us,
+                 m.avg_runtime_us);
+  }
+}
+
+void phy::get_stage_metrics(std::vector<phy_stage_metrics_t>& metrics)
+{
+  metrics = workers_common.stage_prof.get_metrics();
+
+  if (phy_log.debug.enabled()) {
+    for (uint32_t i = 0; i < metrics.size(); i++) {
+      const phy_stage_metrics_t& m = metrics[i];
+      if (m.count == 0) {
+        continue;
+      }
+      phy_log.debug("%s stage: count=%d, avg=%.1f us, p99=%.0f us, max=%.1f us",
+                    phy_stage_to_string((phy_stage_t)i),
+                    m.count,
+                    m.avg_us,
+                    m.p99_us,
+                    m.max_us);
+    }
+  }
 }
 
 void phy::cmd_cell_gain(uint32_t cell_id, float gain_db)
@@ -358,6 +409,7 @@ int phy::init_nr(const phy_args_t& args, const phy_cfg_t& cfg, stack_interface_p
   worker_args.log.phy_level           = args.log.phy_level;
   worker_args.log.phy_hex_limit       = args.log.phy_hex_limit;
   worker_args.pusch_max_its           = args.nr_pusch_max_its;
+  worker_args.stage_prof              = &workers_common.stage_prof;
 
   if (not nr_workers->init(worker_args, cfg.phy_cell_cfg_nr)) {
     return SRSRAN_ERROR;
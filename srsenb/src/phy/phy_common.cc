@@ -19,10 +19,12 @@
  *
  */
 
+#include "srsenb/hdr/phy/phy_table_cache.h"
 #include "srsenb/hdr/phy/txrx.h"
 #include "srsran/common/threads.h"
 #include "srsran/phy/channel/channel.h"
 #include <sstream>
+#include <thread>
 
 #include <assert.h>
 
@@ -77,6 +79,83 @@ bool phy_common::init(const phy_cell_cfg_list_t&    cell_list_,
   return true;
 }
 
+/// Generates the PUSCH DMRS of a cell for all the PRB allocations, subframes and cyclic shifts and packs them in table
+static bool gen_dmrs_pusch_table(const srsran_cell_t&                     cell,
+                                 const srsran_refsignal_dmrs_pusch_cfg_t& cfg,
+                                 std::vector<uint8_t>&                    table)
+{
+  srsran_refsignal_ul_t             signal = {};
+  srsran_refsignal_ul_dmrs_pregen_t pregen = {};
+  srsran_refsignal_dmrs_pusch_cfg_t dmrs   = cfg;
+
+  bool ret = false;
+  table.resize(srsran_refsignal_dmrs_pusch_pregen_nof_bytes(cell.nof_prb));
+  if (srsran_refsignal_ul_set_cell(&signal, cell) == SRSRAN_SUCCESS and
+      srsran_refsignal_dmrs_pusch_pregen_init(&pregen, cell.nof_prb) == SRSRAN_SUCCESS and
+      srsran_refsignal_dmrs_pusch_pregen(&signal, &pregen, &dmrs) == SRSRAN_SUCCESS) {
+    ret = srsran_refsignal_dmrs_pusch_pregen_pack(&pregen, cell.nof_prb, table.data()) == SRSRAN_SUCCESS;
+  }
+  srsran_refsignal_dmrs_pusch_pregen_free(&signal, &pregen);
+  return ret;
+}
+
+bool phy_common::init_dmrs_pusch_tables()
+{
+  // Tables loaded from the cache stay pending, the rest are generated by a thread each
+  enum class gen_state_t { pending, ok, failed };
+
+  srslog::basic_logger& logger = srslog::fetch_basic_logger("PHY");
+  phy_table_cache       cache(params.table_cache_dir, logger);
+
+  dmrs_pusch_tables.clear();
+  dmrs_pusch_tables.resize(cell_list_lte.size());
+  std::vector<uint64_t>    keys(cell_list_lte.size());
+  std::vector<gen_state_t> generated(cell_list_lte.size(), gen_state_t::pending);
+  std::vector<std::thread> threads;
+
+  for (uint32_t cc = 0; cc < cell_list_lte.size(); cc++) {
+    const srsran_cell_t& cell = cell_list_lte[cc].cell;
+
+    // The table depends on the cell identity, bandwidth and cyclic prefix and the common DMRS configuration
+    uint64_t key = phy_table_cache::hash_value(cell.id);
+    key          = phy_table_cache::hash_value(cell.nof_prb, key);
+    key          = phy_table_cache::hash_value(cell.cp, key);
+    key          = phy_table_cache::hash_value(dmrs_pusch_cfg.cyclic_shift, key);
+    key          = phy_table_cache::hash_value(dmrs_pusch_cfg.delta_ss, key);
+    key          = phy_table_cache::hash_value(dmrs_pusch_cfg.group_hopping_en, key);
+    key          = phy_table_cache::hash_value(dmrs_pusch_cfg.sequence_hopping_en, key);
+    keys[cc]     = key;
+
+    uint32_t len = srsran_refsignal_dmrs_pusch_pregen_nof_bytes(cell.nof_prb);
+    if (cache.load("dmrs_pusch", SRSRAN_REFSIGNAL_DMRS_PUSCH_PREGEN_FORMAT, key, len, dmrs_pusch_tables[cc])) {
+      continue;
+    }
+    threads.emplace_back([this, cc, &generated]() {
+      bool ok       = gen_dmrs_pusch_table(cell_list_lte[cc].cell, dmrs_pusch_cfg, dmrs_pusch_tables[cc]);
+      generated[cc] = ok ? gen_state_t::ok : gen_state_t::failed;
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  for (uint32_t cc = 0; cc < cell_list_lte.size(); cc++) {
+    if (generated[cc] == gen_state_t::failed) {
+      logger.error("Error generating the PUSCH DMRS of cell %d", cc);
+      return false;
+    }
+    if (generated[cc] == gen_state_t::ok) {
+      cache.store("dmrs_pusch", SRSRAN_REFSIGNAL_DMRS_PUSCH_PREGEN_FORMAT, keys[cc], dmrs_pusch_tables[cc]);
+    }
+  }
+  return true;
+}
+
+void phy_common::free_dmrs_pusch_tables()
+{
+  std::vector<std::vector<uint8_t> >().swap(dmrs_pusch_tables);
+}
+
 void phy_common::stop()
 {
   semaphore.wait_all();
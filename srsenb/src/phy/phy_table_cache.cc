@@ -0,0 +1,149 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/phy/phy_table_cache.h"
+#include <cinttypes>
+#include <cstdio>
+#include <unistd.h>
+
+namespace srsenb {
+
+namespace {
+
+/// Header of each cached table file
+struct table_file_hdr_t {
+  uint32_t magic;
+  uint32_t version;
+  uint64_t key;
+  uint64_t len;
+  uint64_t checksum;
+  uint64_t format;
+};
+
+const uint32_t table_file_magic   = 0x53525442; // "SRTB"
+const uint32_t table_file_version = 2;
+
+} // namespace
+
+uint64_t phy_table_cache::hash(const void* data, size_t len, uint64_t seed)
+{
+  // FNV-1a
+  const uint8_t* bytes = static_cast<const uint8_t*>(data);
+  for (size_t i = 0; i < len; i++) {
+    seed ^= bytes[i];
+    seed *= 0x100000001b3ULL;
+  }
+  return seed;
+}
+
+phy_table_cache::phy_table_cache(std::string dir_, srslog::basic_logger& logger_) :
+  dir(std::move(dir_)), logger(logger_)
+{}
+
+std::string phy_table_cache::filename(const std::string& name, uint64_t key) const
+{
+  char key_str[17];
+  snprintf(key_str, sizeof(key_str), "%016" PRIx64, key);
+  return dir + "/" + name + "_" + key_str + ".bin";
+}
+
+bool phy_table_cache::load(const std::string&    name,
+                           uint32_t              format,
+                           uint64_t              key,
+                           size_t                len,
+                           std::vector<uint8_t>& table) const
+{
+  if (not enabled()) {
+    return false;
+  }
+
+  std::string path = filename(name, key);
+  FILE*       f    = fopen(path.c_str(), "rb");
+  if (f == nullptr) {
+    logger.info("PHY table %s not cached in %s", name.c_str(), path.c_str());
+    return false;
+  }
+
+  // The length is checked against the expected one and the file size before the table is allocated
+  long file_size = -1;
+  if (fseek(f, 0, SEEK_END) == 0) {
+    file_size = ftell(f);
+    rewind(f);
+  }
+
+  table_file_hdr_t hdr = {};
+  bool             ok  = fread(&hdr, sizeof(hdr), 1, f) == 1 and hdr.magic == table_file_magic and
+          hdr.version == table_file_version and hdr.format == format and hdr.key == key and hdr.len == len and
+          file_size >= 0 and (uint64_t)file_size == sizeof(hdr) + hdr.len;
+  if (ok) {
+    table.resize(hdr.len);
+    ok = fread(table.data(), 1, table.size(), f) == table.size() and
+         hash(table.data(), table.size()) == hdr.checksum;
+  }
+  fclose(f);
+
+  if (not ok) {
+    logger.warning("Discarding invalid PHY table cache file %s", path.c_str());
+    table.clear();
+    return false;
+  }
+  logger.info("Loaded PHY table %s from %s", name.c_str(), path.c_str());
+  return true;
+}
+
+bool phy_table_cache::store(const std::string&          name,
+                            uint32_t                    format,
+                            uint64_t                    key,
+                            const std::vector<uint8_t>& table) const
+{
+  if (not enabled()) {
+    return false;
+  }
+
+  // Write to a temporary file and rename it, so that an interrupted write never leaves a partial file behind
+  std::string path     = filename(name, key);
+  std::string tmp_path = path + ".tmp" + std::to_string(getpid());
+  FILE*       f        = fopen(tmp_path.c_str(), "wb");
+  if (f == nullptr) {
+    logger.warning("Couldn't create PHY table cache file %s", tmp_path.c_str());
+    return false;
+  }
+
+  table_file_hdr_t hdr = {};
+  hdr.magic            = table_file_magic;
+  hdr.version          = table_file_version;
+  hdr.format           = format;
+  hdr.key              = key;
+  hdr.len              = table.size();
+  hdr.checksum         = hash(table.data(), table.size());
+  bool ok = fwrite(&hdr, sizeof(hdr), 1, f) == 1 and fwrite(table.data(), 1, table.size(), f) == table.size();
+  ok      = (fclose(f) == 0) and ok;
+
+  if (not ok or rename(tmp_path.c_str(), path.c_str()) != 0) {
+    logger.warning("Couldn't write PHY table cache file %s", path.c_str());
+    unlink(tmp_path.c_str());
+    return false;
+  }
+  logger.info("Stored PHY table %s in %s", name.c_str(), path.c_str());
+  return true;
+}
+
+} // namespace srsenb
@@ -29,12 +29,16 @@ int prach_worker::init(const srsran_cell_t&      cell_,
                        const srsran_prach_cfg_t& prach_cfg_,
                        stack_interface_phy_lte*  stack_,
                        int                       priority,
-                       uint32_t                  nof_workers_)
+                       uint32_t                  nof_workers_,
+                       srsran::stage_profiler*   stage_prof_,
+                       uint32_t                  prof_stage_)
 {
   stack       = stack_;
   prach_cfg   = prach_cfg_;
   cell        = cell_;
   nof_workers = nof_workers_;
+  stage_prof  = stage_prof_;
+  prof_stage  = prof_stage_;
 
   max_prach_offset_us = 50;
 
@@ -143,6 +147,7 @@ int prach_worker::run_tti(sf_buffer* b)
   uint32_t prach_nof_det = 0;
   if (srsran_prach_tti_opportunity(&prach, b->tti, -1)) {
     // Detect possible PRACHs
+    uint64_t t_start = srsran::read_cycle_counter();
     if (srsran_prach_detect_offset(&prach,
                                    prach_cfg.freq_offset,
                                    &b->samples[prach.N_cp],
@@ -154,6 +159,9 @@ int prach_worker::run_tti(sf_buffer* b)
       logger.error("Error detecting PRACH");
       return SRSRAN_ERROR;
     }
+    if (stage_prof != nullptr) {
+      stage_prof->add(prof_stage, srsran::read_cycle_counter() - t_start);
+    }
 
     if (prach_nof_det) {
       for (uint32_t i = 0; i < prach_nof_det; i++) {
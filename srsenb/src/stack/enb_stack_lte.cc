@@ -26,6 +26,7 @@
 #include "srsran/interfaces/enb_x2_interfaces.h"
 #include "srsran/rlc/bearer_mem_pool.h"
 #include "srsran/srslog/event_trace.h"
+#include <inttypes.h>
 
 using namespace srsran;
 
@@ -101,12 +102,11 @@ enb_stack_lte::enb_stack_lte(srslog::sink& log_sink) :
   gtpu(&task_sched, gtpu_logger, &rx_sockets),
   s1ap(&task_sched, s1ap_logger, &rx_sockets),
   rrc(&task_sched, bearers),
-  mac_pcap(),
-  pending_stack_metrics(64)
+  mac_pcap()
 {
   get_background_workers().set_nof_workers(2);
   enb_task_queue     = task_sched.make_task_queue();
-  metrics_task_queue = task_sched.make_task_queue();
+  metrics_task_queue = task_sched.make_task_queue(srsran::task_priority::bulk);
   // sync_queue is added in init()
 }
 
@@ -130,6 +130,7 @@ int enb_stack_lte::init(const stack_args_t&      args_,
   phy     = phy_;
 
   // Init RNTI and bearer memory pools
+  srsran::set_rlc_compact_windows(args.mac.compact_ue_ctx);
   reserve_rnti_memblocks(args.mac.nof_prealloc_ues);
   uint32_t min_nof_bearers_per_ue = 4;
   reserve_rlc_memblocks(args.mac.nof_prealloc_ues * min_nof_bearers_per_ue);
@@ -153,7 +154,7 @@ int enb_stack_lte::init(const stack_args_t&      args_,
 
   // Set up pcap and trace
   if (args.mac_pcap.enable) {
-    mac_pcap.open(args.mac_pcap.filename);
+    mac_pcap.open(args.mac_pcap.filename, 0, args.pcap_rotation);
     mac.start_pcap(&mac_pcap);
   }
 
@@ -166,12 +167,14 @@ int enb_stack_lte::init(const stack_args_t&      args_,
   }
 
   if (args.s1ap_pcap.enable) {
-    s1ap_pcap.open(args.s1ap_pcap.filename.c_str());
+    s1ap_pcap.open(args.s1ap_pcap.filename.c_str(), args.pcap_rotation);
     s1ap.start_pcap(&s1ap_pcap);
   }
 
-  // add sync queue
-  sync_task_queue = task_sched.make_task_queue(args.sync_queue_size);
+  // add sync queue. The TTI tick runs before any other task, while the user plane and metrics tasks only get the
+  // configured time of each TTI
+  sync_task_queue = task_sched.make_task_queue(args.sync_queue_size, srsran::task_priority::tti_critical);
+  task_sched.set_task_budget(srsran::task_priority::bulk, std::chrono::microseconds(args.bulk_task_budget_us));
 
   // add x2 queue
   if (x2_ != nullptr) {
@@ -267,27 +270,96 @@ void enb_stack_lte::stop_impl()
 
 bool enb_stack_lte::get_metrics(stack_metrics_t* metrics)
 {
-  // use stack thread to query metrics
-  auto ret = metrics_task_queue.try_push([this]() {
-    stack_metrics_t metrics{};
-    mac.get_metrics(metrics.mac);
-    if (not metrics.mac.ues.empty()) {
-      rlc.get_metrics(metrics.rlc, metrics.mac.ues[0].nof_tti);
-      pdcp.get_metrics(metrics.pdcp, metrics.mac.ues[0].nof_tti);
+  // Each request waits on its own completion, so concurrent metrics and footprint requests can't steal each other's
+  // wakeup
+  std::promise<void> metrics_ready;
+
+  // use stack thread to query metrics. The per-UE vectors are filled in place in the caller's struct, which outlives
+  // the task because the caller waits for it, so no UE entry is copied on the way back
+  auto ret = metrics_task_queue.try_push([this, metrics, &metrics_ready]() {
+    mac.get_metrics(metrics->mac);
+    if (args.metrics_max_ues > 0) {
+      get_selected_ue_metrics(*metrics);
+    } else {
+      if (not metrics->mac.ues.empty()) {
+        rlc.get_metrics(metrics->rlc, metrics->mac.ues[0].nof_tti);
+        pdcp.get_metrics(metrics->pdcp, metrics->mac.ues[0].nof_tti);
+      }
+      rrc.get_metrics(metrics->rrc);
     }
-    rrc.get_metrics(metrics.rrc);
-    s1ap.get_metrics(metrics.s1ap);
-    if (not pending_stack_metrics.try_push(metrics)) {
-      stack_logger.error("Unable to push metrics to queue");
+    s1ap.get_metrics(metrics->s1ap);
+    log_task_metrics();
+    metrics_ready.set_value();
+  });
+  if (not ret.has_value()) {
+    return false;
+  }
+
+  // wait for result
+  metrics_ready.get_future().wait();
+  return true;
+}
+
+void enb_stack_lte::get_selected_ue_metrics(stack_metrics_t& metrics)
+{
+  // The UEs are ranked with the MAC counters of the period, which were already read for every UE. Only the selected
+  // UEs are kept and only their RLC, PDCP and RRC metrics are collected, the period of the others is restarted.
+  metrics.ue_idxs = mac_select_reported_ues(metrics.mac, metrics.mac.ues.size(), args.metrics_max_ues);
+
+  uint32_t              nof_tti = metrics.mac.ues.empty() ? 0 : metrics.mac.ues[0].nof_tti;
+  std::vector<uint16_t> rntis(metrics.ue_idxs.size());
+  for (uint32_t i = 0; i < metrics.ue_idxs.size(); ++i) {
+    // the indexes are increasing, so the entries can be moved to the front in place
+    if (metrics.ue_idxs[i] != i) {
+      metrics.mac.ues[i] = metrics.mac.ues[metrics.ue_idxs[i]];
     }
+    rntis[i] = metrics.mac.ues[i].rnti;
+  }
+  metrics.mac.ues.resize(rntis.size());
+
+  rlc.get_metrics(metrics.rlc, nof_tti, rntis);
+  pdcp.get_metrics(metrics.pdcp, nof_tti, rntis);
+  rrc.get_metrics(metrics.rrc, rntis);
+}
+
+bool enb_stack_lte::get_mem_footprint(stack_mem_footprint_t* footprint)
+{
+  std::promise<void> ready;
+
+  // the UE contexts are only modified by the stack thread, so walk them from there
+  auto ret = metrics_task_queue.try_push([this, footprint, &ready]() {
+    mac.get_mem_footprint(*footprint);
+    footprint->rlc  = rlc.get_mem_footprint();
+    footprint->pdcp = pdcp.get_mem_footprint();
+    footprint->rrc  = rrc.get_mem_footprint();
+    footprint->s1ap = s1ap.get_mem_footprint();
+    ready.set_value();
   });
+  if (not ret.has_value()) {
+    return false;
+  }
 
-  if (ret.has_value()) {
-    // wait for result
-    *metrics = pending_stack_metrics.pop_blocking();
-    return true;
+  ready.get_future().wait();
+  return true;
+}
+
+void enb_stack_lte::log_task_metrics()
+{
+  if (not stack_logger.info.enabled()) {
+    return;
+  }
+  for (uint32_t i = 0; i < static_cast<uint32_t>(srsran::task_priority::nof_priorities); ++i) {
+    auto                                prio = static_cast<srsran::task_priority>(i);
+    const srsran::task_class_metrics_t& m    = task_sched.get_task_metrics(prio);
+    stack_logger.info("Tasks %s: total=%" PRIu64 ", latency p50<%" PRIu64 "us, p99<%" PRIu64 "us, max=%" PRIu64
+                      "us, budget_exhausted=%" PRIu64,
+                      srsran::to_string(prio),
+                      m.nof_tasks,
+                      m.latency_percentile_us(50),
+                      m.latency_percentile_us(99),
+                      m.max_latency_us,
+                      m.nof_budget_exhausted);
   }
-  return false;
 }
 
 void enb_stack_lte::run_thread()
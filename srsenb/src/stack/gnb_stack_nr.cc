@@ -39,9 +39,9 @@ gnb_stack_nr::gnb_stack_nr(srslog::sink& log_sink) :
   pdcp(&task_sched, pdcp_logger),
   rlc(rlc_logger)
 {
-  sync_task_queue    = task_sched.make_task_queue();
-  gtpu_task_queue    = task_sched.make_task_queue();
-  metrics_task_queue = task_sched.make_task_queue();
+  sync_task_queue    = task_sched.make_task_queue(srsran::task_priority::tti_critical);
+  gtpu_task_queue    = task_sched.make_task_queue(srsran::task_priority::bulk);
+  metrics_task_queue = task_sched.make_task_queue(srsran::task_priority::bulk);
   gnb_task_queue     = task_sched.make_task_queue();
   x2_task_queue      = task_sched.make_task_queue();
 }
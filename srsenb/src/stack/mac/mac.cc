@@ -244,13 +244,14 @@ int mac::cell_cfg(const std::vector<sched_interface::cell_cfg_t>& cell_cfg_)
 void mac::get_metrics(mac_metrics_t& metrics)
 {
   srsran::rwlock_read_guard lock(rwlock);
+  metrics.ues.clear();
   metrics.ues.reserve(ue_db.size());
   for (auto& u : ue_db) {
-    if (not scheduler.ue_exists(u.first)) {
-      continue;
-    }
+    // users not yet (or no longer) in the scheduler are skipped
     metrics.ues.emplace_back();
-    u.second->metrics_read(&metrics.ues.back());
+    if (not u.second->metrics_read(&metrics.ues.back())) {
+      metrics.ues.pop_back();
+    }
   }
   metrics.cc_info.resize(detected_rachs.size());
   for (unsigned cc = 0, e = detected_rachs.size(); cc != e; ++cc) {
@@ -259,6 +260,22 @@ void mac::get_metrics(mac_metrics_t& metrics)
   }
 }
 
+void mac::get_mem_footprint(stack_mem_footprint_t& footprint)
+{
+  {
+    srsran::rwlock_read_guard lock(rwlock);
+    footprint.nof_ues = 0;
+    footprint.mac     = 0;
+    for (auto& u : ue_db) {
+      if (u.first != SRSRAN_MRNTI) {
+        footprint.nof_ues++;
+      }
+      footprint.mac += u.second->get_mem_footprint();
+    }
+  }
+  footprint.sched = scheduler.get_mem_footprint();
+}
+
 void mac::toggle_padding()
 {
   do_padding = !do_padding;
@@ -493,8 +510,17 @@ uint16_t mac::allocate_ue(uint32_t enb_cc_idx)
     }
 
     // Allocate and initialize UE object
-    unique_rnti_ptr<ue> ue_ptr = make_rnti_obj<ue>(
-        rnti, rnti, enb_cc_idx, &scheduler, rrc_h, rlc_h, phy_h, logger, cells.size(), softbuffer_pool.get());
+    unique_rnti_ptr<ue> ue_ptr = make_rnti_obj<ue>(rnti,
+                                                   rnti,
+                                                   enb_cc_idx,
+                                                   &scheduler,
+                                                   rrc_h,
+                                                   rlc_h,
+                                                   phy_h,
+                                                   logger,
+                                                   cells.size(),
+                                                   softbuffer_pool.get(),
+                                                   args.compact_ue_ctx);
 
     // Add UE to rnti map
     srsran::rwlock_write_guard rw_lock(rwlock);
@@ -996,8 +1022,17 @@ void mac::write_mcch(const srsran::sib2_mbms_t* sib2_,
   memcpy(mcch_payload_buffer, mcch_payload, mcch_payload_length * sizeof(uint8_t));
   current_mcch_length     = mcch_payload_length;
 
-  unique_rnti_ptr<ue> ue_ptr = make_rnti_obj<ue>(
-      SRSRAN_MRNTI, SRSRAN_MRNTI, 0, &scheduler, rrc_h, rlc_h, phy_h, logger, cells.size(), softbuffer_pool.get());
+  unique_rnti_ptr<ue> ue_ptr = make_rnti_obj<ue>(SRSRAN_MRNTI,
+                                                 SRSRAN_MRNTI,
+                                                 0,
+                                                 &scheduler,
+                                                 rrc_h,
+                                                 rlc_h,
+                                                 phy_h,
+                                                 logger,
+                                                 cells.size(),
+                                                 softbuffer_pool.get(),
+                                                 args.compact_ue_ctx);
 
   auto ret = ue_db.insert(SRSRAN_MRNTI, std::move(ue_ptr));
   if (!ret) {
@@ -174,6 +174,26 @@ uint32_t sched::get_ul_buffer(uint16_t rnti)
   return ret;
 }
 
+int sched::get_ue_metrics_state(uint16_t rnti, uint32_t& ul_buffer, uint32_t& dl_buffer, uint32_t& pcell_enb_cc_idx)
+{
+  return ue_db_access_locked(
+      rnti,
+      [this, &ul_buffer, &dl_buffer, &pcell_enb_cc_idx](sched_ue& ue) {
+        ul_buffer        = ue.get_pending_ul_new_data(to_tx_ul(last_tti), -1);
+        dl_buffer        = ue.get_pending_dl_rlc_data();
+        pcell_enb_cc_idx = SRSRAN_MAX_CARRIERS;
+        for (size_t enb_cc_idx = 0; enb_cc_idx < carrier_schedulers.size(); ++enb_cc_idx) {
+          const sched_ue_cell* cc_ue = ue.find_ue_carrier(enb_cc_idx);
+          if (cc_ue != nullptr and cc_ue->get_ue_cc_idx() == 0) {
+            pcell_enb_cc_idx = enb_cc_idx;
+            break;
+          }
+        }
+      },
+      __PRETTY_FUNCTION__,
+      false);
+}
+
 int sched::dl_rlc_buffer_state(uint16_t rnti, uint32_t lc_id, uint32_t tx_queue, uint32_t prio_tx_queue)
 {
   return ue_db_access_locked(rnti, [&](sched_ue& ue) { ue.dl_buffer_state(lc_id, tx_queue, prio_tx_queue); });
@@ -301,6 +321,16 @@ std::array<int, SRSRAN_MAX_CARRIERS> sched::get_enb_ue_activ_cc_map(uint16_t rnt
   return ret;
 }
 
+size_t sched::get_mem_footprint()
+{
+  std::lock_guard<std::mutex> lock(sched_mutex);
+  size_t                      bytes = 0;
+  for (auto& ue_pair : ue_db) {
+    bytes += ue_pair.second->get_mem_footprint();
+  }
+  return bytes;
+}
+
 /*******************************************************
  *
  * Main sched functions
@@ -71,6 +71,18 @@ void ue_cc_softbuffers::clear()
   }
 }
 
+size_t ue_cc_softbuffers::get_mem_footprint() const
+{
+  size_t bytes = sizeof(ue_cc_softbuffers);
+  for (const srsran_softbuffer_rx_t& buffer : softbuffer_rx_list) {
+    bytes += srsran_softbuffer_rx_mem_size(&buffer);
+  }
+  for (const srsran_softbuffer_tx_t& buffer : softbuffer_tx_list) {
+    bytes += srsran_softbuffer_tx_mem_size(&buffer);
+  }
+  return bytes;
+}
+
 cc_used_buffers_map::cc_used_buffers_map() : logger(&srslog::fetch_basic_logger("MAC")) {}
 
 cc_used_buffers_map::~cc_used_buffers_map()
@@ -141,18 +153,7 @@ bool cc_used_buffers_map::has_tti(tti_point tti) const
 
 ////////////////
 
-cc_buffer_handler::cc_buffer_handler()
-{
-  for (auto& harq_buffers : tx_payload_buffer) {
-    for (srsran::unique_byte_buffer_t& tb_buffer : harq_buffers) {
-      tb_buffer = srsran::make_byte_buffer();
-      if (tb_buffer == nullptr) {
-        srslog::fetch_basic_logger("MAC").error("Failed to allocate HARQ buffers for UE");
-        return;
-      }
-    }
-  }
-}
+cc_buffer_handler::cc_buffer_handler() {}
 
 cc_buffer_handler::~cc_buffer_handler()
 {
@@ -184,6 +185,59 @@ void cc_buffer_handler::reset()
   }
 }
 
+void cc_buffer_handler::allocate_tx_payload_buffers()
+{
+  for (auto& harq_buffers : tx_payload_buffer) {
+    for (srsran::unique_byte_buffer_t& tb_buffer : harq_buffers) {
+      if (tb_buffer != nullptr) {
+        continue;
+      }
+      tb_buffer = srsran::make_byte_buffer();
+      if (tb_buffer == nullptr) {
+        srslog::fetch_basic_logger("MAC").error("Failed to allocate HARQ buffers for UE");
+        return;
+      }
+    }
+  }
+}
+
+void cc_buffer_handler::release_idle_tx_payload_buffers()
+{
+  if (nof_tx_idle_ttis < max_tx_idle_ttis) {
+    nof_tx_idle_ttis++;
+    return;
+  }
+  for (auto& harq_buffers : tx_payload_buffer) {
+    for (srsran::unique_byte_buffer_t& tb_buffer : harq_buffers) {
+      tb_buffer.reset();
+    }
+  }
+}
+
+srsran::byte_buffer_t* cc_buffer_handler::get_tx_payload_buffer(size_t harq_pid, size_t tb)
+{
+  nof_tx_idle_ttis                        = 0;
+  srsran::unique_byte_buffer_t& tb_buffer = tx_payload_buffer[harq_pid][tb];
+  if (tb_buffer == nullptr) {
+    tb_buffer = srsran::make_byte_buffer();
+    if (tb_buffer == nullptr) {
+      srslog::fetch_basic_logger("MAC").error("Failed to allocate HARQ buffer for UE");
+    }
+  }
+  return tb_buffer.get();
+}
+
+size_t cc_buffer_handler::get_mem_footprint() const
+{
+  size_t bytes = empty() ? 0 : cc_softbuffers->get_mem_footprint();
+  for (const auto& harq_buffers : tx_payload_buffer) {
+    for (const srsran::unique_byte_buffer_t& tb_buffer : harq_buffers) {
+      bytes += tb_buffer != nullptr ? sizeof(srsran::byte_buffer_t) : 0;
+    }
+  }
+  return bytes;
+}
+
 ue::ue(uint16_t                                 rnti_,
        uint32_t                                 enb_cc_idx,
        sched_interface*                         sched_,
@@ -192,7 +246,8 @@ ue::ue(uint16_t                                 rnti_,
        phy_interface_stack_lte*                 phy_,
        srslog::basic_logger&                    logger_,
        uint32_t                                 nof_cells_,
-       srsran::obj_pool_itf<ue_cc_softbuffers>* softbuffer_pool_) :
+       srsran::obj_pool_itf<ue_cc_softbuffers>* softbuffer_pool_,
+       bool                                     compact_ctx_) :
   rnti(rnti_),
   sched(sched_),
   rrc(rrc_),
@@ -204,10 +259,18 @@ ue::ue(uint16_t                                 rnti_,
   mac_msg_ul(20, logger_),
   ta_fsm(this),
   softbuffer_pool(softbuffer_pool_),
+  compact_ctx(compact_ctx_),
   cc_buffers(nof_cells_)
 {
   // Allocate buffer for PCell
   cc_buffers[enb_cc_idx].allocate_cc(softbuffer_pool->make());
+
+  // In compact mode the HARQ payload buffers are only taken from the pool once a HARQ process is used
+  if (not compact_ctx) {
+    for (auto& cc : cc_buffers) {
+      cc.allocate_tx_payload_buffers();
+    }
+  }
 }
 
 ue::~ue() {}
@@ -277,6 +340,14 @@ void ue::clear_old_buffers(uint32_t tti)
   for (auto& cc : cc_buffers) {
     cc.get_rx_used_buffers().clear_old_pdus(tti_point{tti});
   }
+
+  // In compact mode, the HARQ payload buffers go back to the pool while there are no DL transmissions
+  if (compact_ctx) {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto& cc : cc_buffers) {
+      cc.release_idle_tx_payload_buffers();
+    }
+  }
 }
 
 void ue::set_tti(uint32_t tti)
@@ -555,6 +626,9 @@ uint8_t* ue::generate_pdu(uint32_t                              enb_cc_idx,
   uint8_t*                    ret = nullptr;
   if (enb_cc_idx < SRSRAN_MAX_CARRIERS && harq_pid < SRSRAN_FDD_NOF_HARQ && tb_idx < SRSRAN_MAX_TB) {
     srsran::byte_buffer_t* buffer = cc_buffers[enb_cc_idx].get_tx_payload_buffer(harq_pid, tb_idx);
+    if (buffer == nullptr) {
+      return nullptr;
+    }
     buffer->clear();
     mac_msg_dl.init_tx(buffer, grant_size, false);
     for (uint32_t i = 0; i < nof_pdu_elems; i++) {
@@ -585,6 +659,9 @@ uint8_t* ue::generate_mch_pdu(uint32_t                             harq_pid,
   std::lock_guard<std::mutex> lock(mutex);
   uint8_t*                    ret    = nullptr;
   srsran::byte_buffer_t*      buffer = cc_buffers[0].get_tx_payload_buffer(harq_pid, 0);
+  if (buffer == nullptr) {
+    return nullptr;
+  }
   buffer->clear();
   mch_mac_msg_dl.init_tx(buffer, grant_size);
 
@@ -605,27 +682,36 @@ uint8_t* ue::generate_mch_pdu(uint32_t                             harq_pid,
   return ret;
 }
 
+size_t ue::get_mem_footprint()
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  size_t                      bytes = sizeof(ue);
+  for (const auto& cc : cc_buffers) {
+    bytes += cc.get_mem_footprint();
+  }
+  return bytes;
+}
+
 /******* METRICS interface ***************/
-void ue::metrics_read(mac_ue_metrics_t* metrics_)
+bool ue::metrics_read(mac_ue_metrics_t* metrics_)
 {
-  uint32_t ul_buffer = sched->get_ul_buffer(rnti);
-  uint32_t dl_buffer = sched->get_dl_buffer(rnti);
+  uint32_t ul_buffer = 0, dl_buffer = 0, pcell_enb_cc_idx = 0;
+  if (sched->get_ue_metrics_state(rnti, ul_buffer, dl_buffer, pcell_enb_cc_idx) != SRSRAN_SUCCESS) {
+    return false;
+  }
 
   std::lock_guard<std::mutex> lock(metrics_mutex);
   ue_metrics.rnti      = rnti;
   ue_metrics.ul_buffer = ul_buffer;
   ue_metrics.dl_buffer = dl_buffer;
-
-  // set PCell sector id
-  std::array<int, SRSRAN_MAX_CARRIERS> cc_list = sched->get_enb_ue_cc_map(rnti);
-  auto                                 it      = std::find(cc_list.begin(), cc_list.end(), 0);
-  ue_metrics.cc_idx                            = std::distance(cc_list.begin(), it);
+  ue_metrics.cc_idx    = pcell_enb_cc_idx;
 
   *metrics_ = ue_metrics;
 
   phr_counter    = 0;
   dl_cqi_counter = 0;
   ue_metrics     = {};
+  return true;
 }
 
 void ue::metrics_phr(float phr)
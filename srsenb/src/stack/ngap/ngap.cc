@@ -278,59 +278,19 @@ void ngap::write_pdu(uint16_t rnti, srsran::unique_byte_buffer_t pdu)
  *              ngap::user_list class
  *********************************************************/
 
-ngap::ue* ngap::user_list::find_ue_rnti(uint16_t rnti)
-{
-  if (rnti == SRSRAN_INVALID_RNTI) {
-    return nullptr;
-  }
-  auto it = std::find_if(
-      users.begin(), users.end(), [rnti](const user_list::pair_type& v) { return v.second->ctxt.rnti == rnti; });
-  return it != users.end() ? it->second.get() : nullptr;
-}
-
 ngap::ue* ngap::user_list::find_ue_gnbid(uint32_t gnbid)
 {
-  auto it = users.find(gnbid);
-  return (it != users.end()) ? it->second.get() : nullptr;
+  return find_ue_enbid(gnbid);
 }
 
 ngap::ue* ngap::user_list::find_ue_amfid(uint32_t amfid)
 {
-  auto it = std::find_if(users.begin(), users.end(), [amfid](const user_list::pair_type& v) {
-    return v.second->ctxt.amf_ue_ngap_id == amfid;
-  });
-  return it != users.end() ? it->second.get() : nullptr;
+  return find_ue_mmeid(amfid);
 }
 
-ngap::ue* ngap::user_list::add_user(std::unique_ptr<ngap::ue> user)
+bool ngap::user_list::set_amf_ue_ngap_id(ue* ue_ptr, uint32_t amfid)
 {
-  static srslog::basic_logger& logger = srslog::fetch_basic_logger("NGAP");
-  // Check for ID repetitions
-  if (find_ue_rnti(user->ctxt.rnti) != nullptr) {
-    logger.error("The user to be added with rnti=0x%x already exists", user->ctxt.rnti);
-    return nullptr;
-  }
-  if (find_ue_gnbid(user->ctxt.ran_ue_ngap_id) != nullptr) {
-    logger.error("The user to be added with ran ue ngap id=%d already exists", user->ctxt.ran_ue_ngap_id);
-    return nullptr;
-  }
-  if (user->ctxt.amf_ue_ngap_id.has_value() and find_ue_amfid(user->ctxt.amf_ue_ngap_id.value()) != nullptr) {
-    logger.error("The user to be added with amf id=%d already exists", user->ctxt.amf_ue_ngap_id.value());
-    return nullptr;
-  }
-  auto p = users.insert(std::make_pair(user->ctxt.ran_ue_ngap_id, std::move(user)));
-  return p.second ? p.first->second.get() : nullptr;
-}
-
-void ngap::user_list::erase(ue* ue_ptr)
-{
-  static srslog::basic_logger& logger = srslog::fetch_basic_logger("NGAP");
-  auto                         it     = users.find(ue_ptr->ctxt.ran_ue_ngap_id);
-  if (it == users.end()) {
-    logger.error("User to be erased does not exist");
-    return;
-  }
-  users.erase(it);
+  return set_mme_ue_s1ap_id(ue_ptr, amfid);
 }
 
 /*******************************************************************************
@@ -753,7 +713,7 @@ ngap::ue* ngap::handle_ngapmsg_ue_id(uint32_t gnb_id, uint32_t amf_id)
 
     user_amf_ptr = users.find_ue_amfid(amf_id);
     if (not user_ptr->ctxt.amf_ue_ngap_id.has_value() and user_amf_ptr == nullptr) {
-      user_ptr->ctxt.amf_ue_ngap_id = amf_id;
+      users.set_amf_ue_ngap_id(user_ptr, amf_id);
       return user_ptr;
     }
 
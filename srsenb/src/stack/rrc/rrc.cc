@@ -25,6 +25,7 @@
 #include "srsenb/hdr/stack/rrc/rrc_endc.h"
 #include "srsenb/hdr/stack/rrc/rrc_mobility.h"
 #include "srsenb/hdr/stack/rrc/rrc_paging.h"
+#include "srsenb/hdr/stack/rrc/ue_meas_cfg.h"
 #include "srsenb/hdr/stack/s1ap/s1ap.h"
 #include "srsran/asn1/asn1_utils.h"
 #include "srsran/asn1/rrc_utils.h"
@@ -84,6 +85,7 @@ int32_t rrc::init(const rrc_cfg_t&       cfg_,
   }
 
   cell_res_list.reset(new freq_res_common_list{cfg});
+  meas_cache.reset(new meas_cfg_cache{});
 
   // Loads the PRACH root sequence
   cfg.sibs[1].sib2().rr_cfg_common.prach_cfg.root_seq_idx = cfg.cell_list[0].root_seq_idx;
@@ -157,6 +159,24 @@ void rrc::get_metrics(rrc_metrics_t& m)
   }
 }
 
+void rrc::get_metrics(rrc_metrics_t& m, const std::vector<uint16_t>& rntis)
+{
+  if (running) {
+    m.ues.assign(rntis.size(), {});
+    for (size_t i = 0; i < rntis.size(); ++i) {
+      auto ue_it = users.find(rntis[i]);
+      if (ue_it != users.end()) {
+        ue_it->second->get_metrics(m.ues[i]);
+      }
+    }
+  }
+}
+
+size_t rrc::get_mem_footprint()
+{
+  return users.size() * sizeof(ue);
+}
+
 /*******************************************************************************
   MAC interface
 
@@ -228,8 +228,11 @@ bool rrc::ue::rrc_mobility::fill_conn_recfg_no_ho_cmd(asn1::rrc::rrc_conn_recfg_
   }
 
   // Check if there has been any update in ue_var_meas based on UE current cell list
-  conn_recfg->meas_cfg_present =
-      apply_meascfg_updates(conn_recfg->meas_cfg, rrc_ue->current_ue_cfg.meas_cfg, rrc_ue->ue_cell_list);
+  conn_recfg->meas_cfg_present = apply_meascfg_updates(conn_recfg->meas_cfg,
+                                                       rrc_ue->current_ue_cfg.meas_cfg,
+                                                       rrc_ue->current_ue_cfg.meas_cfg_id,
+                                                       rrc_ue->ue_cell_list,
+                                                       *rrc_enb->meas_cache);
   return conn_recfg->meas_cfg_present;
 }
 
@@ -549,8 +552,13 @@ void rrc::ue::rrc_mobility::fill_mobility_reconf_common(asn1::rrc::dl_dcch_msg_s
   intralte.next_hop_chaining_count        = rrc_ue->ue_security_cfg.get_ncc();
 
   // Add MeasConfig of target cell
-  recfg_r8.meas_cfg_present = apply_meascfg_updates(
-      recfg_r8.meas_cfg, rrc_ue->current_ue_cfg.meas_cfg, rrc_ue->ue_cell_list, src_dl_earfcn, src_pci);
+  recfg_r8.meas_cfg_present = apply_meascfg_updates(recfg_r8.meas_cfg,
+                                                    rrc_ue->current_ue_cfg.meas_cfg,
+                                                    rrc_ue->current_ue_cfg.meas_cfg_id,
+                                                    rrc_ue->ue_cell_list,
+                                                    *rrc_enb->meas_cache,
+                                                    src_dl_earfcn,
+                                                    src_pci);
 
   apply_reconf_updates(recfg_r8,
                        rrc_ue->current_ue_cfg,
@@ -1015,7 +1023,8 @@ bool rrc::ue::rrc_mobility::apply_ho_prep_cfg(const ho_prep_info_r8_ies_s&
   apply_rr_cfg_ded_diff(rrc_ue->current_ue_cfg.rr_cfg, ho_prep.as_cfg.source_rr_cfg);
 
   // Save measConfig
-  rrc_ue->current_ue_cfg.meas_cfg = ho_prep.as_cfg.source_meas_cfg;
+  rrc_ue->current_ue_cfg.meas_cfg    = ho_prep.as_cfg.source_meas_cfg;
+  rrc_ue->current_ue_cfg.meas_cfg_id = meas_cfg_cache::invalid_cfg_id;
 
   // Save source UE MAC configuration as a base
   rrc_ue->mac_ctrl.handle_ho_prep(ho_prep);
@@ -77,6 +77,20 @@ int rrc_nr::init(const rrc_nr_cfg_t&         cfg_,
                                     &cfg.cell_list[0].phy_cell.pdcch);
   srsran_assert(ret2, "Invalid NR cell configuration.");
 
+  // PHY config of newly added EN-DC UEs, derived from the cell config once rather than per UE
+  srsran::phy_cfg_nr_default_t::reference_cfg_t ref_args{};
+  ref_args.duplex     = cfg.cell_list[0].duplex_mode == SRSRAN_DUPLEX_MODE_TDD
+                            ? srsran::phy_cfg_nr_default_t::reference_cfg_t::R_DUPLEX_TDD_CUSTOM_6_4
+                            : srsran::phy_cfg_nr_default_t::reference_cfg_t::R_DUPLEX_FDD;
+  base_ue_phy_cfg     = srsran::phy_cfg_nr_default_t{ref_args};
+  base_ue_phy_cfg.csi = {}; // disable CSI until RA is complete
+
+  // Fill and pack the secondary cell group config common to all UEs
+  if (pack_base_cell_group_cfg() != SRSRAN_SUCCESS) {
+    logger.error("Couldn't pack the NR secondary cell group config.");
+    return SRSRAN_ERROR;
+  }
+
   config_phy(); // if PHY is not yet initialized, config will be stored and applied on initialization
   config_mac();
 
@@ -172,9 +186,12 @@ rrc_nr_cfg_t rrc_nr::update_default_cfg(const rrc_nr_cfg_t& current)
  */
 int rrc_nr::add_user(uint16_t rnti, const sched_nr_ue_cfg_t& uecfg, bool start_msg3_timer)
 {
-  if (users.count(rnti) == 0) {
+  if (not users.contains(rnti)) {
     // If in the ue ctor, "start_msg3_timer" is set to true, this will start the MSG3 RX TIMEOUT at ue creation
-    users.insert(std::make_pair(rnti, std::unique_ptr<ue>(new ue(this, rnti, uecfg, start_msg3_timer))));
+    if (not users.insert(rnti, std::unique_ptr<ue>(new ue(this, rnti, uecfg, start_msg3_timer)))) {
+      logger.error("Adding user rnti=0x%x (no space left)", rnti);
+      return SRSRAN_ERROR;
+    }
     rlc->add_user(rnti);
     pdcp->add_user(rnti);
     logger.info("Added new user rnti=0x%x", rnti);
@@ -437,7 +454,7 @@ void rrc_nr::handle_pdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer
     logger.info(pdu->msg, pdu->N_bytes, "Rx %s PDU", get_rb_name(lcid));
   }
 
-  if (users.count(rnti) == 1) {
+  if (users.contains(rnti)) {
     switch (static_cast<srsran::nr_srb>(lcid)) {
       case srsran::nr_srb::srb0:
         //        parse_ul_ccch(rnti, std::move(pdu));
@@ -518,12 +535,7 @@ void rrc_nr::sgnb_addition_request(uint16_t eutra_rnti, const sgnb_addition_req_
   uecfg.carriers[0].active      = true;
   uecfg.carriers[0].cc          = 0;
   uecfg.ue_bearers[0].direction = mac_lc_ch_cfg_t::BOTH;
-  srsran::phy_cfg_nr_default_t::reference_cfg_t ref_args{};
-  ref_args.duplex   = cfg.cell_list[0].duplex_mode == SRSRAN_DUPLEX_MODE_TDD
-                          ? srsran::phy_cfg_nr_default_t::reference_cfg_t::R_DUPLEX_TDD_CUSTOM_6_4
-                          : srsran::phy_cfg_nr_default_t::reference_cfg_t::R_DUPLEX_FDD;
-  uecfg.phy_cfg     = srsran::phy_cfg_nr_default_t{ref_args};
-  uecfg.phy_cfg.csi = {}; // disable CSI until RA is complete
+  uecfg.phy_cfg                 = base_ue_phy_cfg;
 
   uint16_t nr_rnti = mac->reserve_rnti(0, uecfg);
   if (nr_rnti == SRSRAN_INVALID_RNTI) {
@@ -697,7 +709,275 @@ void rrc_nr::ue::send_dl_ccch(dl_ccch_msg_s* dl_ccch_msg)
   parent->rlc->write_sdu(rnti, (uint32_t)srsran::nr_srb::srb0, std::move(pdu));
 }
 
-int rrc_nr::ue::pack_secondary_cell_group_rlc_cfg(asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack)
+// Helper for the RRC Reconfiguration sender to pack hard-coded config
+int rrc_nr::ue::pack_secondary_cell_group_cfg(asn1::dyn_octstring& packed_secondary_cell_config)
+{
+  // Copy the packed config common to all UEs and write the newUE-Identity (initially zero) of this UE
+  packed_secondary_cell_config = parent->base_cell_group_cfg_packed;
+  for (uint32_t i = 0; i < 16; ++i) {
+    if ((rnti >> (15U - i)) & 1U) {
+      uint32_t pos = parent->new_ue_id_bit_pos + i;
+      packed_secondary_cell_config[pos / 8] |= 0x80U >> (pos % 8);
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+// Packs a hard-coded RRC Reconfiguration with fixed params for all layers (for now)
+int rrc_nr::ue::pack_rrc_reconfiguration(asn1::dyn_octstring& packed_rrc_reconfig)
+{
+  rrc_recfg_s reconfig;
+  reconfig.rrc_transaction_id = ((transaction_id++) % 4u);
+  rrc_recfg_ies_s& recfg_ies  = reconfig.crit_exts.set_rrc_recfg();
+
+  // add secondary cell group config
+  recfg_ies.secondary_cell_group_present = true;
+
+  if (pack_secondary_cell_group_cfg(recfg_ies.secondary_cell_group) == SRSRAN_ERROR) {
+    parent->logger.error("Failed to pack secondary cell group");
+    return SRSRAN_ERROR;
+  }
+
+  // now pack ..
+  packed_rrc_reconfig.resize(512);
+  asn1::bit_ref bref_pack(packed_rrc_reconfig.data(), packed_rrc_reconfig.size());
+  if (reconfig.pack(bref_pack) != asn1::SRSASN_SUCCESS) {
+    parent->logger.error("Failed to pack RRC Reconfiguration");
+    return SRSRAN_ERROR;
+  }
+  packed_rrc_reconfig.resize(bref_pack.distance_bytes());
+
+  return SRSRAN_SUCCESS;
+}
+
+// Packs a hard-coded NR radio bearer config with fixed params for RLC/PDCP (for now)
+int rrc_nr::ue::pack_nr_radio_bearer_config(asn1::dyn_octstring& packed_nr_bearer_config)
+{
+  // set security config
+  auto& radio_bearer_cfg_pack                        = radio_bearer_cfg;
+  radio_bearer_cfg_pack.security_cfg_present         = true;
+  auto& sec_cfg                                      = radio_bearer_cfg_pack.security_cfg;
+  sec_cfg.key_to_use_present                         = true;
+  sec_cfg.key_to_use                                 = asn1::rrc_nr::security_cfg_s::key_to_use_opts::secondary;
+  sec_cfg.security_algorithm_cfg_present             = true;
+  sec_cfg.security_algorithm_cfg.ciphering_algorithm = ciphering_algorithm_opts::nea0;
+  sec_cfg.security_algorithm_cfg.integrity_prot_algorithm_present = true;
+  sec_cfg.security_algorithm_cfg.integrity_prot_algorithm         = integrity_prot_algorithm_opts::nia0;
+
+  // pack it
+  packed_nr_bearer_config.resize(128);
+  asn1::bit_ref bref_pack(packed_nr_bearer_config.data(), packed_nr_bearer_config.size());
+  if (radio_bearer_cfg_pack.pack(bref_pack) != asn1::SRSASN_SUCCESS) {
+    parent->logger.error("Failed to pack NR radio bearer config");
+    return SRSRAN_ERROR;
+  }
+
+  // resize to packed length
+  packed_nr_bearer_config.resize(bref_pack.distance_bytes());
+
+  return SRSRAN_SUCCESS;
+}
+
+int rrc_nr::ue::handle_sgnb_addition_request(uint16_t eutra_rnti_, const sgnb_addition_req_params_t& req_params)
+{
+  // Add DRB1 to RLC and PDCP
+  if (add_drb() != SRSRAN_SUCCESS) {
+    parent->logger.error("Failed to configure DRB");
+    parent->rrc_eutra->sgnb_addition_reject(eutra_rnti_);
+    return SRSRAN_ERROR;
+  }
+
+  // provide hard-coded NR configs
+  rrc_eutra_interface_rrc_nr::sgnb_addition_ack_params_t ack_params = {};
+  if (pack_rrc_reconfiguration(ack_params.nr_secondary_cell_group_cfg_r15) == SRSRAN_ERROR) {
+    parent->logger.error("Failed to pack RRC Reconfiguration. Sending SgNB addition reject.");
+    parent->rrc_eutra->sgnb_addition_reject(eutra_rnti_);
+    return SRSRAN_ERROR;
+  }
+
+  if (pack_nr_radio_bearer_config(ack_params.nr_radio_bearer_cfg1_r15) == SRSRAN_ERROR) {
+    parent->logger.error("Failed to pack NR radio bearer config. Sending SgNB addition reject.");
+    parent->rrc_eutra->sgnb_addition_reject(eutra_rnti_);
+    return SRSRAN_ERROR;
+  }
+
+  // send response to EUTRA
+  ack_params.nr_rnti       = rnti;
+  ack_params.eps_bearer_id = req_params.eps_bearer_id;
+  parent->rrc_eutra->sgnb_addition_ack(eutra_rnti_, ack_params);
+
+  // recognize RNTI as ENDC user
+  endc       = true;
+  eutra_rnti = eutra_rnti_;
+
+  return SRSRAN_SUCCESS;
+}
+
+void rrc_nr::ue::crnti_ce_received()
+{
+  // Assume NSA mode active
+  if (endc) {
+    // send SgNB addition complete for ENDC users
+    parent->rrc_eutra->sgnb_addition_complete(eutra_rnti, rnti);
+
+    // stop RX MSG3/MSG5 activity timer on MAC CE RNTI reception
+    set_activity_timeout(UE_INACTIVITY_TIMEOUT);
+    parent->logger.debug("Received MAC CE-RNTI for 0x%x - stopping MSG3/MSG5 timer, starting inactivity timer", rnti);
+
+    // Add DRB1 to MAC
+    const cell_group_cfg_s& cell_group_cfg = parent->base_cell_group_cfg;
+    for (auto& drb : cell_group_cfg.rlc_bearer_to_add_mod_list) {
+      uecfg.ue_bearers[drb.lc_ch_id].direction = mac_lc_ch_cfg_t::BOTH;
+      uecfg.ue_bearers[drb.lc_ch_id].group     = drb.mac_lc_ch_cfg.ul_specific_params.lc_ch_group;
+    }
+
+    // Update UE phy params
+    srsran::make_pdsch_cfg_from_serv_cell(cell_group_cfg.sp_cell_cfg.sp_cell_cfg_ded, &uecfg.phy_cfg.pdsch);
+    srsran::make_csi_cfg_from_serv_cell(cell_group_cfg.sp_cell_cfg.sp_cell_cfg_ded, &uecfg.phy_cfg.csi);
+    srsran::make_phy_ssb_cfg(parent->cfg.cell_list[0].phy_cell.carrier,
+                             cell_group_cfg.sp_cell_cfg.recfg_with_sync.sp_cell_cfg_common,
+                             &uecfg.phy_cfg.ssb);
+    srsran::make_duplex_cfg_from_serv_cell(cell_group_cfg.sp_cell_cfg.recfg_with_sync.sp_cell_cfg_common,
+                                           &uecfg.phy_cfg.duplex);
+
+    parent->mac->ue_cfg(rnti, uecfg);
+  }
+}
+
+/**
+ * @brief Set DRB configuration
+ *
+ * The function adds the bearer to the local RLC and PDCP entities, with the RLC config of the cellGroupConfig common to
+ * all UEs, and sets the PDCP config in the radioBearerConfig of the UE.
+ *
+ * @return int SRSRAN_SUCCESS on success
+ */
+int rrc_nr::ue::add_drb()
+{
+  // RLC and MAC logical channel config for DRB1 (with fixed LCID) are part of the common cell_group_cfg
+  const auto& rlc_bearer = parent->base_cell_group_cfg.rlc_bearer_to_add_mod_list[0];
+
+  // add RLC bearer
+  srsran::rlc_config_t rlc_cfg;
+  if (srsran::make_rlc_config_t(rlc_bearer.rlc_cfg, &rlc_cfg) != SRSRAN_SUCCESS) {
+    parent->logger.error("Failed to build RLC config");
+    return SRSRAN_ERROR;
+  }
+  parent->rlc->add_bearer(rnti, drb1_lcid, rlc_cfg);
+  // TODO: add LC config to MAC
+
+  // PDCP config goes into radio_bearer_cfg
+  auto& radio_bearer_cfg_pack                       = radio_bearer_cfg;
+  radio_bearer_cfg_pack.drb_to_add_mod_list_present = true;
+  radio_bearer_cfg_pack.drb_to_add_mod_list.resize(1);
+
+  // configure fixed DRB1
+  auto& drb_item                                = radio_bearer_cfg_pack.drb_to_add_mod_list[0];
+  drb_item.drb_id                               = 1;
+  drb_item.cn_assoc_present                     = true;
+  drb_item.cn_assoc.set_eps_bearer_id()         = 5;
+  drb_item.pdcp_cfg_present                     = true;
+  drb_item.pdcp_cfg.ciphering_disabled_present  = true;
+  drb_item.pdcp_cfg.drb_present                 = true;
+  drb_item.pdcp_cfg.drb.pdcp_sn_size_dl_present = true;
+  drb_item.pdcp_cfg.drb.pdcp_sn_size_dl         = asn1::rrc_nr::pdcp_cfg_s::drb_s_::pdcp_sn_size_dl_opts::len18bits;
+  drb_item.pdcp_cfg.drb.pdcp_sn_size_ul_present = true;
+  drb_item.pdcp_cfg.drb.pdcp_sn_size_ul         = asn1::rrc_nr::pdcp_cfg_s::drb_s_::pdcp_sn_size_ul_opts::len18bits;
+  drb_item.pdcp_cfg.drb.discard_timer_present   = true;
+  drb_item.pdcp_cfg.drb.discard_timer           = asn1::rrc_nr::pdcp_cfg_s::drb_s_::discard_timer_opts::ms100;
+  drb_item.pdcp_cfg.drb.hdr_compress.set_not_used();
+  drb_item.pdcp_cfg.t_reordering_present = true;
+  drb_item.pdcp_cfg.t_reordering         = asn1::rrc_nr::pdcp_cfg_s::t_reordering_opts::ms0;
+
+  // Add DRB1 to PDCP
+  srsran::pdcp_config_t pdcp_cnfg = srsran::make_drb_pdcp_config_t(drb_item.drb_id, false, drb_item.pdcp_cfg);
+  parent->pdcp->add_bearer(rnti, rlc_bearer.lc_ch_id, pdcp_cnfg);
+
+  // Note: DRB1 is only activated in the MAC when the C-RNTI CE is received
+
+  return SRSRAN_SUCCESS;
+}
+
+/**
+ * @brief Deactivate all Bearers (MAC logical channel) for this specific RNTI
+ *
+ * The function iterates over the bearers or MAC logical channels and deactivates them by setting each one to IDLE
+ */
+void rrc_nr::ue::deactivate_bearers()
+{
+  // Iterate over the bearers (MAC LC CH) and set each of them to IDLE
+  for (auto& ue_bearer : uecfg.ue_bearers) {
+    ue_bearer.direction = mac_lc_ch_cfg_t::IDLE;
+  }
+
+  // No need to check the returned value, as the function ue_cfg will return SRSRAN_SUCCESS (it asserts if it fails)
+  parent->mac->ue_cfg(rnti, uecfg);
+}
+
+/*******************************************************************************
+  Secondary cell group config
+*******************************************************************************/
+
+int rrc_nr::fill_secondary_cell_group_cfg(uint16_t rnti, asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg)
+{
+  pack_secondary_cell_group_rlc_cfg(cell_group_cfg);
+  pack_secondary_cell_group_mac_cfg(cell_group_cfg);
+  pack_secondary_cell_group_sp_cell_cfg(cell_group_cfg);
+  cell_group_cfg.sp_cell_cfg.recfg_with_sync.new_ue_id = rnti;
+
+  return SRSRAN_SUCCESS;
+}
+
+/**
+ * @brief Fills and packs the secondary cell group config common to all the UEs of the cell
+ *
+ * The UEs only differ in the newUE-Identity of the reconfigurationWithSync, which UPER encodes as a 16 bit field at a
+ * fixed position. The config is packed with two different identities to find that position, so that the config of
+ * each UE is a copy of the packed config with its RNTI written in place.
+ */
+int rrc_nr::pack_base_cell_group_cfg()
+{
+  fill_secondary_cell_group_cfg(0, base_cell_group_cfg);
+
+  asn1::dyn_octstring packed_ones;
+  for (uint16_t new_ue_id : {0xffff, 0}) {
+    asn1::dyn_octstring& packed = new_ue_id == 0 ? base_cell_group_cfg_packed : packed_ones;
+
+    base_cell_group_cfg.sp_cell_cfg.recfg_with_sync.new_ue_id = new_ue_id;
+    packed.resize(256);
+    asn1::bit_ref bref_pack(packed.data(), packed.size());
+    if (base_cell_group_cfg.pack(bref_pack) != asn1::SRSASN_SUCCESS) {
+      logger.error("Failed to pack NR secondary cell config");
+      return SRSRAN_ERROR;
+    }
+    packed.resize(bref_pack.distance_bytes());
+  }
+
+  // All the 16 bits of the newUE-Identity differ between both encodings, find where they start
+  if (packed_ones.size() != base_cell_group_cfg_packed.size()) {
+    logger.error("The NR secondary cell config length depends on the newUE-Identity");
+    return SRSRAN_ERROR;
+  }
+  uint32_t i = 0;
+  while (i < packed_ones.size() and packed_ones[i] == base_cell_group_cfg_packed[i]) {
+    i++;
+  }
+  uint8_t diff      = i < packed_ones.size() ? packed_ones[i] ^ base_cell_group_cfg_packed[i] : 0;
+  new_ue_id_bit_pos = i * 8;
+  while (diff != 0 and (diff & 0x80U) == 0) {
+    diff <<= 1U;
+    new_ue_id_bit_pos++;
+  }
+  if (diff == 0 or new_ue_id_bit_pos + 16 > base_cell_group_cfg_packed.size() * 8) {
+    logger.error("Couldn't find the newUE-Identity in the packed NR secondary cell config");
+    return SRSRAN_ERROR;
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int rrc_nr::pack_secondary_cell_group_rlc_cfg(asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack)
 {
   // RLC for DRB1 (with fixed LCID)
   cell_group_cfg_pack.rlc_bearer_to_add_mod_list_present = true;
@@ -731,7 +1011,7 @@ int rrc_nr::ue::pack_secondary_cell_group_rlc_cfg(asn1::rrc_nr::cell_group_cfg_s
   return SRSRAN_SUCCESS;
 }
 
-int rrc_nr::ue::pack_secondary_cell_group_mac_cfg(asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack)
+int rrc_nr::pack_secondary_cell_group_mac_cfg(asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack)
 {
   // mac-CellGroup-Config for BSR and SR
   cell_group_cfg_pack.mac_cell_group_cfg_present                         = true;
@@ -766,7 +1046,7 @@ int rrc_nr::ue::pack_secondary_cell_group_mac_cfg(asn1::rrc_nr::cell_group_cfg_s
   return SRSRAN_SUCCESS;
 }
 
-int rrc_nr::ue::pack_sp_cell_cfg_ded_init_dl_bwp(asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack)
+int rrc_nr::pack_sp_cell_cfg_ded_init_dl_bwp(asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack)
 {
   cell_group_cfg_pack.sp_cell_cfg.sp_cell_cfg_ded.init_dl_bwp_present = true;
 
@@ -776,7 +1056,7 @@ int rrc_nr::ue::pack_sp_cell_cfg_ded_init_dl_bwp(asn1::rrc_nr::cell_group_cfg_s&
   return SRSRAN_SUCCESS;
 }
 
-int rrc_nr::ue::pack_sp_cell_cfg_ded_init_dl_bwp_radio_link_monitoring(
+int rrc_nr::pack_sp_cell_cfg_ded_init_dl_bwp_radio_link_monitoring(
     asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack)
 {
   cell_group_cfg_pack.sp_cell_cfg.sp_cell_cfg_ded.init_dl_bwp.radio_link_monitoring_cfg_present = true;
@@ -793,7 +1073,7 @@ int rrc_nr::ue::pack_sp_cell_cfg_ded_init_dl_bwp_radio_link_monitoring(
   return SRSRAN_SUCCESS;
 }
 
-int rrc_nr::ue::pack_sp_cell_cfg_ded_init_dl_bwp_pdsch_cfg(asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack)
+int rrc_nr::pack_sp_cell_cfg_ded_init_dl_bwp_pdsch_cfg(asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack)
 {
   cell_group_cfg_pack.sp_cell_cfg.sp_cell_cfg_ded.init_dl_bwp.pdsch_cfg_present = true;
   auto& pdsch_cfg_dedicated = cell_group_cfg_pack.sp_cell_cfg.sp_cell_cfg_ded.init_dl_bwp.pdsch_cfg;
@@ -845,7 +1125,7 @@ int rrc_nr::ue::pack_sp_cell_cfg_ded_init_dl_bwp_pdsch_cfg(asn1::rrc_nr::cell_gr
   return SRSRAN_SUCCESS;
 }
 
-int rrc_nr::ue::pack_sp_cell_cfg_ded_ul_cfg_init_ul_bwp_pucch_cfg(asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack)
+int rrc_nr::pack_sp_cell_cfg_ded_ul_cfg_init_ul_bwp_pucch_cfg(asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack)
 {
   // PUCCH
   cell_group_cfg_pack.sp_cell_cfg.sp_cell_cfg_ded.ul_cfg.init_ul_bwp.pucch_cfg_present = true;
@@ -871,7 +1151,7 @@ int rrc_nr::ue::pack_sp_cell_cfg_ded_ul_cfg_init_ul_bwp_pucch_cfg(asn1::rrc_nr::
   // DL data
   pucch_cfg.setup().dl_data_to_ul_ack_present = true;
 
-  if (parent->cfg.cell_list[0].duplex_mode == SRSRAN_DUPLEX_MODE_FDD) {
+  if (cfg.cell_list[0].duplex_mode == SRSRAN_DUPLEX_MODE_FDD) {
     pucch_cfg.setup().dl_data_to_ul_ack.resize(1);
     pucch_cfg.setup().dl_data_to_ul_ack[0] = 4;
   } else {
@@ -914,13 +1194,13 @@ int rrc_nr::ue::pack_sp_cell_cfg_ded_ul_cfg_init_ul_bwp_pucch_cfg(asn1::rrc_nr::
   pucch_cfg.setup().res_to_add_mod_list_present = true;
   pucch_cfg.setup().res_to_add_mod_list.resize(3);
   if (not srsran::make_phy_res_config(resource_small, pucch_cfg.setup().res_to_add_mod_list[0], 0)) {
-    parent->logger.warning("Failed to create 1-2 bit NR PUCCH resource");
+    logger.warning("Failed to create 1-2 bit NR PUCCH resource");
   }
   if (not srsran::make_phy_res_config(resource_big, pucch_cfg.setup().res_to_add_mod_list[1], 1)) {
-    parent->logger.warning("Failed to create >2 bit NR PUCCH resource");
+    logger.warning("Failed to create >2 bit NR PUCCH resource");
   }
   if (not srsran::make_phy_res_config(resource_sr, pucch_cfg.setup().res_to_add_mod_list[2], 2)) {
-    parent->logger.warning("Failed to create SR NR PUCCH resource");
+    logger.warning("Failed to create SR NR PUCCH resource");
   }
 
   // Make 2 PUCCH resource sets
@@ -944,7 +1224,7 @@ int rrc_nr::ue::pack_sp_cell_cfg_ded_ul_cfg_init_ul_bwp_pucch_cfg(asn1::rrc_nr::
   return SRSRAN_SUCCESS;
 }
 
-int rrc_nr::ue::pack_sp_cell_cfg_ded_ul_cfg_init_ul_bwp_pusch_cfg(asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack)
+int rrc_nr::pack_sp_cell_cfg_ded_ul_cfg_init_ul_bwp_pusch_cfg(asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack)
 {
   // PUSCH config
   cell_group_cfg_pack.sp_cell_cfg.sp_cell_cfg_ded.ul_cfg.init_ul_bwp.pusch_cfg_present = true;
@@ -983,7 +1263,7 @@ int rrc_nr::ue::pack_sp_cell_cfg_ded_ul_cfg_init_ul_bwp_pusch_cfg(asn1::rrc_nr::
   return SRSRAN_SUCCESS;
 }
 
-int rrc_nr::ue::pack_sp_cell_cfg_ded_ul_cfg_init_ul_bwp(asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack)
+int rrc_nr::pack_sp_cell_cfg_ded_ul_cfg_init_ul_bwp(asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack)
 {
   cell_group_cfg_pack.sp_cell_cfg.sp_cell_cfg_ded.ul_cfg.init_ul_bwp_present = true;
 
@@ -993,7 +1273,7 @@ int rrc_nr::ue::pack_sp_cell_cfg_ded_ul_cfg_init_ul_bwp(asn1::rrc_nr::cell_group
   return SRSRAN_SUCCESS;
 }
 
-int rrc_nr::ue::pack_sp_cell_cfg_ded_ul_cfg(asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack)
+int rrc_nr::pack_sp_cell_cfg_ded_ul_cfg(asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack)
 {
   // UL config dedicated
   cell_group_cfg_pack.sp_cell_cfg.sp_cell_cfg_ded.ul_cfg_present = true;
@@ -1006,7 +1286,7 @@ int rrc_nr::ue::pack_sp_cell_cfg_ded_ul_cfg(asn1::rrc_nr::cell_group_cfg_s& cell
   return SRSRAN_SUCCESS;
 }
 
-int rrc_nr::ue::pack_sp_cell_cfg_ded_pdcch_serving_cell_cfg(asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack)
+int rrc_nr::pack_sp_cell_cfg_ded_pdcch_serving_cell_cfg(asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack)
 {
   cell_group_cfg_pack.sp_cell_cfg.sp_cell_cfg_ded.pdcch_serving_cell_cfg_present = true;
   cell_group_cfg_pack.sp_cell_cfg.sp_cell_cfg_ded.pdcch_serving_cell_cfg.set_setup();
@@ -1021,13 +1301,13 @@ int rrc_nr::ue::pack_sp_cell_cfg_ded_pdcch_serving_cell_cfg(asn1::rrc_nr::cell_g
   return SRSRAN_SUCCESS;
 }
 
-int rrc_nr::ue::pack_sp_cell_cfg_ded(asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack)
+int rrc_nr::pack_sp_cell_cfg_ded(asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack)
 {
   // SP Cell Dedicated config
   cell_group_cfg_pack.sp_cell_cfg.sp_cell_cfg_ded_present                        = true;
   cell_group_cfg_pack.sp_cell_cfg.sp_cell_cfg_ded.first_active_dl_bwp_id_present = true;
 
-  if (parent->cfg.cell_list[0].duplex_mode == SRSRAN_DUPLEX_MODE_FDD) {
+  if (cfg.cell_list[0].duplex_mode == SRSRAN_DUPLEX_MODE_FDD) {
     cell_group_cfg_pack.sp_cell_cfg.sp_cell_cfg_ded.first_active_dl_bwp_id = 0;
   } else {
     cell_group_cfg_pack.sp_cell_cfg.sp_cell_cfg_ded.first_active_dl_bwp_id = 1;
@@ -1040,14 +1320,14 @@ int rrc_nr::ue::pack_sp_cell_cfg_ded(asn1::rrc_nr::cell_group_cfg_s& cell_group_
   pack_sp_cell_cfg_ded_pdcch_serving_cell_cfg(cell_group_cfg_pack);
 
   // spCellConfig
-  if (fill_sp_cell_cfg_from_enb_cfg(parent->cfg, UE_PSCELL_CC_IDX, cell_group_cfg_pack.sp_cell_cfg) != SRSRAN_SUCCESS) {
-    parent->logger.error("Failed to pack spCellConfig for rnti=0x%x", rnti);
+  if (fill_sp_cell_cfg_from_enb_cfg(cfg, UE_PSCELL_CC_IDX, cell_group_cfg_pack.sp_cell_cfg) != SRSRAN_SUCCESS) {
+    logger.error("Failed to pack spCellConfig");
   }
 
   return SRSRAN_SUCCESS;
 }
 
-int rrc_nr::ue::pack_recfg_with_sync_sp_cell_cfg_common_dl_cfg_common_phy_cell_group_cfg(
+int rrc_nr::pack_recfg_with_sync_sp_cell_cfg_common_dl_cfg_common_phy_cell_group_cfg(
     asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack)
 {
   cell_group_cfg_pack.phys_cell_group_cfg_present = true;
@@ -1057,7 +1337,7 @@ int rrc_nr::ue::pack_recfg_with_sync_sp_cell_cfg_common_dl_cfg_common_phy_cell_g
   return SRSRAN_SUCCESS;
 }
 
-int rrc_nr::ue::pack_recfg_with_sync_sp_cell_cfg_common_dl_cfg_init_dl_bwp_pdsch_cfg_common(
+int rrc_nr::pack_recfg_with_sync_sp_cell_cfg_common_dl_cfg_init_dl_bwp_pdsch_cfg_common(
     asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack)
 {
   // PDSCH config common
@@ -1076,7 +1356,7 @@ int rrc_nr::ue::pack_recfg_with_sync_sp_cell_cfg_common_dl_cfg_init_dl_bwp_pdsch
   return SRSRAN_SUCCESS;
 }
 
-int rrc_nr::ue::pack_recfg_with_sync_sp_cell_cfg_common_dl_cfg_init_dl_bwp(
+int rrc_nr::pack_recfg_with_sync_sp_cell_cfg_common_dl_cfg_init_dl_bwp(
     asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack)
 {
   cell_group_cfg_pack.sp_cell_cfg.recfg_with_sync.sp_cell_cfg_common.dl_cfg_common.init_dl_bwp_present = true;
@@ -1090,7 +1370,7 @@ int rrc_nr::ue::pack_recfg_with_sync_sp_cell_cfg_common_dl_cfg_init_dl_bwp(
   return SRSRAN_SUCCESS;
 }
 
-int rrc_nr::ue::pack_recfg_with_sync_sp_cell_cfg_common_dl_cfg_common(
+int rrc_nr::pack_recfg_with_sync_sp_cell_cfg_common_dl_cfg_common(
     asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack)
 {
   // DL config
@@ -1102,7 +1382,7 @@ int rrc_nr::ue::pack_recfg_with_sync_sp_cell_cfg_common_dl_cfg_common(
   return SRSRAN_SUCCESS;
 }
 
-int rrc_nr::ue::pack_recfg_with_sync_sp_cell_cfg_common_ul_cfg_common_init_ul_bwp_pusch_cfg_common(
+int rrc_nr::pack_recfg_with_sync_sp_cell_cfg_common_ul_cfg_common_init_ul_bwp_pusch_cfg_common(
     asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack)
 {
   // PUSCH config common
@@ -1139,7 +1419,7 @@ int rrc_nr::ue::pack_recfg_with_sync_sp_cell_cfg_common_ul_cfg_common_init_ul_bw
   return SRSRAN_SUCCESS;
 }
 
-int rrc_nr::ue::pack_recfg_with_sync_sp_cell_cfg_common_ul_cfg_common_init_ul_bwp(
+int rrc_nr::pack_recfg_with_sync_sp_cell_cfg_common_ul_cfg_common_init_ul_bwp(
     asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack)
 {
   cell_group_cfg_pack.sp_cell_cfg.recfg_with_sync.sp_cell_cfg_common.ul_cfg_common.init_ul_bwp_present = true;
@@ -1153,7 +1433,7 @@ int rrc_nr::ue::pack_recfg_with_sync_sp_cell_cfg_common_ul_cfg_common_init_ul_bw
   return SRSRAN_ERROR;
 }
 
-int rrc_nr::ue::pack_recfg_with_sync_sp_cell_cfg_common_ul_cfg_common(
+int rrc_nr::pack_recfg_with_sync_sp_cell_cfg_common_ul_cfg_common(
     asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack)
 {
   // UL config
@@ -1165,9 +1445,9 @@ int rrc_nr::ue::pack_recfg_with_sync_sp_cell_cfg_common_ul_cfg_common(
   return SRSRAN_SUCCESS;
 }
 
-int rrc_nr::ue::pack_recfg_with_sync_sp_cell_cfg_common(asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack)
+int rrc_nr::pack_recfg_with_sync_sp_cell_cfg_common(asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack)
 {
-  auto& pscell_cfg = parent->cfg.cell_list.at(UE_PSCELL_CC_IDX);
+  auto& pscell_cfg = cfg.cell_list.at(UE_PSCELL_CC_IDX);
 
   if (pscell_cfg.duplex_mode == SRSRAN_DUPLEX_MODE_TDD) {
     cell_group_cfg_pack.sp_cell_cfg.recfg_with_sync.smtc.release();
@@ -1182,13 +1462,13 @@ int rrc_nr::ue::pack_recfg_with_sync_sp_cell_cfg_common(asn1::rrc_nr::cell_group
   return SRSRAN_SUCCESS;
 }
 
-int rrc_nr::ue::pack_recfg_with_sync(asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack)
+int rrc_nr::pack_recfg_with_sync(asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack)
 {
   // Reconfig with Sync
   cell_group_cfg_pack.cell_group_id = 1; // 0 identifies the MCG. Other values identify SCGs.
 
   cell_group_cfg_pack.sp_cell_cfg.recfg_with_sync_present   = true;
-  cell_group_cfg_pack.sp_cell_cfg.recfg_with_sync.new_ue_id = rnti;
+  cell_group_cfg_pack.sp_cell_cfg.recfg_with_sync.new_ue_id = 0; // set per UE, see fill_secondary_cell_group_cfg()
   cell_group_cfg_pack.sp_cell_cfg.recfg_with_sync.t304      = recfg_with_sync_s::t304_opts::ms1000;
 
   pack_recfg_with_sync_sp_cell_cfg_common(cell_group_cfg_pack);
@@ -1196,7 +1476,7 @@ int rrc_nr::ue::pack_recfg_with_sync(asn1::rrc_nr::cell_group_cfg_s& cell_group_
   return SRSRAN_SUCCESS;
 }
 
-int rrc_nr::ue::pack_secondary_cell_group_sp_cell_cfg(asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack)
+int rrc_nr::pack_secondary_cell_group_sp_cell_cfg(asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack)
 {
   cell_group_cfg_pack.sp_cell_cfg_present               = true;
   cell_group_cfg_pack.sp_cell_cfg.serv_cell_idx_present = true;
@@ -1208,243 +1488,4 @@ int rrc_nr::ue::pack_secondary_cell_group_sp_cell_cfg(asn1::rrc_nr::cell_group_c
   return SRSRAN_SUCCESS;
 }
 
-// Helper for the RRC Reconfiguration sender to pack hard-coded config
-int rrc_nr::ue::pack_secondary_cell_group_cfg(asn1::dyn_octstring& packed_secondary_cell_config)
-{
-  auto& cell_group_cfg_pack = cell_group_cfg;
-
-  pack_secondary_cell_group_rlc_cfg(cell_group_cfg_pack);
-  pack_secondary_cell_group_mac_cfg(cell_group_cfg_pack);
-  pack_secondary_cell_group_sp_cell_cfg(cell_group_cfg_pack);
-
-  // make sufficiant space
-  packed_secondary_cell_config.resize(256);
-  asn1::bit_ref bref_pack(packed_secondary_cell_config.data(), packed_secondary_cell_config.size());
-  if (cell_group_cfg_pack.pack(bref_pack) != asn1::SRSASN_SUCCESS) {
-    parent->logger.error("Failed to pack NR secondary cell config");
-    return SRSRAN_ERROR;
-  }
-  packed_secondary_cell_config.resize(bref_pack.distance_bytes());
-
-  return SRSRAN_SUCCESS;
-}
-
-// Packs a hard-coded RRC Reconfiguration with fixed params for all layers (for now)
-int rrc_nr::ue::pack_rrc_reconfiguration(asn1::dyn_octstring& packed_rrc_reconfig)
-{
-  rrc_recfg_s reconfig;
-  reconfig.rrc_transaction_id = ((transaction_id++) % 4u);
-  rrc_recfg_ies_s& recfg_ies  = reconfig.crit_exts.set_rrc_recfg();
-
-  // add secondary cell group config
-  recfg_ies.secondary_cell_group_present = true;
-
-  if (pack_secondary_cell_group_cfg(recfg_ies.secondary_cell_group) == SRSRAN_ERROR) {
-    parent->logger.error("Failed to pack secondary cell group");
-    return SRSRAN_ERROR;
-  }
-
-  // now pack ..
-  packed_rrc_reconfig.resize(512);
-  asn1::bit_ref bref_pack(packed_rrc_reconfig.data(), packed_rrc_reconfig.size());
-  if (reconfig.pack(bref_pack) != asn1::SRSASN_SUCCESS) {
-    parent->logger.error("Failed to pack RRC Reconfiguration");
-    return SRSRAN_ERROR;
-  }
-  packed_rrc_reconfig.resize(bref_pack.distance_bytes());
-
-  return SRSRAN_SUCCESS;
-}
-
-// Packs a hard-coded NR radio bearer config with fixed params for RLC/PDCP (for now)
-int rrc_nr::ue::pack_nr_radio_bearer_config(asn1::dyn_octstring& packed_nr_bearer_config)
-{
-  // set security config
-  auto& radio_bearer_cfg_pack                        = radio_bearer_cfg;
-  radio_bearer_cfg_pack.security_cfg_present         = true;
-  auto& sec_cfg                                      = radio_bearer_cfg_pack.security_cfg;
-  sec_cfg.key_to_use_present                         = true;
-  sec_cfg.key_to_use                                 = asn1::rrc_nr::security_cfg_s::key_to_use_opts::secondary;
-  sec_cfg.security_algorithm_cfg_present             = true;
-  sec_cfg.security_algorithm_cfg.ciphering_algorithm = ciphering_algorithm_opts::nea0;
-  sec_cfg.security_algorithm_cfg.integrity_prot_algorithm_present = true;
-  sec_cfg.security_algorithm_cfg.integrity_prot_algorithm         = integrity_prot_algorithm_opts::nia0;
-
-  // pack it
-  packed_nr_bearer_config.resize(128);
-  asn1::bit_ref bref_pack(packed_nr_bearer_config.data(), packed_nr_bearer_config.size());
-  if (radio_bearer_cfg_pack.pack(bref_pack) != asn1::SRSASN_SUCCESS) {
-    parent->logger.error("Failed to pack NR radio bearer config");
-    return SRSRAN_ERROR;
-  }
-
-  // resize to packed length
-  packed_nr_bearer_config.resize(bref_pack.distance_bytes());
-
-  return SRSRAN_SUCCESS;
-}
-
-int rrc_nr::ue::handle_sgnb_addition_request(uint16_t eutra_rnti_, const sgnb_addition_req_params_t& req_params)
-{
-  // Add DRB1 to RLC and PDCP
-  if (add_drb() != SRSRAN_SUCCESS) {
-    parent->logger.error("Failed to configure DRB");
-    parent->rrc_eutra->sgnb_addition_reject(eutra_rnti_);
-    return SRSRAN_ERROR;
-  }
-
-  // provide hard-coded NR configs
-  rrc_eutra_interface_rrc_nr::sgnb_addition_ack_params_t ack_params = {};
-  if (pack_rrc_reconfiguration(ack_params.nr_secondary_cell_group_cfg_r15) == SRSRAN_ERROR) {
-    parent->logger.error("Failed to pack RRC Reconfiguration. Sending SgNB addition reject.");
-    parent->rrc_eutra->sgnb_addition_reject(eutra_rnti_);
-    return SRSRAN_ERROR;
-  }
-
-  if (pack_nr_radio_bearer_config(ack_params.nr_radio_bearer_cfg1_r15) == SRSRAN_ERROR) {
-    parent->logger.error("Failed to pack NR radio bearer config. Sending SgNB addition reject.");
-    parent->rrc_eutra->sgnb_addition_reject(eutra_rnti_);
-    return SRSRAN_ERROR;
-  }
-
-  // send response to EUTRA
-  ack_params.nr_rnti       = rnti;
-  ack_params.eps_bearer_id = req_params.eps_bearer_id;
-  parent->rrc_eutra->sgnb_addition_ack(eutra_rnti_, ack_params);
-
-  // recognize RNTI as ENDC user
-  endc       = true;
-  eutra_rnti = eutra_rnti_;
-
-  return SRSRAN_SUCCESS;
-}
-
-void rrc_nr::ue::crnti_ce_received()
-{
-  // Assume NSA mode active
-  if (endc) {
-    // send SgNB addition complete for ENDC users
-    parent->rrc_eutra->sgnb_addition_complete(eutra_rnti, rnti);
-
-    // stop RX MSG3/MSG5 activity timer on MAC CE RNTI reception
-    set_activity_timeout(UE_INACTIVITY_TIMEOUT);
-    parent->logger.debug("Received MAC CE-RNTI for 0x%x - stopping MSG3/MSG5 timer, starting inactivity timer", rnti);
-
-    // Add DRB1 to MAC
-    for (auto& drb : cell_group_cfg.rlc_bearer_to_add_mod_list) {
-      uecfg.ue_bearers[drb.lc_ch_id].direction = mac_lc_ch_cfg_t::BOTH;
-      uecfg.ue_bearers[drb.lc_ch_id].group     = drb.mac_lc_ch_cfg.ul_specific_params.lc_ch_group;
-    }
-
-    // Update UE phy params
-    srsran::make_pdsch_cfg_from_serv_cell(cell_group_cfg.sp_cell_cfg.sp_cell_cfg_ded, &uecfg.phy_cfg.pdsch);
-    srsran::make_csi_cfg_from_serv_cell(cell_group_cfg.sp_cell_cfg.sp_cell_cfg_ded, &uecfg.phy_cfg.csi);
-    srsran::make_phy_ssb_cfg(parent->cfg.cell_list[0].phy_cell.carrier,
-                             cell_group_cfg.sp_cell_cfg.recfg_with_sync.sp_cell_cfg_common,
-                             &uecfg.phy_cfg.ssb);
-    srsran::make_duplex_cfg_from_serv_cell(cell_group_cfg.sp_cell_cfg.recfg_with_sync.sp_cell_cfg_common,
-                                           &uecfg.phy_cfg.duplex);
-
-    parent->mac->ue_cfg(rnti, uecfg);
-  }
-}
-
-/**
- * @brief Set DRB configuration
- *
- * The function sets and configures all relavant fields for the DRB configuration (MAC, RLC, PDCP) in the
- * cellGroupConfig and also adds the bearer to the local RLC and PDCP entities.
- *
- * @return int SRSRAN_SUCCESS on success
- */
-int rrc_nr::ue::add_drb()
-{
-  // RLC for DRB1 (with fixed LCID) inside cell_group_cfg
-  auto& cell_group_cfg_pack = cell_group_cfg;
-
-  cell_group_cfg_pack.rlc_bearer_to_add_mod_list_present = true;
-  cell_group_cfg_pack.rlc_bearer_to_add_mod_list.resize(1);
-  auto& rlc_bearer                       = cell_group_cfg_pack.rlc_bearer_to_add_mod_list[0];
-  rlc_bearer.lc_ch_id                    = drb1_lcid;
-  rlc_bearer.served_radio_bearer_present = true;
-  rlc_bearer.served_radio_bearer.set_drb_id();
-  rlc_bearer.served_radio_bearer.drb_id() = 1;
-  rlc_bearer.rlc_cfg_present              = true;
-  rlc_bearer.rlc_cfg.set_um_bi_dir();
-  rlc_bearer.rlc_cfg.um_bi_dir().ul_um_rlc.sn_field_len_present = true;
-  rlc_bearer.rlc_cfg.um_bi_dir().ul_um_rlc.sn_field_len         = sn_field_len_um_opts::size12;
-  rlc_bearer.rlc_cfg.um_bi_dir().dl_um_rlc.sn_field_len_present = true;
-  rlc_bearer.rlc_cfg.um_bi_dir().dl_um_rlc.sn_field_len         = sn_field_len_um_opts::size12;
-  rlc_bearer.rlc_cfg.um_bi_dir().dl_um_rlc.t_reassembly         = t_reassembly_opts::ms50;
-
-  // add RLC bearer
-  srsran::rlc_config_t rlc_cfg;
-  if (srsran::make_rlc_config_t(cell_group_cfg.rlc_bearer_to_add_mod_list[0].rlc_cfg, &rlc_cfg) != SRSRAN_SUCCESS) {
-    parent->logger.error("Failed to build RLC config");
-    return SRSRAN_ERROR;
-  }
-  parent->rlc->add_bearer(rnti, drb1_lcid, rlc_cfg);
-
-  // MAC logical channel config
-  rlc_bearer.mac_lc_ch_cfg_present                    = true;
-  rlc_bearer.mac_lc_ch_cfg.ul_specific_params_present = true;
-  rlc_bearer.mac_lc_ch_cfg.ul_specific_params.prio    = 11;
-  rlc_bearer.mac_lc_ch_cfg.ul_specific_params.prioritised_bit_rate =
-      asn1::rrc_nr::lc_ch_cfg_s::ul_specific_params_s_::prioritised_bit_rate_opts::kbps0;
-  rlc_bearer.mac_lc_ch_cfg.ul_specific_params.bucket_size_dur =
-      asn1::rrc_nr::lc_ch_cfg_s::ul_specific_params_s_::bucket_size_dur_opts::ms100;
-  rlc_bearer.mac_lc_ch_cfg.ul_specific_params.lc_ch_group_present      = true;
-  rlc_bearer.mac_lc_ch_cfg.ul_specific_params.lc_ch_group              = 3;
-  rlc_bearer.mac_lc_ch_cfg.ul_specific_params.sched_request_id_present = true;
-  rlc_bearer.mac_lc_ch_cfg.ul_specific_params.sched_request_id         = 0;
-  // TODO: add LC config to MAC
-
-  // PDCP config goes into radio_bearer_cfg
-  auto& radio_bearer_cfg_pack                       = radio_bearer_cfg;
-  radio_bearer_cfg_pack.drb_to_add_mod_list_present = true;
-  radio_bearer_cfg_pack.drb_to_add_mod_list.resize(1);
-
-  // configure fixed DRB1
-  auto& drb_item                                = radio_bearer_cfg_pack.drb_to_add_mod_list[0];
-  drb_item.drb_id                               = 1;
-  drb_item.cn_assoc_present                     = true;
-  drb_item.cn_assoc.set_eps_bearer_id()         = 5;
-  drb_item.pdcp_cfg_present                     = true;
-  drb_item.pdcp_cfg.ciphering_disabled_present  = true;
-  drb_item.pdcp_cfg.drb_present                 = true;
-  drb_item.pdcp_cfg.drb.pdcp_sn_size_dl_present = true;
-  drb_item.pdcp_cfg.drb.pdcp_sn_size_dl         = asn1::rrc_nr::pdcp_cfg_s::drb_s_::pdcp_sn_size_dl_opts::len18bits;
-  drb_item.pdcp_cfg.drb.pdcp_sn_size_ul_present = true;
-  drb_item.pdcp_cfg.drb.pdcp_sn_size_ul         = asn1::rrc_nr::pdcp_cfg_s::drb_s_::pdcp_sn_size_ul_opts::len18bits;
-  drb_item.pdcp_cfg.drb.discard_timer_present   = true;
-  drb_item.pdcp_cfg.drb.discard_timer           = asn1::rrc_nr::pdcp_cfg_s::drb_s_::discard_timer_opts::ms100;
-  drb_item.pdcp_cfg.drb.hdr_compress.set_not_used();
-  drb_item.pdcp_cfg.t_reordering_present = true;
-  drb_item.pdcp_cfg.t_reordering         = asn1::rrc_nr::pdcp_cfg_s::t_reordering_opts::ms0;
-
-  // Add DRB1 to PDCP
-  srsran::pdcp_config_t pdcp_cnfg = srsran::make_drb_pdcp_config_t(drb_item.drb_id, false, drb_item.pdcp_cfg);
-  parent->pdcp->add_bearer(rnti, rlc_bearer.lc_ch_id, pdcp_cnfg);
-
-  // Note: DRB1 is only activated in the MAC when the C-RNTI CE is received
-
-  return SRSRAN_SUCCESS;
-}
-
-/**
- * @brief Deactivate all Bearers (MAC logical channel) for this specific RNTI
- *
- * The function iterates over the bearers or MAC logical channels and deactivates them by setting each one to IDLE
- */
-void rrc_nr::ue::deactivate_bearers()
-{
-  // Iterate over the bearers (MAC LC CH) and set each of them to IDLE
-  for (auto& ue_bearer : uecfg.ue_bearers) {
-    ue_bearer.direction = mac_lc_ch_cfg_t::IDLE;
-  }
-
-  // No need to check the returned value, as the function ue_cfg will return SRSRAN_SUCCESS (it asserts if it fails)
-  parent->mac->ue_cfg(rnti, uecfg);
-}
-
 } // namespace srsenb
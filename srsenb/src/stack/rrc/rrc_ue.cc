@@ -47,6 +47,7 @@ namespace srsenb {
 rrc::ue::ue(rrc* outer_rrc, uint16_t rnti_, const sched_interface::ue_cfg_t& sched_ue_cfg) :
   parent(outer_rrc),
   rnti(rnti_),
+  ul_dcch_queue(srsran::get_background_workers()),
   phy_rrc_dedicated_list(sched_ue_cfg.supported_cc_list.size()),
   ue_cell_list(parent->cfg, *outer_rrc->cell_res_list, *outer_rrc->cell_common_list),
   bearer_list(rnti_, parent->cfg, outer_rrc->gtpu),
@@ -112,6 +113,7 @@ void rrc::ue::get_metrics(rrc_ue_metrics_t& ue_metrics) const
   ue_metrics.state      = state;
   const auto& drb_list  = bearer_list.get_established_drbs();
   const auto& erab_list = bearer_list.get_erabs();
+  ue_metrics.drb_qci_map.clear();
   ue_metrics.drb_qci_map.reserve(drb_list.size());
   for (size_t i = 0; i < drb_list.size(); ++i) {
     auto erab_it = erab_list.find(drb_list[i].eps_bearer_id);
@@ -326,10 +328,72 @@ bool rrc::ue::is_idle()
 
 void rrc::ue::parse_ul_dcch(uint32_t lcid, srsran::unique_byte_buffer_t pdu)
 {
-  ul_dcch_msg_s  ul_dcch_msg;
-  asn1::cbit_ref bref(pdu->msg, pdu->N_bytes);
-  if (ul_dcch_msg.unpack(bref) != asn1::SRSASN_SUCCESS or
-      ul_dcch_msg.msg.type().value != ul_dcch_msg_type_c::types_opts::c1) {
+  if (not parent->cfg.parallel_ul_dcch) {
+    ul_dcch_rx_t rx;
+    rx.lcid = lcid;
+    rx.pdu  = std::move(pdu);
+    decode_ul_dcch(rx);
+    handle_ul_dcch(rx);
+    return;
+  }
+
+  std::unique_ptr<ul_dcch_rx_t> rx(new ul_dcch_rx_t{});
+  rx->lcid = lcid;
+  rx->pdu  = std::move(pdu);
+
+  // The message is decoded in a background worker and handled back in the stack thread, if the UE still exists
+  rrc*                rrc_ptr = parent;
+  uint16_t            rnti_   = rnti;
+  std::weak_ptr<void> token   = ul_dcch_queue.alive_token();
+  ul_dcch_queue.push_task(std::bind(
+      [rrc_ptr, rnti_, token](std::unique_ptr<ul_dcch_rx_t>& rx_) {
+        decode_ul_dcch(*rx_);
+        rrc_ptr->task_sched.notify_background_task_result(std::bind(
+            [rrc_ptr, rnti_, token](std::unique_ptr<ul_dcch_rx_t>& decoded) {
+              auto user_it = rrc_ptr->users.find(rnti_);
+              if (token.expired() or user_it == rrc_ptr->users.end()) {
+                rrc_ptr->log_rx_pdu_fail(rnti_, decoded->lcid, *decoded->pdu, "UE was removed");
+                return;
+              }
+              user_it->second->handle_ul_dcch(*decoded);
+            },
+            std::move(rx_)));
+      },
+      std::move(rx)));
+}
+
+void rrc::ue::decode_ul_dcch(ul_dcch_rx_t& rx)
+{
+  asn1::cbit_ref bref(rx.pdu->msg, rx.pdu->N_bytes);
+  rx.msg_valid =
+      rx.msg.unpack(bref) == asn1::SRSASN_SUCCESS and rx.msg.msg.type().value == ul_dcch_msg_type_c::types_opts::c1;
+  if (not rx.msg_valid or rx.msg.msg.c1().type().value != ul_dcch_msg_type_c::c1_c_::types::ue_cap_info) {
+    return;
+  }
+
+  // The EUTRA capabilities are carried in an octet string, which is the most expensive part to unpack
+  ue_cap_info_r8_ies_s& msg_r8 = rx.msg.msg.c1().ue_cap_info().crit_exts.c1().ue_cap_info_r8();
+  for (uint32_t i = 0; i < msg_r8.ue_cap_rat_container_list.size(); i++) {
+    if (msg_r8.ue_cap_rat_container_list[i].rat_type != rat_type_e::eutra) {
+      // Not handling UE capability information for RATs other than EUTRA
+      continue;
+    }
+    asn1::cbit_ref cap_bref(msg_r8.ue_cap_rat_container_list[i].ue_cap_rat_container.data(),
+                            msg_r8.ue_cap_rat_container_list[i].ue_cap_rat_container.size());
+    rx.eutra_cap_present = true;
+    rx.eutra_cap_valid   = rx.eutra_cap.unpack(cap_bref) == asn1::SRSASN_SUCCESS;
+    if (not rx.eutra_cap_valid) {
+      break;
+    }
+  }
+}
+
+void rrc::ue::handle_ul_dcch(ul_dcch_rx_t& rx)
+{
+  uint32_t                     lcid        = rx.lcid;
+  srsran::unique_byte_buffer_t pdu         = std::move(rx.pdu);
+  ul_dcch_msg_s&               ul_dcch_msg = rx.msg;
+  if (not rx.msg_valid) {
     parent->log_rx_pdu_fail(rnti, lcid, *pdu, "Failed to unpack UL-DCCH message");
     return;
   }
@@ -391,7 +455,7 @@ void rrc::ue::parse_ul_dcch(uint32_t lcid, srsran::unique_byte_buffer_t pdu)
       handle_security_mode_failure(&ul_dcch_msg.msg.c1().security_mode_fail());
       break;
     case ul_dcch_msg_type_c::c1_c_::types::ue_cap_info:
-      if (handle_ue_cap_info(&ul_dcch_msg.msg.c1().ue_cap_info()) == SRSRAN_SUCCESS) {
+      if (handle_ue_cap_info(rx) == SRSRAN_SUCCESS) {
         if (endc_handler != nullptr && endc_handler->is_endc_supported() && state == RRC_STATE_WAIT_FOR_UE_CAP_INFO) {
           // request EUTRA-NR and NR capabilities as well
           send_ue_cap_enquiry({asn1::rrc::rat_type_opts::options::eutra_nr, asn1::rrc::rat_type_opts::options::nr});
@@ -1049,22 +1113,18 @@ void rrc::ue::send_ue_cap_enquiry(const std::vector<asn1::rrc::rat_type_opts::op
  *
  * @return int SRSRAN_SUCCESS if unpacking was ok. SRSRAN_ERROR otherwise
  */
-int rrc::ue::handle_ue_cap_info(ue_cap_info_s* msg)
+int rrc::ue::handle_ue_cap_info(ul_dcch_rx_t& rx)
 {
+  ue_cap_info_s* msg = &rx.msg.msg.c1().ue_cap_info();
   parent->logger.info("UECapabilityInformation transaction ID: %d", msg->rrc_transaction_id);
-  ue_cap_info_r8_ies_s* msg_r8 = &msg->crit_exts.c1().ue_cap_info_r8();
 
-  for (uint32_t i = 0; i < msg_r8->ue_cap_rat_container_list.size(); i++) {
-    if (msg_r8->ue_cap_rat_container_list[i].rat_type != rat_type_e::eutra) {
-      // Not handling UE capability information for RATs other than EUTRA
-      continue;
-    }
-    asn1::cbit_ref bref(msg_r8->ue_cap_rat_container_list[i].ue_cap_rat_container.data(),
-                        msg_r8->ue_cap_rat_container_list[i].ue_cap_rat_container.size());
-    if (eutra_capabilities.unpack(bref) != asn1::SRSASN_SUCCESS) {
+  // The EUTRA capabilities were unpacked with the message
+  if (rx.eutra_cap_present) {
+    if (not rx.eutra_cap_valid) {
       parent->logger.error("Failed to unpack EUTRA capabilities message");
       return SRSRAN_ERROR;
     }
+    eutra_capabilities = std::move(rx.eutra_cap);
     if (parent->logger.debug.enabled()) {
       asn1::json_writer js{};
       eutra_capabilities.to_json(js);
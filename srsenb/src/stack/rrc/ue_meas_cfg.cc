@@ -375,9 +375,11 @@ bool fill_meascfg_enb_cfg(meas_cfg_s& meascfg, const ue_cell_ded_list& ue_cell_l
   return set_meascfg_presence_flags(meascfg);
 }
 
-bool compute_diff_meascfg(const meas_cfg_s& current_meascfg, const meas_cfg_s& target_meascfg, meas_cfg_s& diff_meascfg)
+/// Computes the difference of all the measConfig fields except measGaps
+void compute_diff_meascfg_lists(const meas_cfg_s& current_meascfg,
+                                const meas_cfg_s& target_meascfg,
+                                meas_cfg_s&       diff_meascfg)
 {
-  diff_meascfg = {};
   compute_diff_meas_objs(current_meascfg, target_meascfg, diff_meascfg);
   compute_diff_report_cfgs(current_meascfg, target_meascfg, diff_meascfg);
   compute_diff_meas_ids(current_meascfg, target_meascfg, diff_meascfg);
@@ -385,6 +387,12 @@ bool compute_diff_meascfg(const meas_cfg_s& current_meascfg, const meas_cfg_s& t
       (target_meascfg.quant_cfg_present and target_meascfg.quant_cfg != current_meascfg.quant_cfg)) {
     diff_meascfg.quant_cfg = target_meascfg.quant_cfg;
   }
+}
+
+bool compute_diff_meascfg(const meas_cfg_s& current_meascfg, const meas_cfg_s& target_meascfg, meas_cfg_s& diff_meascfg)
+{
+  diff_meascfg = {};
+  compute_diff_meascfg_lists(current_meascfg, target_meascfg, diff_meascfg);
 
   // Only update measGap if it was not set before or periodicity changed
   if (current_meascfg.meas_gap_cfg.type().value == setup_opts::setup) {
@@ -401,31 +409,23 @@ bool compute_diff_meascfg(const meas_cfg_s& current_meascfg, const meas_cfg_s& t
   return set_meascfg_presence_flags(diff_meascfg);
 }
 
-bool apply_meascfg_updates(meas_cfg_s&             meascfg,
-                           meas_cfg_s&             current_meascfg,
-                           const ue_cell_ded_list& ue_cell_list,
-                           int                     prev_earfcn,
-                           int                     prev_pci)
+/**
+ * Apply TS 36.331 5.5.6.1 - If Source and Target eNB EARFCNs do no match, update SourceMeasCfg.MeasIdList
+ * @return true if the measIds of current_meascfg were modified
+ */
+bool apply_meas_id_swap(meas_cfg_s& current_meascfg, uint32_t target_earfcn, int prev_earfcn)
 {
-  meascfg = {};
-
-  const ue_cell_ded* pcell         = ue_cell_list.get_ue_cc_idx(UE_PCELL_CC_IDX);
-  uint32_t           target_earfcn = pcell->get_dl_earfcn();
-
-  if (static_cast<uint32_t>(prev_pci) == pcell->get_pci() and static_cast<uint32_t>(prev_earfcn) == target_earfcn) {
-    // Shortcut: No PCell change -> no measConfig updates
-    return false;
-  }
-
-  // Apply TS 36.331 5.5.6.1 - If Source and Target eNB EARFCNs do no match, update SourceMeasCfg.MeasIdList
+  bool modified = false;
   if ((uint32_t)prev_earfcn != target_earfcn) {
     meas_obj_t* found_target_obj = find_meas_obj(current_meascfg.meas_obj_to_add_mod_list, target_earfcn);
     meas_obj_t* found_src_obj    = prev_earfcn != 0 ? &current_meascfg.meas_obj_to_add_mod_list[0] : nullptr;
     if (found_target_obj != nullptr and found_src_obj != nullptr) {
       for (auto& mid : current_meascfg.meas_id_to_add_mod_list) {
         if (found_target_obj->meas_obj_id == mid.meas_obj_id) {
+          modified |= mid.meas_obj_id != found_src_obj->meas_obj_id;
           mid.meas_obj_id = found_src_obj->meas_obj_id;
         } else if (found_src_obj->meas_obj_id == mid.meas_obj_id) {
+          modified |= mid.meas_obj_id != found_target_obj->meas_obj_id;
           mid.meas_obj_id = found_target_obj->meas_obj_id;
         }
       }
@@ -435,25 +435,40 @@ bool apply_meascfg_updates(meas_cfg_s&             meascfg,
         if (it->meas_obj_id == found_src_obj->meas_obj_id) {
           auto rit = it++;
           current_meascfg.meas_id_to_add_mod_list.erase(rit);
+          modified = true;
         } else {
           ++it;
         }
       }
     }
   }
+  return modified;
+}
+
+bool apply_meascfg_updates(meas_cfg_s&             meascfg,
+                           meas_cfg_s&             current_meascfg,
+                           const ue_cell_ded_list& ue_cell_list,
+                           int                     prev_earfcn,
+                           int                     prev_pci)
+{
+  meascfg = {};
+
+  const ue_cell_ded* pcell         = ue_cell_list.get_ue_cc_idx(UE_PCELL_CC_IDX);
+  uint32_t           target_earfcn = pcell->get_dl_earfcn();
+
+  if (static_cast<uint32_t>(prev_pci) == pcell->get_pci() and static_cast<uint32_t>(prev_earfcn) == target_earfcn) {
+    // Shortcut: No PCell change -> no measConfig updates
+    return false;
+  }
+
+  apply_meas_id_swap(current_meascfg, target_earfcn, prev_earfcn);
 
   // Generate final measConfig
   meas_cfg_s target_meascfg;
   fill_meascfg_enb_cfg(target_meascfg, ue_cell_list);
 
   // Set a MeasConfig in the RRC Connection Reconfiguration for HO.
-  compute_diff_meas_objs(current_meascfg, target_meascfg, meascfg);
-  compute_diff_report_cfgs(current_meascfg, target_meascfg, meascfg);
-  compute_diff_meas_ids(current_meascfg, target_meascfg, meascfg);
-  if (target_meascfg.quant_cfg_present != current_meascfg.quant_cfg_present or
-      (target_meascfg.quant_cfg_present and target_meascfg.quant_cfg != current_meascfg.quant_cfg)) {
-    meascfg.quant_cfg = target_meascfg.quant_cfg;
-  }
+  compute_diff_meascfg_lists(current_meascfg, target_meascfg, meascfg);
 
   // Set measGaps if changed
   meascfg.meas_gap_cfg_present =
@@ -466,4 +481,98 @@ bool apply_meascfg_updates(meas_cfg_s&             meascfg,
   return ret;
 }
 
+/***********************************
+ *        measConfig cache
+ **********************************/
+
+meas_cfg_cache::meas_cfg_cache()
+{
+  // The empty measConfig of a UE before its first reconfiguration
+  cfgs.emplace_back(new meas_cfg_s{});
+}
+
+uint32_t meas_cfg_cache::get_cfg_id(const ue_cell_ded_list& ue_cell_list)
+{
+  // The PCell defines the neighbour cells and reports, the SCells only add carriers
+  std::vector<uint32_t> key(ue_cell_list.nof_cells());
+  for (uint32_t ue_cc_idx = 0; ue_cc_idx < ue_cell_list.nof_cells(); ++ue_cc_idx) {
+    key[ue_cc_idx] = ue_cell_list.get_ue_cc_idx(ue_cc_idx)->cell_common->enb_cc_idx;
+  }
+  std::sort(key.begin() + 1, key.end());
+
+  auto it = cfg_ids.find(key);
+  if (it != cfg_ids.end()) {
+    return it->second;
+  }
+
+  std::unique_ptr<meas_cfg_s> cfg(new meas_cfg_s{});
+  fill_meascfg_enb_cfg(*cfg, ue_cell_list);
+  cfg->meas_gap_cfg = {};
+  set_meascfg_presence_flags(*cfg);
+
+  uint32_t cfg_id = cfgs.size();
+  cfgs.push_back(std::move(cfg));
+  cfg_ids.emplace(std::move(key), cfg_id);
+  return cfg_id;
+}
+
+const meas_cfg_s& meas_cfg_cache::get_diff(uint32_t src_cfg_id, uint32_t target_cfg_id)
+{
+  auto key = std::make_pair(src_cfg_id, target_cfg_id);
+  auto it  = diffs.find(key);
+  if (it == diffs.end()) {
+    meas_cfg_s diff{};
+    compute_diff_meascfg_lists(get_cfg(src_cfg_id), get_cfg(target_cfg_id), diff);
+    set_meascfg_presence_flags(diff);
+    it = diffs.emplace(key, std::move(diff)).first;
+  }
+  return it->second;
+}
+
+bool apply_meascfg_updates(meas_cfg_s&             meascfg,
+                           meas_cfg_s&             current_meascfg,
+                           uint32_t&               current_cfg_id,
+                           const ue_cell_ded_list& ue_cell_list,
+                           meas_cfg_cache&         cache,
+                           int                     prev_earfcn,
+                           int                     prev_pci)
+{
+  meascfg = {};
+
+  const ue_cell_ded* pcell         = ue_cell_list.get_ue_cc_idx(UE_PCELL_CC_IDX);
+  uint32_t           target_earfcn = pcell->get_dl_earfcn();
+
+  if (static_cast<uint32_t>(prev_pci) == pcell->get_pci() and static_cast<uint32_t>(prev_earfcn) == target_earfcn) {
+    // Shortcut: No PCell change -> no measConfig updates
+    return false;
+  }
+
+  if (apply_meas_id_swap(current_meascfg, target_earfcn, prev_earfcn)) {
+    // The current measConfig no longer matches the cached one
+    current_cfg_id = meas_cfg_cache::invalid_cfg_id;
+  }
+
+  uint32_t          target_cfg_id  = cache.get_cfg_id(ue_cell_list);
+  const meas_cfg_s& target_meascfg = cache.get_cfg(target_cfg_id);
+  if (current_cfg_id != meas_cfg_cache::invalid_cfg_id) {
+    meascfg = cache.get_diff(current_cfg_id, target_cfg_id);
+  } else {
+    compute_diff_meascfg_lists(current_meascfg, target_meascfg, meascfg);
+  }
+
+  // The measGaps depend on the UE
+  meas_gap_cfg_c target_gaps = make_measgap(target_meascfg.meas_obj_to_add_mod_list, *pcell);
+  meascfg.meas_gap_cfg_present =
+      apply_meas_gap_updates(current_meascfg.meas_gap_cfg, target_gaps, meascfg.meas_gap_cfg);
+
+  // Update current measconfig
+  bool ret                     = set_meascfg_presence_flags(meascfg);
+  current_meascfg              = target_meascfg;
+  current_meascfg.meas_gap_cfg = target_gaps;
+  set_meascfg_presence_flags(current_meascfg);
+  current_cfg_id = target_cfg_id;
+
+  return ret;
+}
+
 } // namespace srsenb
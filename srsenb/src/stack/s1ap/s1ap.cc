@@ -355,6 +355,11 @@ void s1ap::get_metrics(s1ap_metrics_t& m)
   }
 }
 
+size_t s1ap::get_mem_footprint() const
+{
+  return users.size() * sizeof(ue);
+}
+
 // Generate common S1AP protocol IEs from config args
 void s1ap::build_tai_cgi()
 {
@@ -452,7 +457,7 @@ void s1ap::user_mod(uint16_t old_rnti, uint16_t new_rnti)
     logger.error("New rnti already exists, aborting.");
     return;
   }
-  users.find_ue_rnti(old_rnti)->ctxt.rnti = new_rnti;
+  users.set_rnti(users.find_ue_rnti(old_rnti), new_rnti);
 }
 
 void s1ap::ue_ctxt_setup_complete(uint16_t rnti)
@@ -1198,7 +1203,10 @@ bool s1ap::send_ho_req_ack(const asn1::s1ap::ho_request_s&                msg,
     logger.error("The MME-S1AP-UE-ID=%ld is not valid", msg.protocol_ies.mme_ue_s1ap_id.value.value);
     return false;
   }
-  ue_ptr->ctxt.rnti       = rnti;
+  if (not users.set_rnti(ue_ptr, rnti)) {
+    logger.error("The rnti=0x%x is already in use", rnti);
+    return false;
+  }
   ue_ptr->ctxt.enb_cc_idx = enb_cc_idx;
 
   container.mme_ue_s1ap_id.value = msg.protocol_ies.mme_ue_s1ap_id.value.value;
@@ -1815,70 +1823,6 @@ bool s1ap::send_enb_status_transfer_proc(uint16_t rnti, std::vector<bearer_statu
   return u->send_enb_status_transfer_proc(bearer_status_list);
 }
 
-/*********************************************************
- *              s1ap::user_list class
- *********************************************************/
-
-s1ap::ue* s1ap::user_list::find_ue_rnti(uint16_t rnti)
-{
-  if (rnti == SRSRAN_INVALID_RNTI) {
-    return nullptr;
-  }
-  auto it = std::find_if(
-      users.begin(), users.end(), [rnti](const user_list::pair_type& v) { return v.second->ctxt.rnti == rnti; });
-  return it != users.end() ? it->second.get() : nullptr;
-}
-
-s1ap::ue* s1ap::user_list::find_ue_enbid(uint32_t enbid)
-{
-  auto it = users.find(enbid);
-  return (it != users.end()) ? it->second.get() : nullptr;
-}
-
-s1ap::ue* s1ap::user_list::find_ue_mmeid(uint32_t mmeid)
-{
-  auto it = std::find_if(users.begin(), users.end(), [mmeid](const user_list::pair_type& v) {
-    return v.second->ctxt.mme_ue_s1ap_id == mmeid;
-  });
-  return it != users.end() ? it->second.get() : nullptr;
-}
-
-/**
- * @brief Adds a user to the user list, avoiding any rnti, enb_s1ap_id, mme_s1ap_id duplication
- * @param %user to be inserted
- * @return ptr of inserted %user. If failure, returns nullptr
- */
-s1ap::ue* s1ap::user_list::add_user(std::unique_ptr<s1ap::ue> user)
-{
-  static srslog::basic_logger& logger = srslog::fetch_basic_logger("S1AP");
-  // Check for ID repetitions
-  if (find_ue_rnti(user->ctxt.rnti) != nullptr) {
-    logger.error("The user to be added with rnti=0x%x already exists", user->ctxt.rnti);
-    return nullptr;
-  }
-  if (find_ue_enbid(user->ctxt.enb_ue_s1ap_id) != nullptr) {
-    logger.error("The user to be added with enb id=%d already exists", user->ctxt.enb_ue_s1ap_id);
-    return nullptr;
-  }
-  if (user->ctxt.mme_ue_s1ap_id.has_value() and find_ue_mmeid(user->ctxt.mme_ue_s1ap_id.value()) != nullptr) {
-    logger.error("The user to be added with mme id=%d already exists", user->ctxt.mme_ue_s1ap_id.value());
-    return nullptr;
-  }
-  auto p = users.insert(std::make_pair(user->ctxt.enb_ue_s1ap_id, std::move(user)));
-  return p.second ? p.first->second.get() : nullptr;
-}
-
-void s1ap::user_list::erase(ue* ue_ptr)
-{
-  static srslog::basic_logger& logger = srslog::fetch_basic_logger("S1AP");
-  auto                         it     = users.find(ue_ptr->ctxt.enb_ue_s1ap_id);
-  if (it == users.end()) {
-    logger.error("User to be erased does not exist");
-    return;
-  }
-  users.erase(it);
-}
-
 /*******************************************************************************
 /* General helpers
 ********************************************************************************/
@@ -1967,7 +1911,7 @@ s1ap::ue* s1ap::handle_s1apmsg_ue_id(uint32_t enb_id, uint32_t mme_id)
     user_mme_ptr = users.find_ue_mmeid(mme_id);
     if (not user_ptr->ctxt.mme_ue_s1ap_id.has_value() and user_mme_ptr == nullptr) {
       // First "returned message", no inconsistency found (see 36.413, Section 10.6)
-      user_ptr->ctxt.mme_ue_s1ap_id = mme_id;
+      users.set_mme_ue_s1ap_id(user_ptr, mme_id);
       return user_ptr;
     }
 
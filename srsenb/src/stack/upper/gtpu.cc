@@ -367,7 +367,7 @@ gtpu::gtpu(srsran::task_sched_handle   task_sched_,
   tunnels(task_sched_, logger),
   rx_socket_handler(rx_socket_handler_)
 {
-  gtpu_queue = task_sched.make_task_queue();
+  gtpu_queue = task_sched.make_task_queue(srsran::task_priority::bulk);
 }
 
 gtpu::~gtpu()
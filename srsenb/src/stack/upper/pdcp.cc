@@ -24,6 +24,8 @@
 #include "srsran/interfaces/enb_gtpu_interfaces.h"
 #include "srsran/interfaces/enb_rlc_interfaces.h"
 #include "srsran/interfaces/enb_rrc_interfaces.h"
+#include <algorithm>
+#include <numeric>
 
 namespace srsenb {
 
@@ -276,4 +278,35 @@ void pdcp::get_metrics(pdcp_metrics_t& m, const uint32_t nof_tti)
   }
 }
 
+void pdcp::get_metrics(pdcp_metrics_t& m, const uint32_t nof_tti, const std::vector<uint16_t>& rntis)
+{
+  m.ues.assign(rntis.size(), {});
+
+  // Walk the requested RNTIs in increasing order along the users, which the map keeps sorted by RNTI
+  std::vector<uint32_t> order(rntis.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&rntis](uint32_t a, uint32_t b) { return rntis[a] < rntis[b]; });
+  auto next = order.begin();
+  for (auto& user : users) {
+    while (next != order.end() and rntis[*next] < user.first) {
+      ++next;
+    }
+    if (next != order.end() and rntis[*next] == user.first) {
+      user.second.pdcp->get_metrics(m.ues[*next], nof_tti);
+      ++next;
+    } else {
+      user.second.pdcp->reset_metrics();
+    }
+  }
+}
+
+size_t pdcp::get_mem_footprint()
+{
+  size_t bytes = 0;
+  for (auto& user : users) {
+    bytes += sizeof(user_interface) + user.second.pdcp->get_mem_footprint();
+  }
+  return bytes;
+}
+
 } // namespace srsenb
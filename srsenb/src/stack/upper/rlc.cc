@@ -24,6 +24,8 @@
 #include "srsran/interfaces/enb_mac_interfaces.h"
 #include "srsran/interfaces/enb_pdcp_interfaces.h"
 #include "srsran/interfaces/enb_rrc_interfaces.h"
+#include <algorithm>
+#include <numeric>
 
 namespace srsenb {
 
@@ -61,6 +63,39 @@ void rlc::get_metrics(rlc_metrics_t& m, const uint32_t nof_tti)
   }
 }
 
+void rlc::get_metrics(rlc_metrics_t& m, const uint32_t nof_tti, const std::vector<uint16_t>& rntis)
+{
+  m.ues.assign(rntis.size(), {});
+
+  // Walk the requested RNTIs in increasing order along the users, which the map keeps sorted by RNTI
+  std::vector<uint32_t> order(rntis.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&rntis](uint32_t a, uint32_t b) { return rntis[a] < rntis[b]; });
+  auto next = order.begin();
+  for (auto& user : users) {
+    while (next != order.end() and rntis[*next] < user.first) {
+      ++next;
+    }
+    if (next != order.end() and rntis[*next] == user.first) {
+      user.second.rlc->get_metrics(m.ues[*next], nof_tti);
+      ++next;
+    } else {
+      user.second.rlc->reset_metrics();
+    }
+  }
+}
+
+size_t rlc::get_mem_footprint()
+{
+  pthread_rwlock_rdlock(&rwlock);
+  size_t bytes = 0;
+  for (auto& user : users) {
+    bytes += sizeof(user_interface) + user.second.rlc->get_mem_footprint();
+  }
+  pthread_rwlock_unlock(&rwlock);
+  return bytes;
+}
+
 void rlc::add_user(uint16_t rnti)
 {
   pthread_rwlock_wrlock(&rwlock);
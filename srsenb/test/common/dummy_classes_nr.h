@@ -22,6 +22,7 @@
 #ifndef SRSRAN_DUMMY_NR_CLASSES_H
 #define SRSRAN_DUMMY_NR_CLASSES_H
 
+#include "srsran/interfaces/enb_x2_interfaces.h"
 #include "srsran/interfaces/gnb_interfaces.h"
 #include "srsran/interfaces/gnb_mac_interfaces.h"
 
@@ -49,13 +50,14 @@ class mac_nr_dummy : public mac_interface_rrc_nr
 {
 public:
   int cell_cfg(const std::vector<srsenb::sched_nr_interface::cell_cfg_t>& nr_cells) override { return SRSRAN_SUCCESS; }
-  uint16_t reserve_rnti(uint32_t enb_cc_idx, const sched_nr_ue_cfg_t& uecfg) override { return 0x4601; }
+  uint16_t reserve_rnti(uint32_t enb_cc_idx, const sched_nr_ue_cfg_t& uecfg) override { return next_rnti++; }
 
   int ue_cfg(uint16_t rnti, const sched_nr_interface::ue_cfg_t& ue_cfg) override { return SRSRAN_SUCCESS; }
 
   int remove_ue(uint16_t rnti) override { return SRSRAN_SUCCESS; }
 
   srsenb::sched_interface::cell_cfg_t cellcfgobj;
+  uint16_t                            next_rnti = 0x4601;
 };
 
 class phy_nr_dummy : public phy_interface_stack_nr
@@ -64,6 +66,26 @@ public:
   int set_common_cfg(const phy_interface_rrc_nr::common_cfg_t& common_cfg_) override { return SRSRAN_SUCCESS; }
 };
 
+class rrc_eutra_dummy : public rrc_eutra_interface_rrc_nr
+{
+public:
+  void sgnb_addition_ack(uint16_t eutra_rnti, sgnb_addition_ack_params_t params) override
+  {
+    nof_acks++;
+    last_ack = std::move(params);
+  }
+  void sgnb_addition_reject(uint16_t eutra_rnti) override { nof_rejects++; }
+  void sgnb_addition_complete(uint16_t eutra_rnti, uint16_t nr_rnti) override {}
+  void sgnb_inactivity_timeout(uint16_t eutra_rnti) override {}
+  void sgnb_release_ack(uint16_t eutra_rnti) override { nof_releases++; }
+  void set_activity_user(uint16_t eutra_rnti) override {}
+
+  uint32_t                   nof_acks     = 0;
+  uint32_t                   nof_rejects  = 0;
+  uint32_t                   nof_releases = 0;
+  sgnb_addition_ack_params_t last_ack;
+};
+
 } // namespace srsenb
 
 #endif // SRSRAN_DUMMY_NR_CLASSES_H
@@ -22,6 +22,7 @@
 #include "srsenb/hdr/metrics_csv.h"
 #include "srsenb/hdr/metrics_stdout.h"
 #include "srsran/common/metrics_hub.h"
+#include "srsran/common/test_common.h"
 #include "srsran/interfaces/enb_metrics_interface.h"
 #include "srsran/srsran.h"
 #include <iostream>
@@ -66,6 +67,13 @@ public:
     metrics[0].phy[0].ul.mcs  = 20.2;
     metrics[0].phy[0].ul.pucch_sinr = 14.2;
     metrics[0].phy[0].ul.pusch_sinr = 14.2;
+    metrics[0].phy_stages.resize((uint32_t)phy_stage_t::nof_stages);
+    metrics[0].phy_stages[(uint32_t)phy_stage_t::fft].count         = 1000;
+    metrics[0].phy_stages[(uint32_t)phy_stage_t::fft].avg_us        = 45.3;
+    metrics[0].phy_stages[(uint32_t)phy_stage_t::fft].p99_us        = 48.0;
+    metrics[0].phy_stages[(uint32_t)phy_stage_t::fft].max_us        = 80.1;
+    metrics[0].phy_stages[(uint32_t)phy_stage_t::fft].histogram[27] = 995; ///< [44, 48) us
+    metrics[0].phy_stages[(uint32_t)phy_stage_t::fft].histogram[32] = 5;   ///< [64, 72) us
 
     metrics[0].rf.rf_o = 10;
     metrics[0].nr_stack.mac.ues.resize(1);
@@ -193,6 +201,33 @@ void parse_args(int argc, char** argv)
   }
 }
 
+int test_reported_ue_selection()
+{
+  mac_metrics_t mac;
+  mac.ues.resize(6);
+  for (uint32_t i = 0; i < mac.ues.size(); ++i) {
+    // UE 1 and 4 are idle
+    mac.ues[i].tx_pkts  = (i == 1 or i == 4) ? 0 : 10;
+    mac.ues[i].tx_brate = (i == 1 or i == 4) ? 0 : 100 * (i + 1);
+  }
+
+  // All UEs are reported without a limit, also the ones without traffic
+  std::vector<uint32_t> idxs = mac_select_reported_ues(mac, mac.ues.size(), 0);
+  TESTASSERT(idxs.size() == mac.ues.size());
+  idxs = mac_select_reported_ues(mac, 3, 0);
+  TESTASSERT(idxs.size() == 3);
+
+  // Only active UEs are reported
+  idxs = mac_select_reported_ues(mac, mac.ues.size(), 10);
+  TESTASSERT((idxs == std::vector<uint32_t>{0, 2, 3, 5}));
+
+  // The UEs with the highest bit rate are reported, in index order
+  idxs = mac_select_reported_ues(mac, mac.ues.size(), 2);
+  TESTASSERT((idxs == std::vector<uint32_t>{3, 5}));
+
+  return SRSRAN_SUCCESS;
+}
+
 int main(int argc, char** argv)
 {
   float     period = 1.0;
@@ -205,6 +240,8 @@ int main(int argc, char** argv)
 
   parse_args(argc, argv);
 
+  TESTASSERT(test_reported_ue_selection() == SRSRAN_SUCCESS);
+
   // the default metrics type for stdout output
   metrics_stdout metrics_screen;
   metrics_screen.set_handle(&enb);
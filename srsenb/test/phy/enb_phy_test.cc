@@ -1173,6 +1173,7 @@ public:
     std::string           log_level           = "none";
     uint32_t              tm_u32              = 1;
     uint32_t              period_pcell_rotate = 0;
+    uint32_t              nof_task_threads    = 0;
     srsran_tm_t           tm                  = SRSRAN_TM1;
     bool                  extended_cp         = false;
     args_t()
@@ -1244,6 +1245,9 @@ public:
     phy_args.log.phy_level   = args.log_level;
     phy_args.nof_phy_threads = 1; ///< Set number of phy threads to 1 for avoiding concurrency issues
 
+    // The carriers of a TTI run in parallel if there are task threads
+    phy_args.nof_phy_task_threads = args.nof_task_threads;
+
     // Create cell configuration
     phy_cfg.phy_cell_cfg.resize(args.nof_enb_cells);
     for (uint32_t i = 0; i < args.nof_enb_cells; i++) {
@@ -1462,6 +1466,7 @@ int parse_args(int argc, char** argv, phy_test_bench::args_t& args)
       ("cell.cp",        bpo::value<bool>(&args.extended_cp)->default_value(false),                      "use extended CP")
       ("tm", bpo::value<uint32_t>(&args.tm_u32)->default_value(args.tm_u32),                             "Transmission mode")
       ("rotation", bpo::value<uint32_t>(&args.period_pcell_rotate),                      "Serving cells rotation period in ms, set to zero to disable")
+      ("task_threads", bpo::value<uint32_t>(&args.nof_task_threads),                      "Number of threads running the carriers as tasks, set to zero to disable")
       ;
   options.add(common).add_options()("help", "Show this message");
   // clang-format on
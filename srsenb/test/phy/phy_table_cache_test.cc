@@ -0,0 +1,163 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/phy/phy_table_cache.h"
+#include "srsran/common/test_common.h"
+#include <cinttypes>
+#include <cstdio>
+#include <stdlib.h>
+#include <unistd.h>
+
+namespace {
+
+const char*    table_name   = "test_table";
+const uint32_t table_format = 3;
+const uint64_t table_key    = 0x0123456789abcdefULL;
+
+std::string table_path(const std::string& dir)
+{
+  char key_str[17];
+  snprintf(key_str, sizeof(key_str), "%016" PRIx64, table_key);
+  return dir + "/" + table_name + "_" + key_str + ".bin";
+}
+
+/// Overwrites len bytes of the file at the given offset
+bool patch_file(const std::string& path, long offset, const void* data, size_t len)
+{
+  FILE* f = fopen(path.c_str(), "r+b");
+  if (f == nullptr) {
+    return false;
+  }
+  bool ok = fseek(f, offset, SEEK_SET) == 0 and fwrite(data, 1, len, f) == len;
+  return (fclose(f) == 0) and ok;
+}
+
+bool truncate_file(const std::string& path, long len)
+{
+  return truncate(path.c_str(), len) == 0;
+}
+
+int test_disabled_cache()
+{
+  srsenb::phy_table_cache cache("", srslog::fetch_basic_logger("PHY"));
+  std::vector<uint8_t>    table(16, 1);
+
+  TESTASSERT(not cache.enabled());
+  TESTASSERT(not cache.store(table_name, table_format, table_key, table));
+  TESTASSERT(not cache.load(table_name, table_format, table_key, table.size(), table));
+  return SRSRAN_SUCCESS;
+}
+
+int test_store_load(const std::string& dir)
+{
+  srsenb::phy_table_cache cache(dir, srslog::fetch_basic_logger("PHY"));
+  std::vector<uint8_t>    table(1000);
+  for (size_t i = 0; i < table.size(); i++) {
+    table[i] = (uint8_t)(i * 7);
+  }
+
+  // Not cached yet
+  std::vector<uint8_t> loaded;
+  TESTASSERT(not cache.load(table_name, table_format, table_key, table.size(), loaded));
+
+  TESTASSERT(cache.store(table_name, table_format, table_key, table));
+  TESTASSERT(cache.load(table_name, table_format, table_key, table.size(), loaded));
+  TESTASSERT(loaded == table);
+
+  // Other configurations, lengths and formats are not loaded
+  TESTASSERT(not cache.load(table_name, table_format, table_key + 1, table.size(), loaded));
+  TESTASSERT(not cache.load(table_name, table_format + 1, table_key, table.size(), loaded));
+  TESTASSERT(not cache.load(table_name, table_format, table_key, table.size() + 1, loaded));
+  TESTASSERT(loaded.empty());
+
+  unlink(table_path(dir).c_str());
+  return SRSRAN_SUCCESS;
+}
+
+int test_invalid_files(const std::string& dir)
+{
+  srsenb::phy_table_cache cache(dir, srslog::fetch_basic_logger("PHY"));
+  std::vector<uint8_t>    table(1000, 0x5a);
+  std::vector<uint8_t>    loaded;
+  std::string             path = table_path(dir);
+
+  // Corrupted contents fail the checksum
+  TESTASSERT(cache.store(table_name, table_format, table_key, table));
+  uint8_t byte = 0xa5;
+  TESTASSERT(patch_file(path, 100, &byte, sizeof(byte)));
+  TESTASSERT(not cache.load(table_name, table_format, table_key, table.size(), loaded));
+
+  // Partially written file
+  TESTASSERT(cache.store(table_name, table_format, table_key, table));
+  TESTASSERT(truncate_file(path, 500));
+  TESTASSERT(not cache.load(table_name, table_format, table_key, table.size(), loaded));
+
+  // Header shorter than expected
+  TESTASSERT(truncate_file(path, 8));
+  TESTASSERT(not cache.load(table_name, table_format, table_key, table.size(), loaded));
+
+  // A length in the header that does not match the file is rejected before allocating the table. The length follows
+  // the magic, the version and the key.
+  TESTASSERT(cache.store(table_name, table_format, table_key, table));
+  uint64_t len = UINT64_C(1) << 60U;
+  TESTASSERT(patch_file(path, 16, &len, sizeof(len)));
+  TESTASSERT(not cache.load(table_name, table_format, table_key, table.size(), loaded));
+  TESTASSERT(not cache.load(table_name, table_format, table_key, len, loaded));
+  TESTASSERT(loaded.empty());
+
+  // A file of a build with an older file layout is rejected, the version follows the magic
+  TESTASSERT(cache.store(table_name, table_format, table_key, table));
+  uint32_t version = 1;
+  TESTASSERT(patch_file(path, 4, &version, sizeof(version)));
+  TESTASSERT(not cache.load(table_name, table_format, table_key, table.size(), loaded));
+
+  // The table is regenerated and stored again
+  TESTASSERT(cache.store(table_name, table_format, table_key, table));
+  TESTASSERT(cache.load(table_name, table_format, table_key, table.size(), loaded));
+  TESTASSERT(loaded == table);
+
+  unlink(path.c_str());
+  return SRSRAN_SUCCESS;
+}
+
+} // namespace
+
+int main()
+{
+  srslog::init();
+
+  char dir_template[] = "/tmp/phy_table_cache_test_XXXXXX";
+  TESTASSERT(mkdtemp(dir_template) != nullptr);
+  std::string dir = dir_template;
+
+  int ret = SRSRAN_SUCCESS;
+  if (test_disabled_cache() != SRSRAN_SUCCESS or test_store_load(dir) != SRSRAN_SUCCESS or
+      test_invalid_files(dir) != SRSRAN_SUCCESS) {
+    ret = SRSRAN_ERROR;
+  }
+  rmdir(dir.c_str());
+
+  srslog::flush();
+  if (ret == SRSRAN_SUCCESS) {
+    printf("Success\n");
+  }
+  return ret;
+}
@@ -331,6 +331,84 @@ int test_minimize_meascfg_reordering()
   return SRSRAN_SUCCESS;
 }
 
+bool is_same_meascfg(const meas_cfg_s& lhs, const meas_cfg_s& rhs)
+{
+  uint8_t       buf1[1024], buf2[1024];
+  asn1::bit_ref bref1(buf1, sizeof(buf1)), bref2(buf2, sizeof(buf2));
+  if (lhs.pack(bref1) != asn1::SRSASN_SUCCESS or rhs.pack(bref2) != asn1::SRSASN_SUCCESS) {
+    return false;
+  }
+  return bref1.distance_bytes() == bref2.distance_bytes() and memcmp(buf1, buf2, bref1.distance_bytes()) == 0;
+}
+
+int test_meascfg_cache()
+{
+  rrc_cfg_t          cfg;
+  srsenb::all_args_t all_args;
+  TESTASSERT(test_helpers::parse_default_cfg(&cfg, all_args) == SRSRAN_SUCCESS);
+  cfg.enb_id           = 0x19B;
+  cfg.cell.nof_prb     = 6;
+  cfg.meas_cfg_present = true;
+  cfg.cell_list.resize(2);
+  cfg.cell_list[0].dl_earfcn = 2850;
+  cfg.cell_list[0].cell_id   = 0x01;
+  cfg.cell_list[0].scell_list.resize(1);
+  cfg.cell_list[0].scell_list[0].cell_id = 0x02;
+  cfg.cell_list[0].meas_cfg.meas_cells.resize(1);
+  cfg.cell_list[0].meas_cfg.meas_cells[0]     = generate_cell1();
+  cfg.cell_list[0].meas_cfg.meas_cells[0].pci = 3;
+  cfg.cell_list[1].dl_earfcn                  = 3400;
+  cfg.cell_list[1].cell_id                    = 0x02;
+  cfg.cell_list[0].meas_cfg.meas_reports.resize(1);
+  cfg.cell_list[0].meas_cfg.meas_reports[0] = generate_rep1();
+  cfg.cell_list[1].meas_cfg.meas_reports.resize(1);
+  cfg.cell_list[1].meas_cfg.meas_reports[0] = generate_rep1();
+
+  enb_cell_common_list cell_list{cfg};
+  freq_res_common_list freq_res{cfg};
+  ue_cell_ded_list     ue1_cells{cfg, freq_res, cell_list}, ue2_cells{cfg, freq_res, cell_list},
+      ref_cells{cfg, freq_res, cell_list};
+  meas_cfg_cache cache;
+  TESTASSERT(cache.nof_cfgs() == 1);
+
+  meas_cfg_s diff1, diff2, ref_diff, cur1{}, cur2{}, ref_cur{};
+  uint32_t   id1 = meas_cfg_cache::empty_cfg_id, id2 = meas_cfg_cache::empty_cfg_id;
+
+  // TEST: UEs with the same cells share the measConfig and the diff. The results match the uncached computation
+  ue1_cells.set_cells({0});
+  ue2_cells.set_cells({0});
+  ref_cells.set_cells({0});
+  TESTASSERT(apply_meascfg_updates(diff1, cur1, id1, ue1_cells, cache));
+  TESTASSERT(apply_meascfg_updates(diff2, cur2, id2, ue2_cells, cache));
+  TESTASSERT(apply_meascfg_updates(ref_diff, ref_cur, ref_cells));
+  TESTASSERT(id1 == id2 and id1 != meas_cfg_cache::empty_cfg_id and id1 != meas_cfg_cache::invalid_cfg_id);
+  TESTASSERT(cache.nof_cfgs() == 2 and cache.nof_diffs() == 1);
+  TESTASSERT(is_same_meascfg(diff1, ref_diff) and is_same_meascfg(diff2, ref_diff));
+  TESTASSERT(is_same_meascfg(cur1, ref_cur) and is_same_meascfg(cur2, ref_cur));
+
+  // TEST: Adding the SCell without a PCell change reuses the diff computed for the first UE
+  ue1_cells.set_cells({0, 1});
+  ue2_cells.set_cells({0, 1});
+  ref_cells.set_cells({0, 1});
+  bool ret1 = apply_meascfg_updates(diff1, cur1, id1, ue1_cells, cache);
+  bool ret2 = apply_meascfg_updates(diff2, cur2, id2, ue2_cells, cache);
+  TESTASSERT(apply_meascfg_updates(ref_diff, ref_cur, ref_cells) == ret1 and ret1 == ret2);
+  TESTASSERT(id1 == id2 and cache.nof_cfgs() == 3 and cache.nof_diffs() == 2);
+  TESTASSERT(is_same_meascfg(diff1, ref_diff) and is_same_meascfg(diff2, ref_diff));
+  TESTASSERT(is_same_meascfg(cur1, ref_cur));
+
+  // TEST: Inter-frequency handover swaps the measIds, the diff is computed for the UE
+  uint32_t src_earfcn = cell_list.get_cc_idx(0)->cell_cfg.dl_earfcn, src_pci = cell_list.get_cc_idx(0)->cell_cfg.pci;
+  ue1_cells.set_cells({1});
+  ref_cells.set_cells({1});
+  TESTASSERT(apply_meascfg_updates(diff1, cur1, id1, ue1_cells, cache, src_earfcn, src_pci));
+  TESTASSERT(apply_meascfg_updates(ref_diff, ref_cur, ref_cells, src_earfcn, src_pci));
+  TESTASSERT(id1 != meas_cfg_cache::invalid_cfg_id and cache.nof_cfgs() == 4);
+  TESTASSERT(is_same_meascfg(diff1, ref_diff) and is_same_meascfg(cur1, ref_cur));
+
+  return SRSRAN_SUCCESS;
+}
+
 } // namespace srsenb
 
 int main(int argc, char** argv)
@@ -348,6 +426,7 @@ int main(int argc, char** argv)
   TESTASSERT(test_correct_meascfg_insertion() == 0);
   TESTASSERT(test_correct_meascfg_calculation() == 0);
   TESTASSERT(test_minimize_meascfg_reordering() == 0);
+  TESTASSERT(test_meascfg_cache() == 0);
 
   srslog::flush();
 
@@ -26,6 +26,7 @@
 #include "srsenb/test/rrc/test_helpers.h"
 #include "srsran/common/test_common.h"
 #include "srsran/interfaces/gnb_rrc_nr_interfaces.h"
+#include <chrono>
 #include <iostream>
 
 using namespace asn1::rrc_nr;
@@ -109,6 +110,140 @@ int test_rrc_setup()
   return SRSRAN_SUCCESS;
 }
 
+/*
+ * Test 3 - SgNB addition secondary cell group config
+ * Description: Add NR carriers through the SgNB addition procedure and check that the secondary cell group config of
+ * each UE, patched with its RNTI, is the same as the config filled and packed for that UE
+ */
+int test_sgnb_addition()
+{
+  srsran::task_scheduler task_sched;
+
+  phy_nr_dummy    phy_obj;
+  mac_nr_dummy    mac_obj;
+  rlc_dummy       rlc_obj;
+  pdcp_dummy      pdcp_obj;
+  rrc_eutra_dummy rrc_eutra_obj;
+  rrc_nr          rrc_obj(&task_sched);
+
+  // set cfg
+  all_args_t   args{};
+  phy_cfg_t    phy_cfg{};
+  rrc_nr_cfg_t rrc_cfg_nr = rrc_obj.update_default_cfg(rrc_nr_cfg_t{});
+  rrc_cfg_nr.cell_list.emplace_back();
+  rrc_cfg_nr.cell_list[0].phy_cell.carrier.pci = 500;
+  rrc_cfg_nr.cell_list[0].dl_arfcn             = 634240;
+  rrc_cfg_nr.cell_list[0].band                 = 78;
+  args.enb.n_prb                               = 50;
+  enb_conf_sections::set_derived_args_nr(&args, &rrc_cfg_nr, &phy_cfg);
+  TESTASSERT(rrc_obj.init(rrc_cfg_nr, &phy_obj, &mac_obj, &rlc_obj, &pdcp_obj, nullptr, nullptr, &rrc_eutra_obj) ==
+             SRSRAN_SUCCESS);
+
+  rrc_nr_interface_rrc::sgnb_addition_req_params_t params{};
+  params.eps_bearer_id = 5;
+
+  // Between them, the RNTIs set every bit of the newUE-Identity. They map to different entries of the user table
+  const uint16_t nr_rntis[] = {0x0001, 0x4602, 0x5555, 0xaaaa, 0x7fff, 0x8000, 0xffef};
+  for (uint32_t i = 0; i < sizeof(nr_rntis) / sizeof(nr_rntis[0]); ++i) {
+    mac_obj.next_rnti = nr_rntis[i];
+    rrc_obj.sgnb_addition_request(0x46 + i, params);
+    TESTASSERT(rrc_eutra_obj.last_ack.nr_rnti == nr_rntis[i]);
+
+    rrc_recfg_s    recfg;
+    asn1::cbit_ref bref(rrc_eutra_obj.last_ack.nr_secondary_cell_group_cfg_r15.data(),
+                        rrc_eutra_obj.last_ack.nr_secondary_cell_group_cfg_r15.size());
+    TESTASSERT(recfg.unpack(bref) == asn1::SRSASN_SUCCESS);
+    TESTASSERT(recfg.crit_exts.type().value == rrc_recfg_s::crit_exts_c_::types_opts::rrc_recfg);
+    TESTASSERT(recfg.crit_exts.rrc_recfg().secondary_cell_group_present);
+    const asn1::dyn_octstring& packed_cell_group = recfg.crit_exts.rrc_recfg().secondary_cell_group;
+
+    cell_group_cfg_s cell_group;
+    asn1::cbit_ref   bref2(packed_cell_group.data(), packed_cell_group.size());
+    TESTASSERT(cell_group.unpack(bref2) == asn1::SRSASN_SUCCESS);
+    TESTASSERT(cell_group.sp_cell_cfg.recfg_with_sync_present);
+    TESTASSERT(cell_group.sp_cell_cfg.recfg_with_sync.new_ue_id == nr_rntis[i]);
+    TESTASSERT(cell_group.rlc_bearer_to_add_mod_list.size() == 1);
+
+    // Fill the whole config of this UE and pack it, it shall give the same bytes
+    cell_group_cfg_s ue_cell_group;
+    TESTASSERT(rrc_obj.fill_secondary_cell_group_cfg(nr_rntis[i], ue_cell_group) == SRSRAN_SUCCESS);
+    asn1::dyn_octstring ue_packed(packed_cell_group.size() + 1);
+    asn1::bit_ref       bref3(ue_packed.data(), ue_packed.size());
+    TESTASSERT(ue_cell_group.pack(bref3) == asn1::SRSASN_SUCCESS);
+    TESTASSERT((uint32_t)bref3.distance_bytes() == packed_cell_group.size());
+    TESTASSERT(memcmp(ue_packed.data(), packed_cell_group.data(), packed_cell_group.size()) == 0);
+  }
+  TESTASSERT(rrc_eutra_obj.nof_acks == sizeof(nr_rntis) / sizeof(nr_rntis[0]));
+  TESTASSERT(rrc_eutra_obj.nof_rejects == 0);
+
+  return SRSRAN_SUCCESS;
+}
+
+/*
+ * Test 4 - EN-DC attach rate
+ * Description: Add NR carriers for many UEs through the SgNB addition procedure and report the time per UE
+ */
+int test_sgnb_addition_rate(uint32_t nof_ues)
+{
+  srsran::task_scheduler task_sched;
+
+  phy_nr_dummy    phy_obj;
+  mac_nr_dummy    mac_obj;
+  rlc_dummy       rlc_obj;
+  pdcp_dummy      pdcp_obj;
+  rrc_eutra_dummy rrc_eutra_obj;
+  rrc_nr          rrc_obj(&task_sched);
+
+  // set cfg
+  all_args_t   args{};
+  phy_cfg_t    phy_cfg{};
+  rrc_nr_cfg_t rrc_cfg_nr = rrc_obj.update_default_cfg(rrc_nr_cfg_t{});
+  rrc_cfg_nr.cell_list.emplace_back();
+  rrc_cfg_nr.cell_list[0].phy_cell.carrier.pci = 500;
+  rrc_cfg_nr.cell_list[0].dl_arfcn             = 634240;
+  rrc_cfg_nr.cell_list[0].band                 = 78;
+  args.enb.n_prb                               = 50;
+  enb_conf_sections::set_derived_args_nr(&args, &rrc_cfg_nr, &phy_cfg);
+  TESTASSERT(rrc_obj.init(rrc_cfg_nr, &phy_obj, &mac_obj, &rlc_obj, &pdcp_obj, nullptr, nullptr, &rrc_eutra_obj) ==
+             SRSRAN_SUCCESS);
+
+  rrc_nr_interface_rrc::sgnb_addition_req_params_t params{};
+  params.eps_bearer_id = 5;
+
+  // Measure the procedure rather than the logging
+  srslog::fetch_basic_logger("RRC-NR").set_level(srslog::basic_levels::warning);
+
+  // The UEs attach and detach in rounds, as the RRC holds up to SRSENB_MAX_UES UEs. Only the attach is timed
+  const uint32_t                      ues_per_round = SRSENB_MAX_UES / 2;
+  std::vector<uint16_t>               nr_rntis;
+  std::chrono::steady_clock::duration attach_time{};
+  for (uint32_t i = 0; i < nof_ues; i += ues_per_round) {
+    uint32_t nof_round_ues = std::min(ues_per_round, nof_ues - i);
+    nr_rntis.clear();
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (uint32_t j = 0; j < nof_round_ues; ++j) {
+      rrc_obj.sgnb_addition_request(0x46 + j, params);
+      nr_rntis.push_back(rrc_eutra_obj.last_ack.nr_rnti);
+    }
+    attach_time += std::chrono::steady_clock::now() - t0;
+
+    for (uint16_t nr_rnti : nr_rntis) {
+      TESTASSERT(nr_rnti != SRSRAN_INVALID_RNTI);
+      rrc_obj.sgnb_release_request(nr_rnti);
+    }
+  }
+  TESTASSERT(rrc_eutra_obj.nof_acks == nof_ues);
+  TESTASSERT(rrc_eutra_obj.nof_rejects == 0);
+  TESTASSERT(rrc_eutra_obj.nof_releases == nof_ues);
+
+  printf("%d UEs: SgNB addition=%.1f us per UE\n",
+         nof_ues,
+         std::chrono::duration_cast<std::chrono::nanoseconds>(attach_time).count() / 1000.0 / nof_ues);
+
+  return SRSRAN_SUCCESS;
+}
+
 } // namespace srsenb
 
 int main(int argc, char** argv)
@@ -127,6 +262,8 @@ int main(int argc, char** argv)
   // FIXME: disabled temporarily until SIB generation is fixed
   // TESTASSERT(srsenb::test_sib_generation() == SRSRAN_SUCCESS);
   TESTASSERT(srsenb::test_rrc_setup() == SRSRAN_SUCCESS);
+  TESTASSERT(srsenb::test_sgnb_addition() == SRSRAN_SUCCESS);
+  TESTASSERT(srsenb::test_sgnb_addition_rate(1000) == SRSRAN_SUCCESS);
 
   return SRSRAN_SUCCESS;
 }
@@ -0,0 +1,167 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/stack/s1ap/s1ap_ue_registry.h"
+#include "srsran/common/test_common.h"
+#include <algorithm>
+#include <chrono>
+#include <random>
+
+using namespace srsenb;
+
+struct dummy_ue {
+  explicit dummy_ue(uint32_t enb_id, uint16_t rnti = SRSRAN_INVALID_RNTI)
+  {
+    ctxt.enb_ue_s1ap_id = enb_id;
+    ctxt.rnti           = rnti;
+  }
+  ue_ctxt_t ctxt;
+};
+
+using registry_t = s1ap_ue_registry<dummy_ue>;
+
+int test_registry_indexes()
+{
+  registry_t users;
+
+  dummy_ue* u1 = users.add_user(std::unique_ptr<dummy_ue>(new dummy_ue{1, 0x46}));
+  dummy_ue* u2 = users.add_user(std::unique_ptr<dummy_ue>(new dummy_ue{2, 0x47}));
+  TESTASSERT(u1 != nullptr and u2 != nullptr);
+  TESTASSERT(users.size() == 2);
+  TESTASSERT(users.find_ue_rnti(0x46) == u1);
+  TESTASSERT(users.find_ue_enbid(2) == u2);
+  TESTASSERT(users.find_ue_rnti(SRSRAN_INVALID_RNTI) == nullptr);
+
+  // TEST: duplicated RNTI, eNB-UE-S1AP-ID or MME-UE-S1AP-ID are rejected
+  TESTASSERT(users.add_user(std::unique_ptr<dummy_ue>(new dummy_ue{3, 0x46})) == nullptr);
+  TESTASSERT(users.add_user(std::unique_ptr<dummy_ue>(new dummy_ue{1, 0x48})) == nullptr);
+  TESTASSERT(users.set_mme_ue_s1ap_id(u1, 10));
+  std::unique_ptr<dummy_ue> dup(new dummy_ue{3, 0x48});
+  dup->ctxt.mme_ue_s1ap_id = 10;
+  TESTASSERT(users.add_user(std::move(dup)) == nullptr);
+  TESTASSERT(users.size() == 2);
+
+  // TEST: MME-UE-S1AP-ID is indexed once it is known, and cannot be taken by another user
+  TESTASSERT(users.find_ue_mmeid(10) == u1);
+  TESTASSERT(not users.set_mme_ue_s1ap_id(u2, 10));
+  TESTASSERT(users.set_mme_ue_s1ap_id(u2, 11));
+  TESTASSERT(users.find_ue_mmeid(11) == u2);
+
+  // TEST: RNTI change on re-establishment, the old RNTI is not found anymore
+  TESTASSERT(not users.set_rnti(u1, 0x47));
+  TESTASSERT(users.set_rnti(u1, 0x50));
+  TESTASSERT(users.find_ue_rnti(0x46) == nullptr);
+  TESTASSERT(users.find_ue_rnti(0x50) == u1);
+  TESTASSERT(users.find_ue_mmeid(10) == u1);
+
+  // TEST: handover target, the user is created by MME-UE-S1AP-ID and gets its RNTI later
+  std::unique_ptr<dummy_ue> ho_ue(new dummy_ue{3});
+  ho_ue->ctxt.mme_ue_s1ap_id = 12;
+  dummy_ue* u3               = users.add_user(std::move(ho_ue));
+  TESTASSERT(u3 != nullptr);
+  TESTASSERT(users.find_ue_mmeid(12) == u3);
+  TESTASSERT(users.set_rnti(u3, 0x46));
+  TESTASSERT(users.find_ue_rnti(0x46) == u3);
+
+  // TEST: erasing a user clears all its indexes
+  users.erase(u1);
+  TESTASSERT(users.size() == 2);
+  TESTASSERT(users.find_ue_rnti(0x50) == nullptr);
+  TESTASSERT(users.find_ue_mmeid(10) == nullptr);
+  TESTASSERT(users.find_ue_enbid(1) == nullptr);
+  TESTASSERT(users.find_ue_rnti(0x47) == u2);
+
+  return SRSRAN_SUCCESS;
+}
+
+int run_benchmark(uint32_t nof_users, uint32_t nof_lookups)
+{
+  registry_t            users;
+  std::vector<uint16_t> rntis;
+  for (uint32_t i = 0; i < nof_users; i++) {
+    uint16_t                  rnti = 0x46 + i;
+    std::unique_ptr<dummy_ue> u(new dummy_ue{i, rnti});
+    u->ctxt.mme_ue_s1ap_id = 1000 + i;
+    TESTASSERT(users.add_user(std::move(u)) != nullptr);
+    rntis.push_back(rnti);
+  }
+
+  std::mt19937          rand_gen(0);
+  std::vector<uint32_t> idxs(nof_lookups);
+  for (uint32_t& idx : idxs) {
+    idx = rand_gen() % nof_users;
+  }
+
+  // Lookups by each of the keys, as done by the UL NAS transport, the MME initiated procedures and the releases
+  uint32_t found = 0;
+  auto     t0    = std::chrono::steady_clock::now();
+  for (uint32_t idx : idxs) {
+    found += users.find_ue_rnti(rntis[idx]) != nullptr;
+  }
+  auto t1 = std::chrono::steady_clock::now();
+  for (uint32_t idx : idxs) {
+    found += users.find_ue_mmeid(1000 + idx) != nullptr;
+  }
+  auto t2 = std::chrono::steady_clock::now();
+  for (uint32_t idx : idxs) {
+    found += users.find_ue_enbid(idx) != nullptr;
+  }
+  auto t3 = std::chrono::steady_clock::now();
+  TESTASSERT(found == 3 * nof_lookups);
+
+  // Reference: scan of the whole registry, as done by a registry without secondary indexes
+  uint32_t nof_scans = std::max(nof_lookups / 100, 1U);
+  for (uint32_t n = 0; n < nof_scans; n++) {
+    uint16_t rnti = rntis[idxs[n]];
+    auto     it   = std::find_if(users.begin(), users.end(), [rnti](const registry_t::pair_type& v) {
+      return v.second->ctxt.rnti == rnti;
+    });
+    found += it != users.end();
+  }
+  auto t4 = std::chrono::steady_clock::now();
+  TESTASSERT(found == 3 * nof_lookups + nof_scans);
+
+  auto ns_per_op = [](std::chrono::steady_clock::duration d, uint32_t n) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(d).count() / (double)n;
+  };
+  printf("%d users: rnti=%.1f ns, mme_id=%.1f ns, enb_id=%.1f ns per lookup, full scan=%.1f ns\n",
+         nof_users,
+         ns_per_op(t1 - t0, nof_lookups),
+         ns_per_op(t2 - t1, nof_lookups),
+         ns_per_op(t3 - t2, nof_lookups),
+         ns_per_op(t4 - t3, nof_scans));
+
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  srslog::fetch_basic_logger("S1AP").set_level(srslog::basic_levels::info);
+  srslog::init();
+
+  TESTASSERT(test_registry_indexes() == SRSRAN_SUCCESS);
+  for (uint32_t nof_users : {100, 1000, 5000}) {
+    TESTASSERT(run_benchmark(nof_users, 100000) == SRSRAN_SUCCESS);
+  }
+
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
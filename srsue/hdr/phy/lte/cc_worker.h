@@ -42,6 +42,7 @@ public:
 
   void  set_tti(uint32_t tti);
   void  set_cfo_nolock(float cfo);
+  void  set_dl_cfo_nolock(float cfo);
   float get_ref_cfo() const;
 
   // Functions to set configuration.
@@ -54,6 +55,12 @@ public:
 
   void set_uci_periodic_cqi(srsran_uci_data_t* uci_data);
 
+  /* Downlink front-end stages (OFDM demodulation and channel estimation). They can be run ahead of work_dl_regular(),
+   * for several antennas and carriers concurrently, as long as dl_front_end_prepare() returned true */
+  bool dl_front_end_prepare();
+  void dl_front_end_fft(uint32_t rx_ant);
+  void dl_front_end_estimate();
+
   bool work_dl_regular();
   bool work_dl_mbsfn(srsran_mbsfn_cfg_t mbsfn_cfg);
   bool work_ul(srsran_uci_data_t* uci_data);
@@ -114,6 +121,9 @@ private:
   srsran_chest_dl_cfg_t chest_mbsfn_cfg   = {};
   srsran_chest_dl_cfg_t chest_default_cfg = {};
 
+  bool dl_front_end_done = false; ///< The current subframe was already demodulated and estimated
+  bool dl_front_end_ok   = false; ///< The front-end stages of the current subframe succeeded
+
   /* Objects for UL */
   srsran_ue_ul_t     ue_ul     = {};
   srsran_ue_ul_cfg_t ue_ul_cfg = {};
@@ -42,7 +42,10 @@ namespace lte {
 class sf_worker : public srsran::thread_pool::worker
 {
 public:
-  sf_worker(uint32_t max_prb, phy_common* phy_, srslog::basic_logger& logger);
+  sf_worker(uint32_t                  max_prb,
+            phy_common*               phy_,
+            srslog::basic_logger&     logger,
+            srsran::task_thread_pool* dl_fe_pool_ = nullptr);
   virtual ~sf_worker();
 
   void reset_cell_nolock(uint32_t cc_idx);
@@ -54,6 +57,7 @@ public:
   void     set_context(const srsran::phy_common_interface::worker_context_t& w_ctx);
   void     set_prach(cf_t* prach_ptr, float prach_power);
   void     set_cfo_nolock(const uint32_t& cc_idx, float cfo);
+  void     set_dl_cfo_nolock(const uint32_t& cc_idx, float cfo);
 
   void set_tdd_config_nolock(srsran_tdd_config_t config);
   void set_config_nolock(uint32_t cc_idx, const srsran::phy_cfg_t& phy_cfg);
@@ -78,12 +82,14 @@ private:
   /* Inherited from thread_pool::worker. Function called every subframe to run the DL/UL processing */
   void work_imp() final;
 
+  void work_dl_front_end(uint32_t tti);
   void update_measurements();
   void reset_uci(srsran_uci_data_t* uci_data);
 
   std::vector<cc_worker*> cc_workers;
 
-  phy_common* phy = nullptr;
+  phy_common*               phy        = nullptr;
+  srsran::task_thread_pool* dl_fe_pool = nullptr; ///< Helper threads for the DL front-end, shared by all workers
 
   srslog::basic_logger& logger;
 
@@ -31,8 +31,9 @@ namespace lte {
 class worker_pool
 {
 private:
-  srsran::thread_pool                      pool;
-  std::vector<std::unique_ptr<sf_worker> > workers;
+  srsran::thread_pool                       pool;
+  std::vector<std::unique_ptr<sf_worker> >  workers;
+  std::unique_ptr<srsran::task_thread_pool> dl_fe_pool; ///< Optional DL front-end helper threads
 
   class phy_cfg_stash_t
   {
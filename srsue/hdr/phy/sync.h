@@ -61,7 +61,8 @@ public:
     phy_logger(phy_logger),
     phy_lib_logger(phy_lib_logger),
     sf_buffer(sync_nof_rx_subframes),
-    dummy_buffer(sync_nof_rx_subframes){};
+    dummy_buffer(sync_nof_rx_subframes),
+    meas_buffer(sync_nof_rx_subframes){};
   ~sync();
 
   void init(srsran::radio_interface_phy* radio_,
@@ -244,6 +245,7 @@ private:
   const static uint32_t sync_nof_rx_subframes = 5;
   srsran::rf_buffer_t   sf_buffer             = {};
   srsran::rf_buffer_t   dummy_buffer;
+  srsran::rf_buffer_t   meas_buffer; // CFO corrected samples for the measurements when the demodulation corrects it
 
   // Sync metrics
   std::atomic<float> sfo     = {}; // SFO estimate updated after each sync-cycle
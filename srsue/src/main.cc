@@ -295,6 +295,10 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
      bpo::value<uint32_t>(&args->phy.nof_phy_threads)->default_value(3),
      "Number of PHY threads")
 
+    ("phy.nof_dl_fe_threads",
+     bpo::value<uint32_t>(&args->phy.nof_dl_fe_threads)->default_value(0),
+     "Number of helper threads overlapping the DL OFDM demodulation and channel estimation of all antennas and carriers (0 disabled)")
+
     ("phy.equalizer_mode",
      bpo::value<string>(&args->phy.equalizer_mode)->default_value("mmse"),
      "Equalizer mode")
@@ -325,6 +329,11 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
      bpo::value<float>(&args->phy.cfo_correct_tol_hz)->default_value(1.0),
      "Tolerance (in Hz) for digital CFO compensation (needs to be low if interpolate_subframe_enabled=true.")
 
+    ("phy.cfo_correct_in_demod",
+     bpo::value<bool>(&args->phy.cfo_correct_in_demod)->default_value(false),
+     "Corrects the CFO of the tracked subframes in the OFDM demodulation instead of in the receive buffer. It only "
+     "applies with a single LTE carrier and no NR carrier.")
+
     ("phy.cfo_pss_ema",
      bpo::value<float>(&args->phy.cfo_pss_ema)->default_value(DEFAULT_CFO_EMA_TRACK),
      "CFO Exponential Moving Average coefficient for PSS estimation during TRACK.")
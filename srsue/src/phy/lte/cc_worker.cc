@@ -185,6 +185,11 @@ void cc_worker::set_cfo_nolock(float cfo)
   ue_ul_cfg.cfo_value = cfo;
 }
 
+void cc_worker::set_dl_cfo_nolock(float cfo)
+{
+  srsran_ue_dl_set_cfo(&ue_dl, cfo);
+}
+
 float cc_worker::get_ref_cfo() const
 {
   return ue_dl.chest_res.cfo;
@@ -202,6 +207,38 @@ void cc_worker::set_tdd_config_nolock(srsran_tdd_config_t config)
  *
  */
 
+bool cc_worker::dl_front_end_prepare()
+{
+  dl_front_end_done = false;
+
+  // The TDD blind search of the PHICH mi value requires estimating the subframe once per candidate
+  if (!cell_initiated || (cell.frame_type == SRSRAN_TDD && !sf_cfg_dl.tdd_config.configured)) {
+    return false;
+  }
+
+  sf_cfg_dl.sf_type   = SRSRAN_SF_NORM;
+  ue_dl_cfg.chest_cfg = chest_default_cfg;
+  srsran_ue_dl_set_mi_auto(&ue_dl);
+
+  dl_front_end_done = true;
+  dl_front_end_ok   = true;
+  return true;
+}
+
+void cc_worker::dl_front_end_fft(uint32_t rx_ant)
+{
+  if (srsran_ue_dl_run_fft(&ue_dl, &sf_cfg_dl, rx_ant) < SRSRAN_SUCCESS) {
+    dl_front_end_ok = false;
+  }
+}
+
+void cc_worker::dl_front_end_estimate()
+{
+  if (dl_front_end_ok && srsran_ue_dl_estimate(&ue_dl, &sf_cfg_dl, &ue_dl_cfg) < SRSRAN_SUCCESS) {
+    dl_front_end_ok = false;
+  }
+}
+
 bool cc_worker::work_dl_regular()
 {
   bool dl_ack[SRSRAN_MAX_CODEWORDS] = {};
@@ -215,6 +252,14 @@ bool cc_worker::work_dl_regular()
     return false;
   }
 
+  // Consume the front-end stages if they were already run for this subframe
+  bool front_end_done = dl_front_end_done;
+  dl_front_end_done   = false;
+  if (front_end_done && !dl_front_end_ok) {
+    Error("Getting PDCCH FFT estimate");
+    return false;
+  }
+
   sf_cfg_dl.sf_type = SRSRAN_SF_NORM;
 
   // Set default channel estimation
@@ -239,7 +284,7 @@ bool cc_worker::work_dl_regular()
     }
 
     /* Do FFT and extract PDCCH LLR, or quit if no actions are required in this subframe */
-    if (srsran_ue_dl_decode_fft_estimate(&ue_dl, &sf_cfg_dl, &ue_dl_cfg) < 0) {
+    if (!front_end_done && srsran_ue_dl_decode_fft_estimate(&ue_dl, &sf_cfg_dl, &ue_dl_cfg) < 0) {
       Error("Getting PDCCH FFT estimate");
       return false;
     }
@@ -23,6 +23,7 @@
 
 #include "srsran/common/standard_streams.h"
 #include "srsue/hdr/phy/lte/sf_worker.h"
+#include <atomic>
 #include <string.h>
 
 #define Error(fmt, ...)                                                                                                \
@@ -56,9 +57,14 @@ static bool      plot_nr_enable = false;
 namespace srsue {
 namespace lte {
 
-sf_worker::sf_worker(uint32_t max_prb, phy_common* phy_, srslog::basic_logger& logger) : logger(logger)
+sf_worker::sf_worker(uint32_t                  max_prb,
+                     phy_common*               phy_,
+                     srslog::basic_logger&     logger,
+                     srsran::task_thread_pool* dl_fe_pool_) :
+  logger(logger)
 {
-  phy = phy_;
+  phy        = phy_;
+  dl_fe_pool = dl_fe_pool_;
 
   // ue_sync in phy.cc requires a buffer for 3 subframes
   for (uint32_t r = 0; r < phy->args->nof_lte_carriers; r++) {
@@ -134,6 +140,11 @@ void sf_worker::set_cfo_nolock(const uint32_t& cc_idx, float cfo)
   cc_workers[cc_idx]->set_cfo_nolock(cfo);
 }
 
+void sf_worker::set_dl_cfo_nolock(const uint32_t& cc_idx, float cfo)
+{
+  cc_workers[cc_idx]->set_dl_cfo_nolock(cfo);
+}
+
 void sf_worker::set_tdd_config_nolock(srsran_tdd_config_t config)
 {
   for (auto& cc_worker : cc_workers) {
@@ -155,6 +166,87 @@ void sf_worker::set_config_nolock(uint32_t cc_idx, const srsran::phy_cfg_t& phy_
   }
 }
 
+/**
+ * Set of independent jobs executed by the calling thread and, concurrently, by the DL front-end helper threads. Every
+ * participant takes jobs until none is left, so the caller never waits for a helper that has not started yet.
+ */
+class dl_fe_batch_t
+{
+public:
+  dl_fe_batch_t(uint32_t nof_jobs_, std::function<void(uint32_t)> job_) : nof_jobs(nof_jobs_), job(std::move(job_)) {}
+
+  void run()
+  {
+    for (uint32_t i = next++; i < nof_jobs; i = next++) {
+      job(i);
+      std::lock_guard<std::mutex> lock(mutex);
+      if (++nof_done == nof_jobs) {
+        cvar.notify_all();
+      }
+    }
+  }
+
+  void wait()
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (nof_done < nof_jobs) {
+      cvar.wait(lock);
+    }
+  }
+
+private:
+  const uint32_t                nof_jobs;
+  std::function<void(uint32_t)> job;
+  std::atomic<uint32_t>         next = {0};
+  std::mutex                    mutex;
+  std::condition_variable       cvar;
+  uint32_t                      nof_done = 0;
+};
+
+static void dl_fe_run_batch(srsran::task_thread_pool& pool, uint32_t nof_jobs, std::function<void(uint32_t)> job)
+{
+  // Helpers may start after the batch is complete, they keep it alive until they return
+  auto     batch       = std::make_shared<dl_fe_batch_t>(nof_jobs, std::move(job));
+  uint32_t nof_helpers = std::min(nof_jobs - 1, (uint32_t)pool.nof_workers());
+  for (uint32_t i = 0; i < nof_helpers; i++) {
+    pool.push_task([batch]() { batch->run(); });
+  }
+  batch->run();
+  batch->wait();
+}
+
+/**
+ * Runs the OFDM demodulation of every antenna and carrier and then the channel estimation of every carrier using the
+ * DL front-end helper threads. The carriers are left ready for the PDCCH/PDSCH decoding in work_dl_regular(), which
+ * is kept serial and in carrier order since the SCell grants may be carried by the PCell.
+ */
+void sf_worker::work_dl_front_end(uint32_t tti)
+{
+  std::vector<uint32_t> cc_list;
+  srsran_mbsfn_cfg_t    mbsfn_cfg = {};
+  for (uint32_t cc_idx = 0; cc_idx < cc_workers.size(); cc_idx++) {
+    if (cc_idx == 0 && phy->is_mbsfn_sf(&mbsfn_cfg, tti)) {
+      continue;
+    }
+    if (phy->cell_state.is_configured(cc_idx) && cc_workers[cc_idx]->dl_front_end_prepare()) {
+      cc_list.push_back(cc_idx);
+    }
+  }
+
+  uint32_t nof_rx_ant = phy->args->nof_rx_ant;
+  uint32_t nof_jobs   = cc_list.size() * nof_rx_ant;
+  if (nof_jobs == 0) {
+    return;
+  }
+
+  dl_fe_run_batch(*dl_fe_pool, nof_jobs, [this, &cc_list, nof_rx_ant](uint32_t i) {
+    cc_workers[cc_list[i / nof_rx_ant]]->dl_front_end_fft(i % nof_rx_ant);
+  });
+  dl_fe_run_batch(*dl_fe_pool, cc_list.size(), [this, &cc_list](uint32_t i) {
+    cc_workers[cc_list[i]]->dl_front_end_estimate();
+  });
+}
+
 void sf_worker::work_imp()
 {
   uint32_t            tti           = context.sf_idx;
@@ -170,6 +262,12 @@ void sf_worker::work_imp()
 
   /***** Downlink Processing *******/
 
+  // Overlap the OFDM demodulation and channel estimation of all antennas and carriers
+  if (dl_fe_pool != nullptr &&
+      (srsran_sfidx_tdd_type(tdd_config, tti % 10) != SRSRAN_TDD_SF_U || cell.frame_type == SRSRAN_FDD)) {
+    work_dl_front_end(tti);
+  }
+
   // Loop through all carriers. carrier_idx=0 is PCell
   for (uint32_t carrier_idx = 0; carrier_idx < cc_workers.size(); carrier_idx++) {
     // Process all DL and special subframes
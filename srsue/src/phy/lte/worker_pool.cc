@@ -54,13 +54,19 @@ worker_pool::worker_pool(uint32_t max_workers) :
 
 bool worker_pool::init(phy_common* common, int prio)
 {
+  // Create the helper threads shared by all workers to overlap the DL front-end processing
+  if (common->args->nof_dl_fe_threads > 0) {
+    dl_fe_pool = std::unique_ptr<srsran::task_thread_pool>(
+        new srsran::task_thread_pool(common->args->nof_dl_fe_threads, false, prio, common->args->worker_cpu_mask));
+  }
+
   // Add workers to workers pool and start threads
   for (uint32_t i = 0; i < common->args->nof_phy_threads; i++) {
     srslog::basic_logger& log = srslog::fetch_basic_logger(fmt::format("PHY{}", i));
     log.set_level(srslog::str_to_basic_level(common->args->log.phy_level));
     log.set_hex_dump_max_size(common->args->log.phy_hex_limit);
 
-    auto w = std::unique_ptr<lte::sf_worker>(new lte::sf_worker(SRSRAN_MAX_PRB, common, log));
+    auto w = std::unique_ptr<lte::sf_worker>(new lte::sf_worker(SRSRAN_MAX_PRB, common, log, dl_fe_pool.get()));
     pool.init_worker(i, w.get(), prio, common->args->worker_cpu_mask);
     workers.push_back(std::move(w));
   }
@@ -102,6 +108,9 @@ sf_worker* worker_pool::wait_worker_id(uint32_t id)
 void worker_pool::stop()
 {
   pool.stop();
+  if (dl_fe_pool != nullptr) {
+    dl_fe_pool->stop();
+  }
 }
 
 void worker_pool::set_config(uint32_t cc_idx, const srsran::phy_cfg_t& phy_cfg)
@@ -112,9 +112,15 @@ sfn_sync::ret_code sfn_sync::decode_mib(srsran_cell_t*
                                         std::array<uint8_t, SRSRAN_BCH_PAYLOAD_LEN>& bch_payload,
                                         bool                                         sfidx_only)
 {
-  // If external buffer provided not equal to internal buffer, copy samples from channel/port 0
+  // If external buffer provided not equal to internal buffer, copy samples from channel/port 0. The CFO is corrected
+  // on the way if ue_sync left it to the OFDM demodulation
   if (ext_buffer != nullptr) {
-    memcpy(mib_buffer.get(0), ext_buffer->get(0), sizeof(cf_t) * ue_sync->sf_len);
+    float cfo = srsran_ue_sync_get_cfo_demod(ue_sync);
+    if (std::isnormal(cfo)) {
+      srsran_vec_apply_cfo(ext_buffer->get(0), cfo, mib_buffer.get(0), ue_sync->sf_len);
+    } else {
+      memcpy(mib_buffer.get(0), ext_buffer->get(0), sizeof(cf_t) * ue_sync->sf_len);
+    }
   }
 
   if (srsran_ue_sync_get_sfidx(ue_sync) == 0) {
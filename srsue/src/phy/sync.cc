@@ -527,6 +527,7 @@ void sync::run_camping_in_sync_state(lte::sf_worker*      lte_worker,
   // Set CFO for all Carriers
   for (uint32_t cc = 0; cc < worker_com->args->nof_lte_carriers; cc++) {
     lte_worker->set_cfo_nolock(cc, get_tx_cfo());
+    lte_worker->set_dl_cfo_nolock(cc, srsran_ue_sync_get_cfo_demod(&ue_sync));
     worker_com->update_cfo_measurement(cc, cfo);
   }
 
@@ -881,6 +882,15 @@ bool sync::set_cell(float cfo_in)
   // Set options defined in expert section
   set_ue_sync_opts(&ue_sync, cfo_in);
 
+  // Optionally, with a single LTE carrier the CFO is corrected by the OFDM demodulation of the worker. Other carriers
+  // and the secondary cell synchronization use the receive buffer, so it is still corrected in place for them.
+  bool cfo_in_demod = worker_com->args->cfo_correct_in_demod && worker_com->args->nof_lte_carriers == 1 &&
+                      worker_com->args->nof_nr_carriers == 0;
+  if (srsran_ue_sync_set_cfo_correct_in_demod(&ue_sync, cfo_in_demod) < SRSRAN_SUCCESS) {
+    Error("SYNC:  Setting cell: enabling CFO correction in the OFDM demodulation");
+    return false;
+  }
+
   // Reset ue_sync and set CFO/gain from search procedure
   srsran_ue_sync_reset(&ue_sync);
 
@@ -997,8 +1007,14 @@ int sync::radio_recv_fnc(srsran::rf_buffer_t& data, srsran_timestamp_t* rx_time)
   if (cell.is_valid()) {
     std::lock_guard<std::mutex> lock(intra_freq_cfg_mutex);
     for (uint32_t i = 0; (uint32_t)i < intra_freq_meas.size(); i++) {
+      // The measurements expect the CFO corrected samples, also when the correction is left to the demodulation
+      cf_t* meas_samples = data.get(i, 0, worker_com->args->nof_rx_ant);
+      if (srsran_ue_sync_cfo_correct_copy(&ue_sync, meas_samples, meas_buffer.get(0), data.get_nof_samples())) {
+        meas_samples = meas_buffer.get(0);
+      }
+
       // Feed the exact number of base-band samples for avoiding an invalid buffer read
-      intra_freq_meas[i]->run_tti(tti, data.get(i, 0, worker_com->args->nof_rx_ant), data.get_nof_samples());
+      intra_freq_meas[i]->run_tti(tti, meas_samples, data.get_nof_samples());
 
       // Update RX gain
       intra_freq_meas[i]->set_rx_gain_offset(worker_com->get_rx_gain_offset());
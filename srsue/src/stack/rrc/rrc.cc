@@ -38,6 +38,7 @@
 #include <inttypes.h> // for printing uint64_t
 #include <iostream>
 #include <math.h>
+#include <mutex>
 #include <numeric>
 #include <string.h>
 
@@ -53,6 +54,65 @@ namespace srsue {
 const static uint32_t NOF_REQUIRED_SIBS                = 4;
 const static uint32_t required_sibs[NOF_REQUIRED_SIBS] = {0, 1, 2, 12}; // SIB1, SIB2, SIB3 and SIB13 (eMBMS)
 
+namespace {
+
+/**
+ * Packed UE-EUTRA-Capability of each capability profile, i.e. of each set of RRC arguments the capabilities are
+ * derived from. Shared by all the UEs of the process, so that the UEs of an emulated population pack their
+ * capabilities once instead of on every enquiry.
+ */
+class eutra_cap_cache
+{
+public:
+  using profile_t = std::vector<uint32_t>;
+
+  static profile_t make_profile(const rrc_args_t& args)
+  {
+    profile_t profile = {args.release,
+                         args.ue_category,
+                         (uint32_t)args.ue_category_ul,
+                         (uint32_t)args.ue_category_dl,
+                         args.feature_group,
+                         (uint32_t)args.support_ca,
+                         args.nof_supported_bands};
+    profile.insert(
+        profile.end(), args.supported_bands.begin(), args.supported_bands.begin() + args.nof_supported_bands);
+    profile.push_back(args.supported_bands_nr.size());
+    profile.insert(profile.end(), args.supported_bands_nr.begin(), args.supported_bands_nr.end());
+    return profile;
+  }
+
+  bool find(const profile_t& profile, asn1::dyn_octstring& container) const
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto                        it = cache.find(profile);
+    if (it == cache.end()) {
+      return false;
+    }
+    container.resize(it->second.size());
+    memcpy(container.data(), it->second.data(), it->second.size());
+    return true;
+  }
+
+  void store(profile_t profile, std::vector<uint8_t> packed)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    cache.emplace(std::move(profile), std::move(packed));
+  }
+
+private:
+  mutable std::mutex                        mutex;
+  std::map<profile_t, std::vector<uint8_t> > cache;
+};
+
+eutra_cap_cache& get_eutra_cap_cache()
+{
+  static eutra_cap_cache cache;
+  return cache;
+}
+
+} // namespace
+
 /*******************************************************************************
   Base functions
 *******************************************************************************/
@@ -1884,6 +1944,14 @@ void rrc::handle_ue_capability_enquiry(const ue_cap_enquiry_s& enquiry)
         args.ue_category = new_category;
       }
 
+      // The capabilities only depend on the arguments, they are packed once for all the UEs that share them
+      eutra_cap_cache::profile_t profile   = eutra_cap_cache::make_profile(args);
+      asn1::dyn_octstring&       container = info->ue_cap_rat_container_list[rat_idx].ue_cap_rat_container;
+      if (get_eutra_cap_cache().find(profile, container)) {
+        rat_idx++;
+        continue;
+      }
+
       ue_eutra_cap_s cap;
       cap.access_stratum_release = (access_stratum_release_e::options)(args.release - SRSRAN_RELEASE_MIN);
       cap.ue_category            = (uint8_t)((args.ue_category < 1 || args.ue_category > 5) ? 4 : args.ue_category);
@@ -2150,6 +2218,7 @@ void rrc::handle_ue_capability_enquiry(const ue_cap_enquiry_s& enquiry)
       auto cap_len = (uint32_t)bref.distance_bytes(buf);
       info->ue_cap_rat_container_list[rat_idx].ue_cap_rat_container.resize(cap_len);
       memcpy(info->ue_cap_rat_container_list[rat_idx].ue_cap_rat_container.data(), buf, cap_len);
+      get_eutra_cap_cache().store(std::move(profile), std::vector<uint8_t>(buf, buf + cap_len));
       rat_idx++;
     } else if (enquiry.crit_exts.c1().ue_cap_enquiry_r8().ue_cap_request[i] == rat_type_e::eutra_nr && has_nr_dc()) {
       info->ue_cap_rat_container_list[rat_idx] = get_eutra_nr_capabilities();
@@ -63,7 +63,7 @@ ue_stack_lte::ue_stack_lte() :
 {
   get_background_workers().set_nof_workers(2);
   ue_task_queue  = task_sched.make_task_queue();
-  gw_queue_id    = task_sched.make_task_queue();
+  gw_queue_id    = task_sched.make_task_queue(srsran::task_priority::bulk);
   cfg_task_queue = task_sched.make_task_queue();
   // sync_queue is added in init()
 }
@@ -212,7 +212,7 @@ int ue_stack_lte::init(const stack_args_t& args_)
   }
 
   // add sync queue
-  sync_task_queue = task_sched.make_task_queue(args.sync_queue_size);
+  sync_task_queue = task_sched.make_task_queue(args.sync_queue_size, srsran::task_priority::tti_critical);
 
   mac.init(phy, &rlc, &rrc);
   rlc.init(&pdcp, &rrc, task_sched.get_timer_handler(), 0 /* RB_ID_SRB0 */);
@@ -44,8 +44,8 @@ ue_stack_nr::ue_stack_nr() :
   byte_buffer_pool::get_instance()->enable_logger(true);
 
   ue_task_queue   = task_sched.make_task_queue();
-  sync_task_queue = task_sched.make_task_queue();
-  gw_task_queue   = task_sched.make_task_queue();
+  sync_task_queue = task_sched.make_task_queue(srsran::task_priority::tti_critical);
+  gw_task_queue   = task_sched.make_task_queue(srsran::task_priority::bulk);
 }
 
 ue_stack_nr::~ue_stack_nr()
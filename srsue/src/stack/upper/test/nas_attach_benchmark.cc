@@ -0,0 +1,267 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsue/hdr/stack/upper/test/nas_test_common.h"
+#include <ctime>
+#include <getopt.h>
+#include <vector>
+
+/*
+ * Measures the CPU time the UE NAS and USIM spend on the attach of each UE of a population: USIM initialization,
+ * authentication, security mode and attach accept.
+ */
+
+using namespace srsran;
+
+namespace {
+
+struct bench_params {
+  uint32_t nof_ues = 1000;
+};
+
+double cpu_time_us()
+{
+  struct timespec t = {};
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &t);
+  return t.tv_sec * 1e6 + t.tv_nsec / 1e3;
+}
+
+void push_pdu(srsue::nas& nas, const uint8_t* pdu, uint32_t len)
+{
+  unique_byte_buffer_t tmp = srsran::make_byte_buffer();
+  srsran_assert(tmp != nullptr, "Failed to allocate buffer");
+  memcpy(tmp->msg, pdu, len);
+  tmp->N_bytes = len;
+  nas.write_pdu(LCID, std::move(tmp));
+}
+
+// Offsets of RAND and AUTN in the authentication request
+const uint32_t auth_request_rand_idx = 3;
+const uint32_t auth_request_autn_idx = 20;
+
+/// Returns the authentication request with an AUTN that the USIM accepts for the given algorithm. The PDU of the test
+/// is already valid for XOR, with Milenage AUTN is computed as the network would do.
+std::vector<uint8_t> make_auth_request(const char* algo)
+{
+  std::vector<uint8_t> pdu(auth_request_pdu, auth_request_pdu + sizeof(auth_request_pdu));
+  if (std::string(algo) != "milenage") {
+    return pdu;
+  }
+
+  uint8_t k[16]  = {0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff};
+  uint8_t op[16] = {0x63, 0xbf, 0xa5, 0x0e, 0xe6, 0x52, 0x33, 0x65, 0xff, 0x14, 0xc1, 0xf4, 0x5f, 0x88, 0x73, 0x7d};
+  uint8_t sqn[6] = {0x00, 0x00, 0x00, 0x00, 0x00, 0x20};
+  uint8_t amf[2] = {0x80, 0x00};
+  uint8_t opc[16], res[8], ck[16], ik[16], ak[6], mac[8];
+
+  uint8_t* rand = &pdu[auth_request_rand_idx];
+  uint8_t* autn = &pdu[auth_request_autn_idx];
+  compute_opc(k, op, opc);
+  security_milenage_f2345(k, opc, rand, res, ck, ik, ak);
+  security_milenage_f1(k, opc, rand, sqn, amf, mac);
+  for (uint32_t i = 0; i < 6; i++) {
+    autn[i] = sqn[i] ^ ak[i];
+  }
+  memcpy(&autn[6], amf, sizeof(amf));
+  memcpy(&autn[8], mac, sizeof(mac));
+  return pdu;
+}
+
+usim_args_t make_usim_args(const char* algo, const std::string& imsi)
+{
+  usim_args_t args;
+  args.algo     = algo;
+  args.imei     = "353490069873319";
+  args.imsi     = imsi;
+  args.k        = "00112233445566778899aabbccddeeff";
+  args.op       = "63BFA50EE6523365FF14C1F45F88737D";
+  args.using_op = true;
+  return args;
+}
+
+// Offsets of the MAC and the sequence number in a security protected message
+const uint32_t sec_hdr_mac_idx = 1;
+const uint32_t sec_hdr_seq_idx = 5;
+
+/// Downlink messages of the attach, protected as the network would do for the given algorithm
+struct attach_pdus {
+  std::vector<uint8_t> auth_request;
+  std::vector<uint8_t> sec_mode_command;
+  std::vector<uint8_t> attach_accept;
+};
+
+/// Sets the sequence number and the MAC of a protected message with the NAS integrity key
+void protect_pdu(const uint8_t* k_nas_int, uint8_t count, std::vector<uint8_t>& pdu)
+{
+  pdu[sec_hdr_seq_idx] = count;
+  security_128_eia2(&k_nas_int[16],
+                    count,
+                    0,
+                    SECURITY_DIRECTION_DOWNLINK,
+                    &pdu[sec_hdr_seq_idx],
+                    pdu.size() - sec_hdr_seq_idx,
+                    &pdu[sec_hdr_mac_idx]);
+}
+
+/// All the UEs share K, so the network derives the same NAS keys for all of them. The security mode command selects
+/// EIA2 without ciphering, the attach accept follows it in the new security context
+attach_pdus make_attach_pdus(const char* algo)
+{
+  attach_pdus pdus;
+  pdus.auth_request = make_auth_request(algo);
+  pdus.sec_mode_command.assign(sec_mode_command_pdu, sec_mode_command_pdu + sizeof(sec_mode_command_pdu));
+  pdus.attach_accept.assign(attach_accept_pdu, attach_accept_pdu + sizeof(attach_accept_pdu));
+
+  usim_args_t args = make_usim_args(algo, "001010123456789");
+  srsue::usim usim(srslog::fetch_basic_logger("USIM"));
+  TESTASSERT(usim.init(&args) == SRSRAN_SUCCESS);
+
+  uint8_t res[16];
+  int     res_len = 0;
+  uint8_t k_asme[32];
+  TESTASSERT(usim.generate_authentication_response(&pdus.auth_request[auth_request_rand_idx],
+                                                   &pdus.auth_request[auth_request_autn_idx],
+                                                   mcc,
+                                                   mnc,
+                                                   res,
+                                                   &res_len,
+                                                   k_asme) == AUTH_OK);
+
+  uint8_t k_nas_enc[32], k_nas_int[32];
+  security_generate_k_nas(
+      k_asme, CIPHERING_ALGORITHM_ID_EEA0, INTEGRITY_ALGORITHM_ID_128_EIA2, k_nas_enc, k_nas_int);
+  protect_pdu(k_nas_int, 0, pdus.sec_mode_command);
+  protect_pdu(k_nas_int, 1, pdus.attach_accept);
+  return pdus;
+}
+
+/// Runs the attach of nof_ues UEs with the given authentication algorithm and returns the CPU time per UE in usec
+int run_attach_benchmark(const bench_params& params, const char* algo, double& cpu_per_ue_us)
+{
+  attach_pdus pdus = make_attach_pdus(algo);
+
+  srsue::stack_test_dummy stack;
+  rrc_dummy               rrc_dummy;
+  gw_dummy                gw;
+
+  nas_args_t cfg;
+  cfg.apn_name          = "test123";
+  cfg.eia               = "1,2,3";
+  cfg.eea               = "0,1,2,3";
+  cfg.force_imsi_attach = true;
+
+  double start = cpu_time_us();
+  for (uint32_t ue = 0; ue < params.nof_ues; ++ue) {
+    char imsi[16];
+    snprintf(imsi, sizeof(imsi), "00101%010u", ue);
+
+    usim_args_t args = make_usim_args(algo, imsi);
+    srsue::usim usim(srslog::fetch_basic_logger("USIM"));
+    TESTASSERT(usim.init(&args) == SRSRAN_SUCCESS);
+
+    srsue::nas nas(srslog::fetch_basic_logger("NAS"), &stack.task_sched);
+    TESTASSERT(nas.init(&usim, &rrc_dummy, &gw, cfg) == SRSRAN_SUCCESS);
+    rrc_dummy.init(&nas);
+
+    push_pdu(nas, pdus.auth_request.data(), pdus.auth_request.size());
+    TESTASSERT(rrc_dummy.get_last_sdu_len() > 3);
+    rrc_dummy.reset();
+
+    push_pdu(nas, pdus.sec_mode_command.data(), pdus.sec_mode_command.size());
+    TESTASSERT(rrc_dummy.get_last_sdu_len() > 3);
+    rrc_dummy.reset();
+
+    // The attach complete is only sent if the attach accept passed the integrity check
+    push_pdu(nas, pdus.attach_accept.data(), pdus.attach_accept.size());
+    TESTASSERT(rrc_dummy.get_last_sdu_len() > 3);
+    rrc_dummy.reset();
+  }
+  cpu_per_ue_us = (cpu_time_us() - start) / params.nof_ues;
+
+  return SRSRAN_SUCCESS;
+}
+
+/// Returns the CPU time in usec of each authentication response of the USIM
+int run_auth_benchmark(const bench_params& params, const char* algo, double& cpu_per_auth_us)
+{
+  usim_args_t args = make_usim_args(algo, "001010123456789");
+  srsue::usim usim(srslog::fetch_basic_logger("USIM"));
+  TESTASSERT(usim.init(&args) == SRSRAN_SUCCESS);
+
+  std::vector<uint8_t> auth_request = make_auth_request(algo);
+  uint8_t*             rand         = &auth_request[auth_request_rand_idx];
+  uint8_t*             autn         = &auth_request[auth_request_autn_idx];
+
+  uint8_t res[16];
+  int     res_len = 0;
+  uint8_t k_asme[32];
+  double  start = cpu_time_us();
+  for (uint32_t i = 0; i < params.nof_ues; ++i) {
+    TESTASSERT(usim.generate_authentication_response(rand, autn, mcc, mnc, res, &res_len, k_asme) == AUTH_OK);
+  }
+  cpu_per_auth_us = (cpu_time_us() - start) / params.nof_ues;
+
+  return SRSRAN_SUCCESS;
+}
+
+void usage(char* prog)
+{
+  printf("Usage: %s [n]\n", prog);
+  printf("\t-n Number of UEs [Default %d]\n", bench_params{}.nof_ues);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  bench_params params;
+  int          opt;
+  while ((opt = getopt(argc, argv, "n:")) != -1) {
+    switch (opt) {
+      case 'n':
+        params.nof_ues = (uint32_t)strtol(argv[optind - 1], nullptr, 10);
+        break;
+      default:
+        usage(argv[0]);
+        return SRSRAN_ERROR;
+    }
+  }
+  if (params.nof_ues == 0) {
+    usage(argv[0]);
+    return SRSRAN_ERROR;
+  }
+
+  // Logging would dominate the measurements
+  srslog::fetch_basic_logger("NAS", false).set_level(srslog::basic_levels::none);
+  srslog::fetch_basic_logger("USIM", false).set_level(srslog::basic_levels::none);
+  srslog::init();
+
+  printf("Attach of %d UEs\n", params.nof_ues);
+  printf("%-10s %16s %16s\n", "algo", "attach [us/UE]", "auth [us/UE]");
+  for (const char* algo : {"milenage", "xor"}) {
+    double attach_us = 0, auth_us = 0;
+    TESTASSERT(run_attach_benchmark(params, algo, attach_us) == SRSRAN_SUCCESS);
+    TESTASSERT(run_auth_benchmark(params, algo, auth_us) == SRSRAN_SUCCESS);
+    printf("%-10s %16.2f %16.2f\n", algo, attach_us, auth_us);
+  }
+
+  return SRSRAN_SUCCESS;
+}
@@ -177,8 +177,8 @@ usim::gen_auth_res_milenage(uint8_t* rand, uint8_t* autn_enb, uint8_t* res, int*
   uint32_t      i;
   uint8_t       sqn[6];
 
-  // Use RAND and K to compute RES, CK, IK and AK
-  security_milenage_f2345(k, opc, rand, res, ck, ik, ak);
+  // Use RAND and K to compute RES, CK, IK and AK, and the MAC over the SQN and AMF of AUTN, with a single key schedule
+  security_milenage_f12345(k, opc, rand, autn_enb, mac, res, ck, ik, ak);
 
   *res_len = 8;
 
@@ -191,9 +191,6 @@ usim::gen_auth_res_milenage(uint8_t* rand, uint8_t* autn_enb, uint8_t* res, int*
     amf[i] = autn_enb[6 + i];
   }
 
-  // Generate MAC
-  security_milenage_f1(k, opc, rand, sqn, amf, mac);
-
   // Construct AUTN
   for (i = 0; i < 6; i++) {
     autn[i] = sqn[i] ^ ak[i];